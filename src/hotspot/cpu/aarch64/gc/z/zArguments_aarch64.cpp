@@ -23,12 +23,45 @@
 
 #include "precompiled.hpp"
 #include "gc/z/zArguments.hpp"
+#include "gc/z/zErrno.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/globals_extension.hpp"
 #include "utilities/debug.hpp"
 
+#include <sys/prctl.h>
+
+//
+// Support for building on older Linux systems
+//
+
+// prctl(2) options
+#ifndef PR_SET_TAGGED_ADDR_CTRL
+#define PR_SET_TAGGED_ADDR_CTRL              55
+#endif
+#ifndef PR_TAGGED_ADDR_ENABLE
+#define PR_TAGGED_ADDR_ENABLE                (1UL << 0)
+#endif
+
+static bool enable_tagged_addresses() {
+  // Colored pointers can end up being passed to system calls, e.g. when native
+  // code gets direct access to the contents of an array. The kernel only accepts
+  // tagged addresses if the tagged address ABI has been enabled. The setting is
+  // inherited by threads created after this point.
+  if (prctl(PR_SET_TAGGED_ADDR_CTRL, PR_TAGGED_ADDR_ENABLE, 0, 0, 0) == -1) {
+    ZErrno err;
+    warning("Failed to enable the tagged address ABI (%s), disabling ZUseTBI", err.to_string());
+    return false;
+  }
+
+  return true;
+}
+
 void ZArguments::initialize_platform() {
   // Disable class unloading - we don't support concurrent class unloading yet.
   FLAG_SET_DEFAULT(ClassUnloading, false);
   FLAG_SET_DEFAULT(ClassUnloadingWithConcurrentMark, false);
+
+  if (ZUseTBI && !enable_tagged_addresses()) {
+    FLAG_SET_DEFAULT(ZUseTBI, false);
+  }
 }
@@ -134,8 +134,48 @@
 //  |
 //  * 63-48 Fixed (16-bits, always zero)
 //
+//
+// Address Space & Pointer Layout with Top Byte Ignore (ZUseTBI)
+// -------------------------------------------------------------
+//
+// The hardware ignores the top byte of addresses on memory accesses, so the
+// metadata bits are moved there and all heap views share a single mapping.
+// That mapping is placed right above the object offset range, i.e. at
+// 4-8TB, 8-16TB or 16-32TB depending on the max heap size, the same way
+// the object offset is selected for the layouts above.
+//
+//   6 6    5 5              4 4 4
+//   3 2    9 8              5 4 3                                             0
+//  +-+----+----------------+-+------------------------------------------------+
+//  |0|1111|00000000 000000 |1|1111 11111111 11111111 11111111 11111111 11111111|
+//  +-+----+----------------+-+------------------------------------------------+
+//  | |    |                | |
+//  | |    |                | * 43-0 Object Offset (44-bits, 16TB address space)
+//  | |    |                |
+//  | |    |                * 44 Heap Base (1-bit, always one, heap view at 16-32TB)
+//  | |    |
+//  | |    * 58-45 Fixed (14-bits, always zero)
+//  | |
+//  | * 62-59 Metadata Bits (4-bits)  0001 = Marked0
+//  |                                 0010 = Marked1
+//  |                                 0100 = Remapped
+//  |                                 1000 = Finalizable
+//  |
+//  * 63 Fixed (1-bit, always zero)
+//
+// The above shows the layout for a 16TB address space, where the heap base is
+// at bit 44. The object offset and heap base bits move down in the same way for
+// the smaller address spaces.
+//
+
+const size_t ZPlatformAddressMetadataShiftTBI = 59;
 
 uintptr_t ZPlatformAddressBase() {
+  if (ZUseTBI) {
+    // Place the single heap view right above the object offset range
+    return (uintptr_t)1 << ZPlatformAddressOffsetBits();
+  }
+
   return 0;
 }
 
@@ -149,5 +189,9 @@ size_t ZPlatformAddressOffsetBits() {
 }
 
 size_t ZPlatformAddressMetadataShift() {
+  if (ZUseTBI) {
+    return ZPlatformAddressMetadataShiftTBI;
+  }
+
   return ZPlatformAddressOffsetBits();
 }
@@ -4725,6 +4725,262 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // Encode 3 * size source bytes into 4 * size Base64 characters.
+  // ld3 and st4 de-interleave the input and interleave the output, so
+  // each lane computes one group of four characters.
+  void generate_base64_encode_simdround(Register src, Register dst,
+        FloatRegister codec, u8 size) {
+
+    FloatRegister in0  = v4,  in1  = v5,  in2  = v6;
+    FloatRegister out0 = v16, out1 = v17, out2 = v18, out3 = v19;
+    FloatRegister ind0 = v20, ind1 = v21, ind2 = v22, ind3 = v23;
+
+    Assembler::SIMD_Arrangement arrangement = size == 16 ? __ T16B : __ T8B;
+
+    __ ld3(in0, in1, in2, arrangement, __ post(src, 3 * size));
+
+    __ ushr(ind0, arrangement, in0,  2);
+
+    __ ushr(ind1, arrangement, in1,  2);
+    __ shl(in0,   arrangement, in0,  6);
+    __ orr(ind1,  arrangement, ind1, in0);
+    __ ushr(ind1, arrangement, ind1, 2);
+
+    __ ushr(ind2, arrangement, in2,  4);
+    __ shl(in1,   arrangement, in1,  4);
+    __ orr(ind2,  arrangement, in1,  ind2);
+    __ ushr(ind2, arrangement, ind2, 2);
+
+    __ shl(ind3,  arrangement, in2,  2);
+    __ ushr(ind3, arrangement, ind3, 2);
+
+    __ tbl(out0,  arrangement, codec,  4, ind0);
+    __ tbl(out1,  arrangement, codec,  4, ind1);
+    __ tbl(out2,  arrangement, codec,  4, ind2);
+    __ tbl(out3,  arrangement, codec,  4, ind3);
+
+    __ st4(out0,  out1, out2, out3, arrangement, __ post(dst, 4 * size));
+  }
+
+   /**
+   *  Arguments:
+   *
+   *  Input:
+   *  c_rarg0   - src_start
+   *  c_rarg1   - src_offset
+   *  c_rarg2   - src_length (end offset, src_length - src_offset is a multiple of 3)
+   *  c_rarg3   - dest_start
+   *  c_rarg4   - dest_offset
+   *  c_rarg5   - isURL
+   *
+   */
+  address generate_base64_encodeBlock() {
+
+    static const char toBase64[64] = {
+      'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+      'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+      'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+      'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+    };
+
+    static const char toBase64URL[64] = {
+      'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+      'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+      'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+      'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '-', '_'
+    };
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "encodeBlock");
+    address start = __ pc();
+
+    Register src   = c_rarg0;  // source array
+    Register soff  = c_rarg1;  // source start offset
+    Register send  = c_rarg2;  // source end offset
+    Register dst   = c_rarg3;  // dest array
+    Register doff  = c_rarg4;  // position for writing to dest array
+    Register isURL = c_rarg5;  // Base64 or URL character set
+
+    // c_rarg6 and c_rarg7 are free to use as temps
+    Register codec  = c_rarg6;
+    Register length = c_rarg7;
+
+    Label ProcessData, Process48B, Process24B, Process3B, SIMDExit, Exit;
+
+    // The offsets are Java ints, only the low 32 bits are defined.
+    __ add(src, src, soff, ext::sxtw);
+    __ add(dst, dst, doff, ext::sxtw);
+    __ subw(length, send, soff);
+
+    // load the codec base address
+    __ lea(codec, ExternalAddress((address) toBase64));
+    __ cbzw(isURL, ProcessData);
+    __ lea(codec, ExternalAddress((address) toBase64URL));
+
+    __ BIND(ProcessData);
+
+    // too short to form a SIMD loop, roll back
+    __ cmpw(length, 24);
+    __ br(Assembler::LT, Process3B);
+
+    __ ld1(v0, v1, v2, v3, __ T16B, Address(codec));
+
+    __ BIND(Process48B);
+    __ cmpw(length, 48);
+    __ br(Assembler::LT, Process24B);
+    generate_base64_encode_simdround(src, dst, v0, 16);
+    __ subw(length, length, 48);
+    __ b(Process48B);
+
+    __ BIND(Process24B);
+    __ cmpw(length, 24);
+    __ br(Assembler::LT, SIMDExit);
+    generate_base64_encode_simdround(src, dst, v0, 8);
+    __ subw(length, length, 24);
+
+    __ BIND(SIMDExit);
+    __ cbzw(length, Exit);
+
+    __ BIND(Process3B);
+    //  3 src bytes, 24 bits
+    __ ldrb(r10, __ post(src, 1));
+    __ ldrb(r11, __ post(src, 1));
+    __ ldrb(r12, __ post(src, 1));
+    __ orrw(r11, r11, r10, Assembler::LSL, 8);
+    __ orrw(r12, r12, r11, Assembler::LSL, 8);
+    // codec index
+    __ ubfmw(r15, r12, 18, 23);
+    __ ubfmw(r14, r12, 12, 17);
+    __ ubfmw(r13, r12, 6,  11);
+    __ andw(r12,  r12, 63);
+    // get the code based on the codec
+    __ ldrb(r15, Address(codec, r15, Address::uxtw(0)));
+    __ ldrb(r14, Address(codec, r14, Address::uxtw(0)));
+    __ ldrb(r13, Address(codec, r13, Address::uxtw(0)));
+    __ ldrb(r12, Address(codec, r12, Address::uxtw(0)));
+    __ strb(r15, __ post(dst, 1));
+    __ strb(r14, __ post(dst, 1));
+    __ strb(r13, __ post(dst, 1));
+    __ strb(r12, __ post(dst, 1));
+    __ subw(length, length, 3);
+    __ cbnzw(length, Process3B);
+
+    __ BIND(Exit);
+    __ ret(lr);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - obja     address
+   *    c_rarg1   - objb     address
+   *    c_rarg2   - length   length
+   *    c_rarg3   - scale    log2_array_indxscale
+   *
+   *  Output:
+   *        r0    - int >= mismatched index, < 0 bitwise complement of tail
+   */
+  address generate_vectorizedMismatch() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+    address start = __ pc();
+
+    const Register obja   = c_rarg0;
+    const Register objb   = c_rarg1;
+    const Register length = c_rarg2;
+    const Register scale  = c_rarg3;
+    const Register result = r0;
+    const Register cnt    = r4;
+    const Register base   = r5;
+    const Register tmp1   = r6;
+    const Register tmp2   = r7;
+
+    Label LOOP32, TAIL8, LOOP8, TAIL1, LOOP1;
+    Label DIFF32, DIFF8, DIFF1, SAME_TILL_END;
+
+    BLOCK_COMMENT("Entry:");
+    // Work in bytes; length * element size does not fit in 32 bits
+    // for long arrays, so widen before shifting.
+    __ sxtw(cnt, length);
+    __ lslv(cnt, cnt, scale);
+    __ mov(base, obja);
+
+    __ cmp(cnt, (u1)32);
+    __ br(Assembler::LT, TAIL8);
+
+    __ BIND(LOOP32);
+    __ ld1(v0, v1, __ T16B, __ post(obja, 32));
+    __ ld1(v2, v3, __ T16B, __ post(objb, 32));
+    __ eor(v0, __ T16B, v0, v2);
+    __ eor(v1, __ T16B, v1, v3);
+    __ orr(v0, __ T16B, v0, v1);
+    __ umov(tmp1, v0, __ D, 0);
+    __ umov(tmp2, v0, __ D, 1);
+    __ orr(tmp1, tmp1, tmp2);
+    __ cbnz(tmp1, DIFF32);
+    __ sub(cnt, cnt, 32);
+    __ cmp(cnt, (u1)32);
+    __ br(Assembler::GE, LOOP32);
+    __ b(TAIL8);
+
+    __ BIND(DIFF32);
+    // The mismatch is somewhere in the last 32 bytes; step back and
+    // let the word loop locate it.
+    __ sub(obja, obja, 32);
+    __ sub(objb, objb, 32);
+
+    __ BIND(TAIL8);
+    __ cmp(cnt, (u1)8);
+    __ br(Assembler::LT, TAIL1);
+
+    __ BIND(LOOP8);
+    __ ldr(tmp1, __ post(obja, 8));
+    __ ldr(tmp2, __ post(objb, 8));
+    __ eor(tmp1, tmp1, tmp2);
+    __ cbnz(tmp1, DIFF8);
+    __ sub(cnt, cnt, 8);
+    __ cmp(cnt, (u1)8);
+    __ br(Assembler::GE, LOOP8);
+
+    __ BIND(TAIL1);
+    __ cbz(cnt, SAME_TILL_END);
+
+    __ BIND(LOOP1);
+    __ ldrb(tmp1, __ post(obja, 1));
+    __ ldrb(tmp2, __ post(objb, 1));
+    __ cmpw(tmp1, tmp2);
+    __ br(Assembler::NE, DIFF1);
+    __ subs(cnt, cnt, 1);
+    __ br(Assembler::NE, LOOP1);
+
+    __ BIND(SAME_TILL_END);
+    __ mov(result, -1);
+    __ ret(lr);
+
+    __ BIND(DIFF8);
+    // Little-endian: the first differing byte is the lowest set byte.
+    __ rbit(tmp1, tmp1);
+    __ clz(tmp1, tmp1);
+    __ sub(obja, obja, 8);
+    __ sub(result, obja, base);
+    __ add(result, result, tmp1, Assembler::LSR, 3);
+    __ lsrv(result, result, scale);
+    __ ret(lr);
+
+    __ BIND(DIFF1);
+    __ sub(obja, obja, 1);
+    __ sub(result, obja, base);
+    __ lsrv(result, result, scale);
+    __ ret(lr);
+
+    return start;
+  }
+
   // Continuation point for throwing of implicit exceptions that are
   // not handled in the current activation. Fabricates an exception
   // oop and initiates normal exception dispatching in this
@@ -5778,6 +6034,14 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
     }
 
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
+
+    if (UseBASE64Intrinsics) {
+      StubRoutines::_base64_encodeBlock = generate_base64_encodeBlock();
+    }
+
     // data cache line writeback
     StubRoutines::_data_cache_writeback = generate_data_cache_writeback();
     StubRoutines::_data_cache_writeback_sync = generate_data_cache_writeback_sync();
@@ -2532,7 +2532,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
                                                          VirtualCallData::receiver_count_offset(i)) -
                             mdo_offset_bias);
           __ ldr(tmp1, data_addr);
-          __ add(tmp1, tmp1, DataLayout::counter_increment);
+          __ add(tmp1, tmp1, profile_call_increment());
           __ str(tmp1, data_addr);
           return;
         }
@@ -2553,7 +2553,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)) -
                             mdo_offset_bias);
           __ ldr(tmp1, data_addr);
-          __ add(tmp1, tmp1, DataLayout::counter_increment);
+          __ add(tmp1, tmp1, profile_call_increment());
           __ str(tmp1, data_addr);
           return;
         }
@@ -2565,7 +2565,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
       // Receiver did not match any saved receiver and there is no empty row for it.
       // Increment total counter to indicate polymorphic case.
       __ ldr(tmp1, counter_addr);
-      __ add(tmp1, tmp1, DataLayout::counter_increment);
+      __ add(tmp1, tmp1, profile_call_increment());
       __ str(tmp1, counter_addr);
 
       __ bind(update_done);
@@ -2573,7 +2573,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
   } else {
     // Static call
     __ ldr(tmp1, counter_addr);
-    __ add(tmp1, tmp1, DataLayout::counter_increment);
+    __ add(tmp1, tmp1, profile_call_increment());
     __ str(tmp1, counter_addr);
   }
 }
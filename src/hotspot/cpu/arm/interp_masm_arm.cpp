@@ -360,7 +360,9 @@ void InterpreterMacroAssembler::gen_subtype_check(Register Rsub_klass,
 
   bind(update_cache);
   // Must be equal but missed in cache.  Update cache.
-  str(Rsuper_klass, Address(Rsub_klass, Klass::secondary_super_cache_offset()));
+  if (UseSecondarySupersCache) {
+    str(Rsuper_klass, Address(Rsub_klass, Klass::secondary_super_cache_offset()));
+  }
 
   bind(ok_is_subtype);
 }
@@ -2819,7 +2819,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
         ciKlass* receiver = vc_data->receiver(i);
         if (known_klass->equals(receiver)) {
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ add2mem_64(data_addr, DataLayout::counter_increment, tmp1);
+          __ add2mem_64(data_addr, profile_call_increment(), tmp1);
           return;
         }
       }
@@ -2836,7 +2836,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
           metadata2reg(known_klass->constant_encoding(), tmp1);
           __ z_stg(tmp1, recv_addr);
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)));
-          __ add2mem_64(data_addr, DataLayout::counter_increment, tmp1);
+          __ add2mem_64(data_addr, profile_call_increment(), tmp1);
           return;
         }
       }
@@ -2846,12 +2846,12 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
       type_profile_helper(mdo, md, data, recv, tmp1, &update_done);
       // Receiver did not match any saved receiver and there is no empty row for it.
       // Increment total counter to indicate polymorphic case.
-      __ add2mem_64(counter_addr, DataLayout::counter_increment, tmp1);
+      __ add2mem_64(counter_addr, profile_call_increment(), tmp1);
       __ bind(update_done);
     }
   } else {
     // static call
-    __ add2mem_64(counter_addr, DataLayout::counter_increment, tmp1);
+    __ add2mem_64(counter_addr, profile_call_increment(), tmp1);
   }
 }
 
@@ -2802,7 +2802,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
                                                          VirtualCallData::receiver_count_offset(i)) -
                             mdo_offset_bias);
           __ ld_ptr(data_addr, tmp1);
-          __ add(tmp1, DataLayout::counter_increment, tmp1);
+          __ add(tmp1, profile_call_increment(), tmp1);
           __ st_ptr(tmp1, data_addr);
           return;
         }
@@ -2823,7 +2823,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
           Address data_addr(mdo, md->byte_offset_of_slot(data, VirtualCallData::receiver_count_offset(i)) -
                             mdo_offset_bias);
           __ ld_ptr(data_addr, tmp1);
-          __ add(tmp1, DataLayout::counter_increment, tmp1);
+          __ add(tmp1, profile_call_increment(), tmp1);
           __ st_ptr(tmp1, data_addr);
           return;
         }
@@ -2835,7 +2835,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
       // Receiver did not match any saved receiver and there is no empty row for it.
       // Increment total counter to indicate polymorphic case.
       __ ld_ptr(counter_addr, tmp1);
-      __ add(tmp1, DataLayout::counter_increment, tmp1);
+      __ add(tmp1, profile_call_increment(), tmp1);
       __ st_ptr(tmp1, counter_addr);
 
       __ bind(update_done);
@@ -2843,7 +2843,7 @@ void LIR_Assembler::emit_profile_call(LIR_OpProfileCall* op) {
   } else {
     // Static call
     __ ld_ptr(counter_addr, tmp1);
-    __ add(tmp1, DataLayout::counter_increment, tmp1);
+    __ add(tmp1, profile_call_increment(), tmp1);
     __ st_ptr(tmp1, counter_addr);
   }
 }
@@ -904,6 +904,7 @@ private:
 
   // These do register sized moves/scans
   void rep_mov();
+  void rep_movsb();
   void rep_stos();
   void rep_stosb();
   void repne_scan();
@@ -1501,6 +1502,9 @@ private:
   void movq(Register dst, Register src);
   void movq(Register dst, Address src);
   void movq(Address  dst, Register src);
+
+  // Store Quadword using a non-temporal hint
+  void movntiq(Address dst, Register src);
 #endif
 
   void movq(Address     dst, MMXRegister src );
@@ -1692,6 +1696,7 @@ private:
   void evpmovwb(Address dst, KRegister mask, XMMRegister src, int vector_len);
 
   void vpmovzxwd(XMMRegister dst, XMMRegister src, int vector_len);
+  void vpmovsxwd(XMMRegister dst, XMMRegister src, int vector_len);
 
   void evpmovdb(Address dst, XMMRegister src, int vector_len);
 
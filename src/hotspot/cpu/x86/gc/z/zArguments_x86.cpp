@@ -23,7 +23,14 @@
 
 #include "precompiled.hpp"
 #include "gc/z/zArguments.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/globals_extension.hpp"
+#include "utilities/debug.hpp"
 
 void ZArguments::initialize_platform() {
-  // Does nothing
+  // The hardware does not ignore the top byte of addresses
+  if (ZUseTBI) {
+    warning("ZUseTBI is not supported on this platform");
+    FLAG_SET_DEFAULT(ZUseTBI, false);
+  }
 }
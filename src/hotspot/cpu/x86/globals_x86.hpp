@@ -221,5 +221,17 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
              "Minimum array size in bytes to use AVX512 intrinsics"         \
              "for copy, inflate and fill. When this value is set as zero"   \
              "compare operations can also use AVX512 intrinsics.")          \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(intx, ArrayCopyRepMovsbThreshold, 0,                              \
+          "Minimum size in bytes of a disjoint byte arraycopy that uses "   \
+          "rep movsb instead of the vector loop. 0 disables. Set at VM "    \
+          "start on CPUs with enhanced rep movsb")                          \
+          range(0, max_jint)                                                \
+                                                                            \
+  product(intx, ArrayCopyNonTemporalThreshold, 0,                           \
+          "Minimum size in bytes of a disjoint arraycopy that uses "        \
+          "non-temporal stores to avoid evicting the last-level cache. "    \
+          "0 disables. Defaults to half the last-level cache size")         \
           range(0, max_jint)
 #endif // CPU_X86_GLOBALS_X86_HPP
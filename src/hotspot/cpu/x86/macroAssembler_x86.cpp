@@ -4382,6 +4382,116 @@ void MacroAssembler::lookup_interface_method(Register recv_klass,
   }
 }
 
+// Look up the method for a megamorphic invokeinterface call in a single pass
+// over the itable. The target method is looked up in the declaring interface
+// (holder_klass) and the receiver is checked to be a subtype of the
+// resolved interface (resolved_klass). Usually both are the same class.
+// Otherwise the offset of holder_klass is remembered while scanning for
+// resolved_klass, and the scan only continues if it has not been seen yet.
+// recv_klass is preserved, method_result and temp_reg are used as temps.
+void MacroAssembler::lookup_interface_method_stub(Register recv_klass,
+                                                  Register holder_klass,
+                                                  Register resolved_klass,
+                                                  Register method_result,
+                                                  Register scan_temp,
+                                                  Register temp_reg,
+                                                  int itable_index,
+                                                  Label& L_no_such_interface) {
+  assert_different_registers(recv_klass, method_result, holder_klass, resolved_klass, scan_temp, temp_reg);
+  Register temp_itbl_klass = method_result;
+
+  int vtable_base = in_bytes(Klass::vtable_start_offset());
+  int itentry_off = itableMethodEntry::method_offset_in_bytes();
+  int scan_step   = itableOffsetEntry::size() * wordSize;
+  int vte_size    = vtableEntry::size_in_bytes();
+  int ioffset     = itableOffsetEntry::interface_offset_in_bytes();
+  int ooffset     = itableOffsetEntry::offset_offset_in_bytes();
+  Address::ScaleFactor times_vte_scale = Address::times_ptr;
+  assert(vte_size == wordSize, "else adjust times_vte_scale");
+
+  Label L_loop_scan_resolved_entry, L_resolved_found, L_holder_found;
+
+  // temp_itbl_klass = recv_klass.itable[0]
+  // scan_temp = &recv_klass.itable[0] + step
+  movl(scan_temp, Address(recv_klass, Klass::vtable_length_offset()));
+  movptr(temp_itbl_klass, Address(recv_klass, scan_temp, times_vte_scale, vtable_base + ioffset));
+  lea(scan_temp, Address(recv_klass, scan_temp, times_vte_scale, vtable_base + ioffset + scan_step));
+  xorptr(temp_reg, temp_reg);
+
+  // Initial checks:
+  //   - if (holder_klass != resolved_klass), go to "scan for resolved"
+  //   - if (itable[0] == 0), no such interface
+  //   - if (itable[0] == holder_klass), shortcut to "holder found"
+  cmpptr(holder_klass, resolved_klass);
+  jccb(Assembler::notEqual, L_loop_scan_resolved_entry);
+  testptr(temp_itbl_klass, temp_itbl_klass);
+  jcc(Assembler::zero, L_no_such_interface);
+  cmpptr(holder_klass, temp_itbl_klass);
+  jccb(Assembler::equal, L_holder_found);
+
+  // Loop: Look for holder_klass record in itable
+  //   do {
+  //     tmp = itable[index];
+  //     index += step;
+  //     if (tmp == holder_klass) {
+  //       goto L_holder_found; // Found!
+  //     }
+  //   } while (tmp != 0);
+  //   goto L_no_such_interface // Not found.
+  Label L_scan_holder;
+  bind(L_scan_holder);
+    movptr(temp_itbl_klass, Address(scan_temp, 0));
+    addptr(scan_temp, scan_step);
+    cmpptr(holder_klass, temp_itbl_klass);
+    jccb(Assembler::equal, L_holder_found);
+    testptr(temp_itbl_klass, temp_itbl_klass);
+    jccb(Assembler::notZero, L_scan_holder);
+
+  jmp(L_no_such_interface);
+
+  // Loop: Look for resolved_class record in itable
+  //   do {
+  //     tmp = itable[index];
+  //     index += step;
+  //     if (tmp == holder_klass) {
+  //        // Also check if we have met a holder klass
+  //        holder_tmp = itable[index-step-ioffset];
+  //     }
+  //     if (tmp == resolved_klass) {
+  //        goto L_resolved_found;  // Found!
+  //     }
+  //   } while (tmp != 0);
+  //   goto L_no_such_interface // Not found.
+  Label L_loop_scan_resolved;
+  bind(L_loop_scan_resolved);
+    movptr(temp_itbl_klass, Address(scan_temp, 0));
+    addptr(scan_temp, scan_step);
+    bind(L_loop_scan_resolved_entry);
+    cmpptr(holder_klass, temp_itbl_klass);
+    cmovl(Assembler::equal, temp_reg, Address(scan_temp, ooffset - ioffset - scan_step));
+    cmpptr(resolved_klass, temp_itbl_klass);
+    jccb(Assembler::equal, L_resolved_found);
+    testptr(temp_itbl_klass, temp_itbl_klass);
+    jccb(Assembler::notZero, L_loop_scan_resolved);
+
+  jmp(L_no_such_interface);
+
+  Label L_ready;
+
+  // See if we already have a holder klass. If not, go and scan for it.
+  bind(L_resolved_found);
+  testptr(temp_reg, temp_reg);
+  jccb(Assembler::zero, L_scan_holder);
+  jmpb(L_ready);
+
+  bind(L_holder_found);
+  movl(temp_reg, Address(scan_temp, ooffset - ioffset - scan_step));
+
+  // Finally, temp_reg contains holder_klass vtable offset
+  bind(L_ready);
+  assert(itableMethodEntry::size() * wordSize == wordSize, "adjust the scaling in the code below");
+  movptr(method_result, Address(recv_klass, temp_reg, Address::times_1, itable_index * wordSize + itentry_off));
+}
 
 // virtual method calling
 void MacroAssembler::lookup_virtual_method(Register recv_klass,
@@ -4591,7 +4701,9 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   else  jcc(Assembler::notEqual, *L_failure);
 
   // Success.  Cache the super we found and proceed in triumph.
-  movptr(super_cache_addr, super_klass);
+  if (UseSecondarySupersCache) {
+    movptr(super_cache_addr, super_klass);
+  }
 
   if (L_success != &L_fallthrough) {
     jmp(*L_success);
@@ -6430,6 +6542,102 @@ void MacroAssembler::string_indexof_char(Register str1, Register cnt1, Register
   bind(DONE_LABEL);
 } // string_indexof_char
 
+// Latin1 flavour of string_indexof_char: scans 32 bytes per iteration
+// with AVX2, 16 with SSE, then the tail one byte at a time.
+// ch must be in [0, 255]; the Java caller filters out other values.
+void MacroAssembler::stringL_indexof_char(Register str1, Register cnt1, Register ch, Register result,
+                                          XMMRegister vec1, XMMRegister vec2, XMMRegister vec3, Register tmp) {
+  ShortBranchVerifier sbv(this);
+  assert(UseSSE42Intrinsics, "SSE4.2 intrinsics are required");
+
+  int stride = 16;
+
+  Label FOUND_CHAR, SCAN_TO_CHAR_INIT, SCAN_TO_CHAR_LOOP,
+        SCAN_TO_16_CHAR, SCAN_TO_16_CHAR_LOOP, SCAN_TO_32_CHAR_LOOP,
+        RET_NOT_FOUND, SCAN_TO_16_CHAR_INIT,
+        FOUND_SEQ_CHAR, DONE_LABEL;
+
+  movptr(result, str1);
+  if (UseAVX >= 2) {
+    cmpl(cnt1, stride);
+    jcc(Assembler::less, SCAN_TO_CHAR_INIT);
+    cmpl(cnt1, stride*2);
+    jcc(Assembler::less, SCAN_TO_16_CHAR_INIT);
+    movdl(vec1, ch);
+    vpbroadcastb(vec1, vec1, Assembler::AVX_256bit);
+    vpxor(vec2, vec2);
+    movl(tmp, cnt1);
+    andl(tmp, 0xFFFFFFE0);  //vector count (in bytes)
+    andl(cnt1,0x0000001F);  //tail count (in bytes)
+
+    bind(SCAN_TO_32_CHAR_LOOP);
+    vmovdqu(vec3, Address(result, 0));
+    vpcmpeqb(vec3, vec3, vec1, Assembler::AVX_256bit);
+    vptest(vec2, vec3);
+    jcc(Assembler::carryClear, FOUND_CHAR);
+    addptr(result, 32);
+    subl(tmp, stride*2);
+    jcc(Assembler::notZero, SCAN_TO_32_CHAR_LOOP);
+    jmp(SCAN_TO_16_CHAR);
+
+    bind(SCAN_TO_16_CHAR_INIT);
+    movdl(vec1, ch);
+    pxor(vec2, vec2);
+    pshufb(vec1, vec2);
+  }
+
+  bind(SCAN_TO_16_CHAR);
+  cmpl(cnt1, stride);
+  jcc(Assembler::less, SCAN_TO_CHAR_INIT); // less than 16 bytes left
+  if (UseAVX < 2) {
+    movdl(vec1, ch);
+    pxor(vec2, vec2);
+    pshufb(vec1, vec2);
+  }
+  movl(tmp, cnt1);
+  andl(tmp, 0xFFFFFFF0);  //vector count (in bytes)
+  andl(cnt1,0x0000000F);  //tail count (in bytes)
+
+  bind(SCAN_TO_16_CHAR_LOOP);
+  movdqu(vec3, Address(result, 0));
+  pcmpeqb(vec3, vec1);
+  ptest(vec2, vec3);
+  jcc(Assembler::carryClear, FOUND_CHAR);
+  addptr(result, 16);
+  subl(tmp, stride);
+  jcc(Assembler::notZero, SCAN_TO_16_CHAR_LOOP);
+
+  bind(SCAN_TO_CHAR_INIT);
+  testl(cnt1, cnt1);
+  jcc(Assembler::zero, RET_NOT_FOUND);
+  bind(SCAN_TO_CHAR_LOOP);
+  load_unsigned_byte(tmp, Address(result, 0));
+  cmpl(ch, tmp);
+  jccb(Assembler::equal, FOUND_SEQ_CHAR);
+  addptr(result, 1);
+  subl(cnt1, 1);
+  jccb(Assembler::zero, RET_NOT_FOUND);
+  jmp(SCAN_TO_CHAR_LOOP);
+
+  bind(RET_NOT_FOUND);
+  movl(result, -1);
+  jmpb(DONE_LABEL);
+
+  bind(FOUND_CHAR);
+  if (UseAVX >= 2) {
+    vpmovmskb(tmp, vec3);
+  } else {
+    pmovmskb(tmp, vec3);
+  }
+  bsfl(ch, tmp);
+  addptr(result, ch);
+
+  bind(FOUND_SEQ_CHAR);
+  subptr(result, str1);
+
+  bind(DONE_LABEL);
+} // stringL_indexof_char
+
 // helper function for string_compare
 void MacroAssembler::load_next_elements(Register elem1, Register elem2, Register str1, Register str2,
                                         Address::ScaleFactor scale, Address::ScaleFactor scale1,
@@ -8834,6 +9042,16 @@ void MacroAssembler::fold_128bit_crc32_avx512(XMMRegister xcrc, XMMRegister xK,
   evpxorq(xcrc, xcrc, xtmp, Assembler::AVX_512bit /* vector_len */);
 }
 
+/**
+* Fold four 128-bit chunks in xcrc into the four chunks in xnext, 512 bits ahead
+*/
+void MacroAssembler::fold_512bit_crc32_avx512(XMMRegister xcrc, XMMRegister xK, XMMRegister xtmp, XMMRegister xnext) {
+  evpclmulhdq(xtmp, xK, xcrc, Assembler::AVX_512bit); // [123:64]
+  evpclmulldq(xcrc, xK, xcrc, Assembler::AVX_512bit); // [63:0]
+  evpxorq(xcrc, xcrc, xnext, Assembler::AVX_512bit /* vector_len */);
+  evpxorq(xcrc, xcrc, xtmp, Assembler::AVX_512bit /* vector_len */);
+}
+
 /**
  * Fold 128-bit data chunk
  */
@@ -8936,11 +9154,54 @@ void MacroAssembler::kernel_crc32(Register crc, Register buf, Register len, Regi
 
   // Fold total 512 bits of polynomial on each iteration
   if (VM_Version::supports_vpclmulqdq()) {
-    Label Parallel_loop, L_No_Parallel;
+    Label Parallel_loop, L_No_Parallel, L_Single_Parallel, L_Parallel_done;
+    Label L_4x_Parallel_loop, L_4x_Parallel_done;
 
     cmpl(len, 8);
-    jccb(Assembler::less, L_No_Parallel);
-
+    jcc(Assembler::less, L_No_Parallel);
+
+    cmpl(len, 32);
+    jcc(Assembler::less, L_Single_Parallel);
+
+    // At least 512 bytes: fold four independent 512-bit accumulators,
+    // 2048 bits per iteration, so that the carry-less multiplies of the
+    // four streams overlap instead of waiting on each other.
+    movdqu(xmm0, ExternalAddress(StubRoutines::x86::crc_by128_masks_addr() + 48));
+    evshufi64x2(xmm0, xmm0, xmm0, 0x00, Assembler::AVX_512bit);
+    evmovdquq(xmm1, Address(buf,   0), Assembler::AVX_512bit);
+    evmovdquq(xmm2, Address(buf,  64), Assembler::AVX_512bit);
+    evmovdquq(xmm3, Address(buf, 128), Assembler::AVX_512bit);
+    evmovdquq(xmm4, Address(buf, 192), Assembler::AVX_512bit);
+    movdl(xmm5, crc);
+    evpxorq(xmm1, xmm1, xmm5, Assembler::AVX_512bit);
+    addptr(buf, 256);
+    subl(len, 16);
+
+    BIND(L_4x_Parallel_loop);
+    cmpl(len, 16);
+    jcc(Assembler::less, L_4x_Parallel_done);
+    fold_128bit_crc32_avx512(xmm1, xmm0, xmm5, buf,   0);
+    fold_128bit_crc32_avx512(xmm2, xmm0, xmm5, buf,  64);
+    fold_128bit_crc32_avx512(xmm3, xmm0, xmm5, buf, 128);
+    fold_128bit_crc32_avx512(xmm4, xmm0, xmm5, buf, 192);
+    addptr(buf, 256);
+    subl(len, 16);
+    jmp(L_4x_Parallel_loop);
+
+    // Fold the four accumulators into xmm1, 512 bits at a time.
+    BIND(L_4x_Parallel_done);
+    movdqu(xmm0, ExternalAddress(StubRoutines::x86::crc_by128_masks_addr() + 32));
+    evshufi64x2(xmm0, xmm0, xmm0, 0x00, Assembler::AVX_512bit);
+    fold_512bit_crc32_avx512(xmm1, xmm0, xmm5, xmm2);
+    fold_512bit_crc32_avx512(xmm1, xmm0, xmm5, xmm3);
+    fold_512bit_crc32_avx512(xmm1, xmm0, xmm5, xmm4);
+    // Continue with the single accumulator loop below, which expects
+    // len to be the number of remaining 16-byte chunks minus 3.
+    subl(len, 3);
+    jcc(Assembler::lessEqual, L_Parallel_done);
+    jmp(Parallel_loop);
+
+    BIND(L_Single_Parallel);
     movdqu(xmm0, ExternalAddress(StubRoutines::x86::crc_by128_masks_addr() + 32));
     evmovdquq(xmm1, Address(buf, 0), Assembler::AVX_512bit);
     movdl(xmm5, crc);
@@ -8955,6 +9216,7 @@ void MacroAssembler::kernel_crc32(Register crc, Register buf, Register len, Regi
     subl(len, 4);
     jcc(Assembler::greater, Parallel_loop);
 
+    BIND(L_Parallel_done);
     vextracti64x2(xmm2, xmm1, 0x01);
     vextracti64x2(xmm3, xmm1, 0x02);
     vextracti64x2(xmm4, xmm1, 0x03);
@@ -627,7 +627,7 @@ void MacroAssembler::avx_ghash(Register input_state, Register htbl,
     const XMMRegister lswap_mask = xmm14;
 
     Label GENERATE_HTBL_1_BLK, GENERATE_HTBL_8_BLKS, BEGIN_PROCESS, GFMUL, BLOCK8_REDUCTION,
-          ONE_BLK_INIT, PROCESS_1_BLOCK, PROCESS_8_BLOCKS, SAVE_STATE, EXIT_GHASH;
+          ONE_BLK_INIT, PROCESS_1_BLOCK, PROCESS_8_BLOCKS, PROCESS_8_BLOCKS_LOOP, SAVE_STATE, EXIT_GHASH;
 
     testptr(blocks, blocks);
     jcc(Assembler::zero, EXIT_GHASH);
@@ -656,8 +656,10 @@ void MacroAssembler::avx_ghash(Register input_state, Register htbl,
     //Do 8 multiplies followed by a reduction processing 8 blocks of data at a time
     //Each block = 16 bytes.
     bind(PROCESS_8_BLOCKS);
-    subl(blocks, 8);
+    // The byte swap mask is not clobbered by the loop, load it only once.
     movdqu(bswap_mask, ExternalAddress(StubRoutines::x86::ghash_byte_swap_mask_addr()));
+    bind(PROCESS_8_BLOCKS_LOOP);
+    subl(blocks, 8);
     movdqu(data, Address(input_data, 16 * 7));
     vpshufb(data, data, bswap_mask, Assembler::AVX_128bit);
     //Loading 1*16 as calculated powers of H required starts at that location.
@@ -737,7 +739,7 @@ void MacroAssembler::avx_ghash(Register input_state, Register htbl,
     lea(input_data, Address(input_data, 16 * 8));
     cmpl(blocks, 8);
     jcc(Assembler::below, ONE_BLK_INIT);
-    jmp(PROCESS_8_BLOCKS);
+    jmp(PROCESS_8_BLOCKS_LOOP);
 
     // Since this is one block operation we will only use H * 2 i.e. the first power of H
     bind(ONE_BLK_INIT);
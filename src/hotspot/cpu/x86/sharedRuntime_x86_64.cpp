@@ -3848,6 +3848,181 @@ montgomery_square(unsigned long a[], unsigned long n[],
     t0 = sub(m, n, t0, len);
 }
 
+// Montgomery multiplication with AVX-512 IFMA.  The operands are
+// recoded into 52-bit digits so that vpmadd52luq/vpmadd52huq can
+// accumulate eight partial products per instruction without carry
+// propagation; carries are resolved once per reduction step.
+
+typedef unsigned int __attribute__((mode(TI))) uint128;
+
+#define IFMA_DIGIT_BITS 52
+#define IFMA_DIGIT_MASK ((1UL << IFMA_DIGIT_BITS) - 1)
+
+// tl[0..8*chunks) += lo52(d * v[]), th[0..8*chunks) += hi52(d * v[])
+static inline void ifma_mul_add_row(unsigned long* tl, unsigned long* th,
+                                    const unsigned long* v, unsigned long d, int chunks) {
+  __asm__ volatile("vpbroadcastq %[d], %%zmm0\n\t"
+                   "1:\n\t"
+                   "vmovdqu64 (%[v]), %%zmm3\n\t"
+                   "vmovdqu64 (%[tl]), %%zmm1\n\t"
+                   "vmovdqu64 (%[th]), %%zmm2\n\t"
+                   "vpmadd52luq %%zmm3, %%zmm0, %%zmm1\n\t"
+                   "vpmadd52huq %%zmm3, %%zmm0, %%zmm2\n\t"
+                   "vmovdqu64 %%zmm1, (%[tl])\n\t"
+                   "vmovdqu64 %%zmm2, (%[th])\n\t"
+                   "add $64, %[v]\n\t"
+                   "add $64, %[tl]\n\t"
+                   "add $64, %[th]\n\t"
+                   "dec %[n]\n\t"
+                   "jnz 1b\n\t"
+                   : [tl]"+r"(tl), [th]"+r"(th), [v]"+r"(v), [n]"+r"(chunks)
+                   : [d]"r"(d)
+                   : "xmm0", "xmm1", "xmm2", "xmm3", "cc", "memory");
+}
+
+// As above for four consecutive digits d[0..3] of one operand, adding
+// d[s] * v[] at offset s.  v must have three zero digits in front.
+static inline void ifma_mul_add_row4(unsigned long* tl, unsigned long* th,
+                                     const unsigned long* v, const unsigned long* d, int chunks) {
+  __asm__ volatile("vpbroadcastq   (%[d]), %%zmm0\n\t"
+                   "vpbroadcastq  8(%[d]), %%zmm4\n\t"
+                   "vpbroadcastq 16(%[d]), %%zmm5\n\t"
+                   "vpbroadcastq 24(%[d]), %%zmm6\n\t"
+                   "1:\n\t"
+                   "vmovdqu64 (%[tl]), %%zmm1\n\t"
+                   "vmovdqu64 (%[th]), %%zmm2\n\t"
+                   "vmovdqu64 (%[v]), %%zmm3\n\t"
+                   "vpmadd52luq %%zmm3, %%zmm0, %%zmm1\n\t"
+                   "vpmadd52huq %%zmm3, %%zmm0, %%zmm2\n\t"
+                   "vmovdqu64 -8(%[v]), %%zmm3\n\t"
+                   "vpmadd52luq %%zmm3, %%zmm4, %%zmm1\n\t"
+                   "vpmadd52huq %%zmm3, %%zmm4, %%zmm2\n\t"
+                   "vmovdqu64 -16(%[v]), %%zmm3\n\t"
+                   "vpmadd52luq %%zmm3, %%zmm5, %%zmm1\n\t"
+                   "vpmadd52huq %%zmm3, %%zmm5, %%zmm2\n\t"
+                   "vmovdqu64 -24(%[v]), %%zmm3\n\t"
+                   "vpmadd52luq %%zmm3, %%zmm6, %%zmm1\n\t"
+                   "vpmadd52huq %%zmm3, %%zmm6, %%zmm2\n\t"
+                   "vmovdqu64 %%zmm1, (%[tl])\n\t"
+                   "vmovdqu64 %%zmm2, (%[th])\n\t"
+                   "add $64, %[v]\n\t"
+                   "add $64, %[tl]\n\t"
+                   "add $64, %[th]\n\t"
+                   "dec %[n]\n\t"
+                   "jnz 1b\n\t"
+                   : [tl]"+r"(tl), [th]"+r"(th), [v]"+r"(v), [n]"+r"(chunks)
+                   : [d]"r"(d)
+                   : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "cc", "memory");
+}
+
+// Split len longwords into ndigits 52-bit digits.
+static void to_radix52(const unsigned long* x, int len, unsigned long* d, int ndigits) {
+  for (int i = 0; i < ndigits; i++) {
+    int pos = i * IFMA_DIGIT_BITS;
+    int limb = pos / 64, off = pos % 64;
+    unsigned long v = 0;
+    if (limb < len) {
+      v = x[limb] >> off;
+      if (off > 64 - IFMA_DIGIT_BITS && limb + 1 < len) {
+        v |= x[limb + 1] << (64 - off);
+      }
+    }
+    d[i] = v & IFMA_DIGIT_MASK;
+  }
+}
+
+// Computes exactly the same result as montgomery_multiply(): the 52-bit digit reduction
+// steps and the final partial step together pick the same unique
+// multiplier M < 2^(64*len) of n, so (a*b + M*n) / 2^(64*len) and the
+// final conditional subtractions are identical.
+static void __attribute__((noinline))
+montgomery_multiply_ifma(unsigned long a[], unsigned long b[], unsigned long n[],
+                         unsigned long m[], unsigned long inv, int len) {
+  assert(inv * n[0] == -1UL, "broken inverse in Montgomery multiply");
+
+  const int bits = 64 * len;
+  const int k = (bits + IFMA_DIGIT_BITS - 1) / IFMA_DIGIT_BITS; // digits per operand
+  const int kp = (k + 7) & ~7;                                  // padded to whole vectors
+  const int kf = bits / IFMA_DIGIT_BITS;                        // whole-digit reduction steps
+  const int r = bits - kf * IFMA_DIGIT_BITS;                    // bits left for the last step
+  const int chunks = kp / 8;
+  const int acc_len = 2 * kp + 16;
+
+  unsigned long* scratch = (unsigned long*)alloca((3 * kp + 20 + 2 * acc_len + len + 2) * sizeof(unsigned long));
+  unsigned long* ad = scratch;          // kp + 4 digits
+  unsigned long* bd = ad + kp + 4 + 8;  // 8 zero digits in front, 8 behind
+  unsigned long* nd = bd + kp + 8;
+  unsigned long* tl = nd + kp;          // low halves, belong to digit d
+  unsigned long* th = tl + acc_len;     // high halves, belong to digit d + 1
+  unsigned long* v = th + acc_len;
+
+  to_radix52(a, len, ad, kp + 4);
+  memset(bd - 8, 0, 8 * sizeof(unsigned long));
+  to_radix52(b, len, bd, kp + 8);
+  to_radix52(n, len, nd, kp);
+  memset(tl, 0, 2 * acc_len * sizeof(unsigned long));
+
+  // Full product a * b, lanes left unnormalized.
+  for (int i = 0; i < k; i += 4) {
+    ifma_mul_add_row4(tl + i, th + i, bd, ad + i, chunks + 1);
+  }
+
+  // Digit-serial reduction.  Digit i is (tl[i] + th[i-1] + carry).
+  const unsigned long inv52 = inv & IFMA_DIGIT_MASK;
+  unsigned long carry = 0;
+  for (int i = 0; i < kf; i++) {
+    unsigned long prev_hi = i > 0 ? th[i - 1] : 0;
+    unsigned long t = tl[i] + prev_hi + carry;
+    unsigned long q = (t * inv52) & IFMA_DIGIT_MASK;
+    ifma_mul_add_row(tl + i, th + i, nd, q, chunks);
+    t = tl[i] + prev_hi + carry;
+    assert((t & IFMA_DIGIT_MASK) == 0, "broken Montgomery multiply");
+    carry = t >> IFMA_DIGIT_BITS;
+  }
+  __asm__ volatile("vzeroupper" ::: "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+
+  // Normalize what is left into longwords.
+  memset(v, 0, (len + 2) * sizeof(unsigned long));
+  int vbit = 0;
+  for (int d = kf; d < acc_len && vbit < 64 * (len + 2); d++) {
+    unsigned long t = tl[d] + th[d - 1] + carry;
+    unsigned long digit = t & IFMA_DIGIT_MASK;
+    carry = t >> IFMA_DIGIT_BITS;
+    int limb = vbit / 64, off = vbit % 64;
+    v[limb] |= digit << off;
+    if (off > 64 - IFMA_DIGIT_BITS && limb + 1 < len + 2) {
+      v[limb + 1] |= digit >> (64 - off);
+    }
+    vbit += IFMA_DIGIT_BITS;
+  }
+
+  // Last partial step over the remaining r bits.
+  if (r > 0) {
+    unsigned long q = (v[0] * inv) & ((1UL << r) - 1);
+    uint128 acc = 0;
+    for (int j = 0; j < len; j++) {
+      acc += (uint128)q * n[j] + v[j];
+      v[j] = (unsigned long)acc;
+      acc >>= 64;
+    }
+    for (int j = len; j < len + 2; j++) {
+      acc += v[j];
+      v[j] = (unsigned long)acc;
+      acc >>= 64;
+    }
+    assert((v[0] & ((1UL << r) - 1)) == 0, "broken Montgomery multiply");
+    for (int j = 0; j < len + 1; j++) {
+      v[j] = (v[j] >> r) | (v[j + 1] << (64 - r));
+    }
+    v[len + 1] >>= r;
+  }
+
+  memcpy(m, v, len * sizeof(unsigned long));
+  unsigned long t0 = v[len];
+  while (t0)
+    t0 = sub(m, n, t0, len);
+}
+
 // Swap words in a longword.
 static unsigned long swap(unsigned long x) {
   return (x << 32) | (x >> 32);
@@ -3868,6 +4043,17 @@ static void reverse_words(unsigned long *s, unsigned long *d, int len) {
 // experimentally on an i7-3930K (Ivy Bridge) CPU @ 3.5GHz.
 #define MONTGOMERY_SQUARING_THRESHOLD 64
 
+// Operand sizes in jints for which the IFMA multiply beats the scalar
+// code: below 2048 bits the digit conversion dominates, and above
+// 4096 bits its scratch space would exceed the stack budget below.
+#define MONTGOMERY_IFMA_MIN_LEN 64
+#define MONTGOMERY_IFMA_MAX_LEN 128
+
+static bool use_montgomery_ifma(jint len) {
+  return UseAVX > 2 && VM_Version::supports_avx512ifma() &&
+         len >= MONTGOMERY_IFMA_MIN_LEN && len <= MONTGOMERY_IFMA_MAX_LEN;
+}
+
 void SharedRuntime::montgomery_multiply(jint *a_ints, jint *b_ints, jint *n_ints,
                                         jint len, jlong inv,
                                         jint *m_ints) {
@@ -3892,7 +4078,11 @@ void SharedRuntime::montgomery_multiply(jint *a_ints, jint *b_ints, jint *n_ints
   reverse_words((unsigned long *)b_ints, b, longwords);
   reverse_words((unsigned long *)n_ints, n, longwords);
 
-  ::montgomery_multiply(a, b, n, m, (unsigned long)inv, longwords);
+  if (use_montgomery_ifma(len)) {
+    montgomery_multiply_ifma(a, b, n, m, (unsigned long)inv, longwords);
+  } else {
+    ::montgomery_multiply(a, b, n, m, (unsigned long)inv, longwords);
+  }
 
   reverse_words(m, (unsigned long *)m_ints, longwords);
 }
@@ -3919,7 +4109,9 @@ void SharedRuntime::montgomery_square(jint *a_ints, jint *n_ints,
   reverse_words((unsigned long *)a_ints, a, longwords);
   reverse_words((unsigned long *)n_ints, n, longwords);
 
-  if (len >= MONTGOMERY_SQUARING_THRESHOLD) {
+  if (use_montgomery_ifma(len)) {
+    montgomery_multiply_ifma(a, a, n, m, (unsigned long)inv, longwords);
+  } else if (len >= MONTGOMERY_SQUARING_THRESHOLD) {
     ::montgomery_square(a, n, m, (unsigned long)inv, longwords);
   } else {
     ::montgomery_multiply(a, a, n, m, (unsigned long)inv, longwords);
@@ -1269,6 +1269,74 @@ class StubGenerator: public StubCodeGenerator {
 #endif
   }
 
+  // Size-tiered dispatch for big forward copies. Copies of at least
+  // ArrayCopyNonTemporalThreshold bytes are done with non-temporal stores
+  // so that they do not evict the whole last-level cache; byte copies of
+  // at least ArrayCopyRepMovsbThreshold bytes use rep movsb. Anything
+  // smaller continues at L_vector. Both tiers leave qword_count in the
+  // state the vector loop would: L_loop_exit expects it in (0, 8] and
+  // L_end expects 4 when everything has been copied.
+  //
+  // rep movsb is restricted to byte copies since it gives no element
+  // atomicity guarantees.
+  //
+  void copy_bytes_forward_large(Register end_from, Register end_to,
+                                Register qword_count, Register to,
+                                bool use_rep_movsb,
+                                Label& L_vector, Label& L_loop_exit, Label& L_end) {
+    use_rep_movsb = use_rep_movsb && ArrayCopyRepMovsbThreshold > 0;
+    bool use_non_temporal = ArrayCopyNonTemporalThreshold > 0;
+    if (!use_rep_movsb && !use_non_temporal) {
+      return;
+    }
+
+    Label L_rep_movsb, L_nt_loop, L_nt_entry;
+    if (use_non_temporal) {
+      __ cmpptr(qword_count, -1 * (ArrayCopyNonTemporalThreshold / 8));
+      __ jcc(Assembler::lessEqual, L_nt_entry);
+    }
+    if (use_rep_movsb) {
+      __ cmpptr(qword_count, -1 * (ArrayCopyRepMovsbThreshold / 8));
+      __ jcc(Assembler::lessEqual, L_rep_movsb);
+    }
+    __ jmp(L_vector);
+
+    if (use_rep_movsb) {
+      assert_different_registers(qword_count, rcx, rsi, rdi, to);
+      __ BIND(L_rep_movsb);
+      __ push(rcx);
+      __ push(rsi);
+      __ push(rdi);
+      __ lea(to, Address(end_from, qword_count, Address::times_8, 8));
+      __ lea(rdi, Address(end_to, qword_count, Address::times_8, 8));
+      __ movptr(rsi, to);
+      __ movptr(rcx, qword_count);
+      __ negptr(rcx);
+      __ shlptr(rcx, 3);
+      __ rep_movsb();
+      __ pop(rdi);
+      __ pop(rsi);
+      __ pop(rcx);
+      __ movptr(qword_count, 4);
+      __ jmp(L_end);
+    }
+
+    if (use_non_temporal) {
+      __ align(OptoLoopAlignment);
+      __ BIND(L_nt_loop);
+      for (int i = -56; i <= 0; i += 8) {
+        __ movq(to, Address(end_from, qword_count, Address::times_8, i));
+        __ movntiq(Address(end_to, qword_count, Address::times_8, i), to);
+      }
+      __ BIND(L_nt_entry);
+      __ addptr(qword_count, 8);
+      __ jcc(Assembler::lessEqual, L_nt_loop);
+      // Non-temporal stores are weakly ordered
+      __ sfence();
+      __ jmp(L_loop_exit);
+    }
+  }
+
   // Copy big chunks forward
   //
   // Inputs:
@@ -1278,10 +1346,12 @@ class StubGenerator: public StubCodeGenerator {
   //   to           - scratch
   //   L_copy_bytes - entry label
   //   L_copy_8_bytes  - exit  label
+  //   use_rep_movsb - byte copy, rep movsb may be used for large counts
   //
   void copy_bytes_forward(Register end_from, Register end_to,
                              Register qword_count, Register to,
-                             Label& L_copy_bytes, Label& L_copy_8_bytes) {
+                             Label& L_copy_bytes, Label& L_copy_8_bytes,
+                             bool use_rep_movsb = false) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
     Label L_loop;
     __ align(OptoLoopAlignment);
@@ -1290,8 +1360,12 @@ class StubGenerator: public StubCodeGenerator {
       // Copy 64-bytes per iteration
       if (UseAVX > 2) {
         Label L_loop_avx512, L_loop_avx2, L_32_byte_head, L_above_threshold, L_below_threshold;
+        Label L_vector;
 
         __ BIND(L_copy_bytes);
+        copy_bytes_forward_large(end_from, end_to, qword_count, to, use_rep_movsb,
+                                 L_vector, L_32_byte_head, L_end);
+        __ BIND(L_vector);
         __ cmpptr(qword_count, (-1 * AVX3Threshold / 8));
         __ jccb(Assembler::less, L_above_threshold);
         __ jmpb(L_below_threshold);
@@ -1317,6 +1391,14 @@ class StubGenerator: public StubCodeGenerator {
         __ subptr(qword_count, 4);  // sub(8) and add(4)
         __ jccb(Assembler::greater, L_end);
       } else {
+        Label L_vector, L_loop_exit;
+
+        __ BIND(L_copy_bytes);
+        copy_bytes_forward_large(end_from, end_to, qword_count, to, use_rep_movsb,
+                                 L_vector, L_loop_exit, L_end);
+        __ jmp(L_vector);
+
+        __ align(OptoLoopAlignment);
         __ BIND(L_loop);
         if (UseAVX == 2) {
           __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
@@ -1334,9 +1416,10 @@ class StubGenerator: public StubCodeGenerator {
           __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
         }
 
-        __ BIND(L_copy_bytes);
+        __ BIND(L_vector);
         __ addptr(qword_count, 8);
         __ jcc(Assembler::lessEqual, L_loop);
+        __ BIND(L_loop_exit);
         __ subptr(qword_count, 4);  // sub(8) and add(4)
         __ jccb(Assembler::greater, L_end);
       }
@@ -1593,7 +1676,7 @@ class StubGenerator: public StubCodeGenerator {
     {
       UnsafeCopyMemoryMark ucmm(this, !aligned, false, ucme_exit_pc);
       // Copy in multi-bytes chunks
-      copy_bytes_forward(end_from, end_to, qword_count, rax, L_copy_bytes, L_copy_8_bytes);
+      copy_bytes_forward(end_from, end_to, qword_count, rax, L_copy_bytes, L_copy_8_bytes, true);
       __ jmp(L_copy_4_bytes);
     }
     return start;
@@ -2557,6 +2640,123 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  //
+  //  Generate 'unsafe' set memory stub
+  //  Though just as safe as the other stubs, it takes an unscaled
+  //  size_t argument instead of an element count.
+  //
+  //  Input:
+  //    c_rarg0   - destination address
+  //    c_rarg1   - byte count (size_t), can be zero
+  //    c_rarg2   - byte value
+  //
+  // Examines the alignment of the operands and fills memory with the
+  // widest unit that alignment permits, so every unit is stored atomically
+  // just like Copy::fill_to_memory_atomic. Bulk long-aligned fills use
+  // 16 (or, with AVX2, 32) byte vector stores.
+  //
+  address generate_unsafe_setmemory(const char *name) {
+    Label L_exit, L_not_long, L_not_int, L_not_short;
+
+    const Register dest = c_rarg0;
+    const Register size = c_rarg1;
+    const Register byte = c_rarg2;
+
+    const Register value = rax;    // byte value replicated into all lanes
+    const Register bits  = r10;    // test copy of low bits
+    const Register ones  = r11;
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ movzbl(value, byte);
+    __ mov64(ones, 0x0101010101010101);
+    __ imulq(value, ones);
+
+    __ mov(bits, dest);
+    __ orptr(bits, size);
+
+    {
+      // UnsafeCopyMemory page error: continue at L_exit
+      UnsafeCopyMemoryMark ucmm(this, true, true);
+
+      __ testb(bits, BytesPerLong-1);
+      __ jcc(Assembler::notZero, L_not_long);
+      {
+        Label L_loop, L_tail, L_tail_loop;
+        const int vec_size = UseAVX >= 2 ? 32 : 16;
+        __ movdq(xmm0, value);
+        if (UseAVX >= 2) {
+          __ vpbroadcastq(xmm0, xmm0, Assembler::AVX_256bit);
+        } else {
+          __ punpcklqdq(xmm0, xmm0);
+        }
+        __ cmpptr(size, vec_size);
+        __ jccb(Assembler::below, L_tail);
+      __ BIND(L_loop);
+        if (UseAVX >= 2) {
+          __ vmovdqu(Address(dest, 0), xmm0);
+        } else {
+          __ movdqu(Address(dest, 0), xmm0);
+        }
+        __ addptr(dest, vec_size);
+        __ subptr(size, vec_size);
+        __ cmpptr(size, vec_size);
+        __ jccb(Assembler::aboveEqual, L_loop);
+      __ BIND(L_tail);
+        __ testptr(size, size);
+        __ jccb(Assembler::zero, L_exit);
+      __ BIND(L_tail_loop);
+        __ movq(Address(dest, 0), value);
+        __ addptr(dest, BytesPerLong);
+        __ subptr(size, BytesPerLong);
+        __ jccb(Assembler::notZero, L_tail_loop);
+        __ jmp(L_exit);
+      }
+
+    __ BIND(L_not_long);
+      __ testb(bits, BytesPerInt-1);
+      __ jccb(Assembler::notZero, L_not_int);
+      fill_unsafe_memory_units(dest, size, value, BytesPerInt, L_exit);
+
+    __ BIND(L_not_int);
+      __ testb(bits, BytesPerShort-1);
+      __ jccb(Assembler::notZero, L_not_short);
+      fill_unsafe_memory_units(dest, size, value, BytesPerShort, L_exit);
+
+    __ BIND(L_not_short);
+      fill_unsafe_memory_units(dest, size, value, 1, L_exit);
+    }
+  __ BIND(L_exit);
+    __ vzeroupper();
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  // Store 'value' to [dest, dest + size) in 'unit' sized pieces and
+  // jump to L_exit. 'size' must be a multiple of 'unit'.
+  void fill_unsafe_memory_units(Register dest, Register size, Register value, int unit, Label& L_exit) {
+    Label L_loop;
+    __ testptr(size, size);
+    __ jcc(Assembler::zero, L_exit);
+  __ BIND(L_loop);
+    switch (unit) {
+      case BytesPerInt:   __ movl(Address(dest, 0), value); break;
+      case BytesPerShort: __ movw(Address(dest, 0), value); break;
+      case 1:             __ movb(Address(dest, 0), value); break;
+      default:            ShouldNotReachHere();
+    }
+    __ addptr(dest, unit);
+    __ subptr(size, unit);
+    __ jccb(Assembler::notZero, L_loop);
+    __ jmp(L_exit);
+  }
+
   //
   //  Generate 'unsafe' array copy stub
   //  Though just as safe as the other stubs, it takes an unscaled
@@ -3064,6 +3264,7 @@ class StubGenerator: public StubCodeGenerator {
                                                               entry_jshort_arraycopy,
                                                               entry_jint_arraycopy,
                                                               entry_jlong_arraycopy);
+    StubRoutines::_unsafe_setmemory    = generate_unsafe_setmemory("unsafe_setmemory");
     StubRoutines::_generic_arraycopy   = generate_generic_copy("generic_arraycopy",
                                                                entry_jbyte_arraycopy,
                                                                entry_jshort_arraycopy,
@@ -5396,6 +5597,167 @@ address generate_avx_ghash_processBlocks() {
     return start;
   }
 
+  // Load eight elements of type bt from src and widen them to eight ints in dst.
+  void hashcode_load_widen(XMMRegister dst, Address src, BasicType bt) {
+    switch (bt) {
+    case T_BOOLEAN:
+      __ vpmovzxbw(dst, src, Assembler::AVX_128bit);
+      __ vpmovzxwd(dst, dst, Assembler::AVX_256bit);
+      break;
+    case T_BYTE:
+      __ movq(dst, src);
+      __ vpmovsxbw(dst, dst, Assembler::AVX_128bit);
+      __ vpmovsxwd(dst, dst, Assembler::AVX_256bit);
+      break;
+    case T_CHAR:
+      __ movdqu(dst, src);
+      __ vpmovzxwd(dst, dst, Assembler::AVX_256bit);
+      break;
+    case T_SHORT:
+      __ movdqu(dst, src);
+      __ vpmovsxwd(dst, dst, Assembler::AVX_256bit);
+      break;
+    case T_INT:
+      __ vmovdqu(dst, src);
+      break;
+    default:
+      ShouldNotReachHere();
+    }
+  }
+
+  // Load a single element of type bt from src, extended to an int in dst.
+  void hashcode_load_scalar(Register dst, Address src, BasicType bt) {
+    switch (bt) {
+    case T_BOOLEAN: __ movzbl(dst, src); break;
+    case T_BYTE:    __ movsbl(dst, src); break;
+    case T_CHAR:    __ movzwl(dst, src); break;
+    case T_SHORT:   __ movswl(dst, src); break;
+    case T_INT:     __ movl(dst, src);   break;
+    default:
+      ShouldNotReachHere();
+    }
+  }
+
+  /**
+  *  Arguments:
+  *
+  *  Input:
+  *    c_rarg0   - ary      address of the first element
+  *    c_rarg1   - cnt      number of elements
+  *    c_rarg2   - result   initial hash value
+  *    c_rarg3   - bt       BasicType of the elements (T_BOOLEAN is an unsigned byte)
+  *
+  *  Output:
+  *        rax   - int, result = 31 * result + ary[i] for each element in order
+  *
+  *  Eight int lanes are accumulated as acc = acc * 31^8 + ary[8k .. 8k+7] while
+  *  31^(8K) is tracked in a scalar register; the lanes are then folded as
+  *  result = result * 31^(8K) + sum(acc[j] * 31^(7-j)) and the remaining
+  *  elements are hashed one at a time.
+  */
+  address generate_vectorizedHashCode() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedHashCode");
+
+    // Lane weights 31^7 .. 31^0 for the final reduction.
+    address powers = __ pc();
+    __ emit_data64(0x34E63B4167E12CDF, relocInfo::none);
+    __ emit_data64(0x000E178101B4D89F, relocInfo::none);
+    __ emit_data64(0x000003C10000745F, relocInfo::none);
+    __ emit_data64(0x000000010000001F, relocInfo::none);
+
+    __ align(CodeEntryAlignment);
+    address start = __ pc();
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+
+    // Win64: rcx, rdx, r8, r9; Unix: rdi, rsi, rdx, rcx (c_rarg0, c_rarg1, ...)
+    const Register ary    = c_rarg0;
+    const Register cnt    = c_rarg1;
+    const Register pow    = c_rarg2;  // initial value is moved to result first
+    const Register bt     = c_rarg3;
+    const Register tmp    = r10;
+    const Register result = rax;
+    // xmm0-xmm5 are volatile on both Win64 and Unix.
+    const XMMRegister vacc = xmm0;
+    const XMMRegister vmul = xmm1;
+    const XMMRegister vtmp = xmm2;
+
+    const jint pow31_8 = (jint)0x94446F01; // 31^8 mod 2^32
+
+    __ movl(result, c_rarg2);
+
+    static const BasicType types[] = { T_BOOLEAN, T_BYTE, T_CHAR, T_SHORT, T_INT };
+    const int ntypes = (int)(sizeof(types) / sizeof(types[0]));
+    Label L_type[ntypes], L_done;
+
+    for (int t = 0; t < ntypes; t++) {
+      __ cmpl(bt, types[t]);
+      __ jcc(Assembler::equal, L_type[t]);
+    }
+    __ stop("vectorizedHashCode: unexpected basic type");
+
+    for (int t = 0; t < ntypes; t++) {
+      const BasicType type = types[t];
+      const int esize = type2aelembytes(type);
+      Label L_vector_loop, L_scalar, L_scalar_loop;
+
+      __ bind(L_type[t]);
+      __ cmpl(cnt, 8);
+      __ jcc(Assembler::less, L_scalar);
+
+      __ vpxor(vacc, vacc, vacc, Assembler::AVX_256bit);
+      __ movl(tmp, pow31_8);
+      __ movdl(vmul, tmp);
+      __ vpbroadcastd(vmul, vmul, Assembler::AVX_256bit);
+      __ movl(pow, 1);
+
+      __ bind(L_vector_loop);
+      __ vpmulld(vacc, vacc, vmul, Assembler::AVX_256bit);
+      hashcode_load_widen(vtmp, Address(ary, 0), type);
+      __ vpaddd(vacc, vacc, vtmp, Assembler::AVX_256bit);
+      __ imull(pow, pow, pow31_8);
+      __ addptr(ary, 8 * esize);
+      __ subl(cnt, 8);
+      __ cmpl(cnt, 8);
+      __ jcc(Assembler::greaterEqual, L_vector_loop);
+
+      // result = result * 31^(8K) + sum(acc[j] * 31^(7-j))
+      __ imull(result, pow);
+      __ lea(tmp, ExternalAddress(powers));
+      __ vpmulld(vacc, vacc, Address(tmp, 0), Assembler::AVX_256bit);
+      __ vextracti128_high(vtmp, vacc);
+      __ vpaddd(vacc, vacc, vtmp, Assembler::AVX_128bit);
+      __ vphaddd(vacc, vacc, vacc, Assembler::AVX_128bit);
+      __ vphaddd(vacc, vacc, vacc, Assembler::AVX_128bit);
+      __ movdl(tmp, vacc);
+      __ addl(result, tmp);
+
+      __ bind(L_scalar);
+      __ testl(cnt, cnt);
+      __ jcc(Assembler::zero, L_done);
+      __ bind(L_scalar_loop);
+      // result = 31 * result + ary[i]
+      __ movl(tmp, result);
+      __ shll(result, 5);
+      __ subl(result, tmp);
+      hashcode_load_scalar(tmp, Address(ary, 0), type);
+      __ addl(result, tmp);
+      __ addptr(ary, esize);
+      __ decrementl(cnt);
+      __ jcc(Assembler::notZero, L_scalar_loop);
+      __ jmp(L_done);
+    }
+
+    __ bind(L_done);
+    __ vzeroupper();
+    __ leave();
+    __ ret(0);
+
+    return start;
+  }
+
 /**
    *  Arguments:
    *
@@ -6203,6 +6565,10 @@ address generate_avx_ghash_processBlocks() {
     if (UseVectorizedMismatchIntrinsic) {
       StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
     }
+
+    if (UseVectorizedHashCodeIntrinsic) {
+      StubRoutines::_vectorizedHashCode = generate_vectorizedHashCode();
+    }
   }
 
  public:
@@ -6215,7 +6581,7 @@ address generate_avx_ghash_processBlocks() {
   }
 }; // end class declaration
 
-#define UCM_TABLE_MAX_ENTRIES 16
+#define UCM_TABLE_MAX_ENTRIES 17
 void StubGenerator_generate(CodeBuffer* code, bool all) {
   if (UnsafeCopyMemory::_table == NULL) {
     UnsafeCopyMemory::create_table(UCM_TABLE_MAX_ENTRIES);
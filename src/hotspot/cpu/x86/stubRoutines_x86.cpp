@@ -122,7 +122,12 @@ uint64_t StubRoutines::x86::_crc_by128_masks[] =
   ((uint64_t) 0xba8ccbe8U << 1), /* low  of K_160_96  */
   ((uint64_t) 0x6655004fU << 1), /* high of K_160_96  */
   ((uint64_t) 0xaa2215eaU << 1), /* low  of K_544_480 */
-  ((uint64_t) 0xe3720acbU << 1)  /* high of K_544_480 */
+  ((uint64_t) 0xe3720acbU << 1), /* high of K_544_480 */
+  /* Used to fold four 512-bit accumulators by 2048 bits in the
+   * VPCLMULQDQ loop of MacroAssembler::kernel_crc32.
+   */
+  ((uint64_t) 0x8aa13bc5U << 1), /* low  of K_2080_2016 */
+  ((uint64_t) 0x99168a18U << 1)  /* high of K_2080_2016 */
 };
 
 /**
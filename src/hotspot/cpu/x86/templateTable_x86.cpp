@@ -49,7 +49,9 @@ static const Register rlocals  = LP64_ONLY(r14) NOT_LP64(rdi);
 
 // Platform-dependent initialization
 void TemplateTable::pd_initialize() {
-  // No x86 specific initialization
+  const int ubcp = 1 << Template::uses_bcp_bit;
+  // aload_0, fast_bgetfield pair (byte and boolean fields of the receiver)
+  def(Bytecodes::_fast_baccess_0, ubcp, vtos, itos, fast_xaccess, btos);
 }
 
 // Address Computation: local variables
@@ -917,10 +919,11 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
   // _aload_0, _fast_igetfield
   // _aload_0, _fast_agetfield
   // _aload_0, _fast_fgetfield
+  // _aload_0, _fast_bgetfield
   //
   // occur frequently. If RewriteFrequentPairs is set, the (slow)
   // _aload_0 bytecode checks if the next bytecode is either
-  // _fast_igetfield, _fast_agetfield or _fast_fgetfield and then
+  // _fast_igetfield, _fast_agetfield, _fast_fgetfield or _fast_bgetfield and then
   // rewrites the current bytecode into a pair bytecode; otherwise it
   // rewrites the current bytecode into _fast_aload_0 that doesn't do
   // the pair check anymore.
@@ -964,6 +967,12 @@ void TemplateTable::aload_0_internal(RewriteControl rc) {
     __ movl(bc, Bytecodes::_fast_faccess_0);
     __ jccb(Assembler::equal, rewrite);
 
+    // if _bgetfield then rewrite to _fast_baccess_0
+    assert(Bytecodes::java_code(Bytecodes::_fast_baccess_0) == Bytecodes::_aload_0, "fix bytecode definition");
+    __ cmpl(rbx, Bytecodes::_fast_bgetfield);
+    __ movl(bc, Bytecodes::_fast_baccess_0);
+    __ jccb(Assembler::equal, rewrite);
+
     // else rewrite to _fast_aload0
     assert(Bytecodes::java_code(Bytecodes::_fast_aload_0) == Bytecodes::_aload_0, "fix bytecode definition");
     __ movl(bc, Bytecodes::_fast_aload_0);
@@ -3565,7 +3574,8 @@ void TemplateTable::fast_accessfield(TosState state) {
 }
 
 void TemplateTable::fast_xaccess(TosState state) {
-  transition(vtos, state);
+  // byte and boolean fields are loaded into itos
+  transition(vtos, state == btos ? itos : state);
 
   // get receiver
   __ movptr(rax, aaddress(0));
@@ -3591,6 +3601,9 @@ void TemplateTable::fast_xaccess(TosState state) {
   case ftos:
     __ access_load_at(T_FLOAT, IN_HEAP, noreg /* ftos */, field, noreg, noreg);
     break;
+  case btos:
+    __ access_load_at(T_BYTE, IN_HEAP, rax, field, noreg, noreg);
+    break;
   default:
     ShouldNotReachHere();
   }
@@ -72,7 +72,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     bool use_evex = FLAG_IS_DEFAULT(UseAVX) || (UseAVX > 2);
 
     Label detect_486, cpu486, detect_586, std_cpuid1, std_cpuid4;
-    Label sef_cpuid, ext_cpuid, ext_cpuid1, ext_cpuid5, ext_cpuid7, ext_cpuid8, done, wrapup;
+    Label sef_cpuid, ext_cpuid, ext_cpuid1, ext_cpuid5, ext_cpuid6, ext_cpuid7, ext_cpuid8, done, wrapup;
     Label legacy_setup, save_restore_except, legacy_save_restore, start_simd_check;
 
     StubCodeMark mark(this, "VM_Version", "get_cpu_info_stub");
@@ -201,7 +201,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ bind(std_cpuid4);
     __ movl(rax, 4);
     __ cmpl(rax, Address(rbp, in_bytes(VM_Version::std_cpuid0_offset()))); // Is cpuid(0x4) supported?
-    __ jccb(Assembler::greater, std_cpuid1);
+    __ jcc(Assembler::greater, std_cpuid1);
 
     __ xorl(rcx, rcx);   // L1 cache
     __ cpuid();
@@ -209,7 +209,7 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ andl(rax, 0x1f);  // Determine if valid cache parameters used
     __ orl(rax, rax);    // eax[4:0] == 0 indicates invalid cache
     __ pop(rax);
-    __ jccb(Assembler::equal, std_cpuid1);
+    __ jcc(Assembler::equal, std_cpuid1);
 
     __ lea(rsi, Address(rbp, in_bytes(VM_Version::dcp_cpuid4_offset())));
     __ movl(Address(rsi, 0), rax);
@@ -217,6 +217,15 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ movl(Address(rsi, 8), rcx);
     __ movl(Address(rsi,12), rdx);
 
+    __ movl(rax, 4);
+    __ movl(rcx, 3);     // L3 cache, validated by last_level_cache_size()
+    __ cpuid();
+    __ lea(rsi, Address(rbp, in_bytes(VM_Version::dcp_cpuid4_L3_offset())));
+    __ movl(Address(rsi, 0), rax);
+    __ movl(Address(rsi, 4), rbx);
+    __ movl(Address(rsi, 8), rcx);
+    __ movl(Address(rsi,12), rdx);
+
     //
     // Standard cpuid(0x1)
     //
@@ -272,14 +281,16 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ jcc(Assembler::belowEqual, done);
     __ cmpl(rax, 0x80000004);     // Is cpuid(0x80000005) supported?
     __ jcc(Assembler::belowEqual, ext_cpuid1);
+    __ cmpl(rax, 0x80000005);     // Is cpuid(0x80000006) supported?
+    __ jcc(Assembler::belowEqual, ext_cpuid5);
     __ cmpl(rax, 0x80000006);     // Is cpuid(0x80000007) supported?
-    __ jccb(Assembler::belowEqual, ext_cpuid5);
+    __ jcc(Assembler::belowEqual, ext_cpuid6);
     __ cmpl(rax, 0x80000007);     // Is cpuid(0x80000008) supported?
-    __ jccb(Assembler::belowEqual, ext_cpuid7);
+    __ jcc(Assembler::belowEqual, ext_cpuid7);
     __ cmpl(rax, 0x80000008);     // Is cpuid(0x80000009 and above) supported?
-    __ jccb(Assembler::belowEqual, ext_cpuid8);
+    __ jcc(Assembler::belowEqual, ext_cpuid8);
     __ cmpl(rax, 0x8000001E);     // Is cpuid(0x8000001E) supported?
-    __ jccb(Assembler::below, ext_cpuid8);
+    __ jcc(Assembler::below, ext_cpuid8);
     //
     // Extended cpuid(0x8000001E)
     //
@@ -315,6 +326,18 @@ class VM_Version_StubGenerator: public StubCodeGenerator {
     __ movl(Address(rsi, 8), rcx);
     __ movl(Address(rsi,12), rdx);
 
+    //
+    // Extended cpuid(0x80000006)
+    //
+    __ bind(ext_cpuid6);
+    __ movl(rax, 0x80000006);
+    __ cpuid();
+    __ lea(rsi, Address(rbp, in_bytes(VM_Version::ext_cpuid6_offset())));
+    __ movl(Address(rsi, 0), rax);
+    __ movl(Address(rsi, 4), rbx);
+    __ movl(Address(rsi, 8), rcx);
+    __ movl(Address(rsi,12), rdx);
+
     //
     // Extended cpuid(0x80000005)
     //
@@ -689,6 +712,7 @@ void VM_Version::get_processor_features() {
     _features &= ~CPU_AVX512_VPOPCNTDQ;
     _features &= ~CPU_VPCLMULQDQ;
     _features &= ~CPU_VAES;
+    _features &= ~CPU_AVX512_IFMA;
   }
 
   if (UseAVX < 2)
@@ -1094,6 +1118,11 @@ void VM_Version::get_processor_features() {
   if (FLAG_IS_DEFAULT(UseMontgomerySquareIntrinsic)) {
     UseMontgomerySquareIntrinsic = true;
   }
+#ifdef COMPILER2
+  if (FLAG_IS_DEFAULT(UseCharacterCompareIntrinsics)) {
+    FLAG_SET_DEFAULT(UseCharacterCompareIntrinsics, true);
+  }
+#endif
 #else
   if (UseMultiplyToLenIntrinsic) {
     if (!FLAG_IS_DEFAULT(UseMultiplyToLenIntrinsic)) {
@@ -1370,6 +1399,15 @@ void VM_Version::get_processor_features() {
       warning("vectorizedMismatch intrinsics are not available on this CPU");
     FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
   }
+  if (UseAVX >= 2) {
+    if (FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      UseVectorizedHashCodeIntrinsic = true;
+    }
+  } else if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic))
+      warning("vectorizedHashCode intrinsic requires AVX2 instructions on this CPU");
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
 #else
   if (UseVectorizedMismatchIntrinsic) {
     if (!FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
@@ -1377,6 +1415,12 @@ void VM_Version::get_processor_features() {
     }
     FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
   }
+  if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      warning("vectorizedHashCode intrinsic is not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
 #endif // _LP64
 
   // Use count leading zeros count instruction if available.
@@ -1455,6 +1499,21 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseXMMForObjInit, false);
   }
 
+#ifdef _LP64
+  // Large disjoint copies: rep movsb is competitive with the vector loop
+  // once the copy is a few KB on CPUs with enhanced rep movsb, and stores
+  // that would not fit in the LLC anyway are better off bypassing it.
+  if (FLAG_IS_DEFAULT(ArrayCopyRepMovsbThreshold) && supports_erms() && UseUnalignedLoadStores) {
+    FLAG_SET_DEFAULT(ArrayCopyRepMovsbThreshold, 2048);
+  }
+  if (FLAG_IS_DEFAULT(ArrayCopyNonTemporalThreshold) && UseUnalignedLoadStores) {
+    size_t llc_size = last_level_cache_size();
+    if (llc_size > 0) {
+      FLAG_SET_DEFAULT(ArrayCopyNonTemporalThreshold, (intx)MIN2(llc_size / 2, (size_t)max_jint));
+    }
+  }
+#endif
+
 #ifdef COMPILER2
   if (FLAG_IS_DEFAULT(AlignVector)) {
     // Modern processors allow misaligned memory operations for vectors.
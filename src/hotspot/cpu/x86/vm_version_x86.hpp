@@ -219,7 +219,9 @@ class VM_Version : public Abstract_VM_Version {
                avx512dq : 1,
                         : 1,
                     adx : 1,
-                        : 3,
+                        : 1,
+             avx512ifma : 1,
+                        : 1,
              clflushopt : 1,
                    clwb : 1,
                         : 1,
@@ -345,6 +347,7 @@ protected:
 #define CPU_FLUSH ((uint64_t)UCONST64(0x20000000000))  // flush instruction
 #define CPU_FLUSHOPT ((uint64_t)UCONST64(0x40000000000)) // flushopt instruction
 #define CPU_CLWB ((uint64_t)UCONST64(0x80000000000))   // clwb instruction
+#define CPU_AVX512_IFMA ((uint64_t)UCONST64(0x100000000000)) // 52-bit integer fused multiply-add
 
 enum Extended_Family {
     // AMD
@@ -394,6 +397,12 @@ enum Extended_Family {
     uint32_t     dcp_cpuid4_ecx; // unused currently
     uint32_t     dcp_cpuid4_edx; // unused currently
 
+    // cpuid function 4, ecx = 3 (L3 cache parameters, if present)
+    uint32_t     dcp_cpuid4_L3_eax;
+    uint32_t     dcp_cpuid4_L3_ebx;
+    uint32_t     dcp_cpuid4_L3_ecx;
+    uint32_t     dcp_cpuid4_L3_edx; // unused currently
+
     // cpuid function 7 (structured extended features)
     SefCpuid7Eax sef_cpuid7_eax;
     SefCpuid7Ebx sef_cpuid7_ebx;
@@ -442,6 +451,12 @@ enum Extended_Family {
     ExtCpuid5Ex  ext_cpuid5_ecx; // L1 data cache info (AMD)
     ExtCpuid5Ex  ext_cpuid5_edx; // L1 instruction cache info (AMD)
 
+    // cpuid function 0x80000006 // AMD L2/L3, Intel L2
+    uint32_t     ext_cpuid6_eax; // unused currently
+    uint32_t     ext_cpuid6_ebx; // unused currently
+    uint32_t     ext_cpuid6_ecx; // unused currently
+    uint32_t     ext_cpuid6_edx; // L3 cache info (AMD)
+
     // cpuid function 0x80000007
     uint32_t     ext_cpuid7_eax; // reserved
     uint32_t     ext_cpuid7_ebx; // reserved
@@ -559,6 +574,8 @@ enum Extended_Family {
           result |= CPU_AVX512BW;
         if (_cpuid_info.sef_cpuid7_ebx.bits.avx512vl != 0)
           result |= CPU_AVX512VL;
+        if (_cpuid_info.sef_cpuid7_ebx.bits.avx512ifma != 0)
+          result |= CPU_AVX512_IFMA;
         if (_cpuid_info.sef_cpuid7_ecx.bits.avx512_vpopcntdq != 0)
           result |= CPU_AVX512_VPOPCNTDQ;
         if (_cpuid_info.sef_cpuid7_ecx.bits.vpclmulqdq != 0)
@@ -676,9 +693,11 @@ public:
   static ByteSize std_cpuid0_offset() { return byte_offset_of(CpuidInfo, std_max_function); }
   static ByteSize std_cpuid1_offset() { return byte_offset_of(CpuidInfo, std_cpuid1_eax); }
   static ByteSize dcp_cpuid4_offset() { return byte_offset_of(CpuidInfo, dcp_cpuid4_eax); }
+  static ByteSize dcp_cpuid4_L3_offset() { return byte_offset_of(CpuidInfo, dcp_cpuid4_L3_eax); }
   static ByteSize sef_cpuid7_offset() { return byte_offset_of(CpuidInfo, sef_cpuid7_eax); }
   static ByteSize ext_cpuid1_offset() { return byte_offset_of(CpuidInfo, ext_cpuid1_eax); }
   static ByteSize ext_cpuid5_offset() { return byte_offset_of(CpuidInfo, ext_cpuid5_eax); }
+  static ByteSize ext_cpuid6_offset() { return byte_offset_of(CpuidInfo, ext_cpuid6_eax); }
   static ByteSize ext_cpuid7_offset() { return byte_offset_of(CpuidInfo, ext_cpuid7_eax); }
   static ByteSize ext_cpuid8_offset() { return byte_offset_of(CpuidInfo, ext_cpuid8_eax); }
   static ByteSize ext_cpuid1E_offset() { return byte_offset_of(CpuidInfo, ext_cpuid1E_eax); }
@@ -806,6 +825,26 @@ public:
     return result;
   }
 
+  // Size in bytes of the last-level (L3) cache, or 0 if it is unknown.
+  static size_t last_level_cache_size() {
+    if (is_intel() || is_zx()) {
+      uint32_t eax = _cpuid_info.dcp_cpuid4_L3_eax;
+      uint32_t ebx = _cpuid_info.dcp_cpuid4_L3_ebx;
+      // eax[4:0] is the cache type (0 == no cache), eax[7:5] the level
+      if ((eax & 0x1f) != 0 && ((eax >> 5) & 0x7) == 3) {
+        size_t ways       = ((ebx >> 22) & 0x3ff) + 1;
+        size_t partitions = ((ebx >> 12) & 0x3ff) + 1;
+        size_t line_size  = (ebx & 0xfff) + 1;
+        size_t sets       = (size_t)_cpuid_info.dcp_cpuid4_L3_ecx + 1;
+        return ways * partitions * line_size * sets;
+      }
+    } else if (is_amd_family()) {
+      // edx[31:18] is the L3 size in 512KB units
+      return (size_t)(_cpuid_info.ext_cpuid6_edx >> 18) * 512 * K;
+    }
+    return 0;
+  }
+
   static intx prefetch_data_size()  {
     return L1_line_size();
   }
@@ -858,6 +897,7 @@ public:
   static bool supports_vpclmulqdq() { return (_features & CPU_VPCLMULQDQ) != 0; }
   static bool supports_vaes()       { return (_features & CPU_VAES) != 0; }
   static bool supports_vnni()       { return (_features & CPU_VNNI) != 0; }
+  static bool supports_avx512ifma() { return (_features & CPU_AVX512_IFMA) != 0; }
 
   // Intel features
   static bool is_intel_family_core() { return is_intel() &&
@@ -925,3 +925,33 @@ bool NetworkPerformanceInterface::initialize() {
 int NetworkPerformanceInterface::network_utilization(NetworkInterface** network_interfaces) const {
   return _impl->network_utilization(network_interfaces);
 }
+
+class HardwareCounterInterface::HardwareCounters : public CHeapObj<mtInternal> {
+  friend class HardwareCounterInterface;
+ private:
+  HardwareCounters() {}
+  HardwareCounters(const HardwareCounters& rhs); // no impl
+  HardwareCounters& operator=(const HardwareCounters& rhs); // no impl
+  bool initialize() { return false; }
+  ~HardwareCounters() {}
+  int read_counters(HardwareCounterValues* values) const { return FUNCTIONALITY_NOT_IMPLEMENTED; }
+};
+
+HardwareCounterInterface::HardwareCounterInterface() {
+  _impl = NULL;
+}
+
+HardwareCounterInterface::~HardwareCounterInterface() {
+  if (_impl != NULL) {
+    delete _impl;
+  }
+}
+
+bool HardwareCounterInterface::initialize() {
+  _impl = new HardwareCounterInterface::HardwareCounters();
+  return _impl->initialize();
+}
+
+int HardwareCounterInterface::read_counters(HardwareCounterValues* values) const {
+  return _impl->read_counters(values);
+}
@@ -32,6 +32,7 @@
 
 #include <unistd.h>
 #include <signal.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -56,6 +57,14 @@
 // 2. When a client connect, the SO_PEERCRED socket option is used to
 //    obtain the credentials of client. We check that the effective uid
 //    of the client matches this process.
+//
+// A client that connects with protocol version 2 asks for the connection to
+// be kept open after the reply, so that a monitoring agent polling the VM
+// every few seconds does not pay for a connect and credential check each
+// time. Replies on such a connection are framed as "<result>\n<length>\n"
+// followed by <length> bytes of output, and the client must wait for a reply
+// before sending its next request. Idle persistent connections are polled
+// together with the listening socket, so they do not hold up other clients.
 
 // forward reference
 class LinuxAttachOperation;
@@ -71,12 +80,22 @@ class LinuxAttachListener: AllStatic {
 
   static bool _atexit_registered;
 
+  // connected sockets of persistent clients waiting for their next request
+  enum {
+    max_persistent_connections = 4
+  };
+  static int _connections[max_persistent_connections];
+
   // reads a request from the given connected socket
   static LinuxAttachOperation* read_request(int s);
 
+  // accepts a connection and checks the peer credentials, returns -1 on failure
+  static int accept_connection();
+
  public:
   enum {
-    ATTACH_PROTOCOL_VER = 1                     // protocol version
+    ATTACH_PROTOCOL_VER = 1,                    // protocol version
+    ATTACH_PROTOCOL_VER_PERSISTENT = 2          // keep connection after reply
   };
   enum {
     ATTACH_ERROR_BADVERSION     = 101           // error codes
@@ -105,6 +124,13 @@ class LinuxAttachListener: AllStatic {
   // write the given buffer to a socket
   static int write_fully(int s, char* buf, int len);
 
+  // hand a persistent connection back to be polled for the next request,
+  // returns false (and the caller closes the socket) if there is no room
+  static bool keep_connection(int s);
+
+  // close all persistent connections
+  static void close_connections();
+
   static LinuxAttachOperation* dequeue();
 };
 
@@ -113,14 +139,21 @@ class LinuxAttachOperation: public AttachOperation {
   // the connection to the client
   int _socket;
 
+  // true if the client asked to keep the connection open after the reply
+  bool _persistent;
+
  public:
   void complete(jint res, bufferedStream* st);
 
   void set_socket(int s)                                { _socket = s; }
   int socket() const                                    { return _socket; }
 
+  void set_persistent(bool p)                           { _persistent = p; }
+  bool is_persistent() const                            { return _persistent; }
+
   LinuxAttachOperation(char* name) : AttachOperation(name) {
     set_socket(-1);
+    set_persistent(false);
   }
 };
 
@@ -129,6 +162,7 @@ char LinuxAttachListener::_path[UNIX_PATH_MAX];
 bool LinuxAttachListener::_has_path;
 int LinuxAttachListener::_listener = -1;
 bool LinuxAttachListener::_atexit_registered = false;
+int LinuxAttachListener::_connections[max_persistent_connections] = { -1, -1, -1, -1 };
 
 // Supporting class to help split a buffer into individual components
 class ArgumentIterator : public StackObj {
@@ -169,6 +203,7 @@ extern "C" {
       ::shutdown(s, SHUT_RDWR);
       ::close(s);
     }
+    LinuxAttachListener::close_connections();
     if (LinuxAttachListener::has_path()) {
       ::unlink(LinuxAttachListener::path());
       LinuxAttachListener::set_path(NULL);
@@ -254,7 +289,7 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   // expected count and the maximum possible length of the request.
   // The request is:
   //   <ver>0<cmd>0<arg>0<arg>0<arg>0
-  // where <ver> is the protocol version (1), <cmd> is the command
+  // where <ver> is the protocol version (1 or 2), <cmd> is the command
   // name ("load", "datadump", ...), and <arg> is an argument
   int expected_str_count = 2 + AttachOperation::arg_count_max;
   const int max_len = (sizeof(ver_str) + 1) + (AttachOperation::name_length_max + 1) +
@@ -262,6 +297,7 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
 
   char buf[max_len];
   int str_count = 0;
+  bool persistent = false;
 
   // Read until all (expected) strings have been read, the buffer is
   // full, or EOF.
@@ -288,13 +324,15 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
         // The first string is <ver> so check it now to
         // check for protocol mis-match
         if (str_count == 1) {
+          int ver = atoi(buf);
           if ((strlen(buf) != strlen(ver_str)) ||
-              (atoi(buf) != ATTACH_PROTOCOL_VER)) {
+              (ver != ATTACH_PROTOCOL_VER && ver != ATTACH_PROTOCOL_VER_PERSISTENT)) {
             char msg[32];
             sprintf(msg, "%d\n", ATTACH_ERROR_BADVERSION);
             write_fully(s, msg, strlen(msg));
             return NULL;
           }
+          persistent = (ver == ATTACH_PROTOCOL_VER_PERSISTENT);
         }
       }
     }
@@ -334,40 +372,117 @@ LinuxAttachOperation* LinuxAttachListener::read_request(int s) {
   }
 
   op->set_socket(s);
+  op->set_persistent(persistent);
   return op;
 }
 
 
+// Accept a connection on the listening socket and check the credentials
+// of the peer. Returns the connected socket, or -1 if the peer was rejected.
+int LinuxAttachListener::accept_connection() {
+  int s;
+
+  struct sockaddr addr;
+  socklen_t len = sizeof(addr);
+  RESTARTABLE(::accept(listener(), &addr, &len), s);
+  if (s == -1) {
+    return -1;
+  }
+
+  // get the credentials of the peer and check the effective uid/guid
+  struct ucred cred_info;
+  socklen_t optlen = sizeof(cred_info);
+  if (::getsockopt(s, SOL_SOCKET, SO_PEERCRED, (void*)&cred_info, &optlen) == -1) {
+    log_debug(attach)("Failed to get socket option SO_PEERCRED");
+    ::close(s);
+    return -1;
+  }
+
+  if (!os::Posix::matches_effective_uid_and_gid_or_root(cred_info.uid, cred_info.gid)) {
+    log_debug(attach)("euid/egid check failed (%d/%d vs %d/%d)",
+            cred_info.uid, cred_info.gid, geteuid(), getegid());
+    ::close(s);
+    return -1;
+  }
+  return s;
+}
+
+bool LinuxAttachListener::keep_connection(int s) {
+  for (int i = 0; i < max_persistent_connections; i++) {
+    if (_connections[i] == -1) {
+      _connections[i] = s;
+      return true;
+    }
+  }
+  log_debug(attach)("Too many persistent attach connections, closing");
+  return false;
+}
+
+void LinuxAttachListener::close_connections() {
+  for (int i = 0; i < max_persistent_connections; i++) {
+    int s = _connections[i];
+    if (s != -1) {
+      _connections[i] = -1;
+      ::close(s);
+    }
+  }
+}
+
 // Dequeue an operation
 //
 // In the Linux implementation there is only a single operation and clients
-// cannot queue commands (except at the socket level).
+// cannot queue commands (except at the socket level). The listening socket
+// is polled together with any persistent connections; the first one that
+// is ready supplies the next request.
 //
 LinuxAttachOperation* LinuxAttachListener::dequeue() {
   for (;;) {
-    int s;
+    struct pollfd fds[1 + max_persistent_connections];
+    int slots[1 + max_persistent_connections];
+    int nfds = 0;
+
+    fds[nfds].fd = listener();
+    fds[nfds].events = POLLIN;
+    fds[nfds].revents = 0;
+    slots[nfds++] = -1;
+    for (int i = 0; i < max_persistent_connections; i++) {
+      if (_connections[i] != -1) {
+        fds[nfds].fd = _connections[i];
+        fds[nfds].events = POLLIN;
+        fds[nfds].revents = 0;
+        slots[nfds++] = i;
+      }
+    }
 
-    // wait for client to connect
-    struct sockaddr addr;
-    socklen_t len = sizeof(addr);
-    RESTARTABLE(::accept(listener(), &addr, &len), s);
-    if (s == -1) {
+    int n;
+    RESTARTABLE(::poll(fds, nfds, -1), n);
+    if (n == -1) {
       return NULL;      // log a warning?
     }
 
-    // get the credentials of the peer and check the effective uid/guid
-    struct ucred cred_info;
-    socklen_t optlen = sizeof(cred_info);
-    if (::getsockopt(s, SOL_SOCKET, SO_PEERCRED, (void*)&cred_info, &optlen) == -1) {
-      log_debug(attach)("Failed to get socket option SO_PEERCRED");
-      ::close(s);
+    // a persistent client sent its next request, or hung up
+    for (int i = 1; i < nfds; i++) {
+      if (fds[i].revents != 0) {
+        int s = fds[i].fd;
+        _connections[slots[i]] = -1;
+        LinuxAttachOperation* op = read_request(s);
+        if (op != NULL) {
+          return op;
+        }
+        ::close(s);
+      }
+    }
+
+    if ((fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+      return NULL;      // listener was closed
+    }
+    if (fds[0].revents == 0) {
       continue;
     }
 
-    if (!os::Posix::matches_effective_uid_and_gid_or_root(cred_info.uid, cred_info.gid)) {
-      log_debug(attach)("euid/egid check failed (%d/%d vs %d/%d)",
-              cred_info.uid, cred_info.gid, geteuid(), getegid());
-      ::close(s);
+    // wait for client to connect
+    int s = accept_connection();
+    if (s == -1) {
       continue;
     }
 
@@ -413,19 +528,31 @@ void LinuxAttachOperation::complete(jint result, bufferedStream* st) {
   // cleared by handle_special_suspend_equivalent_condition() or
   // java_suspend_self() via check_and_wait_while_suspended()
 
-  // write operation result
-  char msg[32];
-  sprintf(msg, "%d\n", result);
+  // write operation result, persistent clients also get the length of
+  // the result data since end-of-stream no longer delimits it
+  char msg[64];
+  if (is_persistent()) {
+    sprintf(msg, "%d\n" SIZE_FORMAT "\n", result, st->size());
+  } else {
+    sprintf(msg, "%d\n", result);
+  }
   int rc = LinuxAttachListener::write_fully(this->socket(), msg, strlen(msg));
 
   // write any result data
   if (rc == 0) {
-    LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
-    ::shutdown(this->socket(), 2);
+    rc = LinuxAttachListener::write_fully(this->socket(), (char*) st->base(), st->size());
+    if (rc == 0 && is_persistent() && LinuxAttachListener::keep_connection(this->socket())) {
+      // the socket is polled for the next request
+      set_socket(-1);
+    } else {
+      ::shutdown(this->socket(), 2);
+    }
   }
 
   // done
-  ::close(this->socket());
+  if (this->socket() != -1) {
+    ::close(this->socket());
+  }
 
   // were we externally suspended while we were waiting?
   thread->check_and_wait_while_suspended();
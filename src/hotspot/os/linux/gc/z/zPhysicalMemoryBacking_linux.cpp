@@ -104,9 +104,11 @@ void ZPhysicalMemoryBacking::warn_max_map_count(size_t max) const {
   // The required max map count is impossible to calculate exactly since subsystems
   // other than ZGC are also creating memory mappings, and we have no control over that.
   // However, ZGC tends to create the most mappings and dominate the total count.
-  // In the worst cases, ZGC will map each granule three times, i.e. once per heap view.
-  // We speculate that we need another 20% to allow for non-ZGC subsystems to map memory.
-  const size_t required_max_map_count = (max / ZGranuleSize) * 3 * 1.2;
+  // In the worst cases, ZGC will map each granule three times, i.e. once per heap view,
+  // or once when the heap views share a single mapping (ZUseTBI). We speculate that we
+  // need another 20% to allow for non-ZGC subsystems to map memory.
+  const size_t nviews = ZUseTBI ? 1 : 3;
+  const size_t required_max_map_count = (max / ZGranuleSize) * nviews * 1.2;
   if (actual_max_map_count < required_max_map_count) {
     log_warning(gc)("***** WARNING! INCORRECT SYSTEM CONFIGURATION DETECTED! *****");
     log_warning(gc)("The system limit on number of memory mappings per process might be too low for the given");
@@ -292,12 +294,20 @@ void ZPhysicalMemoryBacking::unmap_view(const ZPhysicalMemory& pmem, uintptr_t a
 }
 
 uintptr_t ZPhysicalMemoryBacking::nmt_address(uintptr_t offset) const {
+  if (ZUseTBI) {
+    // All heap views share a single mapping
+    return ZAddress::uncolored(offset);
+  }
+
   // From an NMT point of view we treat the first heap view (marked0) as committed
   return ZAddress::marked0(offset);
 }
 
 void ZPhysicalMemoryBacking::map(const ZPhysicalMemory& pmem, uintptr_t offset) const {
-  if (ZVerifyViews) {
+  if (ZUseTBI) {
+    // Map single view, colors are ignored by the hardware
+    map_view(pmem, ZAddress::uncolored(offset), AlwaysPreTouch);
+  } else if (ZVerifyViews) {
     // Map good view
     map_view(pmem, ZAddress::good(offset), AlwaysPreTouch);
   } else {
@@ -309,7 +319,10 @@ void ZPhysicalMemoryBacking::map(const ZPhysicalMemory& pmem, uintptr_t offset)
 }
 
 void ZPhysicalMemoryBacking::unmap(const ZPhysicalMemory& pmem, uintptr_t offset) const {
-  if (ZVerifyViews) {
+  if (ZUseTBI) {
+    // Unmap single view
+    unmap_view(pmem, ZAddress::uncolored(offset));
+  } else if (ZVerifyViews) {
     // Unmap good view
     unmap_view(pmem, ZAddress::good(offset));
   } else {
@@ -71,6 +71,14 @@
           "Increase the thread stack size to include space for glibc "  \
           "static thread-local storage (TLS) if true")                  \
                                                                         \
+  product(intx, NativeThreadPoolSize, 0,                                \
+          "Maximum number of native threads kept parked, with their "   \
+          "stacks, after their Java thread exits so that new Java "     \
+          "threads can start on them without creating a native thread. "\
+          "Pooled threads do not run pthread TSD destructors between "  \
+          "Java threads. 0 disables the pool")                          \
+          range(0, 1024)                                                \
+                                                                        \
   diagnostic(bool, DumpPrivateMappingsInCore, true,                     \
           "If true, sets bit 2 of /proc/PID/coredump_filter, thus "     \
           "resulting in file-backed private mappings of the process to "\
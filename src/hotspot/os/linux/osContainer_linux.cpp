@@ -161,9 +161,37 @@ class CgroupMemorySubsystem: CgroupSubsystem {
 
 };
 
+class CgroupCpuSubsystem: CgroupSubsystem {
+ friend class OSContainer;
+
+ private:
+    volatile int _active_processor_count;
+    volatile jlong _next_check_counter;
+
+ public:
+    CgroupCpuSubsystem(char *root, char *mountpoint) : CgroupSubsystem::CgroupSubsystem(root, mountpoint) {
+      _active_processor_count = -1;
+      _next_check_counter = min_jlong;
+    }
+
+    bool should_check_active_processor_count() {
+      return os::elapsed_counter() > _next_check_counter;
+    }
+    int active_processor_count() { return _active_processor_count; }
+    void set_active_processor_count(int value) {
+      _active_processor_count = value;
+      // The processor count is queried often, e.g. by every call of
+      // Runtime.availableProcessors(), and computing it reads three
+      // cgroup files. CPU limits can be changed on a running container,
+      // so, as for the memory limit, only cache it for a short (20ms)
+      // time.
+      _next_check_counter = os::elapsed_counter() + (NANOSECS_PER_SEC/50);
+    }
+};
+
 CgroupMemorySubsystem* memory = NULL;
 CgroupSubsystem* cpuset = NULL;
-CgroupSubsystem* cpu = NULL;
+CgroupCpuSubsystem* cpu = NULL;
 CgroupSubsystem* cpuacct = NULL;
 
 typedef char * cptr;
@@ -346,7 +374,7 @@ void OSContainer::init() {
       } else if (strcmp(token, "cpuset") == 0) {
         cpuset = new CgroupSubsystem(tmproot, tmpmount);
       } else if (strcmp(token, "cpu") == 0) {
-        cpu = new CgroupSubsystem(tmproot, tmpmount);
+        cpu = new CgroupCpuSubsystem(tmproot, tmpmount);
       } else if (strcmp(token, "cpuacct") == 0) {
         cpuacct= new CgroupSubsystem(tmproot, tmpmount);
       }
@@ -485,6 +513,12 @@ jlong OSContainer::memory_limit_in_bytes() {
     return memory->memory_limit_in_bytes();
   }
   jlong memory_limit = read_memory_limit_in_bytes();
+  jlong old_memory_limit = memory->memory_limit_in_bytes();
+  bool first_check = memory->_next_check_counter == min_jlong;
+  if (!first_check && memory_limit != old_memory_limit) {
+    log_info(os, container)("Memory Limit changed from " JLONG_FORMAT " to " JLONG_FORMAT,
+                            old_memory_limit, memory_limit);
+  }
   // Update CgroupMemorySubsystem to avoid re-reading container settings too often
   memory->set_memory_limit_in_bytes(memory_limit);
   return memory_limit;
@@ -613,6 +647,24 @@ jlong OSContainer::memory_max_usage_in_bytes() {
  *    number of CPUs
  */
 int OSContainer::active_processor_count() {
+  if (!cpu->should_check_active_processor_count()) {
+    int cached = cpu->active_processor_count();
+    log_trace(os, container)("OSContainer::active_processor_count (cached): %d", cached);
+    return cached;
+  }
+
+  int result = read_active_processor_count();
+  int old_result = cpu->active_processor_count();
+  bool first_check = cpu->_next_check_counter == min_jlong;
+  if (!first_check && result != old_result) {
+    log_info(os, container)("Active processor count changed from %d to %d", old_result, result);
+  }
+  // Update CgroupCpuSubsystem to avoid re-reading container settings too often
+  cpu->set_active_processor_count(result);
+  return result;
+}
+
+int OSContainer::read_active_processor_count() {
   int quota_count = 0, share_count = 0;
   int cpu_count, limit_count;
   int result;
@@ -37,6 +37,7 @@ class OSContainer: AllStatic {
   static bool   _is_initialized;
   static bool   _is_containerized;
   static jlong read_memory_limit_in_bytes();
+  static int read_active_processor_count();
 
  public:
   static void init();
@@ -45,6 +45,10 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  // Stack size passed to pthread_create() for this native thread; used
+  // to match pooled native threads against later thread requests.
+  size_t _pthread_stack_size;
+
  public:
 
   // Methods to save/restore caller's signal mask
@@ -68,6 +72,12 @@
   void set_pthread_id(pthread_t tid) {
     _pthread_id = tid;
   }
+  size_t pthread_stack_size() const {
+    return _pthread_stack_size;
+  }
+  void set_pthread_stack_size(size_t size) {
+    _pthread_stack_size = size;
+  }
 
   // ***************************************************************
   // suspension support.
@@ -734,8 +734,86 @@ bool os::Linux::manually_expand_stack(JavaThread * t, address addr) {
 //////////////////////////////////////////////////////////////////////////////
 // create new thread
 
-// Thread start routine for all newly created threads
-static void *thread_native_entry(Thread *thread) {
+// Native thread pool
+//
+// With NativeThreadPoolSize > 0 a native thread whose Java thread has
+// exited does not terminate.  It parks here, keeping its stack, until
+// os::create_thread() hands it a new Java thread with the same stack
+// size.  That saves the pthread_create()/clone() and the stack mmap for
+// threads that come and go frequently.  The pool entries live on the
+// stacks of the parked threads and are protected by _native_thread_pool_lock.
+
+class PooledNativeThread {
+ public:
+  pthread_t           _tid;
+  size_t              _stack_size;
+  Thread*             _next_thread;   // set by os::create_thread(); NULL while parked
+  pthread_cond_t      _cond;
+  PooledNativeThread* _next;
+};
+
+static pthread_mutex_t     _native_thread_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static PooledNativeThread* _native_thread_pool = NULL;
+static intx                _native_thread_pool_count = 0;
+
+// Parks the current native thread in the pool.  Returns the next Thread
+// to run on it, or NULL if the pool is full and the thread should exit.
+static Thread* park_in_native_thread_pool(size_t stack_size) {
+  PooledNativeThread entry;
+  entry._tid = pthread_self();
+  entry._stack_size = stack_size;
+  entry._next_thread = NULL;
+
+  pthread_mutex_lock(&_native_thread_pool_lock);
+  if (_native_thread_pool_count >= NativeThreadPoolSize) {
+    pthread_mutex_unlock(&_native_thread_pool_lock);
+    return NULL;
+  }
+  int status = pthread_cond_init(&entry._cond, NULL);
+  assert_status(status == 0, status, "pthread_cond_init");
+  entry._next = _native_thread_pool;
+  _native_thread_pool = &entry;
+  _native_thread_pool_count++;
+
+  log_debug(os, thread)("Thread parked in native thread pool (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
+    os::current_thread_id(), (uintx) pthread_self());
+
+  while (entry._next_thread == NULL) {
+    pthread_cond_wait(&entry._cond, &_native_thread_pool_lock);
+  }
+  pthread_mutex_unlock(&_native_thread_pool_lock);
+  pthread_cond_destroy(&entry._cond);
+  return entry._next_thread;
+}
+
+// Hands thread to a parked native thread of the given stack size, if
+// there is one.  Returns true and sets tid on success.
+static bool start_on_pooled_native_thread(Thread* thread, size_t stack_size, pthread_t* tid) {
+  if (NativeThreadPoolSize == 0) {
+    return false;
+  }
+  bool found = false;
+  pthread_mutex_lock(&_native_thread_pool_lock);
+  PooledNativeThread** link = &_native_thread_pool;
+  for (PooledNativeThread* p = *link; p != NULL; link = &p->_next, p = *link) {
+    if (p->_stack_size == stack_size) {
+      *link = p->_next;
+      _native_thread_pool_count--;
+      *tid = p->_tid;
+      p->_next_thread = thread;
+      // p stays valid until its owner reacquires the lock.
+      pthread_cond_signal(&p->_cond);
+      found = true;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_native_thread_pool_lock);
+  return found;
+}
+
+// Runs thread on the current native thread.  Returns the stack size to
+// pool the native thread under afterwards, or 0 if it must not be pooled.
+static size_t run_native_thread(Thread *thread) {
 
   thread->record_stack_base_and_size();
 
@@ -786,16 +864,36 @@ static void *thread_native_entry(Thread *thread) {
 
   assert(osthread->pthread_id() != 0, "pthread_id was not set as expected");
 
+  // Only plain Java threads are pooled; they are the ones created and
+  // destroyed at application rate.
+  size_t pool_stack_size = 0;
+  if (NativeThreadPoolSize > 0 && osthread->thread_type() == os::java_thread) {
+    pool_stack_size = osthread->pthread_stack_size();
+  }
+
   // call one more level start routine
   thread->call_run();
 
   // Note: at this point the thread object may already have deleted itself.
   // Prevent dereferencing it from here on out.
   thread = NULL;
+  osthread = NULL;
 
   log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
     os::current_thread_id(), (uintx) pthread_self());
 
+  return pool_stack_size;
+}
+
+// Thread start routine for all newly created threads
+static void *thread_native_entry(Thread *thread) {
+  while (thread != NULL) {
+    size_t pool_stack_size = run_native_thread(thread);
+    thread = NULL;
+    if (pool_stack_size != 0) {
+      thread = park_in_native_thread_pool(pool_stack_size);
+    }
+  }
   return 0;
 }
 
@@ -920,16 +1018,21 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
   int status = pthread_attr_setstacksize(&attr, stack_size);
   assert_status(status == 0, status, "pthread_attr_setstacksize");
 
+  osthread->set_pthread_stack_size(stack_size);
+
   ThreadState state;
 
   {
     pthread_t tid;
-    int ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
+    bool pooled = thr_type == os::java_thread &&
+                  start_on_pooled_native_thread(thread, stack_size, &tid);
+    int ret = pooled ? 0 : pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
 
     char buf[64];
     if (ret == 0) {
-      log_info(os, thread)("Thread started (pthread id: " UINTX_FORMAT ", attributes: %s). ",
-        (uintx) tid, os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr));
+      log_info(os, thread)("Thread started (pthread id: " UINTX_FORMAT ", attributes: %s)%s. ",
+        (uintx) tid, os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr),
+        pooled ? " on pooled native thread" : "");
     } else {
       log_warning(os, thread)("Failed to start thread - pthread_create failed (%s) for attributes: %s.",
         os::errno_name(ret), os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr));
@@ -2298,6 +2401,13 @@ void os::Linux::print_full_memory_info(outputStream* st) {
   st->print("\n/proc/meminfo:\n");
   _print_ascii_file("/proc/meminfo", st);
   st->cr();
+
+  // The kernel THP policy decides whether UseTransparentHugePages has
+  // any effect, so print it too.
+  _print_ascii_file("/sys/kernel/mm/transparent_hugepage/enabled", st,
+                    "/sys/kernel/mm/transparent_hugepage/enabled:");
+  _print_ascii_file("/sys/kernel/mm/transparent_hugepage/defrag", st,
+                    "/sys/kernel/mm/transparent_hugepage/defrag (defrag/compaction efforts parameter):");
 }
 
 void os::Linux::print_ld_preload_file(outputStream* st) {
@@ -3584,8 +3694,57 @@ bool os::unguard_memory(char* addr, size_t size) {
   return linux_mprotect(addr, size, PROT_READ|PROT_WRITE);
 }
 
+// Returns the mode of /sys/kernel/mm/transparent_hugepage/enabled. The
+// file lists all modes with the selected one in brackets, for example
+// "always [madvise] never".
+os::Linux::THPMode os::Linux::transparent_huge_pages_mode() {
+  THPMode mode = THP_unknown;
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp != NULL) {
+    char buf[64];
+    if (fgets(buf, sizeof(buf), fp) != NULL) {
+      if (strstr(buf, "[always]") != NULL) {
+        mode = THP_always;
+      } else if (strstr(buf, "[madvise]") != NULL) {
+        mode = THP_madvise;
+      } else if (strstr(buf, "[never]") != NULL) {
+        mode = THP_never;
+      }
+    }
+    fclose(fp);
+  }
+  return mode;
+}
+
+// Returns the size of the pages khugepaged and the THP fault path
+// allocate, or 0 if it can't be determined. This can differ from the
+// default hugetlbfs page size in /proc/meminfo.
+size_t os::Linux::transparent_huge_page_size() {
+  size_t page_size = 0;
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+  if (fp != NULL) {
+    julong x = 0;
+    if (fscanf(fp, JULONG_FORMAT, &x) == 1 && is_power_of_2(x)) {
+      page_size = (size_t)x;
+    }
+    fclose(fp);
+  }
+  return page_size;
+}
+
 bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
                                                     size_t page_size) {
+  THPMode mode = transparent_huge_pages_mode();
+  if (mode == THP_never) {
+    // madvise(MADV_HUGEPAGE) still succeeds, but no huge page will
+    // ever back the memory.
+    if (warn) {
+      warning("TransparentHugePages is disabled by the operating system "
+              "(/sys/kernel/mm/transparent_hugepage/enabled is never).");
+    }
+    return false;
+  }
+
   bool result = false;
   void *p = mmap(NULL, page_size * 2, PROT_READ|PROT_WRITE,
                  MAP_ANONYMOUS|MAP_PRIVATE,
@@ -3602,6 +3761,12 @@ bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
     warning("TransparentHugePages is not supported by the operating system.");
   }
 
+  if (result) {
+    log_info(pagesize)("Transparent huge pages: mode %s, page size " SIZE_FORMAT "%s",
+                       mode == THP_always ? "always" : (mode == THP_madvise ? "madvise" : "unknown"),
+                       byte_size_in_exact_unit(page_size), exact_unit_for_byte_size(page_size));
+  }
+
   return result;
 }
 
@@ -3730,6 +3895,16 @@ size_t os::Linux::find_large_page_size() {
     fclose(fp);
   }
 
+  // Transparent huge pages are always PMD sized, whatever the default
+  // hugetlbfs page size is. Aligning reservations and commits to it
+  // lets the fault path and khugepaged back them with huge pages.
+  if (UseTransparentHugePages && !FLAG_IS_DEFAULT(UseTransparentHugePages)) {
+    size_t thp_page_size = transparent_huge_page_size();
+    if (thp_page_size != 0) {
+      large_page_size = thp_page_size;
+    }
+  }
+
   if (!FLAG_IS_DEFAULT(LargePageSizeInBytes) && LargePageSizeInBytes != large_page_size) {
     warning("Setting LargePageSizeInBytes has no effect on this OS. Large page size is "
             SIZE_FORMAT "%s.", byte_size_in_proper_unit(large_page_size),
@@ -5766,14 +5941,17 @@ static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
   char cdummy;
   int idummy;
   long ldummy;
-  FILE *fp;
+  int fd;
 
+  // This is called for every thread by the JFR thread CPU load event, so
+  // read the file directly rather than setting up a stdio stream for it.
   snprintf(proc_name, 64, "/proc/self/task/%d/stat", tid);
-  fp = fopen(proc_name, "r");
-  if (fp == NULL) return -1;
-  statlen = fread(stat, 1, 2047, fp);
+  fd = ::open(proc_name, O_RDONLY);
+  if (fd == -1) return -1;
+  statlen = ::read(fd, stat, sizeof(stat) - 1);
+  ::close(fd);
+  if (statlen <= 0) return -1;
   stat[statlen] = '\0';
-  fclose(fp);
 
   // Skip pid and the command string. Note that we could be dealing with
   // weird command names, e.g. user could decide to rename java launcher
@@ -84,6 +84,15 @@ class Linux {
   static size_t setup_large_page_size();
 
   static bool setup_large_page_type(size_t page_size);
+
+  enum THPMode {
+    THP_unknown,
+    THP_always,
+    THP_madvise,
+    THP_never
+  };
+  static THPMode transparent_huge_pages_mode();
+  static size_t transparent_huge_page_size();
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
   static bool hugetlbfs_sanity_check(bool warn, size_t page_size);
 
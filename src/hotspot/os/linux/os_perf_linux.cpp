@@ -46,6 +46,8 @@
 #include <limits.h>
 #include <ifaddrs.h>
 #include <fcntl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
 
 /**
    /proc/[number]/stat
@@ -1035,3 +1037,127 @@ bool NetworkPerformanceInterface::initialize() {
 int NetworkPerformanceInterface::network_utilization(NetworkInterface** network_interfaces) const {
   return _impl->network_utilization(network_interfaces);
 }
+
+/**
+ * The hardware counters are opened with perf_event_open(2) for the calling
+ * thread only (pid 0, any cpu), counting user mode only so that they are
+ * usable with the default perf_event_paranoid setting. Each counter is
+ * opened on its own rather than as a group: if the PMU is overcommitted the
+ * kernel multiplexes the counters and the read format lets us scale each
+ * value by time_enabled / time_running.
+ */
+class HardwareCounterInterface::HardwareCounters : public CHeapObj<mtInternal> {
+  friend class HardwareCounterInterface;
+ private:
+  enum {
+    CYCLES,
+    INSTRUCTIONS,
+    LLC_MISSES,
+    DTLB_MISSES,
+    COUNTER_COUNT
+  };
+
+  int _fds[COUNTER_COUNT];
+
+  HardwareCounters();
+  HardwareCounters(const HardwareCounters& rhs); // no impl
+  HardwareCounters& operator=(const HardwareCounters& rhs); // no impl
+  bool initialize();
+  ~HardwareCounters();
+  static int open_counter(uint32_t type, uint64_t config);
+  uint64_t read_counter(int index) const;
+  int read_counters(HardwareCounterValues* values) const;
+};
+
+HardwareCounterInterface::HardwareCounters::HardwareCounters() {
+  for (int i = 0; i < COUNTER_COUNT; i++) {
+    _fds[i] = -1;
+  }
+}
+
+int HardwareCounterInterface::HardwareCounters::open_counter(uint32_t type, uint64_t config) {
+#ifdef __NR_perf_event_open
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0 /* this thread */, -1 /* any cpu */, -1 /* no group */, 0);
+#else
+  return -1;
+#endif
+}
+
+bool HardwareCounterInterface::HardwareCounters::initialize() {
+  const uint64_t cache_read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  _fds[CYCLES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  if (_fds[CYCLES] == -1) {
+    // No PMU access (virtualized, perf_event_paranoid or seccomp)
+    return false;
+  }
+  // The remaining counters are optional and read as zero if unavailable
+  _fds[INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  _fds[LLC_MISSES] = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cache_read_miss);
+  _fds[DTLB_MISSES] = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cache_read_miss);
+  return true;
+}
+
+HardwareCounterInterface::HardwareCounters::~HardwareCounters() {
+  for (int i = 0; i < COUNTER_COUNT; i++) {
+    if (_fds[i] != -1) {
+      ::close(_fds[i]);
+    }
+  }
+}
+
+uint64_t HardwareCounterInterface::HardwareCounters::read_counter(int index) const {
+  if (_fds[index] == -1) {
+    return 0;
+  }
+  // value, time_enabled, time_running
+  uint64_t data[3];
+  if (::read(_fds[index], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+    return 0;
+  }
+  uint64_t value = data[0];
+  if (data[2] != 0 && data[2] < data[1]) {
+    // The counter was multiplexed, extrapolate to the enabled time
+    value = (uint64_t)((double)value * ((double)data[1] / (double)data[2]));
+  }
+  return value;
+}
+
+int HardwareCounterInterface::HardwareCounters::read_counters(HardwareCounterValues* values) const {
+  assert(values != NULL, "invariant");
+  if (_fds[CYCLES] == -1) {
+    return OS_ERR;
+  }
+  values->set_cycles(read_counter(CYCLES));
+  values->set_instructions(read_counter(INSTRUCTIONS));
+  values->set_llc_misses(read_counter(LLC_MISSES));
+  values->set_dtlb_misses(read_counter(DTLB_MISSES));
+  return OS_OK;
+}
+
+HardwareCounterInterface::HardwareCounterInterface() {
+  _impl = NULL;
+}
+
+HardwareCounterInterface::~HardwareCounterInterface() {
+  if (_impl != NULL) {
+    delete _impl;
+  }
+}
+
+bool HardwareCounterInterface::initialize() {
+  _impl = new HardwareCounterInterface::HardwareCounters();
+  return _impl->initialize();
+}
+
+int HardwareCounterInterface::read_counters(HardwareCounterValues* values) const {
+  return _impl->read_counters(values);
+}
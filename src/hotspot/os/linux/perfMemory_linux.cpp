@@ -1259,6 +1259,16 @@ void PerfMemory::create_memory_region(size_t size) {
       }
       PerfDisableSharedMem = true;
       _start = create_standard_memory(size);
+    } else if (PerfPublishSharedMem) {
+
+      // keep the counters in standard memory so that updating them never
+      // faults on the file backed pages; StatSampler copies them over.
+      //
+      char* standard = create_standard_memory(size);
+      if (standard != NULL) {
+        _shared_copy = _start;
+        _start = standard;
+      }
     }
   }
 
@@ -25,6 +25,7 @@
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zVirtualMemory.hpp"
 #include "logging/log.hpp"
+#include "runtime/globals.hpp"
 
 #include <sys/mman.h>
 #include <sys/types.h>
@@ -52,6 +53,20 @@ static bool map(uintptr_t start, size_t size) {
 }
 
 bool ZVirtualMemoryManager::reserve_platform(uintptr_t start, size_t size) {
+  if (ZUseTBI) {
+    // Reserve a single address view, shared by all heap views
+    const uintptr_t uncolored = ZAddress::uncolored(start);
+
+    if (!map(uncolored, size)) {
+      return false;
+    }
+
+    // Register address view with native memory tracker
+    nmt_reserve(uncolored, size);
+
+    return true;
+  }
+
   // Reserve address views
   const uintptr_t marked0 = ZAddress::marked0(start);
   const uintptr_t marked1 = ZAddress::marked1(start);
@@ -35,6 +35,7 @@
 class  OutputMap;
 class  ProductionState;
 class  Expr;
+class  ChainEntry;
 
 // STRUCTURE FOR HANDLING INPUT AND OUTPUT FILES
 typedef BufferedFile ADLFILE;
@@ -134,6 +135,12 @@ private:
                   Dict &operands_chained_from, ProductionState &status);
   void expand_opclass(FILE *fp, const char *indent, const Expr *cost,
                       const char *result_type, ProductionState &status);
+  ChainEntry **chain_closure(ChainEntry **tail, const char *operand, const Expr *icost,
+                             const char *irule, Dict &operands_chained_from);
+  void gen_chain_tables(FILE *fp);
+  void gen_chain_rules(FILE *fp, const char *indent, const char *operand,
+                       const Expr *icost, const char *irule,
+                       Dict &operands_chained_from, ProductionState &status);
   Expr *calc_cost(FILE *fp, const char *spaces, MatchList &mList, ProductionState &status);
   void prune_matchlist(Dict &minimize, MatchList &mlist);
 
@@ -108,7 +108,72 @@ private:
 };
 
 
+//------------------------------ChainEntry-------------------------------------
+// A production reached from an operand through chain rules and operand
+// classes.  The same closure is generated wherever the operand is produced,
+// so it can be emitted once as a table.
+class ChainEntry {
+public:
+  const char *_result;     // Operand produced
+  const char *_rule;       // Rule reducing the result
+  bool        _pass_rule;  // Reduce by the rule that produced the starting operand, if any
+  Expr       *_cost;       // Cost of the result, including the starting operand
+  ChainEntry *_next;
+
+  ChainEntry(const char *result, const char *rule, bool pass_rule, Expr *cost)
+    : _result(result), _rule(rule), _pass_rule(pass_rule), _cost(cost), _next(NULL) {}
+};
+
+
 //---------------------------Helper Functions----------------------------------
+// How a production has to be guarded, given the productions of the same
+// result seen so far for this root opcode.
+enum CostCheckKind {
+  cc_redundant,        // A previous production always costs less or the same
+  cc_set,              // No previous production, set unconditionally
+  cc_check_valid,      // Check for validity and compare costs
+  cc_check_cost,       // Known valid, compare costs
+  cc_overwrite         // Known valid and never cheaper, overwrite unconditionally
+};
+
+static CostCheckKind cost_check_kind(const char *arrayIdx, const Expr *cost, ProductionState &status) {
+  const char *validity_check = status.valid(arrayIdx);
+  if( validity_check == unknownValid ) {
+    return cc_check_valid;
+  }
+  if( validity_check == knownInvalid ) {
+    return cc_set;
+  }
+  assert( validity_check == knownValid, "invariant");
+
+  const Expr *previous_ub = status.cost_ub(arrayIdx);
+  if( !previous_ub->is_unknown() && previous_ub->less_than_or_equal(cost) ) {
+    // production cost is known to be too high.
+    return cc_redundant;
+  }
+  const Expr *previous_lb = status.cost_lb(arrayIdx);
+  if( !previous_lb->is_unknown() && cost->less_than_or_equal(previous_lb) ) {
+    // production will unconditionally overwrite a previous production that had higher cost
+    return cc_overwrite;
+  }
+  return cc_check_cost;
+}
+
+// Update ProductionState after generating a production of the given kind
+static void update_production_state(const char *arrayIdx, const Expr *cost, CostCheckKind kind, ProductionState &status) {
+  if( kind == cc_redundant ) {
+    return;
+  }
+  bool state_check = (kind == cc_check_valid);
+  bool cost_check  = (kind == cc_check_valid || kind == cc_check_cost);
+  status.set_cost_bounds(arrayIdx, cost, state_check, cost_check);
+
+  if( kind == cc_set || kind == cc_check_valid ) {
+    // set State vector if not previously known
+    status.set_valid(arrayIdx);
+  }
+}
+
 // cost_check template:
 // 1)      if (STATE__NOT_YET_VALID(EBXREGI) || _cost[EBXREGI] > c) {
 // 2)        DFA_PRODUCTION__SET_VALID(EBXREGI, cmovI_memu_rule, c)
@@ -116,72 +181,44 @@ private:
 //
 static void cost_check(FILE *fp, const char *spaces,
                        const char *arrayIdx, const Expr *cost, const char *rule, ProductionState &status) {
-  bool state_check               = false;  // true if this production needs to check validity
-  bool cost_check                = false;  // true if this production needs to check cost
-  bool cost_is_above_upper_bound = false;  // true if this production is unnecessary due to high cost
-  bool cost_is_below_lower_bound = false;  // true if this production replaces a higher cost production
-
-  // Get information about this production
-  const Expr *previous_ub = status.cost_ub(arrayIdx);
-  if( !previous_ub->is_unknown() ) {
-    if( previous_ub->less_than_or_equal(cost) ) {
-      cost_is_above_upper_bound = true;
-      if( debug_output ) { fprintf(fp, "// Previous rule with lower cost than: %s === %s_rule costs %s\n", arrayIdx, rule, cost->as_string()); }
-    }
-  }
-
-  const Expr *previous_lb = status.cost_lb(arrayIdx);
-  if( !previous_lb->is_unknown() ) {
-    if( cost->less_than_or_equal(previous_lb) ) {
-      cost_is_below_lower_bound = true;
-      if( debug_output ) { fprintf(fp, "// Previous rule with higher cost\n"); }
-    }
-  }
+  CostCheckKind kind = cost_check_kind(arrayIdx, cost, status);
 
   // line 1)
   // Check for validity and compare to other match costs
-  const char *validity_check = status.valid(arrayIdx);
-  if( validity_check == unknownValid ) {
-    fprintf(fp, "%sif (STATE__NOT_YET_VALID(%s) || _cost[%s] > %s) {\n",  spaces, arrayIdx, arrayIdx, cost->as_string());
-    state_check = true;
-    cost_check  = true;
-  }
-  else if( validity_check == knownInvalid ) {
+  switch( kind ) {
+  case cc_redundant:
+    if( debug_output ) { fprintf(fp, "// Previous rule with lower cost than: %s === %s_rule costs %s\n", arrayIdx, rule, cost->as_string()); }
+    return;
+  case cc_set:
     if( debug_output ) { fprintf(fp, "%s// %s KNOWN_INVALID \n",  spaces, arrayIdx); }
-  }
-  else if( validity_check == knownValid ) {
-    if( cost_is_above_upper_bound ) {
-      // production cost is known to be too high.
-      return;
-    } else if( cost_is_below_lower_bound ) {
-      // production will unconditionally overwrite a previous production that had higher cost
-    } else {
-      fprintf(fp, "%sif ( /* %s KNOWN_VALID || */ _cost[%s] > %s) {\n",  spaces, arrayIdx, arrayIdx, cost->as_string());
-      cost_check  = true;
-    }
+    break;
+  case cc_check_valid:
+    fprintf(fp, "%sif (STATE__NOT_YET_VALID(%s) || _cost[%s] > %s) {\n",  spaces, arrayIdx, arrayIdx, cost->as_string());
+    break;
+  case cc_check_cost:
+    fprintf(fp, "%sif ( /* %s KNOWN_VALID || */ _cost[%s] > %s) {\n",  spaces, arrayIdx, arrayIdx, cost->as_string());
+    break;
+  case cc_overwrite:
+    if( debug_output ) { fprintf(fp, "// Previous rule with higher cost\n"); }
+    break;
   }
 
   // line 2)
   // no need to set State vector if our state is knownValid
-  const char *production = (validity_check == knownValid) ? dfa_production : dfa_production_set_valid;
+  bool known_valid = (kind == cc_check_cost || kind == cc_overwrite);
+  const char *production = known_valid ? dfa_production : dfa_production_set_valid;
   fprintf(fp, "%s  %s(%s, %s_rule, %s)", spaces, production, arrayIdx, rule, cost->as_string() );
-  if( validity_check == knownValid ) {
-    if( cost_is_below_lower_bound ) { fprintf(fp, "\t  // overwrites higher cost rule"); }
-   }
-   fprintf(fp, "\n");
+  if( kind == cc_overwrite ) {
+    fprintf(fp, "\t  // overwrites higher cost rule");
+  }
+  fprintf(fp, "\n");
 
   // line 3)
-  if( cost_check || state_check ) {
+  if( kind == cc_check_valid || kind == cc_check_cost ) {
     fprintf(fp, "%s}\n", spaces);
   }
 
-  status.set_cost_bounds(arrayIdx, cost, state_check, cost_check);
-
-  // Update ProductionState
-  if( validity_check != knownValid ) {
-    // set State vector if not previously known
-    status.set_valid(arrayIdx);
-  }
+  update_production_state(arrayIdx, cost, kind, status);
 }
 
 
@@ -280,7 +317,7 @@ void ArchDesc::gen_match(FILE *fp, MatchList &mList, ProductionState &status, Di
 
   // If this rule produces an operand which has associated chain rules,
   // update the operands with the chain rule + this rule cost & this rule.
-  chain_rule(fp, spaces6, mList._resultStr, cost, rule, operands_chained_from, status);
+  gen_chain_rules(fp, spaces6, mList._resultStr, cost, rule, operands_chained_from, status);
 
   // Close the child-and-predicate-test braces
   fprintf(fp, "    }\n");
@@ -355,6 +392,137 @@ void ArchDesc::chain_rule(FILE *fp, const char *indent, const char *operand,
   }
 }
 
+//---------------------------chain_closure-------------------------------------
+// Append to 'tail' the productions chain_rule() generates for 'operand', in
+// the same order.  'irule' is the instruction chain rule reached so far, or
+// NULL while the chain consists of operand chain rules only.
+ChainEntry **ArchDesc::chain_closure(ChainEntry **tail, const char *operand,
+                                     const Expr *icost, const char *irule, Dict &operands_chained_from) {
+  if( operands_chained_from[operand] != NULL ) {
+    return tail;
+  } else {
+    operands_chained_from.Insert( operand, operand);
+  }
+
+  ChainList *lst = (ChainList *)_chainRules[operand];
+  if (lst) {
+    const char *result, *cost, *rule;
+    for(lst->reset(); (lst->iter(result,cost,rule)) == true; ) {
+      // Do not generate operands that are already available
+      if( operands_chained_from[result] != NULL ) {
+        continue;
+      }
+      Expr *total_cost = icost->clone();  // icost + cost
+      total_cost->add(cost, *this);
+
+      Form *form = (Form *)_globalNames[rule];
+      const char *next_irule = form->is_instruction() ? rule : irule;
+      ChainEntry *entry = (next_irule == NULL) ? new ChainEntry(result, rule, true, total_cost)
+                                               : new ChainEntry(result, next_irule, false, total_cost);
+      *tail = entry;
+      tail = &entry->_next;
+      tail = chain_closure(tail, result, total_cost, next_irule, operands_chained_from);
+
+      // Members of an operand class are reduced by the member operand
+      const Form *rform = _globalNames[result];
+      OperandForm *op = rform ? rform->is_operand() : NULL;
+      if( op && op->_classes.count() > 0 ) {
+        const char *oclass;
+        for( op->_classes.reset(); (oclass = op->_classes.iter()) != NULL; ) {
+          entry = new ChainEntry(oclass, result, false, total_cost);
+          *tail = entry;
+          tail = &entry->_next;
+        }
+      }
+    }
+  }
+  return tail;
+}
+
+//---------------------------gen_chain_tables----------------------------------
+// Emit the chain closure of each operand with chain rules as a table for
+// State::_chain(), followed by the definition of State::_chain().
+void ArchDesc::gen_chain_tables(FILE *fp) {
+  Dict operands_chained_from(cmpstr, hashstr, Form::arena);
+  const Expr *zeroCost = new Expr("0");
+
+  fprintf(fp, "// Chain rule closures, applied by State::_chain.  Costs are relative to\n");
+  fprintf(fp, "// the cost of the starting operand.\n");
+  for( DictI iter(&_chainRules); iter.test(); ++iter ) {
+    const char *operand = (const char *)iter._key;
+    ChainEntry *chain = NULL;
+    operands_chained_from.Clear();
+    chain_closure(&chain, operand, zeroCost, NULL, operands_chained_from);
+    if( chain == NULL ) continue;
+
+    fprintf(fp, "static const DFAChainRule %s_chain[] = {\n", operand);
+    for( ChainEntry *e = chain; e != NULL; e = e->_next ) {
+      const char *result_enum = ArchDesc::getMachOperEnum(e->_result);
+      fprintf(fp, "  { %s, %s_rule, %s, %s },\n", result_enum, e->_rule,
+              e->_cost->as_string(), e->_pass_rule ? "true" : "false");
+      delete[] result_enum;
+    }
+    fprintf(fp, "};\n");
+  }
+  fprintf(fp, "\n");
+
+  fprintf(fp, "// Apply 'count' chain rules from 'chain' to an operand produced by 'rule'\n");
+  fprintf(fp, "// at cost 'c'.  A negative 'rule' keeps the rules of the table.\n");
+  fprintf(fp, "void State::_chain(const DFAChainRule* chain, int count, int rule, unsigned int c) {\n");
+  fprintf(fp, "  for (int i = 0; i < count; i++) {\n");
+  fprintf(fp, "    unsigned int result = chain[i]._result;\n");
+  fprintf(fp, "    unsigned int cost = c + chain[i]._cost;\n");
+  fprintf(fp, "    if (STATE__NOT_YET_VALID(result) || _cost[result] > cost) {\n");
+  fprintf(fp, "      unsigned int r = (chain[i]._pass_rule && rule >= 0) ? rule : chain[i]._rule;\n");
+  fprintf(fp, "      %s(result, r, cost)\n", dfa_production_set_valid);
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
+  fprintf(fp, "}\n");
+  fprintf(fp, "\n");
+}
+
+//---------------------------gen_chain_rules-----------------------------------
+// Generate the chain rules starting at 'operand' as a call to State::_chain,
+// or expand them inline with chain_rule() where the table would not be
+// equivalent: a result reached twice, or a production that overwrites a
+// known valid one unconditionally and therefore also on equal cost.
+void ArchDesc::gen_chain_rules(FILE *fp, const char *indent, const char *operand,
+     const Expr *icost, const char *irule, Dict &operands_chained_from, ProductionState &status) {
+  ChainEntry *chain = NULL;
+  chain_closure(&chain, operand, icost, NULL, operands_chained_from);
+  operands_chained_from.Clear();
+  if( chain == NULL ) {
+    return;
+  }
+
+  Dict results(cmpstr, hashstr, Form::arena);
+  int  count = 0;
+  bool use_table = true;
+  for( ChainEntry *e = chain; e != NULL; e = e->_next, count++ ) {
+    const char *result_enum = ArchDesc::getMachOperEnum(e->_result);
+    if( results[e->_result] != NULL ||
+        cost_check_kind(result_enum, e->_cost, status) == cc_overwrite ) {
+      use_table = false;
+    }
+    results.Insert(e->_result, e->_result);
+  }
+  if( !use_table ) {
+    chain_rule(fp, indent, operand, icost, irule, operands_chained_from, status);
+    return;
+  }
+
+  if( strcmp(irule, "Invalid") ) {
+    fprintf(fp, "%s_chain(%s_chain, %d, %s_rule, %s);\n", indent, operand, count, irule, icost->as_string());
+  } else {
+    fprintf(fp, "%s_chain(%s_chain, %d, -1, %s);\n", indent, operand, count, icost->as_string());
+  }
+
+  for( ChainEntry *e = chain; e != NULL; e = e->_next ) {
+    const char *result_enum = ArchDesc::getMachOperEnum(e->_result);
+    update_production_state(result_enum, e->_cost, cost_check_kind(result_enum, e->_cost, status), status);
+  }
+}
+
 //---------------------------prune_matchlist-----------------------------------
 // Check for duplicate entries in a matchlist, and prune out the higher cost
 // entry.
@@ -408,6 +576,9 @@ void ArchDesc::buildDFA(FILE* fp) {
   fprintf(fp, "  %s( (result), (rule), (cost) ); STATE__SET_VALID( (result) );\n", dfa_production);
   fprintf(fp, "\n");
 
+  fprintf(fp, "//------------------------- Chain rules ------------------------------------\n");
+  gen_chain_tables(fp);
+
   fprintf(fp, "//------------------------- DFA --------------------------------------------\n");
 
   fprintf(fp,
@@ -626,8 +797,8 @@ void ArchDesc::gen_dfa_state_body(FILE* fp, Dict &minimize, ProductionState &sta
   operands_chained_from.Clear();  //
   if( debug_output1 ) { fprintf(fp, "// top level chain rules for: %s \n", (char *)NodeClassNames[i]); } // %%%%% Explanation
   const Expr *zeroCost = new Expr("0");
-  chain_rule(fp, "   ", (char *)NodeClassNames[i], zeroCost, "Invalid",
-             operands_chained_from, status);
+  gen_chain_rules(fp, "   ", (char *)NodeClassNames[i], zeroCost, "Invalid",
+                  operands_chained_from, status);
 }
 
 
@@ -2054,6 +2054,16 @@ void ArchDesc::defineStateClass(FILE *fp) {
   fprintf(fp,"// indexed by machine operand opcodes, pointers to the children in the label\n");
   fprintf(fp,"// tree generated by the Label routines in ideal nodes (currently limited to\n");
   fprintf(fp,"// two for convenience, but this could change).\n");
+  fprintf(fp,"// Entry of a chain rule table generated by ADLC: produce _result by _rule,\n");
+  fprintf(fp,"// or by the rule of the starting operand if _pass_rule, at _cost more than\n");
+  fprintf(fp,"// the starting operand.\n");
+  fprintf(fp,"struct DFAChainRule {\n");
+  fprintf(fp,"  unsigned short _result;\n");
+  fprintf(fp,"  unsigned short _rule;\n");
+  fprintf(fp,"  unsigned int   _cost;\n");
+  fprintf(fp,"  bool           _pass_rule;\n");
+  fprintf(fp,"};\n");
+  fprintf(fp,"\n");
   fprintf(fp,"class State : public ResourceObj {\n");
   fprintf(fp,"public:\n");
   fprintf(fp,"  int    _id;         // State identifier\n");
@@ -2073,6 +2083,9 @@ void ArchDesc::defineStateClass(FILE *fp) {
   fprintf(fp,"  // Assign a state to a node, definition of method produced by ADLC\n");
   fprintf(fp,"  bool DFA( int opcode, const Node *ideal );\n");
   fprintf(fp,"\n");
+  fprintf(fp,"  // Apply a chain rule table, definition of method produced by ADLC\n");
+  fprintf(fp,"  void _chain(const DFAChainRule* chain, int count, int rule, unsigned int c);\n");
+  fprintf(fp,"\n");
   fprintf(fp,"  // Access function for _valid bit vector\n");
   fprintf(fp,"  bool valid(uint index) {\n");
   fprintf(fp,"    return( STATE__VALID(index) != 0 );\n");
@@ -826,6 +826,33 @@ bool AOTCodeHeap::load_klass_data(InstanceKlass* ik, Thread* thread) {
   // Initialize global symbols of the DSO to the corresponding VM symbol values.
   link_global_lib_symbols();
 
+  if (AOTLazyMethodLinking) {
+    // Methods are published one by one from their first invocation event,
+    // see AOTLoader::load_for_method(). Class initializers run only once,
+    // so they are not worth publishing at all.
+    return true;
+  }
+  publish_klass_methods(ik, klass_data, NULL, thread);
+  return true;
+}
+
+bool AOTCodeHeap::load_method_data(const methodHandle& mh, Thread* thread) {
+  ResourceMark rm;
+  InstanceKlass* ik = mh->method_holder();
+  AOTKlassData* klass_data = find_klass(ik);
+  if (klass_data == NULL) {
+    return false;
+  }
+  // The class must have been accepted by load_klass_data() for this library.
+  assert(klass_data->_class_id < _class_count, "invalid class id");
+  if (_classes[klass_data->_class_id]._classloader != ik->class_loader_data()) {
+    return false;
+  }
+  return publish_klass_methods(ik, klass_data, mh(), thread);
+}
+
+bool AOTCodeHeap::publish_klass_methods(InstanceKlass* ik, AOTKlassData* klass_data, Method* only, Thread* thread) {
+  bool published = false;
   int methods_offset = klass_data->_compiled_methods_offset;
   if (methods_offset >= 0) {
     address methods_cnt_adr = _methods_offsets + methods_offset;
@@ -850,14 +877,21 @@ bool AOTCodeHeap::load_klass_data(InstanceKlass* ik, Thread* thread) {
       int klass_len = Bytes::get_Java_u2((address)aot_name);
       const char* method_name = aot_name + 2 + klass_len;
       Method* m = AOTCodeHeap::find_method(ik, thread, method_name);
+      if (only != NULL && m != only) {
+        continue;
+      }
       methodHandle mh(thread, m);
       if (mh->code() != NULL) { // Does it have already compiled code?
         continue; // Don't overwrite
       }
       publish_aot(mh, method_data, code_id);
+      published = (mh->code() != NULL);
+      if (only != NULL) {
+        break;
+      }
     }
   }
-  return true;
+  return published;
 }
 
 AOTCompiledMethod* AOTCodeHeap::next_in_use_at(int start) const {
@@ -226,6 +226,9 @@ class AOTCodeHeap : public CodeHeap {
 
   AOTCompiledMethod* next_in_use_at(int index) const;
 
+  // Publish the compiled methods of a class, or only 'only' if not NULL.
+  bool publish_klass_methods(InstanceKlass* ik, AOTKlassData* klass_data, Method* only, Thread* thread);
+
   // Find klass in SystemDictionary for aot metadata.
   static Klass* lookup_klass(const char* name, int len, const Method* method, Thread* THREAD);
 public:
@@ -241,6 +244,7 @@ public:
 
   AOTKlassData* find_klass(InstanceKlass* ik);
   bool load_klass_data(InstanceKlass* ik, Thread* thread);
+  bool load_method_data(const methodHandle& mh, Thread* thread);
   Klass* get_klass_from_got(const char* klass_name, int klass_len, const Method* method);
 
   bool is_dependent_method(Klass* dependee, AOTCompiledMethod* aot);
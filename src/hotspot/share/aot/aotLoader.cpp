@@ -56,6 +56,24 @@ void AOTLoader::load_for_klass(InstanceKlass* ik, Thread* thread) {
   }
 }
 
+// Used with AOTLazyMethodLinking: publish the AOT code of a single method
+// the first time the interpreter reports an invocation event for it.
+bool AOTLoader::load_for_method(const methodHandle& mh, Thread* thread) {
+  if (!UseAOT || mh->code() != NULL) {
+    return false;
+  }
+  InstanceKlass* ik = mh->method_holder();
+  if (ik->is_unsafe_anonymous() || !ik->is_initialized()) {
+    return false;
+  }
+  FOR_ALL_AOT_HEAPS(heap) {
+    if ((*heap)->load_method_data(mh, thread)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 uint64_t AOTLoader::get_saved_fingerprint(InstanceKlass* ik) {
   assert(UseAOT, "called only when AOT is enabled");
   if (ik->is_unsafe_anonymous()) {
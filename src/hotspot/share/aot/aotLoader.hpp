@@ -60,6 +60,7 @@ public:
   static void set_narrow_oop_shift() NOT_AOT_RETURN;
   static void set_narrow_klass_shift() NOT_AOT_RETURN;
   static void load_for_klass(InstanceKlass* ik, Thread* thread) NOT_AOT_RETURN;
+  static bool load_for_method(const methodHandle& mh, Thread* thread) NOT_AOT({ return false; });
   static uint64_t get_saved_fingerprint(InstanceKlass* ik) NOT_AOT({ return 0; });
   static void oops_do(OopClosure* f) NOT_AOT_RETURN;
   static void metadata_do(MetadataClosure* f) NOT_AOT_RETURN;
@@ -144,6 +144,11 @@ class LIR_Assembler: public CompilationResourceObj {
   static LIR_Opr receiverOpr();
   static LIR_Opr osrBufferPointer();
 
+  // increment for call profile counters; scaled up when updates are sampled
+  static int profile_call_increment() {
+    return DataLayout::counter_increment << C1ProfileCallSampleFreqLog;
+  }
+
   // stubs
   void emit_slow_case_stubs();
   void emit_static_call_stub();
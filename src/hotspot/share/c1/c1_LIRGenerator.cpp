@@ -3232,7 +3232,27 @@ void LIRGenerator::do_ProfileCall(ProfileCall* x) {
     recv = new_register(T_OBJECT);
     __ move(value.result(), recv);
   }
-  __ profile_call(x->method(), x->bci_of_invoke(), x->callee(), mdo, recv, tmp, x->known_holder());
+
+  if (C1ProfileCallSampleFreqLog > 0) {
+    // Only update the call profile once every 2^C1ProfileCallSampleFreqLog
+    // calls made by this thread. The profile counters are bumped by the
+    // same factor (see LIR_Assembler::profile_call_increment()).
+    LabelObj* L_skip = new LabelObj();
+    LIR_Address* counter = new LIR_Address(getThreadPointer(),
+                                           in_bytes(JavaThread::profile_sample_counter_offset()),
+                                           T_INT);
+    LIR_Opr result = new_register(T_INT);
+    __ load(counter, result);
+    __ add(result, LIR_OprFact::intConst(1), result);
+    __ logical_and(result, LIR_OprFact::intConst(right_n_bits(C1ProfileCallSampleFreqLog)), result);
+    __ store(result, counter);
+    __ cmp(lir_cond_notEqual, result, LIR_OprFact::intConst(0));
+    __ branch(lir_cond_notEqual, T_INT, L_skip->label());
+    __ profile_call(x->method(), x->bci_of_invoke(), x->callee(), mdo, recv, tmp, x->known_holder());
+    __ branch_destination(L_skip->label());
+  } else {
+    __ profile_call(x->method(), x->bci_of_invoke(), x->callee(), mdo, recv, tmp, x->known_holder());
+  }
 }
 
 void LIRGenerator::do_ProfileReturnType(ProfileReturnType* x) {
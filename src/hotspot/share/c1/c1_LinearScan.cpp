@@ -746,6 +746,19 @@ void LinearScan::compute_global_live_sets() {
   int  iteration_count = 0;
   ResourceBitMap live_out(live_set_size()); // scratch set for calculations
 
+  // Per-block timestamps (indexed by linear_scan_number): when the block was
+  // last visited and when its live_in set was last recomputed.  A block's
+  // live_out only depends on the live_in sets of its successors and exception
+  // handlers, so it need not be recomputed if none of them changed since the
+  // block was last visited.
+  int* visited_at = NEW_RESOURCE_ARRAY(int, num_blocks);
+  int* live_in_at = NEW_RESOURCE_ARRAY(int, num_blocks);
+  int  stamp      = 0;
+  for (int i = 0; i < num_blocks; i++) {
+    visited_at[i] = -1;
+    live_in_at[i] = -1;
+  }
+
   // Perform a backward dataflow analysis to compute live_out and live_in for each block.
   // The loop is executed until a fixpoint is reached (no changes in an iteration)
   // Exception handlers must be processed because not all live values are
@@ -762,7 +775,19 @@ void LinearScan::compute_global_live_sets() {
       // live_out(block) is the union of live_in(sux), for successors sux of block
       int n = block->number_of_sux();
       int e = block->number_of_exception_handlers();
-      if (n + e > 0) {
+      int bn = block->linear_scan_number();
+      assert(bn == i, "block order must match linear scan numbers");
+
+      bool sux_changed = iteration_count == 0;
+      for (int j = 0; !sux_changed && j < n; j++) {
+        sux_changed = live_in_at[block->sux_at(j)->linear_scan_number()] > visited_at[bn];
+      }
+      for (int j = 0; !sux_changed && j < e; j++) {
+        sux_changed = live_in_at[block->exception_handler_at(j)->linear_scan_number()] > visited_at[bn];
+      }
+      visited_at[bn] = stamp++;
+
+      if (sux_changed && n + e > 0) {
         // block has successors
         if (n > 0) {
           live_out.set_from(block->sux_at(0)->live_in());
@@ -794,6 +819,7 @@ void LinearScan::compute_global_live_sets() {
         live_in.set_from(block->live_out());
         live_in.set_difference(block->live_kill());
         live_in.set_union(block->live_gen());
+        live_in_at[bn] = stamp++;
       }
 
 #ifndef PRODUCT
@@ -309,6 +309,12 @@
   product(bool, C1ProfileInlinedCalls, true,                                \
           "Profile inlined calls when generating code for updating MDOs")   \
                                                                             \
+  product(intx, C1ProfileCallSampleFreqLog, 0,                              \
+          "If non-zero, tier 3 code updates call profiles only once every " \
+          "2^n executions per thread, adding 2^n to the counters so that "  \
+          "profile counts keep their expected values")                      \
+          range(0, 10)                                                      \
+                                                                            \
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
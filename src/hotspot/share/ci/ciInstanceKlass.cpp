@@ -451,21 +451,15 @@ int ciInstanceKlass::compute_nonstatic_fields() {
   }
   assert(!is_java_lang_Object(), "bootstrap OK");
 
-  // Size in bytes of my fields, including inherited fields.
-  int fsize = nonstatic_field_size() * heapOopSize;
-
   ciInstanceKlass* super = this->super();
   GrowableArray<ciField*>* super_fields = NULL;
   if (super != NULL && super->has_nonstatic_fields()) {
-    int super_fsize  = super->nonstatic_field_size() * heapOopSize;
     int super_flen   = super->nof_nonstatic_fields();
     super_fields = super->_nonstatic_fields;
     assert(super_flen == 0 || super_fields != NULL, "first get nof_fields");
-    // See if I am no larger than my super; if so, I can use his fields.
-    if (fsize == super_fsize) {
-      _nonstatic_fields = super_fields;
-      return super_fields->length();
-    }
+    // Local fields may fit in the padding after the superclass fields, so
+    // the same nonstatic field size does not mean there are no local fields.
+    // compute_nonstatic_fields_impl() returns NULL when there are none.
   }
 
   GrowableArray<ciField*>* fields = NULL;
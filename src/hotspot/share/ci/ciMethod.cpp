@@ -536,9 +536,10 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
         // or < 0 in the case of a type check failure for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
         if (morphism > 0 && morphism == result._limit) {
-           // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           // The morphism <= MorphismLimit. A single receiver is exact by
+           // itself; with more of them the site count has to be zero, or
+           // other receivers were seen that did not fit into the rows.
+           if (morphism == 1 || count == 0) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
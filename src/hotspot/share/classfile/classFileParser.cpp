@@ -3762,6 +3762,30 @@ static unsigned int compute_oop_map_count(const InstanceKlass* super,
   return map_count;
 }
 
+// Returns the offset just past the last nonstatic field of the nearest
+// superclass that declares any, or -1 if the space after it must not be
+// reused because it holds contended padding.
+static int super_nonstatic_fields_end(const InstanceKlass* super) {
+  for (InstanceKlass* k = const_cast<InstanceKlass*>(super); k != NULL; k = k->superklass()) {
+    if (k->is_contended()) {
+      return -1;
+    }
+    int end = -1;
+    for (AllFieldStream fs(k); !fs.done(); fs.next()) {
+      if (fs.access_flags().is_static()) continue;
+      if (fs.is_contended()) {
+        return -1;
+      }
+      const int size = type2aelembytes(FieldType::basic_type(fs.signature()));
+      end = MAX2(end, fs.offset() + size);
+    }
+    if (end != -1) {
+      return end;
+    }
+  }
+  return -1;
+}
+
 #ifndef PRODUCT
 static void print_field_layout(const Symbol* name,
                                Array<u2>* fields,
@@ -3941,6 +3965,18 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
     compact_fields   = false; // Don't compact fields
   }
 
+  // The superclass fields end is rounded up to heapOopSize, which can
+  // leave a few bytes unused after the last superclass field. Start right
+  // after that field so the gap filling below can reclaim them.
+  if (compact_fields && allocation_style != 0 && !is_contended_class &&
+      nonstatic_fields_count > 0 && super_has_nonstatic_fields) {
+    const int super_end = super_nonstatic_fields_end(_super_klass);
+    if (super_end > 0) {
+      assert(super_end <= next_nonstatic_field_offset, "super fields must end before ours");
+      next_nonstatic_field_offset = super_end;
+    }
+  }
+
   int next_nonstatic_oop_offset = 0;
   int next_nonstatic_double_offset = 0;
 
@@ -3985,44 +4021,46 @@ void ClassFileParser::layout_fields(ConstantPool* cp,
   int nonstatic_short_space_offset = 0;
   int nonstatic_byte_space_offset = 0;
 
-  // Try to squeeze some of the fields into the gaps due to
-  // long/double alignment.
-  if (nonstatic_double_count > 0) {
+  // Try to squeeze some of the fields into the gap due to the alignment of
+  // the first field group: long/double alignment, or an unaligned start
+  // after the superclass fields. The gap ends at an aligned offset, so it is
+  // filled downwards from there, the widest fields first.
+  int first_field_alignment = nonstatic_double_count > 0 ? BytesPerLong :
+                              nonstatic_word_count   > 0 ? BytesPerInt  :
+                              nonstatic_short_count  > 0 ? BytesPerShort : 1;
+  {
     int offset = next_nonstatic_double_offset;
-    next_nonstatic_double_offset = align_up(offset, BytesPerLong);
+    next_nonstatic_double_offset = align_up(offset, first_field_alignment);
     if (compact_fields && offset != next_nonstatic_double_offset) {
-      // Allocate available fields into the gap before double field.
-      int length = next_nonstatic_double_offset - offset;
-      assert(length == BytesPerInt, "");
-      nonstatic_word_space_offset = offset;
-      if (nonstatic_word_count > 0) {
+      // Allocate available fields into the gap before the first field group.
+      int gap_end = next_nonstatic_double_offset;
+      if (gap_end - offset >= BytesPerInt && nonstatic_word_count > 0) {
         nonstatic_word_count      -= 1;
         nonstatic_word_space_count = 1; // Only one will fit
-        length -= BytesPerInt;
-        offset += BytesPerInt;
+        gap_end -= BytesPerInt;
       }
-      nonstatic_short_space_offset = offset;
-      while (length >= BytesPerShort && nonstatic_short_count > 0) {
+      nonstatic_word_space_offset = gap_end;
+      while (gap_end - offset >= BytesPerShort && nonstatic_short_count > 0) {
         nonstatic_short_count       -= 1;
         nonstatic_short_space_count += 1;
-        length -= BytesPerShort;
-        offset += BytesPerShort;
+        gap_end -= BytesPerShort;
       }
-      nonstatic_byte_space_offset = offset;
-      while (length > 0 && nonstatic_byte_count > 0) {
+      nonstatic_short_space_offset = gap_end;
+      while (gap_end > offset && nonstatic_byte_count > 0) {
         nonstatic_byte_count       -= 1;
         nonstatic_byte_space_count += 1;
-        length -= 1;
+        gap_end -= 1;
       }
+      nonstatic_byte_space_offset = gap_end;
       // Allocate oop field in the gap if there are no other fields for that.
-      nonstatic_oop_space_offset = offset;
-      if (length >= heapOopSize && nonstatic_oop_count > 0 &&
+      if (gap_end - offset >= heapOopSize && is_aligned(gap_end, heapOopSize) &&
+          nonstatic_oop_count > 0 &&
           allocation_style != 0) { // when oop fields not first
         nonstatic_oop_count      -= 1;
         nonstatic_oop_space_count = 1; // Only one will fit
-        length -= heapOopSize;
-        offset += heapOopSize;
+        gap_end -= heapOopSize;
       }
+      nonstatic_oop_space_offset = gap_end;
     }
   }
 
@@ -65,6 +65,7 @@
 #include "runtime/os.inline.hpp"
 #include "runtime/threadCritical.hpp"
 #include "runtime/timer.hpp"
+#include "runtime/timerTrace.hpp"
 #include "runtime/vm_version.hpp"
 #include "services/management.hpp"
 #include "services/threadService.hpp"
@@ -99,6 +100,8 @@ static JImageClose_t                   JImageClose            = NULL;
 static JImagePackageToModule_t         JImagePackageToModule  = NULL;
 static JImageFindResource_t            JImageFindResource     = NULL;
 static JImageGetResource_t             JImageGetResource      = NULL;
+static JImageGetResourceAddress_t      JImageGetResourceAddress = NULL;
+static JImagePrefetchResources_t       JImagePrefetchResources = NULL;
 static JImageResourceIterator_t        JImageResourceIterator = NULL;
 
 // Globals
@@ -432,11 +435,20 @@ ClassFileStream* ClassPathImageEntry::open_stream_for_loader(const char* name, C
     if (UsePerfData) {
       ClassLoader::perf_sys_classfile_bytes_read()->inc(size);
     }
-    char* data = NEW_RESOURCE_ARRAY(char, size);
-    (*JImageGetResource)(_jimage, location, data, size);
-    // Resource allocated
     assert(this == (ClassPathImageEntry*)ClassLoader::get_jrt_entry(), "must be");
-    return new ClassFileStream((u1*)data,
+    // Uncompressed classes are parsed straight from the mapped image, which
+    // stays mapped for the lifetime of the VM.
+    const char* data = NULL;
+    if (JImageGetResourceAddress != NULL) {
+      data = (*JImageGetResourceAddress)(_jimage, location);
+    }
+    if (data == NULL) {
+      char* buffer = NEW_RESOURCE_ARRAY(char, size);
+      (*JImageGetResource)(_jimage, location, buffer, size);
+      // Resource allocated
+      data = buffer;
+    }
+    return new ClassFileStream((const u1*)data,
                                (int)size,
                                _name,
                                ClassFileStream::verify,
@@ -1028,6 +1040,10 @@ void ClassLoader::load_jimage_library() {
   guarantee(JImageFindResource != NULL, "function JIMAGE_FindResource not found");
   JImageGetResource = CAST_TO_FN_PTR(JImageGetResource_t, os::dll_lookup(handle, "JIMAGE_GetResource"));
   guarantee(JImageGetResource != NULL, "function JIMAGE_GetResource not found");
+  // Optional, the resource is copied out of the image if it is missing.
+  JImageGetResourceAddress = CAST_TO_FN_PTR(JImageGetResourceAddress_t, os::dll_lookup(handle, "JIMAGE_GetResourceAddress"));
+  // Optional, classes are not prefetched if it is missing.
+  JImagePrefetchResources = CAST_TO_FN_PTR(JImagePrefetchResources_t, os::dll_lookup(handle, "JIMAGE_PrefetchResources"));
   JImageResourceIterator = CAST_TO_FN_PTR(JImageResourceIterator_t, os::dll_lookup(handle, "JIMAGE_ResourceIterator"));
   guarantee(JImageResourceIterator != NULL, "function JIMAGE_ResourceIterator not found");
 }
@@ -1618,6 +1634,72 @@ void ClassLoader::classLoader_init2(TRAPS) {
       GrowableArray<ModuleClassPathList*>(EXPLODED_ENTRY_SIZE, true);
     add_to_exploded_build_list(vmSymbols::java_base(), CHECK);
   }
+
+  // Classes come from the jimage only when they are not in a CDS archive.
+  if (JImagePrefetchThreads > 0 && has_jrt_entry() &&
+      JImagePrefetchResources != NULL && !UseSharedSpaces) {
+    prefetch_jimage_classes();
+  }
+}
+
+// Decompress the classes named in the default class list, which are the
+// classes loaded by a typical startup, before they are loaded. With an
+// image created with jlink --compress the boot loader spends most of its
+// time decompressing, which libjimage can do on JImagePrefetchThreads
+// threads ahead of demand. The bytes are held by libjimage until the class
+// is read, and uncompressed classes are skipped by libjimage.
+void ClassLoader::prefetch_jimage_classes() {
+  TraceTime timer("Prefetch classes from runtime image", TRACETIME_LOG(Info, startuptime));
+  ResourceMark rm;
+  JImageFile* jimage = _jrt_entry->jimage();
+  char path[JVM_MAXPATHLEN];
+  jio_snprintf(path, sizeof(path), "%s%slib%sclasslist",
+               Arguments::get_java_home(), os::file_separator(), os::file_separator());
+  int fd = os::open(path, O_RDONLY, S_IREAD);
+  if (fd < 0) {
+    return;
+  }
+  FILE* file = os::open(fd, "r");
+  if (file == NULL) {
+    ::close(fd);
+    return;
+  }
+
+  GrowableArray<JImageLocationRef>* locations = new GrowableArray<JImageLocationRef>(1024);
+  char line[JIMAGE_MAX_PATH];
+  while (fgets(line, sizeof(line), file) != NULL) {
+    // Each line starts with a class name, optionally followed by options.
+    size_t len = strcspn(line, " \t\r\n");
+    if (len == 0 || line[0] == '#' || len + sizeof(".class") > sizeof(line)) {
+      continue;
+    }
+    strcpy(line + len, ".class");
+    const char* pkg_end = strrchr(line, '/');
+    if (pkg_end == NULL) {
+      continue;
+    }
+    char* pkg = NEW_RESOURCE_ARRAY(char, pkg_end - line + 1);
+    strncpy(pkg, line, pkg_end - line);
+    pkg[pkg_end - line] = '\0';
+    const char* module_name = (*JImagePackageToModule)(jimage, pkg);
+    if (module_name != NULL) {
+      jlong size;
+      JImageLocationRef location = (*JImageFindResource)(jimage, module_name,
+                                                         get_jimage_version_string(),
+                                                         line, &size);
+      if (location != 0) {
+        locations->append(location);
+      }
+    }
+  }
+  fclose(file);
+
+  if (locations->length() > 0) {
+    jint held = (*JImagePrefetchResources)(jimage, locations->adr_at(0),
+                                           locations->length(), (jint)JImagePrefetchThreads);
+    log_info(class, load)("Prefetched %d of %d classes from %s",
+                          held, locations->length(), _jrt_entry->name());
+  }
 }
 
 
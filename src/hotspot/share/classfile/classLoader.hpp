@@ -248,6 +248,7 @@ class ClassLoader: AllStatic {
   static void setup_boot_search_path(const char *class_path);
   static void setup_patch_mod_entries();
   static void create_javabase();
+  static void prefetch_jimage_classes();
 
   static void load_zip_library();
   static void load_jimage_library();
@@ -632,6 +632,21 @@ int ClassLoaderDataGraph::resize_dictionaries() {
   return resized;
 }
 
+int ClassLoaderDataGraph::resize_package_tables() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  int resized = 0;
+  assert(PackageEntryTable::does_any_table_need_resizing(), "some package entry table should need resizing");
+  PackageEntryTable::clear_needs_resizing();
+  ClassLoaderDataGraphIterator iter;
+  while (ClassLoaderData* cld = iter.get_next()) {
+    PackageEntryTable* packages = cld->packages();
+    if (packages != NULL && packages->resize_if_needed()) {
+      resized++;
+    }
+  }
+  return resized;
+}
+
 ClassLoaderDataGraphKlassIteratorAtomic::ClassLoaderDataGraphKlassIteratorAtomic()
     : _next_klass(NULL) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
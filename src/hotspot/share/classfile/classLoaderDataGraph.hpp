@@ -128,6 +128,7 @@ class ClassLoaderDataGraph : public AllStatic {
   }
 
   static int resize_dictionaries();
+  static int resize_package_tables();
 
   static bool has_metaspace_oom()           { return _metaspace_oom; }
   static void set_metaspace_oom(bool value) { _metaspace_oom = value; }
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classPreloader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/java.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+
+void ClassPreloader::initialize() {
+  if (PreloadClassList == NULL) {
+    return;
+  }
+  EXCEPTION_MARK;
+
+  const char* name = "Class Preloader";
+  Handle string = java_lang_String::create_from_str(name, CHECK);
+
+  // Initialize thread_oop to put it into the system threadGroup
+  Handle thread_group (THREAD, Universe::system_thread_group());
+  Handle thread_oop = JavaCalls::construct_new_instance(
+                          SystemDictionary::Thread_klass(),
+                          vmSymbols::threadgroup_string_void_signature(),
+                          thread_group,
+                          string,
+                          CHECK);
+
+  {
+    MutexLocker mu(Threads_lock);
+    ClassPreloader* thread = new ClassPreloader(&preloader_thread_entry);
+
+    // Preloading is only an optimization, so just don't do it if we
+    // could not get a native thread.
+    if (thread == NULL || thread->osthread() == NULL) {
+      log_warning(class, load)("Could not start class preloader thread");
+      return;
+    }
+
+    java_lang_Thread::set_thread(thread_oop(), thread);
+    java_lang_Thread::set_priority(thread_oop(), NormPriority);
+    java_lang_Thread::set_daemon(thread_oop());
+    thread->set_threadObj(thread_oop());
+
+    Threads::add(thread);
+    Thread::start(thread);
+  }
+}
+
+void ClassPreloader::preloader_thread_entry(JavaThread* jt, TRAPS) {
+  // Use os::open() because neither fopen() nor os::fopen()
+  // can handle long path name on Windows.
+  FILE* file = NULL;
+  int fd = os::open(PreloadClassList, O_RDONLY, S_IREAD);
+  if (fd != -1) {
+    file = os::open(fd, "r");
+  }
+  if (file == NULL) {
+    log_warning(class, load)("Could not open class preload list %s", PreloadClassList);
+    return;
+  }
+
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  char line[1024];
+  int total = 0;
+  int loaded = 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    // Comments and CDS directives are skipped. Only the class name at the
+    // start of the line is used, any attributes following it are ignored.
+    if (line[0] == '#' || line[0] == '@' || line[0] == '[') {
+      continue;
+    }
+    size_t len = strcspn(line, " \t\r\n");
+    if (len == 0) {
+      continue;
+    }
+    line[len] = '\0';
+    for (size_t i = 0; i < len; i++) {
+      if (line[i] == '.') {
+        line[i] = '/';
+      }
+    }
+    total++;
+    if (preload(line, loader, THREAD)) {
+      loaded++;
+    }
+  }
+  fclose(file);
+  log_info(class, load)("Preloaded %d of %d classes listed in %s", loaded, total, PreloadClassList);
+}
+
+// Loads and links one class. Failures are ignored: the class is loaded
+// again, and any error reported, when the application really uses it.
+bool ClassPreloader::preload(const char* name, Handle loader, TRAPS) {
+  HandleMark hm(THREAD);
+  ResourceMark rm(THREAD);
+  if (strlen(name) > Symbol::max_length()) {
+    return false;
+  }
+  TempNewSymbol class_name = SymbolTable::new_symbol(name);
+  Klass* k = SystemDictionary::resolve_or_null(class_name, loader, Handle(), THREAD);
+  if (!HAS_PENDING_EXCEPTION && k != NULL && k->is_instance_klass()) {
+    // Linking verifies and rewrites the class, but does not initialize it.
+    InstanceKlass::cast(k)->link_class(THREAD);
+  }
+  if (HAS_PENDING_EXCEPTION) {
+    log_debug(class, load)("Could not preload %s", name);
+    CLEAR_PENDING_EXCEPTION;
+    return false;
+  }
+  return k != NULL;
+}
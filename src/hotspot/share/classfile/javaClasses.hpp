@@ -166,6 +166,28 @@ class java_lang_String : AllStatic {
   // produce an ascii string with all other values quoted using \u####
   static char*  as_quoted_ascii(oop java_string);
 
+  static unsigned int hash_code_element(jchar c) { return (unsigned int) c; }
+  static unsigned int hash_code_element(jbyte c) { return ((unsigned int) c) & 0xFF; }
+
+  // Computes s[0]*31^(n-1) + s[1]*31^(n-2) + ... + s[n-1] like String.hashCode().
+  // Four elements are folded in per step, so the multiplications do not form a
+  // single dependency chain and the compiler can overlap or vectorize them.
+  template <typename T>
+  static unsigned int hash_code_impl(const T* s, int len) {
+    unsigned int h = 0;
+    for (; len >= 4; len -= 4, s += 4) {
+      h = 31*31*31*31 * h
+        + 31*31*31 * hash_code_element(s[0])
+        + 31*31    * hash_code_element(s[1])
+        + 31       * hash_code_element(s[2])
+        +            hash_code_element(s[3]);
+    }
+    for (; len > 0; len--, s++) {
+      h = 31*h + hash_code_element(*s);
+    }
+    return h;
+  }
+
   // Compute the hash value for a java.lang.String object which would
   // contain the characters passed in.
   //
@@ -177,21 +199,11 @@ class java_lang_String : AllStatic {
   //
   // For this reason, THIS ALGORITHM MUST MATCH String.hashCode().
   static unsigned int hash_code(const jchar* s, int len) {
-    unsigned int h = 0;
-    while (len-- > 0) {
-      h = 31*h + (unsigned int) *s;
-      s++;
-    }
-    return h;
+    return hash_code_impl(s, len);
   }
 
   static unsigned int hash_code(const jbyte* s, int len) {
-    unsigned int h = 0;
-    while (len-- > 0) {
-      h = 31*h + (((unsigned int) *s) & 0xFF);
-      s++;
-    }
-    return h;
+    return hash_code_impl(s, len);
   }
 
   static unsigned int hash_code(oop java_string);
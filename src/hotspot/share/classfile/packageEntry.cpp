@@ -29,6 +29,8 @@
 #include "memory/resourceArea.hpp"
 #include "oops/symbol.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/events.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/hashtable.inline.hpp"
@@ -166,8 +168,13 @@ void PackageEntry::delete_qualified_exports() {
   _qualified_exports = NULL;
 }
 
+// Set if any package entry table needs resizing, so the safepoint cleanup
+// does not have to walk every class loader to find out.
+bool PackageEntryTable::_some_table_needs_resizing = false;
+
 PackageEntryTable::PackageEntryTable(int table_size)
-  : Hashtable<Symbol*, mtModule>(table_size, sizeof(PackageEntry))
+  : Hashtable<Symbol*, mtModule>(table_size, sizeof(PackageEntry)),
+    _resizable(true), _needs_resizing(false)
 {
 }
 
@@ -209,6 +216,66 @@ PackageEntry* PackageEntryTable::new_entry(unsigned int hash, Symbol* name, Modu
 void PackageEntryTable::add_entry(int index, PackageEntry* new_entry) {
   assert(Module_lock->owned_by_self(), "should have the Module_lock");
   Hashtable<Symbol*, mtModule>::add_entry(index, (HashtableEntry<Symbol*, mtModule>*)new_entry);
+  check_if_needs_resize();
+}
+
+const int _resize_load_trigger = 5;       // load factor that will trigger the resize
+const double _resize_factor    = 2.0;     // by how much we will resize using current number of entries
+const int _resize_max_size     = 10103;   // the max package entry table size allowed
+const int _primelist[] = {109, 1009, 2017, 4049, 5051, _resize_max_size};
+const int _prime_array_size = sizeof(_primelist)/sizeof(int);
+
+// Calculate next "good" table size based on requested count
+static int calculate_table_size(int requested) {
+  int index = 0;
+  int newsize = _primelist[index];
+  for (; index < (_prime_array_size - 1); newsize = _primelist[++index]) {
+    if (requested <= newsize) {
+      break;
+    }
+  }
+  return newsize;
+}
+
+bool PackageEntryTable::does_any_table_need_resizing() {
+  return _some_table_needs_resizing;
+}
+
+void PackageEntryTable::check_if_needs_resize() {
+  if (_resizable && number_of_entries() > (_resize_load_trigger * table_size())) {
+    _needs_resizing = true;
+    _some_table_needs_resizing = true;
+  }
+}
+
+// Called at a safepoint.  Lock free readers are blocked, but a thread that
+// holds the Module lock may be in the middle of walking the buckets, so leave
+// the table alone until a later safepoint in that case.
+bool PackageEntryTable::resize_if_needed() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (!_needs_resizing) {
+    return false;
+  }
+  if (Module_lock->owner() != NULL) {
+    _some_table_needs_resizing = true;
+    return false;
+  }
+  int desired_size = calculate_table_size((int)(_resize_factor * number_of_entries()));
+  if (desired_size >= _resize_max_size) {
+    // We have reached the limit, turn resizing off
+    desired_size = _resize_max_size;
+    _resizable = false;
+  }
+  bool resized = false;
+  if (desired_size != table_size()) {
+    resized = resize(desired_size);
+    if (!resized) {
+      // Something went wrong, turn resizing off
+      _resizable = false;
+    }
+  }
+  _needs_resizing = false;
+  return resized;
 }
 
 // Create package entry in loader's package entry table.  Assume Module lock
@@ -231,8 +298,12 @@ void PackageEntryTable::locked_create_entry_if_not_exist(Symbol* name, ModuleEnt
 }
 
 PackageEntry* PackageEntryTable::lookup(Symbol* name, ModuleEntry* module) {
+  PackageEntry* p = lookup_only(name);
+  if (p != NULL) {
+    return p;
+  }
   MutexLocker ml(Module_lock);
-  PackageEntry* p = locked_lookup_only(name);
+  p = locked_lookup_only(name);
   if (p != NULL) {
     return p;
   } else {
@@ -245,8 +316,13 @@ PackageEntry* PackageEntryTable::lookup(Symbol* name, ModuleEntry* module) {
 
 PackageEntry* PackageEntryTable::lookup_only(Symbol* name) {
   assert(!Module_lock->owned_by_self(), "should not have the Module_lock - use locked_lookup_only");
-  MutexLocker ml(Module_lock);
-  return locked_lookup_only(name);
+  int index = index_for(name);
+  for (PackageEntry* p = bucket(index); p != NULL; p = p->next()) {
+    if (p->name()->fast_compare(name) == 0) {
+      return p;
+    }
+  }
+  return NULL;
 }
 
 PackageEntry* PackageEntryTable::locked_lookup_only(Symbol* name) {
@@ -216,7 +216,10 @@ public:
 
 // The PackageEntryTable is a Hashtable containing a list of all packages defined
 // by a particular class loader.  Each package is represented as a PackageEntry node.
-// The PackageEntryTable's lookup is lock free.
+// The PackageEntryTable's lookup is lock free.  Entries are published with
+// release semantics and are only freed together with the table, so readers
+// never need the Module lock.  Additions are done under the Module lock, and
+// the table is grown at a safepoint when its load factor gets too high.
 //
 class PackageEntryTable : public Hashtable<Symbol*, mtModule> {
   friend class VMStructs;
@@ -226,6 +229,11 @@ public:
   };
 
 private:
+  static bool _some_table_needs_resizing;
+  bool _resizable;
+  bool _needs_resizing;
+  void check_if_needs_resize();
+
   PackageEntry* new_entry(unsigned int hash, Symbol* name, ModuleEntry* module);
   void add_entry(int index, PackageEntry* new_entry);
 
@@ -242,6 +250,10 @@ public:
   PackageEntryTable(int table_size);
   ~PackageEntryTable();
 
+  static bool does_any_table_need_resizing();
+  static void clear_needs_resizing() { _some_table_needs_resizing = false; }
+  bool resize_if_needed();
+
   PackageEntry* bucket(int i) {
     return (PackageEntry*)Hashtable<Symbol*, mtModule>::bucket(i);
   }
@@ -255,11 +267,11 @@ public:
   void locked_create_entry_if_not_exist(Symbol* name, ModuleEntry* module);
 
   // Lookup Package with loader's package entry table, add it if not found.
-  // This will acquire the Module lock.
+  // This will acquire the Module lock if the package has to be added.
   PackageEntry* lookup(Symbol* name, ModuleEntry* module);
 
   // Only lookup Package within loader's package entry table.
-  // This will acquire the Module lock.
+  // This is lock free.
   PackageEntry* lookup_only(Symbol* Package);
 
   // Only lookup Package within loader's package entry table.  Assume Module lock
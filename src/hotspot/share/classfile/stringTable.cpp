@@ -63,6 +63,8 @@ const size_t END_SIZE = 24;
 const size_t REHASH_LEN = 100;
 // If we have as many dead items as 50% of the number of bucket
 const double CLEAN_DEAD_HIGH_WATER_MARK = 0.5;
+// Let safepoints in after cleaning this many buckets
+const size_t CLEAN_BUCKETS_PER_YIELD = 256;
 
 #if INCLUDE_CDS_JAVA_HEAP
 inline oop read_string_from_compact_hashtable(address base_address, u4 offset) {
@@ -88,6 +90,10 @@ volatile bool StringTable::_needs_rehashing = false;
 
 volatile size_t StringTable::_uncleaned_items_count = 0;
 
+juint* StringTable::_dead_hashes = NULL;
+size_t StringTable::_dead_hashes_capacity = 0;
+volatile size_t StringTable::_dead_hashes_count = 0;
+
 static size_t _current_size = 0;
 static volatile size_t _items_count = 0;
 
@@ -211,6 +217,9 @@ void StringTable::create_table() {
   log_trace(stringtable)("Start size: " SIZE_FORMAT " (" SIZE_FORMAT ")",
                          _current_size, start_size_log_2);
   _local_table = new StringTableHash(start_size_log_2, END_SIZE, REHASH_LEN);
+  // Cleaning is triggered well before there are as many dead entries as buckets.
+  _dead_hashes_capacity = _current_size;
+  _dead_hashes = NEW_C_HEAP_ARRAY(juint, _dead_hashes_capacity, mtSymbol);
 }
 
 size_t StringTable::item_added() {
@@ -292,6 +301,16 @@ oop StringTable::do_lookup(const jchar* name, int len, uintx hash) {
   return stg.get_res_oop();
 }
 
+oop StringTable::do_lookup(Handle string, uintx hash) {
+  Thread* thread = Thread::current();
+  StringTableLookupOop lookup(thread, hash, string);
+  StringTableGet stg(thread);
+  bool rehash_warning;
+  _local_table->get(thread, lookup, stg, &rehash_warning);
+  update_needs_rehash(rehash_warning);
+  return stg.get_res_oop();
+}
+
 // Interning
 oop StringTable::intern(Symbol* symbol, TRAPS) {
   if (symbol == NULL) return NULL;
@@ -305,10 +324,22 @@ oop StringTable::intern(Symbol* symbol, TRAPS) {
 
 oop StringTable::intern(oop string, TRAPS) {
   if (string == NULL) return NULL;
+  Handle h_string (THREAD, string);
+  if (!_alt_hash) {
+    // Strings that are interned over and over again are found in the local
+    // table by comparing the String values directly, using the hash cached in
+    // the String, without copying them into a jchar array first.  Strings in
+    // the local table are never also in the shared table, so a match here is
+    // the canonical copy.
+    unsigned int hash = java_lang_String::hash_code(h_string());
+    oop found_string = do_lookup(h_string, hash);
+    if (found_string != NULL) {
+      return found_string;
+    }
+  }
   ResourceMark rm(THREAD);
   int length;
-  Handle h_string (THREAD, string);
-  jchar* chars = java_lang_String::as_unicode_string(string, length,
+  jchar* chars = java_lang_String::as_unicode_string(h_string(), length,
                                                      CHECK_NULL);
   oop result = intern(h_string, chars, length, CHECK_NULL);
   return result;
@@ -432,7 +463,95 @@ struct StringTableDeleteCheck : StackObj {
   }
 };
 
+// Matches nothing, but reports the dead entries of the bucket for the hash.
+class StringTableDeadLookup : public StackObj {
+ private:
+  uintx _hash;
+
+ public:
+  StringTableDeadLookup(uintx hash) : _hash(hash) { }
+
+  uintx get_hash() const {
+    return _hash;
+  }
+
+  bool equals(WeakHandle<vm_string_table_data>* value, bool* is_dead) {
+    if (value->peek() == NULL) {
+      *is_dead = true;
+    }
+    return false;
+  }
+};
+
+// The dead string is still intact within the pause, but must not be
+// kept alive, so this cannot go through java_lang_String::hash_code.
+static juint dead_string_hash(oop string) {
+  typeArrayOop value = java_lang_String::value_no_keepalive(string);
+  int length = java_lang_String::length(string, value);
+  if (length == 0) {
+    return 0;
+  }
+  if (java_lang_String::is_latin1(string)) {
+    return java_lang_String::hash_code(value->byte_at_addr(0), length);
+  }
+  return java_lang_String::hash_code(value->char_at_addr(0), length);
+}
+
+void StringTable::DeadHashBatch::add(oop dead_string) {
+  // With the alternate hash the entry is left to a full walk.
+  if (_alt_hash) {
+    return;
+  }
+  _hashes[_count++] = dead_string_hash(dead_string);
+  if (_count == BatchSize) {
+    flush();
+  }
+}
+
+void StringTable::DeadHashBatch::flush() {
+  if (_count == 0) {
+    return;
+  }
+  size_t end = Atomic::add((size_t)_count, &_dead_hashes_count);
+  size_t start = end - _count;
+  for (uint i = 0; i < _count && start + i < _dead_hashes_capacity; i++) {
+    _dead_hashes[start + i] = _hashes[i];
+  }
+  _count = 0;
+}
+
+void StringTable::clean_dead_buckets(JavaThread* jt, const juint* hashes, size_t count) {
+  TraceTime timer("Clean buckets", TRACETIME_LOG(Debug, stringtable, perf));
+  for (size_t i = 0; i < count; i++) {
+    StringTableDeadLookup lookup(hashes[i]);
+    _local_table->delete_dead_in_bucket(jt, lookup);
+    if ((i + 1) % CLEAN_BUCKETS_PER_YIELD == 0) {
+      ThreadBlockInVM tbivm(jt);
+    }
+  }
+  log_debug(stringtable)("Cleaned buckets of " SIZE_FORMAT " dead strings", count);
+}
+
 void StringTable::clean_dead_entries(JavaThread* jt) {
+  // Take the hashes recorded so far; pauses while cleaning record into a
+  // fresh buffer. No safepoint can intervene while swapping them.
+  juint* hashes = _dead_hashes;
+  size_t capacity = _dead_hashes_capacity;
+  size_t count = _dead_hashes_count;
+  _dead_hashes_capacity = table_size();
+  _dead_hashes = NEW_C_HEAP_ARRAY(juint, _dead_hashes_capacity, mtSymbol);
+  _dead_hashes_count = 0;
+
+  // Every dead entry seen by the last weak processing pass must have
+  // its hash recorded, else only a full walk will find them all.
+  bool complete = !_alt_hash && count <= capacity && count >= _uncleaned_items_count;
+  if (complete) {
+    clean_dead_buckets(jt, hashes, count);
+    FREE_C_HEAP_ARRAY(juint, hashes);
+    return;
+  }
+  FREE_C_HEAP_ARRAY(juint, hashes);
+
   StringTableHash::BulkDeleteTask bdt(_local_table);
   if (!bdt.prepare(jt)) {
     return;
@@ -48,11 +48,19 @@ class StringTable : public CHeapObj<mtSymbol>{
   static volatile bool _has_work;
   static volatile size_t _uncleaned_items_count;
 
+  // Hashes of the strings found dead by weak processing since the last
+  // cleaning, so that cleaning need only visit their buckets. The count
+  // keeps growing past the capacity, which then forces a full walk.
+  static juint* _dead_hashes;
+  static size_t _dead_hashes_capacity;
+  static volatile size_t _dead_hashes_count;
+
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static volatile bool _needs_rehashing;
 
   static void grow(JavaThread* jt);
   static void clean_dead_entries(JavaThread* jt);
+  static void clean_dead_buckets(JavaThread* jt, const juint* hashes, size_t count);
 
   static double get_load_factor();
   static double get_dead_factor();
@@ -67,6 +75,7 @@ class StringTable : public CHeapObj<mtSymbol>{
   static oop intern(Handle string_or_null_h, const jchar* name, int len, TRAPS);
   static oop do_intern(Handle string_or_null, const jchar* name, int len, uintx hash, TRAPS);
   static oop do_lookup(const jchar* name, int len, uintx hash);
+  static oop do_lookup(Handle string, uintx hash);
 
   static void print_table_statistics(outputStream* st, const char* table_name);
 
@@ -94,6 +103,23 @@ class StringTable : public CHeapObj<mtSymbol>{
   // strings to this method.
   static void inc_dead_counter(size_t ndead) { add_items_to_clean(ndead); }
 
+  // Collects, for one GC worker, the hashes of the strings it finds dead
+  // while clearing their entries, and publishes them in batches. Must be
+  // used while the dead strings are still intact, i.e. within the pause.
+  // Entries cleared without a batch are found by a full table walk.
+  class DeadHashBatch : public StackObj {
+    static const uint BatchSize = 64;
+    juint _hashes[BatchSize];
+    uint _count;
+
+  public:
+    DeadHashBatch() : _count(0) { }
+    ~DeadHashBatch() { flush(); }
+
+    void add(oop dead_string);
+    void flush();
+  };
+
   // Serially invoke "f->do_oop" on the locations of all oops in the table.
   // Used by JFR leak profiler.  TODO: it should find these oops through
   // the WeakProcessor.
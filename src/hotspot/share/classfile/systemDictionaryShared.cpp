@@ -294,6 +294,7 @@ public:
     if (DynamicDumpSharedSpaces) {
       _klass = DynamicArchive::original_to_target(info._klass);
     }
+    MetaspaceShared::mark_pointer((address*)&_klass);
   }
 
   bool matches(int clsfile_size, int clsfile_crc32) const {
@@ -336,6 +337,7 @@ public:
       *info_pointer_addr(klass) = DynamicArchive::buffer_to_target(record);
     } else {
       *info_pointer_addr(klass) = record;
+      MetaspaceShared::mark_pointer((address*)info_pointer_addr(klass));
     }
   }
 
@@ -1333,6 +1335,13 @@ size_t SystemDictionaryShared::estimate_size_for_archive() {
     CompactHashtableWriter::estimate_size(_dumptime_table->count_of(false));
 }
 
+// The shared dictionaries are keyed by the offset of the class name from
+// SharedBaseAddress, so they remain valid when the archive is relocated.
+static unsigned int hash_for_shared_dictionary(Symbol* name) {
+  uintx offset = pointer_delta((address)name, (address)SharedBaseAddress, 1);
+  return primitive_hash<uintx>(offset);
+}
+
 class CopySharedClassInfoToArchive : StackObj {
   CompactHashtableWriter* _writer;
   bool _is_builtin;
@@ -1354,7 +1363,7 @@ public:
       if (DynamicDumpSharedSpaces) {
         name = DynamicArchive::original_to_target(name);
       }
-      hash = primitive_hash<Symbol*>(name);
+      hash = hash_for_shared_dictionary(name);
       u4 delta;
       if (DynamicDumpSharedSpaces) {
         delta = MetaspaceShared::object_delta_u4(DynamicArchive::buffer_to_target(record));
@@ -1413,7 +1422,7 @@ SystemDictionaryShared::find_record(RunTimeSharedDictionary* static_dict, RunTim
     return NULL;
   }
 
-  unsigned int hash = primitive_hash<Symbol*>(name);
+  unsigned int hash = hash_for_shared_dictionary(name);
   const RunTimeSharedClassInfo* record = NULL;
   if (!MetaspaceShared::is_shared_dynamic(name)) {
     // The names of all shared classes in the static dict must also be in the
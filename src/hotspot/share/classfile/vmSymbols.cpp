@@ -523,6 +523,7 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
     case vmIntrinsics::_indexOfIL:
     case vmIntrinsics::_indexOfIU:
     case vmIntrinsics::_indexOfIUL:
+    case vmIntrinsics::_indexOfL_char:
     case vmIntrinsics::_indexOfU_char:
     case vmIntrinsics::_compareToL:
     case vmIntrinsics::_compareToU:
@@ -773,6 +774,9 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_vectorizedMismatch:
     if (!UseVectorizedMismatchIntrinsic) return true;
     break;
+  case vmIntrinsics::_vectorizedHashCode:
+    if (!UseVectorizedHashCodeIntrinsic) return true;
+    break;
   case vmIntrinsics::_updateBytesAdler32:
   case vmIntrinsics::_updateByteBufferAdler32:
     if (!UseAdler32Intrinsics) return true;
@@ -808,6 +812,7 @@ bool vmIntrinsics::is_disabled_by_flags(vmIntrinsics::ID id) {
   case vmIntrinsics::_indexOfIL:
   case vmIntrinsics::_indexOfIU:
   case vmIntrinsics::_indexOfIUL:
+  case vmIntrinsics::_indexOfL_char:
   case vmIntrinsics::_indexOfU_char:
     if (!SpecialStringIndexOf) return true;
     break;
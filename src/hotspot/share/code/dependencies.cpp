@@ -1986,10 +1986,18 @@ bool DepChange::ContextStream::next() {
   return false;
 }
 
+uint KlassDepChange::_check_epoch_counter = 0;
+
 void KlassDepChange::initialize() {
   // entire transaction must be under this lock:
   assert_lock_strong(Compile_lock);
 
+  // Zero is the initial epoch of every nmethod, skip it.
+  if (++_check_epoch_counter == 0) {
+    ++_check_epoch_counter;
+  }
+  _check_epoch = _check_epoch_counter;
+
   // Mark all dependee and all its superclasses
   // Mark transitive interfaces
   for (ContextStream str(*this); str.next(); ) {
@@ -687,6 +687,9 @@ class DepChange : public StackObj {
 
   virtual void mark_for_deoptimization(nmethod* nm) = 0;
 
+  // Returns false if nm has already been checked against this change.
+  virtual bool should_check(nmethod* nm) { return true; }
+
   // Subclass casting with assertions.
   KlassDepChange*    as_klass_change() {
     assert(is_klass_change(), "bad cast");
@@ -760,6 +763,12 @@ class KlassDepChange : public DepChange {
   // each change set is rooted in exactly one new type (at present):
   Klass* _new_type;
 
+  // An nmethod usually depends on several of the marked super types and so
+  // is found on several dependency contexts.  check_dependency_on() looks at
+  // all of its dependencies at once, so it is checked only the first time.
+  uint _check_epoch;
+  static uint _check_epoch_counter;
+
   void initialize();
 
  public:
@@ -780,6 +789,14 @@ class KlassDepChange : public DepChange {
     nm->mark_for_deoptimization(/*inc_recompile_counts=*/true);
   }
 
+  virtual bool should_check(nmethod* nm) {
+    if (nm->dependency_check_epoch() == _check_epoch) {
+      return false;
+    }
+    nm->set_dependency_check_epoch(_check_epoch);
+    return true;
+  }
+
   Klass* new_type() { return _new_type; }
 
   // involves_context(k) is true if k is new_type or any of the super types
@@ -34,14 +34,19 @@
 #include "memory/resourceArea.hpp"
 #include "oops/method.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.hpp"
 
 DEF_STUB_INTERFACE(ICStub);
 
-StubQueue* InlineCacheBuffer::_buffer    = NULL;
+StubQueue* InlineCacheBuffer::_buffers[InlineCacheBuffer::max_chunks] = { NULL };
+volatile int InlineCacheBuffer::_num_buffers = 0;
+volatile int InlineCacheBuffer::_growing = 0;
 
 CompiledICHolder* InlineCacheBuffer::_pending_released = NULL;
 int InlineCacheBuffer::_pending_count = 0;
@@ -137,15 +142,68 @@ void ICStub::print() {
 // Implementation of InlineCacheBuffer
 
 
+static const int ic_buffer_chunk_size = 10*K;
+
+StubQueue* InlineCacheBuffer::new_buffer() {
+  StubQueue* buffer = new StubQueue(new ICStubInterface, ic_buffer_chunk_size, InlineCacheBuffer_lock, "InlineCacheBuffer");
+  assert (buffer != NULL, "cannot allocate InlineCacheBuffer");
+  return buffer;
+}
+
 void InlineCacheBuffer::initialize() {
-  if (_buffer != NULL) return; // already initialized
-  _buffer = new StubQueue(new ICStubInterface, 10*K, InlineCacheBuffer_lock, "InlineCacheBuffer");
-  assert (_buffer != NULL, "cannot allocate InlineCacheBuffer");
+  if (_num_buffers != 0) return; // already initialized
+  _buffers[0] = new_buffer();
+  OrderAccess::release_store(&_num_buffers, 1);
+}
+
+
+int InlineCacheBuffer::num_buffers() {
+  return OrderAccess::load_acquire(&_num_buffers);
 }
 
 
 ICStub* InlineCacheBuffer::new_ic_stub() {
-  return (ICStub*)buffer()->request_committed(ic_stub_code_size());
+  int n = num_buffers();
+  for (int i = 0; i < n; i++) {
+    ICStub* stub = (ICStub*)buffer_at(i)->request_committed(ic_stub_code_size());
+    if (stub != NULL) {
+      return stub;
+    }
+  }
+  return NULL;
+}
+
+
+// Adds a chunk to the buffer so that IC transitions can go on without
+// a safepoint. Returns false if the buffer cannot grow any further.
+bool InlineCacheBuffer::grow() {
+  int n = num_buffers();
+  if (n >= (int)MIN2(InlineCacheBufferChunks, (uintx)max_chunks)) {
+    return false;
+  }
+  if (Atomic::cmpxchg(1, &_growing, 0) != 0) {
+    // Another thread is adding a chunk; retry in that one.
+    while (OrderAccess::load_acquire(&_growing) != 0) {
+      os::naked_yield();
+    }
+    return true;
+  }
+  bool grown = true;
+  if (num_buffers() == n) {
+    // The StubQueue exits the VM if the code cache has no room for it,
+    // so leave plenty of headroom for the code cache sweeper.
+    if (CodeCache::unallocated_capacity(CodeBlobType::NonNMethod) > 4 * (size_t)ic_buffer_chunk_size) {
+      _buffers[n] = new_buffer();
+      OrderAccess::release_store(&_num_buffers, n + 1);
+      if (TraceICBuffer) {
+        tty->print_cr("[growing inline cache buffer to %d chunks]", n + 1);
+      }
+    } else {
+      grown = false;
+    }
+  }
+  OrderAccess::release_store(&_growing, 0);
+  return grown;
 }
 
 
@@ -154,6 +212,9 @@ void InlineCacheBuffer::refill_ic_stubs() {
   ICRefillVerifier* verifier = current_ic_refill_verifier();
   verifier->request_remembered();
 #endif
+  if (grow()) {
+    return;
+  }
   // we ran out of inline cache buffer space; must enter safepoint.
   // We do this by forcing a safepoint
   EXCEPTION_MARK;
@@ -171,23 +232,39 @@ void InlineCacheBuffer::refill_ic_stubs() {
 
 
 void InlineCacheBuffer::update_inline_caches() {
-  if (buffer()->number_of_stubs() > 0) {
-    if (TraceICBuffer) {
-      tty->print_cr("[updating inline caches with %d stubs]", buffer()->number_of_stubs());
+  int n = num_buffers();
+  for (int i = 0; i < n; i++) {
+    StubQueue* buffer = buffer_at(i);
+    if (buffer->number_of_stubs() > 0) {
+      if (TraceICBuffer) {
+        tty->print_cr("[updating inline caches with %d stubs]", buffer->number_of_stubs());
+      }
+      buffer->remove_all();
     }
-    buffer()->remove_all();
   }
   release_pending_icholders();
 }
 
 
 bool InlineCacheBuffer::contains(address instruction_address) {
-  return buffer()->contains(instruction_address);
+  int n = num_buffers();
+  for (int i = 0; i < n; i++) {
+    if (buffer_at(i)->contains(instruction_address)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 
 bool InlineCacheBuffer::is_empty() {
-  return buffer()->number_of_stubs() == 0;
+  int n = num_buffers();
+  for (int i = 0; i < n; i++) {
+    if (buffer_at(i)->number_of_stubs() > 0) {
+      return false;
+    }
+  }
+  return true;
 }
 
 
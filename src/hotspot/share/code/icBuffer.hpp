@@ -139,12 +139,21 @@ class InlineCacheBuffer: public AllStatic {
 
   static int ic_stub_code_size();
 
-  static StubQueue* _buffer;
+  // The buffer is made of up to InlineCacheBufferChunks stub queues.
+  // Chunks are added when the existing ones are full and are never
+  // removed; the stubs in all of them are released at the next safepoint.
+  static const int max_chunks = 64;
+  static StubQueue* _buffers[max_chunks];
+  static volatile int _num_buffers;
+  static volatile int _growing;
 
   static CompiledICHolder* _pending_released;
   static int _pending_count;
 
-  static StubQueue* buffer()                         { return _buffer;         }
+  static int num_buffers();
+  static StubQueue* buffer_at(int i)                 { return _buffers[i];     }
+  static StubQueue* new_buffer();
+  static bool grow();
 
   static ICStub* new_ic_stub();
 
@@ -428,6 +428,7 @@ void nmethod::init_defaults() {
   _has_flushed_dependencies   = 0;
   _lock_count                 = 0;
   _stack_traversal_mark       = 0;
+  _dependency_check_epoch     = 0;
   _unload_reported            = false; // jvmti state
   _is_far_code                = false; // nmethods are located in CodeCache
 
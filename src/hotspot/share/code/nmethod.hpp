@@ -145,6 +145,9 @@ class nmethod : public CompiledMethod {
   // current sweep traversal index.
   volatile long _stack_traversal_mark;
 
+  // Last KlassDepChange this nmethod was checked against (see KlassDepChange::should_check)
+  uint _dependency_check_epoch;
+
   // The _hotness_counter indicates the hotness of a method. The higher
   // the value the hotter the method. The hotness counter of a nmethod is
   // set to [(ReservedCodeCacheSize / (1024 * 1024)) * 2] each time the method
@@ -430,6 +433,10 @@ public:
   long  stack_traversal_mark()                    { return _stack_traversal_mark; }
   void  set_stack_traversal_mark(long l)          { _stack_traversal_mark = l; }
 
+  // Dependency checking support
+  uint  dependency_check_epoch() const            { return _dependency_check_epoch; }
+  void  set_dependency_check_epoch(uint e)        { _dependency_check_epoch = e; }
+
   // On-stack replacement support
   int   osr_entry_bci() const                     { assert(is_osr_method(), "wrong kind of nmethod"); return _entry_bci; }
   address  osr_entry() const                      { assert(is_osr_method(), "wrong kind of nmethod"); return _osr_entry_point; }
@@ -35,6 +35,7 @@
 #include "compiler/compileLog.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "compiler/directivesParser.hpp"
+#include "compiler/hotMethodList.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
@@ -58,6 +59,7 @@
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/sweeper.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/vframe.inline.hpp"
 #include "utilities/debug.hpp"
@@ -233,6 +235,10 @@ bool compileBroker_init() {
   // init directives stack, adding default directive
   DirectivesStack::init();
 
+  if (HotMethodsFile != NULL) {
+    HotMethodList::load(HotMethodsFile);
+  }
+
   if (DirectivesParser::has_file()) {
     return DirectivesParser::parse_from_flag();
   } else if (CompilerDirectivesPrint) {
@@ -900,16 +906,21 @@ void CompileBroker::possibly_add_compiler_threads() {
   // If SegmentedCodeCache is off, both values refer to the single heap (with type CodeBlobType::All).
   size_t available_cc_np  = CodeCache::unallocated_capacity(CodeBlobType::MethodNonProfiled),
          available_cc_p   = CodeCache::unallocated_capacity(CodeBlobType::MethodProfiled);
+  // The thread counts are derived from the processor count at startup,
+  // but a container's CPU quota can be lowered while the VM runs. Don't
+  // start more threads of either kind than there are processors now.
+  int available_processors = os::active_processor_count();
 
   // Only do attempt to start additional threads if the lock is free.
   if (!CompileThread_lock->try_lock()) return;
 
   if (_c2_compile_queue != NULL) {
     int old_c2_count = _compilers[1]->num_compiler_threads();
-    int new_c2_count = MIN4(_c2_count,
+    int new_c2_count = MIN2(MIN4(_c2_count,
         _c2_compile_queue->size() / 2,
         (int)(available_memory / (200*M)),
-        (int)(available_cc_np / (128*K)));
+        (int)(available_cc_np / (128*K))),
+        available_processors);
 
     for (int i = old_c2_count; i < new_c2_count; i++) {
       JavaThread *ct = make_thread(compiler2_object(i), _c2_compile_queue, _compilers[1], CHECK);
@@ -926,10 +937,11 @@ void CompileBroker::possibly_add_compiler_threads() {
 
   if (_c1_compile_queue != NULL) {
     int old_c1_count = _compilers[0]->num_compiler_threads();
-    int new_c1_count = MIN4(_c1_count,
+    int new_c1_count = MIN2(MIN4(_c1_count,
         _c1_compile_queue->size() / 4,
         (int)(available_memory / (100*M)),
-        (int)(available_cc_p / (128*K)));
+        (int)(available_cc_p / (128*K))),
+        available_processors);
 
     for (int i = old_c1_count; i < new_c1_count; i++) {
       JavaThread *ct = make_thread(compiler1_object(i), _c1_compile_queue, _compilers[0], CHECK);
@@ -1793,6 +1805,21 @@ void CompileBroker::compiler_thread_loop() {
       task->set_code_handle(&result_handle);
       methodHandle method(thread, task->method());
 
+      EventCompilationQueueWait event;
+      if (event.should_commit()) {
+        event.set_compileId(task->compile_id());
+        event.set_compileLevel(task->comp_level());
+        event.set_queueTime(TimeHelper::counter_to_millis(os::elapsed_counter() - task->time_queued()));
+        event.set_queueSize(queue->size());
+        event.commit();
+      }
+
+      // Check the queue length before this compilation rather than after
+      // it, so that helper threads start while the backlog is building up.
+      if (UseDynamicNumberOfCompilerThreads) {
+        possibly_add_compiler_threads();
+      }
+
       // Never compile a method if breakpoints are present in it
       if (method()->number_of_breakpoints() == 0) {
         // Compile the method.
@@ -1805,10 +1832,6 @@ void CompileBroker::compiler_thread_loop() {
           task->set_failure_reason("compilation is disabled");
         }
       }
-
-      if (UseDynamicNumberOfCompilerThreads) {
-        possibly_add_compiler_threads();
-      }
     }
   }
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/hotMethodList.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+struct HotMethodKey {
+  Symbol* _klass;
+  Symbol* _name;
+  Symbol* _signature;
+};
+
+static unsigned hot_method_hash(HotMethodKey const& k) {
+  return k._klass->identity_hash() ^ (31 * (unsigned)k._name->identity_hash()) ^ (unsigned)k._signature->identity_hash();
+}
+
+static bool hot_method_equals(HotMethodKey const& a, HotMethodKey const& b) {
+  return a._klass == b._klass && a._name == b._name && a._signature == b._signature;
+}
+
+// Filled in once during startup and only read afterwards.
+typedef ResourceHashtable<HotMethodKey, bool, hot_method_hash, hot_method_equals,
+                          1024, ResourceObj::C_HEAP, mtCompiler> HotMethodTable;
+static HotMethodTable* _table = NULL;
+
+int HotMethodList::_count = 0;
+
+void HotMethodList::load(const char* path) {
+  FILE* stream = fopen(path, "rt");
+  if (stream == NULL) {
+    warning("Cannot open hot methods file %s", path);
+    return;
+  }
+  _table = new (ResourceObj::C_HEAP, mtCompiler) HotMethodTable();
+
+  char line[3 * 1024];
+  char klass[1024];
+  char name[1024];
+  char signature[1024];
+  int line_no = 0;
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    line_no++;
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+    if (sscanf(line, "%1023s %1023s %1023s", klass, name, signature) != 3) {
+      warning("Ignoring malformed line %d in hot methods file %s", line_no, path);
+      continue;
+    }
+    HotMethodKey key;
+    key._klass = SymbolTable::new_permanent_symbol(klass);
+    key._name = SymbolTable::new_permanent_symbol(name);
+    key._signature = SymbolTable::new_permanent_symbol(signature);
+    if (_table->put(key, true)) {
+      _count++;
+    }
+  }
+  fclose(stream);
+}
+
+bool HotMethodList::contains(const Method* m) {
+  if (_table == NULL) {
+    return false;
+  }
+  HotMethodKey key;
+  key._klass = m->klass_name();
+  key._name = m->name();
+  key._signature = m->signature();
+  return _table->get(key) != NULL;
+}
+
+void HotMethodList::print_on(outputStream* st) {
+  MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  CompiledMethodIterator iter(CompiledMethodIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    CompiledMethod* cm = iter.method();
+    Method* m = cm->method();
+    if (m == NULL || cm->comp_level() != CompLevel_full_optimization || cm->is_osr_method()) {
+      continue;
+    }
+    ResourceMark rm;
+    st->print_cr("%s %s %s", m->klass_name()->as_C_string(),
+                 m->name()->as_C_string(), m->signature()->as_C_string());
+  }
+}
+
+void HotMethodList::dump_to_file(const char* path) {
+  fileStream fs(path, "w");
+  if (!fs.is_open()) {
+    warning("Cannot open hot methods file %s for writing", path);
+    return;
+  }
+  fs.print_cr("# klass name signature of the methods with C2 code");
+  print_on(&fs);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_HOTMETHODLIST_HPP
+#define SHARE_COMPILER_HOTMETHODLIST_HPP
+
+#include "memory/allocation.hpp"
+
+class Method;
+class outputStream;
+
+// The methods that had C2 code in an earlier run of the application.
+// The list is written at exit to DumpHotMethodsFile, or printed by the
+// Compiler.hotmethods diagnostic command, one "klass name signature"
+// line per method, e.g.
+//
+//   java/lang/String hashCode ()I
+//
+// Given back through HotMethodsFile at startup, the tiered policy
+// compiles the listed methods at the highest tier as soon as the
+// interpreter first reports them, instead of profiling its way there.
+class HotMethodList : AllStatic {
+ private:
+  static int _count;
+
+ public:
+  // Read the list from path; called once during compiler initialization.
+  static void load(const char* path);
+
+  static bool is_empty() { return _count == 0; }
+  static bool contains(const Method* m);
+
+  static void print_on(outputStream* st);
+  static void dump_to_file(const char* path);
+};
+
+#endif // SHARE_COMPILER_HOTMETHODLIST_HPP
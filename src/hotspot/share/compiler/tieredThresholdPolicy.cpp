@@ -23,8 +23,10 @@
  */
 
 #include "precompiled.hpp"
+#include "aot/aotLoader.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/hotMethodList.hpp"
 #include "compiler/tieredThresholdPolicy.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/arguments.hpp"
@@ -307,7 +309,14 @@ CompileTask* TieredThresholdPolicy::select_task(CompileQueue* compile_queue) {
   Method* max_method = NULL;
   jlong t = os::javaTimeMillis();
   // Iterate through the queue and find a method with a maximum rate.
+  // Only the oldest TieredCompileQueueScanLimit tasks are looked at so that
+  // selection stays cheap with huge queues during warmup. Tasks behind them
+  // move into the window as the queue drains and cannot starve.
+  int scanned = 0;
   for (CompileTask* task = compile_queue->first(); task != NULL;) {
+    if (TieredCompileQueueScanLimit > 0 && scanned++ >= TieredCompileQueueScanLimit) {
+      break;
+    }
     CompileTask* next_task = task->next();
     Method* method = task->method();
     // If a method was unloaded or has been stale for some time, remove it from the queue.
@@ -407,6 +416,13 @@ nmethod* TieredThresholdPolicy::event(const methodHandle& method, const methodHa
   }
 
   if (bci == InvocationEntryBci) {
+#if INCLUDE_AOT
+    if (AOTLazyMethodLinking && comp_level == CompLevel_none && method() == inlinee() &&
+        AOTLoader::load_for_method(method, thread)) {
+      // The method has been linked to its AOT code, calls will go there from now on.
+      return NULL;
+    }
+#endif
     method_invocation_event(method, inlinee, comp_level, nm, thread);
   } else {
     // method == inlinee if the event originated in the main method
@@ -852,6 +868,15 @@ CompLevel TieredThresholdPolicy::common(Predicate p, Method* method, CompLevel c
 
 // Determine if a method should be compiled with a normal entry point at a different level.
 CompLevel TieredThresholdPolicy::call_event(Method* method, CompLevel cur_level, JavaThread * thread) {
+  // A method that was hot in an earlier run goes to the top tier right
+  // away, unless it already had top tier code in this run and was
+  // deoptimized; then it takes the usual path and gets profiled again.
+  if (cur_level == CompLevel_none && !HotMethodList::is_empty() &&
+      method->highest_comp_level() < CompLevel_full_optimization &&
+      HotMethodList::contains(method)) {
+    return MIN2(CompLevel_full_optimization, (CompLevel)TieredStopAtLevel);
+  }
+
   CompLevel osr_level = MIN2((CompLevel) method->highest_osr_comp_level(),
                              common(&TieredThresholdPolicy::loop_predicate, method, cur_level, true));
   CompLevel next_level = common(&TieredThresholdPolicy::call_predicate, method, cur_level);
@@ -27,11 +27,15 @@
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/locationPrinter.inline.hpp"
+#include "gc/shared/spaceDecorator.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/vmOperations.hpp"
+#include "runtime/vmThread.hpp"
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -61,6 +65,9 @@ jint EpsilonHeap::initialize() {
   _last_counter_update = 0;
   _last_heap_print = 0;
 
+  // Arena mark covers the entire heap until set
+  _arena_mark = _space->bottom();
+
   // Install barrier set
   BarrierSet::set_barrier_set(new EpsilonBarrierSet());
 
@@ -267,6 +274,57 @@ HeapWord* EpsilonHeap::mem_allocate(size_t size, bool *gc_overhead_limit_was_exc
   return allocate_work(size);
 }
 
+class VM_EpsilonResetArena : public VM_Operation {
+public:
+  virtual VMOp_Type type() const {
+    return VMOp_EpsilonResetArena;
+  }
+
+  virtual void doit() {
+    EpsilonHeap::heap()->reset_to_arena_mark_at_safepoint();
+  }
+};
+
+void EpsilonHeap::set_arena_mark() {
+  // TLABs are carved out of the space with bump-the-pointer allocation, so all
+  // TLABs lie either completely below or completely above the current top.
+  HeapWord* mark = _space->top();
+  Atomic::store(mark, &_arena_mark);
+
+  log_info(gc)("Arena mark set at " SIZE_FORMAT "K", pointer_delta(mark, _space->bottom()) * HeapWordSize / K);
+}
+
+void EpsilonHeap::reset_to_arena_mark() {
+  VM_EpsilonResetArena op;
+  VMThread::execute(&op);
+}
+
+void EpsilonHeap::reset_to_arena_mark_at_safepoint() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint");
+
+  // Retire all TLABs, since the memory they cover above the mark is about to be reused
+  ensure_parsability(true /* retire_tlabs */);
+
+  HeapWord* mark = Atomic::load(&_arena_mark);
+  HeapWord* top = _space->top();
+  assert(mark <= top, "Arena mark should be below top");
+
+  size_t used_before = used();
+  if (ZapUnusedHeapArea) {
+    SpaceMangler::mangle_region(MemRegion(mark, top));
+  }
+  _space->set_top(mark);
+
+  // Counters compare against the last used value, which is now above the actual used value
+  size_t used_after = used();
+  _last_counter_update = used_after;
+  _last_heap_print = used_after;
+  _monitoring_support->update_counters();
+
+  log_info(gc)("Arena reset: " SIZE_FORMAT "K->" SIZE_FORMAT "K(" SIZE_FORMAT "K)",
+               used_before / K, used_after / K, capacity() / K);
+}
+
 void EpsilonHeap::collect(GCCause::Cause cause) {
   switch (cause) {
     case GCCause::_metadata_GC_threshold:
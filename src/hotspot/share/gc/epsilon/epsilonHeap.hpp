@@ -46,6 +46,7 @@ private:
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  HeapWord* volatile _arena_mark;
 
 public:
   static EpsilonHeap* heap();
@@ -99,6 +100,13 @@ public:
   virtual size_t max_tlab_size()                    const { return _max_tlab_size; }
   virtual size_t unsafe_max_tlab_alloc(Thread* thr) const;
 
+  // Arena support: everything allocated after the arena mark is discarded
+  // wholesale on reset. The caller guarantees that no references to these
+  // objects remain, neither from the application nor from the VM.
+  void set_arena_mark();
+  void reset_to_arena_mark();
+  void reset_to_arena_mark_at_safepoint();
+
   virtual void collect(GCCause::Cause cause);
   virtual void do_full_collection(bool clear_all_soft_refs);
 
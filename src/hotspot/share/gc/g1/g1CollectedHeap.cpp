@@ -169,12 +169,15 @@ HeapRegion* G1CollectedHeap::new_heap_region(uint hrs_index,
 
 // Private methods.
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size,
+                                        HeapRegionType type,
+                                        bool do_expand,
+                                        uint node_index) {
   assert(!is_humongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
 
-  HeapRegion* res = _hrm->allocate_free_region(type);
+  HeapRegion* res = _hrm->allocate_free_region(type, node_index);
 
   if (res == NULL && do_expand && _expand_heap_after_alloc_failure) {
     // Currently, only attempts to allocate GC alloc regions set
@@ -186,12 +189,12 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, HeapRegionType type, b
     log_debug(gc, ergo, heap)("Attempt heap expansion (region allocation request failed). Allocation request: " SIZE_FORMAT "B",
                               word_size * HeapWordSize);
 
-    if (expand(word_size * HeapWordSize)) {
+    if (expand(word_size * HeapWordSize, workers())) {
       // Given that expand() succeeded in expanding the heap, and we
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm->allocate_free_region(type);
+      res = _hrm->allocate_free_region(type, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -1496,6 +1499,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _bot(NULL),
   _listener(),
   _hrm(NULL),
+  _numa(G1NUMA::create()),
   _allocator(NULL),
   _verifier(NULL),
   _summary_bytes_used(0),
@@ -1524,6 +1528,7 @@ G1CollectedHeap::G1CollectedHeap() :
   _cr(NULL),
   _task_queues(NULL),
   _evacuation_failed(false),
+  _to_space_exhausted(false),
   _evacuation_failed_info_array(NULL),
   _preserved_marks_set(true /* in_c_heap */),
 #ifndef PRODUCT
@@ -1689,6 +1694,7 @@ jint G1CollectedHeap::initialize() {
   // Carve out the G1 part of the heap.
   ReservedSpace g1_rs = heap_rs.first_part(reserved_byte_size);
   size_t page_size = actual_reserved_page_size(heap_rs);
+  _numa->set_region_info(HeapRegion::GrainBytes, page_size);
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_heap_mapper(g1_rs,
                                               g1_rs.size(),
@@ -2209,6 +2215,30 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+private:
+  G1CollectedHeap*  _heap;
+  HeapRegionClaimer _claimer;
+
+public:
+  G1ParallelObjectIterator(uint thread_num) :
+      _heap(G1CollectedHeap::heap()),
+      _claimer(thread_num) {}
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    _heap->object_iterate_parallel(cl, worker_id, &_claimer);
+  }
+};
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  return new G1ParallelObjectIterator(thread_num);
+}
+
+void G1CollectedHeap::object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_from_worker_offset(&blk, claimer, worker_id);
+}
+
 void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm->iterate(cl);
 }
@@ -2293,6 +2323,19 @@ void G1CollectedHeap::deduplicate_string(oop str) {
   }
 }
 
+// Pin and unpin can only be called by threads that prevent safepoints, i.e.
+// the pinned object counts are stable during a collection.
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "must not be at safepoint");
+  heap_region_containing(obj)->increment_pinned_object_count();
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "must not be at safepoint");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 void G1CollectedHeap::prepare_for_verify() {
   _verifier->prepare_for_verify();
 }
@@ -3063,7 +3106,7 @@ bool G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_
     }
 
     // Print the remainder of the GC log output.
-    if (evacuation_failed()) {
+    if (to_space_exhausted()) {
       log_info(gc)("To-space exhausted");
     }
 
@@ -3108,8 +3151,15 @@ bool G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_
 }
 
 void G1CollectedHeap::remove_self_forwarding_pointers(G1RedirtyCardsQueueSet* rdcqs) {
-  G1ParRemoveSelfForwardPtrsTask rsfp_task(rdcqs);
-  workers()->run_task(&rsfp_task);
+  // Every worker gets at least one collection set region to walk.
+  uint const num_regions = collection_set()->region_length();
+  uint const num_workers = WorkerPolicy::calc_workers_for_work(workers()->active_workers(), num_regions, 1);
+
+  G1ParRemoveSelfForwardPtrsTask rsfp_task(rdcqs, num_workers);
+  log_debug(gc, ergo)("Running %s using %u workers for collection set length %u",
+                      rsfp_task.name(), num_workers, num_regions);
+  workers()->run_task(&rsfp_task, num_workers);
+  phase_times()->record_evac_fail_remove_self_forwards_workers(num_workers);
 }
 
 void G1CollectedHeap::restore_after_evac_failure(G1RedirtyCardsQueueSet* rdcqs) {
@@ -3122,12 +3172,17 @@ void G1CollectedHeap::restore_after_evac_failure(G1RedirtyCardsQueueSet* rdcqs)
   phase_times()->record_evac_fail_remove_self_forwards((os::elapsedTime() - remove_self_forwards_start) * 1000.0);
 }
 
-void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m) {
+void G1CollectedHeap::preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m, bool pinned) {
   if (!_evacuation_failed) {
     _evacuation_failed = true;
   }
 
-  _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
+  if (!pinned) {
+    if (!_to_space_exhausted) {
+      _to_space_exhausted = true;
+    }
+    _evacuation_failed_info_array[worker_id].register_copy_failure(obj->size());
+  }
   _preserved_marks_set.get(worker_id)->push_if_necessary(obj, m);
 }
 
@@ -3229,6 +3284,10 @@ class G1RedirtyLoggedCardsTask : public AbstractGangTask {
     AbstractGangTask("Redirty Cards"),
     _qset(qset), _g1h(g1h), _nodes(qset->all_completed_buffers()) { }
 
+  // Redirtying a card is a single card table store, so only use another
+  // worker for every CardsPerWorker cards.
+  static const size_t CardsPerWorker = 32 * K;
+
   virtual void work(uint worker_id) {
     G1GCPhaseTimes* p = _g1h->phase_times();
     G1GCParPhaseTimesTracker x(p, G1GCPhaseTimes::RedirtyCards, worker_id);
@@ -3244,7 +3303,14 @@ void G1CollectedHeap::redirty_logged_cards(G1RedirtyCardsQueueSet* rdcqs) {
   double redirty_logged_cards_start = os::elapsedTime();
 
   G1RedirtyLoggedCardsTask redirty_task(rdcqs, this);
-  workers()->run_task(&redirty_task);
+  size_t const num_cards = rdcqs->entry_count();
+  uint const num_workers = WorkerPolicy::calc_workers_for_work(workers()->active_workers(),
+                                                               num_cards,
+                                                               G1RedirtyLoggedCardsTask::CardsPerWorker);
+  log_debug(gc, ergo)("Running %s using %u workers for " SIZE_FORMAT " cards",
+                      redirty_task.name(), num_workers, num_cards);
+  workers()->run_task(&redirty_task, num_workers);
+  phase_times()->record_redirty_logged_cards_workers(num_workers);
 
   G1DirtyCardQueueSet& dcq = G1BarrierSet::dirty_card_queue_set();
   dcq.merge_bufferlists(rdcqs);
@@ -3541,6 +3607,7 @@ void G1CollectedHeap::merge_per_thread_state_info(G1ParScanThreadStateSet* per_t
 void G1CollectedHeap::pre_evacuate_collection_set(G1EvacuationInfo& evacuation_info, G1ParScanThreadStateSet* per_thread_states) {
   _expand_heap_after_alloc_failure = true;
   _evacuation_failed = false;
+  _to_space_exhausted = false;
 
   // Disable the hot card cache.
   _hot_card_cache->reset_hot_cache_claimed_index();
@@ -3758,7 +3825,7 @@ void G1CollectedHeap::evacuate_next_optional_regions(G1ParScanThreadStateSet* pe
 void G1CollectedHeap::evacuate_optional_collection_set(G1ParScanThreadStateSet* per_thread_states) {
   const double gc_start_time_ms = phase_times()->cur_collection_start_sec() * 1000.0;
 
-  while (!evacuation_failed() && _collection_set.optional_region_length() > 0) {
+  while (!to_space_exhausted() && _collection_set.optional_region_length() > 0) {
 
     double time_used_ms = os::elapsedTime() * 1000.0 - gc_start_time_ms;
     double time_left_ms = MaxGCPauseMillis - time_used_ms;
@@ -4199,14 +4266,16 @@ void G1CollectedHeap::free_collection_set(G1CollectionSet* collection_set, G1Eva
 
   {
     uint const num_regions = _collection_set.region_length();
-    uint const num_chunks = MAX2(num_regions / G1FreeCollectionSetTask::chunk_size(), 1U);
-    uint const num_workers = MIN2(workers()->active_workers(), num_chunks);
+    uint const num_workers = WorkerPolicy::calc_workers_for_work(workers()->active_workers(),
+                                                                 num_regions,
+                                                                 G1FreeCollectionSetTask::chunk_size());
 
     G1FreeCollectionSetTask cl(collection_set, &evacuation_info, surviving_young_words);
 
     log_debug(gc, ergo)("Running %s using %u workers for collection set length %u",
                         cl.name(), num_workers, num_regions);
     workers()->run_task(&cl, num_workers);
+    phase_times()->record_free_cset_workers(num_workers);
   }
   phase_times()->record_total_free_cset_time_ms((os::elapsedTime() - free_cset_start_time) * 1000.0);
 
@@ -4547,13 +4616,15 @@ void G1CollectedHeap::rebuild_region_sets(bool free_list_only) {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   bool should_allocate = policy()->should_allocate_mutator_region();
   if (force || should_allocate) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               HeapRegionType::Eden,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, !should_allocate);
@@ -4591,7 +4662,7 @@ bool G1CollectedHeap::has_more_regions(G1HeapRegionAttr dest) {
   }
 }
 
-HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest) {
+HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (!has_more_regions(dest)) {
@@ -4607,7 +4678,8 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size, G1HeapRegionA
 
   HeapRegion* new_alloc_region = new_region(word_size,
                                             type,
-                                            true /* do_expand */);
+                                            true /* do_expand */,
+                                            node_index);
 
   if (new_alloc_region != NULL) {
     if (type.is_survivor()) {
@@ -41,6 +41,7 @@
 #include "gc/g1/g1HRPrinter.hpp"
 #include "gc/g1/g1HeapRegionAttr.hpp"
 #include "gc/g1/g1MonitoringSupport.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1RedirtyCardsQueue.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
 #include "gc/g1/g1YCTypes.hpp"
@@ -194,6 +195,9 @@ private:
   // The sequence of all heap regions in the heap.
   HeapRegionManager* _hrm;
 
+  // Keeps track of the NUMA nodes the heap is spread over.
+  G1NUMA* _numa;
+
   // Manages all allocations with regions except humongous object allocations.
   G1Allocator* _allocator;
 
@@ -387,7 +391,12 @@ private:
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. 'type' takes the type of region to be allocated. (Use constants
   // Old, Eden, Humongous, Survivor defined in HeapRegionType.)
-  HeapRegion* new_region(size_t word_size, HeapRegionType type, bool do_expand);
+  // 'node_index' is the preferred NUMA node of the region, G1NUMA::AnyNodeIndex
+  // if there is no preference.
+  HeapRegion* new_region(size_t word_size,
+                         HeapRegionType type,
+                         bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -462,13 +471,13 @@ private:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   bool has_more_regions(G1HeapRegionAttr dest);
-  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest);
+  HeapRegion* new_gc_alloc_region(size_t word_size, G1HeapRegionAttr dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, G1HeapRegionAttr dest);
 
@@ -795,6 +804,9 @@ public:
 
   // True iff a evacuation has failed in the current collection.
   bool _evacuation_failed;
+  // True iff some of these failures were caused by running out of space
+  // rather than by objects in regions with pinned objects.
+  bool _to_space_exhausted;
 
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
@@ -809,8 +821,10 @@ public:
   PreservedMarksSet _preserved_marks_set;
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
-  // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m);
+  // word being overwritten with a self-forwarding-pointer. The object is
+  // not moved either because its region has pinned objects (pinned is true)
+  // or because we ran out of space.
+  void preserve_mark_during_evac_failure(uint worker_id, oop obj, markWord m, bool pinned);
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -976,6 +990,8 @@ public:
 
   HeapRegionManager* hrm() const { return _hrm; }
 
+  G1NUMA* numa() const { return _numa; }
+
   const G1CollectionSet* collection_set() const { return &_collection_set; }
   G1CollectionSet* collection_set() { return &_collection_set; }
 
@@ -1082,6 +1098,9 @@ public:
 
   // True iff an evacuation has failed in the most-recent collection.
   bool evacuation_failed() { return _evacuation_failed; }
+  // True iff an evacuation has failed in the most-recent collection because
+  // there was no space to copy objects to.
+  bool to_space_exhausted() { return _to_space_exhausted; }
 
   void remove_from_old_sets(const uint old_regions_removed, const uint humongous_regions_removed);
   void prepend_to_freelist(FreeRegionList* list);
@@ -1152,6 +1171,11 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+
+  // Iterate over the objects in the regions claimed by the given worker.
+  void object_iterate_parallel(ObjectClosure* cl, uint worker_id, HeapRegionClaimer* claimer);
+
   // Iterate over heap regions, in address order, terminating the
   // iteration early if the "do_heap_region" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
@@ -1374,6 +1398,13 @@ public:
   // Deduplicate the string
   virtual void deduplicate_string(oop str);
 
+  // Pinning an object pins its region: young collections do not evacuate
+  // the objects of such a region but keep them in place as self-forwarded,
+  // and full collections do not compact it.
+  virtual bool supports_object_pinning() const { return G1UseRegionPinning; }
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Perform any cleanup actions necessary before allowing a verification.
   virtual void prepare_for_verify();
 
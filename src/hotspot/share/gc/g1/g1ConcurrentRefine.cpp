@@ -198,15 +198,18 @@ inline size_t deactivation_level(const Thresholds& t) { return t.second; }
 
 static Thresholds calc_thresholds(size_t green_zone,
                                   size_t yellow_zone,
+                                  uint predicted_threads,
                                   uint worker_id) {
   double yellow_size = yellow_zone - green_zone;
   double step = yellow_size / G1ConcurrentRefine::max_num_threads();
-  if (worker_id == 0) {
+  if (worker_id < MAX2(predicted_threads, 1u)) {
     // Potentially activate worker 0 more aggressively, to keep
     // available buffers near green_zone value.  When yellow_size is
     // large we don't want to allow a full step to accumulate before
     // doing any processing, as that might lead to significantly more
     // than green_zone buffers to be processed during scanning.
+    // The same goes for the workers predicted to be needed to keep
+    // up with the mutators until the next GC.
     step = MIN2(step, ParallelGCThreads / 2.0);
   }
   size_t activate_offset = static_cast<size_t>(ceil(step * (worker_id + 1)));
@@ -223,7 +226,8 @@ G1ConcurrentRefine::G1ConcurrentRefine(size_t green_zone,
   _green_zone(green_zone),
   _yellow_zone(yellow_zone),
   _red_zone(red_zone),
-  _min_yellow_zone_size(min_yellow_zone_size)
+  _min_yellow_zone_size(min_yellow_zone_size),
+  _predicted_threads(0)
 {
   assert_zone_constraints_gyr(green_zone, yellow_zone, red_zone);
 }
@@ -381,13 +385,55 @@ void G1ConcurrentRefine::update_zones(double logged_cards_scan_time,
             _green_zone, _yellow_zone, _red_zone);
 }
 
+// The number of threads that can refine, at refine_rate_ms each, the
+// cards that are pending now plus those logged at logged_cards_rate_ms
+// until the next GC, less the green zone that is left for the pause.
+static uint calc_predicted_threads(size_t green_zone,
+                                   size_t pending_cards,
+                                   double logged_cards_rate_ms,
+                                   double refine_rate_ms,
+                                   double time_to_next_gc_ms) {
+  if (refine_rate_ms <= 0.0 || time_to_next_gc_ms <= 0.0) {
+    return 0;
+  }
+  double cards = pending_cards + logged_cards_rate_ms * time_to_next_gc_ms;
+  if (cards <= green_zone) {
+    return 0;
+  }
+  double threads = (cards - green_zone) / (refine_rate_ms * time_to_next_gc_ms);
+  return static_cast<uint>(ceil(MIN2(threads, (double)G1ConcurrentRefine::max_num_threads())));
+}
+
+void G1ConcurrentRefine::update_predicted_threads(double logged_cards_rate_ms,
+                                                  double refine_rate_ms,
+                                                  double time_to_next_gc_ms) {
+  size_t pending_cards = G1BarrierSet::dirty_card_queue_set().num_cards();
+  _predicted_threads = calc_predicted_threads(_green_zone,
+                                              pending_cards,
+                                              logged_cards_rate_ms,
+                                              refine_rate_ms,
+                                              time_to_next_gc_ms);
+  log_debug( CTRL_TAGS )("Predicted Refinement Threads: %u, "
+                         "pending cards: " SIZE_FORMAT ", "
+                         "logged cards rate: %.3f/ms, "
+                         "refinement rate: %.3f/ms, "
+                         "time to next GC: %.3fms",
+                         _predicted_threads, pending_cards,
+                         logged_cards_rate_ms, refine_rate_ms,
+                         time_to_next_gc_ms);
+}
+
 void G1ConcurrentRefine::adjust(double logged_cards_scan_time,
                                 size_t processed_logged_cards,
-                                double goal_ms) {
+                                double goal_ms,
+                                double logged_cards_rate_ms,
+                                double refine_rate_ms,
+                                double time_to_next_gc_ms) {
   G1DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
 
   if (G1UseAdaptiveConcRefinement) {
     update_zones(logged_cards_scan_time, processed_logged_cards, goal_ms);
+    update_predicted_threads(logged_cards_rate_ms, refine_rate_ms, time_to_next_gc_ms);
 
     // Change the barrier params
     if (max_num_threads() == 0) {
@@ -429,12 +475,12 @@ G1ConcurrentRefine::RefinementStats G1ConcurrentRefine::total_refinement_stats()
 }
 
 size_t G1ConcurrentRefine::activation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, _predicted_threads, worker_id);
   return activation_level(thresholds);
 }
 
 size_t G1ConcurrentRefine::deactivation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, _predicted_threads, worker_id);
   return deactivation_level(thresholds);
 }
 
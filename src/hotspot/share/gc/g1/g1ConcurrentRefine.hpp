@@ -92,6 +92,10 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   size_t _yellow_zone;
   size_t _red_zone;
   size_t _min_yellow_zone_size;
+  // Number of threads needed to refine the cards the mutators are predicted
+  // to log until the next GC. These threads are activated right above the
+  // green zone instead of being spread across the yellow zone.
+  uint _predicted_threads;
 
   G1ConcurrentRefine(size_t green_zone,
                      size_t yellow_zone,
@@ -103,6 +107,11 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
                     size_t processed_logged_cards,
                     double goal_ms);
 
+  // Update the number of threads activated right above the green zone.
+  void update_predicted_threads(double logged_cards_rate_ms,
+                                double refine_rate_ms,
+                                double time_to_next_gc_ms);
+
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_cards);
 
@@ -116,8 +125,15 @@ public:
 
   void stop();
 
-  // Adjust refinement thresholds based on work done during the pause and the goal time.
-  void adjust(double logged_cards_scan_time, size_t processed_logged_cards, double goal_ms);
+  // Adjust refinement thresholds based on work done during the pause and the goal time,
+  // and on the predicted card logging and refinement rates until the next GC.
+  // A rate or time of zero means that there is no prediction yet.
+  void adjust(double logged_cards_scan_time,
+              size_t processed_logged_cards,
+              double goal_ms,
+              double logged_cards_rate_ms,
+              double refine_rate_ms,
+              double time_to_next_gc_ms);
 
   struct RefinementStats {
     Tickspan _time;
@@ -148,6 +164,8 @@ public:
   size_t green_zone() const      { return _green_zone;  }
   size_t yellow_zone() const     { return _yellow_zone; }
   size_t red_zone() const        { return _red_zone;    }
+
+  uint predicted_threads() const { return _predicted_threads; }
 };
 
 #endif // SHARE_GC_G1_G1CONCURRENTREFINE_HPP
@@ -28,6 +28,7 @@
 #include "gc/g1/g1ConcurrentRefineThread.hpp"
 #include "gc/g1/g1DirtyCardQueue.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/handles.inline.hpp"
@@ -108,6 +109,7 @@ void G1ConcurrentRefineThread::run_service() {
                           G1BarrierSet::dirty_card_queue_set().num_cards());
 
     size_t start_total_refined_cards = _total_refined_cards; // For logging.
+    EventG1ConcurrentRefinement event;
 
     {
       SuspendibleThreadSetJoiner sts_join;
@@ -127,6 +129,11 @@ void G1ConcurrentRefineThread::run_service() {
     }
 
     deactivate();
+    if (event.should_commit()) {
+      event.set_workerId(_worker_id);
+      event.set_refinedCards(_total_refined_cards - start_total_refined_cards);
+      event.commit();
+    }
     log_debug(gc, refine)("Deactivated worker %d, off threshold: " SIZE_FORMAT
                           ", current: " SIZE_FORMAT ", refined cards: "
                           SIZE_FORMAT ", total refined cards: " SIZE_FORMAT,
@@ -34,6 +34,14 @@
 #include "oops/oop.inline.hpp"
 #include "utilities/ticks.hpp"
 
+class G1ResetPinnedLiveClosure : public StackObj {
+public:
+  size_t apply(oop obj) {
+    obj->init_mark_raw();
+    return obj->size();
+  }
+};
+
 class G1ResetHumongousClosure : public HeapRegionClosure {
   G1CMBitMap* _bitmap;
 
@@ -54,6 +62,13 @@ public:
         }
       }
       current->reset_during_compaction();
+    } else if (!current->is_pinned() && current->has_pinned_objects()) {
+      // Regions with pinned objects have not been compacted, but the objects
+      // have been forwarded to themselves.
+      G1ResetPinnedLiveClosure reset_pinned;
+      current->apply_to_marked_objects(_bitmap, &reset_pinned);
+      _bitmap->clear_region(current);
+      current->reset_during_compaction();
     }
     return false;
   }
@@ -50,7 +50,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
       free_humongous_region(hr);
     }
   } else if (!hr->is_pinned()) {
-    prepare_for_compaction(hr);
+    if (hr->has_pinned_objects()) {
+      prepare_pinned_region(hr);
+    } else {
+      prepare_for_compaction(hr);
+    }
   }
 
   // Reset data structures not valid after Full GC.
@@ -110,6 +114,16 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::free_humongous_region(Heap
   dummy_free_list.remove_all();
 }
 
+void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_pinned_region(HeapRegion* hr) {
+  // Objects in a region with pinned objects are not moved, so the region
+  // is not added to the compaction queue. Its live objects are forwarded
+  // to themselves like live humongous objects.
+  hr->reset_bot();
+  G1PreparePinnedLiveClosure prepare_pinned(hr);
+  hr->apply_to_marked_objects(_bitmap, &prepare_pinned);
+  prepare_pinned.fill_remainder();
+}
+
 void G1FullGCPrepareTask::G1CalculatePointersClosure::reset_region_metadata(HeapRegion* hr) {
   hr->rem_set()->clear();
   hr->clear_cardtable();
@@ -120,6 +134,44 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::reset_region_metadata(Heap
   }
 }
 
+G1FullGCPrepareTask::G1PreparePinnedLiveClosure::G1PreparePinnedLiveClosure(HeapRegion* hr) :
+    _hr(hr),
+    _last_live_end(hr->bottom()) { }
+
+size_t G1FullGCPrepareTask::G1PreparePinnedLiveClosure::apply(oop object) {
+  HeapWord* obj_addr = (HeapWord*)object;
+  size_t size = object->size();
+
+  fill_dead_range(_last_live_end, obj_addr);
+  object->forward_to(object);
+  _hr->cross_threshold(obj_addr, obj_addr + size);
+  _last_live_end = obj_addr + size;
+  return size;
+}
+
+void G1FullGCPrepareTask::G1PreparePinnedLiveClosure::fill_remainder() {
+  fill_dead_range(_last_live_end, _hr->top());
+}
+
+// The dead objects may refer to unloaded classes, so the region would not
+// be parsable any more without overwriting them.
+void G1FullGCPrepareTask::G1PreparePinnedLiveClosure::fill_dead_range(HeapWord* start, HeapWord* end) {
+  if (start == end) {
+    return;
+  }
+  size_t gap_size = pointer_delta(end, start);
+  assert(gap_size >= CollectedHeap::min_fill_size(), "Dead range must contain at least one object");
+  CollectedHeap::fill_with_objects(start, gap_size);
+
+  // Fill_with_objects() creates at most two objects, see
+  // RemoveSelfForwardPtrObjClosure::zap_dead_objects().
+  HeapWord* end_first_obj = start + ((oop)start)->size();
+  _hr->cross_threshold(start, end_first_obj);
+  if (end_first_obj != end) {
+    _hr->cross_threshold(end_first_obj, end);
+  }
+}
+
 G1FullGCPrepareTask::G1PrepareCompactLiveClosure::G1PrepareCompactLiveClosure(G1FullGCCompactionPoint* cp) :
     _cp(cp) { }
 
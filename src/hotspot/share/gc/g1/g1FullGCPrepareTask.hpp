@@ -60,6 +60,7 @@ protected:
     void prepare_for_compaction_work(G1FullGCCompactionPoint* cp, HeapRegion* hr);
     void free_humongous_region(HeapRegion* hr);
     void reset_region_metadata(HeapRegion* hr);
+    void prepare_pinned_region(HeapRegion* hr);
 
   public:
     G1CalculatePointersClosure(G1CMBitMap* bitmap,
@@ -78,6 +79,20 @@ protected:
     size_t apply(oop object);
   };
 
+  // Keeps the live objects of a region with pinned objects in place and
+  // overwrites the dead ones with filler objects, rebuilding the BOT.
+  class G1PreparePinnedLiveClosure : public StackObj {
+    HeapRegion* _hr;
+    HeapWord* _last_live_end;
+
+    void fill_dead_range(HeapWord* start, HeapWord* end);
+
+  public:
+    G1PreparePinnedLiveClosure(HeapRegion* hr);
+    size_t apply(oop object);
+    void fill_remainder();
+  };
+
   class G1RePrepareClosure : public StackObj {
     G1FullGCCompactionPoint* _cp;
     HeapRegion* _current;
@@ -180,6 +180,10 @@ void G1GCPhaseTimes::reset() {
   _cur_derived_pointer_table_update_time_ms = 0.0;
   _cur_clear_ct_time_ms = 0.0;
   _cur_expand_heap_time_ms = 0.0;
+  _cur_clear_ct_workers = 0;
+  _cur_evac_fail_remove_self_forwards_workers = 0;
+  _recorded_redirty_logged_cards_workers = 0;
+  _recorded_free_cset_workers = 0;
   _cur_ref_proc_time_ms = 0.0;
   _cur_collection_start_sec = 0.0;
   _root_region_scan_wait_time_ms = 0.0;
@@ -484,6 +488,7 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
   debug_time("Code Roots Fixup", _cur_collection_code_root_fixup_time_ms);
 
   debug_time("Clear Card Table", _cur_clear_ct_time_ms);
+  trace_count("Workers", _cur_clear_ct_workers);
 
   debug_time_for_reference("Reference Processing", _cur_ref_proc_time_ms);
   _ref_phase_times.print_all_references(2, false);
@@ -499,12 +504,14 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
     debug_time("Evacuation Failure", evac_fail_handling);
     trace_time("Recalculate Used", _cur_evac_fail_recalc_used);
     trace_time("Remove Self Forwards",_cur_evac_fail_remove_self_forwards);
+    trace_count("Remove Self Forwards Workers", _cur_evac_fail_remove_self_forwards_workers);
   }
 
   debug_time("Merge Per-Thread State", _recorded_merge_pss_time_ms);
   debug_time("Code Roots Purge", _cur_strong_code_root_purge_time_ms);
 
   debug_time("Redirty Cards", _recorded_redirty_logged_cards_time_ms);
+  trace_count("Workers", _recorded_redirty_logged_cards_workers);
   trace_phase(_gc_par_phases[RedirtyCards]);
 #if COMPILER2_OR_JVMCI
   debug_time("DerivedPointerTable Update", _cur_derived_pointer_table_update_time_ms);
@@ -512,6 +519,7 @@ double G1GCPhaseTimes::print_post_evacuate_collection_set() const {
 
   debug_time("Free Collection Set", _recorded_total_free_cset_time_ms);
   trace_time("Free Collection Set Serial", _recorded_serial_free_cset_time_ms);
+  trace_count("Workers", _recorded_free_cset_workers);
   trace_phase(_gc_par_phases[YoungFreeCSet]);
   trace_phase(_gc_par_phases[NonYoungFreeCSet]);
 
@@ -621,7 +629,8 @@ void G1EvacPhaseWithTrimTimeTracker::stop() {
 }
 
 G1GCParPhaseTimesTracker::G1GCParPhaseTimesTracker(G1GCPhaseTimes* phase_times, G1GCPhaseTimes::GCParPhases phase, uint worker_id, bool must_record) :
-  _start_time(), _phase(phase), _phase_times(phase_times), _worker_id(worker_id), _event(), _must_record(must_record) {
+  _start_time(), _phase(phase), _phase_times(phase_times), _worker_id(worker_id), _event(), _must_record(must_record),
+  _hardware_counters(phase_times != NULL && HardwareCounters::should_measure(log_is_enabled(Trace, gc, phases, perf))) {
   if (_phase_times != NULL) {
     _start_time = Ticks::now();
   }
@@ -635,7 +644,26 @@ G1GCParPhaseTimesTracker::~G1GCParPhaseTimesTracker() {
       _phase_times->record_or_add_time_secs(_phase, _worker_id, (Ticks::now() - _start_time).seconds());
     }
     _event.commit(GCId::current(), _worker_id, G1GCPhaseTimes::phase_name(_phase));
+    if (_hardware_counters.is_active()) {
+      report_hardware_counters();
+    }
+  }
+}
+
+void G1GCParPhaseTimesTracker::report_hardware_counters() {
+  HardwareCounterValues values;
+  if (!_hardware_counters.elapsed(&values)) {
+    return;
+  }
+  const char* name = G1GCPhaseTimes::phase_name(_phase);
+  LogTarget(Trace, gc, phases, perf) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    ls.print("%s (%u): ", name, _worker_id);
+    HardwareCounters::print_on(&ls, values);
+    ls.cr();
   }
+  _hardware_counters.send_event(name, values);
 }
 
 G1EvacPhaseTimesTracker::G1EvacPhaseTimesTracker(G1GCPhaseTimes* phase_times,
@@ -30,6 +30,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "logging/logLevel.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/hardwareCounters.hpp"
 #include "utilities/macros.hpp"
 
 class LineBuffer;
@@ -179,6 +180,14 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double _cur_clear_ct_time_ms;
   double _cur_expand_heap_time_ms;
+
+  // Number of workers chosen from the amount of work for phases that do
+  // not use all active workers.
+  uint _cur_clear_ct_workers;
+  uint _cur_evac_fail_remove_self_forwards_workers;
+  uint _recorded_redirty_logged_cards_workers;
+  uint _recorded_free_cset_workers;
+
   double _cur_ref_proc_time_ms;
 
   double _cur_collection_start_sec;
@@ -288,6 +297,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_clear_ct_time_ms = ms;
   }
 
+  void record_clear_ct_workers(uint workers) {
+    _cur_clear_ct_workers = workers;
+  }
+
   void record_expand_heap_time(double ms) {
     _cur_expand_heap_time_ms = ms;
   }
@@ -332,6 +345,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_evac_fail_remove_self_forwards = ms;
   }
 
+  void record_evac_fail_remove_self_forwards_workers(uint workers) {
+    _cur_evac_fail_remove_self_forwards_workers = workers;
+  }
+
   void record_string_deduplication_time(double ms) {
     _cur_string_deduplication_time_ms = ms;
   }
@@ -348,6 +365,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _recorded_total_free_cset_time_ms = time_ms;
   }
 
+  void record_free_cset_workers(uint workers) {
+    _recorded_free_cset_workers = workers;
+  }
+
   void record_serial_free_cset_time_ms(double time_ms) {
     _recorded_serial_free_cset_time_ms = time_ms;
   }
@@ -375,6 +396,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _recorded_redirty_logged_cards_time_ms = time_ms;
   }
 
+  void record_redirty_logged_cards_workers(uint workers) {
+    _recorded_redirty_logged_cards_workers = workers;
+  }
+
   void record_preserve_cm_referents_time_ms(double time_ms) {
     _recorded_preserve_cm_referents_time_ms = time_ms;
   }
@@ -479,6 +504,9 @@ protected:
   uint _worker_id;
   EventGCPhaseParallel _event;
   bool _must_record;
+  HardwareCounterScope _hardware_counters;
+
+  void report_hardware_counters();
 
 public:
   G1GCParPhaseTimesTracker(G1GCPhaseTimes* phase_times, G1GCPhaseTimes::GCParPhases phase, uint worker_id, bool must_record = true);
@@ -29,6 +29,8 @@
 #include "gc/g1/g1MemoryPool.hpp"
 #include "gc/shared/hSpaceCounters.hpp"
 #include "memory/metaspaceCounters.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "services/memoryPool.hpp"
 
 class G1GenerationCounters : public GenerationCounters {
@@ -110,7 +112,8 @@ G1MonitoringSupport::G1MonitoringSupport(G1CollectedHeap* g1h) :
   _eden_space_used(0),
   _survivor_space_committed(0),
   _survivor_space_used(0),
-  _old_gen_used(0) {
+  _old_gen_used(0),
+  _sizes_version(0) {
 
   recalculate_sizes();
 
@@ -203,8 +206,9 @@ void G1MonitoringSupport::initialize_serviceability() {
 }
 
 MemoryUsage G1MonitoringSupport::memory_usage() {
-  MutexLocker x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
-  return MemoryUsage(InitialHeapSize, _overall_used, _overall_committed, _g1h->max_capacity());
+  size_t used, committed;
+  read_sizes(&_overall_used, &_overall_committed, &used, &committed);
+  return MemoryUsage(InitialHeapSize, used, committed, _g1h->max_capacity());
 }
 
 GrowableArray<GCMemoryManager*> G1MonitoringSupport::memory_managers() {
@@ -226,6 +230,8 @@ void G1MonitoringSupport::recalculate_sizes() {
   assert_heap_locked_or_at_safepoint(true);
 
   MutexLocker x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+  _sizes_version++;
+  OrderAccess::storestore();
   // Recalculate all the sizes from scratch.
 
   // This never includes used bytes of current allocating heap region.
@@ -285,6 +291,24 @@ void G1MonitoringSupport::recalculate_sizes() {
   assert(_old_gen_used <= _old_gen_committed, "Old gen used bytes(" SIZE_FORMAT
          ") should be less than or equal to old gen committed(" SIZE_FORMAT ")",
          _old_gen_used, _old_gen_committed);
+
+  OrderAccess::release_store(&_sizes_version, _sizes_version + 1);
+}
+
+void G1MonitoringSupport::read_sizes(const size_t* used, const size_t* committed,
+                                     size_t* used_result, size_t* committed_result) {
+  for (;;) {
+    uint version = OrderAccess::load_acquire(&_sizes_version);
+    if ((version & 1) == 0) {
+      *used_result = *(const volatile size_t*)used;
+      *committed_result = *(const volatile size_t*)committed;
+      OrderAccess::loadload();
+      if (version == _sizes_version) {
+        return;
+      }
+    }
+    SpinPause();
+  }
 }
 
 void G1MonitoringSupport::update_sizes() {
@@ -317,29 +341,32 @@ void G1MonitoringSupport::update_eden_size() {
 }
 
 MemoryUsage G1MonitoringSupport::eden_space_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLocker x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+  size_t used, committed;
+  read_sizes(&_eden_space_used, &_eden_space_committed, &used, &committed);
 
   return MemoryUsage(initial_size,
-                     _eden_space_used,
-                     _eden_space_committed,
+                     used,
+                     committed,
                      max_size);
 }
 
 MemoryUsage G1MonitoringSupport::survivor_space_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLocker x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+  size_t used, committed;
+  read_sizes(&_survivor_space_used, &_survivor_space_committed, &used, &committed);
 
   return MemoryUsage(initial_size,
-                     _survivor_space_used,
-                     _survivor_space_committed,
+                     used,
+                     committed,
                      max_size);
 }
 
 MemoryUsage G1MonitoringSupport::old_gen_memory_usage(size_t initial_size, size_t max_size) {
-  MutexLocker x(MonitoringSupport_lock, Mutex::_no_safepoint_check_flag);
+  size_t used, committed;
+  read_sizes(&_old_gen_used, &_old_gen_committed, &used, &committed);
 
   return MemoryUsage(initial_size,
-                     _old_gen_used,
-                     _old_gen_committed,
+                     used,
+                     committed,
                      max_size);
 }
 
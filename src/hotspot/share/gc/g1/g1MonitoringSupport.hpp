@@ -174,9 +174,19 @@ class G1MonitoringSupport : public CHeapObj<mtGC> {
 
   size_t _old_gen_used;
 
+  // Incremented before and after recalculate_sizes() updates the sizes
+  // above, so it is odd while an update is in progress. The MemoryPool
+  // usage readers retry on a version change instead of taking
+  // MonitoringSupport_lock, which only serializes the updaters.
+  volatile uint _sizes_version;
+
   // Recalculate all the sizes.
   void recalculate_sizes();
 
+  // Read a used/committed pair consistent with one recalculate_sizes().
+  void read_sizes(const size_t* used, const size_t* committed,
+                  size_t* used_result, size_t* committed_result);
+
   void recalculate_eden_size();
 
 public:
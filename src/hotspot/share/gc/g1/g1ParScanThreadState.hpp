@@ -33,6 +33,7 @@
 #include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/ageTable.hpp"
+#include "gc/shared/partialArrayTaskStepper.hpp"
 #include "memory/allocation.hpp"
 #include "oops/oop.hpp"
 #include "utilities/ticks.hpp"
@@ -95,10 +96,17 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   size_t _num_optional_regions;
   G1OopStarChunkedList* _oops_into_optional_regions;
 
+  // Splits large object arrays into chunks that are claimed through the
+  // length field of the to-space copy, so several workers can scan the
+  // same array at once.
+  PartialArrayTaskStepper _partial_array_stepper;
+  int const _partial_objarray_chunk_size;
+
 public:
   G1ParScanThreadState(G1CollectedHeap* g1h,
                        G1RedirtyCardsQueueSet* rdcqs,
                        uint worker_id,
+                       uint n_workers,
                        size_t young_cset_length,
                        size_t optional_cset_length);
   virtual ~G1ParScanThreadState();
@@ -177,6 +185,7 @@ private:
   }
 
   inline void do_oop_partial_array(oop* p);
+  inline void start_partial_objarray(G1HeapRegionAttr dest_attr, oop from, oop to);
 
   // This method is applied to the fields of the objects that have just been copied.
   template <class T> inline void do_oop_evac(T* p);
@@ -196,13 +205,14 @@ private:
   HeapWord* allocate_in_next_plab(G1HeapRegionAttr const region_attr,
                                   G1HeapRegionAttr* dest,
                                   size_t word_sz,
-                                  bool previous_plab_refill_failed);
+                                  bool previous_plab_refill_failed,
+                                  uint node_index);
 
   inline G1HeapRegionAttr next_region_attr(G1HeapRegionAttr const region_attr, markWord const m, uint& age);
 
   void report_promotion_event(G1HeapRegionAttr const dest_attr,
                               oop const old, size_t word_sz, uint age,
-                              HeapWord * const obj_ptr) const;
+                              HeapWord * const obj_ptr, uint node_index) const;
 
   inline bool needs_partial_trimming() const;
   inline bool is_partially_trimmed() const;
@@ -219,8 +229,9 @@ public:
 
   inline void steal_and_trim_queue(RefToScanQueueSet *task_queues);
 
-  // An attempt to evacuate "obj" has failed; take necessary steps.
-  oop handle_evacuation_failure_par(oop obj, markWord m);
+  // An attempt to evacuate "obj" has failed, or "obj" must stay in place because
+  // its region has pinned objects; take necessary steps.
+  oop handle_evacuation_failure_par(oop obj, markWord m, bool pinned = false);
 
   template <typename T>
   inline void remember_root_into_optional_region(T* p);
@@ -38,6 +38,7 @@
 #include "gc/g1/g1GCPhaseTimes.hpp"
 #include "gc/g1/g1Policy.hpp"
 #include "gc/g1/g1SurvivorRegions.hpp"
+#include "gc/g1/g1Trace.hpp"
 #include "gc/g1/g1YoungGenSizer.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
@@ -658,7 +659,7 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
   bool this_pause_included_initial_mark = false;
   bool this_pause_was_young_only = collector_state()->in_young_only_phase();
 
-  bool update_stats = !_g1h->evacuation_failed();
+  bool update_stats = !_g1h->to_space_exhausted();
 
   record_pause(young_gc_pause_kind(), end_time_sec - pause_time_ms / 1000.0, end_time_sec);
 
@@ -865,9 +866,36 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t heap_use
   log_debug(gc, ergo, refine)("Concurrent refinement times: Logged Cards Scan time goal: %1.2fms Logged Cards Scan time: %1.2fms HCC time: %1.2fms",
                               scan_logged_cards_time_goal_ms, logged_cards_time, scan_hcc_time_ms);
 
-  _g1h->concurrent_refine()->adjust(logged_cards_time,
-                                    phase_times()->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards),
-                                    scan_logged_cards_time_goal_ms);
+  G1ConcurrentRefine* cr = _g1h->concurrent_refine();
+  double logged_cards_rate_ms = _analytics->predict_logged_cards_rate_ms();
+  double refine_rate_ms = _analytics->predict_concurrent_refine_rate_ms();
+  double time_to_next_gc_ms = predict_time_to_next_gc_ms();
+  cr->adjust(logged_cards_time,
+             phase_times()->sum_thread_work_items(G1GCPhaseTimes::MergeLB, G1GCPhaseTimes::MergeLBDirtyCards),
+             scan_logged_cards_time_goal_ms,
+             logged_cards_rate_ms,
+             refine_rate_ms,
+             time_to_next_gc_ms);
+
+  _g1h->gc_tracer_stw()->report_refinement_control(cr->green_zone(),
+                                                   cr->yellow_zone(),
+                                                   cr->red_zone(),
+                                                   logged_cards_rate_ms,
+                                                   refine_rate_ms,
+                                                   time_to_next_gc_ms,
+                                                   cr->predicted_threads());
+}
+
+double G1Policy::predict_time_to_next_gc_ms() const {
+  if (_analytics->num_alloc_rate_ms() <= 3) {
+    return 0.0; // Not enough information to make the prediction
+  }
+  double alloc_rate_ms = _analytics->predict_alloc_rate_ms();
+  uint survivor_length = _g1h->survivor_regions_count();
+  if (alloc_rate_ms <= 0.0 || _young_list_target_length <= survivor_length) {
+    return 0.0;
+  }
+  return (_young_list_target_length - survivor_length) / alloc_rate_ms;
 }
 
 G1IHOPControl* G1Policy::create_ihop_control(const G1Predictions* predictor){
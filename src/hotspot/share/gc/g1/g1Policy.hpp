@@ -148,6 +148,9 @@ public:
 
   double predict_survivor_regions_evac_time() const;
 
+  // Predicted mutator time until the eden is full again.
+  double predict_time_to_next_gc_ms() const;
+
   void cset_regions_freed() {
     bool update = should_update_surv_rate_group_predictors();
 
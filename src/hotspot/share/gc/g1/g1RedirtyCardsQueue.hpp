@@ -115,6 +115,8 @@ public:
   // Processing phase operations.
   // precondition: Must not be concurrent with buffer collection.
   BufferNode* all_completed_buffers() const;
+  // Number of card entries in the collected buffers.
+  size_t entry_count() const { return _entry_count; }
   G1BufferNodeList take_all_completed_buffers();
 };
 
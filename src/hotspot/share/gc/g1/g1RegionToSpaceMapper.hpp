@@ -53,6 +53,8 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   CHeapBitMap _commit_map;
 
+  MemoryType _memory_type;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t used_size, size_t page_size, size_t region_granularity, size_t commit_factor, MemoryType type);
 
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
@@ -71,6 +73,11 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   }
 
   void commit_and_set_special();
+  // Notify the listener about regions whose memory has stayed committed while they
+  // were not in use, so that their contents are reset as after a fresh commit.
+  void reactivate_regions(uint start_idx, size_t num_regions = 1) {
+    fire_on_commit(start_idx, num_regions, false /* zero_filled */);
+  }
   virtual void commit_regions(uint start_idx, size_t num_regions = 1, WorkGang* pretouch_workers = NULL) = 0;
   virtual void uncommit_regions(uint start_idx, size_t num_regions = 1) = 0;
 
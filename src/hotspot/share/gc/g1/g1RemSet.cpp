@@ -44,6 +44,7 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "gc/shared/ptrQueue.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
+#include "gc/shared/workerPolicy.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
@@ -277,7 +278,7 @@ private:
     }
 
     uint const num_chunks = (uint)(align_up((size_t)num_regions << HeapRegion::LogCardsPerRegion, G1ClearCardTableTask::chunk_size()) / G1ClearCardTableTask::chunk_size());
-    uint const num_workers = MIN2(num_chunks, workers->active_workers());
+    uint const num_workers = WorkerPolicy::calc_workers_for_work(workers->active_workers(), num_chunks, 1);
     uint const chunk_length = G1ClearCardTableTask::chunk_size() / (uint)HeapRegion::CardsPerRegion;
 
     // Iterate over the dirty cards region list.
@@ -287,6 +288,7 @@ private:
                         "units of work for %u regions.",
                         cl.name(), num_workers, num_chunks, num_regions);
     workers->run_task(&cl, num_workers);
+    G1CollectedHeap::heap()->phase_times()->record_clear_ct_workers(num_workers);
 
 #ifndef PRODUCT
     G1CollectedHeap::heap()->verifier()->verify_card_table_cleanup();
@@ -936,6 +938,15 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       _scan_state->add_dirty_region(region_idx);
       return true;
     }
+
+    void mark_cards_dirty(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
+      size_t const region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
+      for (uint i = 0; i < num_cards; i++) {
+        size_t card_idx = region_base_idx + cards[i];
+        _ct->mark_clean_as_dirty(card_idx);
+        _scan_state->set_chunk_dirty(card_idx);
+      }
+    }
   public:
     G1MergeCardSetClosure(G1RemSetScanState* scan_state) :
       _scan_state(scan_state),
@@ -972,19 +983,22 @@ class G1MergeHeapRootsTask : public AbstractGangTask {
       }
     }
 
-    void next_sparse_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
+    void next_fine_array_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
       if (!remember_if_interesting(region_idx)) {
         return;
       }
 
-      _merged_sparse++;
+      _merged_fine++;
+      mark_cards_dirty(region_idx, cards, num_cards);
+    }
 
-      size_t const region_base_idx = (size_t)region_idx << HeapRegion::LogCardsPerRegion;
-      for (uint i = 0; i < num_cards; i++) {
-        size_t card_idx = region_base_idx + cards[i];
-        _ct->mark_clean_as_dirty(card_idx);
-        _scan_state->set_chunk_dirty(card_idx);
+    void next_sparse_prt(uint const region_idx, SparsePRTEntry::card_elem_t* cards, uint const num_cards) {
+      if (!remember_if_interesting(region_idx)) {
+        return;
       }
+
+      _merged_sparse++;
+      mark_cards_dirty(region_idx, cards, num_cards);
     }
 
     virtual bool do_heap_region(HeapRegion* r) {
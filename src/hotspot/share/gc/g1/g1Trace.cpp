@@ -125,6 +125,22 @@ void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
                                 prediction_active);
 }
 
+void G1NewTracer::report_refinement_control(size_t green_zone,
+                                            size_t yellow_zone,
+                                            size_t red_zone,
+                                            double logged_cards_rate_ms,
+                                            double refine_rate_ms,
+                                            double time_to_next_gc_ms,
+                                            uint predicted_threads) {
+  send_refinement_control(green_zone,
+                          yellow_zone,
+                          red_zone,
+                          logged_cards_rate_ms,
+                          refine_rate_ms,
+                          time_to_next_gc_ms,
+                          predicted_threads);
+}
+
 void G1NewTracer::send_g1_young_gc_event() {
   EventG1GarbageCollection e(UNTIMED);
   if (e.should_commit()) {
@@ -243,6 +259,27 @@ void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
   }
 }
 
+void G1NewTracer::send_refinement_control(size_t green_zone,
+                                          size_t yellow_zone,
+                                          size_t red_zone,
+                                          double logged_cards_rate_ms,
+                                          double refine_rate_ms,
+                                          double time_to_next_gc_ms,
+                                          uint predicted_threads) {
+  EventG1RefinementControl evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_greenZone(green_zone);
+    evt.set_yellowZone(yellow_zone);
+    evt.set_redZone(red_zone);
+    evt.set_loggedCardsRate(logged_cards_rate_ms);
+    evt.set_refinementRate(refine_rate_ms);
+    evt.set_timeToNextGC(time_to_next_gc_ms);
+    evt.set_predictedThreads(predicted_threads);
+    evt.commit();
+  }
+}
+
 void G1OldTracer::report_gc_start_impl(GCCause::Cause cause, const Ticks& timestamp) {
   _shared_gc_info.set_start_timestamp(timestamp);
 }
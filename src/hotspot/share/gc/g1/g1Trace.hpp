@@ -69,6 +69,13 @@ public:
                                        double predicted_allocation_rate,
                                        double predicted_marking_length,
                                        bool prediction_active);
+  void report_refinement_control(size_t green_zone,
+                                 size_t yellow_zone,
+                                 size_t red_zone,
+                                 double logged_cards_rate_ms,
+                                 double refine_rate_ms,
+                                 double time_to_next_gc_ms,
+                                 uint predicted_threads);
 private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(G1EvacuationInfo* info);
@@ -90,6 +97,13 @@ private:
                                      double predicted_allocation_rate,
                                      double predicted_marking_length,
                                      bool prediction_active);
+  void send_refinement_control(size_t green_zone,
+                               size_t yellow_zone,
+                               size_t red_zone,
+                               double logged_cards_rate_ms,
+                               double refine_rate_ms,
+                               double time_to_next_gc_ms,
+                               uint predicted_threads);
 };
 
 class G1OldTracer : public OldGCTracer {
@@ -30,10 +30,12 @@
 #include "gc/g1/g1Policy.hpp"
 #include "gc/g1/g1YoungRemSetSamplingThread.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
+#include "gc/g1/heapRegionManager.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "memory/universe.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "utilities/ticks.hpp"
 
 G1YoungRemSetSamplingThread::G1YoungRemSetSamplingThread() :
     ConcurrentGCThread(),
@@ -99,6 +101,27 @@ void G1YoungRemSetSamplingThread::check_for_periodic_gc(){
   }
 }
 
+// Release the memory of regions the heap has been shrunk by, in small steps so
+// that heap expansion and pauses do not need to wait long for the uncommit lock.
+void G1YoungRemSetSamplingThread::uncommit_inactive_regions() {
+  HeapRegionManager* hrm = G1CollectedHeap::heap()->hrm();
+  if (!hrm->has_inactive_regions()) {
+    return;
+  }
+  Ticks start = Ticks::now();
+  uint num_uncommitted = 0;
+  while (!should_terminate()) {
+    uint num_regions = hrm->uncommit_inactive_regions(G1UncommitBatchRegions);
+    if (num_regions == 0) {
+      break;
+    }
+    num_uncommitted += num_regions;
+  }
+  log_debug(gc, heap)("Concurrent uncommit: " SIZE_FORMAT "B (%u regions) %1.3fms",
+                      (size_t)num_uncommitted * HeapRegion::GrainBytes, num_uncommitted,
+                      (Ticks::now() - start).seconds() * MILLIUNITS);
+}
+
 void G1YoungRemSetSamplingThread::run_service() {
   double vtime_start = os::elapsedVTime();
 
@@ -120,6 +143,8 @@ void G1YoungRemSetSamplingThread::run_service() {
 
     check_for_periodic_gc();
 
+    uncommit_inactive_regions();
+
     sleep_before_next_cycle();
   }
 }
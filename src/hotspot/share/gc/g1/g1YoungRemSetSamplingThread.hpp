@@ -39,6 +39,9 @@
 // reevaluates the prediction for the remembered set scanning costs, and potentially
 // G1Policy resizes the young gen. This may do a premature GC or even
 // increase the young gen size to keep pause time length goal.
+//
+// It also triggers periodic GCs and releases the memory of regions the heap
+// has been shrunk by (see HeapRegionManager::uncommit_inactive_regions()).
 class G1YoungRemSetSamplingThread: public ConcurrentGCThread {
 private:
   Monitor _monitor;
@@ -51,6 +54,7 @@ private:
 
   void run_service();
   void check_for_periodic_gc();
+  void uncommit_inactive_regions();
 
   void stop_service();
 
@@ -181,6 +181,10 @@
           range(0, max_jint/wordSize)                                       \
           constraint(G1RSetSparseRegionEntriesConstraintFunc,AfterErgo)     \
                                                                             \
+  diagnostic(bool, G1RSetUseArrayContainers, true,                          \
+          "Keep the cards of medium occupancy fine-grain remembered set "   \
+          "entries in sorted arrays instead of bitmaps")                    \
+                                                                            \
   develop(intx, G1MaxVerifyFailures, -1,                                    \
           "The maximum number of verification failures to print.  "         \
           "-1 means print all.")                                            \
@@ -316,6 +320,21 @@
           "disables this check.")                                           \
           range(0.0, (double)max_uintx)                                     \
                                                                             \
+  experimental(bool, G1UseRegionPinning, true,                              \
+          "Keep objects used by JNI critical sections in place by pinning " \
+          "their regions instead of blocking garbage collections using "    \
+          "the GCLocker.")                                                  \
+                                                                            \
+  experimental(bool, G1UncommitConcurrently, true,                          \
+          "Release the memory of regions removed by heap shrinking in "     \
+          "the background instead of during the pause that shrinks "        \
+          "the heap.")                                                      \
+                                                                            \
+  experimental(uint, G1UncommitBatchRegions, 8,                             \
+          "Maximum number of regions uncommitted concurrently in one step " \
+          "while holding the uncommit lock.")                               \
+          range(1, max_juint)                                               \
+                                                                            \
   experimental(uintx, G1YoungExpansionBufferPercent, 10,                    \
                "When heterogenous heap is enabled by AllocateOldGenAt "     \
                "option, after every GC, young gen is re-sized which "       \
@@ -28,6 +28,7 @@
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1CollectionSet.hpp"
 #include "gc/g1/g1HeapRegionTraceType.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/g1OopClosures.inline.hpp"
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionBounds.inline.hpp"
@@ -118,6 +119,8 @@ void HeapRegion::hr_clear(bool keep_remset, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
   assert(!in_collection_set(),
          "Should not clear heap region %u in the collection set", hrm_index());
+  assert(!has_pinned_objects(),
+         "Should not clear heap region %u with pinned objects", hrm_index());
 
   clear_young_index_in_cset();
   clear_index_in_opt_cset();
@@ -240,6 +243,7 @@ HeapRegion::HeapRegion(uint hrm_index,
     _type(),
     _humongous_start_region(NULL),
     _evacuation_failed(false),
+    _pinned_object_count(0),
     _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
@@ -248,7 +252,8 @@ HeapRegion::HeapRegion(uint hrm_index,
     _index_in_opt_cset(InvalidCSetIndex), _young_index_in_cset(-1),
     _surv_rate_group(NULL), _age_index(-1),
     _prev_top_at_mark_start(NULL), _next_top_at_mark_start(NULL),
-    _recorded_rs_length(0), _predicted_elapsed_time_ms(0)
+    _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
+    _node_index(G1NUMA::numa()->preferred_node_index_for_index(hrm_index))
 {
   _rem_set = new HeapRegionRemSet(bot, this);
 
@@ -455,8 +460,13 @@ void HeapRegion::print_on(outputStream* st) const {
   } else {
     st->print("|  ");
   }
-  st->print_cr("|TAMS " PTR_FORMAT ", " PTR_FORMAT "| %s ",
+  st->print("|TAMS " PTR_FORMAT ", " PTR_FORMAT "| %s ",
                p2i(prev_top_at_mark_start()), p2i(next_top_at_mark_start()), rem_set()->get_state_str());
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa->is_enabled()) {
+    st->print("|%d", numa->numa_id(node_index()));
+  }
+  st->cr();
 }
 
 class G1VerificationClosure : public BasicOopIterateClosure {
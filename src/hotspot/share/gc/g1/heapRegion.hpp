@@ -34,6 +34,7 @@
 #include "gc/shared/cardTable.hpp"
 #include "gc/shared/verifyOption.hpp"
 #include "gc/shared/spaceDecorator.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/macros.hpp"
 
 // A HeapRegion is the smallest piece of a G1CollectedHeap that
@@ -235,6 +236,9 @@ class HeapRegion: public G1ContiguousSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of objects in this region currently pinned by JNI critical sections.
+  volatile size_t _pinned_object_count;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -291,6 +295,9 @@ class HeapRegion: public G1ContiguousSpace {
   // for the collection set.
   double _predicted_elapsed_time_ms;
 
+  // The preferred NUMA node index of the memory backing this region.
+  uint _node_index;
+
   // Iterate over the references covered by the given MemRegion in a humongous
   // object and apply the given closure to them.
   // Humongous objects are allocated directly in the old-gen. So we need special
@@ -377,6 +384,10 @@ class HeapRegion: public G1ContiguousSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // Returns the index of the NUMA node the memory of this region is
+  // preferably allocated on. Always 0 if NUMA support is disabled.
+  uint node_index() const { return _node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -443,6 +454,17 @@ class HeapRegion: public G1ContiguousSpace {
   // Humongous regions and archive regions are pinned.
   bool is_pinned() const { return _type.is_pinned(); }
 
+  // Objects in a region with pinned objects must not be moved either. In
+  // contrast to is_pinned(), this is a transient property of any region that
+  // can only change outside of safepoints.
+  bool has_pinned_objects() const { return pinned_object_count() > 0; }
+  size_t pinned_object_count() const { return Atomic::load(&_pinned_object_count); }
+  void increment_pinned_object_count() { Atomic::inc(&_pinned_object_count); }
+  void decrement_pinned_object_count() {
+    assert(has_pinned_objects(), "Unbalanced unpin in region %u", hrm_index());
+    Atomic::dec(&_pinned_object_count);
+  }
+
   // An archive region is a pinned region, also tagged as old, which
   // should not be marked during mark/sweep. This allows the address
   // space to be shared by JVM instances.
@@ -547,8 +569,8 @@ class HeapRegion: public G1ContiguousSpace {
   void note_self_forwarding_removal_end(size_t marked_bytes);
 
   void reset_during_compaction() {
-    assert(is_humongous(),
-           "should only be called for humongous regions");
+    assert(is_humongous() || has_pinned_objects(),
+           "should only be called for humongous regions or regions with pinned objects");
 
     zero_marked_bytes();
     init_top_at_mark_start();
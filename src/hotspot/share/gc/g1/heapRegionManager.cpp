@@ -26,11 +26,14 @@
 #include "gc/g1/g1Arguments.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
+#include "gc/g1/g1NUMA.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "gc/g1/heapRegionManager.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
 #include "gc/g1/heterogeneousHeapRegionManager.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "utilities/bitMap.inline.hpp"
 
 class MasterFreeRegionListChecker : public HeapRegionSetChecker {
@@ -60,6 +63,9 @@ HeapRegionManager::HeapRegionManager() :
   _cardtable_mapper(NULL),
   _card_counts_mapper(NULL),
   _available_map(mtGC),
+  _inactive_map(mtGC),
+  _num_inactive(0),
+  _uncommit_lock(Mutex::leaf - 1, "G1 Uncommit lock", true, Mutex::_safepoint_check_never),
   _num_committed(0),
   _allocated_heapregions_length(0),
   _regions(), _heap_mapper(NULL),
@@ -97,6 +103,7 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
   _regions.initialize(reserved.start(), reserved.end(), HeapRegion::GrainBytes);
 
   _available_map.initialize(_regions.length());
+  _inactive_map.initialize(_regions.length());
 }
 
 bool HeapRegionManager::is_available(uint region) const {
@@ -118,6 +125,7 @@ HeapRegion* HeapRegionManager::new_heap_region(uint hrm_index) {
 }
 
 void HeapRegionManager::commit_regions(uint index, size_t num_regions, WorkGang* pretouch_gang) {
+  assert_lock_strong(&_uncommit_lock);
   guarantee(num_regions > 0, "Must commit more than zero regions");
   guarantee(_num_committed + num_regions <= max_length(), "Cannot commit more than the maximum amount of regions");
 
@@ -147,9 +155,17 @@ void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
     }
   }
 
+  MutexLocker ml(&_uncommit_lock, Mutex::_no_safepoint_check_flag);
+
   _num_committed -= (uint)num_regions;
 
   _available_map.par_clear_range(start, start + num_regions, BitMap::unknown_range);
+  uncommit_storage(start, num_regions);
+}
+
+void HeapRegionManager::uncommit_storage(uint start, size_t num_regions) {
+  assert_lock_strong(&_uncommit_lock);
+
   _heap_mapper->uncommit_regions(start, num_regions);
 
   // Also uncommit auxiliary data
@@ -162,9 +178,90 @@ void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
   _card_counts_mapper->uncommit_regions(start, num_regions);
 }
 
+void HeapRegionManager::deactivate_regions(uint start, size_t num_regions) {
+  guarantee(num_regions >= 1, "Need to specify at least one region to deactivate, tried to deactivate zero regions at %u", start);
+  guarantee(_num_committed >= num_regions, "pre-condition");
+
+  // Print before deactivating, the regions are not available any more afterwards.
+  if (G1CollectedHeap::heap()->hr_printer()->is_active()) {
+    for (uint i = start; i < start + num_regions; i++) {
+      HeapRegion* hr = at(i);
+      G1CollectedHeap::heap()->hr_printer()->uncommit(hr);
+    }
+  }
+
+  MutexLocker ml(&_uncommit_lock, Mutex::_no_safepoint_check_flag);
+
+  _num_committed -= (uint)num_regions;
+
+  _available_map.par_clear_range(start, start + num_regions, BitMap::unknown_range);
+  _inactive_map.set_range(start, start + num_regions);
+  Atomic::add((uint)num_regions, &_num_inactive);
+}
+
+void HeapRegionManager::reactivate_regions(uint start, size_t num_regions) {
+  assert_lock_strong(&_uncommit_lock);
+  guarantee(_num_committed + num_regions <= max_length(), "Cannot commit more than the maximum amount of regions");
+
+  _num_committed += (uint)num_regions;
+
+  _inactive_map.clear_range(start, start + num_regions);
+  Atomic::sub((uint)num_regions, &_num_inactive);
+
+  // The heap memory of free regions needs no reset, but the auxiliary data
+  // must look as if it had just been committed.
+  _prev_bitmap_mapper->reactivate_regions(start, num_regions);
+  _next_bitmap_mapper->reactivate_regions(start, num_regions);
+
+  _bot_mapper->reactivate_regions(start, num_regions);
+  _cardtable_mapper->reactivate_regions(start, num_regions);
+
+  _card_counts_mapper->reactivate_regions(start, num_regions);
+}
+
+uint HeapRegionManager::find_same_state_from_idx(uint start_idx, uint end_idx) const {
+  assert(start_idx < end_idx, "must be");
+  bool inactive = _inactive_map.at(start_idx);
+  BitMap::idx_t end = inactive ? _inactive_map.get_next_zero_offset(start_idx, end_idx)
+                               : _inactive_map.get_next_one_offset(start_idx, end_idx);
+  return (uint)(end - start_idx);
+}
+
+uint HeapRegionManager::uncommit_inactive_regions(uint max_regions) {
+  assert(max_regions > 0, "must be");
+  MutexLocker ml(&_uncommit_lock, Mutex::_no_safepoint_check_flag);
+
+  BitMap::idx_t start = _inactive_map.get_next_one_offset(0);
+  if (start == _inactive_map.size()) {
+    return 0;
+  }
+  BitMap::idx_t limit = MIN2(start + max_regions, _inactive_map.size());
+  uint num_regions = (uint)(_inactive_map.get_next_zero_offset(start, limit) - start);
+
+  _inactive_map.clear_range(start, start + num_regions);
+  Atomic::sub(num_regions, &_num_inactive);
+
+  uncommit_storage((uint)start, num_regions);
+  return num_regions;
+}
+
 void HeapRegionManager::make_regions_available(uint start, uint num_regions, WorkGang* pretouch_gang) {
   guarantee(num_regions > 0, "No point in calling this for zero regions");
-  commit_regions(start, num_regions, pretouch_gang);
+  {
+    MutexLocker ml(&_uncommit_lock, Mutex::_no_safepoint_check_flag);
+    // Regions that are inactive only need to be reactivated, the others
+    // need to be committed.
+    uint end = start + num_regions;
+    for (uint cur = start; cur < end; ) {
+      uint num_same = find_same_state_from_idx(cur, end);
+      if (_inactive_map.at(cur)) {
+        reactivate_regions(cur, num_same);
+      } else {
+        commit_regions(cur, num_same, pretouch_gang);
+      }
+      cur += num_same;
+    }
+  }
   for (uint i = start; i < start + num_regions; i++) {
     if (_regions.get_by_index(i) == NULL) {
       HeapRegion* new_hr = new_heap_region(i);
@@ -190,6 +287,29 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions, Wor
   }
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(HeapRegionType type, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  bool from_head = !type.is_young();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && G1NUMA::numa()->is_enabled()) {
+    // Try to allocate with requested node index.
+    hr = _free_list.remove_region_with_node_index(from_head, requested_node_index);
+  }
+
+  if (hr == NULL) {
+    // If there's a single active node or we did not get a region from our requested node,
+    // try without requested node index.
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+
+  return hr;
+}
+
 MemoryUsage HeapRegionManager::get_auxiliary_data_memory_usage() const {
   size_t used_sz =
     _prev_bitmap_mapper->committed_size() +
@@ -424,7 +544,14 @@ uint HeapRegionManager::shrink_by(uint num_regions_to_remove) {
       (num_last_found = find_empty_from_idx_reverse(cur, &idx_last_found)) > 0) {
     uint to_remove = MIN2(num_regions_to_remove - removed, num_last_found);
 
-    shrink_at(idx_last_found + num_last_found - to_remove, to_remove);
+    uint index = idx_last_found + num_last_found - to_remove;
+    if (G1UncommitConcurrently) {
+      // Leave releasing the memory to the concurrent uncommit.
+      assert_empty_and_free(index, to_remove);
+      deactivate_regions(index, to_remove);
+    } else {
+      shrink_at(index, to_remove);
+    }
 
     cur = idx_last_found;
     removed += to_remove;
@@ -435,14 +562,18 @@ uint HeapRegionManager::shrink_by(uint num_regions_to_remove) {
   return removed;
 }
 
-void HeapRegionManager::shrink_at(uint index, size_t num_regions) {
 #ifdef ASSERT
+void HeapRegionManager::assert_empty_and_free(uint index, size_t num_regions) const {
   for (uint i = index; i < (index + num_regions); i++) {
     assert(is_available(i), "Expected available region at index %u", i);
     assert(at(i)->is_empty(), "Expected empty region at index %u", i);
     assert(at(i)->is_free(), "Expected free region at index %u", i);
   }
+}
 #endif
+
+void HeapRegionManager::shrink_at(uint index, size_t num_regions) {
+  assert_empty_and_free(index, num_regions);
   uncommit_regions(index, num_regions);
 }
 
@@ -491,6 +622,7 @@ void HeapRegionManager::verify() {
       prev_committed = false;
       continue;
     }
+    guarantee(!_inactive_map.at(i), "invariant: available region %u must not be inactive", i);
     num_committed++;
     HeapRegion* hr = _regions.get_by_index(i);
     guarantee(hr != NULL, "invariant: i: %u", i);
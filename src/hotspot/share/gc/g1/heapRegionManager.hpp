@@ -28,6 +28,8 @@
 #include "gc/g1/g1BiasedArray.hpp"
 #include "gc/g1/g1RegionToSpaceMapper.hpp"
 #include "gc/g1/heapRegionSet.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/mutex.hpp"
 #include "services/memoryUsage.hpp"
 
 class HeapRegion;
@@ -66,6 +68,13 @@ class G1HeapRegionTable : public G1BiasedMappedArray<HeapRegion*> {
 //   number of regions+1 for which we have HeapRegions.
 // * max_length() returns the maximum number of regions the heap can have.
 //
+// With G1UncommitConcurrently, regions removed by shrink_by() are only made
+// inactive: they are not available any more, but their memory stays committed
+// until uncommit_inactive_regions() releases it from a concurrent thread. An
+// inactive region that is needed again before that is simply reactivated.
+// The _uncommit_lock serializes the concurrent uncommit with commits, since
+// the auxiliary data mappers may share pages between regions.
+//
 
 class HeapRegionManager: public CHeapObj<mtGC> {
   friend class VMStructs;
@@ -79,6 +88,13 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // for allocation.
   CHeapBitMap _available_map;
 
+  // Each bit in this bitmap indicates that the corresponding region is inactive,
+  // i.e. not available but still committed. Protected by the _uncommit_lock.
+  CHeapBitMap _inactive_map;
+  volatile uint _num_inactive;
+
+  Mutex _uncommit_lock;
+
    // The number of regions committed in the heap.
   uint _num_committed;
 
@@ -90,6 +106,17 @@ class HeapRegionManager: public CHeapObj<mtGC> {
 
   // Pass down commit calls to the VirtualSpace.
   void commit_regions(uint index, size_t num_regions = 1, WorkGang* pretouch_gang = NULL);
+  // Pass down uncommit calls to the VirtualSpace. Requires the _uncommit_lock.
+  void uncommit_storage(uint index, size_t num_regions);
+
+  // Remove the given available, empty and free regions from use without
+  // uncommitting their memory.
+  void deactivate_regions(uint index, size_t num_regions);
+  // Undo deactivate_regions() for the given inactive regions.
+  void reactivate_regions(uint index, size_t num_regions);
+  // Finds the next sequence of regions starting from start_idx that are
+  // either all inactive or all neither inactive nor available.
+  uint find_same_state_from_idx(uint start_idx, uint end_idx) const;
 
   // Notify other data structures about change in the heap layout.
   void update_committed_space(HeapWord* old_end, HeapWord* new_end);
@@ -108,6 +135,8 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // sequence could be found, otherwise res_idx contains the start index of this range.
   uint find_empty_from_idx_reverse(uint start_idx, uint* res_idx) const;
 
+  void assert_empty_and_free(uint index, size_t num_regions) const NOT_DEBUG_RETURN;
+
 protected:
   G1HeapRegionTable _regions;
   G1RegionToSpaceMapper* _heap_mapper;
@@ -174,15 +203,9 @@ public:
     _free_list.add_ordered(list);
   }
 
-  virtual HeapRegion* allocate_free_region(HeapRegionType type) {
-    HeapRegion* hr = _free_list.remove_region(!type.is_young());
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region with the given type from the free list. Regions
+  // on the NUMA node given by requested_node_index are preferred, if any.
+  virtual HeapRegion* allocate_free_region(HeapRegionType type, uint requested_node_index);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -260,6 +283,12 @@ public:
   // empty, and free.
   void shrink_at(uint index, size_t num_regions);
 
+  // Returns whether there are inactive regions whose memory has not been released yet.
+  bool has_inactive_regions() const { return Atomic::load(&_num_inactive) > 0; }
+  // Uncommit the memory of up to max_regions inactive regions. Returns the
+  // number of regions uncommitted. Called by a concurrent thread.
+  uint uncommit_inactive_regions(uint max_regions);
+
   virtual void verify();
 
   // Do some sanity checking.
@@ -33,6 +33,7 @@
 #include "memory/padded.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/safepoint.hpp"
 #include "utilities/bitMap.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -60,6 +61,143 @@ PerRegionTable* PerRegionTable::alloc(HeapRegion* hr) {
 
 PerRegionTable* volatile PerRegionTable::_free_list = NULL;
 
+uint PerRegionTable::max_array_cards() {
+  if (!G1RSetUseArrayContainers) {
+    return 0;
+  }
+  // An array of this many 16 bit card indices takes half the memory of a
+  // bitmap for the region.  Only use arrays if they can hold more cards
+  // than a sparse entry, which is where the cards of a new table come from.
+  uint max_cards = (uint)HeapRegion::CardsPerRegion / 32;
+  return max_cards > (uint)G1RSetSparseRegionEntries ? max_cards : 0;
+}
+
+void PerRegionTable::reset_cards() {
+  _occupied = 0;
+  uint max_cards = max_array_cards();
+  if (max_cards == 0) {
+    if (_bm.size() == 0) {
+      _bm.initialize(HeapRegion::CardsPerRegion);
+    } else {
+      _bm.clear();
+    }
+    _is_bitmap = true;
+    return;
+  }
+  // Keep a bitmap from an earlier use of this table: threads that still
+  // think this table is in bitmap mode may concurrently set bits in it.
+  if (_cards == NULL) {
+    _cards_capacity = MIN2(max_cards, MAX2(2 * (uint)G1RSetSparseRegionEntries, 16u));
+    _cards = NEW_C_HEAP_ARRAY(card_elem_t, _cards_capacity, mtGC);
+  }
+  _num_cards = 0;
+  _is_bitmap = false;
+}
+
+bool PerRegionTable::grow_cards() {
+  uint max_cards = max_array_cards();
+  if (_cards_capacity >= max_cards) {
+    return false;
+  }
+  uint new_capacity = MIN2(_cards_capacity * 2, max_cards);
+  _cards = REALLOC_C_HEAP_ARRAY(card_elem_t, _cards, new_capacity, mtGC);
+  _cards_capacity = new_capacity;
+  return true;
+}
+
+void PerRegionTable::switch_to_bitmap() {
+  assert(!is_bitmap(), "must be");
+  if (_bm.size() == 0) {
+    _bm.initialize(HeapRegion::CardsPerRegion);
+  } else {
+    _bm.clear();
+  }
+  for (uint i = 0; i < _num_cards; i++) {
+    _bm.set_bit(_cards[i]);
+  }
+  FREE_C_HEAP_ARRAY(card_elem_t, _cards);
+  _cards = NULL;
+  _num_cards = 0;
+  _cards_capacity = 0;
+  // Concurrent threads may start to add cards to the bitmap without the lock
+  // as soon as they see this.
+  OrderAccess::release_store(&_is_bitmap, true);
+}
+
+void PerRegionTable::add_card_locked(CardIdx_t from_card_index) {
+  if (is_bitmap()) {
+    add_card_to_bitmap(from_card_index);
+    return;
+  }
+  assert(from_card_index >= 0 && (size_t)from_card_index < HeapRegion::CardsPerRegion,
+         "Card index %d out of range", from_card_index);
+  card_elem_t card = (card_elem_t)from_card_index;
+
+  // Binary search for the insertion point.
+  uint low = 0;
+  uint high = _num_cards;
+  while (low < high) {
+    uint mid = low + (high - low) / 2;
+    if (_cards[mid] < card) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low < _num_cards && _cards[low] == card) {
+    return;
+  }
+
+  if (_num_cards == _cards_capacity && !grow_cards()) {
+    switch_to_bitmap();
+    add_card_to_bitmap(from_card_index);
+    return;
+  }
+  memmove(&_cards[low + 1], &_cards[low], (_num_cards - low) * sizeof(card_elem_t));
+  _cards[low] = card;
+  _num_cards++;
+  _occupied++;
+}
+
+bool PerRegionTable::contains_reference(OopOrNarrowOopStar from) const {
+  assert(hr()->is_in_reserved(from), "Precondition.");
+  size_t card_ind = pointer_delta(from, hr()->bottom(),
+                                  G1CardTable::card_size);
+  if (is_bitmap()) {
+    return _bm.at(card_ind);
+  }
+  uint low = 0;
+  uint high = _num_cards;
+  while (low < high) {
+    uint mid = low + (high - low) / 2;
+    if (_cards[mid] < card_ind) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low < _num_cards && _cards[low] == card_ind;
+}
+
+void PerRegionTable::union_bitmap_into(BitMap* bm) {
+  if (is_bitmap()) {
+    bm->set_union(_bm);
+  } else {
+    for (uint i = 0; i < _num_cards; i++) {
+      bm->set_bit(_cards[i]);
+    }
+  }
+}
+
+void PerRegionTable::release_bitmap() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  if (is_bitmap() && max_array_cards() > 0) {
+    _bm.resize(0);
+    // Start out in array mode again when reused.
+    reset_cards();
+  }
+}
+
 size_t OtherRegionsTable::_max_fine_entries = 0;
 size_t OtherRegionsTable::_mod_max_fine_entries_mask = 0;
 size_t OtherRegionsTable::_fine_eviction_stride = 0;
@@ -227,7 +365,7 @@ void OtherRegionsTable::add_reference(OopOrNarrowOopStar from, uint tid) {
       assert(sprt_entry != NULL, "There should have been an entry");
       for (int i = 0; i < sprt_entry->num_valid_cards(); i++) {
         CardIdx_t c = sprt_entry->card(i);
-        prt->add_card(c);
+        prt->add_card_locked(c);
       }
       // Now we can delete the sparse entry.
       bool res = _sparse_table.delete_entry(from_hrm_ind);
@@ -240,7 +378,7 @@ void OtherRegionsTable::add_reference(OopOrNarrowOopStar from, uint tid) {
   // OtherRegionsTable for why this is OK.
   assert(prt != NULL, "Inv");
 
-  prt->add_reference(from);
+  prt->add_reference(from, _m);
   assert(contains_reference(from), "We just added " PTR_FORMAT " to the PRT (%d)", p2i(from), prt->contains_reference(from));
 }
 
@@ -361,11 +499,9 @@ size_t OtherRegionsTable::occ_sparse() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs differ in size depending on their representation.
+  for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+    sum += cur->mem_size();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -386,6 +522,13 @@ void OtherRegionsTable::clear() {
   // if there are no entries, skip this step
   if (_first_all_fine_prts != NULL) {
     guarantee(_first_all_fine_prts != NULL && _last_all_fine_prts != NULL, "just checking");
+    if (SafepointSynchronize::is_at_safepoint()) {
+      // Nobody can be adding cards to these tables any more, so shrink
+      // them back to arrays before they go on the free list.
+      for (PerRegionTable* cur = _first_all_fine_prts; cur != NULL; cur = cur->next()) {
+        cur->release_bitmap();
+      }
+    }
     PerRegionTable::bulk_free(_first_all_fine_prts, _last_all_fine_prts);
     memset(_fine_grain_regions, 0, _max_fine_entries * sizeof(_fine_grain_regions[0]));
   } else {
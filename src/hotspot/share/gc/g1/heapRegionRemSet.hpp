@@ -158,11 +158,26 @@ public:
   void clear();
 };
 
+// A PerRegionTable keeps the cards of a single region.  At medium occupancy
+// the cards are stored as a sorted, growable array of card indices within the
+// region, using 16 bits per card.  When that array would exceed half the size
+// of a bitmap with one bit per card of the region, the table switches to such
+// a bitmap.  Array tables may only be modified with the lock of the owning
+// remembered set held; bitmap tables are also updated without it.
 class PerRegionTable: public CHeapObj<mtGC> {
   friend class OtherRegionsTable;
 
+  typedef SparsePRTEntry::card_elem_t card_elem_t;
+
   HeapRegion*     _hr;
+  // The sorted card indices in array mode, NULL in bitmap mode.
+  card_elem_t*    _cards;
+  uint            _num_cards;
+  uint            _cards_capacity;
+  // Only allocated once the table switches to bitmap mode.
   CHeapBitMap     _bm;
+  // Set with release semantics once _bm contains all cards.
+  volatile bool   _is_bitmap;
   jint            _occupied;
 
   // next pointer for free/allocated 'all' list
@@ -177,18 +192,46 @@ class PerRegionTable: public CHeapObj<mtGC> {
   // Global free list of PRTs
   static PerRegionTable* volatile _free_list;
 
+  // Maximum number of cards in array mode, 0 if array mode is not used.
+  static uint max_array_cards();
+
+  // Reset to an empty table, in array mode if that is used.
+  void reset_cards();
+  bool grow_cards();
+  void switch_to_bitmap();
+
+  inline void add_card_to_bitmap(CardIdx_t from_card_index);
+
 protected:
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
+    _cards(NULL),
+    _num_cards(0),
+    _cards_capacity(0),
+    _bm(mtGC),
+    _is_bitmap(false),
     _occupied(0),
     _next(NULL), _prev(NULL),
     _collision_list_next(NULL)
-  {}
+  {
+    reset_cards();
+  }
 
 public:
-  // We need access in order to union things into the base table.
-  BitMap* bm() { return &_bm; }
+  bool is_bitmap() const { return OrderAccess::load_acquire(&_is_bitmap); }
+
+  // Bitmap mode accessor.
+  BitMap* bm() {
+    assert(is_bitmap(), "must be");
+    return &_bm;
+  }
+
+  // Array mode accessors.
+  card_elem_t* cards() const {
+    assert(!is_bitmap(), "must be");
+    return _cards;
+  }
+  uint num_cards() const { return _num_cards; }
 
   HeapRegion* hr() const { return OrderAccess::load_acquire(&_hr); }
 
@@ -200,28 +243,30 @@ public:
 
   void init(HeapRegion* hr, bool clear_links_to_all_list);
 
-  inline void add_reference(OopOrNarrowOopStar from);
+  // Adds the given reference or card.  "m" is the lock of the owning
+  // remembered set, taken if the table is in array mode.
+  inline void add_reference(OopOrNarrowOopStar from, Mutex* m);
+  inline void add_card(CardIdx_t from_card_index, Mutex* m);
+  // As above, with the lock of the owning remembered set already held.
+  void add_card_locked(CardIdx_t from_card_index);
 
-  inline void add_card(CardIdx_t from_card_index);
+  // (Destructively) union the cards of the current table into the given
+  // bitmap (which is assumed to span the cards of a region.)
+  void union_bitmap_into(BitMap* bm);
 
-  // (Destructively) union the bitmap of the current table into the given
-  // bitmap (which is assumed to be of the same size.)
-  void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
-  }
+  // Give back the memory of the bitmap of a table that is about to be put
+  // on the free list.  Only safe at a safepoint, when other threads can not
+  // be adding cards to it.
+  void release_bitmap();
 
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize +
+           _cards_capacity * sizeof(card_elem_t);
   }
 
   // Requires "from" to be in "hr()".
-  bool contains_reference(OopOrNarrowOopStar from) const {
-    assert(hr()->is_in_reserved(from), "Precondition.");
-    size_t card_ind = pointer_delta(from, hr()->bottom(),
-                                    G1CardTable::card_size);
-    return _bm.at(card_ind);
-  }
+  bool contains_reference(OopOrNarrowOopStar from) const;
 
   // Bulk-free the PRTs from prt to last, assumes that they are
   // linked together using their _next field.
@@ -317,9 +362,10 @@ public:
   // For each PRT in the card (remembered) set call one of the following methods
   // of the given closure:
   //
-  // set_full_region_dirty(uint region_idx) - pass the region index for coarse PRTs
-  // set_bitmap_dirty(uint region_idx, BitMap* bitmap) - pass the region index and bitmap for fine PRTs
-  // set_cards_dirty(uint region_idx, elem_t* cards, uint num_cards) - pass region index and cards for sparse PRTs
+  // next_coarse_prt(uint region_idx) - pass the region index for coarse PRTs
+  // next_fine_prt(uint region_idx, BitMap* bitmap) - pass the region index and bitmap for fine PRTs in bitmap mode
+  // next_fine_array_prt(uint region_idx, card_elem_t* cards, uint num_cards) - pass region index and cards for fine PRTs in array mode
+  // next_sparse_prt(uint region_idx, card_elem_t* cards, uint num_cards) - pass region index and cards for sparse PRTs
   template <class Closure>
   inline void iterate_prts(Closure& cl);
 
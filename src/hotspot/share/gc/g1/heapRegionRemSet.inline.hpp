@@ -35,13 +35,22 @@ inline void HeapRegionRemSet::iterate_prts(Closure& cl) {
   _other_regions.iterate(cl);
 }
 
-inline void PerRegionTable::add_card(CardIdx_t from_card_index) {
+inline void PerRegionTable::add_card_to_bitmap(CardIdx_t from_card_index) {
   if (_bm.par_set_bit(from_card_index)) {
     Atomic::inc(&_occupied);
   }
 }
 
-inline void PerRegionTable::add_reference(OopOrNarrowOopStar from) {
+inline void PerRegionTable::add_card(CardIdx_t from_card_index, Mutex* m) {
+  if (is_bitmap()) {
+    add_card_to_bitmap(from_card_index);
+  } else {
+    MutexLocker x(m, Mutex::_no_safepoint_check_flag);
+    add_card_locked(from_card_index);
+  }
+}
+
+inline void PerRegionTable::add_reference(OopOrNarrowOopStar from, Mutex* m) {
   // Must make this robust in case "from" is not in "_hr", because of
   // concurrency.
 
@@ -51,7 +60,7 @@ inline void PerRegionTable::add_reference(OopOrNarrowOopStar from) {
   // and adding a bit to the new table is never incorrect.
   if (loc_hr->is_in_reserved(from)) {
     CardIdx_t from_card = OtherRegionsTable::card_within_region(from, loc_hr);
-    add_card(from_card);
+    add_card(from_card, m);
   }
 }
 
@@ -61,9 +70,8 @@ inline void PerRegionTable::init(HeapRegion* hr, bool clear_links_to_all_list) {
     set_prev(NULL);
   }
   _collision_list_next = NULL;
-  _occupied = 0;
-  _bm.clear();
-  // Make sure that the bitmap clearing above has been finished before publishing
+  reset_cards();
+  // Make sure that the clearing above has been finished before publishing
   // this PRT to concurrent threads.
   OrderAccess::release_store(&_hr, hr);
 }
@@ -80,7 +88,11 @@ void OtherRegionsTable::iterate(Closure& cl) {
   {
     PerRegionTable* cur = _first_all_fine_prts;
     while (cur != NULL) {
-      cl.next_fine_prt(cur->hr()->hrm_index(), cur->bm());
+      if (cur->is_bitmap()) {
+        cl.next_fine_prt(cur->hr()->hrm_index(), cur->bm());
+      } else {
+        cl.next_fine_array_prt(cur->hr()->hrm_index(), cur->cards(), cur->num_cards());
+      }
       cur = cur->next();
     }
   }
@@ -71,7 +71,7 @@ class ObjectStartArray : public CHeapObj<mtGC> {
   }
 
   // Mapping from object start array entry to address of first word
-  HeapWord* addr_for_block(jbyte* p) {
+  HeapWord* addr_for_block(jbyte* p) const {
     assert(_blocks_region.contains(p),
            "out of bounds access to object start array");
     size_t delta = pointer_delta(p, _offset_base, sizeof(jbyte));
@@ -141,6 +141,9 @@ class ObjectStartArray : public CHeapObj<mtGC> {
   // object hit should be at the beginning of the block
   inline HeapWord* object_start(HeapWord* addr) const;
 
+  // Hint that object_start(addr) is going to be called soon.
+  inline void prefetch_object_start(HeapWord* addr) const;
+
   bool is_block_allocated(HeapWord* addr) {
     assert_covered_region_contains(addr);
     jbyte* block = block_for_addr(addr);
@@ -26,6 +26,7 @@
 #define SHARE_GC_PARALLEL_OBJECTSTARTARRAY_INLINE_HPP
 
 #include "gc/parallel/objectStartArray.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 // Optimized for finding the first object that crosses into
 // a given block. The blocks contain the offset of the last
@@ -49,5 +50,14 @@ HeapWord* ObjectStartArray::object_start(HeapWord* addr) const {
   return scroll_forward;
 }
 
+// Prefetch the start array entry and the first heap words of the block
+// that object_start(addr) is going to inspect.
+void ObjectStartArray::prefetch_object_start(HeapWord* addr) const {
+  assert_covered_region_contains(addr);
+  jbyte* block = block_for_addr(addr);
+  Prefetch::read(block, 0);
+  Prefetch::read(addr_for_block(block), 0);
+}
+
 
 #endif // SHARE_GC_PARALLEL_OBJECTSTARTARRAY_INLINE_HPP
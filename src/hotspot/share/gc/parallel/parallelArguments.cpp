@@ -61,6 +61,12 @@ void ParallelArguments::initialize() {
     vm_exit(1);
   }
 
+  // The number of reference processing threads is adjusted to the number
+  // of discovered references, so small sets stay on a single thread.
+  if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) && ParallelGCThreads > 1) {
+    FLAG_SET_DEFAULT(ParallelRefProcEnabled, true);
+  }
+
   if (UseAdaptiveSizePolicy) {
     // We don't want to limit adaptive heap sizing's freedom to adjust the heap
     // unless the user actually sets these flags.
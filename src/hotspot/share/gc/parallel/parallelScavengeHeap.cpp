@@ -393,6 +393,10 @@ ParallelScavengeHeap::death_march_check(HeapWord* const addr, size_t size) {
   }
 }
 
+HeapWord* ParallelScavengeHeap::mem_allocate_pretenured(size_t size) {
+  return old_gen()->allocate(size);
+}
+
 HeapWord* ParallelScavengeHeap::mem_allocate_old_gen(size_t size) {
   if (!should_alloc_in_eden(size) || GCLocker::is_active_and_needs_gc()) {
     // Size is too big for eden, or gc is locked out.
@@ -178,6 +178,9 @@ class ParallelScavengeHeap : public CollectedHeap {
   // "gc_time_limit_was_exceeded" has an undefined meaning.
   HeapWord* mem_allocate(size_t size, bool* gc_overhead_limit_was_exceeded);
 
+  virtual bool supports_pretenured_allocation() const { return true; }
+  virtual HeapWord* mem_allocate_pretenured(size_t size);
+
   // Allocation attempt(s) during a safepoint. It should never be called
   // to allocate a new TLAB as this allocation might be satisfied out
   // of the old generation.
@@ -72,6 +72,11 @@
           "Delay in scheduling GC workers (in milliseconds)")               \
                                                                             \
   product(bool, PSChunkLargeArrays, true,                                   \
-          "Process large arrays in chunks")
+          "Process large arrays in chunks")                                 \
+                                                                            \
+  product(uint, PSScavengeStripesPerWorker, 16,                             \
+          "Number of stripes of the old generation card table per GC "      \
+          "thread that are claimed dynamically during a young collection") \
+          range(1, 1024)
 
 #endif // SHARE_GC_PARALLEL_PARALLEL_GLOBALS_HPP
@@ -32,6 +32,7 @@
 #include "memory/iterator.inline.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/prefetch.inline.hpp"
 #include "utilities/align.hpp"
 
@@ -126,144 +127,214 @@ class CheckForPreciseMarks : public BasicOopIterateClosure {
 // when the space is empty, fix the calculation of
 // end_card to allow sp_top == sp->bottom().
 
-// The generation (old gen) is divided into slices, which are further
-// subdivided into stripes, with one stripe per GC thread. The size of
-// a stripe is a constant, ssize.
+// The generation (old gen) is divided into stripes of a fixed number of
+// cards, which the GC threads claim one at a time until all of them have
+// been handed out.
 //
-//      +===============+        slice 0
+//      +===============+
 //      |  stripe 0     |
 //      +---------------+
 //      |  stripe 1     |
 //      +---------------+
 //      |  stripe 2     |
 //      +---------------+
-//      |  stripe 3     |
-//      +===============+        slice 1
-//      |  stripe 0     |
-//      +---------------+
-//      |  stripe 1     |
-//      +---------------+
-//      |  stripe 2     |
-//      +---------------+
-//      |  stripe 3     |
-//      +===============+        slice 2
 //      ...
+//      +---------------+
+//      |  stripe n-1   |
+//      +===============+
 //
-// In this case there are 4 threads, so 4 stripes.  A GC thread first works on
-// its stripe within slice 0 and then moves to its stripe in the next slice
-// until it has exceeded the top of the generation.  The distance to stripe in
-// the next slice is calculated based on the number of stripes.  The next
-// stripe is at ssize * number_of_stripes (= slice_stride)..  So after
-// finishing stripe 0 in slice 0, the thread finds the stripe 0 in slice1 by
-// adding slice_stride to the start of stripe 0 in slice 0 to get to the start
-// of stride 0 in slice 1.
+// Claiming the stripes in address order keeps the scan mostly sequential,
+// while a thread that finds its stripes clean simply moves on to the next
+// unclaimed one. Dirty cards tend to be clustered, so this balances much
+// better than a fixed assignment of stripes to threads. The stripe size is
+// chosen so that each thread gets PSScavengeStripesPerWorker stripes on
+// average.
+
+PSCardTableStripes::PSCardTableStripes(HeapWord* bottom, HeapWord* top, uint num_workers) :
+  _stripe_size(MinStripeSize),
+  _num_stripes(0),
+  _claimed(0) {
+  assert(bottom <= top, "invariant");
+  if (bottom == top) {
+    return;
+  }
+  const size_t num_cards = (uintptr_t(top - 1) >> CardTable::card_shift) -
+                           (uintptr_t(bottom) >> CardTable::card_shift) + 1;
+  const size_t target_stripes = (size_t)MAX2(num_workers, 1u) * PSScavengeStripesPerWorker;
+  _stripe_size = MAX2(num_cards / target_stripes, MinStripeSize);
+  _num_stripes = (num_cards + _stripe_size - 1) / _stripe_size;
+}
+
+bool PSCardTableStripes::try_claim(size_t& stripe) {
+  // Check first, so that the counter stops growing once all stripes
+  // have been handed out.
+  if (Atomic::load(&_claimed) >= _num_stripes) {
+    return false;
+  }
+  size_t claimed = Atomic::add((size_t)1, &_claimed) - 1;
+  if (claimed >= _num_stripes) {
+    return false;
+  }
+  stripe = claimed;
+  return true;
+}
+
+// Remembers the last object located through the object start array. An
+// objArray spanning many stripes is looked up again for every stripe and
+// every run of dirty cards within it, and walking the start array back to
+// its header each time would get expensive.
+class PSObjectStartCache : public StackObj {
+  ObjectStartArray* const _start_array;
+  HeapWord* _obj;
+  HeapWord* _obj_end;
+
+ public:
+  PSObjectStartCache(ObjectStartArray* start_array) :
+    _start_array(start_array), _obj(NULL), _obj_end(NULL) { }
+
+  ObjectStartArray* start_array() const { return _start_array; }
+
+  HeapWord* object_start(HeapWord* addr) {
+    if (_obj <= addr && addr < _obj_end) {
+      return _obj;
+    }
+    _obj = _start_array->object_start(addr);
+    _obj_end = _obj + oop(_obj)->size();
+    return _obj;
+  }
+};
 
 void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
                                              MutableSpace* sp,
                                              HeapWord* space_top,
                                              PSPromotionManager* pm,
-                                             uint stripe_number,
-                                             uint stripe_total) {
-  int ssize = 128; // Naked constant!  Work unit = 64k.
-  int dirty_card_count = 0;
-
+                                             PSCardTableStripes* stripes,
+                                             uint worker_id) {
   // It is a waste to get here if empty.
   assert(sp->bottom() < sp->top(), "Should not be called if empty");
-  oop* sp_top = (oop*)space_top;
   CardValue* start_card = byte_for(sp->bottom());
-  CardValue* end_card   = byte_for(sp_top - 1) + 1;
-  oop* last_scanned = NULL; // Prevent scanning objects more than once
-  // The width of the stripe ssize*stripe_total must be
-  // consistent with the number of stripes so that the complete slice
-  // is covered.
-  size_t slice_width = ssize * stripe_total;
-  for (CardValue* slice = start_card; slice < end_card; slice += slice_width) {
-    CardValue* worker_start_card = slice + stripe_number * ssize;
-    if (worker_start_card >= end_card)
-      return; // We're done.
-
-    CardValue* worker_end_card = worker_start_card + ssize;
-    if (worker_end_card > end_card)
-      worker_end_card = end_card;
-
-    // We do not want to scan objects more than once. In order to accomplish
-    // this, we assert that any object with an object head inside our 'slice'
-    // belongs to us. We may need to extend the range of scanned cards if the
-    // last object continues into the next 'slice'.
-    //
-    // Note! ending cards are exclusive!
-    HeapWord* slice_start = addr_for(worker_start_card);
-    HeapWord* slice_end = MIN2((HeapWord*) sp_top, addr_for(worker_end_card));
+  CardValue* end_card   = byte_for(space_top - 1) + 1;
+  const size_t ssize = stripes->stripe_size();
+  assert(start_card + stripes->num_stripes() * ssize >= end_card, "Stripes must cover the space");
 
+  PSObjectStartCache starts(start_array);
+  size_t stripe;
+  while (stripes->try_claim(stripe)) {
 #ifdef ASSERT
     if (GCWorkerDelayMillis > 0) {
       // Delay 1 worker so that it proceeds after all the work
       // has been completed.
-      if (stripe_number < 2) {
+      if (worker_id < 2) {
         os::naked_sleep(GCWorkerDelayMillis);
       }
     }
 #endif
 
-    // If there are not objects starting within the chunk, skip it.
-    if (!start_array->object_starts_in_range(slice_start, slice_end)) {
-      continue;
+    CardValue* stripe_start_card = start_card + stripe * ssize;
+    assert(stripe_start_card < end_card, "Claimed stripe beyond end card");
+    CardValue* stripe_end_card = MIN2(stripe_start_card + ssize, end_card);
+    scavenge_stripe(&starts, space_top, pm, stripe_start_card, stripe_end_card);
+  }
+}
+
+// Objects other than objArrays belong to the stripe that contains their
+// header and are scanned as a whole, so the range covered by a stripe is
+// extended to the end of its last such object. Stores into objArrays are
+// card marked precisely, so their elements are only scanned on dirty cards,
+// and the parts of an objArray that lie in different stripes are scanned
+// by whoever claims those stripes. A large array with old-to-young
+// pointers all over it is thereby spread over all the GC threads.
+void PSCardTable::scavenge_stripe(PSObjectStartCache* starts,
+                                  HeapWord* sp_top,
+                                  PSPromotionManager* pm,
+                                  CardValue* stripe_start_card,
+                                  CardValue* stripe_end_card) {
+  ObjectStartArray* start_array = starts->start_array();
+  HeapWord* stripe_start = addr_for(stripe_start_card);
+  HeapWord* stripe_end = MIN2(sp_top, addr_for(stripe_end_card));
+
+  // The part of the heap this stripe is responsible for.
+  HeapWord* own_start;
+  HeapWord* own_end;
+
+  if (!start_array->object_starts_in_range(stripe_start, stripe_end)) {
+    // The stripe lies within a single object. Unless it is an objArray
+    // with dirty cards in this stripe there is nothing to do here.
+    CardValue* card = stripe_start_card;
+    while (card < stripe_end_card && card_is_clean(*card)) {
+      card++;
+    }
+    if (card == stripe_end_card) {
+      return;
     }
-    // Update our beginning addr
-    HeapWord* first_object = start_array->object_start(slice_start);
-    debug_only(oop* first_object_within_slice = (oop*) first_object;)
-    if (first_object < slice_start) {
-      last_scanned = (oop*)(first_object + oop(first_object)->size());
-      debug_only(first_object_within_slice = last_scanned;)
-      worker_start_card = byte_for(last_scanned);
+    if (!oop(starts->object_start(stripe_start))->is_objArray()) {
+      return;
+    }
+    own_start = stripe_start;
+    own_end = stripe_end;
+  } else {
+    HeapWord* first_object = starts->object_start(stripe_start);
+    if (first_object == stripe_start || oop(first_object)->is_objArray()) {
+      own_start = stripe_start;
+    } else {
+      own_start = first_object + oop(first_object)->size();
     }
+    own_end = stripe_end;
+    if (stripe_end < sp_top) {
+      // The subtraction is important! An object may start precisely at stripe_end.
+      HeapWord* last_object = starts->object_start(stripe_end - 1);
+      if (!oop(last_object)->is_objArray()) {
+        own_end = last_object + oop(last_object)->size();
+      }
+    }
+  }
 
-    // Update the ending addr
-    if (slice_end < (HeapWord*)sp_top) {
-      // The subtraction is important! An object may start precisely at slice_end.
-      HeapWord* last_object = start_array->object_start(slice_end - 1);
-      slice_end = last_object + oop(last_object)->size();
-      // worker_end_card is exclusive, so bump it one past the end of last_object's
-      // covered span.
-      worker_end_card = byte_for(slice_end) + 1;
-
-      if (worker_end_card > end_card)
-        worker_end_card = end_card;
+  assert(own_start < own_end, "Stripe has nothing to scan");
+  assert(own_end <= sp_top, "Last object in stripe crosses space boundary");
+
+  // Note! ending cards are exclusive!
+  CardValue* const first_card = byte_for(own_start);
+  CardValue* const end_card = byte_for(own_end - 1) + 1;
+  assert(is_valid_card_address(first_card), "Invalid stripe start card");
+  assert(is_valid_card_address(end_card), "Invalid stripe end card");
+
+  // A card that is only partially covered may hold a part of an object
+  // scanned by another worker, or of a promotion lab above sp_top. Such a
+  // card is scanned but never cleaned, as that could lose a mark set by
+  // the other party.
+  CardValue* const clear_start_card = is_card_aligned(own_start) ? first_card : first_card + 1;
+  CardValue* const clear_end_card = is_card_aligned(own_end) ? end_card : end_card - 1;
+
+  // Everything below scanned_to has been scanned already.
+  HeapWord* scanned_to = own_start;
+
+  CardValue* current_card = first_card;
+  while (current_card < end_card) {
+    // Find an unclean card.
+    while (current_card < end_card && card_is_clean(*current_card)) {
+      current_card++;
     }
+    CardValue* first_unclean_card = current_card;
 
-    assert(slice_end <= (HeapWord*)sp_top, "Last object in slice crosses space boundary");
-    assert(is_valid_card_address(worker_start_card), "Invalid worker start card");
-    assert(is_valid_card_address(worker_end_card), "Invalid worker end card");
-    // Note that worker_start_card >= worker_end_card is legal, and happens when
-    // an object spans an entire slice.
-    assert(worker_start_card <= end_card, "worker start card beyond end card");
-    assert(worker_end_card <= end_card, "worker end card beyond end card");
-
-    CardValue* current_card = worker_start_card;
-    while (current_card < worker_end_card) {
-      // Find an unclean card.
-      while (current_card < worker_end_card && card_is_clean(*current_card)) {
+    // Find the end of a run of contiguous unclean cards
+    while (current_card < end_card && !card_is_clean(*current_card)) {
+      while (current_card < end_card && !card_is_clean(*current_card)) {
         current_card++;
       }
-      CardValue* first_unclean_card = current_card;
-
-      // Find the end of a run of contiguous unclean cards
-      while (current_card < worker_end_card && !card_is_clean(*current_card)) {
-        while (current_card < worker_end_card && !card_is_clean(*current_card)) {
-          current_card++;
-        }
 
-        if (current_card < worker_end_card) {
-          // Some objects may be large enough to span several cards. If such
-          // an object has more than one dirty card, separated by a clean card,
-          // we will attempt to scan it twice. The test against "last_scanned"
-          // prevents the redundant object scan, but it does not prevent newly
-          // marked cards from being cleaned.
-          HeapWord* last_object_in_dirty_region = start_array->object_start(addr_for(current_card)-1);
-          size_t size_of_last_object = oop(last_object_in_dirty_region)->size();
-          HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
+      if (current_card < end_card) {
+        // Some objects may be large enough to span several cards. If such
+        // an object has more than one dirty card, separated by a clean card,
+        // we will attempt to scan it twice. The test against "scanned_to"
+        // prevents the redundant object scan, but it does not prevent newly
+        // marked cards from being cleaned. objArrays are only scanned on
+        // their dirty cards, so they never extend the run.
+        HeapWord* last_object_in_dirty_region = starts->object_start(addr_for(current_card) - 1);
+        oop last_object = oop(last_object_in_dirty_region);
+        if (!last_object->is_objArray()) {
+          HeapWord* end_of_last_object = last_object_in_dirty_region + last_object->size();
           CardValue* ending_card_of_last_object = byte_for(end_of_last_object);
-          assert(ending_card_of_last_object <= worker_end_card, "ending_card_of_last_object is greater than worker_end_card");
+          assert(ending_card_of_last_object <= end_card, "ending_card_of_last_object is greater than end_card");
           if (ending_card_of_last_object > current_card) {
             // This means the object spans the next complete card.
             // We need to bump the current_card to ending_card_of_last_object
@@ -271,81 +342,68 @@ void PSCardTable::scavenge_contents_parallel(ObjectStartArray* start_array,
           }
         }
       }
-      CardValue* following_clean_card = current_card;
-
-      if (first_unclean_card < worker_end_card) {
-        oop* p = (oop*) start_array->object_start(addr_for(first_unclean_card));
-        assert((HeapWord*)p <= addr_for(first_unclean_card), "checking");
-        // "p" should always be >= "last_scanned" because newly GC dirtied
-        // cards are no longer scanned again (see comment at end
-        // of loop on the increment of "current_card").  Test that
-        // hypothesis before removing this code.
-        // If this code is removed, deal with the first time through
-        // the loop when the last_scanned is the object starting in
-        // the previous slice.
-        assert((p >= last_scanned) ||
-               (last_scanned == first_object_within_slice),
-               "Should no longer be possible");
-        if (p < last_scanned) {
-          // Avoid scanning more than once; this can happen because
-          // newgen cards set by GC may a different set than the
-          // originally dirty set
-          p = last_scanned;
-        }
-        oop* to = (oop*)addr_for(following_clean_card);
-
-        // Test slice_end first!
-        if ((HeapWord*)to > slice_end) {
-          to = (oop*)slice_end;
-        } else if (to > sp_top) {
-          to = sp_top;
-        }
-
-        // we know which cards to scan, now clear them
-        if (first_unclean_card <= worker_start_card+1)
-          first_unclean_card = worker_start_card+1;
-        if (following_clean_card >= worker_end_card-1)
-          following_clean_card = worker_end_card-1;
+    }
+    CardValue* following_clean_card = current_card;
+
+    if (first_unclean_card < end_card) {
+      HeapWord* from = addr_for(first_unclean_card);
+      HeapWord* to = MIN2(addr_for(following_clean_card), own_end);
+      assert(scanned_to <= MAX2(from, own_start), "Should no longer be possible");
+      from = MAX2(from, scanned_to);
+
+      // we know which cards to scan, now clear them
+      CardValue* clear_card = MAX2(first_unclean_card, clear_start_card);
+      CardValue* clear_end = MIN2(following_clean_card, clear_end_card);
+      while (clear_card < clear_end) {
+        *clear_card++ = clean_card;
+      }
 
-        while (first_unclean_card < following_clean_card) {
-          *first_unclean_card++ = clean_card;
-        }
+      // Find the next run, and have the start array entry and the heap
+      // words its object start lookup needs on the way while this run is
+      // being scanned.
+      CardValue* next_unclean_card = following_clean_card + 1;
+      while (next_unclean_card < end_card && card_is_clean(*next_unclean_card)) {
+        next_unclean_card++;
+      }
+      if (next_unclean_card < end_card) {
+        start_array->prefetch_object_start(addr_for(next_unclean_card));
+      }
 
-        const int interval = PrefetchScanIntervalInBytes;
-        // scan all objects in the range
+      // scan all objects in the range
+      const intx interval = PrefetchScanIntervalInBytes;
+      HeapWord* p = starts->object_start(from);
+      while (p < to) {
         if (interval != 0) {
-          while (p < to) {
-            Prefetch::write(p, interval);
-            oop m = oop(p);
-            assert(oopDesc::is_oop_or_null(m), "Expected an oop or NULL for header field at " PTR_FORMAT, p2i(m));
-            pm->push_contents(m);
-            p += m->size();
-          }
-          pm->drain_stacks_cond_depth();
+          Prefetch::write(p, interval);
+        }
+        oop m = oop(p);
+        assert(oopDesc::is_oop_or_null(m), "Expected an oop or NULL for header field at " PTR_FORMAT, p2i(m));
+        HeapWord* end_of_object = p + m->size();
+        if (m->is_objArray()) {
+          HeapWord* scan_end = MIN2(end_of_object, to);
+          pm->push_contents_bounded(m, MAX2(p, from), scan_end);
+          scanned_to = scan_end;
         } else {
-          while (p < to) {
-            oop m = oop(p);
-            assert(oopDesc::is_oop_or_null(m), "Expected an oop or NULL for header field at " PTR_FORMAT, p2i(m));
-            pm->push_contents(m);
-            p += m->size();
-          }
-          pm->drain_stacks_cond_depth();
+          assert(p >= scanned_to, "Object scanned twice");
+          pm->push_contents(m);
+          scanned_to = end_of_object;
         }
-        last_scanned = p;
+        p = end_of_object;
       }
-      // "current_card" is still the "following_clean_card" or
-      // the current_card is >= the worker_end_card so the
-      // loop will not execute again.
-      assert((current_card == following_clean_card) ||
-             (current_card >= worker_end_card),
-        "current_card should only be incremented if it still equals "
-        "following_clean_card");
-      // Increment current_card so that it is not processed again.
-      // It may now be dirty because a old-to-young pointer was
-      // found on it an updated.  If it is now dirty, it cannot be
-      // be safely cleaned in the next iteration.
-      current_card++;
+      pm->drain_stacks_cond_depth();
     }
+    // "current_card" is still the "following_clean_card" or
+    // the current_card is >= the end_card so the
+    // loop will not execute again.
+    assert((current_card == following_clean_card) ||
+           (current_card >= end_card),
+      "current_card should only be incremented if it still equals "
+      "following_clean_card");
+    // Increment current_card so that it is not processed again.
+    // It may now be dirty because a old-to-young pointer was
+    // found on it an updated.  If it is now dirty, it cannot be
+    // be safely cleaned in the next iteration.
+    current_card++;
   }
 }
 
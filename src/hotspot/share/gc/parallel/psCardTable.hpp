@@ -30,8 +30,31 @@
 
 class MutableSpace;
 class ObjectStartArray;
+class PSObjectStartCache;
 class PSPromotionManager;
 
+// The stripes of the old generation card table that are scanned for
+// old-to-young pointers during a scavenge. The workers claim the stripes
+// dynamically, so that clusters of dirty cards are spread over all of them.
+class PSCardTableStripes {
+  // Smallest stripe handed out, in cards. Work unit = 64k.
+  static const size_t MinStripeSize = 128;
+
+  size_t _stripe_size;
+  size_t _num_stripes;
+  volatile size_t _claimed;
+
+ public:
+  PSCardTableStripes(HeapWord* bottom, HeapWord* top, uint num_workers);
+
+  size_t stripe_size() const { return _stripe_size; }
+  size_t num_stripes() const { return _num_stripes; }
+
+  // Claims the next unscanned stripe. Returns false once all stripes
+  // have been handed out.
+  bool try_claim(size_t& stripe);
+};
+
 class PSCardTable: public CardTable {
  private:
   // Support methods for resizing the card table.
@@ -45,6 +68,12 @@ class PSCardTable: public CardTable {
 
   void verify_all_young_refs_precise_helper(MemRegion mr);
 
+  void scavenge_stripe(PSObjectStartCache* starts,
+                       HeapWord* sp_top,
+                       PSPromotionManager* pm,
+                       CardValue* stripe_start_card,
+                       CardValue* stripe_end_card);
+
   enum ExtendedCardValue {
     youngergen_card   = CT_MR_BS_last_reserved + 1,
     verify_card       = CT_MR_BS_last_reserved + 5
@@ -61,8 +90,8 @@ class PSCardTable: public CardTable {
                                   MutableSpace* sp,
                                   HeapWord* space_top,
                                   PSPromotionManager* pm,
-                                  uint stripe_number,
-                                  uint stripe_total);
+                                  PSCardTableStripes* stripes,
+                                  uint worker_id);
 
   bool addr_is_marked_imprecise(void *addr);
   bool addr_is_marked_precise(void *addr);
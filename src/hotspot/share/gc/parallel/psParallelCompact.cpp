@@ -557,15 +557,143 @@ void ParallelCompactData::add_obj(HeapWord* addr, size_t len)
   _region_data[end_region].set_partial_obj_addr(addr);
 }
 
+// Walking every region of a large heap in the summary phase is worth
+// spreading over the GC workers. The regions are split into chunks, which
+// the workers claim one at a time.
+class PCRegionChunks : public StackObj {
+  // Smaller chunks are not worth the claiming.
+  static const size_t MinRegionsPerChunk = 1024;
+  static const size_t ChunksPerWorker = 4;
+
+  const size_t _beg_region;
+  const size_t _end_region;
+  size_t _chunk_size;
+  size_t _num_chunks;
+  volatile size_t _claimed;
+
+ public:
+  PCRegionChunks(size_t beg_region, size_t end_region) :
+    _beg_region(beg_region),
+    _end_region(end_region),
+    _chunk_size(MinRegionsPerChunk),
+    _num_chunks(0),
+    _claimed(0) {
+    assert(beg_region <= end_region, "invalid range");
+    const size_t num_regions = end_region - beg_region;
+    const size_t num_workers = ParallelScavengeHeap::heap()->workers().active_workers();
+    _chunk_size = MAX2(num_regions / (num_workers * ChunksPerWorker), MinRegionsPerChunk);
+    _num_chunks = (num_regions + _chunk_size - 1) / _chunk_size;
+  }
+
+  // Should the regions in [beg_region, end_region) be processed in parallel?
+  static bool should_parallelize(size_t beg_region, size_t end_region) {
+    return end_region >= beg_region + 2 * MinRegionsPerChunk &&
+           ParallelScavengeHeap::heap()->workers().active_workers() > 1;
+  }
+
+  size_t num_chunks() const { return _num_chunks; }
+  size_t chunk_beg(size_t chunk) const { return _beg_region + chunk * _chunk_size; }
+  size_t chunk_end(size_t chunk) const { return MIN2(chunk_beg(chunk) + _chunk_size, _end_region); }
+
+  bool try_claim(size_t& chunk) {
+    if (Atomic::load(&_claimed) >= _num_chunks) {
+      return false;
+    }
+    size_t claimed = Atomic::add((size_t)1, &_claimed) - 1;
+    if (claimed >= _num_chunks) {
+      return false;
+    }
+    chunk = claimed;
+    return true;
+  }
+
+  void reset() { _claimed = 0; }
+};
+
+// Performs one of the steps of the summary phase on the chunks of a range
+// of regions.
+class PCSummaryTask : public AbstractGangTask {
+ public:
+  enum Step {
+    DensePrefix,    // Summarize the regions as dense prefix.
+    ChunkSizes,     // Sum up the live data of each chunk.
+    Destinations    // Summarize the regions to the precomputed chunk destinations.
+  };
+
+ private:
+  ParallelCompactData* const _sd;
+  PCRegionChunks* const _chunks;
+  const Step _step;
+  SplitInfo* const _split_info;
+  size_t* const _chunk_words;
+  HeapWord** const _chunk_dest;
+
+ public:
+  PCSummaryTask(ParallelCompactData* sd, PCRegionChunks* chunks, Step step,
+                SplitInfo* split_info = NULL,
+                size_t* chunk_words = NULL,
+                HeapWord** chunk_dest = NULL) :
+    AbstractGangTask("PCSummaryTask"),
+    _sd(sd),
+    _chunks(chunks),
+    _step(step),
+    _split_info(split_info),
+    _chunk_words(chunk_words),
+    _chunk_dest(chunk_dest) { }
+
+  virtual void work(uint worker_id) {
+    size_t chunk;
+    while (_chunks->try_claim(chunk)) {
+      const size_t beg_region = _chunks->chunk_beg(chunk);
+      const size_t end_region = _chunks->chunk_end(chunk);
+      switch (_step) {
+        case DensePrefix:
+          _sd->summarize_dense_prefix_regions(beg_region, end_region);
+          break;
+        case ChunkSizes: {
+          size_t words = 0;
+          for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+            words += _sd->region(cur_region)->data_size();
+          }
+          _chunk_words[chunk] = words;
+          break;
+        }
+        case Destinations: {
+          HeapWord* const dest_end = _sd->summarize_regions(*_split_info, beg_region, end_region,
+                                                            _chunk_dest[chunk]);
+          assert(chunk + 1 == _chunks->num_chunks() || dest_end == _chunk_dest[chunk + 1],
+                 "chunk destinations do not match");
+          break;
+        }
+        default:
+          ShouldNotReachHere();
+      }
+    }
+  }
+};
+
 void
 ParallelCompactData::summarize_dense_prefix(HeapWord* beg, HeapWord* end)
 {
   assert(region_offset(beg) == 0, "not RegionSize aligned");
   assert(region_offset(end) == 0, "not RegionSize aligned");
 
-  size_t cur_region = addr_to_region_idx(beg);
+  const size_t beg_region = addr_to_region_idx(beg);
   const size_t end_region = addr_to_region_idx(end);
-  HeapWord* addr = beg;
+  if (PCRegionChunks::should_parallelize(beg_region, end_region)) {
+    PCRegionChunks chunks(beg_region, end_region);
+    PCSummaryTask task(this, &chunks, PCSummaryTask::DensePrefix);
+    ParallelScavengeHeap::heap()->workers().run_task(&task);
+  } else {
+    summarize_dense_prefix_regions(beg_region, end_region);
+  }
+}
+
+void
+ParallelCompactData::summarize_dense_prefix_regions(size_t beg_region, size_t end_region)
+{
+  size_t cur_region = beg_region;
+  HeapWord* addr = region_to_addr(beg_region);
   while (cur_region < end_region) {
     _region_data[cur_region].set_destination(addr);
     _region_data[cur_region].set_destination_count(0);
@@ -687,6 +815,114 @@ ParallelCompactData::summarize_split_space(size_t src_region,
   return source_next;
 }
 
+void ParallelCompactData::summarize_region(SplitInfo& split_info, size_t cur_region,
+                                           HeapWord* dest_addr, size_t words)
+{
+  assert(words > 0, "only regions with data have a destination count");
+
+  // Compute the destination_count for cur_region, and if necessary, update
+  // source_region for a destination region.  The source_region field is
+  // updated if cur_region is the first (left-most) region to be copied to a
+  // destination region.
+  //
+  // The destination_count calculation is a bit subtle.  A region that has
+  // data that compacts into itself does not count itself as a destination.
+  // This maintains the invariant that a zero count means the region is
+  // available and can be claimed and then filled.
+  uint destination_count = 0;
+  if (split_info.is_split(cur_region)) {
+    // The current region has been split:  the partial object will be copied
+    // to one destination space and the remaining data will be copied to
+    // another destination space.  Adjust the initial destination_count and,
+    // if necessary, set the source_region field if the partial object will
+    // cross a destination region boundary.
+    destination_count = split_info.destination_count();
+    if (destination_count == 2) {
+      size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
+      _region_data[dest_idx].set_source_region(cur_region);
+    }
+  }
+
+  HeapWord* const last_addr = dest_addr + words - 1;
+  const size_t dest_region_1 = addr_to_region_idx(dest_addr);
+  const size_t dest_region_2 = addr_to_region_idx(last_addr);
+
+  // Initially assume that the destination regions will be the same and
+  // adjust the value below if necessary.  Under this assumption, if
+  // cur_region == dest_region_2, then cur_region will be compacted
+  // completely into itself.
+  destination_count += cur_region == dest_region_2 ? 0 : 1;
+  if (dest_region_1 != dest_region_2) {
+    // Destination regions differ; adjust destination_count.
+    destination_count += 1;
+    // Data from cur_region will be copied to the start of dest_region_2.
+    _region_data[dest_region_2].set_source_region(cur_region);
+  } else if (region_offset(dest_addr) == 0) {
+    // Data from cur_region will be copied to the start of the destination
+    // region.
+    _region_data[dest_region_1].set_source_region(cur_region);
+  }
+
+  _region_data[cur_region].set_destination_count(destination_count);
+  _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+}
+
+HeapWord* ParallelCompactData::summarize_regions(SplitInfo& split_info,
+                                                 size_t beg_region, size_t end_region,
+                                                 HeapWord* dest_addr)
+{
+  for (size_t cur_region = beg_region; cur_region < end_region; ++cur_region) {
+    // The destination must be set even if the region has no data.
+    _region_data[cur_region].set_destination(dest_addr);
+
+    size_t words = _region_data[cur_region].data_size();
+    if (words > 0) {
+      summarize_region(split_info, cur_region, dest_addr, words);
+      dest_addr += words;
+    }
+  }
+  return dest_addr;
+}
+
+// The destination of a region is the target address plus the live data of
+// all regions to its left, a prefix sum. The live data of each chunk of
+// regions is summed up in parallel first, then a short serial pass over the
+// chunks yields the destination of each chunk, from which the regions of a
+// chunk are summarized in parallel again.
+//
+// Different chunks may set the source_region of the same destination
+// region's RegionData, but only one source region can copy data to the
+// start of a destination region, so there is never more than one writer.
+void ParallelCompactData::summarize_parallel(SplitInfo& split_info,
+                                             size_t beg_region, size_t end_region,
+                                             HeapWord* dest_addr, HeapWord** target_next)
+{
+  WorkGang& workers = ParallelScavengeHeap::heap()->workers();
+  PCRegionChunks chunks(beg_region, end_region);
+  const size_t num_chunks = chunks.num_chunks();
+  size_t* const chunk_words = NEW_C_HEAP_ARRAY(size_t, num_chunks, mtGC);
+  HeapWord** const chunk_dest = NEW_C_HEAP_ARRAY(HeapWord*, num_chunks, mtGC);
+
+  PCSummaryTask sizes_task(this, &chunks, PCSummaryTask::ChunkSizes,
+                           &split_info, chunk_words, chunk_dest);
+  workers.run_task(&sizes_task);
+
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    chunk_dest[chunk] = dest_addr;
+    dest_addr += chunk_words[chunk];
+  }
+
+  chunks.reset();
+  PCSummaryTask dest_task(this, &chunks, PCSummaryTask::Destinations,
+                          &split_info, chunk_words, chunk_dest);
+  workers.run_task(&dest_task);
+
+  FREE_C_HEAP_ARRAY(size_t, chunk_words);
+  FREE_C_HEAP_ARRAY(HeapWord*, chunk_dest);
+
+  *target_next = dest_addr;
+}
+
 bool ParallelCompactData::summarize(SplitInfo& split_info,
                                     HeapWord* source_beg, HeapWord* source_end,
                                     HeapWord** source_next,
@@ -703,6 +939,14 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
   size_t cur_region = addr_to_region_idx(source_beg);
   const size_t end_region = addr_to_region_idx(region_align_up(source_end));
 
+  // Without source_next the caller knows that the source fits into the
+  // target, so there is no split point to look for.
+  if (source_next == NULL && PCRegionChunks::should_parallelize(cur_region, end_region)) {
+    summarize_parallel(split_info, cur_region, end_region, target_beg, target_next);
+    assert(*target_next <= target_end, "source does not fit into target");
+    return true;
+  }
+
   HeapWord *dest_addr = target_beg;
   while (cur_region < end_region) {
     // The destination must be set even if the region has no data.
@@ -720,51 +964,7 @@ bool ParallelCompactData::summarize(SplitInfo& split_info,
         return false;
       }
 
-      // Compute the destination_count for cur_region, and if necessary, update
-      // source_region for a destination region.  The source_region field is
-      // updated if cur_region is the first (left-most) region to be copied to a
-      // destination region.
-      //
-      // The destination_count calculation is a bit subtle.  A region that has
-      // data that compacts into itself does not count itself as a destination.
-      // This maintains the invariant that a zero count means the region is
-      // available and can be claimed and then filled.
-      uint destination_count = 0;
-      if (split_info.is_split(cur_region)) {
-        // The current region has been split:  the partial object will be copied
-        // to one destination space and the remaining data will be copied to
-        // another destination space.  Adjust the initial destination_count and,
-        // if necessary, set the source_region field if the partial object will
-        // cross a destination region boundary.
-        destination_count = split_info.destination_count();
-        if (destination_count == 2) {
-          size_t dest_idx = addr_to_region_idx(split_info.dest_region_addr());
-          _region_data[dest_idx].set_source_region(cur_region);
-        }
-      }
-
-      HeapWord* const last_addr = dest_addr + words - 1;
-      const size_t dest_region_1 = addr_to_region_idx(dest_addr);
-      const size_t dest_region_2 = addr_to_region_idx(last_addr);
-
-      // Initially assume that the destination regions will be the same and
-      // adjust the value below if necessary.  Under this assumption, if
-      // cur_region == dest_region_2, then cur_region will be compacted
-      // completely into itself.
-      destination_count += cur_region == dest_region_2 ? 0 : 1;
-      if (dest_region_1 != dest_region_2) {
-        // Destination regions differ; adjust destination_count.
-        destination_count += 1;
-        // Data from cur_region will be copied to the start of dest_region_2.
-        _region_data[dest_region_2].set_source_region(cur_region);
-      } else if (region_offset(dest_addr) == 0) {
-        // Data from cur_region will be copied to the start of the destination
-        // region.
-        _region_data[dest_region_1].set_source_region(cur_region);
-      }
-
-      _region_data[cur_region].set_destination_count(destination_count);
-      _region_data[cur_region].set_data_location(region_to_addr(cur_region));
+      summarize_region(split_info, cur_region, dest_addr, words);
       dest_addr += words;
     }
 
@@ -860,7 +1060,8 @@ public:
       true,                // mt discovery
       ParallelGCThreads,   // mt discovery degree
       true,                // atomic_discovery
-      is_alive_non_header) {
+      is_alive_non_header,
+      true) {              // adjust processing threads to the reference counts
   }
 
   template<typename T> bool discover(oop obj, ReferenceType type) {
@@ -1352,6 +1553,95 @@ PSParallelCompact::reclaimed_ratio(const RegionData* const cp,
   return double(reclaimable) / divisor;
 }
 
+// Finds the region with the best reclaimed ratio within each chunk of a range
+// of regions.
+class PCReclaimedRatioTask : public AbstractGangTask {
+  PCRegionChunks* const _chunks;
+  HeapWord* const _bottom;
+  HeapWord* const _top;
+  HeapWord* const _new_top;
+  size_t* const _chunk_best;
+  double* const _chunk_ratio;
+
+ public:
+  PCReclaimedRatioTask(PCRegionChunks* chunks,
+                       HeapWord* bottom, HeapWord* top, HeapWord* new_top,
+                       size_t* chunk_best, double* chunk_ratio) :
+    AbstractGangTask("PCReclaimedRatioTask"),
+    _chunks(chunks),
+    _bottom(bottom),
+    _top(top),
+    _new_top(new_top),
+    _chunk_best(chunk_best),
+    _chunk_ratio(chunk_ratio) { }
+
+  virtual void work(uint worker_id) {
+    ParallelCompactData& sd = PSParallelCompact::summary_data();
+    size_t chunk;
+    while (_chunks->try_claim(chunk)) {
+      const size_t end_region = _chunks->chunk_end(chunk);
+      size_t best_region = _chunks->chunk_beg(chunk);
+      double best_ratio = 0.0;
+      for (size_t cur_region = best_region; cur_region < end_region; ++cur_region) {
+        double tmp_ratio = PSParallelCompact::reclaimed_ratio(sd.region(cur_region),
+                                                              _bottom, _top, _new_top);
+        if (tmp_ratio > best_ratio) {
+          best_region = cur_region;
+          best_ratio = tmp_ratio;
+        }
+      }
+      _chunk_best[chunk] = best_region;
+      _chunk_ratio[chunk] = best_ratio;
+    }
+  }
+};
+
+const ParallelCompactData::RegionData*
+PSParallelCompact::best_reclaimed_ratio_region(const RegionData* beg,
+                                               const RegionData* end,
+                                               HeapWord* const bottom,
+                                               HeapWord* const top,
+                                               HeapWord* const new_top)
+{
+  ParallelCompactData& sd = summary_data();
+  const size_t beg_region = sd.region(beg);
+  const size_t end_region = end > beg ? sd.region(end) : beg_region;
+
+  double best_ratio = 0.0;
+  const RegionData* best_cp = beg;
+  if (!PCRegionChunks::should_parallelize(beg_region, end_region)) {
+    for (const RegionData* cp = beg; cp < end; ++cp) {
+      double tmp_ratio = reclaimed_ratio(cp, bottom, top, new_top);
+      if (tmp_ratio > best_ratio) {
+        best_cp = cp;
+        best_ratio = tmp_ratio;
+      }
+    }
+    return best_cp;
+  }
+
+  PCRegionChunks chunks(beg_region, end_region);
+  const size_t num_chunks = chunks.num_chunks();
+  size_t* const chunk_best = NEW_C_HEAP_ARRAY(size_t, num_chunks, mtGC);
+  double* const chunk_ratio = NEW_C_HEAP_ARRAY(double, num_chunks, mtGC);
+
+  PCReclaimedRatioTask task(&chunks, bottom, top, new_top, chunk_best, chunk_ratio);
+  ParallelScavengeHeap::heap()->workers().run_task(&task);
+
+  // Visit the chunks left to right, so ties go to the left-most region, as
+  // in the serial scan.
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    if (chunk_ratio[chunk] > best_ratio) {
+      best_cp = sd.region(chunk_best[chunk]);
+      best_ratio = chunk_ratio[chunk];
+    }
+  }
+
+  FREE_C_HEAP_ARRAY(size_t, chunk_best);
+  FREE_C_HEAP_ARRAY(double, chunk_ratio);
+  return best_cp;
+}
+
 // Return the address of the end of the dense prefix, a.k.a. the start of the
 // compacted region.  The address is always on a region boundary.
 //
@@ -1428,15 +1718,8 @@ PSParallelCompact::compute_dense_prefix(const SpaceId id,
 
   // Scan from the first region with dead space to the limit region and find the
   // one with the best (largest) reclaimed ratio.
-  double best_ratio = 0.0;
-  const RegionData* best_cp = full_cp;
-  for (const RegionData* cp = full_cp; cp < limit_cp; ++cp) {
-    double tmp_ratio = reclaimed_ratio(cp, bottom, top, new_top);
-    if (tmp_ratio > best_ratio) {
-      best_cp = cp;
-      best_ratio = tmp_ratio;
-    }
-  }
+  const RegionData* best_cp =
+    best_reclaimed_ratio_region(full_cp, limit_cp, bottom, top, new_top);
 
   return sd.region_to_addr(best_cp);
 }
@@ -2232,12 +2515,12 @@ public:
 
 class RefProcTaskExecutor: public AbstractRefProcTaskExecutor {
   void execute(ProcessTask& process_task, uint ergo_workers) {
-    assert(ParallelScavengeHeap::heap()->workers().active_workers() == ergo_workers,
-           "Ergonomically chosen workers (%u) must be equal to active workers (%u)",
+    assert(ParallelScavengeHeap::heap()->workers().active_workers() >= ergo_workers,
+           "Ergonomically chosen workers (%u) should be less than or equal to active workers (%u)",
            ergo_workers, ParallelScavengeHeap::heap()->workers().active_workers());
 
     PCRefProcTask task(process_task, ergo_workers);
-    ParallelScavengeHeap::heap()->workers().run_task(&task);
+    ParallelScavengeHeap::heap()->workers().run_task(&task, ergo_workers);
   }
 };
 
@@ -461,10 +461,29 @@ public:
 #endif  // #ifdef ASSERT
 
 private:
+  friend class PCSummaryTask;
+
   bool initialize_block_data();
   bool initialize_region_data(size_t region_size);
   PSVirtualSpace* create_vspace(size_t count, size_t element_size);
 
+  // Region index based versions of summarize_dense_prefix() and summarize()
+  // for the regions [beg_region, end_region), which the summary phase hands
+  // out to the GC workers in chunks when there are many regions. The data in
+  // the regions is known to fit at dest_addr, which is returned advanced past
+  // the summarized data.
+  void summarize_dense_prefix_regions(size_t beg_region, size_t end_region);
+  HeapWord* summarize_regions(SplitInfo& split_info,
+                              size_t beg_region, size_t end_region,
+                              HeapWord* dest_addr);
+  // Set the destination count and source region fields for a region whose
+  // words of live data are copied to dest_addr.
+  void summarize_region(SplitInfo& split_info, size_t cur_region,
+                        HeapWord* dest_addr, size_t words);
+  void summarize_parallel(SplitInfo& split_info,
+                          size_t beg_region, size_t end_region,
+                          HeapWord* dest_addr, HeapWord** target_next);
+
 private:
   HeapWord*       _region_start;
 #ifdef  ASSERT
@@ -953,6 +972,7 @@ class PSParallelCompact : AllStatic {
   };
 
   friend class RefProcTaskProxy;
+  friend class PCReclaimedRatioTask;
   friend class PSParallelCompactTest;
 
  private:
@@ -1041,6 +1061,14 @@ class PSParallelCompact : AllStatic {
                                        HeapWord* const top,
                                        HeapWord* const new_top);
 
+  // Return the region in [beg, end) with the best (largest) reclaimed ratio,
+  // or beg if none has a positive one.  Large ranges are scanned in parallel.
+  static const RegionData* best_reclaimed_ratio_region(const RegionData* beg,
+                                                       const RegionData* end,
+                                                       HeapWord* const bottom,
+                                                       HeapWord* const top,
+                                                       HeapWord* const new_top);
+
   // Compute the dense prefix for the designated space.
   static HeapWord* compute_dense_prefix(const SpaceId id,
                                         bool maximum_compaction);
@@ -213,6 +213,7 @@ class PSPromotionManager {
   TASKQUEUE_STATS_ONLY(inline void record_steal(StarTask& p);)
 
   void push_contents(oop obj);
+  void push_contents_bounded(oop obj, HeapWord* left, HeapWord* right);
 };
 
 #endif // SHARE_GC_PARALLEL_PSPROMOTIONMANAGER_HPP
@@ -29,6 +29,7 @@
 #include "code/codeCache.hpp"
 #include "gc/parallel/parallelScavengeHeap.hpp"
 #include "gc/parallel/psAdaptiveSizePolicy.hpp"
+#include "gc/parallel/psCardTable.hpp"
 #include "gc/parallel/psClosure.inline.hpp"
 #include "gc/parallel/psCompactionManager.hpp"
 #include "gc/parallel/psMarkSweepProxy.hpp"
@@ -246,8 +247,11 @@ public:
 };
 
 void PSRefProcTaskExecutor::execute(ProcessTask& process_task, uint ergo_workers) {
+  assert(ParallelScavengeHeap::heap()->workers().active_workers() >= ergo_workers,
+         "Ergonomically chosen workers (%u) should be less than or equal to active workers (%u)",
+         ergo_workers, ParallelScavengeHeap::heap()->workers().active_workers());
   PSRefProcTask task(process_task, ergo_workers);
-  ParallelScavengeHeap::heap()->workers().run_task(&task);
+  ParallelScavengeHeap::heap()->workers().run_task(&task, ergo_workers);
 }
 
 // This method contains all heap specific policy for invoking scavenge.
@@ -318,6 +322,7 @@ class ScavengeRootsTask : public AbstractGangTask {
   HeapWord* _gen_top;
   uint _active_workers;
   bool _is_empty;
+  PSCardTableStripes _stripes;
   TaskTerminator _terminator;
 
 public:
@@ -332,6 +337,7 @@ public:
       _gen_top(gen_top),
       _active_workers(active_workers),
       _is_empty(is_empty),
+      _stripes(old_gen->object_space()->bottom(), gen_top, active_workers),
       _terminator(active_workers, PSPromotionManager::vm_thread_promotion_manager()->stack_array_depth()) {
     _subtasks.set_n_threads(active_workers);
     _subtasks.set_n_tasks(ParallelRootType::sentinel);
@@ -358,8 +364,8 @@ public:
                                                _old_gen->object_space(),
                                                _gen_top,
                                                pm,
-                                               worker_id,
-                                               _active_workers);
+                                               &_stripes,
+                                               worker_id);
 
         // Do the real work
         pm->drain_stacks(false);
@@ -851,7 +857,7 @@ void PSScavenge::initialize() {
                            ParallelGCThreads,          // mt discovery degree
                            true,                       // atomic_discovery
                            NULL,                       // header provides liveness info
-                           false);
+                           true);                      // adjust processing threads to the reference counts
 
   // Cache the cardtable
   _card_table = heap->card_table();
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
 #include "gc/serial/defNewGeneration.inline.hpp"
 #include "gc/serial/serialHeap.inline.hpp"
 #include "gc/serial/tenuredGeneration.hpp"
@@ -662,16 +663,26 @@ void DefNewGeneration::collect(bool   full,
     assert(_promo_failure_scan_stack.is_empty(), "post condition");
     _promo_failure_scan_stack.clear(true); // Clear cached segments.
 
-    remove_forwarding_pointers();
     log_info(gc, promotion)("Promotion failed");
-    // Add to-space to the list of space to compact
-    // when a promotion failure has occurred.  In that
-    // case there can be live objects in to-space
-    // as a result of a partial evacuation of eden
-    // and from-space.
-    swap_spaces();   // For uniformity wrt ParNewGeneration.
-    from()->set_next_compaction_space(to());
-    heap->set_incremental_collection_failed();
+    if (SerialCompactAfterPromotionFailure && compact_after_promotion_failure()) {
+      // Everything left behind in eden and from-space now sits at the
+      // bottom of eden, so the survivor spaces can be swapped as after
+      // a successful scavenge and the next scavenge may go ahead.
+      swap_spaces();
+      assert(to()->is_empty(), "to space should be empty now");
+    } else {
+      if (!SerialCompactAfterPromotionFailure) {
+        remove_forwarding_pointers();
+      }
+      // Add to-space to the list of space to compact
+      // when a promotion failure has occurred.  In that
+      // case there can be live objects in to-space
+      // as a result of a partial evacuation of eden
+      // and from-space.
+      swap_spaces();   // For uniformity wrt ParNewGeneration.
+      from()->set_next_compaction_space(to());
+      heap->set_incremental_collection_failed();
+    }
 
     // Inform the next generation that a promotion failure occurred.
     _old_gen->promotion_failure_occurred();
@@ -717,6 +728,153 @@ void DefNewGeneration::restore_preserved_marks() {
   _preserved_marks_set.restore(&task_executor);
 }
 
+// Adjusts references into eden and from-space to the new locations
+// computed by compact_after_promotion_failure(). Every such reference
+// points to an object that failed promotion: all others were updated
+// to the copies by the scavenge.
+class AdjustYoungPointerClosure : public BasicOopsInGenClosure {
+  ContiguousSpace* _eden;
+  ContiguousSpace* _from;
+
+  template <class T> void do_oop_work(T* p) {
+    T heap_oop = RawAccess<>::oop_load(p);
+    if (CompressedOops::is_null(heap_oop)) {
+      return;
+    }
+    oop obj = CompressedOops::decode_not_null(heap_oop);
+    if (_eden->is_in_reserved(obj) || _from->is_in_reserved(obj)) {
+      assert(obj->is_forwarded(), "only objects that failed promotion are left in " PTR_FORMAT, p2i(obj));
+      oop new_obj = obj->forwardee();
+      if (new_obj != obj) {
+        RawAccess<IS_NOT_NULL>::oop_store(p, new_obj);
+      }
+    }
+  }
+
+public:
+  AdjustYoungPointerClosure(ContiguousSpace* eden, ContiguousSpace* from) :
+    _eden(eden), _from(from) { }
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+  virtual ReferenceIterationMode reference_iteration_mode() { return DO_FIELDS; }
+};
+
+bool DefNewGeneration::is_compacted_after_promotion_failure(oop obj) const {
+  if (!obj->is_forwarded()) {
+    return false;
+  }
+  // The stale copies of evacuated objects are forwarded to to-space or
+  // the old generation; survivors are forwarded within eden or from.
+  oop fwd = obj->forwardee();
+  return eden()->is_in_reserved(fwd) || from()->is_in_reserved(fwd);
+}
+
+bool DefNewGeneration::compact_after_promotion_failure() {
+  GCTraceTime(Debug, gc, phases) tm("Compact After Promotion Failure", _gc_timer);
+
+  // Phase 1: compute new locations. Objects that failed promotion are
+  // self-forwarded; slide eden's down within eden, then place from-space's
+  // after them. Eden objects must stay in eden, so that a from-space
+  // object that is yet to be moved is never overwritten. Once eden is
+  // full the rest of from-space slides down within from-space.
+  ContiguousSpace* dest = eden();
+  HeapWord* dest_top = eden()->bottom();
+  HeapWord* eden_top = NULL;
+  ContiguousSpace* spaces[] = { eden(), from() };
+  for (uint i = 0; i < ARRAY_SIZE(spaces); i++) {
+    ContiguousSpace* sp = spaces[i];
+    HeapWord* cur = sp->bottom();
+    HeapWord* const limit = sp->top();
+    while (cur < limit) {
+      oop obj = oop(cur);
+      size_t size = obj->size();
+      if (obj->is_forwarded() && obj->forwardee() == obj) {
+        if (dest == eden() && pointer_delta(eden()->end(), dest_top) < size) {
+          assert(sp == from(), "eden objects always fit into eden");
+          eden_top = dest_top;
+          dest = from();
+          dest_top = from()->bottom();
+        }
+        obj->forward_to(oop(dest_top));
+        dest_top += size;
+      }
+      cur += size;
+    }
+  }
+  HeapWord* const from_top = (dest == from()) ? dest_top : from()->bottom();
+  if (dest == eden()) {
+    eden_top = dest_top;
+  }
+
+  // Phase 2: adjust references into eden and from-space. They can only
+  // come from the roots, the old generation, to-space and the survivors
+  // themselves; the old generation is walked but neither marked nor moved.
+  AdjustYoungPointerClosure adjust(eden(), from());
+  SerialHeap* heap = SerialHeap::heap();
+  ClassLoaderDataGraph::clear_claimed_marks();
+  CLDToOopClosure adjust_cld(&adjust, ClassLoaderData::_claim_strong);
+  {
+    StrongRootsScope srs(1);
+    heap->full_process_roots(&srs,
+                             true,  // Adjust phase; fix nmethod relocations.
+                             GenCollectedHeap::SO_AllCodeCache,
+                             false, // All roots.
+                             &adjust,
+                             &adjust_cld);
+  }
+  heap->gen_process_weak_roots(&adjust);
+  _preserved_marks_set.get()->adjust_during_full_gc();
+  _old_gen->oop_iterate(&adjust);
+  to()->oop_iterate(&adjust);
+  for (uint i = 0; i < ARRAY_SIZE(spaces); i++) {
+    ContiguousSpace* sp = spaces[i];
+    HeapWord* cur = sp->bottom();
+    HeapWord* const limit = sp->top();
+    while (cur < limit) {
+      oop obj = oop(cur);
+      size_t size = obj->size();
+      if (is_compacted_after_promotion_failure(obj)) {
+        obj->oop_iterate(&adjust);
+      }
+      cur += size;
+    }
+  }
+
+  // Phase 3: move the objects, in address order so that no object is
+  // overwritten before it has been moved, and reset their headers. The
+  // preserved marks now refer to the new locations.
+  for (uint i = 0; i < ARRAY_SIZE(spaces); i++) {
+    ContiguousSpace* sp = spaces[i];
+    HeapWord* cur = sp->bottom();
+    HeapWord* const limit = sp->top();
+    while (cur < limit) {
+      oop obj = oop(cur);
+      size_t size = obj->size();
+      if (is_compacted_after_promotion_failure(obj)) {
+        HeapWord* new_addr = (HeapWord*)obj->forwardee();
+        if (new_addr != cur) {
+          Copy::aligned_conjoint_words(cur, new_addr, size);
+        }
+        PreservedMarks::init_forwarded_mark(oop(new_addr));
+      }
+      cur += size;
+    }
+  }
+  restore_preserved_marks();
+
+  eden()->set_top(eden_top);
+  from()->set_top(from_top);
+  if (ZapUnusedHeapArea) {
+    eden()->mangle_unused_area_complete();
+    from()->mangle_unused_area_complete();
+  }
+
+  log_debug(gc, promotion)("Compacted after promotion failure: eden " SIZE_FORMAT "K, from " SIZE_FORMAT "K",
+                           eden()->used() / K, from()->used() / K);
+  return from()->is_empty();
+}
+
 void DefNewGeneration::handle_promotion_failure(oop old) {
   log_debug(gc, promotion)("Promotion failure size = %d) ", old->size());
 
@@ -90,6 +90,15 @@ protected:
   // therefore we must remove their forwarding pointers.
   void remove_forwarding_pointers();
 
+  // Alternatively, with SerialCompactAfterPromotionFailure, slide the
+  // objects that failed promotion down to the bottom of eden, adjusting
+  // only the references into eden and from-space, so that the young
+  // generation need not be left to the full collection. Returns true if
+  // from-space was emptied. Otherwise the remainder lies at the bottom
+  // of from-space and the full collection is still required.
+  bool compact_after_promotion_failure();
+  bool is_compacted_after_promotion_failure(oop obj) const;
+
   virtual void restore_preserved_marks();
 
   // Preserved marks
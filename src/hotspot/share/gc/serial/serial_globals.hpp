@@ -38,6 +38,11 @@
                         lp64_product,                                       \
                         range,                                              \
                         constraint,                                         \
-                        writeable)
+                        writeable)                                          \
+                                                                            \
+  product(bool, SerialCompactAfterPromotionFailure, false,                  \
+          "After a promotion failure in a young collection, compact the "   \
+          "objects left in eden and from-space in place rather than "       \
+          "leaving them to a full collection")
 
 #endif // SHARE_GC_SERIAL_SERIAL_GLOBALS_HPP
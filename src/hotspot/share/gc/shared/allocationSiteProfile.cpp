@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "gc/shared/oopStorageSet.hpp"
+#include "interpreter/bytecodes.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/method.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/vframe.hpp"
+
+// A site is not judged before this many of its samples are known, and
+// its counts are halved when they reach the maximum, so that the profile
+// follows changes in the behavior of the application.
+static const uint min_site_samples = 8;
+static const uint max_site_samples = 64;
+
+volatile bool AllocationSiteProfile::_enabled = false;
+Mutex* AllocationSiteProfile::_lock = NULL;
+AllocationSiteProfile::Site* AllocationSiteProfile::_sites = NULL;
+size_t AllocationSiteProfile::_num_sites = 0;
+AllocationSiteProfile::Tracked* AllocationSiteProfile::_tracked = NULL;
+size_t AllocationSiteProfile::_num_tracked = 0;
+
+void AllocationSiteProfile::initialize() {
+  if (!PretenureAllocationSites) {
+    return;
+  }
+  if (!Universe::heap()->supports_pretenured_allocation()) {
+    log_warning(gc)("PretenureAllocationSites is not supported by %s", Universe::heap()->name());
+    return;
+  }
+  // Same rank as the allocation trace lock, for the same reasons.
+  _lock = new Mutex(Mutex::oopstorage + 1, "AllocationSiteProfile_lock", true,
+                    Mutex::_safepoint_check_never);
+  _sites = NEW_C_HEAP_ARRAY(Site, PretenureSiteTableSize, mtGC);
+  for (size_t i = 0; i < PretenureSiteTableSize; i++) {
+    _sites[i]._method = NULL;
+  }
+  _num_sites = 0;
+  _tracked = NEW_C_HEAP_ARRAY(Tracked, PretenureSiteTableSize, mtGC);
+  _num_tracked = 0;
+  OrderAccess::release_store(&_enabled, true);
+}
+
+AllocationSiteProfile::Site* AllocationSiteProfile::find_site(const Method* method, int bci, bool create) {
+  assert_lock_strong(_lock);
+  const size_t size = PretenureSiteTableSize;
+  const size_t start = first_index(method);
+  Site* free_site = NULL;
+  for (size_t i = 0; i < size; i++) {
+    Site* site = &_sites[(start + i) % size];
+    if (site->_method == NULL) {
+      if (free_site == NULL) {
+        free_site = site;
+      }
+      break;
+    } else if (site->_method == removed_method()) {
+      if (free_site == NULL) {
+        free_site = site;
+      }
+    } else if (site->_method == method && site->_bci == bci) {
+      return site;
+    }
+  }
+  if (!create || free_site == NULL) {
+    return NULL;
+  }
+  if (free_site->_method == NULL) {
+    // Keep the probe sequences short.
+    if (_num_sites >= size / 4 * 3) {
+      return NULL;
+    }
+    _num_sites++;
+  }
+  free_site->_method = const_cast<Method*>(method);
+  free_site->_bci = bci;
+  free_site->_samples = 0;
+  free_site->_long_lived = 0;
+  free_site->_pretenure = false;
+  return free_site;
+}
+
+void AllocationSiteProfile::update_site(Site* site, bool long_lived) {
+  site->_samples++;
+  if (long_lived) {
+    site->_long_lived++;
+  }
+  if (site->_samples >= min_site_samples) {
+    bool pretenure = site->_long_lived * 100 >= site->_samples * PretenureSurvivalThreshold;
+    if (pretenure != site->_pretenure) {
+      site->_pretenure = pretenure;
+      if (log_is_enabled(Debug, gc, alloc)) {
+        ResourceMark rm;
+        log_debug(gc, alloc)("%s allocations at %s@%d (%u of %u sampled objects long-lived)",
+                             pretenure ? "Pretenuring" : "No longer pretenuring",
+                             site->_method->name_and_sig_as_C_string(), site->_bci,
+                             site->_long_lived, site->_samples);
+      }
+    }
+  }
+  if (site->_samples >= max_site_samples) {
+    site->_samples /= 2;
+    site->_long_lived /= 2;
+  }
+}
+
+void AllocationSiteProfile::record_allocation(Thread* thread, oop obj) {
+  assert(is_enabled(), "must be profiling");
+  if (!thread->is_Java_thread()) {
+    return;
+  }
+  JavaThread* jt = (JavaThread*)thread;
+  if (!jt->has_last_Java_frame()) {
+    return;
+  }
+
+  Method* method;
+  int bci;
+  {
+    ResourceMark rm(jt);
+    vframeStream vfst(jt);
+    if (vfst.at_end()) {
+      return;
+    }
+    method = vfst.method();
+    bci = vfst.bci();
+  }
+  if (method->is_native()) {
+    return;
+  }
+  Bytecodes::Code code = method->java_code_at(bci);
+  if (code != Bytecodes::_new && code != Bytecodes::_newarray && code != Bytecodes::_anewarray) {
+    // Allocated by the runtime on behalf of some other bytecode.
+    return;
+  }
+
+  OopStorage* storage = OopStorageSet::vm_weak();
+  // Allocated before taking the lock; given back if not needed.
+  oop* ref = storage->allocate();
+  if (ref == NULL) {
+    return;
+  }
+
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  Site* site = NULL;
+  if (_num_tracked < PretenureSiteTableSize) {
+    site = find_site(method, bci, true /* create */);
+  }
+  if (site == NULL) {
+    storage->release(ref);
+    return;
+  }
+  NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(ref, obj);
+  _tracked[_num_tracked]._ref = ref;
+  _tracked[_num_tracked]._site = site;
+  _tracked[_num_tracked]._survived_gcs = 0;
+  _num_tracked++;
+}
+
+void AllocationSiteProfile::report_gc_end() {
+  if (!is_enabled()) {
+    return;
+  }
+  OopStorage* storage = OopStorageSet::vm_weak();
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  size_t i = 0;
+  while (i < _num_tracked) {
+    Tracked* t = &_tracked[i];
+    oop obj = NativeAccess<ON_PHANTOM_OOP_REF | AS_NO_KEEPALIVE>::oop_load(t->_ref);
+    const bool removed = t->_site->_method == removed_method();
+    if (!removed && obj != NULL && ++t->_survived_gcs < PretenureSurvivedGCs) {
+      // Fate not known yet.
+      i++;
+      continue;
+    }
+    if (!removed) {
+      update_site(t->_site, obj != NULL /* long_lived */);
+    }
+    NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(t->_ref, (oop)NULL);
+    storage->release(t->_ref);
+    _tracked[i] = _tracked[--_num_tracked];
+  }
+}
+
+void AllocationSiteProfile::method_unloaded(const Method* method) {
+  if (!is_enabled()) {
+    return;
+  }
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  // All the sites of a method are in the probe sequence of the method.
+  // The samples of a removed site are dropped at the end of the next GC,
+  // unless the entry has been reused by then, in which case they count
+  // for the new site.
+  const size_t size = PretenureSiteTableSize;
+  const size_t start = first_index(method);
+  for (size_t i = 0; i < size; i++) {
+    Site* site = &_sites[(start + i) % size];
+    if (site->_method == NULL) {
+      break;
+    } else if (site->_method == method) {
+      site->_method = removed_method();
+    }
+  }
+}
+
+bool AllocationSiteProfile::should_pretenure(const Method* method, int bci) {
+  if (!is_enabled()) {
+    return false;
+  }
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  Site* site = find_site(method, bci, false /* create */);
+  return site != NULL && site->_pretenure;
+}
+
+PretenureAllocationMark::PretenureAllocationMark(Thread* thread) :
+    _thread(thread),
+    _saved(thread->pretenure_allocations()) {
+  thread->set_pretenure_allocations(true);
+}
+
+PretenureAllocationMark::~PretenureAllocationMark() {
+  _thread->set_pretenure_allocations(_saved);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_GC_SHARED_ALLOCATIONSITEPROFILE_HPP
+#define SHARE_GC_SHARED_ALLOCATIONSITEPROFILE_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "runtime/globals.hpp"
+
+class Method;
+class Mutex;
+class Thread;
+
+// Survival profile of allocation sites, for pretenuring.
+//
+// With -XX:+PretenureAllocationSites, the allocations that JFR samples
+// (those outside a TLAB, and those that refill a TLAB) are attributed to
+// the new, newarray or anewarray bytecode that made them.  The sampled
+// objects are held weakly, and at the end of every GC each is either
+// found dead or, once it has survived PretenureSurvivedGCs collections,
+// counted as long-lived.  A site is pretenured when at least
+// PretenureSurvivalThreshold percent of its sampled objects are
+// long-lived.
+//
+// C2 allocates the objects of pretenured sites through the pretenuring
+// runtime stubs, which allocate in the old generation of collectors that
+// support it.  The decision is taken when the method is compiled.
+class AllocationSiteProfile : AllStatic {
+  struct Site {
+    Method* _method;
+    int _bci;
+    uint _samples;          // Sampled objects whose fate is known
+    uint _long_lived;       // Of those, the ones that were long-lived
+    bool _pretenure;
+  };
+
+  struct Tracked {
+    oop* _ref;
+    Site* _site;
+    uint _survived_gcs;
+  };
+
+  static volatile bool _enabled;
+  static Mutex* _lock;
+  static Site* _sites;
+  static size_t _num_sites;
+  static Tracked* _tracked;
+  static size_t _num_tracked;
+
+  // Marks the entry of a site whose method has been deallocated.
+  static Method* removed_method() { return (Method*)1; }
+
+  // The sites of a method are found by linear probing from this index,
+  // so that they can be removed together.
+  static size_t first_index(const Method* method) {
+    return ((uintptr_t)method >> LogBytesPerWord) % PretenureSiteTableSize;
+  }
+
+  static Site* find_site(const Method* method, int bci, bool create);
+  static void update_site(Site* site, bool long_lived);
+
+public:
+  static void initialize();
+
+  static bool is_enabled() { return _enabled; }
+
+  // Attributes obj, just allocated by thread, to the allocation site of
+  // the topmost Java frame of thread, if that is an allocation bytecode.
+  static void record_allocation(Thread* thread, oop obj);
+
+  // Updates the profile with the fate of the sampled objects. Called at
+  // the end of every GC.
+  static void report_gc_end();
+
+  // Forgets the sites of a method that is being deallocated.
+  static void method_unloaded(const Method* method);
+
+  // Whether the objects allocated at bci in method should be pretenured.
+  static bool should_pretenure(const Method* method, int bci);
+};
+
+// Makes the allocations of the current thread pretenured while in scope.
+class PretenureAllocationMark : public StackObj {
+  Thread* const _thread;
+  const bool _saved;
+
+public:
+  PretenureAllocationMark(Thread* thread);
+  ~PretenureAllocationMark();
+};
+
+#endif // SHARE_GC_SHARED_ALLOCATIONSITEPROFILE_HPP
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "gc/shared/allocationTrace.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "gc/shared/oopStorageSet.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/access.inline.hpp"
+#include "oops/arrayOop.hpp"
+#include "oops/objArrayOop.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/jniHandles.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+
+volatile bool AllocationTraceRecorder::_enabled = false;
+Mutex* AllocationTraceRecorder::_lock = NULL;
+fileStream* AllocationTraceRecorder::_out = NULL;
+jlong AllocationTraceRecorder::_start_nanos = 0;
+uint64_t AllocationTraceRecorder::_next_id = 0;
+AllocationTraceRecorder::Tracked* AllocationTraceRecorder::_tracked = NULL;
+size_t AllocationTraceRecorder::_num_tracked = 0;
+
+jlong AllocationTraceRecorder::nanos_since_start() {
+  return os::javaTimeNanos() - _start_nanos;
+}
+
+void AllocationTraceRecorder::initialize() {
+  if (AllocationTraceFile == NULL || AllocationTraceFile[0] == '\0') {
+    return;
+  }
+  fileStream* out = new (ResourceObj::C_HEAP, mtGC) fileStream(AllocationTraceFile, "w");
+  if (!out->is_open()) {
+    log_warning(gc)("Could not open allocation trace file %s", AllocationTraceFile);
+    delete out;
+    return;
+  }
+  // Below leaf, since allocations can happen with leaf locks held, but
+  // above oopstorage, since OopStorage is called with it held.
+  _lock = new Mutex(Mutex::oopstorage + 1, "AllocationTrace_lock", true,
+                    Mutex::_safepoint_check_never);
+  _tracked = NEW_C_HEAP_ARRAY(Tracked, AllocationTraceMaxTracked, mtGC);
+  _num_tracked = 0;
+  _out = out;
+  _start_nanos = os::javaTimeNanos();
+  OrderAccess::release_store(&_enabled, true);
+  log_info(gc)("Recording allocation trace to %s", AllocationTraceFile);
+}
+
+void AllocationTraceRecorder::shutdown() {
+  if (!is_enabled()) {
+    return;
+  }
+  OopStorage* storage = OopStorageSet::vm_weak();
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  if (!_enabled) {
+    return;
+  }
+  _enabled = false;
+  for (size_t i = 0; i < _num_tracked; i++) {
+    NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(_tracked[i]._ref, (oop)NULL);
+    storage->release(_tracked[i]._ref);
+  }
+  _num_tracked = 0;
+  _out->print_cr("E " JLONG_FORMAT, nanos_since_start());
+  _out->flush();
+  delete _out;
+  _out = NULL;
+}
+
+void AllocationTraceRecorder::record_allocation(Thread* thread, oop obj, size_t weight) {
+  assert(is_enabled(), "must be recording");
+  OopStorage* storage = OopStorageSet::vm_weak();
+  const size_t size = obj->size() * HeapWordSize;
+  const char kind = obj->is_objArray() ? 'o' : (obj->is_typeArray() ? 'a' : 'i');
+
+  ResourceMark rm(thread);
+  const char* name = obj->klass()->external_name();
+
+  // Allocated before taking the lock; given back if not needed.
+  oop* ref = storage->allocate();
+
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  if (!_enabled) {
+    if (ref != NULL) {
+      storage->release(ref);
+    }
+    return;
+  }
+  uint64_t id = _next_id++;
+  bool tracked = false;
+  if (ref != NULL && _num_tracked < AllocationTraceMaxTracked) {
+    NativeAccess<ON_PHANTOM_OOP_REF>::oop_store(ref, obj);
+    _tracked[_num_tracked]._ref = ref;
+    _tracked[_num_tracked]._id = id;
+    _num_tracked++;
+    tracked = true;
+  } else if (ref != NULL) {
+    storage->release(ref);
+  }
+  _out->print_cr("A " UINT64_FORMAT " " JLONG_FORMAT " " INTX_FORMAT " " SIZE_FORMAT " " SIZE_FORMAT " %c%s %s",
+                 id, nanos_since_start(), os::current_thread_id(), weight, size,
+                 kind, tracked ? "*" : "", name);
+}
+
+void AllocationTraceRecorder::report_gc_end() {
+  if (!is_enabled()) {
+    return;
+  }
+  OopStorage* storage = OopStorageSet::vm_weak();
+  MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+  if (!_enabled) {
+    return;
+  }
+  jlong now = nanos_since_start();
+  size_t i = 0;
+  while (i < _num_tracked) {
+    oop* ref = _tracked[i]._ref;
+    oop obj = NativeAccess<ON_PHANTOM_OOP_REF | AS_NO_KEEPALIVE>::oop_load(ref);
+    if (obj == NULL) {
+      _out->print_cr("D " UINT64_FORMAT " " JLONG_FORMAT, _tracked[i]._id, now);
+      storage->release(ref);
+      _tracked[i] = _tracked[--_num_tracked];
+    } else {
+      i++;
+    }
+  }
+  _out->flush();
+}
+
+// Replay
+
+struct AllocationTraceSample {
+  jlong _time;
+  jlong _death;       // -1 if the object outlived the recording
+  size_t _weight;
+  size_t _size;
+  char _kind;
+};
+
+static int compare_deaths(const AllocationTraceSample* a, const AllocationTraceSample* b) {
+  // Samples that outlived the recording sort last.
+  jlong da = (a->_death < 0) ? max_jlong : a->_death;
+  jlong db = (b->_death < 0) ? max_jlong : b->_death;
+  return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+// The largest number of objects allocated for one sample.
+static const size_t max_replay_cohort = 64 * K;
+
+static bool read_trace(const char* file, GrowableArray<AllocationTraceSample>* samples,
+                       outputStream* out) {
+  FILE* fp = os::fopen(file, "r");
+  if (fp == NULL) {
+    out->print_cr("Could not open allocation trace file %s", file);
+    return false;
+  }
+  char line[1024];
+  int lineno = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), fp) != NULL) {
+    lineno++;
+    uint64_t id;
+    jlong time;
+    intx thread;
+    size_t weight, size;
+    char kind;
+    if (line[0] == 'A') {
+      if (sscanf(line, "A " UINT64_FORMAT " " JLONG_FORMAT " " INTX_FORMAT " " SIZE_FORMAT " " SIZE_FORMAT " %c",
+                 &id, &time, &thread, &weight, &size, &kind) != 6 ||
+          id != (uint64_t)samples->length()) {
+        ok = false;
+      } else {
+        AllocationTraceSample s = { time, -1, weight, size, kind };
+        samples->append(s);
+      }
+    } else if (line[0] == 'D') {
+      if (sscanf(line, "D " UINT64_FORMAT " " JLONG_FORMAT, &id, &time) != 2 ||
+          id >= (uint64_t)samples->length()) {
+        ok = false;
+      } else {
+        samples->adr_at((int)id)->_death = time;
+      }
+    } else if (line[0] != 'E') {
+      ok = false;
+    }
+  }
+  fclose(fp);
+  if (!ok) {
+    out->print_cr("Malformed allocation trace %s at line %d", file, lineno);
+  }
+  return ok;
+}
+
+// Allocates an object of about size bytes, shaped like a sample of kind.
+// Instances are stood in for by byte arrays.
+static oop replay_object(char kind, size_t size, TRAPS) {
+  if (kind == 'o') {
+    size_t base = arrayOopDesc::base_offset_in_bytes(T_OBJECT);
+    int length = (int)MIN2((size > base ? size - base : 0) / heapOopSize, (size_t)max_jint);
+    return oopFactory::new_objArray(SystemDictionary::Object_klass(), length, THREAD);
+  } else {
+    size_t base = arrayOopDesc::base_offset_in_bytes(T_BYTE);
+    int length = (int)MIN2(size > base ? size - base : 0, (size_t)max_jint);
+    return oopFactory::new_byteArray(length, THREAD);
+  }
+}
+
+bool AllocationTraceReplayer::replay(const char* file, bool paced, outputStream* out, TRAPS) {
+  JavaThread* jt = (JavaThread*)THREAD;
+  GrowableArray<AllocationTraceSample> samples(1024, true, mtGC);
+  if (!read_trace(file, &samples, out)) {
+    return false;
+  }
+  if (samples.is_empty()) {
+    out->print_cr("Allocation trace %s has no samples", file);
+    return true;
+  }
+
+  // The cohorts still reachable, ordered by the time they die.
+  jobject* cohorts = NEW_C_HEAP_ARRAY(jobject, samples.length(), mtGC);
+  int* by_death = NEW_C_HEAP_ARRAY(int, samples.length(), mtGC);
+  GrowableArray<AllocationTraceSample*> order(samples.length(), true, mtGC);
+  for (int i = 0; i < samples.length(); i++) {
+    cohorts[i] = NULL;
+    order.append(samples.adr_at(i));
+  }
+  QuickSort::sort(order.adr_at(0), order.length(), compare_deaths, false);
+  for (int i = 0; i < order.length(); i++) {
+    by_death[i] = (int)(order.at(i) - samples.adr_at(0));
+  }
+
+  size_t allocated = 0;
+  int next_death = 0;
+  jlong start = os::javaTimeNanos();
+  bool ok = true;
+
+  for (int i = 0; i < samples.length() && ok; i++) {
+    const AllocationTraceSample& s = samples.at(i);
+
+    // Let the cohorts due to die become unreachable.
+    while (next_death < samples.length()) {
+      const AllocationTraceSample& d = samples.at(by_death[next_death]);
+      if (d._death < 0 || d._death > s._time) {
+        break;
+      }
+      if (cohorts[by_death[next_death]] != NULL) {
+        JNIHandles::destroy_global(cohorts[by_death[next_death]]);
+        cohorts[by_death[next_death]] = NULL;
+      }
+      next_death++;
+    }
+
+    // Wait for the time of the sample, letting safepoints happen.
+    {
+      ThreadBlockInVM tbivm(jt);
+      jlong wait_ms = paced ? (s._time - (os::javaTimeNanos() - start)) / NANOSECS_PER_MILLISEC : 0;
+      while (wait_ms > 0) {
+        jlong ms = MIN2(wait_ms, (jlong)500);
+        os::naked_short_sleep(ms);
+        wait_ms -= ms;
+      }
+    }
+
+    HandleMark hm(THREAD);
+    size_t size = MAX2(s._size, (size_t)1);
+    size_t n = MIN2(MAX2(s._weight / size, (size_t)1), max_replay_cohort);
+    bool survives = s._death < 0 || s._death > s._time;
+    objArrayHandle holder;
+    if (survives) {
+      objArrayOop h = oopFactory::new_objArray(SystemDictionary::Object_klass(), (int)n, THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        ok = false;
+        break;
+      }
+      holder = objArrayHandle(THREAD, h);
+    }
+    for (size_t k = 0; k < n; k++) {
+      oop o = replay_object(s._kind, size, THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        ok = false;
+        break;
+      }
+      if (survives) {
+        holder->obj_at_put((int)k, o);
+      }
+      allocated += size;
+    }
+    if (ok && survives) {
+      cohorts[i] = JNIHandles::make_global(holder);
+    }
+  }
+
+  jlong elapsed = os::javaTimeNanos() - start;
+  for (int i = 0; i < samples.length(); i++) {
+    if (cohorts[i] != NULL) {
+      JNIHandles::destroy_global(cohorts[i]);
+    }
+  }
+  FREE_C_HEAP_ARRAY(jobject, cohorts);
+  FREE_C_HEAP_ARRAY(int, by_death);
+
+  if (HAS_PENDING_EXCEPTION) {
+    CLEAR_PENDING_EXCEPTION;
+    out->print_cr("Replay stopped by an exception, most likely OutOfMemoryError");
+  }
+  out->print_cr("Replayed %d samples, " SIZE_FORMAT "K allocated in " JLONG_FORMAT "ms",
+                samples.length(), allocated / K, elapsed / NANOSECS_PER_MILLISEC);
+  return ok;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_ALLOCATIONTRACE_HPP
+#define SHARE_GC_SHARED_ALLOCATIONTRACE_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/exceptions.hpp"
+
+class fileStream;
+class Mutex;
+class outputStream;
+class Thread;
+
+// Recording of a sampled allocation and lifetime trace, for replaying the
+// allocation rate and heap shape of a workload against any collector.
+//
+// With -XX:AllocationTraceFile=<file>, the allocations that JFR samples
+// (those outside a TLAB, and those that refill a TLAB) are written to the
+// file together with the number of bytes each one stands for.  Up to
+// AllocationTraceMaxTracked of the sampled objects are also held weakly,
+// and the end of the first GC that finds one of them dead is recorded.
+//
+// The trace is a text file with one record per line:
+//
+//   A <id> <nanos> <thread> <weight> <size> <kind> <class>
+//                        object <id> of <size> bytes was allocated, standing
+//                        for <weight> allocated bytes; <kind> is i for an
+//                        instance, a for a primitive array and o for an
+//                        object array, with a trailing * if its death is
+//                        tracked
+//   D <id> <nanos>       object <id> was found dead
+//   E <nanos>            end of the recording
+//
+// Times are nanoseconds since the recording started.
+class AllocationTraceRecorder : AllStatic {
+  struct Tracked {
+    oop* _ref;
+    uint64_t _id;
+  };
+
+  static volatile bool _enabled;
+  static Mutex* _lock;
+  static fileStream* _out;
+  static jlong _start_nanos;
+  static uint64_t _next_id;
+  static Tracked* _tracked;
+  static size_t _num_tracked;
+
+  static jlong nanos_since_start();
+
+public:
+  static void initialize();
+  static void shutdown();
+
+  static bool is_enabled() { return _enabled; }
+
+  // Records obj, just allocated by thread, as a sample for weight bytes.
+  static void record_allocation(Thread* thread, oop obj, size_t weight);
+
+  // Records the deaths of tracked objects. Called at the end of every GC.
+  static void report_gc_end();
+};
+
+// Replays a trace written by AllocationTraceRecorder.  Every sampled
+// allocation is reproduced by allocating its weight in arrays of the
+// sampled size.  The arrays of a sample whose object died stay reachable
+// until the recorded time of the death; the ones of a sample that
+// outlived the recording stay reachable until the end of the replay.
+// With paced, the recorded timing is followed, otherwise the trace is
+// replayed as fast as possible.
+class AllocationTraceReplayer : public StackObj {
+public:
+  static bool replay(const char* file, bool paced, outputStream* out, TRAPS);
+};
+
+#endif // SHARE_GC_SHARED_ALLOCATIONTRACE_HPP
@@ -28,6 +28,7 @@
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/barrierSetNMethod.hpp"
 #include "logging/log.hpp"
+#include "runtime/sweeper.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
 
@@ -67,10 +68,22 @@ int BarrierSetNMethod::nmethod_stub_entry_barrier(address* return_address_ptr) {
   if (!may_enter) {
     log_trace(nmethod, barrier)("Deoptimizing nmethod: " PTR_FORMAT, p2i(nm));
     bs_nm->deoptimize(nm, return_address_ptr);
+  } else {
+    record_entry(nm);
   }
   return may_enter ? 0 : 1;
 }
 
+// The barriers are armed once per GC cycle, so the first entry after that
+// tells the sweeper that the nmethod is still in use in this GC epoch,
+// just like finding it on a stack would. Unlike the stack scan this also
+// catches methods that are called often but return quickly.
+void BarrierSetNMethod::record_entry(nmethod* nm) {
+  if (UseCodeCacheFlushing) {
+    nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
+  }
+}
+
 bool BarrierSetNMethod::nmethod_osr_entry_barrier(nmethod* nm) {
   // This check depends on the invariant that all nmethods that are deoptimized / made not entrant
   // are NOT disarmed.
@@ -83,5 +96,9 @@ bool BarrierSetNMethod::nmethod_osr_entry_barrier(nmethod* nm) {
 
   assert(nm->is_osr_method(), "Should not reach here");
   log_trace(nmethod, barrier)("Running osr nmethod entry barrier: " PTR_FORMAT, p2i(nm));
-  return nmethod_entry_barrier(nm);
+  bool may_enter = nmethod_entry_barrier(nm);
+  if (may_enter) {
+    record_entry(nm);
+  }
+  return may_enter;
 }
@@ -34,6 +34,7 @@ class nmethod;
 class BarrierSetNMethod: public CHeapObj<mtGC> {
   bool supports_entry_barrier(nmethod* nm);
   void deoptimize(nmethod* nm, address* return_addr_ptr);
+  static void record_entry(nmethod* nm);
 
 protected:
   virtual int disarmed_value() const;
@@ -66,12 +66,11 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
   }
 
   double timestamp = fetch_timestamp();
-  MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-  int index = compute_log_index();
-  _records[index].thread = NULL; // Its the GC thread so it's not that interesting.
-  _records[index].timestamp = timestamp;
-  _records[index].data.is_before = before;
-  stringStream st(_records[index].data.buffer(), _records[index].data.size());
+  uint seq = begin_record();
+  record_at(seq).thread = NULL; // Its the GC thread so it's not that interesting.
+  record_at(seq).timestamp = timestamp;
+  record_at(seq).data.is_before = before;
+  stringStream st(record_at(seq).data.buffer(), record_at(seq).data.size());
 
   st.print_cr("{Heap %s GC invocations=%u (full %u):",
                  before ? "before" : "after",
@@ -80,6 +79,7 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
 
   heap->print_on(&st);
   st.print_cr("}");
+  end_record(seq);
 }
 
 size_t CollectedHeap::unused() const {
@@ -561,6 +561,14 @@ void CollectedHeap::reset_promotion_should_fail() {
 
 #endif  // #ifndef PRODUCT
 
+bool CollectedHeap::supports_pretenured_allocation() const {
+  return false;
+}
+
+HeapWord* CollectedHeap::mem_allocate_pretenured(size_t size) {
+  return NULL;
+}
+
 bool CollectedHeap::supports_object_pinning() const {
   return false;
 }
@@ -59,6 +59,14 @@ class VirtualSpaceSummary;
 class WorkGang;
 class nmethod;
 
+// An iterator over the objects of the heap that is shared by several worker
+// threads. Every object is visited by exactly one of them.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+public:
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 class GCMessage : public FormatBuffer<1024> {
  public:
   bool is_before;
@@ -393,6 +401,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns an iterator that thread_num worker threads can use to iterate
+  // over all objects in parallel, or NULL if the heap does not support it.
+  // Must be called at a safepoint.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
   // Returns the longest time (in ms) that has elapsed since the last
   // time that any part of the heap was examined by a garbage collection.
   virtual jlong millis_since_last_gc() = 0;
@@ -499,6 +514,12 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   virtual oop pin_object(JavaThread* thread, oop obj);
   virtual void unpin_object(JavaThread* thread, oop obj);
 
+  // Support for pretenuring. Allocates size words directly in the old
+  // generation, without collecting, or returns NULL. Used for the objects
+  // of allocation sites that AllocationSiteProfile finds long-lived.
+  virtual bool supports_pretenured_allocation() const;
+  virtual HeapWord* mem_allocate_pretenured(size_t size);
+
   // Deduplicate the string, iff the GC supports string deduplication.
   virtual void deduplicate_string(oop str);
 
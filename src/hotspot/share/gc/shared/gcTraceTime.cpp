@@ -25,6 +25,8 @@
 #include "precompiled.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "logging/log.hpp"
+#include "logging/logStream.hpp"
+#include "runtime/hardwareCounters.hpp"
 #include "runtime/os.hpp"
 
 GCTraceCPUTime::GCTraceCPUTime() :
@@ -58,3 +60,18 @@ GCTraceCPUTime::~GCTraceCPUTime() {
     }
   }
 }
+
+void GCTraceTimeImpl::report_hardware_counters() {
+  HardwareCounterValues values;
+  if (!_hardware_counters.elapsed(&values)) {
+    return;
+  }
+  LogTarget(Debug, gc, phases, perf) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    ls.print("%s: ", _title);
+    HardwareCounters::print_on(&ls, values);
+    ls.cr();
+  }
+  _hardware_counters.send_event(_title, values);
+}
@@ -29,6 +29,7 @@
 #include "logging/logHandle.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/hardwareCounters.hpp"
 #include "utilities/ticks.hpp"
 
 class GCTraceCPUTime : public StackObj {
@@ -53,9 +54,11 @@ class GCTraceTimeImpl : public StackObj {
   GCCause::Cause _gc_cause;
   GCTimer* _timer;
   size_t _heap_usage_before;
+  HardwareCounterScope _hardware_counters;
 
   void log_start(jlong start_counter);
   void log_stop(jlong start_counter, jlong stop_counter);
+  void report_hardware_counters();
   void time_stamp(Ticks& ticks);
 
  public:
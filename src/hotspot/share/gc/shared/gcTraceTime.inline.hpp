@@ -86,7 +86,8 @@ inline GCTraceTimeImpl::GCTraceTimeImpl(LogTargetHandle out_start, LogTargetHand
   _title(title),
   _gc_cause(gc_cause),
   _timer(timer),
-  _heap_usage_before(SIZE_MAX) {
+  _heap_usage_before(SIZE_MAX),
+  _hardware_counters(HardwareCounters::should_measure(log_is_enabled(Debug, gc, phases, perf))) {
 
   time_stamp(_start_ticks);
   if (_enabled) {
@@ -109,6 +110,9 @@ inline GCTraceTimeImpl::~GCTraceTimeImpl() {
   if (_timer != NULL) {
     _timer->register_gc_phase_end(stop_ticks);
   }
+  if (_hardware_counters.is_active()) {
+    report_hardware_counters();
+  }
 }
 
 template <LogLevelType Level, LogTagType T0, LogTagType T1, LogTagType T2, LogTagType T3, LogTagType T4, LogTagType GuardTag >
@@ -129,8 +129,10 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   bool _print_help;
   bool _print_class_stats;
   const char* _columns;
+  uint _parallel_thread_num;
  public:
-  VM_GC_HeapInspection(outputStream* out, bool request_full_gc) :
+  VM_GC_HeapInspection(outputStream* out, bool request_full_gc,
+                       uint parallel_thread_num = 1) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_inspection /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
@@ -141,6 +143,7 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
     _print_help = false;
     _print_class_stats = false;
     _columns = NULL;
+    _parallel_thread_num = parallel_thread_num;
   }
 
   ~VM_GC_HeapInspection() {}
@@ -223,6 +223,34 @@
           "Force dynamic selection of the number of "                       \
           "parallel threads parallel gc will use to aid debugging")         \
                                                                             \
+  diagnostic(ccstr, AllocationTraceFile, NULL,                              \
+          "Record a sampled allocation and lifetime trace to this file, "   \
+          "for replay with the GC.replay_allocation_trace command")         \
+                                                                            \
+  diagnostic(uintx, AllocationTraceMaxTracked, 16*K,                        \
+          "Maximum number of sampled objects whose death is tracked at "    \
+          "the same time when recording an allocation trace")               \
+          range(0, max_juint)                                               \
+                                                                            \
+  experimental(bool, PretenureAllocationSites, false,                       \
+          "Profile the survival of sampled objects per allocation site, "   \
+          "and let C2 allocate the objects of sites whose objects survive " \
+          "directly in the old generation")                                 \
+                                                                            \
+  experimental(uintx, PretenureSiteTableSize, 1024,                         \
+          "Maximum number of allocation sites profiled for pretenuring")    \
+          range(16, max_juint)                                              \
+                                                                            \
+  experimental(uintx, PretenureSurvivedGCs, 2,                              \
+          "Number of collections a sampled object must survive to count "   \
+          "as long-lived for pretenuring")                                  \
+          range(1, markWord::max_age)                                       \
+                                                                            \
+  experimental(uintx, PretenureSurvivalThreshold, 90,                       \
+          "Percentage of the sampled objects of an allocation site that "   \
+          "must be long-lived for the site to be pretenured")               \
+          range(1, 100)                                                     \
+                                                                            \
   product(size_t, HeapSizePerGCThread, ScaleForWordSize(32*M),              \
           "Size of heap (bytes) per GC thread used in calculating the "     \
           "number of GC threads")                                           \
@@ -388,6 +416,16 @@
   experimental(uintx, WorkStealingSpinToYieldRatio, 10,                     \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  experimental(uint, WorkStealingBatchSize, 1,                              \
+          "Maximum number of tasks taken from a victim queue in one "       \
+          "steal. Tasks beyond the first are moved to the queue of the "    \
+          "stealing worker. 1 disables batched stealing")                   \
+          range(1, 1024)                                                    \
+                                                                            \
+  experimental(bool, WorkStealingPreferNUMALocal, false,                    \
+          "Prefer the queues of workers on the same NUMA node as victims "  \
+          "when stealing. Requires UseNUMA")                                \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 2048,                               \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
@@ -773,6 +811,15 @@
           "Percentage of Eden that can be wasted")                          \
           range(1, 100)                                                     \
                                                                             \
+  product(bool, TLABAllocationClasses, true,                                \
+          "Classify threads as hot, warm or cold by the amount they "       \
+          "allocated since the last GC and size their TLABs accordingly")   \
+                                                                            \
+  product(uintx, TLABHotThreadPercent, 5,                                   \
+          "Percentage of the TLAB capacity a thread must have allocated "   \
+          "since the last GC to be classified as hot")                      \
+          range(1, 100)                                                     \
+                                                                            \
   product(uintx, TLABRefillWasteFraction,    64,                            \
           "Maximum TLAB waste at a refill (internal fragmentation)")        \
           range(1, max_juint)                                               \
@@ -473,6 +473,10 @@ HeapWord* GenCollectedHeap::mem_allocate(size_t size,
                            gc_overhead_limit_was_exceeded);
 }
 
+HeapWord* GenCollectedHeap::mem_allocate_pretenured(size_t size) {
+  return _old_gen->par_allocate(size, false /* is_tlab */);
+}
+
 bool GenCollectedHeap::must_clear_all_soft_refs() {
   return _gc_cause == GCCause::_metadata_GC_clear_soft_refs ||
          _gc_cause == GCCause::_wb_full_gc;
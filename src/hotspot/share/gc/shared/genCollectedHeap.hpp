@@ -206,6 +206,9 @@ public:
 
   HeapWord* mem_allocate(size_t size, bool*  gc_overhead_limit_was_exceeded);
 
+  virtual bool supports_pretenured_allocation() const { return true; }
+  virtual HeapWord* mem_allocate_pretenured(size_t size);
+
   // We may support a shared contiguous allocation area, if the youngest
   // generation does.
   bool supports_inline_contig_alloc() const;
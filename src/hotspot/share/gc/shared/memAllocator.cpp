@@ -25,6 +25,8 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "gc/shared/allocTracer.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
+#include "gc/shared/allocationTrace.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/memAllocator.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
@@ -47,6 +49,7 @@ class MemAllocator::Allocation: StackObj {
   oop*                _obj_ptr;
   bool                _overhead_limit_exceeded;
   bool                _allocated_outside_tlab;
+  bool                _allocated_pretenured;
   size_t              _allocated_tlab_size;
   bool                _tlab_end_reset_for_sample;
 
@@ -58,6 +61,8 @@ class MemAllocator::Allocation: StackObj {
   void notify_allocation_jvmti_sampler();
   void notify_allocation_low_memory_detector();
   void notify_allocation_jfr_sampler();
+  void notify_allocation_trace_recorder();
+  void notify_allocation_site_profile();
   void notify_allocation_dtrace_sampler();
   void check_for_bad_heap_word_value() const;
 #ifdef ASSERT
@@ -73,6 +78,7 @@ public:
       _obj_ptr(obj_ptr),
       _overhead_limit_exceeded(false),
       _allocated_outside_tlab(false),
+      _allocated_pretenured(false),
       _allocated_tlab_size(0),
       _tlab_end_reset_for_sample(false)
   {
@@ -233,6 +239,29 @@ void MemAllocator::Allocation::notify_allocation_jfr_sampler() {
   }
 }
 
+void MemAllocator::Allocation::notify_allocation_trace_recorder() {
+  if (!AllocationTraceRecorder::is_enabled()) {
+    return;
+  }
+  // Same samples as the JFR events above, weighted by the bytes they stand for.
+  if (_allocated_outside_tlab) {
+    AllocationTraceRecorder::record_allocation(_thread, obj(), _allocator._word_size * HeapWordSize);
+  } else if (_allocated_tlab_size != 0) {
+    AllocationTraceRecorder::record_allocation(_thread, obj(), _allocated_tlab_size * HeapWordSize);
+  }
+}
+
+void MemAllocator::Allocation::notify_allocation_site_profile() {
+  if (!AllocationSiteProfile::is_enabled()) {
+    return;
+  }
+  // Same samples as the JFR events above, except for the allocations of
+  // sites that are already pretenured, which all happen outside a TLAB.
+  if ((_allocated_outside_tlab && !_allocated_pretenured) || _allocated_tlab_size != 0) {
+    AllocationSiteProfile::record_allocation(_thread, obj());
+  }
+}
+
 void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
   if (DTraceAllocProbes) {
     // support for Dtrace object alloc event (no-op most of the time)
@@ -247,6 +276,8 @@ void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
 void MemAllocator::Allocation::notify_allocation() {
   notify_allocation_low_memory_detector();
   notify_allocation_jfr_sampler();
+  notify_allocation_trace_recorder();
+  notify_allocation_site_profile();
   notify_allocation_dtrace_sampler();
   notify_allocation_jvmti_sampler();
 }
@@ -265,6 +296,21 @@ HeapWord* MemAllocator::allocate_outside_tlab(Allocation& allocation) const {
   return mem;
 }
 
+HeapWord* MemAllocator::allocate_pretenured(Allocation& allocation) const {
+  HeapWord* mem = Universe::heap()->mem_allocate_pretenured(_word_size);
+  if (mem == NULL) {
+    return mem;
+  }
+  allocation._allocated_outside_tlab = true;
+  allocation._allocated_pretenured = true;
+
+  NOT_PRODUCT(Universe::heap()->check_for_non_bad_heap_word_value(mem, _word_size));
+  size_t size_in_bytes = _word_size * HeapWordSize;
+  _thread->incr_allocated_bytes(size_in_bytes);
+
+  return mem;
+}
+
 HeapWord* MemAllocator::allocate_inside_tlab(Allocation& allocation) const {
   assert(UseTLAB, "should use UseTLAB");
 
@@ -346,6 +392,13 @@ HeapWord* MemAllocator::allocate_inside_tlab_slow(Allocation& allocation) const
 }
 
 HeapWord* MemAllocator::mem_allocate(Allocation& allocation) const {
+  if (_thread->pretenure_allocations()) {
+    HeapWord* result = allocate_pretenured(allocation);
+    if (result != NULL) {
+      return result;
+    }
+  }
+
   if (UseTLAB) {
     HeapWord* result = allocate_inside_tlab(allocation);
     if (result != NULL) {
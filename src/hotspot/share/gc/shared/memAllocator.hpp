@@ -46,6 +46,8 @@ private:
   HeapWord* allocate_inside_tlab(Allocation& allocation) const;
   HeapWord* allocate_inside_tlab_slow(Allocation& allocation) const;
   HeapWord* allocate_outside_tlab(Allocation& allocation) const;
+  // Allocate in the old generation, for a pretenured allocation site.
+  HeapWord* allocate_pretenured(Allocation& allocation) const;
 
 protected:
   MemAllocator(Klass* klass, size_t word_size, Thread* thread)
@@ -62,7 +64,8 @@ protected:
   virtual oop finish(HeapWord* mem) const;
 
   // Raw memory allocation. This will try to do a TLAB allocation, and otherwise fall
-  // back to calling CollectedHeap::mem_allocate().
+  // back to calling CollectedHeap::mem_allocate(). Pretenured allocations first try
+  // CollectedHeap::mem_allocate_pretenured().
   HeapWord* mem_allocate(Allocation& allocation) const;
 
   virtual MemRegion obj_memory_range(oop obj) const {
@@ -268,6 +268,14 @@ bool OopStorage::Block::is_safe_to_delete() const {
          (OrderAccess::load_acquire(&_deferred_updates_next) == NULL);
 }
 
+void OopStorage::Block::increment_release_refcount() {
+  Atomic::inc(&_release_refcount);
+}
+
+void OopStorage::Block::decrement_release_refcount() {
+  Atomic::dec(&_release_refcount);
+}
+
 OopStorage::Block* OopStorage::Block::deferred_updates_next() const {
   return _deferred_updates_next;
 }
@@ -301,10 +309,29 @@ unsigned OopStorage::Block::get_index(const oop* ptr) const {
 }
 
 oop* OopStorage::Block::allocate() {
-  // Use CAS loop because release may change bitmask outside of lock.
+  // Use CAS loop because release and lock-free allocation may change
+  // bitmask outside of lock.
+  uintx allocated = allocated_bitmask();
+  while (true) {
+    if (is_full_bitmask(allocated)) {
+      return NULL;             // Filled by lock-free allocations.
+    }
+    unsigned index = count_trailing_zeros(~allocated);
+    uintx new_value = allocated | bitmask_for_index(index);
+    uintx fetched = Atomic::cmpxchg(new_value, &_allocated_bitmask, allocated);
+    if (fetched == allocated) {
+      return get_pointer(index); // CAS succeeded; return entry for index.
+    }
+    allocated = fetched;       // CAS failed; retry with latest value.
+  }
+}
+
+oop* OopStorage::Block::allocate_if_not_empty() {
   uintx allocated = allocated_bitmask();
   while (true) {
-    assert(!is_full_bitmask(allocated), "attempt to allocate from full block");
+    if (is_full_bitmask(allocated) || is_empty_bitmask(allocated)) {
+      return NULL;
+    }
     unsigned index = count_trailing_zeros(~allocated);
     uintx new_value = allocated | bitmask_for_index(index);
     uintx fetched = Atomic::cmpxchg(new_value, &_allocated_bitmask, allocated);
@@ -386,6 +413,21 @@ OopStorage::Block::block_for_ptr(const OopStorage* owner, const oop* ptr) {
 // removed from the _allocation_list so it won't be considered by future
 // allocations until some entries in it are released.
 //
+// Most allocations don't take the _allocation_mutex at all.  Each thread
+// maps to one of the _allocation_hints, which names the block that the
+// last locked allocation through that hint used.  allocate() first tries
+// to take an entry from that block with a CAS on its _allocated_bitmask,
+// inside a _protect_allocation_hints critical section.  This fast path
+// never allocates from an empty block, so it can't race with empty block
+// deletion putting a block back into use, nor disturb the segregation of
+// empty blocks to the end of the _allocation_list.  Before a block is
+// deleted it is withdrawn from the hints and the critical sections that
+// might have seen it are waited for.  If the fast path fills the block,
+// it takes the _allocation_mutex to remove the block from the
+// _allocation_list, as a locked allocation would.  Otherwise the list is
+// unaffected.  Active array growth only happens when a block is added,
+// which is rare enough to stay under the lock.
+//
 // release() is performed lock-free. (Note: This means it can't notify the
 // service thread of pending cleanup work.  It must be lock-free because
 // it is called in all kinds of contexts where even quite low ranked locks
@@ -410,18 +452,70 @@ OopStorage::Block::block_for_ptr(const OopStorage* owner, const oop* ptr) {
 // full.  The block is moved to the end of the _allocation_list if the bitmask
 // is empty, for ease of empty block deletion processing.
 
+static uint allocation_hint_index_for_current_thread(uint hint_count) {
+  // Threads are allocated well apart; drop the low bits that are shared.
+  uintptr_t id = reinterpret_cast<uintptr_t>(Thread::current_or_null());
+  return static_cast<uint>((id >> 10) ^ (id >> 16)) % hint_count;
+}
+
+bool OopStorage::is_in_allocation_list(const Block& block) const {
+  assert_lock_strong(_allocation_mutex);
+  return (_allocation_list.ctail() != NULL) &&
+         ((_allocation_list.ctail() == &block) ||
+          (_allocation_list.next(block) != NULL));
+}
+
+oop* OopStorage::try_allocate_from_hint(uint hint_index) {
+  Block* block;
+  oop* result;
+  {
+    SingleWriterSynchronizer::CriticalSection cs(&_protect_allocation_hints);
+    block = OrderAccess::load_acquire(&_allocation_hints[hint_index]._block);
+    if (block == NULL) return NULL;
+    result = block->allocate_if_not_empty();
+    if (result == NULL) return NULL;
+    Atomic::inc(&_allocation_count);
+    if (!block->is_full()) {
+      log_trace(oopstorage, ref)("%s: allocated " PTR_FORMAT, name(), p2i(result));
+      return result;
+    }
+    // Releases could empty the block once we leave the critical section.
+    block->increment_release_refcount();
+  }
+  // Transitioning from not full to full.  Unless that's already been
+  // done, remove it from consideration by future allocates.
+  {
+    MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
+    if (block->is_full() && is_in_allocation_list(*block)) {
+      log_trace(oopstorage, blocks)("%s: block full " PTR_FORMAT, name(), p2i(block));
+      _allocation_list.unlink(*block);
+    }
+  }
+  block->decrement_release_refcount();
+  log_trace(oopstorage, ref)("%s: allocated " PTR_FORMAT, name(), p2i(result));
+  return result;
+}
+
 oop* OopStorage::allocate() {
+  uint hint_index = allocation_hint_index_for_current_thread(allocation_hint_count);
+  oop* result = try_allocate_from_hint(hint_index);
+  if (result != NULL) return result;
+
   MutexLocker ml(_allocation_mutex, Mutex::_no_safepoint_check_flag);
 
-  Block* block = block_for_allocation();
-  if (block == NULL) return NULL; // Block allocation failed.
-  assert(!block->is_full(), "invariant");
-  if (block->is_empty()) {
-    // Transitioning from empty to not empty.
-    log_trace(oopstorage, blocks)("%s: block not empty " PTR_FORMAT, name(), p2i(block));
+  Block* block;
+  while (true) {
+    block = block_for_allocation();
+    if (block == NULL) return NULL; // Block allocation failed.
+    if (block->is_empty()) {
+      // Transitioning from empty to not empty.
+      log_trace(oopstorage, blocks)("%s: block not empty " PTR_FORMAT, name(), p2i(block));
+    }
+    result = block->allocate();
+    if (result != NULL) break;
+    // Filled by lock-free allocations that have yet to unlink it.
+    _allocation_list.unlink(*block);
   }
-  oop* result = block->allocate();
-  assert(result != NULL, "allocation failed");
   assert(!block->is_empty(), "postcondition");
   Atomic::inc(&_allocation_count); // release updates outside lock.
   if (block->is_full()) {
@@ -429,11 +523,27 @@ oop* OopStorage::allocate() {
     // Remove full blocks from consideration by future allocates.
     log_trace(oopstorage, blocks)("%s: block full " PTR_FORMAT, name(), p2i(block));
     _allocation_list.unlink(*block);
+  } else {
+    // Let this thread's next allocations use the block without locking.
+    OrderAccess::release_store(&_allocation_hints[hint_index]._block, block);
   }
   log_trace(oopstorage, ref)("%s: allocated " PTR_FORMAT, name(), p2i(result));
   return result;
 }
 
+// Ensure no lock-free allocation is using block, so it can be deleted.
+void OopStorage::withdraw_allocation_hints(const Block& block) {
+  assert_lock_strong(_allocation_mutex);
+  for (uint i = 0; i < allocation_hint_count; ++i) {
+    if (_allocation_hints[i]._block == &block) {
+      OrderAccess::release_store(&_allocation_hints[i]._block, (Block*)NULL);
+    }
+  }
+  // A critical section may have read the block before a hint was
+  // changed to another block, so always wait.
+  _protect_allocation_hints.synchronize();
+}
+
 bool OopStorage::try_add_block() {
   assert_lock_strong(_allocation_mutex);
   Block* block;
@@ -665,11 +775,12 @@ bool OopStorage::reduce_deferred_updates() {
   uintx allocated = block->allocated_bitmask();
 
   // Make membership in list consistent with bitmask state.
-  if ((_allocation_list.ctail() != NULL) &&
-      ((_allocation_list.ctail() == block) ||
-       (_allocation_list.next(*block) != NULL))) {
-    // Block is in the _allocation_list.
-    assert(!is_full_bitmask(allocated), "invariant");
+  if (is_in_allocation_list(*block)) {
+    // Block is in the _allocation_list.  It may have just been filled by
+    // a lock-free allocation that is yet to unlink it.
+    if (is_full_bitmask(allocated)) {
+      _allocation_list.unlink(*block);
+    }
   } else if (!is_full_bitmask(allocated)) {
     // Block is not in the _allocation_list, but now should be.
     _allocation_list.push_front(*block);
@@ -743,6 +854,9 @@ OopStorage::OopStorage(const char* name,
   _concurrent_iteration_count(0),
   _needs_cleanup(false)
 {
+  for (uint i = 0; i < allocation_hint_count; ++i) {
+    _allocation_hints[i]._block = NULL;
+  }
   _active_array->increment_refcount();
   assert(_active_mutex->rank() < _allocation_mutex->rank(),
          "%s: active_mutex must have lower rank than allocation_mutex", _name);
@@ -880,7 +994,13 @@ bool OopStorage::delete_empty_blocks() {
         break;
       }
 
-      // Try to delete the block.  First, try to remove from _active_array.
+      // Try to delete the block.  Lock-free allocation never allocates
+      // from an empty block, but may still be looking at it.
+      withdraw_allocation_hints(*block);
+      if (!block->is_safe_to_delete()) {
+        break;
+      }
+      // Then try to remove from _active_array.
       {
         MutexLocker aml(_active_mutex, Mutex::_no_safepoint_check_flag);
         // Don't interfere with an active concurrent iteration.
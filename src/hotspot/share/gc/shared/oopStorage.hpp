@@ -26,6 +26,7 @@
 #define SHARE_GC_SHARED_OOPSTORAGE_HPP
 
 #include "memory/allocation.hpp"
+#include "memory/padded.hpp"
 #include "oops/oop.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -100,7 +101,8 @@ public:
   EntryStatus allocation_status(const oop* ptr) const;
 
   // Allocates and returns a new entry.  Returns NULL if memory allocation
-  // failed.  Locks _allocation_mutex.
+  // failed.  Locks _allocation_mutex unless the entry can be taken from
+  // the block the calling thread last allocated from.
   // postcondition: *result == NULL.
   oop* allocate();
 
@@ -231,6 +233,18 @@ private:
   // Protection for _active_array.
   mutable SingleWriterSynchronizer _protect_active;
 
+  // Blocks for lock-free allocation, indexed by a hash of the allocating
+  // thread.  Set while holding _allocation_mutex, read without it.
+  static const uint allocation_hint_count = 16;
+  struct AllocationHint {
+    Block* volatile _block;
+    DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(Block*));
+  };
+  AllocationHint _allocation_hints[allocation_hint_count];
+
+  // Protection for blocks obtained from _allocation_hints.
+  mutable SingleWriterSynchronizer _protect_allocation_hints;
+
   // mutable because this gets set even for const iteration.
   mutable int _concurrent_iteration_count;
 
@@ -238,6 +252,9 @@ private:
 
   bool try_add_block();
   Block* block_for_allocation();
+  oop* try_allocate_from_hint(uint hint_index);
+  void withdraw_allocation_hints(const Block& block);
+  bool is_in_allocation_list(const Block& block) const;
 
   Block* find_block_or_null(const oop* ptr) const;
   void delete_empty_block(const Block& block);
@@ -176,6 +176,10 @@ public:
 
   bool is_safe_to_delete() const;
 
+  // Holds off deletion while the block is used without the mutex.
+  void increment_release_refcount();
+  void decrement_release_refcount();
+
   Block* deferred_updates_next() const;
   void set_deferred_updates_next(Block* new_next);
 
@@ -188,7 +192,10 @@ public:
   // Returns NULL if ptr is not in a block or not allocated in that block.
   static Block* block_for_ptr(const OopStorage* owner, const oop* ptr);
 
+  // Returns NULL if the block is full.
   oop* allocate();
+  // Returns NULL if the block is full or empty.
+  oop* allocate_if_not_empty();
   static Block* new_block(const OopStorage* owner);
   static void delete_block(const Block& block);
 
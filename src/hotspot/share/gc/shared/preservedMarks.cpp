@@ -28,44 +28,80 @@
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/macros.hpp"
 
 void PreservedMarks::restore() {
-  while (!_stack.is_empty()) {
-    const OopAndMarkWord elem = _stack.pop();
-    elem.set_mark();
+  for (Chunk* chunk = _chunks; chunk != NULL; chunk = chunk->_next) {
+    chunk->restore();
   }
+  release_chunks();
   assert_empty();
 }
 
 void PreservedMarks::adjust_during_full_gc() {
-  StackIterator<OopAndMarkWord, mtGC> iter(_stack);
-  while (!iter.is_empty()) {
-    OopAndMarkWord* elem = iter.next_addr();
+  for (Chunk* chunk = _chunks; chunk != NULL; chunk = chunk->_next) {
+    for (size_t i = 0; i < chunk->_top; i++) {
+      OopAndMarkWord* elem = &chunk->_data[i];
+
+      oop obj = elem->get_oop();
+      if (obj->is_forwarded()) {
+        elem->set_oop(obj->forwardee());
+      }
+    }
+  }
+}
 
-    oop obj = elem->get_oop();
-    if (obj->is_forwarded()) {
-      elem->set_oop(obj->forwardee());
+PreservedMarks::Chunk* PreservedMarks::allocate_chunk() {
+  Chunk* chunk = _free_chunks;
+  if (chunk == NULL) {
+    return new Chunk();
+  }
+  _free_chunks = chunk->_next;
+  _num_free_chunks--;
+  chunk->_next = NULL;
+  assert(chunk->_top == 0, "cached chunk should be empty");
+  return chunk;
+}
+
+void PreservedMarks::release_chunks() {
+  Chunk* chunk = _chunks;
+  while (chunk != NULL) {
+    Chunk* next = chunk->_next;
+    if (_num_free_chunks < MaxCachedChunks) {
+      chunk->_top = 0;
+      chunk->_next = _free_chunks;
+      _free_chunks = chunk;
+      _num_free_chunks++;
+    } else {
+      delete chunk;
     }
+    chunk = next;
   }
+  _chunks = NULL;
+  _num_chunks = 0;
+  _size = 0;
 }
 
-void PreservedMarks::restore_and_increment(volatile size_t* const total_size_addr) {
-  const size_t stack_size = size();
-  restore();
-  // Only do the atomic add if the size is > 0.
-  if (stack_size > 0) {
-    Atomic::add(stack_size, total_size_addr);
+void PreservedMarks::free_cached_chunks() {
+  while (_free_chunks != NULL) {
+    Chunk* next = _free_chunks->_next;
+    delete _free_chunks;
+    _free_chunks = next;
   }
+  _num_free_chunks = 0;
+}
+
+PreservedMarks::~PreservedMarks() {
+  assert_empty();
+  free_cached_chunks();
 }
 
 #ifndef PRODUCT
 void PreservedMarks::assert_empty() {
-  assert(_stack.is_empty(), "stack expected to be empty, size = " SIZE_FORMAT,
-         _stack.size());
-  assert(_stack.cache_size() == 0,
-         "stack expected to have no cached segments, cache size = " SIZE_FORMAT,
-         _stack.cache_size());
+  assert(_chunks == NULL && _num_chunks == 0,
+         "expected to have no chunks in use, chunks = " SIZE_FORMAT, _num_chunks);
+  assert(_size == 0, "expected to be empty, size = " SIZE_FORMAT, _size);
 }
 #endif // ndef PRODUCT
 
@@ -91,32 +127,73 @@ void PreservedMarksSet::init(uint num) {
   assert_empty();
 }
 
+// Restores the preserved marks of all stacks in parallel. The unit of work
+// is a chunk rather than a whole stack, so that the restoration is balanced
+// even if most marks were preserved by a single worker.
 class ParRestoreTask : public AbstractGangTask {
 private:
-  PreservedMarksSet* const _preserved_marks_set;
-  SequentialSubTasksDone _sub_tasks;
+  PreservedMarks::Chunk** _chunks;
+  size_t _num_chunks;
+  volatile size_t _claimed;
   volatile size_t* const _total_size_addr;
 
 public:
   virtual void work(uint worker_id) {
-    uint task_id = 0;
-    while (_sub_tasks.try_claim_task(/* reference */ task_id)) {
-      _preserved_marks_set->get(task_id)->restore_and_increment(_total_size_addr);
+    size_t restored = 0;
+    for (;;) {
+      size_t i = Atomic::add((size_t)1, &_claimed) - 1;
+      if (i >= _num_chunks) {
+        break;
+      }
+      _chunks[i]->restore();
+      restored += _chunks[i]->_top;
+    }
+    // Only do the atomic add if the size is > 0.
+    if (restored > 0) {
+      Atomic::add(restored, _total_size_addr);
     }
-    _sub_tasks.all_tasks_completed();
   }
 
-  ParRestoreTask(uint worker_num,
-                 PreservedMarksSet* preserved_marks_set,
+  size_t num_chunks() const { return _num_chunks; }
+
+  ParRestoreTask(PreservedMarksSet* preserved_marks_set,
                  volatile size_t* total_size_addr)
       : AbstractGangTask("Parallel Preserved Mark Restoration"),
-        _preserved_marks_set(preserved_marks_set),
+        _chunks(NULL),
+        _num_chunks(0),
+        _claimed(0),
         _total_size_addr(total_size_addr) {
-    _sub_tasks.set_n_threads(worker_num);
-    _sub_tasks.set_n_tasks(preserved_marks_set->num());
+    for (uint i = 0; i < preserved_marks_set->num(); i += 1) {
+      _num_chunks += preserved_marks_set->get(i)->_num_chunks;
+    }
+    if (_num_chunks == 0) {
+      return;
+    }
+
+    _chunks = NEW_C_HEAP_ARRAY(PreservedMarks::Chunk*, _num_chunks, mtGC);
+    size_t n = 0;
+    for (uint i = 0; i < preserved_marks_set->num(); i += 1) {
+      PreservedMarks* pm = preserved_marks_set->get(i);
+      for (PreservedMarks::Chunk* chunk = pm->_chunks; chunk != NULL; chunk = chunk->_next) {
+        _chunks[n++] = chunk;
+      }
+    }
+    assert(n == _num_chunks, "must be");
+  }
+
+  ~ParRestoreTask() {
+    if (_chunks != NULL) {
+      FREE_C_HEAP_ARRAY(PreservedMarks::Chunk*, _chunks);
+    }
   }
 };
 
+void PreservedMarksSet::release_restored_chunks() {
+  for (uint i = 0; i < _num; i += 1) {
+    get(i)->release_chunks();
+  }
+}
+
 void PreservedMarksSet::reclaim() {
   assert_empty();
 
@@ -150,7 +227,10 @@ void SharedRestorePreservedMarksTaskExecutor::restore(PreservedMarksSet* preserv
       preserved_marks_set->get(i)->restore();
     }
   } else {
-    ParRestoreTask task(_workers->active_workers(), preserved_marks_set, total_size_addr);
-    _workers->run_task(&task);
+    ParRestoreTask task(preserved_marks_set, total_size_addr);
+    if (task.num_chunks() > 0) {
+      _workers->run_task(&task);
+    }
+    preserved_marks_set->release_restored_chunks();
   }
 }
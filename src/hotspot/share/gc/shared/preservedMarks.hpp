@@ -28,12 +28,17 @@
 #include "memory/allocation.hpp"
 #include "memory/padded.hpp"
 #include "oops/oop.hpp"
-#include "utilities/stack.hpp"
 
 class PreservedMarksSet;
 class WorkGang;
 
+// Preserved marks are kept in fixed size chunks. Chunks released by a
+// restore are kept for reuse by later GCs, up to a small limit, so that
+// repeated evacuation failures do not allocate and free the same memory
+// over and over again.
 class PreservedMarks {
+  friend class ParRestoreTask;
+  friend class PreservedMarksSet;
 private:
   class OopAndMarkWord {
   private:
@@ -41,37 +46,68 @@ private:
     markWord _m;
 
   public:
+    OopAndMarkWord() : _o(NULL), _m(markWord::zero()) { }
     OopAndMarkWord(oop obj, markWord m) : _o(obj), _m(m) { }
 
-    oop get_oop() { return _o; }
+    oop get_oop() const { return _o; }
     inline void set_mark() const;
     void set_oop(oop obj) { _o = obj; }
   };
-  typedef Stack<OopAndMarkWord, mtGC> OopAndMarkWordStack;
 
-  OopAndMarkWordStack _stack;
+  class Chunk : public CHeapObj<mtGC> {
+  public:
+    // 16K per chunk with 64 bit oops.
+    static const size_t Capacity = 1024;
+
+    Chunk* _next;
+    size_t _top;
+    OopAndMarkWord _data[Capacity];
+
+    Chunk() : _next(NULL), _top(0) { }
+
+    bool is_full() const { return _top == Capacity; }
+
+    // Restore the marks of all entries, prefetching objects ahead.
+    inline void restore() const;
+  };
+
+  // Maximum number of empty chunks kept for reuse.
+  static const size_t MaxCachedChunks = 8;
+
+  Chunk* _chunks;        // In-use chunks, the one being filled first.
+  Chunk* _free_chunks;   // Empty chunks kept for reuse.
+  size_t _num_chunks;
+  size_t _num_free_chunks;
+  size_t _size;
 
   inline bool should_preserve_mark(oop obj, markWord m) const;
 
+  Chunk* allocate_chunk();
+
+  // All in-use chunks have been restored: recycle them, keeping at most
+  // MaxCachedChunks for reuse and freeing the rest.
+  void release_chunks();
+
+  void free_cached_chunks();
+
 public:
-  size_t size() const { return _stack.size(); }
+  size_t size() const { return _size; }
   inline void push(oop obj, markWord m);
   inline void push_if_necessary(oop obj, markWord m);
-  // Iterate over the stack, restore all preserved marks, and
-  // reclaim the memory taken up by the stack segments.
+  // Iterate over the chunks, restore all preserved marks, and
+  // recycle the chunks.
   void restore();
-  // Iterate over the stack, adjust all preserved marks according
+  // Iterate over the chunks, adjust all preserved marks according
   // to their forwarding location stored in the mark.
   void adjust_during_full_gc();
 
-  void restore_and_increment(volatile size_t* const _total_size_addr);
   inline static void init_forwarded_mark(oop obj);
 
-  // Assert the stack is empty and has no cached segments.
+  // Assert there are no preserved marks.
   void assert_empty() PRODUCT_RETURN;
 
   inline PreservedMarks();
-  ~PreservedMarks() { assert_empty(); }
+  ~PreservedMarks();
 };
 
 class RemoveForwardedPointerClosure: public ObjectClosure {
@@ -126,16 +162,20 @@ public:
   // Allocate stack array.
   void init(uint num);
 
-  // Iterate over all stacks, restore all preserved marks, and reclaim
-  // the memory taken up by the stack segments.
-  // Supported executors: SharedRestorePreservedMarksTaskExecutor (Serial, CMS, G1),
-  // PSRestorePreservedMarksTaskExecutor (PS).
+  // Iterate over all stacks, restore all preserved marks, and recycle
+  // the chunks holding them.
+  // Supported executors: SharedRestorePreservedMarksTaskExecutor (Serial, CMS, G1, PS,
+  // Shenandoah). With a work gang the chunks of all stacks are restored in parallel,
+  // so a single large stack does not serialize the restoration.
   inline void restore(RestorePreservedMarksTaskExecutor* executor);
 
+  // Recycle the chunks of all stacks after they have been restored in parallel.
+  void release_restored_chunks();
+
   // Reclaim stack array.
   void reclaim();
 
-  // Assert all the stacks are empty and have no cached segments.
+  // Assert all the stacks are empty.
   void assert_empty() PRODUCT_RETURN;
 
   PreservedMarksSet(bool in_c_heap)
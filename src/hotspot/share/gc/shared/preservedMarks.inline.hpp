@@ -28,7 +28,7 @@
 #include "gc/shared/preservedMarks.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
-#include "utilities/stack.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 inline bool PreservedMarks::should_preserve_mark(oop obj, markWord m) const {
   return obj->mark_must_be_preserved_for_promotion_failure(m);
@@ -36,8 +36,14 @@ inline bool PreservedMarks::should_preserve_mark(oop obj, markWord m) const {
 
 inline void PreservedMarks::push(oop obj, markWord m) {
   assert(should_preserve_mark(obj, m), "pre-condition");
-  OopAndMarkWord elem(obj, m);
-  _stack.push(elem);
+  if (_chunks == NULL || _chunks->is_full()) {
+    Chunk* chunk = allocate_chunk();
+    chunk->_next = _chunks;
+    _chunks = chunk;
+    _num_chunks++;
+  }
+  _chunks->_data[_chunks->_top++] = OopAndMarkWord(obj, m);
+  _size++;
 }
 
 inline void PreservedMarks::push_if_necessary(oop obj, markWord m) {
@@ -72,15 +78,26 @@ inline void PreservedMarksSet::restore(RestorePreservedMarksTaskExecutor* execut
 }
 
 inline PreservedMarks::PreservedMarks()
-    : _stack(OopAndMarkWordStack::default_segment_size(),
-             // This stack should be used very infrequently so there's
-             // no point in caching stack segments (there will be a
-             // waste of space most of the time). So we set the max
-             // cache size to 0.
-             0 /* max_cache_size */) { }
+    : _chunks(NULL),
+      _free_chunks(NULL),
+      _num_chunks(0),
+      _num_free_chunks(0),
+      _size(0) { }
 
 void PreservedMarks::OopAndMarkWord::set_mark() const {
   _o->set_mark_raw(_m);
 }
 
+void PreservedMarks::Chunk::restore() const {
+  // The objects are spread over the heap, start loading their
+  // headers a few entries ahead of the stores.
+  const size_t prefetch_distance = 8;
+  for (size_t i = 0; i < _top; i++) {
+    if (i + prefetch_distance < _top) {
+      Prefetch::write(_data[i + prefetch_distance].get_oop()->mark_addr_raw(), 0);
+    }
+    _data[i].set_mark();
+  }
+}
+
 #endif // SHARE_GC_SHARED_PRESERVEDMARKS_INLINE_HPP
@@ -663,19 +663,27 @@ bool ReferenceProcessor::need_balance_queues(DiscoveredList refs_lists[]) {
   // that must be redistributed to lists in that range.  Even if not
   // needed for that, balancing may be desirable to eliminate poor
   // distribution of references among the lists.
-  if (ParallelRefProcBalancingEnabled) {
-    return true;                // Configuration says do it.
-  } else {
-    // Configuration says don't balance, but if there are non-empty
-    // lists beyond the processing degree, then must ignore the
-    // configuration and balance anyway.
-    for (uint i = _num_queues; i < _max_num_queues; ++i) {
-      if (!refs_lists[i].is_empty()) {
-        return true;            // Must balance despite configuration.
-      }
+  //
+  // If there are non-empty lists beyond the processing degree, then must
+  // balance regardless of the configuration.
+  for (uint i = _num_queues; i < _max_num_queues; ++i) {
+    if (!refs_lists[i].is_empty()) {
+      return true;              // Must balance despite configuration.
     }
+  }
+  if (!ParallelRefProcBalancingEnabled) {
     return false;               // Safe to obey configuration and not balance.
   }
+  // Configuration says do it, but only bother if the lists are skewed,
+  // i.e. the longest list is more than twice as long as needed.
+  size_t total_refs = 0;
+  size_t max_refs = 0;
+  for (uint i = 0; i < _num_queues; ++i) {
+    total_refs += refs_lists[i].length();
+    max_refs = MAX2(max_refs, refs_lists[i].length());
+  }
+  const size_t avg_refs = (total_refs + _num_queues - 1) / _num_queues;
+  return max_refs > 2 * avg_refs;
 }
 
 void ReferenceProcessor::maybe_balance_queues(DiscoveredList refs_lists[]) {
@@ -790,7 +798,7 @@ void ReferenceProcessor::process_soft_ref_reconsider(BoolObjectClosure* is_alive
     return;
   }
 
-  RefProcMTDegreeAdjuster a(this, RefPhase1, num_soft_refs);
+  RefProcMTDegreeAdjuster a(this, RefPhase1, num_soft_refs, phase_times);
 
   if (_processing_is_mt) {
     RefProcBalanceQueuesTimeTracker tt(RefPhase1, phase_times);
@@ -838,7 +846,7 @@ void ReferenceProcessor::process_soft_weak_final_refs(BoolObjectClosure* is_aliv
     return;
   }
 
-  RefProcMTDegreeAdjuster a(this, RefPhase2, num_total_refs);
+  RefProcMTDegreeAdjuster a(this, RefPhase2, num_total_refs, phase_times);
 
   if (_processing_is_mt) {
     RefProcBalanceQueuesTimeTracker tt(RefPhase2, phase_times);
@@ -909,7 +917,7 @@ void ReferenceProcessor::process_final_keep_alive(OopClosure* keep_alive,
     return;
   }
 
-  RefProcMTDegreeAdjuster a(this, RefPhase3, num_final_refs);
+  RefProcMTDegreeAdjuster a(this, RefPhase3, num_final_refs, phase_times);
 
   if (_processing_is_mt) {
     RefProcBalanceQueuesTimeTracker tt(RefPhase3, phase_times);
@@ -949,7 +957,7 @@ void ReferenceProcessor::process_phantom_refs(BoolObjectClosure* is_alive,
     return;
   }
 
-  RefProcMTDegreeAdjuster a(this, RefPhase4, num_phantom_refs);
+  RefProcMTDegreeAdjuster a(this, RefPhase4, num_phantom_refs, phase_times);
 
   if (_processing_is_mt) {
     RefProcBalanceQueuesTimeTracker tt(RefPhase4, phase_times);
@@ -1368,18 +1376,22 @@ bool RefProcMTDegreeAdjuster::use_max_threads(RefProcPhases phase) const {
 
 RefProcMTDegreeAdjuster::RefProcMTDegreeAdjuster(ReferenceProcessor* rp,
                                                  RefProcPhases phase,
-                                                 size_t ref_count):
+                                                 size_t ref_count,
+                                                 ReferenceProcessorPhaseTimes* phase_times):
     _rp(rp),
     _saved_mt_processing(_rp->processing_is_mt()),
     _saved_num_queues(_rp->num_queues()) {
-  if (!_rp->processing_is_mt() || !_rp->adjust_no_of_processing_threads() || (ReferencesPerThread == 0)) {
-    return;
-  }
+  if (_rp->processing_is_mt() && _rp->adjust_no_of_processing_threads() && (ReferencesPerThread != 0)) {
+    uint workers = ergo_proc_thread_count(ref_count, _rp->num_queues(), phase);
 
-  uint workers = ergo_proc_thread_count(ref_count, _rp->num_queues(), phase);
+    _rp->set_mt_processing(workers > 1);
+    _rp->set_active_mt_degree(workers);
+  }
 
-  _rp->set_mt_processing(workers > 1);
-  _rp->set_active_mt_degree(workers);
+  uint const used_workers = _rp->processing_is_mt() ? _rp->num_queues() : 1;
+  phase_times->set_phase_num_workers(phase, used_workers);
+  log_debug(gc, ref)("Phase%u of Reference Processing: " SIZE_FORMAT " references, %u workers",
+                     (uint)phase + 1, ref_count, used_workers);
 }
 
 RefProcMTDegreeAdjuster::~RefProcMTDegreeAdjuster() {
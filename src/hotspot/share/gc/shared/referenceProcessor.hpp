@@ -691,7 +691,8 @@ class RefProcMTDegreeAdjuster : public StackObj {
 public:
   RefProcMTDegreeAdjuster(ReferenceProcessor* rp,
                           RefProcPhases phase,
-                          size_t ref_count);
+                          size_t ref_count,
+                          ReferenceProcessorPhaseTimes* phase_times);
   ~RefProcMTDegreeAdjuster();
 };
 
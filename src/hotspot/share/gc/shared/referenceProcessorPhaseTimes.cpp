@@ -212,6 +212,7 @@ void ReferenceProcessorPhaseTimes::reset() {
   for (int i = 0; i < ReferenceProcessor::RefPhaseMax; i++) {
     _phases_time_ms[i] = uninitialized();
     _balance_queues_time_ms[i] = uninitialized();
+    _phase_num_workers[i] = 0;
   }
 
   _phase2_worker_time_sec->reset();
@@ -264,6 +265,16 @@ void ReferenceProcessorPhaseTimes::set_balance_queues_time_ms(ReferenceProcessor
   _balance_queues_time_ms[phase] = time_ms;
 }
 
+uint ReferenceProcessorPhaseTimes::phase_num_workers(ReferenceProcessor::RefProcPhases phase) const {
+  ASSERT_PHASE(phase);
+  return _phase_num_workers[phase];
+}
+
+void ReferenceProcessorPhaseTimes::set_phase_num_workers(ReferenceProcessor::RefProcPhases phase, uint num_workers) {
+  ASSERT_PHASE(phase);
+  _phase_num_workers[phase] = num_workers;
+}
+
 #define TIME_FORMAT "%.1lfms"
 
 void ReferenceProcessorPhaseTimes::print_all_references(uint base_indent, bool print_total) const {
@@ -327,6 +338,9 @@ void ReferenceProcessorPhaseTimes::print_phase(ReferenceProcessor::RefProcPhases
   if (lt2.is_enabled()) {
     LogStream ls(lt2);
 
+    if (phase_num_workers(phase) != 0) {
+      ls.print_cr("%s%s %u", Indents[indent + 1], "Workers:", phase_num_workers(phase));
+    }
     if (_processing_is_mt) {
       print_balance_time(&ls, phase, indent + 1);
     }
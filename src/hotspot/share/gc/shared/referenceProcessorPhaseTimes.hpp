@@ -48,6 +48,8 @@ class ReferenceProcessorPhaseTimes : public CHeapObj<mtGC> {
   double                   _phases_time_ms[ReferenceProcessor::RefPhaseMax];
   // Records total queue balancing for each phase.
   double                   _balance_queues_time_ms[ReferenceProcessor::RefPhaseMax];
+  // Records the number of workers chosen for each phase, 0 if skipped.
+  uint                     _phase_num_workers[ReferenceProcessor::RefPhaseMax];
 
   WorkerDataArray<double>* _phase2_worker_time_sec;
 
@@ -93,6 +95,9 @@ public:
 
   void set_balance_queues_time_ms(ReferenceProcessor::RefProcPhases phase, double time_ms);
 
+  uint phase_num_workers(ReferenceProcessor::RefProcPhases phase) const;
+  void set_phase_num_workers(ReferenceProcessor::RefProcPhases phase, uint num_workers);
+
   void set_processing_is_mt(bool processing_is_mt) { _processing_is_mt = processing_is_mt; }
 
   GCTimer* gc_timer() const { return _gc_timer; }
@@ -36,6 +36,7 @@
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
 
 //
@@ -212,6 +213,7 @@ const double             StringDedupTable::_shrink_load_factor = _grow_load_fact
 const double             StringDedupTable::_max_cache_factor = 0.1; // Cache a maximum of 10% of the table size
 const uintx              StringDedupTable::_rehash_multiple = 60;   // Hash bucket has 60 times more collisions than expected
 const uintx              StringDedupTable::_rehash_threshold = (uintx)(_rehash_multiple * _grow_load_factor);
+const size_t             StringDedupTable::_resize_step_size = 256; // Buckets migrated per resize step
 
 uintx                    StringDedupTable::_entries_added = 0;
 uintx                    StringDedupTable::_entries_removed = 0;
@@ -220,7 +222,9 @@ uintx                    StringDedupTable::_rehash_count = 0;
 
 StringDedupTable*        StringDedupTable::_resized_table = NULL;
 StringDedupTable*        StringDedupTable::_rehashed_table = NULL;
+size_t                   StringDedupTable::_resize_index = 0;
 volatile size_t          StringDedupTable::_claimed_index = 0;
+volatile size_t          StringDedupTable::_claimed_resized_index = 0;
 
 StringDedupTable::StringDedupTable(size_t size, jint hash_seed) :
   _size(size),
@@ -251,7 +255,10 @@ void StringDedupTable::add(typeArrayOop value, bool latin1, unsigned int hash, S
   entry->set_latin1(latin1);
   entry->set_next(*list);
   *list = entry;
-  _entries++;
+
+  // The entry count is kept in the currently active table,
+  // even when the entry is added to the resized table.
+  _table->_entries++;
 }
 
 void StringDedupTable::remove(StringDedupEntry** pentry, uint worker_id) {
@@ -298,7 +305,7 @@ typeArrayOop StringDedupTable::lookup_or_add_inner(typeArrayOop value, bool lati
 
   // Check if rehash is needed
   if (count > _rehash_threshold) {
-    _rehash_needed = true;
+    _table->_rehash_needed = true;
   }
 
   if (existing_value == NULL) {
@@ -424,13 +431,73 @@ StringDedupTable* StringDedupTable::prepare_resize() {
   // Update max cache size
   _entry_cache->set_max_size(size * _max_cache_factor);
 
-  // Allocate the new table. The new table will be populated by workers
-  // calling unlink_or_oops_do() and finally installed by finish_resize().
+  // Allocate the new table. The new table will be populated by resize_step()
+  // and finally installed by finish_resize().
   return new StringDedupTable(size, _table->_hash_seed);
 }
 
+void StringDedupTable::start_resize() {
+  assert(Thread::current()->is_ConcurrentGC_thread(), "Must be the deduplication thread");
+  assert(!SafepointSynchronize::is_at_safepoint(), "Must not be at a safepoint");
+
+  if (is_resizing() || is_rehashing()) {
+    // Already in progress
+    return;
+  }
+
+  // The current table can only be replaced by this thread or at a
+  // safepoint, so the new table can be allocated and cleared without
+  // holding the lock.
+  StringDedupTable* resized_table = prepare_resize();
+  if (resized_table == NULL) {
+    // Resize not needed
+    return;
+  }
+
+  MutexLocker ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+  _resize_index = 0;
+  _resized_table = resized_table;
+
+  log_debug(gc, stringdedup)("Resizing table from " SIZE_FORMAT " to " SIZE_FORMAT,
+                             _table->_size, _resized_table->_size);
+}
+
+bool StringDedupTable::resize_step() {
+  assert(!SafepointSynchronize::is_at_safepoint(), "Must not be at a safepoint");
+
+  if (!is_resizing()) {
+    // Only this thread starts and completes resizing, no need for the lock
+    return false;
+  }
+
+  MutexLocker ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+
+  // Migrate the next range of buckets. An entry in the current table always
+  // hashes to a single bucket, so once a bucket has been moved all lookups
+  // for hash codes mapping to it are directed to the resized table.
+  size_t end = MIN2(_resize_index + _resize_step_size, _table->_size);
+  for (size_t bucket = _resize_index; bucket < end; bucket++) {
+    StringDedupEntry** entry = _table->bucket(bucket);
+    while (*entry != NULL) {
+      _table->transfer(entry, _resized_table);
+    }
+  }
+  _resize_index = end;
+
+  if (_resize_index < _table->_size) {
+    // More to do
+    return true;
+  }
+
+  StringDedupTable::finish_resize(_resized_table);
+  _resized_table = NULL;
+  _resize_index = 0;
+  return false;
+}
+
 void StringDedupTable::finish_resize(StringDedupTable* resized_table) {
   assert(resized_table != NULL, "Invalid table");
+  assert(_resize_index == _table->_size, "All buckets must have been migrated");
 
   resized_table->_entries = _table->_entries;
 
@@ -444,79 +511,79 @@ void StringDedupTable::finish_resize(StringDedupTable* resized_table) {
 void StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl, uint worker_id) {
   // The table is divided into partitions to allow lock-less parallel processing by
   // multiple worker threads. A worker thread first claims a partition, which ensures
-  // exclusive access to that part of the table, then continues to process it. To allow
-  // shrinking of the table in parallel we also need to make sure that the same worker
-  // thread processes all partitions where entries will hash to the same destination
-  // partition. Since the table size is always a power of two and we always shrink by
-  // dividing the table in half, we know that for a given partition there is only one
-  // other partition whoes entries will hash to the same destination partition. That
-  // other partition is always the sibling partition in the second half of the table.
-  // For example, if the table is divided into 8 partitions, the sibling of partition 0
-  // is partition 4, the sibling of partition 1 is partition 5, etc.
-  size_t table_half = _table->_size / 2;
+  // exclusive access to that part of the table, then continues to process it. Entries
+  // are never moved between partitions here, except for rehashing which is completed
+  // single threaded by finish_rehash(). If a resize is in progress, the partitions of
+  // the resized table are claimed and processed in the same way after those of the
+  // current table.
+  uintx removed = unlink_or_oops_do(cl, _table, &_claimed_index, worker_id);
+  if (is_resizing()) {
+    removed += unlink_or_oops_do(cl, _resized_table, &_claimed_resized_index, worker_id);
+  }
+
+  // Delayed update to avoid contention on the table lock
+  if (removed > 0) {
+    MutexLocker ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+    _table->_entries -= removed;
+    _entries_removed += removed;
+  }
+}
 
+uintx StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
+                                          StringDedupTable* table,
+                                          volatile size_t* claimed_index,
+                                          uint worker_id) {
   // Let each partition be one page worth of buckets
-  size_t partition_size = MIN2(table_half, os::vm_page_size() / sizeof(StringDedupEntry*));
-  assert(table_half % partition_size == 0, "Invalid partition size");
+  size_t partition_size = MIN2(table->_size, os::vm_page_size() / sizeof(StringDedupEntry*));
+  assert(table->_size % partition_size == 0, "Invalid partition size");
 
   // Number of entries removed during the scan
   uintx removed = 0;
 
   for (;;) {
     // Grab next partition to scan
-    size_t partition_begin = claim_table_partition(partition_size);
+    size_t partition_begin = claim_table_partition(claimed_index, partition_size);
     size_t partition_end = partition_begin + partition_size;
-    if (partition_begin >= table_half) {
+    if (partition_begin >= table->_size) {
       // End of table
       break;
     }
 
-    // Scan the partition followed by the sibling partition in the second half of the table
-    removed += unlink_or_oops_do(cl, partition_begin, partition_end, worker_id);
-    removed += unlink_or_oops_do(cl, table_half + partition_begin, table_half + partition_end, worker_id);
+    removed += unlink_or_oops_do(cl, table, partition_begin, partition_end, worker_id);
   }
 
-  // Delayed update to avoid contention on the table lock
-  if (removed > 0) {
-    MutexLocker ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
-    _table->_entries -= removed;
-    _entries_removed += removed;
-  }
+  return removed;
 }
 
 uintx StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
+                                          StringDedupTable* table,
                                           size_t partition_begin,
                                           size_t partition_end,
                                           uint worker_id) {
   uintx removed = 0;
   for (size_t bucket = partition_begin; bucket < partition_end; bucket++) {
-    StringDedupEntry** entry = _table->bucket(bucket);
+    StringDedupEntry** entry = table->bucket(bucket);
     while (*entry != NULL) {
       oop* p = (oop*)(*entry)->obj_addr();
       if (cl->is_alive(*p)) {
         cl->keep_alive(p);
-        if (is_resizing()) {
-          // We are resizing the table, transfer entry to the new table
-          _table->transfer(entry, _resized_table);
-        } else {
-          if (is_rehashing()) {
-            // We are rehashing the table, rehash the entry but keep it
-            // in the table. We can't transfer entries into the new table
-            // at this point since we don't have exclusive access to all
-            // destination partitions. finish_rehash() will do a single
-            // threaded transfer of all entries.
-            typeArrayOop value = (typeArrayOop)*p;
-            bool latin1 = (*entry)->latin1();
-            unsigned int hash = hash_code(value, latin1);
-            (*entry)->set_hash(hash);
-          }
-
-          // Move to next entry
-          entry = (*entry)->next_addr();
+        if (is_rehashing()) {
+          // We are rehashing the table, rehash the entry but keep it
+          // in the table. We can't transfer entries into the new table
+          // at this point since we don't have exclusive access to all
+          // destination partitions. finish_rehash() will do a single
+          // threaded transfer of all entries.
+          typeArrayOop value = (typeArrayOop)*p;
+          bool latin1 = (*entry)->latin1();
+          unsigned int hash = hash_code(value, latin1);
+          (*entry)->set_hash(hash);
         }
+
+        // Move to next entry
+        entry = (*entry)->next_addr();
       } else {
         // Not alive, remove entry from table
-        _table->remove(entry, worker_id);
+        table->remove(entry, worker_id);
         removed++;
       }
     }
@@ -526,27 +593,23 @@ uintx StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
 }
 
 void StringDedupTable::gc_prologue(bool resize_and_rehash_table) {
-  assert(!is_resizing() && !is_rehashing(), "Already in progress?");
+  assert(!is_rehashing(), "Already in progress?");
 
   _claimed_index = 0;
-  if (resize_and_rehash_table) {
-    // If both resize and rehash is needed, only do resize. Rehash of
-    // the table will eventually happen if the situation persists.
-    _resized_table = StringDedupTable::prepare_resize();
-    if (!is_resizing()) {
-      _rehashed_table = StringDedupTable::prepare_rehash();
-    }
+  _claimed_resized_index = 0;
+  if (resize_and_rehash_table && !is_resizing()) {
+    // Resizing is done incrementally by the deduplication thread. If a
+    // resize is in progress, rehashing is postponed. Rehash of the table
+    // will eventually happen if the situation persists.
+    _rehashed_table = StringDedupTable::prepare_rehash();
   }
 }
 
 void StringDedupTable::gc_epilogue() {
   assert(!is_resizing() || !is_rehashing(), "Can not both resize and rehash");
-  assert(_claimed_index >= _table->_size / 2 || _claimed_index == 0, "All or nothing");
+  assert(_claimed_index >= _table->_size || _claimed_index == 0, "All or nothing");
 
-  if (is_resizing()) {
-    StringDedupTable::finish_resize(_resized_table);
-    _resized_table = NULL;
-  } else if (is_rehashing()) {
+  if (is_rehashing()) {
     StringDedupTable::finish_rehash(_rehashed_table);
     _rehashed_table = NULL;
   }
@@ -570,6 +633,7 @@ StringDedupTable* StringDedupTable::prepare_rehash() {
 
 void StringDedupTable::finish_rehash(StringDedupTable* rehashed_table) {
   assert(rehashed_table != NULL, "Invalid table");
+  assert(!is_resizing(), "Can not both resize and rehash");
 
   // Move all newly rehashed entries into the correct buckets in the new table
   for (size_t bucket = 0; bucket < _table->_size; bucket++) {
@@ -588,14 +652,21 @@ void StringDedupTable::finish_rehash(StringDedupTable* rehashed_table) {
   _table = rehashed_table;
 }
 
-size_t StringDedupTable::claim_table_partition(size_t partition_size) {
-  return Atomic::add(partition_size, &_claimed_index) - partition_size;
+size_t StringDedupTable::claim_table_partition(volatile size_t* claimed_index, size_t partition_size) {
+  return Atomic::add(partition_size, claimed_index) - partition_size;
 }
 
 void StringDedupTable::verify() {
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
+  verify(_table);
+  if (is_resizing()) {
+    verify(_resized_table);
+  }
+}
+
+void StringDedupTable::verify(StringDedupTable* table) {
+  for (size_t bucket = 0; bucket < table->_size; bucket++) {
     // Verify entries
-    StringDedupEntry** entry = _table->bucket(bucket);
+    StringDedupEntry** entry = table->bucket(bucket);
     while (*entry != NULL) {
       typeArrayOop value = (*entry)->obj();
       guarantee(value != NULL, "Object must not be NULL");
@@ -605,7 +676,8 @@ void StringDedupTable::verify() {
       bool latin1 = (*entry)->latin1();
       unsigned int hash = hash_code(value, latin1);
       guarantee((*entry)->hash() == hash, "Table entry has inorrect hash");
-      guarantee(_table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
+      guarantee(table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
+      guarantee(table_for_hash(hash) == table, "Table entry has not been migrated");
       entry = (*entry)->next_addr();
     }
 
@@ -613,7 +685,7 @@ void StringDedupTable::verify() {
     // We only need to compare entries in the same bucket. If the same oop or an
     // identical array has been inserted more than once into different/incorrect
     // buckets the verification step above will catch that.
-    StringDedupEntry** entry1 = _table->bucket(bucket);
+    StringDedupEntry** entry1 = table->bucket(bucket);
     while (*entry1 != NULL) {
       typeArrayOop value1 = (*entry1)->obj();
       bool latin1_1 = (*entry1)->latin1();
@@ -635,14 +707,19 @@ void StringDedupTable::clean_entry_cache() {
 
 void StringDedupTable::print_statistics() {
   Log(gc, stringdedup) log;
+  size_t buckets = _table->_size + (is_resizing() ? _resized_table->_size : 0);
   log.debug("  Table");
   log.debug("    Memory Usage: " STRDEDUP_BYTES_FORMAT_NS,
-            STRDEDUP_BYTES_PARAM(_table->_size * sizeof(StringDedupEntry*) + (_table->_entries + _entry_cache->size()) * sizeof(StringDedupEntry)));
+            STRDEDUP_BYTES_PARAM(buckets * sizeof(StringDedupEntry*) + (_table->_entries + _entry_cache->size()) * sizeof(StringDedupEntry)));
   log.debug("    Size: " SIZE_FORMAT ", Min: " SIZE_FORMAT ", Max: " SIZE_FORMAT, _table->_size, _min_size, _max_size);
   log.debug("    Entries: " UINTX_FORMAT ", Load: " STRDEDUP_PERCENT_FORMAT_NS ", Cached: " UINTX_FORMAT ", Added: " UINTX_FORMAT ", Removed: " UINTX_FORMAT,
             _table->_entries, percent_of((size_t)_table->_entries, _table->_size), _entry_cache->size(), _entries_added, _entries_removed);
   log.debug("    Resize Count: " UINTX_FORMAT ", Shrink Threshold: " UINTX_FORMAT "(" STRDEDUP_PERCENT_FORMAT_NS "), Grow Threshold: " UINTX_FORMAT "(" STRDEDUP_PERCENT_FORMAT_NS ")",
             _resize_count, _table->_shrink_threshold, _shrink_load_factor * 100.0, _table->_grow_threshold, _grow_load_factor * 100.0);
+  if (is_resizing()) {
+    log.debug("    Resizing: " SIZE_FORMAT " -> " SIZE_FORMAT ", Migrated: " SIZE_FORMAT " buckets",
+              _table->_size, _resized_table->_size, _resize_index);
+  }
   log.debug("    Rehash Count: " UINTX_FORMAT ", Rehash Threshold: " UINTX_FORMAT ", Hash Seed: 0x%x", _rehash_count, _rehash_threshold, _table->_hash_seed);
   log.debug("    Age Threshold: " UINTX_FORMAT, StringDeduplicationAgeThreshold);
 }
@@ -101,6 +101,11 @@ public:
 // The table is dynamically resized to accommodate the current number of table entries.
 // The table has hash buckets with chains for hash collision. If the average chain
 // length goes above or below given thresholds the table grows or shrinks accordingly.
+// Resizing is done incrementally by the deduplication thread outside of safepoints.
+// While a resize is in progress, the buckets of the current table below _resize_index
+// have been migrated to the resized table, and lookups of hash codes mapping to those
+// buckets are directed to the resized table. The resized table is installed as the
+// current table once all buckets have been migrated.
 //
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
 // unbalanced, i.e., a hash chain is significantly longer than average.
@@ -109,7 +114,9 @@ public:
 // safepoints in which case GC workers are allowed to access a table partitions they
 // have claimed without first acquiring the lock. Note however, that this applies only
 // the table partition (i.e. a range of elements in _buckets), not other parts of the
-// table such as the _entries field, statistics counters, etc.
+// table such as the _entries field, statistics counters, etc. While a resize is in
+// progress, GC workers process the partitions of both the current and the resized
+// table, but never move entries between them.
 //
 class StringDedupTable : public CHeapObj<mtGC> {
 private:
@@ -142,6 +149,9 @@ private:
   static const uintx              _rehash_threshold;
   static const double             _max_cache_factor;
 
+  // Number of buckets migrated per incremental resize step.
+  static const size_t             _resize_step_size;
+
   // Table statistics, only used for logging.
   static uintx                    _entries_added;
   static uintx                    _entries_removed;
@@ -149,8 +159,10 @@ private:
   static uintx                    _rehash_count;
 
   static volatile size_t          _claimed_index;
+  static volatile size_t          _claimed_resized_index;
 
   static StringDedupTable*        _resized_table;
+  static size_t                   _resize_index;
   static StringDedupTable*        _rehashed_table;
 
   StringDedupTable(size_t size, jint hash_seed = 0);
@@ -184,13 +196,22 @@ private:
   // table entry if no matching character array exists.
   typeArrayOop lookup_or_add_inner(typeArrayOop value, bool latin1, unsigned int hash);
 
+  // Returns the table holding entries with the given hash code. This is the
+  // resized table if the bucket for the hash code has already been migrated.
+  static StringDedupTable* table_for_hash(unsigned int hash) {
+    if (is_resizing() && _table->hash_to_index(hash) < _resize_index) {
+      return _resized_table;
+    }
+    return _table;
+  }
+
   // Thread safe lookup or add of table entry
   static typeArrayOop lookup_or_add(typeArrayOop value, bool latin1, unsigned int hash) {
     // Protect the table from concurrent access. Also note that this lock
     // acts as a fence for _table, which could have been replaced by a new
     // instance if the table was resized or rehashed.
     MutexLocker ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
-    return _table->lookup_or_add_inner(value, latin1, hash);
+    return table_for_hash(hash)->lookup_or_add_inner(value, latin1, hash);
   }
 
   // Returns true if the hashtable is currently using a Java compatible
@@ -204,11 +225,17 @@ private:
   static unsigned int hash_code(typeArrayOop value, bool latin1);
 
   static uintx unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
+                                 StringDedupTable* table,
+                                 volatile size_t* claimed_index,
+                                 uint worker_id);
+
+  static uintx unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl,
+                                 StringDedupTable* table,
                                  size_t partition_begin,
                                  size_t partition_end,
                                  uint worker_id);
 
-  static size_t claim_table_partition(size_t partition_size);
+  static size_t claim_table_partition(volatile size_t* claimed_index, size_t partition_size);
 
   static bool is_resizing();
   static bool is_rehashing();
@@ -218,7 +245,8 @@ private:
   static StringDedupTable* prepare_resize();
 
   // Installs a newly resized table as the currently active table
-  // and deletes the previously active table.
+  // and deletes the previously active table. All entries must have
+  // been migrated to the resized table.
   static void finish_resize(StringDedupTable* resized_table);
 
   // If a table rehash is needed, returns a newly allocated empty
@@ -230,6 +258,8 @@ private:
   // and deletes the previously active table.
   static void finish_rehash(StringDedupTable* rehashed_table);
 
+  static void verify(StringDedupTable* table);
+
 public:
   static void create();
 
@@ -245,6 +275,13 @@ public:
   // If the table entry cache has grown too large, delete overflowed entries.
   static void clean_entry_cache();
 
+  // Incremental resize support, only called by the deduplication thread
+  // while joined to the suspendible thread set. start_resize() begins a
+  // resize if one is needed, and resize_step() migrates the next range of
+  // buckets, returning true if the resize is still in progress.
+  static void start_resize();
+  static bool resize_step();
+
   // GC support
   static void gc_prologue(bool resize_and_rehash_table);
   static void gc_epilogue();
@@ -58,6 +58,10 @@ void StringDedupThreadImpl<S>::do_deduplication() {
       stat.mark_exec();
       StringDedupStat::print_start(&stat);
 
+      // Start a table resize if needed. The resize is done
+      // incrementally while processing the queue.
+      StringDedupTable::start_resize();
+
       // Process the queue
       for (;;) {
         oop java_string = StringDedupQueue::pop();
@@ -67,6 +71,9 @@ void StringDedupThreadImpl<S>::do_deduplication() {
 
         StringDedupTable::deduplicate(java_string, &stat);
 
+        // Migrate part of the table if a resize is in progress
+        StringDedupTable::resize_step();
+
         // Safepoint this thread if needed
         if (sts_join.should_yield()) {
           stat.mark_block();
@@ -75,6 +82,15 @@ void StringDedupThreadImpl<S>::do_deduplication() {
         }
       }
 
+      // Complete any resize in progress now that the queue is empty
+      while (StringDedupTable::resize_step()) {
+        if (sts_join.should_yield()) {
+          stat.mark_block();
+          sts_join.yield();
+          stat.mark_unblock();
+        }
+      }
+
       stat.mark_done();
 
       total_stat.add(&stat);
@@ -41,7 +41,8 @@ uint ParallelTaskTerminator::_total_peeks = 0;
 
 #if TASKQUEUE_STATS
 const char * const TaskQueueStats::_names[last_stat_id] = {
-  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "opush", "omax"
+  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "qsteal-b", "qsteal-l",
+  "opush", "omax"
 };
 
 TaskQueueStats & TaskQueueStats::operator +=(const TaskQueueStats & addend)
@@ -93,15 +94,20 @@ void TaskQueueStats::print(outputStream* stream, unsigned int width) const
 // quiescent; they do not hold at arbitrary times.
 void TaskQueueStats::verify() const
 {
-  assert(get(push) == get(pop) + get(steal),
-         "push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT,
-         get(push), get(pop), get(steal));
+  // Tasks moved by batched steals have been pushed again onto the queue of
+  // the stealing worker.
+  assert(get(push) == get(pop) + get(steal) + get(steal_batch),
+         "push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT " steal_batch=" SIZE_FORMAT,
+         get(push), get(pop), get(steal), get(steal_batch));
   assert(get(pop_slow) <= get(pop),
          "pop_slow=" SIZE_FORMAT " pop=" SIZE_FORMAT,
          get(pop_slow), get(pop));
   assert(get(steal) <= get(steal_attempt),
          "steal=" SIZE_FORMAT " steal_attempt=" SIZE_FORMAT,
          get(steal), get(steal_attempt));
+  assert(get(steal_local) <= get(steal),
+         "steal_local=" SIZE_FORMAT " steal=" SIZE_FORMAT,
+         get(steal_local), get(steal));
   assert(get(overflow) == 0 || get(push) != 0,
          "overflow=" SIZE_FORMAT " push=" SIZE_FORMAT,
          get(overflow), get(push));
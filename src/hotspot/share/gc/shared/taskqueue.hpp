@@ -54,6 +54,8 @@ public:
     pop_slow,         // subset of taskqueue pops that were done slow-path
     steal_attempt,    // number of taskqueue steal attempts
     steal,            // number of taskqueue steals
+    steal_batch,      // number of additional tasks moved by batched steals
+    steal_local,      // subset of taskqueue steals from the same NUMA node
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -67,6 +69,8 @@ public:
   inline void record_pop_slow()      { record_pop(); ++_stats[pop_slow]; }
   inline void record_steal_attempt() { ++_stats[steal_attempt]; }
   inline void record_steal()         { ++_stats[steal]; }
+  inline void record_steal_batch(size_t n) { _stats[steal_batch] += n; }
+  inline void record_steal_local()   { ++_stats[steal_local]; }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -303,7 +307,12 @@ private:
   // Element array.
   volatile E* _elems;
 
-  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*));
+  // The NUMA node of the queue owner, used for victim selection.  Written
+  // only by the owner, and rarely, but read by other threads.
+  static const uint InvalidNUMAId = uint(-1);
+  volatile uint _numa_id;
+
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(E*) + sizeof(uint));
   // Queue owner local variables. Not to be accessed by other threads.
 
   static const uint InvalidQueueId = uint(-1);
@@ -319,10 +328,16 @@ public:
   uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
   bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != InvalidQueueId; }
   void invalidate_last_stolen_queue_id()     { _last_stolen_queue_id = InvalidQueueId; }
+
+  // Refresh the NUMA node of the queue owner.  Must only be called by the owner.
+  inline void update_numa_id();
+  uint numa_id() const                       { return _numa_id; }
+  bool is_numa_id_valid() const              { return _numa_id != InvalidNUMAId; }
 };
 
 template<class E, MEMFLAGS F, unsigned int N>
-GenericTaskQueue<E, F, N>::GenericTaskQueue() : _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
+GenericTaskQueue<E, F, N>::GenericTaskQueue() :
+  _numa_id(InvalidNUMAId), _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
   assert(sizeof(Age) == sizeof(size_t), "Depends on this.");
 }
 
@@ -386,7 +401,13 @@ private:
   uint _n;
   T** _queues;
 
-  bool steal_best_of_2(uint queue_num, E& t);
+  // Picks a random queue other than queue_num and excluded.  If numa_local,
+  // queues on the same NUMA node as queue_num are preferred.
+  uint random_victim(uint queue_num, uint excluded, bool numa_local);
+  // Pops a task from the victim queue and, with batched stealing, moves
+  // further tasks from it to the queue of queue_num.
+  bool steal_from(uint queue_num, uint victim, uint victim_size, E& t);
+  bool steal_best_of_2(uint queue_num, E& t, bool numa_local);
 
 public:
   GenericTaskQueueSet(uint n);
@@ -398,6 +419,8 @@ public:
 
   // Try to steal a task from some other queue than queue_num. It may perform several attempts at doing so.
   // Returns if stealing succeeds, and sets "t" to the stolen task.
+  // Must only be called by the owner of queue_num, as batched stealing
+  // (WorkStealingBatchSize) pushes additional stolen tasks onto that queue.
   bool steal(uint queue_num, E& t);
 
   bool peek();
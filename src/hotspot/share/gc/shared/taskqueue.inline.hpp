@@ -29,7 +29,9 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/stack.inline.hpp"
 
@@ -256,8 +258,69 @@ int GenericTaskQueue<E, F, N>::next_random_queue_id() {
   return randomParkAndMiller(&_seed);
 }
 
+template<class E, MEMFLAGS F, unsigned int N>
+inline void GenericTaskQueue<E, F, N>::update_numa_id() {
+  uint numa_id = (uint)os::numa_get_group_id();
+  if (_numa_id != numa_id) {
+    _numa_id = numa_id;
+  }
+}
+
+template<class T, MEMFLAGS F> uint
+GenericTaskQueueSet<T, F>::random_victim(uint queue_num, uint excluded, bool numa_local) {
+  assert(_n > 2, "must have a choice");
+  T* const local_queue = _queues[queue_num];
+  // There may be no other queue on our node, so only prefer local ones
+  // for a bounded number of tries.
+  for (uint tries = 0; ; tries++) {
+    uint k = local_queue->next_random_queue_id() % _n;
+    if (k == queue_num || k == excluded) {
+      continue;
+    }
+    if (!numa_local || tries >= _n || _queues[k]->numa_id() == local_queue->numa_id()) {
+      return k;
+    }
+  }
+}
+
+template<class T, MEMFLAGS F> bool
+GenericTaskQueueSet<T, F>::steal_from(uint queue_num, uint victim, uint victim_size, E& t) {
+  T* const local_queue = _queues[queue_num];
+  T* const victim_queue = _queues[victim];
+  if (!victim_queue->pop_global(t)) {
+    return false;
+  }
+
+  TASKQUEUE_STATS_ONLY(
+    if (local_queue->is_numa_id_valid() && victim_queue->numa_id() == local_queue->numa_id()) {
+      local_queue->stats.record_steal_local();
+    }
+  )
+
+  if (WorkStealingBatchSize > 1) {
+    // Take up to half of the tasks the victim had, without taking more than
+    // fit into our queue.  Other threads only ever shrink our queue, so the
+    // pushes below cannot fail or overflow.  Each task is claimed with its own
+    // pop_global(); claiming a range of tasks with a single CAS on the age
+    // would race with the CAS-free fast path of the victim's pop_local().
+    uint batch = MIN2(victim_size / 2, (uint)WorkStealingBatchSize - 1);
+    batch = MIN2(batch, local_queue->max_elems() - local_queue->size());
+    uint moved = 0;
+    for (; moved < batch; moved++) {
+      E task;
+      if (!victim_queue->pop_global(task)) {
+        break;
+      }
+      DEBUG_ONLY(bool pushed =) local_queue->push(task);
+      assert(pushed, "checked that there is room");
+    }
+    TASKQUEUE_STATS_ONLY(local_queue->stats.record_steal_batch(moved));
+  }
+  return true;
+}
+
 template<class T, MEMFLAGS F> bool
-GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
+GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t, bool numa_local) {
   if (_n > 2) {
     T* const local_queue = _queues[queue_num];
     uint k1 = queue_num;
@@ -266,15 +329,10 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
       k1 = local_queue->last_stolen_queue_id();
       assert(k1 != queue_num, "Should not be the same");
     } else {
-      while (k1 == queue_num) {
-        k1 = local_queue->next_random_queue_id() % _n;
-      }
+      k1 = random_victim(queue_num, queue_num, numa_local);
     }
 
-    uint k2 = queue_num;
-    while (k2 == queue_num || k2 == k1) {
-      k2 = local_queue->next_random_queue_id() % _n;
-    }
+    uint k2 = random_victim(queue_num, k1, numa_local);
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
@@ -284,10 +342,10 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
 
     if (sz2 > sz1) {
       sel_k = k2;
-      suc = _queues[k2]->pop_global(t);
+      suc = steal_from(queue_num, k2, sz2, t);
     } else if (sz1 > 0) {
       sel_k = k1;
-      suc = _queues[k1]->pop_global(t);
+      suc = steal_from(queue_num, k1, sz1, t);
     }
 
     if (suc) {
@@ -300,7 +358,7 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    return steal_from(queue_num, k, _queues[k]->size(), t);
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
@@ -309,9 +367,15 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
 
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+  bool numa_local = UseNUMA && WorkStealingPreferNUMALocal;
+  if (numa_local) {
+    queue(queue_num)->update_numa_id();
+  }
   for (uint i = 0; i < 2 * _n; i++) {
     TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal_attempt());
-    if (steal_best_of_2(queue_num, t)) {
+    // Only prefer victims on our own node for the first half of the
+    // attempts, so that remote work is still found.
+    if (steal_best_of_2(queue_num, t, numa_local && i < _n)) {
       TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal());
       return true;
     }
@@ -24,7 +24,9 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gcId.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
@@ -55,8 +57,15 @@ void ThreadLocalAllocBuffer::accumulate_and_reset_statistics(ThreadLocalAllocSta
   size_t allocated_since_last_gc = total_allocated - _allocated_before_last_gc;
   _allocated_before_last_gc = total_allocated;
 
+  update_allocation_class(allocated_since_last_gc, capacity);
+
   print_stats("gc");
 
+  stats->update_allocation_class(_allocation_class,
+                                 _number_of_refills,
+                                 _allocated_size,
+                                 _gc_waste + _slow_refill_waste + _fast_refill_waste);
+
   if (_number_of_refills > 0) {
     // Update allocation history if a reasonable amount of eden was allocated.
     bool update_allocation_history = used > 0.5 * capacity;
@@ -125,20 +134,61 @@ void ThreadLocalAllocBuffer::retire_before_allocation() {
   retire();
 }
 
-void ThreadLocalAllocBuffer::resize() {
+void ThreadLocalAllocBuffer::update_allocation_class(size_t allocated_since_last_gc, size_t capacity) {
+  if (!TLABAllocationClasses) {
+    _allocation_class = Warm;
+  } else if (allocated_since_last_gc < desired_size() * HeapWordSize) {
+    // Did not even use up a single TLAB since the last GC
+    _allocation_class = Cold;
+  } else if (allocated_since_last_gc >= capacity / 100 * TLABHotThreadPercent) {
+    _allocation_class = Hot;
+  } else {
+    _allocation_class = Warm;
+  }
+}
+
+const char* ThreadLocalAllocBuffer::allocation_class_name(AllocationClass c) {
+  switch (c) {
+    case Cold: return "Cold";
+    case Warm: return "Warm";
+    case Hot:  return "Hot";
+    default:   ShouldNotReachHere(); return NULL;
+  }
+}
+
+size_t ThreadLocalAllocBuffer::compute_desired_size() {
+  if (_allocation_class == Cold) {
+    // Near-idle threads keep the smallest TLAB so that they do not hold
+    // on to eden they are unlikely to use before the next GC.
+    return align_object_size(min_size());
+  }
+
+  // Hot threads allocate a large part of eden themselves, so the space
+  // left in their TLAB at a GC is small compared to what they allocated.
+  // Let them refill half as often.
+  unsigned target_refills = _target_refills;
+  if (_allocation_class == Hot) {
+    target_refills = MAX2(target_refills / 2, 2U);
+  }
+
   // Compute the next tlab size using expected allocation amount
-  assert(ResizeTLAB, "Should not call this otherwise");
   size_t alloc = (size_t)(_allocation_fraction.average() *
                           (Universe::heap()->tlab_capacity(thread()) / HeapWordSize));
-  size_t new_size = alloc / _target_refills;
+  size_t new_size = alloc / target_refills;
 
   new_size = MIN2(MAX2(new_size, min_size()), max_size());
 
-  size_t aligned_new_size = align_object_size(new_size);
+  return align_object_size(new_size);
+}
+
+void ThreadLocalAllocBuffer::resize() {
+  assert(ResizeTLAB, "Should not call this otherwise");
+  size_t aligned_new_size = compute_desired_size();
 
-  log_trace(gc, tlab)("TLAB new size: thread: " INTPTR_FORMAT " [id: %2d]"
+  log_trace(gc, tlab)("TLAB new size: thread: " INTPTR_FORMAT " [id: %2d] %s"
                       " refills %d  alloc: %8.6f desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
                       p2i(thread()), thread()->osthread()->thread_id(),
+                      allocation_class_name(_allocation_class),
                       _target_refills, _allocation_fraction.average(), desired_size(), aligned_new_size);
 
   set_desired_size(aligned_new_size);
@@ -164,6 +214,15 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
 
   initialize(start, top, start + new_size - alignment_reserve());
 
+  if (_allocation_class == Cold && _number_of_refills >= ColdRefillsBeforeWarm) {
+    // The thread is allocating again, go back to regular sizing
+    // instead of waiting for the next GC to reclassify it.
+    _allocation_class = Warm;
+    if (ResizeTLAB) {
+      set_desired_size(compute_desired_size());
+    }
+  }
+
   // Reset amount of internal fragmentation
   set_refill_waste_limit(initial_refill_waste_limit());
 }
@@ -265,12 +324,13 @@ void ThreadLocalAllocBuffer::print_stats(const char* tag) {
   size_t waste = _gc_waste + _slow_refill_waste + _fast_refill_waste;
   double waste_percent = percent_of(waste, _allocated_size);
   size_t tlab_used  = Universe::heap()->tlab_used(thrd);
-  log.trace("TLAB: %s thread: " INTPTR_FORMAT " [id: %2d]"
+  log.trace("TLAB: %s thread: " INTPTR_FORMAT " [id: %2d] %s"
             " desired_size: " SIZE_FORMAT "KB"
             " slow allocs: %d  refill waste: " SIZE_FORMAT "B"
             " alloc:%8.5f %8.0fKB refills: %d waste %4.1f%% gc: %dB"
             " slow: %dB fast: %dB",
             tag, p2i(thrd), thrd->osthread()->thread_id(),
+            allocation_class_name(_allocation_class),
             _desired_size / (K / HeapWordSize),
             _slow_allocations, _refill_waste_limit * HeapWordSize,
             _allocation_fraction.average(),
@@ -363,7 +423,14 @@ ThreadLocalAllocStats::ThreadLocalAllocStats() :
     _total_slow_refill_waste(0),
     _max_slow_refill_waste(0),
     _total_slow_allocations(0),
-    _max_slow_allocations(0) {}
+    _max_slow_allocations(0) {
+  for (uint i = 0; i < ThreadLocalAllocBuffer::AllocationClassCount; i++) {
+    _class_threads[i]     = 0;
+    _class_refills[i]     = 0;
+    _class_allocations[i] = 0;
+    _class_waste[i]       = 0;
+  }
+}
 
 unsigned int ThreadLocalAllocStats::allocating_threads_avg() {
   return MAX2((unsigned int)(_allocating_threads_avg.average() + 0.5), 1U);
@@ -391,6 +458,16 @@ void ThreadLocalAllocStats::update_slow_allocations(unsigned int allocations) {
   _max_slow_allocations    = MAX2(_max_slow_allocations, allocations);
 }
 
+void ThreadLocalAllocStats::update_allocation_class(ThreadLocalAllocBuffer::AllocationClass c,
+                                                    unsigned int refills,
+                                                    size_t allocations,
+                                                    size_t waste) {
+  _class_threads[c]     += 1;
+  _class_refills[c]     += refills;
+  _class_allocations[c] += allocations;
+  _class_waste[c]       += waste;
+}
+
 void ThreadLocalAllocStats::update(const ThreadLocalAllocStats& other) {
   _allocating_threads      += other._allocating_threads;
   _total_refills           += other._total_refills;
@@ -404,6 +481,12 @@ void ThreadLocalAllocStats::update(const ThreadLocalAllocStats& other) {
   _max_slow_refill_waste    = MAX2(_max_slow_refill_waste, other._max_slow_refill_waste);
   _total_slow_allocations  += other._total_slow_allocations;
   _max_slow_allocations     = MAX2(_max_slow_allocations, other._max_slow_allocations);
+  for (uint i = 0; i < ThreadLocalAllocBuffer::AllocationClassCount; i++) {
+    _class_threads[i]      += other._class_threads[i];
+    _class_refills[i]      += other._class_refills[i];
+    _class_allocations[i]  += other._class_allocations[i];
+    _class_waste[i]        += other._class_waste[i];
+  }
 }
 
 void ThreadLocalAllocStats::reset() {
@@ -419,6 +502,31 @@ void ThreadLocalAllocStats::reset() {
   _max_slow_refill_waste   = 0;
   _total_slow_allocations  = 0;
   _max_slow_allocations    = 0;
+  for (uint i = 0; i < ThreadLocalAllocBuffer::AllocationClassCount; i++) {
+    _class_threads[i]      = 0;
+    _class_refills[i]      = 0;
+    _class_allocations[i]  = 0;
+    _class_waste[i]        = 0;
+  }
+}
+
+void ThreadLocalAllocStats::send_class_events() const {
+  for (uint i = 0; i < ThreadLocalAllocBuffer::AllocationClassCount; i++) {
+    if (_class_threads[i] == 0) {
+      continue;
+    }
+
+    EventThreadLocalAllocationBufferStatistics e;
+    if (e.should_commit()) {
+      e.set_gcId(GCId::current_or_undefined());
+      e.set_allocationClass(ThreadLocalAllocBuffer::allocation_class_name((ThreadLocalAllocBuffer::AllocationClass)i));
+      e.set_threads(_class_threads[i]);
+      e.set_refills(_class_refills[i]);
+      e.set_allocated(_class_allocations[i] * HeapWordSize);
+      e.set_waste(_class_waste[i] * HeapWordSize);
+      e.commit();
+    }
+  }
 }
 
 void ThreadLocalAllocStats::publish() {
@@ -441,6 +549,20 @@ void ThreadLocalAllocStats::publish() {
                       _total_slow_refill_waste * HeapWordSize, _max_slow_refill_waste * HeapWordSize,
                       _total_fast_refill_waste * HeapWordSize, _max_fast_refill_waste * HeapWordSize);
 
+  if (TLABAllocationClasses) {
+    log_debug(gc, tlab)("TLAB classes: hot: %u thrds " SIZE_FORMAT "KB"
+                        " warm: %u thrds " SIZE_FORMAT "KB"
+                        " cold: %u thrds " SIZE_FORMAT "KB",
+                        _class_threads[ThreadLocalAllocBuffer::Hot],
+                        _class_allocations[ThreadLocalAllocBuffer::Hot] * HeapWordSize / K,
+                        _class_threads[ThreadLocalAllocBuffer::Warm],
+                        _class_allocations[ThreadLocalAllocBuffer::Warm] * HeapWordSize / K,
+                        _class_threads[ThreadLocalAllocBuffer::Cold],
+                        _class_allocations[ThreadLocalAllocBuffer::Cold] * HeapWordSize / K);
+  }
+
+  send_class_events();
+
   if (UsePerfData) {
     _perf_allocating_threads      ->set_value(_allocating_threads);
     _perf_total_refills           ->set_value(_total_refills);
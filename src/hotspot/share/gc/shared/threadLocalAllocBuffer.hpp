@@ -42,9 +42,22 @@ class ThreadLocalAllocStats;
 //            allocation_end contains the real end of the tlab allocation,
 //            whereas end can be set to an arbitrary spot in the tlab to
 //            trip the return and sample the allocation.
+//
+//            With TLABAllocationClasses, each thread is classified at every
+//            GC by the amount it allocated since the previous GC. Cold
+//            threads get minimal TLABs until they start refilling again,
+//            and hot threads target fewer refills between GCs.
 class ThreadLocalAllocBuffer: public CHeapObj<mtThread> {
   friend class VMStructs;
   friend class JVMCIVMStructs;
+public:
+  enum AllocationClass {
+    Cold,
+    Warm,
+    Hot,
+    AllocationClassCount
+  };
+
 private:
   HeapWord* _start;                              // address of TLAB
   HeapWord* _top;                                // address after last allocation
@@ -61,6 +74,11 @@ private:
   static int      _reserve_for_allocation_prefetch;   // Reserve at the end of the TLAB
   static unsigned _target_refills;                    // expected number of refills between GCs
 
+  // Number of refills after which a cold thread is considered warm again.
+  static const unsigned ColdRefillsBeforeWarm = 4;
+
+  AllocationClass _allocation_class;
+
   unsigned  _number_of_refills;
   unsigned  _fast_refill_waste;
   unsigned  _slow_refill_waste;
@@ -85,6 +103,12 @@ private:
   static int    target_refills()                 { return _target_refills; }
   size_t initial_desired_size();
 
+  // Desired size for the current allocation class and allocation history.
+  size_t compute_desired_size();
+
+  // Classify the thread by the number of bytes allocated since the last GC.
+  void update_allocation_class(size_t allocated_since_last_gc, size_t capacity);
+
   size_t remaining();
 
   // Make parsable and release it.
@@ -111,7 +135,10 @@ private:
   int slow_allocations() const  { return _slow_allocations; }
 
 public:
-  ThreadLocalAllocBuffer() : _allocated_before_last_gc(0), _allocation_fraction(TLABAllocationWeight) {
+  ThreadLocalAllocBuffer() :
+    _allocated_before_last_gc(0),
+    _allocation_class(Warm),
+    _allocation_fraction(TLABAllocationWeight) {
     // do nothing.  tlabs must be inited by initialize() calls
   }
 
@@ -132,6 +159,9 @@ public:
   // Don't discard tlab if remaining space is larger than this.
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
   size_t bytes_since_last_sample_point() const   { return _bytes_since_last_sample_point; }
+  AllocationClass allocation_class() const       { return _allocation_class; }
+
+  static const char* allocation_class_name(AllocationClass c);
 
   // Allocate size HeapWords. The memory is NOT initialized to zero.
   inline HeapWord* allocate(size_t size);
@@ -220,6 +250,14 @@ private:
   unsigned int _total_slow_allocations;
   unsigned int _max_slow_allocations;
 
+  // Per allocation class totals
+  unsigned int _class_threads[ThreadLocalAllocBuffer::AllocationClassCount];
+  unsigned int _class_refills[ThreadLocalAllocBuffer::AllocationClassCount];
+  size_t       _class_allocations[ThreadLocalAllocBuffer::AllocationClassCount];
+  size_t       _class_waste[ThreadLocalAllocBuffer::AllocationClassCount];
+
+  void send_class_events() const;
+
 public:
   static void initialize();
   static unsigned int allocating_threads_avg();
@@ -232,6 +270,10 @@ public:
                                size_t fast_refill_waste,
                                size_t slow_refill_waste);
   void update_slow_allocations(unsigned int allocations);
+  void update_allocation_class(ThreadLocalAllocBuffer::AllocationClass c,
+                               unsigned int refills,
+                               size_t allocations,
+                               size_t waste);
   void update(const ThreadLocalAllocStats& other);
 
   void reset();
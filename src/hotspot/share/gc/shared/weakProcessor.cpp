@@ -39,11 +39,15 @@
 template <typename Container>
 class OopsDoAndReportCounts {
 public:
-  void operator()(BoolObjectClosure* is_alive, OopClosure* keep_alive, OopStorage* storage) {
+  void operator()(BoolObjectClosure* is_alive, OopClosure* keep_alive, OopStorage* storage,
+                  StringTable::DeadHashBatch* dead_strings = NULL) {
     Container::reset_dead_counter();
 
-    CountingSkippedIsAliveClosure<BoolObjectClosure, OopClosure> cl(is_alive, keep_alive);
+    CountingSkippedIsAliveClosure<BoolObjectClosure, OopClosure> cl(is_alive, keep_alive, dead_strings);
     storage->oops_do(&cl);
+    if (dead_strings != NULL) {
+      dead_strings->flush();
+    }
 
     Container::inc_dead_counter(cl.num_dead() + cl.num_skipped());
     Container::finish_dead_counter();
@@ -59,7 +63,8 @@ void WeakProcessor::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_a
   OopStorageSet::Iterator it = OopStorageSet::weak_iterator();
   for ( ; !it.is_end(); ++it) {
     if (OopStorageSet::string_table_weak() == *it) {
-      OopsDoAndReportCounts<StringTable>()(is_alive, keep_alive, *it);
+      StringTable::DeadHashBatch dead_strings;
+      OopsDoAndReportCounts<StringTable>()(is_alive, keep_alive, *it, &dead_strings);
     } else if (OopStorageSet::resolved_method_table_weak() == *it) {
       OopsDoAndReportCounts<ResolvedMethodTable>()(is_alive, keep_alive, *it);
     } else {
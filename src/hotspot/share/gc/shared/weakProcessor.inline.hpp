@@ -64,12 +64,15 @@ template <typename IsAlive, typename KeepAlive>
 class CountingSkippedIsAliveClosure : public Closure {
   CountingIsAliveClosure<IsAlive> _counting_is_alive;
   KeepAlive* _keep_alive;
+  StringTable::DeadHashBatch* _dead_strings;
 
   size_t _num_skipped;
 
 public:
-  CountingSkippedIsAliveClosure(IsAlive* is_alive, KeepAlive* keep_alive) :
-    _counting_is_alive(is_alive), _keep_alive(keep_alive), _num_skipped(0) { }
+  CountingSkippedIsAliveClosure(IsAlive* is_alive, KeepAlive* keep_alive,
+                                StringTable::DeadHashBatch* dead_strings = NULL) :
+    _counting_is_alive(is_alive), _keep_alive(keep_alive),
+    _dead_strings(dead_strings), _num_skipped(0) { }
 
   void do_oop(oop* p) {
     oop obj = *p;
@@ -78,6 +81,9 @@ public:
     } else if (_counting_is_alive.do_object_b(obj)) {
       _keep_alive->do_oop(p);
     } else {
+      if (_dead_strings != NULL) {
+        _dead_strings->add(obj);
+      }
       *p = NULL;
     }
   }
@@ -112,16 +118,22 @@ void WeakProcessor::Task::work(uint worker_id,
 
   for (Iterator it = WeakProcessorPhases::oopstorage_iterator(); !it.is_end(); ++it) {
     WeakProcessorPhase phase = *it;
-    CountingSkippedIsAliveClosure<IsAlive, KeepAlive> cl(is_alive, keep_alive);
-    WeakProcessorPhaseTimeTracker pt(_phase_times, phase, worker_id);
     uint oopstorage_index = WeakProcessorPhases::oopstorage_index(phase);
     StorageState& cur_state = _storage_states[oopstorage_index];
+    const OopStorage* cur_storage = cur_state.storage();
+    // Record the dead strings' hashes in the same pass that clears
+    // their entries, so StringTable cleaning need not walk the table.
+    StringTable::DeadHashBatch dead_strings;
+    bool is_string_table = (cur_storage == OopStorageSet::string_table_weak());
+    CountingSkippedIsAliveClosure<IsAlive, KeepAlive> cl(is_alive, keep_alive,
+                                                         is_string_table ? &dead_strings : NULL);
+    WeakProcessorPhaseTimeTracker pt(_phase_times, phase, worker_id);
     cur_state.oops_do(&cl);
     if (_phase_times != NULL) {
       _phase_times->record_worker_items(worker_id, phase, cl.num_dead(), cl.num_total());
     }
-    const OopStorage* cur_storage = cur_state.storage();
-    if (cur_storage == OopStorageSet::string_table_weak()) {
+    if (is_string_table) {
+      dead_strings.flush();
       StringTable::inc_dead_counter(cl.num_dead() + cl.num_skipped());
     } else if (cur_storage == OopStorageSet::resolved_method_table_weak()) {
       ResolvedMethodTable::inc_dead_counter(cl.num_dead() + cl.num_skipped());
@@ -121,6 +121,12 @@ uint WorkerPolicy::calc_default_active_workers(uintx total_workers,
 
   new_active_workers = MIN2(max_active_workers, (uintx) total_workers);
 
+  // Do not use more workers than there are processors currently available
+  // to the VM.  The number of workers is chosen at startup, but in a
+  // container the CPU quota may have been lowered since.
+  uintx active_processors = MAX2((uintx) os::active_processor_count(), min_workers);
+  new_active_workers = MIN2(new_active_workers, active_processors);
+
   // Increase GC workers instantly but decrease them more
   // slowly.
   if (new_active_workers < prev_active_workers) {
@@ -187,6 +193,16 @@ uint WorkerPolicy::calc_active_workers(uintx total_workers,
   return new_active_workers;
 }
 
+uint WorkerPolicy::calc_workers_for_work(uint max_workers,
+                                         size_t work_units,
+                                         size_t units_per_worker) {
+  assert(max_workers > 0, "Always need at least 1");
+  assert(units_per_worker > 0, "Must be");
+  size_t workers_by_work = work_units / units_per_worker +
+                           ((work_units % units_per_worker) != 0 ? 1 : 0);
+  return (uint) MIN2(MAX2(workers_by_work, (size_t) 1), (size_t) max_workers);
+}
+
 uint WorkerPolicy::calc_active_conc_workers(uintx total_workers,
                                             uintx active_workers,
                                             uintx application_workers) {
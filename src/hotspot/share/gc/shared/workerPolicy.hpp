@@ -71,6 +71,14 @@ public:
                                   uintx active_workers,
                                   uintx application_workers);
 
+  // Return the number of workers to use for a parallel phase with
+  // work_units units of work, giving each worker at least units_per_worker
+  // of them.  The result is between 1 and max_workers, so that small phases
+  // do not wake up workers that would have nothing to do.
+  static uint calc_workers_for_work(uint max_workers,
+                                    size_t work_units,
+                                    size_t units_per_worker);
+
   // Return number of GC threads to use in the next concurrent GC phase.
   static uint calc_active_conc_workers(uintx total_workers,
                                        uintx active_workers,
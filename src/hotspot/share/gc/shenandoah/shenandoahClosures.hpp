@@ -89,6 +89,24 @@ public:
   inline void do_oop(narrowOop* p);
 };
 
+// Concurrent weak root cleaning: clears the references to objects that were found
+// dead by the last marking, and evacuates/updates the live ones in collection set.
+class ShenandoahEvacUpdateCleanupOopStorageRootsClosure : public BasicOopIterateClosure {
+private:
+  ShenandoahHeap* const           _heap;
+  ShenandoahMarkingContext* const _mark_context;
+  Thread* const                   _thread;
+  size_t                          _dead_counter;
+
+public:
+  inline ShenandoahEvacUpdateCleanupOopStorageRootsClosure();
+  inline void do_oop(oop* p);
+  inline void do_oop(narrowOop* p);
+
+  size_t dead_counter() const { return _dead_counter; }
+  void reset_dead_counter()   { _dead_counter = 0; }
+};
+
 #ifdef ASSERT
 class ShenandoahAssertNotForwardedClosure : public OopClosure {
 private:
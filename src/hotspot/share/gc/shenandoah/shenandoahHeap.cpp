@@ -25,6 +25,8 @@
 #include "memory/allocation.hpp"
 #include "memory/universe.hpp"
 
+#include "classfile/stringTable.hpp"
+
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/gcTimer.hpp"
 #include "gc/shared/gcTraceTime.inline.hpp"
@@ -71,6 +73,7 @@
 
 #include "memory/metaspace.hpp"
 #include "oops/compressedOops.inline.hpp"
+#include "prims/resolvedMethodTable.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/safepointMechanism.hpp"
@@ -461,7 +464,8 @@ ShenandoahHeap::ShenandoahHeap(ShenandoahCollectorPolicy* policy) :
   _bitmap_region_special(false),
   _aux_bitmap_region_special(false),
   _liveness_cache(NULL),
-  _collection_set(NULL)
+  _collection_set(NULL),
+  _age_table(true)
 {
   log_info(gc, init)("GC threads: " UINT32_FORMAT " parallel, " UINT32_FORMAT " concurrent", ParallelGCThreads, ConcGCThreads);
   log_info(gc, init)("Reference processing: %s", ParallelRefProcEnabled ? "parallel" : "serial");
@@ -1525,6 +1529,15 @@ void ShenandoahHeap::op_final_mark() {
       _free_set->rebuild();
     }
 
+    update_region_ages();
+
+    // Dead referents in OopStorage backed weak roots are only hidden from Java threads
+    // while evacuation is in progress, clean them up right away if there is nothing
+    // to evacuate.
+    if (is_concurrent_weak_root_in_progress() && collection_set()->is_empty()) {
+      stw_process_concurrent_weak_roots();
+    }
+
     // If collection set has candidates, start evacuation.
     // Otherwise, bypass the rest of the cycle.
     if (!collection_set()->is_empty()) {
@@ -1580,6 +1593,40 @@ void ShenandoahHeap::op_final_mark() {
   }
 }
 
+void ShenandoahHeap::update_region_ages() {
+  _age_table.clear();
+
+  size_t young_regions = 0;
+  size_t young_live = 0;
+  size_t old_regions = 0;
+  size_t old_live = 0;
+
+  for (size_t i = 0; i < num_regions(); i++) {
+    ShenandoahHeapRegion* r = get_region(i);
+    if (r->is_regular() && r->has_live()) {
+      r->increment_age();
+      size_t live = r->get_live_data_words();
+      _age_table.add(r->age(), live);
+      if (r->age() < MaxTenuringThreshold) {
+        young_regions++;
+        young_live += live;
+      } else {
+        old_regions++;
+        old_live += live;
+      }
+    }
+  }
+
+  _age_table.print_age_table((uint) MaxTenuringThreshold);
+
+  young_live *= HeapWordSize;
+  old_live *= HeapWordSize;
+  log_debug(gc, age)("Region ages: " SIZE_FORMAT " young regions (" SIZE_FORMAT "%s live), "
+                     SIZE_FORMAT " old regions (" SIZE_FORMAT "%s live)",
+                     young_regions, byte_size_in_proper_unit(young_live), proper_unit_for_byte_size(young_live),
+                     old_regions, byte_size_in_proper_unit(old_live), proper_unit_for_byte_size(old_live));
+}
+
 void ShenandoahHeap::op_final_evac() {
   assert(ShenandoahSafepoint::is_at_shenandoah_safepoint(), "Should be at safepoint");
 
@@ -1620,7 +1667,6 @@ void ShenandoahHeap::op_cleanup() {
 class ShenandoahConcurrentRootsEvacUpdateTask : public AbstractGangTask {
 private:
   ShenandoahVMRoots<true /*concurrent*/>        _vm_roots;
-  ShenandoahWeakRoots<true /*concurrent*/>      _weak_roots;
   ShenandoahClassLoaderDataRoots<true /*concurrent*/, false /*single threaded*/> _cld_roots;
 
 public:
@@ -1631,11 +1677,10 @@ public:
   void work(uint worker_id) {
     ShenandoahEvacOOMScope oom;
     {
-      // jni_roots and weak_roots are OopStorage backed roots, concurrent iteration
+      // jni_roots are OopStorage backed roots, concurrent iteration
       // may race against OopStorage::release() calls.
       ShenandoahEvacUpdateOopStorageRootsClosure cl;
       _vm_roots.oops_do<ShenandoahEvacUpdateOopStorageRootsClosure>(&cl);
-      _weak_roots.oops_do<ShenandoahEvacUpdateOopStorageRootsClosure>(&cl);
     }
 
     {
@@ -1646,7 +1691,58 @@ public:
   }
 };
 
+// Cleans up OopStorage backed weak roots, left over by final mark. Dead referents are
+// cleared and the table owners are notified about them, live referents in collection set
+// are evacuated and updated.
+class ShenandoahConcurrentWeakRootsEvacUpdateTask : public AbstractGangTask {
+private:
+  ShenandoahWeakRoot<true /*concurrent*/>  _jni_roots;
+  ShenandoahWeakRoot<true /*concurrent*/>  _string_table_roots;
+  ShenandoahWeakRoot<true /*concurrent*/>  _resolved_method_table_roots;
+  ShenandoahWeakRoot<true /*concurrent*/>  _vm_roots;
+
+public:
+  ShenandoahConcurrentWeakRootsEvacUpdateTask() :
+    AbstractGangTask("Shenandoah Concurrent Weak Roots Task"),
+    _jni_roots(OopStorageSet::jni_weak(), ShenandoahPhaseTimings::JNIWeakRoots),
+    _string_table_roots(OopStorageSet::string_table_weak(), ShenandoahPhaseTimings::StringTableRoots),
+    _resolved_method_table_roots(OopStorageSet::resolved_method_table_weak(), ShenandoahPhaseTimings::ResolvedMethodTableRoots),
+    _vm_roots(OopStorageSet::vm_weak(), ShenandoahPhaseTimings::VMWeakRoots) {
+    StringTable::reset_dead_counter();
+    ResolvedMethodTable::reset_dead_counter();
+  }
+
+  ~ShenandoahConcurrentWeakRootsEvacUpdateTask() {
+    StringTable::finish_dead_counter();
+    ResolvedMethodTable::finish_dead_counter();
+  }
+
+  void work(uint worker_id) {
+    ShenandoahEvacOOMScope oom;
+    // All these roots are OopStorage backed, concurrent iteration
+    // may race against OopStorage::release() calls.
+    ShenandoahEvacUpdateCleanupOopStorageRootsClosure cl;
+    _jni_roots.oops_do(&cl, worker_id);
+    _vm_roots.oops_do(&cl, worker_id);
+
+    cl.reset_dead_counter();
+    _string_table_roots.oops_do(&cl, worker_id);
+    StringTable::inc_dead_counter(cl.dead_counter());
+
+    cl.reset_dead_counter();
+    _resolved_method_table_roots.oops_do(&cl, worker_id);
+    ResolvedMethodTable::inc_dead_counter(cl.dead_counter());
+  }
+};
+
 void ShenandoahHeap::op_roots() {
+  if (is_concurrent_weak_root_in_progress()) {
+    assert(is_evacuation_in_progress(), "Should only be left over for evacuation");
+    ShenandoahConcurrentWeakRootsEvacUpdateTask task;
+    workers()->run_task(&task);
+    set_concurrent_weak_root_in_progress(false);
+  }
+
   if (is_evacuation_in_progress() &&
       ShenandoahConcurrentRoots::should_do_concurrent_roots()) {
     ShenandoahConcurrentRootsEvacUpdateTask task;
@@ -1675,6 +1771,8 @@ void ShenandoahHeap::op_final_traversal() {
 }
 
 void ShenandoahHeap::op_full(GCCause::Cause cause) {
+  assert(!is_concurrent_weak_root_in_progress(), "Weak roots should have been cleaned");
+
   ShenandoahMetricsSnapshot metrics;
   metrics.snap_before();
 
@@ -1702,6 +1800,9 @@ void ShenandoahHeap::op_degenerated(ShenandoahDegenPoint point) {
 
   clear_cancelled_gc();
 
+  // Concurrent roots phase always follows final mark, weak roots can not be left over.
+  assert(!is_concurrent_weak_root_in_progress(), "Weak roots should have been cleaned");
+
   ShenandoahMetricsSnapshot metrics;
   metrics.snap_before();
 
@@ -2061,9 +2162,47 @@ void ShenandoahHeap::stw_process_weak_roots(bool full_gc) {
   }
 }
 
+// Concurrent cycles only clean the weak roots that are not backed by OopStorage here,
+// the rest is left over for concurrent roots phase, or for the end of final mark if
+// there turns out to be nothing to evacuate.
+void ShenandoahHeap::stw_process_serial_weak_roots() {
+  ShenandoahGCPhase root_phase(ShenandoahPhaseTimings::purge);
+  ShenandoahGCPhase phase(ShenandoahPhaseTimings::purge_par);
+  assert(!has_forwarded_objects(), "Should not have forwarded objects");
+
+  ShenandoahIsAliveClosure is_alive;
+#ifdef ASSERT
+  ShenandoahAssertNotForwardedClosure verify_cl;
+  ShenandoahSerialWeakRootsCleaningTask<ShenandoahIsAliveClosure, ShenandoahAssertNotForwardedClosure>
+    cleaning_task(&is_alive, &verify_cl);
+#else
+  ShenandoahSerialWeakRootsCleaningTask<ShenandoahIsAliveClosure, DoNothingClosure>
+    cleaning_task(&is_alive, &do_nothing_cl);
+#endif
+  _workers->run_task(&cleaning_task);
+}
+
+void ShenandoahHeap::stw_process_concurrent_weak_roots() {
+  assert(ShenandoahSafepoint::is_at_shenandoah_safepoint(), "Should be at safepoint");
+  ShenandoahGCPhase phase(ShenandoahPhaseTimings::purge_weak_roots);
+  ShenandoahConcurrentWeakRootsEvacUpdateTask task;
+  _workers->run_task(&task);
+  set_concurrent_weak_root_in_progress(false);
+}
+
 void ShenandoahHeap::parallel_cleaning(bool full_gc) {
   assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
-  stw_process_weak_roots(full_gc);
+  // Forwarded objects are left over when update-refs was piggy-backed on this
+  // marking, weak roots need to be updated in the pause then.
+  if (!full_gc &&
+      ShenandoahConcurrentWeakRootCleaning &&
+      ShenandoahConcurrentRoots::should_do_concurrent_roots() &&
+      !has_forwarded_objects()) {
+    stw_process_serial_weak_roots();
+    set_concurrent_weak_root_in_progress(true);
+  } else {
+    stw_process_weak_roots(full_gc);
+  }
   stw_unload_classes(full_gc);
 }
 
@@ -2092,6 +2231,14 @@ bool ShenandoahHeap::unload_classes() const {
   return _unload_classes.is_set();
 }
 
+void ShenandoahHeap::set_concurrent_weak_root_in_progress(bool in_progress) {
+  _concurrent_weak_root_in_progress.set_cond(in_progress);
+}
+
+bool ShenandoahHeap::is_concurrent_weak_root_in_progress() const {
+  return _concurrent_weak_root_in_progress.is_set();
+}
+
 address ShenandoahHeap::in_cset_fast_test_addr() {
   ShenandoahHeap* heap = ShenandoahHeap::heap();
   assert(heap->collection_set() != NULL, "Sanity");
@@ -24,6 +24,7 @@
 #ifndef SHARE_GC_SHENANDOAH_SHENANDOAHHEAP_HPP
 #define SHARE_GC_SHENANDOAH_SHENANDOAHHEAP_HPP
 
+#include "gc/shared/ageTable.hpp"
 #include "gc/shared/markBitMap.hpp"
 #include "gc/shared/softRefPolicy.hpp"
 #include "gc/shared/collectedHeap.hpp"
@@ -510,17 +511,24 @@ public:
 //
 private:
   ShenandoahSharedFlag _unload_classes;
+  ShenandoahSharedFlag _concurrent_weak_root_in_progress;
 
 public:
   void set_unload_classes(bool uc);
   bool unload_classes() const;
 
+  // OopStorage backed weak roots are left for concurrent cleaning
+  void set_concurrent_weak_root_in_progress(bool in_progress);
+  bool is_concurrent_weak_root_in_progress() const;
+
   // Perform STW class unloading and weak root cleaning
   void parallel_cleaning(bool full_gc);
 
 private:
   void stw_unload_classes(bool full_gc);
   void stw_process_weak_roots(bool full_gc);
+  void stw_process_serial_weak_roots();
+  void stw_process_concurrent_weak_roots();
 
 // ---------- Generic interface hooks
 // Minor things that super-interface expects us to implement to play nice with
@@ -669,8 +677,15 @@ private:
   ShenandoahCollectionSet* _collection_set;
   ShenandoahEvacOOMHandler _oom_evac_handler;
 
+  // Census of live data in regions that survived marking, by region age.
+  AgeTable _age_table;
+
   void evacuate_and_update_roots();
 
+  // Age the regions that stay out of the collection set and record their
+  // live data in the age table.
+  void update_region_ages();
+
 public:
   static address in_cset_fast_test_addr();
 
@@ -61,6 +61,7 @@ ShenandoahHeapRegion::ShenandoahHeapRegion(ShenandoahHeap* heap, HeapWord* start
   _new_top(NULL),
   _critical_pins(0),
   _empty_time(os::elapsedTime()),
+  _age(0),
   _state(committed ? _empty_committed : _empty_uncommitted),
   _tlab_allocs(0),
   _gclab_allocs(0),
@@ -490,6 +491,7 @@ void ShenandoahHeapRegion::recycle() {
     ContiguousSpace::mangle_unused_area_complete();
   }
   clear_live_data();
+  reset_age();
 
   reset_alloc_metadata();
 
@@ -29,6 +29,7 @@
 #include "gc/shenandoah/shenandoahAsserts.hpp"
 #include "gc/shenandoah/shenandoahHeap.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
+#include "oops/markWord.hpp"
 #include "utilities/sizes.hpp"
 
 class VMStructs;
@@ -240,6 +241,7 @@ private:
   HeapWord* _new_top;
   size_t _critical_pins;
   double _empty_time;
+  uint _age;
 
   // Seldom updated fields
   RegionState _state;
@@ -367,6 +369,11 @@ public:
   size_t get_live_data_bytes() const;
   size_t get_live_data_words() const;
 
+  // Number of marking cycles the region has survived since it was last recycled
+  uint age() const          { return _age; }
+  void increment_age()      { if (_age < markWord::max_age) _age++; }
+  void reset_age()          { _age = 0; }
+
   void print_on(outputStream* st) const;
 
   size_t garbage() const;
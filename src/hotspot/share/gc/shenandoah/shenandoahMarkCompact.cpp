@@ -47,12 +47,115 @@
 #include "memory/universe.hpp"
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/growableArray.hpp"
+#include "utilities/quickSort.hpp"
 #include "gc/shared/workgroup.hpp"
 
+// Slices of the heap that are compacted independently of each other: objects in a slice
+// only ever move to regions of the same slice.
+class ShenandoahCompactionSlices : public StackObj {
+public:
+  static const uint NO_SLICE = (uint)-1;
+
+private:
+  struct SliceLive {
+    uint   _index;
+    size_t _live;
+  };
+
+  uint                      const _max_slices;
+  ShenandoahHeapRegionSet** const _slices;
+  SliceLive*                const _order;
+  size_t                          _slice_live_limit;
+
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(volatile uint));
+  volatile uint _num_slices;
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(volatile uint));
+  volatile uint _next_compact;
+  DEFINE_PAD_MINUS_SIZE(2, DEFAULT_CACHE_LINE_SIZE, 0);
+
+  static int compare_by_live(SliceLive a, SliceLive b) {
+    if (a._live > b._live) return -1;
+    if (a._live < b._live) return 1;
+    return 0;
+  }
+
+public:
+  ShenandoahCompactionSlices(uint max_slices) :
+    _max_slices(max_slices),
+    _slices(NEW_C_HEAP_ARRAY(ShenandoahHeapRegionSet*, max_slices, mtGC)),
+    _order(NEW_C_HEAP_ARRAY(SliceLive, max_slices, mtGC)),
+    _slice_live_limit(SIZE_MAX),
+    _num_slices(0),
+    _next_compact(0) {
+    for (uint i = 0; i < _max_slices; i++) {
+      _slices[i] = NULL;
+      _order[i]._index = i;
+      _order[i]._live = 0;
+    }
+  }
+
+  ~ShenandoahCompactionSlices() {
+    for (uint i = 0; i < _max_slices; i++) {
+      delete _slices[i];
+    }
+    FREE_C_HEAP_ARRAY(ShenandoahHeapRegionSet*, _slices);
+    FREE_C_HEAP_ARRAY(SliceLive, _order);
+  }
+
+  uint num_slices() const {
+    return MIN2(_num_slices, _max_slices);
+  }
+
+  ShenandoahHeapRegionSet* slice(uint index) const {
+    assert(index < num_slices(), "sanity");
+    return _slices[index];
+  }
+
+  // Live data in a slice, above which the slice gets closed and a new one is started
+  size_t slice_live_limit() const {
+    return _slice_live_limit;
+  }
+
+  void set_slice_live_limit(size_t words) {
+    _slice_live_limit = words;
+  }
+
+  // Returns NO_SLICE if no more slices can be created
+  uint claim_new_slice() {
+    uint index = Atomic::add(1u, &_num_slices) - 1;
+    if (index >= _max_slices) {
+      return NO_SLICE;
+    }
+    _slices[index] = new ShenandoahHeapRegionSet();
+    return index;
+  }
+
+  void set_live(uint index, size_t words) {
+    _order[index]._live = words;
+  }
+
+  // Order slices by the amount of live data, so that the largest slices are
+  // compacted first and the small ones fill the gaps at the end.
+  void prepare_for_compaction() {
+    QuickSort::sort(_order, num_slices(), compare_by_live, false);
+    _next_compact = 0;
+  }
+
+  // Returns NO_SLICE if all slices have been claimed
+  uint claim_compact_slice() {
+    uint n = Atomic::add(1u, &_next_compact) - 1;
+    if (n >= num_slices()) {
+      return NO_SLICE;
+    }
+    return _order[n]._index;
+  }
+};
+
 ShenandoahMarkCompact::ShenandoahMarkCompact() :
   _gc_timer(NULL),
   _preserved_marks(new PreservedMarksSet(true)) {}
@@ -149,24 +252,22 @@ void ShenandoahMarkCompact::do_it(GCCause::Cause gc_cause) {
   // Setup workers for the rest
   OrderAccess::fence();
 
-  // Initialize worker slices
-  ShenandoahHeapRegionSet** worker_slices = NEW_C_HEAP_ARRAY(ShenandoahHeapRegionSet*, heap->max_workers(), mtGC);
-  for (uint i = 0; i < heap->max_workers(); i++) {
-    worker_slices[i] = new ShenandoahHeapRegionSet();
-  }
+  // Initialize compaction slices. Every worker opens one slice, and every closed slice
+  // holds at least 1/SLICES_PER_WORKER-th of the average live data per worker.
+  ShenandoahCompactionSlices slices(heap->max_workers() * (uint)(SLICES_PER_WORKER + 1));
 
   {
     // The rest of code performs region moves, where region status is undefined
     // until all phases run together.
     ShenandoahHeapLocker lock(heap->lock());
 
-    phase2_calculate_target_addresses(worker_slices);
+    phase2_calculate_target_addresses(&slices);
 
     OrderAccess::fence();
 
     phase3_update_references();
 
-    phase4_compact_objects(worker_slices);
+    phase4_compact_objects(&slices);
   }
 
   {
@@ -180,12 +281,6 @@ void ShenandoahMarkCompact::do_it(GCCause::Cause gc_cause) {
   // Resize metaspace
   MetaspaceGC::compute_new_size();
 
-  // Free worker slices
-  for (uint i = 0; i < heap->max_workers(); i++) {
-    delete worker_slices[i];
-  }
-  FREE_C_HEAP_ARRAY(ShenandoahHeapRegionSet*, worker_slices);
-
   heap->set_full_gc_move_in_progress(false);
   heap->set_full_gc_in_progress(false);
 
@@ -319,10 +414,10 @@ public:
 
 class ShenandoahPrepareForCompactionTask : public AbstractGangTask {
 private:
-  PreservedMarksSet*        const _preserved_marks;
-  ShenandoahHeap*           const _heap;
-  ShenandoahHeapRegionSet** const _worker_slices;
-  ShenandoahRegionIterator        _heap_regions;
+  PreservedMarksSet*          const _preserved_marks;
+  ShenandoahHeap*             const _heap;
+  ShenandoahCompactionSlices* const _slices;
+  ShenandoahRegionIterator          _heap_regions;
 
   ShenandoahHeapRegion* next_from_region(ShenandoahHeapRegionSet* slice) {
     ShenandoahHeapRegion* from_region = _heap_regions.next();
@@ -352,20 +447,13 @@ private:
     return from_region;
   }
 
-public:
-  ShenandoahPrepareForCompactionTask(PreservedMarksSet* preserved_marks, ShenandoahHeapRegionSet** worker_slices) :
-    AbstractGangTask("Shenandoah Prepare For Compaction Task"),
-    _preserved_marks(preserved_marks),
-    _heap(ShenandoahHeap::heap()), _worker_slices(worker_slices) {
-  }
-
-  void work(uint worker_id) {
-    ShenandoahHeapRegionSet* slice = _worker_slices[worker_id];
-    ShenandoahHeapRegion* from_region = next_from_region(slice);
-    // No work?
-    if (from_region == NULL) {
-      return;
-    }
+  // Compacts regions into the slice until it holds enough live data, or no regions are left.
+  // Returns the index of the next slice to compact into, or NO_SLICE when done.
+  uint prepare_slice(uint worker_id, uint index, ShenandoahHeapRegion* from_region) {
+    ShenandoahHeapRegionSet* slice = _slices->slice(index);
+    size_t live = 0;
+    uint next_index = ShenandoahCompactionSlices::NO_SLICE;
+    bool can_split = true;
 
     // Sliding compaction. Walk all regions in the slice, and compact them.
     // Remember empty regions and reuse them as needed.
@@ -376,12 +464,23 @@ public:
       cl.set_from_region(from_region);
       if (from_region->has_live()) {
         _heap->marked_object_iterate(from_region, &cl);
+        live += from_region->get_live_data_words();
       }
 
       // Compacted the region to somewhere else? From-region is empty then.
       if (!cl.is_compact_same_region()) {
         empty_regions.append(from_region);
       }
+
+      // Enough work in this slice? Continue in the new one, if we can still have it.
+      if (can_split && live >= _slices->slice_live_limit()) {
+        next_index = _slices->claim_new_slice();
+        if (next_index != ShenandoahCompactionSlices::NO_SLICE) {
+          break;
+        }
+        can_split = false;
+      }
+
       from_region = next_from_region(slice);
     }
     cl.finish_region();
@@ -391,6 +490,30 @@ public:
       ShenandoahHeapRegion* r = empty_regions.at(pos);
       r->set_new_top(r->bottom());
     }
+
+    _slices->set_live(index, live);
+    return next_index;
+  }
+
+public:
+  ShenandoahPrepareForCompactionTask(PreservedMarksSet* preserved_marks, ShenandoahCompactionSlices* slices) :
+    AbstractGangTask("Shenandoah Prepare For Compaction Task"),
+    _preserved_marks(preserved_marks),
+    _heap(ShenandoahHeap::heap()), _slices(slices) {
+  }
+
+  void work(uint worker_id) {
+    uint index = _slices->claim_new_slice();
+    assert(index != ShenandoahCompactionSlices::NO_SLICE, "every worker gets at least one slice");
+
+    while (index != ShenandoahCompactionSlices::NO_SLICE) {
+      ShenandoahHeapRegion* from_region = next_from_region(_slices->slice(index));
+      // No work?
+      if (from_region == NULL) {
+        return;
+      }
+      index = prepare_slice(worker_id, index, from_region);
+    }
   }
 };
 
@@ -499,7 +622,7 @@ public:
   }
 };
 
-void ShenandoahMarkCompact::phase2_calculate_target_addresses(ShenandoahHeapRegionSet** worker_slices) {
+void ShenandoahMarkCompact::phase2_calculate_target_addresses(ShenandoahCompactionSlices* slices) {
   GCTraceTime(Info, gc, phases) time("Phase 2: Compute new object addresses", _gc_timer);
   ShenandoahGCPhase calculate_address_phase(ShenandoahPhaseTimings::full_gc_calculate_addresses);
 
@@ -519,8 +642,27 @@ void ShenandoahMarkCompact::phase2_calculate_target_addresses(ShenandoahHeapRegi
   // Compute the new addresses for regular objects
   {
     ShenandoahGCPhase phase(ShenandoahPhaseTimings::full_gc_calculate_addresses_regular);
-    ShenandoahPrepareForCompactionTask prepare_task(_preserved_marks, worker_slices);
+
+    // Size slices by live data, but keep them large enough to amortize the partially
+    // filled last region in every slice.
+    size_t live = 0;
+    for (size_t i = 0; i < heap->num_regions(); i++) {
+      ShenandoahHeapRegion* r = heap->get_region(i);
+      if (!r->is_humongous() && r->is_stw_move_allowed()) {
+        live += r->get_live_data_words();
+      }
+    }
+    size_t nworkers = heap->workers()->active_workers();
+    size_t limit = MAX2(live / (nworkers * SLICES_PER_WORKER),
+                        MIN_SLICE_REGIONS * ShenandoahHeapRegion::region_size_words());
+    slices->set_slice_live_limit(limit);
+
+    ShenandoahPrepareForCompactionTask prepare_task(_preserved_marks, slices);
     heap->workers()->run_task(&prepare_task);
+
+    log_debug(gc)("Full GC compaction slices: %u, live per slice limit: " SIZE_FORMAT "%s",
+                  slices->num_slices(),
+                  byte_size_in_proper_unit(limit * HeapWordSize), proper_unit_for_byte_size(limit * HeapWordSize));
   }
 
   // Compute the new addresses for humongous objects
@@ -661,27 +803,31 @@ public:
 class ShenandoahCompactObjectsTask : public AbstractGangTask {
 private:
   ShenandoahHeap* const _heap;
-  ShenandoahHeapRegionSet** const _worker_slices;
+  ShenandoahCompactionSlices* const _slices;
 
 public:
-  ShenandoahCompactObjectsTask(ShenandoahHeapRegionSet** worker_slices) :
+  ShenandoahCompactObjectsTask(ShenandoahCompactionSlices* slices) :
     AbstractGangTask("Shenandoah Compact Objects Task"),
     _heap(ShenandoahHeap::heap()),
-    _worker_slices(worker_slices) {
+    _slices(slices) {
   }
 
   void work(uint worker_id) {
-    ShenandoahHeapRegionSetIterator slice(_worker_slices[worker_id]);
-
     ShenandoahCompactObjectsClosure cl(worker_id);
-    ShenandoahHeapRegion* r = slice.next();
-    while (r != NULL) {
-      assert(!r->is_humongous(), "must not get humongous regions here");
-      if (r->has_live()) {
-        _heap->marked_object_iterate(r, &cl);
+
+    uint index = _slices->claim_compact_slice();
+    while (index != ShenandoahCompactionSlices::NO_SLICE) {
+      ShenandoahHeapRegionSetIterator slice(_slices->slice(index));
+      ShenandoahHeapRegion* r = slice.next();
+      while (r != NULL) {
+        assert(!r->is_humongous(), "must not get humongous regions here");
+        if (r->has_live()) {
+          _heap->marked_object_iterate(r, &cl);
+        }
+        r->set_top(r->new_top());
+        r = slice.next();
       }
-      r->set_top(r->new_top());
-      r = slice.next();
+      index = _slices->claim_compact_slice();
     }
   }
 };
@@ -736,15 +882,82 @@ public:
   }
 };
 
+// Humongous object move, in region indexes.
+class ShenandoahHumongousMove {
+public:
+  size_t _old_start;
+  size_t _new_start;
+  size_t _words_size;
+
+  ShenandoahHumongousMove() : _old_start(0), _new_start(0), _words_size(0) {}
+  ShenandoahHumongousMove(size_t old_start, size_t new_start, size_t words_size) :
+    _old_start(old_start), _new_start(new_start), _words_size(words_size) {}
+};
+
+// Consecutive moves [first; last] that overlap each other, and have to be copied in order.
+class ShenandoahHumongousMoveChain {
+public:
+  int _first;
+  int _last;
+
+  ShenandoahHumongousMoveChain() : _first(0), _last(-1) {}
+  ShenandoahHumongousMoveChain(int first) : _first(first), _last(first) {}
+};
+
+class ShenandoahCompactHumongousObjectsTask : public AbstractGangTask {
+private:
+  ShenandoahHeap* const _heap;
+  const GrowableArray<ShenandoahHumongousMove>& _moves;
+  const GrowableArray<ShenandoahHumongousMoveChain>& _chains;
+
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(volatile int));
+  volatile int _next_chain;
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, 0);
+
+public:
+  ShenandoahCompactHumongousObjectsTask(const GrowableArray<ShenandoahHumongousMove>& moves,
+                                        const GrowableArray<ShenandoahHumongousMoveChain>& chains) :
+    AbstractGangTask("Shenandoah Compact Humongous Objects Task"),
+    _heap(ShenandoahHeap::heap()),
+    _moves(moves),
+    _chains(chains),
+    _next_chain(0) {
+  }
+
+  void work(uint worker_id) {
+    for (int c = Atomic::add(1, &_next_chain) - 1; c < _chains.length(); c = Atomic::add(1, &_next_chain) - 1) {
+      const ShenandoahHumongousMoveChain& chain = _chains.at(c);
+      for (int m = chain._first; m <= chain._last; m++) {
+        const ShenandoahHumongousMove& move = _moves.at(m);
+        size_t num_regions = ShenandoahHeapRegion::required_regions(move._words_size * HeapWordSize);
+
+        Copy::aligned_conjoint_words(_heap->get_region(move._old_start)->bottom(),
+                                     _heap->get_region(move._new_start)->bottom(),
+                                     ShenandoahHeapRegion::region_size_words()*num_regions);
+
+        oop new_obj = oop(_heap->get_region(move._new_start)->bottom());
+        new_obj->init_mark_raw();
+      }
+    }
+  }
+};
+
 void ShenandoahMarkCompact::compact_humongous_objects() {
   // Compact humongous regions, based on their fwdptr objects.
   //
-  // This code is serial, because doing the in-slice parallel sliding is tricky. In most cases,
-  // humongous regions are already compacted, and do not require further moves, which alleviates
-  // sliding costs. We may consider doing this in parallel in future.
+  // Humongous objects slide towards the end of the heap, and a move can only be copied after
+  // the moves whose regions it overwrites have been copied. Scanning the heap backwards, such
+  // overlapping moves are grouped into chains that are copied in order, while independent
+  // chains are copied in parallel. Region states are updated serially afterwards, as it
+  // requires the heap lock.
 
   ShenandoahHeap* heap = ShenandoahHeap::heap();
 
+  ResourceMark rm;
+  GrowableArray<ShenandoahHumongousMove> moves;
+  GrowableArray<ShenandoahHumongousMoveChain> chains;
+  size_t chain_low = 0;
+
   for (size_t c = heap->num_regions(); c > 0; c--) {
     ShenandoahHeapRegion* r = heap->get_region(c - 1);
     if (r->is_humongous_start()) {
@@ -757,45 +970,63 @@ void ShenandoahMarkCompact::compact_humongous_objects() {
       size_t num_regions = ShenandoahHeapRegion::required_regions(words_size * HeapWordSize);
 
       size_t old_start = r->region_number();
-      size_t old_end   = old_start + num_regions - 1;
       size_t new_start = heap->heap_region_index_containing(old_obj->forwardee());
       size_t new_end   = new_start + num_regions - 1;
-      assert(old_start != new_start, "must be real move");
+      assert(old_start < new_start, "must be real move towards the end of the heap");
       assert(r->is_stw_move_allowed(), "Region " SIZE_FORMAT " should be movable", r->region_number());
 
-      Copy::aligned_conjoint_words(heap->get_region(old_start)->bottom(),
-                                   heap->get_region(new_start)->bottom(),
-                                   ShenandoahHeapRegion::region_size_words()*num_regions);
+      // All moves in the current chain are above chain_low. If this move does not reach there,
+      // it cannot overwrite anything the chain has yet to copy, and starts a new chain.
+      if (chains.is_empty() || new_end < chain_low) {
+        chains.append(ShenandoahHumongousMoveChain(moves.length()));
+      } else {
+        chains.at(chains.length() - 1)._last = moves.length();
+      }
+      moves.append(ShenandoahHumongousMove(old_start, new_start, words_size));
+      chain_low = old_start;
+    }
+  }
 
-      oop new_obj = oop(heap->get_region(new_start)->bottom());
-      new_obj->init_mark_raw();
+  if (moves.is_empty()) {
+    return;
+  }
 
-      {
-        for (size_t c = old_start; c <= old_end; c++) {
-          ShenandoahHeapRegion* r = heap->get_region(c);
-          r->make_regular_bypass();
-          r->set_top(r->bottom());
-        }
+  ShenandoahCompactHumongousObjectsTask task(moves, chains);
+  heap->workers()->run_task(&task);
 
-        for (size_t c = new_start; c <= new_end; c++) {
-          ShenandoahHeapRegion* r = heap->get_region(c);
-          if (c == new_start) {
-            r->make_humongous_start_bypass();
-          } else {
-            r->make_humongous_cont_bypass();
-          }
-
-          // Trailing region may be non-full, record the remainder there
-          size_t remainder = words_size & ShenandoahHeapRegion::region_size_words_mask();
-          if ((c == new_end) && (remainder != 0)) {
-            r->set_top(r->bottom() + remainder);
-          } else {
-            r->set_top(r->end());
-          }
-
-          r->reset_alloc_metadata_to_shared();
-        }
+  for (int m = 0; m < moves.length(); m++) {
+    const ShenandoahHumongousMove& move = moves.at(m);
+    size_t words_size = move._words_size;
+    size_t num_regions = ShenandoahHeapRegion::required_regions(words_size * HeapWordSize);
+
+    size_t old_start = move._old_start;
+    size_t old_end   = old_start + num_regions - 1;
+    size_t new_start = move._new_start;
+    size_t new_end   = new_start + num_regions - 1;
+
+    for (size_t c = old_start; c <= old_end; c++) {
+      ShenandoahHeapRegion* r = heap->get_region(c);
+      r->make_regular_bypass();
+      r->set_top(r->bottom());
+    }
+
+    for (size_t c = new_start; c <= new_end; c++) {
+      ShenandoahHeapRegion* r = heap->get_region(c);
+      if (c == new_start) {
+        r->make_humongous_start_bypass();
+      } else {
+        r->make_humongous_cont_bypass();
+      }
+
+      // Trailing region may be non-full, record the remainder there
+      size_t remainder = words_size & ShenandoahHeapRegion::region_size_words_mask();
+      if ((c == new_end) && (remainder != 0)) {
+        r->set_top(r->bottom() + remainder);
+      } else {
+        r->set_top(r->end());
       }
+
+      r->reset_alloc_metadata_to_shared();
     }
   }
 }
@@ -829,7 +1060,7 @@ public:
   }
 };
 
-void ShenandoahMarkCompact::phase4_compact_objects(ShenandoahHeapRegionSet** worker_slices) {
+void ShenandoahMarkCompact::phase4_compact_objects(ShenandoahCompactionSlices* slices) {
   GCTraceTime(Info, gc, phases) time("Phase 4: Move objects", _gc_timer);
   ShenandoahGCPhase compaction_phase(ShenandoahPhaseTimings::full_gc_copy_objects);
 
@@ -838,7 +1069,8 @@ void ShenandoahMarkCompact::phase4_compact_objects(ShenandoahHeapRegionSet** wor
   // Compact regular objects first
   {
     ShenandoahGCPhase phase(ShenandoahPhaseTimings::full_gc_copy_objects_regular);
-    ShenandoahCompactObjectsTask compact_task(worker_slices);
+    slices->prepare_for_compaction();
+    ShenandoahCompactObjectsTask compact_task(slices);
     heap->workers()->run_task(&compact_task);
   }
 
@@ -45,15 +45,25 @@
  *    all references in live objects by what's stored in the target object's fwdptr.
  * 4. Compact the heap by copying all live objects to their new location.
  *
- * Parallelization is handled by assigning each GC worker the slice of the heap (the set of regions)
- * where it does sliding compaction, without interfering with other threads.
+ * Parallelization is handled by splitting the heap into slices (sets of regions) where sliding
+ * compaction happens without interfering with other slices. Workers create slices on demand while
+ * calculating the new addresses, closing a slice once it holds enough live data, and claim slices
+ * dynamically during compaction, largest first. Independent chains of humongous moves are copied
+ * in parallel.
  */
 
 class PreservedMarksSet;
+class ShenandoahCompactionSlices;
 
 class ShenandoahMarkCompact : public CHeapObj<mtGC> {
   friend class ShenandoahPrepareForCompactionObjectClosure;
 private:
+  // Number of slices per worker to split the live data into
+  static const size_t SLICES_PER_WORKER = 4;
+
+  // Minimum amount of live data in a slice, in regions
+  static const size_t MIN_SLICE_REGIONS = 16;
+
   GCTimer* _gc_timer;
 
   PreservedMarksSet* _preserved_marks;
@@ -66,9 +76,9 @@ public:
 
 private:
   void phase1_mark_heap();
-  void phase2_calculate_target_addresses(ShenandoahHeapRegionSet** worker_slices);
+  void phase2_calculate_target_addresses(ShenandoahCompactionSlices* slices);
   void phase3_update_references();
-  void phase4_compact_objects(ShenandoahHeapRegionSet** worker_slices);
+  void phase4_compact_objects(ShenandoahCompactionSlices* slices);
 
   void calculate_target_humongous_objects();
   void compact_humongous_objects();
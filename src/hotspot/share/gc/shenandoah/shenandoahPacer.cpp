@@ -25,7 +25,9 @@
 
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
-#include "gc/shenandoah/shenandoahPacer.hpp"
+#include "gc/shenandoah/shenandoahPacer.inline.hpp"
+#include "gc/shenandoah/shenandoahThreadLocalData.hpp"
+#include "runtime/mutexLocker.hpp"
 
 /*
  * In normal concurrent cycle, we have to pace the application to let GC finish.
@@ -194,13 +196,19 @@ void ShenandoahPacer::restart_with(size_t non_taxable_bytes, double tax_rate) {
   Atomic::xchg((intptr_t)initial, &_budget);
   Atomic::store(tax_rate, &_tax_rate);
   Atomic::inc(&_epoch);
+
+  // Shake up stalled waiters after budget update.
+  _need_notify_waiters.try_set();
 }
 
 bool ShenandoahPacer::claim_for_alloc(size_t words, bool force) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
   intptr_t tax = MAX2<intptr_t>(1, words * Atomic::load(&_tax_rate));
+  return claim_budget(tax, force);
+}
 
+bool ShenandoahPacer::claim_budget(intptr_t tax, bool force) {
   intptr_t cur = 0;
   intptr_t new_val = 0;
   do {
@@ -217,13 +225,15 @@ bool ShenandoahPacer::claim_for_alloc(size_t words, bool force) {
 void ShenandoahPacer::unpace_for_alloc(intptr_t epoch, size_t words) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
-  if (_epoch != epoch) {
+  Thread* thread = Thread::current();
+  if (_epoch != epoch || ShenandoahThreadLocalData::paced_epoch(thread) != epoch) {
     // Stale ticket, no need to unpace.
     return;
   }
 
+  // Return the unused budget to this thread, it would be spent by its next allocations.
   intptr_t tax = MAX2<intptr_t>(1, words * Atomic::load(&_tax_rate));
-  Atomic::add(tax, &_budget);
+  ShenandoahThreadLocalData::set_paced_budget(thread, ShenandoahThreadLocalData::paced_budget(thread) + tax);
 }
 
 intptr_t ShenandoahPacer::epoch() {
@@ -233,50 +243,90 @@ intptr_t ShenandoahPacer::epoch() {
 void ShenandoahPacer::pace_for_alloc(size_t words) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
-  // Fast path: try to allocate right away
-  if (claim_for_alloc(words, false)) {
+  Thread* thread = Thread::current();
+  intptr_t epoch = Atomic::load(&_epoch);
+  double tax_rate = Atomic::load(&_tax_rate);
+  intptr_t tax = MAX2<intptr_t>(1, words * tax_rate);
+
+  // Budget claimed during the previous pacing phase is stale, drop it.
+  if (ShenandoahThreadLocalData::paced_epoch(thread) != epoch) {
+    ShenandoahThreadLocalData::set_paced_epoch(thread, epoch);
+    ShenandoahThreadLocalData::set_paced_budget(thread, 0);
+  }
+
+  // Fast path: spend the budget this thread had claimed before
+  intptr_t local = ShenandoahThreadLocalData::paced_budget(thread);
+  if (local >= tax) {
+    ShenandoahThreadLocalData::set_paced_budget(thread, local - tax);
+    return;
+  }
+
+  // Claim the budget from the shared pool in TLAB-sized chunks, so that
+  // the following allocations by this thread do not have to touch it.
+  intptr_t need = tax - local;
+  intptr_t chunk = MAX2<intptr_t>(need, thread->tlab().desired_size() * tax_rate);
+  if (claim_budget(chunk, false)) {
+    ShenandoahThreadLocalData::set_paced_budget(thread, chunk - need);
+    return;
+  }
+  ShenandoahThreadLocalData::set_paced_budget(thread, 0);
+  if (chunk > need && claim_budget(need, false)) {
+    return;
+  }
+
+  // Forcefully claim the budget: it may go negative at this point, and
+  // GC should replenish for this and subsequent allocations. After this claim,
+  // we would wait a bit until our claim is matched by additional progress,
+  // or the time budget depletes.
+  claim_budget(need, true);
+
+  // Threads that are attaching should not block at all: they are not
+  // fully initialized yet. Blocking them would be awkward.
+  // This is probably the path that allocates the thread oop itself.
+  if (JavaThread::current()->is_attaching_via_jni()) {
     return;
   }
 
-  size_t max = ShenandoahPacingMaxDelay;
   double start = os::elapsedTime();
 
-  size_t total = 0;
-  size_t cur = 0;
+  size_t max_ms = ShenandoahPacingMaxDelay;
+  size_t total_ms = 0;
 
   while (true) {
     // We could instead assist GC, but this would suffice for now.
-    // This code should also participate in safepointing.
-    // Perform the exponential backoff, limited by max.
-
-    cur = cur * 2;
-    if (total + cur > max) {
-      cur = (max > total) ? (max - total) : 0;
-    }
-    cur = MAX2<size_t>(1, cur);
-
-    JavaThread::current()->sleep(cur);
+    size_t cur_ms = (max_ms > total_ms) ? (max_ms - total_ms) : 1;
+    wait(cur_ms);
 
     double end = os::elapsedTime();
-    total = (size_t)((end - start) * 1000);
-
-    if (total > max) {
-      // Spent local time budget to wait for enough GC progress.
-      // Breaking out and allocating anyway, which may mean we outpace GC,
-      // and start Degenerated GC cycle.
-      _delays.add(total);
-
-      // Forcefully claim the budget: it may go negative at this point, and
-      // GC should replenish for this and subsequent allocations
-      claim_for_alloc(words, true);
+    total_ms = (size_t)((end - start) * 1000);
+
+    if (total_ms > max_ms || Atomic::load(&_budget) >= 0) {
+      // Exiting if either:
+      //  a) Spent local time budget to wait for enough GC progress.
+      //     Breaking out and allocating anyway, which may mean we outpace GC,
+      //     and start Degenerated GC cycle.
+      //  b) The budget had been replenished, which means our claim is satisfied.
+      _delays.add(total_ms);
       break;
     }
+  }
+}
 
-    if (claim_for_alloc(words, false)) {
-      // Acquired enough permit, nice. Can allocate now.
-      _delays.add(total);
-      break;
-    }
+void ShenandoahPacer::wait(size_t time_ms) {
+  // Perform timed wait. It works like sleep(), except without modifying
+  // the thread interruptible status. MonitorLocker also checks for safepoints.
+  assert(time_ms > 0, "Should not call this with zero argument, as it would stall until notify");
+  assert(time_ms <= LONG_MAX, "Sanity");
+  MonitorLocker locker(_wait_monitor);
+  _wait_monitor->wait((long)time_ms);
+}
+
+void ShenandoahPacer::notify_waiters() {
+  // Wake up all stalled threads at once, instead of waking them up
+  // one by one with every budget update.
+  if (_need_notify_waiters.try_unset()) {
+    MonitorLocker locker(_wait_monitor);
+    _wait_monitor->notify_all();
   }
 }
 
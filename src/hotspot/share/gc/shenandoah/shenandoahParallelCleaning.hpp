@@ -44,6 +44,20 @@ public:
   void work(uint worker_id);
 };
 
+// Perform cleaning of the weak roots that are not backed by OopStorage at a pause,
+// OopStorage backed weak roots are cleaned concurrently afterwards
+template <typename IsAlive, typename KeepAlive>
+class ShenandoahSerialWeakRootsCleaningTask : public AbstractGangTask {
+protected:
+  IsAlive*                _is_alive;
+  KeepAlive*              _keep_alive;
+public:
+  ShenandoahSerialWeakRootsCleaningTask(IsAlive* is_alive, KeepAlive* keep_alive);
+  ~ShenandoahSerialWeakRootsCleaningTask();
+
+  void work(uint worker_id);
+};
+
 // Perform class unloading at a pause
 class ShenandoahClassUnloadingTask : public AbstractGangTask {
 private:
@@ -61,4 +61,36 @@ void ShenandoahParallelWeakRootsCleaningTask<IsAlive, KeepAlive>::work(uint work
   }
 }
 
+template<typename IsAlive, typename KeepAlive>
+ShenandoahSerialWeakRootsCleaningTask<IsAlive, KeepAlive>::ShenandoahSerialWeakRootsCleaningTask(IsAlive* is_alive,
+                                                                                                 KeepAlive* keep_alive) :
+  AbstractGangTask("Serial Weak Root Cleaning Task"),
+  _is_alive(is_alive), _keep_alive(keep_alive) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+
+  if (ShenandoahStringDedup::is_enabled()) {
+    StringDedup::gc_prologue(false);
+  }
+}
+
+template<typename IsAlive, typename KeepAlive>
+ShenandoahSerialWeakRootsCleaningTask<IsAlive, KeepAlive>::~ShenandoahSerialWeakRootsCleaningTask() {
+  if (StringDedup::is_enabled()) {
+    StringDedup::gc_epilogue();
+  }
+}
+
+template<typename IsAlive, typename KeepAlive>
+void ShenandoahSerialWeakRootsCleaningTask<IsAlive, KeepAlive>::work(uint worker_id) {
+  if (worker_id == 0) {
+    for (WeakProcessorPhases::Iterator it = WeakProcessorPhases::serial_iterator(); !it.is_end(); ++it) {
+      WeakProcessorPhases::processor(*it)(_is_alive, _keep_alive);
+    }
+  }
+
+  if (ShenandoahStringDedup::is_enabled()) {
+    ShenandoahStringDedup::parallel_oops_do(_is_alive, _keep_alive, worker_id);
+  }
+}
+
 #endif // SHARE_GC_SHENANDOAH_SHENANDOAHPARALLELCLEANING_INLINE_HPP
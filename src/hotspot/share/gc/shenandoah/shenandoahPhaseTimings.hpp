@@ -103,6 +103,7 @@ class outputStream;
   f(retire_tlabs,                                   "  Retire TLABs")                   \
   f(trash_cset,                                     "  Trash CSet")                     \
   f(prepare_evac,                                   "  Prepare Evacuation")             \
+  f(purge_weak_roots,                               "  Purge Weak Roots")               \
                                                                                         \
   /* Per-thread timer block, should have "roots" counters in consistent order */        \
   f(init_evac,                                      "  Initial Evacuation")             \
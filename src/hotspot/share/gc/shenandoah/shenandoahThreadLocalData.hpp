@@ -43,6 +43,8 @@ private:
   size_t _gclab_size;
   uint  _worker_id;
   bool _force_satb_flush;
+  intptr_t _paced_budget;
+  intptr_t _paced_epoch;
 
   ShenandoahThreadLocalData() :
     _gc_state(0),
@@ -51,7 +53,9 @@ private:
     _gclab(NULL),
     _gclab_size(0),
     _worker_id(INVALID_WORKER_ID),
-    _force_satb_flush(false) {
+    _force_satb_flush(false),
+    _paced_budget(0),
+    _paced_epoch(0) {
   }
 
   ~ShenandoahThreadLocalData() {
@@ -139,6 +143,22 @@ public:
     data(thread)->_gclab_size = v;
   }
 
+  static intptr_t paced_budget(Thread* thread) {
+    return data(thread)->_paced_budget;
+  }
+
+  static void set_paced_budget(Thread* thread, intptr_t v) {
+    data(thread)->_paced_budget = v;
+  }
+
+  static intptr_t paced_epoch(Thread* thread) {
+    return data(thread)->_paced_epoch;
+  }
+
+  static void set_paced_epoch(Thread* thread, intptr_t v) {
+    data(thread)->_paced_epoch = v;
+  }
+
 #ifdef ASSERT
   static void set_evac_allowed(Thread* thread, bool evac_allowed) {
     if (evac_allowed) {
@@ -459,7 +459,8 @@ public:
         ShenandoahVerifyOopClosure cl(&stack, _bitmap, _ld,
                                       ShenandoahMessageBuffer("%s, Roots", _label),
                                       _options);
-        if (_heap->unload_classes()) {
+        // Weak roots that are left for concurrent cleaning may still refer to dead objects.
+        if (_heap->unload_classes() || _heap->is_concurrent_weak_root_in_progress()) {
           _verifier->strong_roots_do(&cl);
         } else {
           _verifier->roots_do(&cl);
@@ -369,6 +369,10 @@
   experimental(bool, ShenandoahConcurrentScanCodeRoots, true,               \
           "Scan code roots concurrently, instead of during a pause")        \
                                                                             \
+  experimental(bool, ShenandoahConcurrentWeakRootCleaning, true,            \
+          "Clean OopStorage backed weak roots concurrently, instead of "    \
+          "during a pause")                                                 \
+                                                                            \
   experimental(uintx, ShenandoahCodeRootsStyle, 2,                          \
           "Use this style to scan code cache:"                              \
           " 0 - sequential iterator;"                                       \
@@ -61,6 +61,7 @@ public:
   static uintptr_t marked1(uintptr_t value);
   static uintptr_t remapped(uintptr_t value);
   static uintptr_t remapped_or_null(uintptr_t value);
+  static uintptr_t uncolored(uintptr_t value);
 };
 
 #endif // SHARE_GC_Z_ZADDRESS_HPP
@@ -83,8 +83,13 @@ inline bool ZAddress::is_remapped(uintptr_t value) {
 }
 
 inline bool ZAddress::is_in(uintptr_t value) {
-  // Check that exactly one non-offset bit is set
-  if (!is_power_of_2(value & ~ZAddressOffsetMask)) {
+  // Check that the base bits are set
+  if ((value & ZAddressBase) != ZAddressBase) {
+    return false;
+  }
+
+  // Check that exactly one non-offset, non-base bit is set
+  if (!is_power_of_2(value & ~(ZAddressOffsetMask | ZAddressBase))) {
     return false;
   }
 
@@ -132,4 +137,10 @@ inline uintptr_t ZAddress::remapped_or_null(uintptr_t value) {
   return is_null(value) ? 0 : remapped(value);
 }
 
+inline uintptr_t ZAddress::uncolored(uintptr_t value) {
+  // Only meaningful as a memory address when the colors are ignored by
+  // the hardware, in which case the heap is only mapped at this view
+  return address(offset(value));
+}
+
 #endif // SHARE_GC_Z_ZADDRESS_INLINE_HPP
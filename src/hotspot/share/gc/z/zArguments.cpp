@@ -98,6 +98,11 @@ void ZArguments::initialize() {
 
   // Initialize platform specific arguments
   initialize_platform();
+
+  // Heap views can not be verified when they share a single mapping
+  if (ZUseTBI) {
+    FLAG_SET_DEFAULT(ZVerifyViews, false);
+  }
 }
 
 size_t ZArguments::conservative_max_heap_alignment() {
@@ -367,6 +367,9 @@ public:
     // Update statistics
     ZStatCycle::at_end(boost_factor);
 
+    // Adjust heap size to the GC CPU overhead
+    ZHeap::heap()->adapt_soft_max_capacity();
+
     // Update data used by soft reference policy
     Universe::update_heap_info_at_gc();
   }
@@ -143,6 +143,9 @@ const size_t      ZMarkPartialArrayMinSize      = (size_t)1 << ZMarkPartialArray
 const size_t      ZMarkProactiveFlushMax        = 10;
 const size_t      ZMarkTerminateFlushMax        = 3;
 
+// Number of followed entries between checks for idle workers to rebalance work to
+const size_t      ZMarkRebalanceInterval        = 1024;
+
 // Try complete mark timeout
 const uint64_t    ZMarkCompleteTimeout          = 1; // ms
 
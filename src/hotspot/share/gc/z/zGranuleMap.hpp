@@ -29,10 +29,13 @@
 template<typename T>
 class ZGranuleMapIterator;
 
+class ZPageTableParallelIterator;
+
 template <typename T>
 class ZGranuleMap {
   friend class VMStructs;
   friend class ZGranuleMapIterator<T>;
+  friend class ZPageTableParallelIterator;
 
 private:
   const size_t _size;
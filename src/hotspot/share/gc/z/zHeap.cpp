@@ -34,12 +34,14 @@
 #include "gc/z/zRelocationSetSelector.hpp"
 #include "gc/z/zResurrection.hpp"
 #include "gc/z/zStat.hpp"
+#include "gc/z/zTask.hpp"
 #include "gc/z/zThread.hpp"
 #include "gc/z/zVerify.hpp"
 #include "gc/z/zWorkers.inline.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/debug.hpp"
@@ -63,7 +65,7 @@ ZHeap::ZHeap() :
     _reference_processor(&_workers),
     _weak_roots_processor(&_workers),
     _relocate(&_workers),
-    _relocation_set(),
+    _relocation_set(&_workers, &_forwarding_table),
     _unload(&_workers),
     _serviceability(heap_min_size(), heap_max_size()) {
   // Install global heap instance
@@ -367,58 +369,68 @@ void ZHeap::process_non_strong_references() {
   _reference_processor.enqueue_references();
 }
 
-void ZHeap::select_relocation_set() {
-  // Do not allow pages to be deleted
-  _page_allocator.enable_deferred_delete();
+class ZRegisterRelocatablePagesTask : public ZTask {
+private:
+  ZHeap* const                   _heap;
+  ZRelocationSetSelector* const  _selector;
+  ZPageTableParallelIterator     _iter;
 
-  // Register relocatable pages with selector
-  ZRelocationSetSelector selector;
-  ZPageTableIterator pt_iter(&_page_table);
-  for (ZPage* page; pt_iter.next(&page);) {
+public:
+  ZRegisterRelocatablePagesTask(ZHeap* heap, const ZPageTable* page_table, ZRelocationSetSelector* selector) :
+      ZTask("ZRegisterRelocatablePagesTask"),
+      _heap(heap),
+      _selector(selector),
+      _iter(page_table) {}
+
+  void do_page(ZPage* page) {
     if (!page->is_relocatable()) {
       // Not relocatable, don't register
-      continue;
+      return;
     }
 
     if (page->is_marked()) {
       // Register live page
-      selector.register_live_page(page);
+      _selector->register_live_page(ZThread::worker_id(), page);
     } else {
       // Register garbage page
-      selector.register_garbage_page(page);
+      _selector->register_garbage_page(ZThread::worker_id(), page);
 
       // Reclaim page immediately
-      free_page(page, true /* reclaimed */);
+      _heap->free_page(page, true /* reclaimed */);
     }
   }
 
+  virtual void work() {
+    _iter.pages_do(this);
+  }
+};
+
+void ZHeap::select_relocation_set() {
+  // Do not allow pages to be deleted
+  _page_allocator.enable_deferred_delete();
+
+  // Register relocatable pages with selector
+  ZRelocationSetSelector selector(_workers.nconcurrent());
+  ZRegisterRelocatablePagesTask task(this, &_page_table, &selector);
+  _workers.run_concurrent(&task);
+
   // Allow pages to be deleted
   _page_allocator.disable_deferred_delete();
 
-  // Select pages to relocate
+  // Select pages to relocate and setup forwarding table
   selector.select(&_relocation_set);
 
-  // Setup forwarding table
-  ZRelocationSetIterator rs_iter(&_relocation_set);
-  for (ZForwarding* forwarding; rs_iter.next(&forwarding);) {
-    _forwarding_table.insert(forwarding);
-  }
-
   // Update statistics
-  ZStatRelocation::set_at_select_relocation_set(selector.relocating());
+  ZStatRelocation::set_at_select_relocation_set(selector.relocating(),
+                                                selector.young_live(),
+                                                selector.young_garbage());
   ZStatHeap::set_at_select_relocation_set(selector.live(),
                                           selector.garbage(),
                                           reclaimed());
 }
 
 void ZHeap::reset_relocation_set() {
-  // Reset forwarding table
-  ZRelocationSetIterator iter(&_relocation_set);
-  for (ZForwarding* forwarding; iter.next(&forwarding);) {
-    _forwarding_table.remove(forwarding);
-  }
-
-  // Reset relocation set
+  // Reset forwarding table and relocation set
   _relocation_set.reset();
 }
 
@@ -453,6 +465,42 @@ void ZHeap::relocate() {
                                  used(), used_high(), used_low());
 }
 
+void ZHeap::adapt_soft_max_capacity() {
+  if (!ZAdaptiveHeap || ZStatCycle::interval().num() == 0) {
+    // Disabled, or not enough cycles to estimate the GC CPU overhead
+    return;
+  }
+
+  // Estimate the fraction of the available CPU time that is spent on GC.
+  // The normalized duration is the duration a cycle would have had without
+  // boosting, so it is scaled by the number of non-boosted worker threads.
+  const double duration_of_gc = ZStatCycle::normalized_duration().davg();
+  const double gc_cpu_time = duration_of_gc * nconcurrent_no_boost_worker_threads();
+  const double cpu_time = ZStatCycle::interval().davg() * os::active_processor_count();
+  const double gc_cpu_percent = percent_of(gc_cpu_time, cpu_time);
+
+  // For a given allocation rate, the GC frequency, and hence the GC CPU
+  // overhead, is roughly inversely proportional to the headroom above the
+  // live set. Scale the headroom towards the target overhead, but limit the
+  // adjustment made after each cycle to dampen oscillations.
+  const size_t live = ZStatHeap::live_at_mark_end();
+  const size_t old_capacity = _page_allocator.adaptive_max_capacity();
+  const size_t headroom = MAX2(old_capacity - MIN2(old_capacity, live), ZGranuleSize);
+  const double factor = MIN2(MAX2(gc_cpu_percent / ZAdaptiveHeapCPUTarget, 0.5), 2.0);
+
+  // Never shrink the headroom below what is expected to be allocated while
+  // a cycle is running, since that would lead to allocation stalls.
+  const double max_alloc_rate = ZStatAllocRate::avg() * ZAllocationSpikeTolerance;
+  const size_t min_headroom = max_alloc_rate * duration_of_gc;
+
+  _page_allocator.set_adaptive_max_capacity(live + MAX2((size_t)(headroom * factor), min_headroom));
+
+  log_debug(gc, heap)("Adaptive Heap: GC CPU %.1f%% (Target %.1f%%), Soft Max Capacity: "
+                      SIZE_FORMAT "M -> " SIZE_FORMAT "M",
+                      gc_cpu_percent, ZAdaptiveHeapCPUTarget,
+                      old_capacity / M, _page_allocator.adaptive_max_capacity() / M);
+}
+
 void ZHeap::object_iterate(ObjectClosure* cl, bool visit_weaks) {
   assert(SafepointSynchronize::is_at_safepoint(), "Should be at safepoint");
 
@@ -122,6 +122,9 @@ public:
   // Uncommit memory
   uint64_t uncommit(uint64_t delay);
 
+  // Adaptive heap sizing
+  void adapt_soft_max_capacity();
+
   // Object allocation
   uintptr_t alloc_tlab(size_t size);
   uintptr_t alloc_object(size_t size);
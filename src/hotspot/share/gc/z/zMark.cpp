@@ -66,8 +66,14 @@ ZMark::ZMark(ZWorkers* workers, ZPageTable* page_table) :
     _work_terminateflush(true),
     _work_nproactiveflush(0),
     _work_nterminateflush(0),
+    _work_nterminate(0),
+    _work_nrebalance(0),
+    _work_terminate_ticks(0),
     _nproactiveflush(0),
     _nterminateflush(0),
+    _nterminate(0),
+    _nrebalance(0),
+    _terminate_ticks(0),
     _ntrycomplete(0),
     _ncontinue(0),
     _nworkers(0) {}
@@ -92,6 +98,9 @@ void ZMark::prepare_mark() {
   // Reset flush/continue counters
   _nproactiveflush = 0;
   _nterminateflush = 0;
+  _nterminate = 0;
+  _nrebalance = 0;
+  _terminate_ticks = 0;
   _ntrycomplete = 0;
   _ncontinue = 0;
 
@@ -195,12 +204,21 @@ void ZMark::prepare_work() {
   // Reset flush counters
   _work_nproactiveflush = _work_nterminateflush = 0;
   _work_terminateflush = true;
+
+  // Reset termination and rebalance counters
+  _work_nterminate = _work_nrebalance = 0;
+  _work_terminate_ticks = 0;
 }
 
 void ZMark::finish_work() {
   // Accumulate proactive/terminate flush counters
   _nproactiveflush += _work_nproactiveflush;
   _nterminateflush += _work_nterminateflush;
+
+  // Accumulate termination and rebalance counters
+  _nterminate += _work_nterminate;
+  _nrebalance += _work_nrebalance;
+  _terminate_ticks += _work_terminate_ticks;
 }
 
 bool ZMark::is_array(uintptr_t addr) const {
@@ -366,6 +384,7 @@ void ZMark::mark_and_follow(ZMarkCache* cache, ZMarkStackEntry entry) {
 template <typename T>
 bool ZMark::drain(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks, ZMarkCache* cache, T* timeout) {
   ZMarkStackEntry entry;
+  size_t nfollowed = 0;
 
   // Drain stripe stacks
   while (stacks->pop(&_allocator, &_stripes, stripe, entry)) {
@@ -376,6 +395,12 @@ bool ZMark::drain(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks, ZMarkCach
       // Timeout
       return false;
     }
+
+    // Check for idle workers
+    if (++nfollowed == ZMarkRebalanceInterval) {
+      nfollowed = 0;
+      try_rebalance(stacks);
+    }
   }
 
   // Success
@@ -392,6 +417,22 @@ bool ZMark::drain_and_flush(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks,
   return success;
 }
 
+void ZMark::try_rebalance(ZMarkThreadLocalStacks* stacks) {
+  if (!_terminate.has_idle_workers()) {
+    // All workers are busy
+    return;
+  }
+
+  // Other workers ran out of work. Publish the thread local stacks, which
+  // includes partial arrays split off to other stripes, to make them
+  // available for stealing. Without this, a deep object graph would be
+  // followed by a single worker, since its stacks rarely fill up and get
+  // published on their own.
+  if (stacks->flush(&_allocator, &_stripes)) {
+    Atomic::inc(&_work_nrebalance);
+  }
+}
+
 bool ZMark::try_steal(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks) {
   // Try to steal a stack from another stripe
   for (ZMarkStripe* victim_stripe = _stripes.stripe_next(stripe);
@@ -474,9 +515,7 @@ bool ZMark::try_proactive_flush() {
   return try_flush(&_work_nproactiveflush);
 }
 
-bool ZMark::try_terminate() {
-  ZStatTimer timer(ZSubPhaseConcurrentMarkTryTerminate);
-
+bool ZMark::try_terminate_inner() {
   if (_terminate.enter_stage0()) {
     // Last thread entered stage 0, flush
     if (Atomic::load(&_work_terminateflush) &&
@@ -521,6 +560,20 @@ bool ZMark::try_terminate() {
   }
 }
 
+bool ZMark::try_terminate() {
+  ZStatTimer timer(ZSubPhaseConcurrentMarkTryTerminate);
+  const Ticks start = Ticks::now();
+
+  const bool terminate = try_terminate_inner();
+
+  // Update statistics
+  const Tickspan duration = Ticks::now() - start;
+  Atomic::inc(&_work_nterminate);
+  Atomic::add((uint64_t)duration.value(), &_work_terminate_ticks);
+
+  return terminate;
+}
+
 class ZMarkNoTimeout : public StackObj {
 public:
   bool has_expired() {
@@ -734,7 +787,8 @@ bool ZMark::end() {
   }
 
   // Update statistics
-  ZStatMark::set_at_mark_end(_nproactiveflush, _nterminateflush, _ntrycomplete, _ncontinue);
+  ZStatMark::set_at_mark_end(_nproactiveflush, _nterminateflush, _ntrycomplete, _ncontinue,
+                             _nterminate, _nrebalance, TimeHelper::counter_to_millis(_terminate_ticks));
 
   // Mark completed
   return true;
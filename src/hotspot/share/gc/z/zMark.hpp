@@ -49,8 +49,14 @@ private:
   volatile bool       _work_terminateflush;
   volatile size_t     _work_nproactiveflush;
   volatile size_t     _work_nterminateflush;
+  volatile size_t     _work_nterminate;
+  volatile size_t     _work_nrebalance;
+  volatile uint64_t   _work_terminate_ticks;
   size_t              _nproactiveflush;
   size_t              _nterminateflush;
+  size_t              _nterminate;
+  size_t              _nrebalance;
+  uint64_t            _terminate_ticks;
   size_t              _ntrycomplete;
   size_t              _ncontinue;
   uint                _nworkers;
@@ -77,11 +83,13 @@ private:
                                              ZMarkThreadLocalStacks* stacks,
                                              ZMarkCache* cache,
                                              T* timeout);
+  void try_rebalance(ZMarkThreadLocalStacks* stacks);
   bool try_steal(ZMarkStripe* stripe, ZMarkThreadLocalStacks* stacks);
   void idle() const;
   bool flush(bool at_safepoint);
   bool try_proactive_flush();
   bool try_flush(volatile size_t* nflush);
+  bool try_terminate_inner();
   bool try_terminate();
   bool try_complete();
   bool try_end();
@@ -49,6 +49,8 @@ public:
 
   bool enter_stage1();
   bool try_exit_stage1();
+
+  bool has_idle_workers() const;
 };
 
 #endif // SHARE_GC_Z_ZMARKTERMINATE_HPP
@@ -84,4 +84,8 @@ inline bool ZMarkTerminate::try_exit_stage1() {
   return try_exit_stage(&_nworking_stage1);
 }
 
+inline bool ZMarkTerminate::has_idle_workers() const {
+  return Atomic::load(&_nworking_stage0) < _nworkers;
+}
+
 #endif // SHARE_GC_Z_ZMARKTERMINATE_INLINE_HPP
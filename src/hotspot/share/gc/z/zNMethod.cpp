@@ -358,7 +358,7 @@ void ZNMethod::unlink(ZWorkers* workers, bool unloading_occurred) {
     }
 
     // Cleaning failed because we ran out of transitional IC stubs,
-    // so we have to refill and try again. Refilling requires taking
+    // so we have to refill and try again. Refilling may require taking
     // a safepoint, so we temporarily leave the suspendible thread set.
     SuspendibleThreadSetLeaver sts;
     InlineCacheBuffer::refill_ic_stubs();
@@ -75,6 +75,7 @@ public:
 
   bool is_allocating() const;
   bool is_relocatable() const;
+  bool is_young() const;
 
   bool is_mapped() const;
   void set_pre_mapped();
@@ -153,6 +153,12 @@ inline bool ZPage::is_relocatable() const {
   return _seqnum < ZGlobalSeqNum;
 }
 
+inline bool ZPage::is_young() const {
+  // Allocated during the previous cycle, i.e. the current
+  // cycle is the first one to mark the objects on this page.
+  return _seqnum + 1 == ZGlobalSeqNum;
+}
+
 inline bool ZPage::is_mapped() const {
   return _seqnum > 0;
 }
@@ -35,6 +35,7 @@
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTracer.inline.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/init.hpp"
 #include "runtime/java.hpp"
 #include "utilities/debug.hpp"
@@ -101,6 +102,7 @@ ZPageAllocator::ZPageAllocator(size_t min_capacity,
     _max_capacity(max_capacity),
     _max_reserve(max_reserve),
     _current_max_capacity(max_capacity),
+    _adaptive_max_capacity(max_capacity),
     _capacity(0),
     _used_high(0),
     _used_low(0),
@@ -184,7 +186,16 @@ size_t ZPageAllocator::max_capacity() const {
 
 size_t ZPageAllocator::soft_max_capacity() const {
   // Note that SoftMaxHeapSize is a manageable flag
-  return MIN2(SoftMaxHeapSize, _current_max_capacity);
+  return MIN3(SoftMaxHeapSize, _current_max_capacity, adaptive_max_capacity());
+}
+
+size_t ZPageAllocator::adaptive_max_capacity() const {
+  return Atomic::load(&_adaptive_max_capacity);
+}
+
+void ZPageAllocator::set_adaptive_max_capacity(size_t capacity) {
+  const size_t aligned = align_up(capacity, ZGranuleSize);
+  Atomic::store(MIN2(MAX2(aligned, _min_capacity), _max_capacity), &_adaptive_max_capacity);
 }
 
 size_t ZPageAllocator::capacity() const {
@@ -47,6 +47,7 @@ private:
   const size_t               _max_capacity;
   const size_t               _max_reserve;
   size_t                     _current_max_capacity;
+  volatile size_t            _adaptive_max_capacity;
   size_t                     _capacity;
   size_t                     _used_high;
   size_t                     _used_low;
@@ -95,6 +96,8 @@ public:
   size_t min_capacity() const;
   size_t max_capacity() const;
   size_t soft_max_capacity() const;
+  size_t adaptive_max_capacity() const;
+  void set_adaptive_max_capacity(size_t capacity);
   size_t capacity() const;
   size_t max_reserve() const;
   size_t used_high() const;
@@ -32,6 +32,7 @@ class ZPage;
 class ZPageTable {
   friend class VMStructs;
   friend class ZPageTableIterator;
+  friend class ZPageTableParallelIterator;
 
 private:
   ZGranuleMap<ZPage*> _map;
@@ -56,4 +57,21 @@ public:
   bool next(ZPage** page);
 };
 
+// Iterates over the page table in chunks of granules, claimed by the
+// threads calling pages_do(). A page is visited by the thread claiming
+// the chunk holding its first granule.
+class ZPageTableParallelIterator : public StackObj {
+private:
+  static const size_t ChunkSize = 1024;
+
+  const ZPageTable* const _page_table;
+  volatile size_t         _claimed;
+
+public:
+  ZPageTableParallelIterator(const ZPageTable* page_table);
+
+  template <typename Closure>
+  void pages_do(Closure* cl);
+};
+
 #endif // SHARE_GC_Z_ZPAGETABLE_HPP
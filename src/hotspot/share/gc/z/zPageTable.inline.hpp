@@ -26,7 +26,9 @@
 
 #include "gc/z/zAddress.inline.hpp"
 #include "gc/z/zGranuleMap.inline.hpp"
+#include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPageTable.hpp"
+#include "runtime/atomic.hpp"
 
 inline ZPage* ZPageTable::get(uintptr_t addr) const {
   return _map.get(addr);
@@ -49,4 +51,28 @@ inline bool ZPageTableIterator::next(ZPage** page) {
   return false;
 }
 
+inline ZPageTableParallelIterator::ZPageTableParallelIterator(const ZPageTable* page_table) :
+    _page_table(page_table),
+    _claimed(0) {}
+
+template <typename Closure>
+inline void ZPageTableParallelIterator::pages_do(Closure* cl) {
+  const ZGranuleMap<ZPage*>* const map = &_page_table->_map;
+  const size_t size = map->_size;
+
+  while (_claimed < size) {
+    // Claim chunk
+    const size_t start = Atomic::add(ChunkSize, &_claimed) - ChunkSize;
+    const size_t end = MIN2(start + ChunkSize, size);
+
+    for (size_t index = start; index < end; index++) {
+      ZPage* const page = map->_map[index];
+      if (page != NULL && (page->start() >> ZGranuleSizeShift) == index) {
+        // First granule of page, visit page
+        cl->do_page(page);
+      }
+    }
+  }
+}
+
 #endif // SHARE_GC_Z_ZPAGETABLE_INLINE_HPP
@@ -23,10 +23,62 @@
 
 #include "precompiled.hpp"
 #include "gc/z/zForwarding.hpp"
+#include "gc/z/zForwardingTable.hpp"
 #include "gc/z/zRelocationSet.hpp"
+#include "gc/z/zTask.hpp"
+#include "gc/z/zWorkers.hpp"
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 
-ZRelocationSet::ZRelocationSet() :
+class ZRelocationSetInstallTask : public ZTask {
+private:
+  ZForwarding** const     _forwardings;
+  ZForwardingTable* const _forwarding_table;
+  ZPage* const* const     _group0;
+  const size_t            _ngroup0;
+  ZPage* const* const     _group1;
+  const size_t            _ngroup1;
+  volatile size_t         _claimed;
+
+  ZPage* page_at(size_t index) const {
+    return (index < _ngroup0) ? _group0[index] : _group1[index - _ngroup0];
+  }
+
+public:
+  ZRelocationSetInstallTask(ZForwarding** forwardings,
+                            ZForwardingTable* forwarding_table,
+                            ZPage* const* group0, size_t ngroup0,
+                            ZPage* const* group1, size_t ngroup1) :
+      ZTask("ZRelocationSetInstallTask"),
+      _forwardings(forwardings),
+      _forwarding_table(forwarding_table),
+      _group0(group0),
+      _ngroup0(ngroup0),
+      _group1(group1),
+      _ngroup1(ngroup1),
+      _claimed(0) {}
+
+  virtual void work() {
+    const size_t nforwardings = _ngroup0 + _ngroup1;
+
+    // Create forwardings and insert them into the forwarding table. Pages
+    // never overlap, so the forwarding table can be updated in parallel.
+    for (;;) {
+      const size_t index = Atomic::add(1u, &_claimed) - 1u;
+      if (index >= nforwardings) {
+        break;
+      }
+
+      ZForwarding* const forwarding = ZForwarding::create(page_at(index));
+      _forwardings[index] = forwarding;
+      _forwarding_table->insert(forwarding);
+    }
+  }
+};
+
+ZRelocationSet::ZRelocationSet(ZWorkers* workers, ZForwardingTable* forwarding_table) :
+    _workers(workers),
+    _forwarding_table(forwarding_table),
     _forwardings(NULL),
     _nforwardings(0) {}
 
@@ -35,21 +87,14 @@ void ZRelocationSet::populate(ZPage* const* group0, size_t ngroup0,
   _nforwardings = ngroup0 + ngroup1;
   _forwardings = REALLOC_C_HEAP_ARRAY(ZForwarding*, _forwardings, _nforwardings, mtGC);
 
-  size_t j = 0;
-
-  // Populate group 0
-  for (size_t i = 0; i < ngroup0; i++) {
-    _forwardings[j++] = ZForwarding::create(group0[i]);
-  }
-
-  // Populate group 1
-  for (size_t i = 0; i < ngroup1; i++) {
-    _forwardings[j++] = ZForwarding::create(group1[i]);
-  }
+  // Populate group 0 followed by group 1
+  ZRelocationSetInstallTask task(_forwardings, _forwarding_table, group0, ngroup0, group1, ngroup1);
+  _workers->run_concurrent(&task);
 }
 
 void ZRelocationSet::reset() {
   for (size_t i = 0; i < _nforwardings; i++) {
+    _forwarding_table->remove(_forwardings[i]);
     ZForwarding::destroy(_forwardings[i]);
     _forwardings[i] = NULL;
   }
@@ -27,17 +27,21 @@
 #include "memory/allocation.hpp"
 
 class ZForwarding;
+class ZForwardingTable;
 class ZPage;
+class ZWorkers;
 
 class ZRelocationSet {
   template <bool> friend class ZRelocationSetIteratorImpl;
 
 private:
-  ZForwarding** _forwardings;
-  size_t        _nforwardings;
+  ZWorkers* const         _workers;
+  ZForwardingTable* const _forwarding_table;
+  ZForwarding**           _forwardings;
+  size_t                  _nforwardings;
 
 public:
-  ZRelocationSet();
+  ZRelocationSet(ZWorkers* workers, ZForwardingTable* forwarding_table);
 
   void populate(ZPage* const* group0, size_t ngroup0,
                 ZPage* const* group1, size_t ngroup1);
@@ -30,69 +30,84 @@
 #include "runtime/globals.hpp"
 #include "utilities/debug.hpp"
 
+ZRelocationSetSelectorGroupWorker::ZRelocationSetSelectorGroupWorker() :
+    _registered_pages(),
+    _fragmentation(0) {
+  memset(_partitions, 0, sizeof(_partitions));
+}
+
 ZRelocationSetSelectorGroup::ZRelocationSetSelectorGroup(const char* name,
                                                          size_t page_size,
-                                                         size_t object_size_limit) :
+                                                         size_t object_size_limit,
+                                                         uint nworkers) :
     _name(name),
     _page_size(page_size),
     _object_size_limit(object_size_limit),
     _fragmentation_limit(page_size * (ZFragmentationLimit / 100)),
-    _registered_pages(),
+    _partition_size_shift(exact_log2(page_size >> ZRelocationSetSelectorGroupWorker::npartitions_shift)),
+    _nworkers(nworkers),
+    _workers(new ZRelocationSetSelectorGroupWorker[nworkers]),
     _sorted_pages(NULL),
+    _nregistered(0),
     _nselected(0),
     _relocating(0),
     _fragmentation(0) {}
 
 ZRelocationSetSelectorGroup::~ZRelocationSetSelectorGroup() {
+  delete [] _workers;
   FREE_C_HEAP_ARRAY(ZPage*, _sorted_pages);
 }
 
-void ZRelocationSetSelectorGroup::register_live_page(ZPage* page, size_t garbage) {
+void ZRelocationSetSelectorGroup::register_live_page(uint worker_id, ZPage* page, size_t garbage) {
+  assert(worker_id < _nworkers, "Invalid worker id");
+  ZRelocationSetSelectorGroupWorker* const worker = &_workers[worker_id];
+
   if (garbage > _fragmentation_limit) {
-    _registered_pages.add(page);
+    // Register page and count it in the worker local histogram
+    const size_t index = page->live_bytes() >> _partition_size_shift;
+    worker->_registered_pages.add(page);
+    worker->_partitions[index]++;
   } else {
-    _fragmentation += garbage;
+    worker->_fragmentation += garbage;
   }
 }
 
 void ZRelocationSetSelectorGroup::semi_sort() {
-  // Semi-sort registered pages by live bytes in ascending order
-  const size_t npartitions_shift = 11;
-  const size_t npartitions = (size_t)1 << npartitions_shift;
-  const size_t partition_size = _page_size >> npartitions_shift;
-  const size_t partition_size_shift = exact_log2(partition_size);
-  const size_t npages = _registered_pages.size();
-
-  // Partition slots/fingers
-  size_t partitions[npartitions];
-
-  // Allocate destination array
-  _sorted_pages = REALLOC_C_HEAP_ARRAY(ZPage*, _sorted_pages, npages, mtGC);
-  debug_only(memset(_sorted_pages, 0, npages * sizeof(ZPage*)));
-
-  // Calculate partition slots
-  memset(partitions, 0, sizeof(partitions));
-  ZArrayIterator<ZPage*> iter1(&_registered_pages);
-  for (ZPage* page; iter1.next(&page);) {
-    const size_t index = page->live_bytes() >> partition_size_shift;
-    partitions[index]++;
-  }
+  // Semi-sort registered pages by live bytes in ascending order. The pages
+  // and their histograms are worker local, so the histograms are first merged
+  // into partition fingers, where each worker gets its own range of slots in
+  // each partition.
+  const size_t npartitions = ZRelocationSetSelectorGroupWorker::npartitions;
 
   // Calculate partition fingers
   size_t finger = 0;
   for (size_t i = 0; i < npartitions; i++) {
-    const size_t slots = partitions[i];
-    partitions[i] = finger;
-    finger += slots;
+    for (uint j = 0; j < _nworkers; j++) {
+      size_t* const partition = &_workers[j]._partitions[i];
+      const size_t slots = *partition;
+      *partition = finger;
+      finger += slots;
+    }
   }
 
+  _nregistered = finger;
+
+  // Allocate destination array
+  _sorted_pages = REALLOC_C_HEAP_ARRAY(ZPage*, _sorted_pages, _nregistered, mtGC);
+  debug_only(memset(_sorted_pages, 0, _nregistered * sizeof(ZPage*)));
+
   // Sort pages into partitions
-  ZArrayIterator<ZPage*> iter2(&_registered_pages);
-  for (ZPage* page; iter2.next(&page);) {
-    const size_t index = page->live_bytes() >> partition_size_shift;
-    const size_t finger = partitions[index]++;
-    assert(_sorted_pages[finger] == NULL, "Invalid finger");
-    _sorted_pages[finger] = page;
+  for (uint j = 0; j < _nworkers; j++) {
+    ZRelocationSetSelectorGroupWorker* const worker = &_workers[j];
+    ZArrayIterator<ZPage*> iter(&worker->_registered_pages);
+    for (ZPage* page; iter.next(&page);) {
+      const size_t index = page->live_bytes() >> _partition_size_shift;
+      const size_t finger = worker->_partitions[index]++;
+      assert(_sorted_pages[finger] == NULL, "Invalid finger");
+      _sorted_pages[finger] = page;
+    }
+
+    _fragmentation += worker->_fragmentation;
   }
 }
 
@@ -100,7 +115,6 @@ void ZRelocationSetSelectorGroup::select() {
   // Calculate the number of pages to relocate by successively including pages in
   // a candidate relocation set and calculate the maximum space requirement for
   // their live objects.
-  const size_t npages = _registered_pages.size();
   size_t selected_from = 0;
   size_t selected_to = 0;
   size_t selected_from_size = 0;
@@ -108,6 +122,8 @@ void ZRelocationSetSelectorGroup::select() {
 
   semi_sort();
 
+  const size_t npages = _nregistered;
+
   for (size_t from = 1; from <= npages; from++) {
     // Add page to the candidate relocation set
     from_size += _sorted_pages[from - 1]->live_bytes();
@@ -166,32 +182,56 @@ size_t ZRelocationSetSelectorGroup::fragmentation() const {
   return _fragmentation;
 }
 
-ZRelocationSetSelector::ZRelocationSetSelector() :
-    _small("Small", ZPageSizeSmall, ZObjectSizeLimitSmall),
-    _medium("Medium", ZPageSizeMedium, ZObjectSizeLimitMedium),
+ZRelocationSetSelectorStats::ZRelocationSetSelectorStats() :
     _live(0),
     _garbage(0),
-    _fragmentation(0) {}
+    _fragmentation(0),
+    _young_live(0),
+    _young_garbage(0) {}
+
+ZRelocationSetSelector::ZRelocationSetSelector(uint nworkers) :
+    _small("Small", ZPageSizeSmall, ZObjectSizeLimitSmall, nworkers),
+    _medium("Medium", ZPageSizeMedium, ZObjectSizeLimitMedium, nworkers),
+    _nworkers(nworkers),
+    _stats(new ZRelocationSetSelectorStats[nworkers]) {}
+
+ZRelocationSetSelector::~ZRelocationSetSelector() {
+  delete [] _stats;
+}
 
-void ZRelocationSetSelector::register_live_page(ZPage* page) {
+void ZRelocationSetSelector::register_live_page(uint worker_id, ZPage* page) {
+  assert(worker_id < _nworkers, "Invalid worker id");
+  ZRelocationSetSelectorStats* const stats = &_stats[worker_id];
   const uint8_t type = page->type();
   const size_t live = page->live_bytes();
   const size_t garbage = page->size() - live;
 
   if (type == ZPageTypeSmall) {
-    _small.register_live_page(page, garbage);
+    _small.register_live_page(worker_id, page, garbage);
   } else if (type == ZPageTypeMedium) {
-    _medium.register_live_page(page, garbage);
+    _medium.register_live_page(worker_id, page, garbage);
   } else {
-    _fragmentation += garbage;
+    stats->_fragmentation += garbage;
   }
 
-  _live += live;
-  _garbage += garbage;
+  stats->_live += live;
+  stats->_garbage += garbage;
+
+  if (page->is_young()) {
+    stats->_young_live += live;
+    stats->_young_garbage += garbage;
+  }
 }
 
-void ZRelocationSetSelector::register_garbage_page(ZPage* page) {
-  _garbage += page->size();
+void ZRelocationSetSelector::register_garbage_page(uint worker_id, ZPage* page) {
+  assert(worker_id < _nworkers, "Invalid worker id");
+  ZRelocationSetSelectorStats* const stats = &_stats[worker_id];
+
+  stats->_garbage += page->size();
+
+  if (page->is_young()) {
+    stats->_young_garbage += page->size();
+  }
 }
 
 void ZRelocationSetSelector::select(ZRelocationSet* relocation_set) {
@@ -210,12 +250,20 @@ void ZRelocationSetSelector::select(ZRelocationSet* relocation_set) {
                            _small.selected(), _small.nselected());
 }
 
+size_t ZRelocationSetSelector::sum_stats(size_t ZRelocationSetSelectorStats::* field) const {
+  size_t sum = 0;
+  for (uint i = 0; i < _nworkers; i++) {
+    sum += _stats[i].*field;
+  }
+  return sum;
+}
+
 size_t ZRelocationSetSelector::live() const {
-  return _live;
+  return sum_stats(&ZRelocationSetSelectorStats::_live);
 }
 
 size_t ZRelocationSetSelector::garbage() const {
-  return _garbage;
+  return sum_stats(&ZRelocationSetSelectorStats::_garbage);
 }
 
 size_t ZRelocationSetSelector::relocating() const {
@@ -223,5 +271,13 @@ size_t ZRelocationSetSelector::relocating() const {
 }
 
 size_t ZRelocationSetSelector::fragmentation() const {
-  return _fragmentation + _small.fragmentation() + _medium.fragmentation();
+  return sum_stats(&ZRelocationSetSelectorStats::_fragmentation) + _small.fragmentation() + _medium.fragmentation();
+}
+
+size_t ZRelocationSetSelector::young_live() const {
+  return sum_stats(&ZRelocationSetSelectorStats::_young_live);
+}
+
+size_t ZRelocationSetSelector::young_garbage() const {
+  return sum_stats(&ZRelocationSetSelectorStats::_young_garbage);
 }
@@ -25,33 +25,56 @@
 #define SHARE_GC_Z_ZRELOCATIONSETSELECTOR_HPP
 
 #include "gc/z/zArray.hpp"
+#include "gc/z/zGlobals.hpp"
 #include "memory/allocation.hpp"
 
 class ZPage;
 class ZRelocationSet;
 
+// Pages registered by a single worker, together with a histogram
+// of their live bytes, used to semi-sort the pages of a group.
+class ZRelocationSetSelectorGroupWorker : public CHeapObj<mtGC> {
+  friend class ZRelocationSetSelectorGroup;
+
+public:
+  static const size_t npartitions_shift = 11;
+  static const size_t npartitions = (size_t)1 << npartitions_shift;
+
+private:
+  ZArray<ZPage*> _registered_pages;
+  size_t         _partitions[npartitions];
+  size_t         _fragmentation;
+
+public:
+  ZRelocationSetSelectorGroupWorker();
+};
+
 class ZRelocationSetSelectorGroup {
 private:
-  const char* const _name;
-  const size_t      _page_size;
-  const size_t      _object_size_limit;
-  const size_t      _fragmentation_limit;
+  const char* const                        _name;
+  const size_t                             _page_size;
+  const size_t                             _object_size_limit;
+  const size_t                             _fragmentation_limit;
+  const size_t                             _partition_size_shift;
+  const uint                               _nworkers;
+  ZRelocationSetSelectorGroupWorker* const _workers;
 
-  ZArray<ZPage*>    _registered_pages;
-  ZPage**           _sorted_pages;
-  size_t            _nselected;
-  size_t            _relocating;
-  size_t            _fragmentation;
+  ZPage**                                  _sorted_pages;
+  size_t                                   _nregistered;
+  size_t                                   _nselected;
+  size_t                                   _relocating;
+  size_t                                   _fragmentation;
 
   void semi_sort();
 
 public:
   ZRelocationSetSelectorGroup(const char* name,
                               size_t page_size,
-                              size_t object_size_limit);
+                              size_t object_size_limit,
+                              uint nworkers);
   ~ZRelocationSetSelectorGroup();
 
-  void register_live_page(ZPage* page, size_t garbage);
+  void register_live_page(uint worker_id, ZPage* page, size_t garbage);
   void select();
 
   ZPage* const* selected() const;
@@ -60,25 +83,47 @@ public:
   size_t fragmentation() const;
 };
 
+// Statistics collected by a single worker
+class ZRelocationSetSelectorStats : public CHeapObj<mtGC> {
+public:
+  size_t _live ATTRIBUTE_ALIGNED(ZCacheLineSize);
+  size_t _garbage;
+  size_t _fragmentation;
+  size_t _young_live;
+  size_t _young_garbage;
+
+  ZRelocationSetSelectorStats();
+};
+
+//
+// Pages can be registered in parallel by a number of workers, identified
+// by a worker id. Each worker keeps its own list of registered pages, page
+// group histograms and statistics, which are merged when the relocation
+// set is selected.
+//
 class ZRelocationSetSelector : public StackObj {
 private:
-  ZRelocationSetSelectorGroup _small;
-  ZRelocationSetSelectorGroup _medium;
-  size_t                      _live;
-  size_t                      _garbage;
-  size_t                      _fragmentation;
+  ZRelocationSetSelectorGroup        _small;
+  ZRelocationSetSelectorGroup        _medium;
+  const uint                         _nworkers;
+  ZRelocationSetSelectorStats* const _stats;
+
+  size_t sum_stats(size_t ZRelocationSetSelectorStats::* field) const;
 
 public:
-  ZRelocationSetSelector();
+  ZRelocationSetSelector(uint nworkers);
+  ~ZRelocationSetSelector();
 
-  void register_live_page(ZPage* page);
-  void register_garbage_page(ZPage* page);
+  void register_live_page(uint worker_id, ZPage* page);
+  void register_garbage_page(uint worker_id, ZPage* page);
   void select(ZRelocationSet* relocation_set);
 
   size_t live() const;
   size_t garbage() const;
   size_t relocating() const;
   size_t fragmentation() const;
+  size_t young_live() const;
+  size_t young_garbage() const;
 };
 
 #endif // SHARE_GC_Z_ZRELOCATIONSETSELECTOR_HPP
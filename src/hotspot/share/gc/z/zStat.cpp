@@ -1032,9 +1032,17 @@ uint64_t  ZStatCycle::_ncycles = 0;
 Ticks     ZStatCycle::_start_of_last;
 Ticks     ZStatCycle::_end_of_last;
 NumberSeq ZStatCycle::_normalized_duration(0.3 /* alpha */);
+NumberSeq ZStatCycle::_interval(0.3 /* alpha */);
 
 void ZStatCycle::at_start() {
-  _start_of_last = Ticks::now();
+  const Ticks now = Ticks::now();
+
+  // Record time between the start of consecutive cycles
+  if (_ncycles > 0) {
+    _interval.add((now - _start_of_last).seconds());
+  }
+
+  _start_of_last = now;
 }
 
 void ZStatCycle::at_end(double boost_factor) {
@@ -1057,6 +1065,10 @@ const AbsSeq& ZStatCycle::normalized_duration() {
   return _normalized_duration;
 }
 
+const AbsSeq& ZStatCycle::interval() {
+  return _interval;
+}
+
 double ZStatCycle::time_since_last() {
   if (_ncycles == 0) {
     // Return time since VM start-up
@@ -1085,6 +1097,9 @@ size_t ZStatMark::_nproactiveflush;
 size_t ZStatMark::_nterminateflush;
 size_t ZStatMark::_ntrycomplete;
 size_t ZStatMark::_ncontinue;
+size_t ZStatMark::_nterminate;
+size_t ZStatMark::_nrebalance;
+double ZStatMark::_terminate_time;
 
 void ZStatMark::set_at_mark_start(size_t nstripes) {
   _nstripes = nstripes;
@@ -1093,11 +1108,17 @@ void ZStatMark::set_at_mark_start(size_t nstripes) {
 void ZStatMark::set_at_mark_end(size_t nproactiveflush,
                                 size_t nterminateflush,
                                 size_t ntrycomplete,
-                                size_t ncontinue) {
+                                size_t ncontinue,
+                                size_t nterminate,
+                                size_t nrebalance,
+                                double terminate_time) {
   _nproactiveflush = nproactiveflush;
   _nterminateflush = nterminateflush;
   _ntrycomplete = ntrycomplete;
   _ncontinue = ncontinue;
+  _nterminate = nterminate;
+  _nrebalance = nrebalance;
+  _terminate_time = terminate_time;
 }
 
 void ZStatMark::print() {
@@ -1106,22 +1127,31 @@ void ZStatMark::print() {
                         SIZE_FORMAT " proactive flush(es), "
                         SIZE_FORMAT " terminate flush(es), "
                         SIZE_FORMAT " completion(s), "
-                        SIZE_FORMAT " continuation(s) ",
+                        SIZE_FORMAT " continuation(s), "
+                        SIZE_FORMAT " termination round(s) (%.3fms), "
+                        SIZE_FORMAT " rebalance(s) ",
                         _nstripes,
                         _nproactiveflush,
                         _nterminateflush,
                         _ntrycomplete,
-                        _ncontinue);
+                        _ncontinue,
+                        _nterminate,
+                        _terminate_time,
+                        _nrebalance);
 }
 
 //
 // Stat relocation
 //
 size_t ZStatRelocation::_relocating;
+size_t ZStatRelocation::_young_live;
+size_t ZStatRelocation::_young_garbage;
 bool ZStatRelocation::_success;
 
-void ZStatRelocation::set_at_select_relocation_set(size_t relocating) {
+void ZStatRelocation::set_at_select_relocation_set(size_t relocating, size_t young_live, size_t young_garbage) {
   _relocating = relocating;
+  _young_live = young_live;
+  _young_garbage = young_garbage;
 }
 
 void ZStatRelocation::set_at_relocate_end(bool success) {
@@ -1134,6 +1164,11 @@ void ZStatRelocation::print() {
   } else {
     log_info(gc, reloc)("Relocation: Incomplete");
   }
+
+  // Survival of the pages allocated during the previous cycle
+  const size_t young = _young_live + _young_garbage;
+  log_info(gc, reloc)("Young Pages: " SIZE_FORMAT "M live, " SIZE_FORMAT "M garbage, %.1f%% survived",
+                      _young_live / M, _young_garbage / M, percent_of(_young_live, young));
 }
 
 //
@@ -1306,6 +1341,10 @@ size_t ZStatHeap::used_at_mark_start() {
   return _at_mark_start.used;
 }
 
+size_t ZStatHeap::live_at_mark_end() {
+  return _at_mark_end.live;
+}
+
 size_t ZStatHeap::used_at_relocate_end() {
   return _at_relocate_end.used;
 }
@@ -369,6 +369,7 @@ private:
   static Ticks     _start_of_last;
   static Ticks     _end_of_last;
   static NumberSeq _normalized_duration;
+  static NumberSeq _interval;
 
 public:
   static void at_start();
@@ -376,6 +377,7 @@ public:
 
   static uint64_t ncycles();
   static const AbsSeq& normalized_duration();
+  static const AbsSeq& interval();
   static double time_since_last();
 };
 
@@ -397,13 +399,19 @@ private:
   static size_t _nterminateflush;
   static size_t _ntrycomplete;
   static size_t _ncontinue;
+  static size_t _nterminate;
+  static size_t _nrebalance;
+  static double _terminate_time;
 
 public:
   static void set_at_mark_start(size_t nstripes);
   static void set_at_mark_end(size_t nproactiveflush,
                               size_t nterminateflush,
                               size_t ntrycomplete,
-                              size_t ncontinue);
+                              size_t ncontinue,
+                              size_t nterminate,
+                              size_t nrebalance,
+                              double terminate_time);
 
   static void print();
 };
@@ -414,10 +422,12 @@ public:
 class ZStatRelocation : public AllStatic {
 private:
   static size_t _relocating;
+  static size_t _young_live;
+  static size_t _young_garbage;
   static bool   _success;
 
 public:
-  static void set_at_select_relocation_set(size_t relocating);
+  static void set_at_select_relocation_set(size_t relocating, size_t young_live, size_t young_garbage);
   static void set_at_relocate_end(bool success);
 
   static void print();
@@ -548,6 +558,7 @@ public:
 
   static size_t max_capacity();
   static size_t used_at_mark_start();
+  static size_t live_at_mark_end();
   static size_t used_at_relocate_end();
 
   static void print();
@@ -56,6 +56,15 @@
   experimental(uint, ZCollectionInterval, 0,                                \
           "Force GC at a fixed time interval (in seconds)")                 \
                                                                             \
+  experimental(bool, ZAdaptiveHeap, false,                                  \
+          "Adapt the soft max heap size to keep the CPU time spent on GC "  \
+          "close to ZAdaptiveHeapCPUTarget")                                \
+                                                                            \
+  experimental(double, ZAdaptiveHeapCPUTarget, 5.0,                         \
+          "Target percentage of CPU time spent on GC when ZAdaptiveHeap "   \
+          "is enabled")                                                     \
+          range(0.1, 100.0)                                                 \
+                                                                            \
   experimental(bool, ZUncommit, true,                                       \
           "Uncommit unused memory")                                         \
                                                                             \
@@ -63,6 +72,11 @@
           "Uncommit memory if it has been unused for the specified "        \
           "amount of time (in seconds)")                                    \
                                                                             \
+  experimental(bool, ZUseTBI, false,                                        \
+          "Keep pointer colors in the top byte of addresses, which is "     \
+          "ignored by the hardware on memory accesses, and map the heap "   \
+          "only once instead of once per heap view (AArch64 only)")         \
+                                                                            \
   diagnostic(uint, ZStatisticsInterval, 10,                                 \
           "Time between statistics print outs (in seconds)")                \
           range(1, (uint)-1)                                                \
@@ -34,7 +34,11 @@
 #include "oops/cpCache.inline.hpp"
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "utilities/resourceHash.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/signature.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmThread.hpp"
 
@@ -76,6 +80,162 @@ bool BootstrapInfo::resolve_previously_linked_invokedynamic(CallInfo& result, TR
   }
 }
 
+// Table of linked StringConcatFactory call sites, keyed by their shape
+class SharedCallSiteKey {
+  const char* _chars;
+  int         _length;
+
+ public:
+  SharedCallSiteKey() : _chars(NULL), _length(0) {}
+  SharedCallSiteKey(const char* chars, int length) : _chars(chars), _length(length) {}
+
+  const char* chars() const { return _chars; }
+  int length() const        { return _length; }
+
+  static unsigned int hash(const SharedCallSiteKey& key) {
+    unsigned int h = 0;
+    for (int i = 0; i < key._length; i++) {
+      h = 31 * h + (unsigned int)(u1)key._chars[i];
+    }
+    return h;
+  }
+  static bool equals(const SharedCallSiteKey& a, const SharedCallSiteKey& b) {
+    return a._length == b._length && memcmp(a._chars, b._chars, a._length) == 0;
+  }
+};
+
+struct SharedCallSite {
+  Method* _method;
+  jobject _method_holder;  // keeps the class of _method alive
+  jobject _appendix;
+};
+
+static const int _max_shared_call_sites = 4096;
+static int _shared_call_site_count = 0;
+static ResourceHashtable<
+  SharedCallSiteKey, SharedCallSite,
+  SharedCallSiteKey::hash,
+  SharedCallSiteKey::equals,
+  1009,                             // prime number
+  ResourceObj::C_HEAP> _shared_call_sites;
+
+static bool is_raw_signature(SignatureStream* ss, Symbol* sig) {
+  return ss->raw_length() == sig->utf8_length() &&
+         memcmp(ss->raw_bytes(), sig->bytes(), sig->utf8_length()) == 0;
+}
+
+// Only parameters of primitive type, String or Object and a String result are
+// accepted, since those resolve to the same classes for every class loader.
+static bool is_loader_independent_signature(Symbol* signature) {
+  for (SignatureStream ss(signature); !ss.is_done(); ss.next()) {
+    if (ss.is_array()) {
+      return false;
+    }
+    if (ss.is_object() &&
+        !is_raw_signature(&ss, vmSymbols::string_signature()) &&
+        (ss.at_return_type() || !is_raw_signature(&ss, vmSymbols::object_signature()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compute the key for sharing the linkage of this call site with other call
+// sites.  Returns false if the call site is not bootstrapped by
+// StringConcatFactory.makeConcatWithConstants, or if its target could depend
+// on the caller.
+bool BootstrapInfo::shared_call_site_key(stringStream* key) {
+  if (!ShareStringConcatCallSites || !is_method_call()) {
+    return false;
+  }
+  // The shared target pins the classes it refers to, so only share between
+  // callers that are never unloaded.
+  if (!caller()->class_loader_data()->is_builtin_class_loader_data()) {
+    return false;
+  }
+  int bsm = bsm_index();
+  if (!_pool->tag_at(bsm).is_method_handle() ||
+      _pool->method_handle_ref_kind_at(bsm) != JVM_REF_invokeStatic ||
+      _pool->method_handle_name_ref_at(bsm) != vmSymbols::makeConcatWithConstants_name() ||
+      _pool->klass_name_at(_pool->method_handle_klass_index_at(bsm)) != vmSymbols::java_lang_invoke_StringConcatFactory()) {
+    return false;
+  }
+  if (!is_loader_independent_signature(_signature)) {
+    return false;
+  }
+  key->write((const char*)_name->bytes(), _name->utf8_length());
+  key->put(' ');
+  key->write((const char*)_signature->bytes(), _signature->utf8_length());
+  for (int i = 0; i < _argc; i++) {
+    int index = arg_index(i);
+    if (!_pool->tag_at(index).is_string()) {
+      return false;
+    }
+    Symbol* s = _pool->unresolved_string_at(index);
+    key->print(" %d:", s->utf8_length());
+    key->write((const char*)s->bytes(), s->utf8_length());
+  }
+  return true;
+}
+
+bool BootstrapInfo::resolve_from_shared_call_site() {
+  ResourceMark rm;
+  stringStream key;
+  if (!shared_call_site_key(&key)) {
+    return false;
+  }
+  Thread* thread = Thread::current();
+  methodHandle method;
+  Handle appendix;
+  {
+    MutexLocker ml(SharedCallSite_lock, Mutex::_no_safepoint_check_flag);
+    SharedCallSite* site = _shared_call_sites.get(SharedCallSiteKey(key.base(), (int)key.size()));
+    if (site == NULL) {
+      return false;
+    }
+    method = methodHandle(thread, site->_method);
+    appendix = Handle(thread, JNIHandles::resolve_non_null(site->_appendix));
+  }
+  set_resolved_method(method, appendix);
+  return true;
+}
+
+void BootstrapInfo::record_shared_call_site() {
+  // Only the unwrapped target of a ConstantCallSite can be shared; a mutable
+  // CallSite appendix belongs to its call site.
+  if (!is_resolved() || _resolved_appendix.is_null() ||
+      !java_lang_invoke_MethodHandle::is_instance(_resolved_appendix())) {
+    return;
+  }
+  ResourceMark rm;
+  stringStream key;
+  if (!shared_call_site_key(&key)) {
+    return;
+  }
+  Thread* thread = Thread::current();
+  SharedCallSite site;
+  site._method = _resolved_method();
+  site._method_holder = JNIHandles::make_global(Handle(thread, _resolved_method->method_holder()->java_mirror()));
+  site._appendix = JNIHandles::make_global(_resolved_appendix);
+
+  bool added = false;
+  {
+    MutexLocker ml(SharedCallSite_lock, Mutex::_no_safepoint_check_flag);
+    SharedCallSiteKey lookup_key(key.base(), (int)key.size());
+    if (_shared_call_site_count < _max_shared_call_sites && _shared_call_sites.get(lookup_key) == NULL) {
+      char* chars = NEW_C_HEAP_ARRAY(char, lookup_key.length(), mtInternal);
+      memcpy(chars, lookup_key.chars(), lookup_key.length());
+      _shared_call_sites.put(SharedCallSiteKey(chars, lookup_key.length()), site);
+      _shared_call_site_count++;
+      added = true;
+    }
+  }
+  if (!added) {
+    JNIHandles::destroy_global(site._method_holder);
+    JNIHandles::destroy_global(site._appendix);
+  }
+}
+
 // Resolve the bootstrap specifier in 3 steps:
 // - unpack the BSM by resolving the MH constant
 // - obtain the NameAndType description for the condy/indy
@@ -51,6 +51,8 @@ class BootstrapInfo : public StackObj {
   methodHandle _resolved_method;  // bind this as indy behavior
   Handle      _resolved_appendix; // extra opaque static argument for _resolved_method
 
+  bool shared_call_site_key(stringStream* key);
+
  public:
   BootstrapInfo(const constantPoolHandle& pool, int bss_index, int indy_index = -1);
 
@@ -113,6 +115,13 @@ class BootstrapInfo : public StackObj {
     _resolved_appendix = appendix;
   }
 
+  // Call sites bootstrapped by StringConcatFactory.makeConcatWithConstants get
+  // a constant target that only depends on the recipe, the constants and the
+  // call site type.  When none of those can differ between callers, the target
+  // linked for one call site is reused for all other call sites of that shape.
+  bool resolve_from_shared_call_site();
+  void record_shared_call_site();
+
   void print() { print_msg_on(tty); }
   void print_msg_on(outputStream* st, const char* msg = NULL);
 };
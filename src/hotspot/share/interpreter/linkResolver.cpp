@@ -1715,7 +1715,15 @@ void LinkResolver::resolve_invokedynamic(CallInfo& result, const constantPoolHan
   // set the indy_rf flag since any subsequent invokedynamic instruction which shares
   // this bootstrap method will encounter the resolution of MethodHandleInError.
 
+  // Call sites of the same shape in other classes may already have computed
+  // the target, in which case the bootstrap method is not called again.
+  if (bootstrap_specifier.resolve_from_shared_call_site()) {
+    bootstrap_specifier.resolve_newly_linked_invokedynamic(result, CHECK);
+    return;
+  }
+
   resolve_dynamic_call(result, bootstrap_specifier, CHECK);
+  bootstrap_specifier.record_shared_call_site();
 
   if (TraceMethodHandles) {
     bootstrap_specifier.print_msg_on(tty, "resolve_invokedynamic");
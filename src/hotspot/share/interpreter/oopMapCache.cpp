@@ -425,10 +425,13 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int bci) const {
   // We use method->code_size() rather than method->identity_hash() below since
   // the mark may not be present if a pointer to the method is already reversed.
+  // Methods of the same class often have the same shape, so the Method* itself
+  // (which does not move) is mixed in as well to spread them over the table.
   return   ((unsigned int) bci)
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
-         ^ ((unsigned int) method->size_of_parameters() << 6);
+         ^ ((unsigned int) method->size_of_parameters() << 6)
+         ^ ((unsigned int) (p2i(method()) >> LogBytesPerWord));
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
@@ -486,8 +489,10 @@ void OopMapCache::flush_obsolete_entries() {
   }
 }
 
-// Called by GC for thread root scan during a safepoint only.  The other interpreted frame oopmaps
-// are generated locally and not cached.
+// Called during a safepoint only, by GC for thread root scan and by the other safepoint
+// operations that walk interpreted frames.  Replaced entries are freed after the next GC
+// operation, outside of any safepoint, so nothing can be reading them then.  Interpreted
+// frame oopmaps needed outside of a safepoint are generated locally and not cached.
 void OopMapCache::lookup(const methodHandle& method,
                          int bci,
                          InterpreterOopMap* entry_for) {
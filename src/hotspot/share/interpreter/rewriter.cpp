@@ -33,6 +33,7 @@
 #include "prims/methodHandles.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "utilities/bitMap.inline.hpp"
 
 // Computes a CPC map (new_index -> original_index) for constant pool entries
 // that are referred to by the interpreter at runtime via the constant pool cache.
@@ -41,6 +42,8 @@
 void Rewriter::compute_index_maps() {
   const int length  = _pool->length();
   init_maps(length);
+  ResourceBitMap referenced(length);
+  mark_member_references(&referenced);
   bool saw_mh_symbol = false;
   for (int i = 0; i < length; i++) {
     int tag = _pool->tag_at(i).value();
@@ -48,7 +51,11 @@ void Rewriter::compute_index_maps() {
       case JVM_CONSTANT_InterfaceMethodref:
       case JVM_CONSTANT_Fieldref          : // fall through
       case JVM_CONSTANT_Methodref         : // fall through
-        add_cp_cache_entry(i);
+        // References that no bytecode uses (e.g. only the targets of
+        // MethodHandle constants) are resolved without a cpCache entry.
+        if (referenced.at(i)) {
+          add_cp_cache_entry(i);
+        }
         break;
       case JVM_CONSTANT_Dynamic:
         assert(_pool->has_dynamic_constant(), "constant pool's _has_dynamic_constant flag not set");
@@ -79,6 +86,46 @@ void Rewriter::compute_index_maps() {
   }
 }
 
+// Marks the member references used by field access and invoke bytecodes,
+// which are the ones that will be rewritten to use a cpCache entry.
+void Rewriter::mark_member_references(BitMap* referenced) {
+  for (int i = 0; i < _methods->length(); i++) {
+    Method* method = _methods->at(i);
+    const address code_base = method->code_base();
+    const int code_length = method->code_size();
+
+    int bc_length;
+    for (int bci = 0; bci < code_length; bci += bc_length) {
+      address bcp = code_base + bci;
+      Bytecodes::Code c = (Bytecodes::Code)(*bcp);
+      bc_length = Bytecodes::length_for(c);
+      if (bc_length == 0) {
+        bc_length = Bytecodes::length_at(method, bcp);
+      }
+      guarantee(bc_length > 0, "Verifier should have caught this invalid bytecode");
+
+      switch (c) {
+        case Bytecodes::_getstatic      : // fall through
+        case Bytecodes::_putstatic      : // fall through
+        case Bytecodes::_getfield       : // fall through
+        case Bytecodes::_putfield       : // fall through
+        case Bytecodes::_invokevirtual  : // fall through
+        case Bytecodes::_invokespecial  : // fall through
+        case Bytecodes::_invokestatic   : // fall through
+        case Bytecodes::_invokeinterface: {
+          int cp_index = Bytes::get_Java_u2(bcp + 1);
+          if (cp_index < _pool->length()) {
+            referenced->set_bit(cp_index);
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+}
+
 // Unrewrite the bytecodes if an error occurs.
 void Rewriter::restore_bytecodes() {
   int len = _methods->length();
@@ -26,6 +26,7 @@
 #define SHARE_INTERPRETER_REWRITER_HPP
 
 #include "memory/allocation.hpp"
+#include "utilities/bitMap.hpp"
 #include "utilities/growableArray.hpp"
 
 // The Rewriter adds caches to the constant pool and rewrites bytecode indices
@@ -183,6 +184,7 @@ class Rewriter: public StackObj {
   Rewriter(InstanceKlass* klass, const constantPoolHandle& cpool, Array<Method*>* methods, TRAPS);
 
   void compute_index_maps();
+  void mark_member_references(BitMap* referenced);
   void make_constant_pool_cache(TRAPS);
   void scan_method(Method* m, bool reverse, bool* invokespecial_error);
   void rewrite_Object_init(const methodHandle& m, TRAPS);
@@ -118,7 +118,7 @@ void BFSClosure::closure_impl(const oop* reference, const oop pointee) {
   assert(reference != NULL, "invariant");
   assert(UnifiedOop::dereference(reference) == pointee, "invariant");
 
-  if (GranularTimer::is_finished()) {
+  if (GranularTimer::is_finished() || _edge_store->all_leak_candidates_found()) {
      return;
   }
 
@@ -157,7 +157,7 @@ void BFSClosure::dfs_fallback() {
   assert(_edge_queue->is_full(), "invariant");
   _use_dfs = true;
   _dfs_fallback_idx = _edge_queue->bottom();
-  while (!_edge_queue->is_empty()) {
+  while (!_edge_queue->is_empty() && !_edge_store->all_leak_candidates_found()) {
     const Edge* edge = _edge_queue->remove();
     if (edge->pointee() != NULL) {
       DFSClosure::find_leaks_from_edge(_edge_store, _mark_bits, edge);
@@ -171,7 +171,7 @@ void BFSClosure::process_queue() {
   assert(_prev_frontier_idx == 0, "invariant");
 
   _next_frontier_idx = _edge_queue->top();
-  while (!is_complete()) {
+  while (!_edge_store->all_leak_candidates_found() && !is_complete()) {
     iterate(_edge_queue->remove()); // edge_queue.remove() increments bottom
   }
 }
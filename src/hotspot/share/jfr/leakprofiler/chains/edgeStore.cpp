@@ -42,7 +42,7 @@ void StoredEdge::operator=(const StoredEdge& edge) {
 
 traceid EdgeStore::_edge_id_counter = 0;
 
-EdgeStore::EdgeStore() : _edges(NULL) {
+EdgeStore::EdgeStore() : _edges(NULL), _leak_chains(0), _leak_candidates(max_uintx) {
   _edges = new EdgeHashTable(this);
 }
 
@@ -254,6 +254,7 @@ StoredEdge* EdgeStore::associate_leak_context_with_candidate(const Edge* edge) {
 void EdgeStore::put_chain(const Edge* chain, size_t length) {
   assert(chain != NULL, "invariant");
   assert(chain->distance_to_root() + 1 == length, "invariant");
+  ++_leak_chains;
   StoredEdge* const leak_context_edge = associate_leak_context_with_candidate(chain);
   assert(leak_context_edge != NULL, "invariant");
   assert(leak_context_edge->parent() == NULL, "invariant");
@@ -72,6 +72,8 @@ class EdgeStore : public CHeapObj<mtTracing> {
  private:
   static traceid _edge_id_counter;
   EdgeHashTable* _edges;
+  size_t _leak_chains;
+  size_t _leak_candidates;
 
   // Hash table callbacks
   void on_link(EdgeEntry* entry);
@@ -103,6 +105,12 @@ class EdgeStore : public CHeapObj<mtTracing> {
   bool is_empty() const;
   traceid get_id(const Edge* edge) const;
   void put_chain(const Edge* chain, size_t length);
+
+  // Once a chain has been found for every leak candidate,
+  // the heap traversal can be terminated.
+  void set_leak_candidates(size_t candidates) { _leak_candidates = candidates; }
+  size_t leak_chains() const { return _leak_chains; }
+  bool all_leak_candidates_found() const { return _leak_chains >= _leak_candidates; }
 };
 
 #endif // SHARE_JFR_LEAKPROFILER_CHAINS_EDGESTORE_HPP
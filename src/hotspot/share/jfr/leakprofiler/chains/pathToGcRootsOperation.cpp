@@ -100,10 +100,13 @@ void PathToGcRootsOperation::doit() {
   // Save the original markWord for the potential leak objects,
   // to be restored on function exit
   ObjectSampleMarker marker;
-  if (ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all) == 0) {
+  const int leak_candidates = ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all);
+  if (leak_candidates == 0) {
     // no valid samples to process
     return;
   }
+  // Stop traversing the heap as soon as every candidate has its chain
+  _edge_store->set_leak_candidates((size_t)leak_candidates);
 
   // Necessary condition for attempting a root set iteration
   Universe::heap()->ensure_parsability(false);
@@ -123,6 +126,7 @@ void PathToGcRootsOperation::doit() {
   }
   GranularTimer::stop();
   log_edge_queue_summary(edge_queue);
+  log_trace(jfr, system)("Found chains for " SIZE_FORMAT " of %d leak candidates", _edge_store->leak_chains(), leak_candidates);
 
   // Emit old objects including their reference chains as events
   EventEmitter emitter(GranularTimer::start_time(), GranularTimer::end_time());
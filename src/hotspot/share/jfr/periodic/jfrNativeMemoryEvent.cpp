@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/jfrNativeMemoryEvent.hpp"
+#include "services/mallocTracker.hpp"
+#include "services/memTracker.hpp"
+#include "services/nmtCommon.hpp"
+#include "services/threadStackTracker.hpp"
+#include "services/virtualMemoryTracker.hpp"
+#include "utilities/macros.hpp"
+
+#if INCLUDE_NMT
+
+static bool is_tracking() {
+  return MemTracker::tracking_level() >= NMT_summary;
+}
+
+// Same accounting as MemSummaryReporter: thread stacks are reported as part
+// of mtThread, and malloc headers as part of mtNMT.
+static void usage_of_type(MEMFLAGS flag, size_t* reserved, size_t* committed) {
+  MallocMemorySnapshot* const malloc_snapshot = MallocMemorySummary::as_snapshot();
+  VirtualMemorySnapshot* const vm_snapshot = VirtualMemorySummary::as_snapshot();
+  const MallocMemory* const malloc_memory = malloc_snapshot->by_type(flag);
+  const VirtualMemory* const virtual_memory = vm_snapshot->by_type(flag);
+  const size_t malloced = malloc_memory->malloc_size() + malloc_memory->arena_size();
+  *reserved = malloced + virtual_memory->reserved();
+  *committed = malloced + virtual_memory->committed();
+  if (flag == mtThread) {
+    if (ThreadStackTracker::track_as_vm()) {
+      const VirtualMemory* const thread_stacks = vm_snapshot->by_type(mtThreadStack);
+      *reserved += thread_stacks->reserved();
+      *committed += thread_stacks->committed();
+    } else {
+      const size_t thread_stacks = malloc_snapshot->by_type(mtThreadStack)->malloc_size();
+      *reserved += thread_stacks;
+      *committed += thread_stacks;
+    }
+  } else if (flag == mtNMT) {
+    *reserved += malloc_snapshot->malloc_overhead()->size();
+    *committed += malloc_snapshot->malloc_overhead()->size();
+  }
+}
+
+void JfrNativeMemoryEvent::send_type_events() {
+  if (!is_tracking()) {
+    return;
+  }
+  for (int index = 0; index < mt_number_of_types; ++index) {
+    const MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    if (flag == mtThreadStack) {
+      continue;
+    }
+    size_t reserved;
+    size_t committed;
+    usage_of_type(flag, &reserved, &committed);
+    EventNativeMemoryUsage event;
+    event.set_type(NMTUtil::flag_to_name(flag));
+    event.set_reserved(reserved);
+    event.set_committed(committed);
+    event.commit();
+  }
+}
+
+void JfrNativeMemoryEvent::send_total_event() {
+  if (!is_tracking()) {
+    return;
+  }
+  size_t total_reserved = 0;
+  size_t total_committed = 0;
+  for (int index = 0; index < mt_number_of_types; ++index) {
+    const MEMFLAGS flag = NMTUtil::index_to_flag(index);
+    if (flag == mtThreadStack) {
+      continue;
+    }
+    size_t reserved;
+    size_t committed;
+    usage_of_type(flag, &reserved, &committed);
+    total_reserved += reserved;
+    total_committed += committed;
+  }
+  EventNativeMemoryUsageTotal event;
+  event.set_reserved(total_reserved);
+  event.set_committed(total_committed);
+  event.commit();
+}
+
+#else // INCLUDE_NMT
+
+void JfrNativeMemoryEvent::send_type_events() {}
+void JfrNativeMemoryEvent::send_total_event() {}
+
+#endif // INCLUDE_NMT
@@ -38,6 +38,7 @@
 #include "gc/shared/objectCountEventSender.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/periodic/jfrModuleEvent.hpp"
+#include "jfr/periodic/jfrNativeMemoryEvent.hpp"
 #include "jfr/periodic/jfrOSInterface.hpp"
 #include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
 #include "jfr/periodic/jfrThreadDumpEvent.hpp"
@@ -590,6 +591,14 @@ TRACE_REQUEST_FUNC(CodeCacheStatistics) {
   }
 }
 
+TRACE_REQUEST_FUNC(NativeMemoryUsage) {
+  JfrNativeMemoryEvent::send_type_events();
+}
+
+TRACE_REQUEST_FUNC(NativeMemoryUsageTotal) {
+  JfrNativeMemoryEvent::send_total_event();
+}
+
 TRACE_REQUEST_FUNC(CodeCacheConfiguration) {
   EventCodeCacheConfiguration event;
   event.set_initialSize(InitialCodeCacheSize);
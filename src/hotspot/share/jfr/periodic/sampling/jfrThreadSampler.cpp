@@ -323,6 +323,7 @@ class JfrThreadSampler : public NonJavaThread {
   volatile bool _disenrolled;
 
   JavaThread* next_thread(ThreadsList* t_list, JavaThread* first_sampled, JavaThread* current);
+  uint sample_by_cpu_time(ThreadsList* t_list, JfrThreadSampleClosure& sample_task, uint sample_limit);
   void task_stacktrace(JfrSampleType type, JavaThread** last_thread);
   JfrThreadSampler(size_t interval_java, size_t interval_native, u4 max_frames);
   ~JfrThreadSampler();
@@ -419,6 +420,60 @@ JavaThread* JfrThreadSampler::next_thread(ThreadsList* t_list, JavaThread* first
   return next != first_sampled ? next : NULL;
 }
 
+// A thread that has consumed cpu time since it was last considered, and the amount.
+struct JfrCpuSampleCandidate {
+  JavaThread* _thread;
+  jlong _cpu_delta;
+};
+
+static const uint MAX_NR_OF_CPU_CANDIDATES = 2 * MAX_NR_OF_JAVA_SAMPLES;
+
+//
+// Instead of visiting threads round-robin, pick the threads in Java that consumed
+// the most cpu time since the previous sampling period. Threads that have not run
+// are not considered, so samples go where the cpu time is spent. A few more
+// candidates than samples are kept, since a thread can leave Java before
+// it is suspended.
+//
+uint JfrThreadSampler::sample_by_cpu_time(ThreadsList* t_list, JfrThreadSampleClosure& sample_task, uint sample_limit) {
+  assert(t_list != NULL, "invariant");
+  assert(Threads_lock->owned_by_self(), "Holding the thread table lock.");
+  JfrCpuSampleCandidate candidates[MAX_NR_OF_CPU_CANDIDATES];
+  uint num_candidates = 0;
+  for (uint i = 0; i < t_list->length(); ++i) {
+    JavaThread* const jt = t_list->thread_at(i);
+    if (jt->is_Compiler_thread() || !thread_state_in_java(jt)) {
+      continue;
+    }
+    JfrThreadLocal* const tl = jt->jfr_thread_local();
+    const jlong cpu_time = os::thread_cpu_time(jt);
+    const jlong cpu_delta = cpu_time - tl->get_sampler_cpu_time();
+    tl->set_sampler_cpu_time(cpu_time);
+    if (cpu_delta <= 0) {
+      continue;
+    }
+    // insertion into the candidates, ordered by decreasing cpu delta
+    uint pos = num_candidates < MAX_NR_OF_CPU_CANDIDATES ? num_candidates++ : MAX_NR_OF_CPU_CANDIDATES;
+    while (pos > 0 && candidates[pos - 1]._cpu_delta < cpu_delta) {
+      if (pos < MAX_NR_OF_CPU_CANDIDATES) {
+        candidates[pos] = candidates[pos - 1];
+      }
+      --pos;
+    }
+    if (pos < MAX_NR_OF_CPU_CANDIDATES) {
+      candidates[pos]._thread = jt;
+      candidates[pos]._cpu_delta = cpu_delta;
+    }
+  }
+  uint num_samples = 0;
+  for (uint i = 0; i < num_candidates && num_samples < sample_limit; ++i) {
+    if (sample_task.do_sample_thread(candidates[i]._thread, _frames, _max_frames, JAVA_SAMPLE)) {
+      num_samples++;
+    }
+  }
+  return num_samples;
+}
+
 void JfrThreadSampler::start_thread() {
   if (os::create_thread(this, os::os_thread)) {
     os::start_thread(this);
@@ -518,27 +573,31 @@ void JfrThreadSampler::task_stacktrace(JfrSampleType type, JavaThread** last_thr
     {
       MutexLocker tlock(Threads_lock);
       ThreadsListHandle tlh;
-      // Resolve a sample session relative start position index into the thread list array.
-      // In cases where the last sampled thread is NULL or not-NULL but stale, find_index() returns -1.
-      _cur_index = tlh.list()->find_index_of_JavaThread(*last_thread);
-      JavaThread* current = _cur_index != -1 ? *last_thread : NULL;
-
-      while (num_samples < sample_limit) {
-        current = next_thread(tlh.list(), start, current);
-        if (current == NULL) {
-          break;
-        }
-        if (start == NULL) {
-          start = current;  // remember the thread where we started to attempt sampling
-        }
-        if (current->is_Compiler_thread()) {
-          continue;
-        }
-        if (sample_task.do_sample_thread(current, _frames, _max_frames, type)) {
-          num_samples++;
+      if (JAVA_SAMPLE == type && os::is_thread_cpu_time_supported()) {
+        num_samples = sample_by_cpu_time(tlh.list(), sample_task, sample_limit);
+      } else {
+        // Resolve a sample session relative start position index into the thread list array.
+        // In cases where the last sampled thread is NULL or not-NULL but stale, find_index() returns -1.
+        _cur_index = tlh.list()->find_index_of_JavaThread(*last_thread);
+        JavaThread* current = _cur_index != -1 ? *last_thread : NULL;
+
+        while (num_samples < sample_limit) {
+          current = next_thread(tlh.list(), start, current);
+          if (current == NULL) {
+            break;
+          }
+          if (start == NULL) {
+            start = current;  // remember the thread where we started to attempt sampling
+          }
+          if (current->is_Compiler_thread()) {
+            continue;
+          }
+          if (sample_task.do_sample_thread(current, _frames, _max_frames, type)) {
+            num_samples++;
+          }
         }
+        *last_thread = current;  // remember the thread we last attempted to sample
       }
-      *last_thread = current;  // remember the thread we last attempted to sample
     }
     sample_time.stop();
     log_trace(jfr)("JFR thread sampling done in %3.7f secs with %d java %d native samples",
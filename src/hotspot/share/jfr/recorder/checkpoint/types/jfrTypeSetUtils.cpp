@@ -74,6 +74,42 @@ void JfrSymbolId::clear() {
   _cstring_list = bootstrap;
 }
 
+// Symbols that were marked since the last rotation are kept for the next
+// chunk, only their per-chunk state is reset and their ids are reassigned.
+// Class and method names tend to be referenced chunk after chunk, so this
+// saves reallocating and rehashing them, and updating the symbol refcounts,
+// on every rotation. Entries that were not marked are released.
+template <typename T>
+class RetainListed {
+ private:
+  traceid& _id_counter;
+ public:
+  RetainListed(traceid& id_counter) : _id_counter(id_counter) {}
+  bool operator()(const T* entry) {
+    assert(entry != NULL, "invariant");
+    if (!entry->is_listed()) {
+      return true;
+    }
+    entry->reset();
+    entry->set_id(++_id_counter);
+    return false;
+  }
+};
+
+void JfrSymbolId::prune() {
+  assert(_sym_table != NULL, "invariant");
+  assert(_cstring_table != NULL, "invariant");
+  _symbol_id_counter = 1;
+  RetainListed<SymbolEntry> retain_symbols(_symbol_id_counter);
+  _sym_table->remove_entries(retain_symbols);
+  RetainListed<CStringEntry> retain_cstrings(_symbol_id_counter);
+  _cstring_table->remove_entries(retain_cstrings);
+  _sym_list = NULL;
+  assert(bootstrap != NULL, "invariant");
+  bootstrap->reset();
+  _cstring_list = bootstrap;
+}
+
 void JfrSymbolId::set_class_unload(bool class_unload) {
   _class_unload = class_unload;
 }
@@ -83,8 +119,6 @@ void JfrSymbolId::on_link(const SymbolEntry* entry) {
   const_cast<Symbol*>(entry->literal())->increment_refcount();
   assert(entry->id() == 0, "invariant");
   entry->set_id(++_symbol_id_counter);
-  entry->set_list_next(_sym_list);
-  _sym_list = entry;
 }
 
 bool JfrSymbolId::on_equals(uintptr_t hash, const SymbolEntry* entry) {
@@ -103,8 +137,6 @@ void JfrSymbolId::on_link(const CStringEntry* entry) {
   assert(entry != NULL, "invariant");
   assert(entry->id() == 0, "invariant");
   entry->set_id(++_symbol_id_counter);
-  entry->set_list_next(_cstring_list);
-  _cstring_list = entry;
 }
 
 bool JfrSymbolId::on_equals(uintptr_t hash, const CStringEntry* entry) {
@@ -118,6 +150,22 @@ void JfrSymbolId::on_unlink(const CStringEntry* entry) {
   JfrCHeapObj::free(const_cast<char*>(entry->literal()), strlen(entry->literal() + 1));
 }
 
+void JfrSymbolId::link(const SymbolEntry* entry) {
+  assert(entry != NULL, "invariant");
+  if (!entry->is_listed()) {
+    entry->set_list_next(_sym_list);
+    _sym_list = entry;
+  }
+}
+
+void JfrSymbolId::link(const CStringEntry* entry) {
+  assert(entry != NULL, "invariant");
+  if (!entry->is_listed()) {
+    entry->set_list_next(_cstring_list);
+    _cstring_list = entry;
+  }
+}
+
 traceid JfrSymbolId::bootstrap_name(bool leakp) {
   assert(bootstrap != NULL, "invariant");
   if (leakp) {
@@ -142,6 +190,7 @@ traceid JfrSymbolId::mark(uintptr_t hash, const Symbol* data, bool leakp) {
     return last_symbol_id;
   }
   const SymbolEntry& entry = _sym_table->lookup_put(hash, data);
+  link(&entry);
   if (_class_unload) {
     entry.set_unloading();
   }
@@ -164,6 +213,7 @@ traceid JfrSymbolId::mark(uintptr_t hash, const char* str, bool leakp) {
     return last_cstring_id;
   }
   const CStringEntry& entry = _cstring_table->lookup_put(hash, str);
+  link(&entry);
   if (_class_unload) {
     entry.set_unloading();
   }
@@ -228,7 +278,8 @@ traceid JfrSymbolId::mark_unsafe_anonymous_klass_name(const InstanceKlass* ik, b
   }
   last_anonymous_hash = hash;
   const CStringEntry* const entry = _cstring_table->lookup_only(hash);
-  last_anonymous_id = entry != NULL ? entry->id() : mark(hash, create_unsafe_anonymous_klass_symbol(ik, hash), leakp);
+  // an entry retained from a previous chunk must be listed again to be written
+  last_anonymous_id = mark(hash, entry != NULL ? entry->literal() : create_unsafe_anonymous_klass_symbol(ik, hash), leakp);
   return last_anonymous_id;
 }
 
@@ -279,7 +330,7 @@ JfrArtifactSet::~JfrArtifactSet() {
 
 void JfrArtifactSet::clear() {
   reset_symbol_caches();
-  _symbol_id->clear();
+  _symbol_id->prune();
   // _klass_list will be cleared by a ResourceMark
 }
 
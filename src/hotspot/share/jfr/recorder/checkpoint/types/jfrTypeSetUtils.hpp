@@ -189,12 +189,13 @@ template <typename T, typename IdType>
 class ListEntry : public JfrHashtableEntry<T, IdType> {
  public:
   ListEntry(uintptr_t hash, const T& data) : JfrHashtableEntry<T, IdType>(hash, data),
-    _list_next(NULL), _serialized(false), _unloading(false), _leakp(false) {}
+    _list_next(NULL), _listed(false), _serialized(false), _unloading(false), _leakp(false) {}
   const ListEntry<T, IdType>* list_next() const { return _list_next; }
   void reset() const {
-    _list_next = NULL; _serialized = false; _unloading = false; _leakp = false;
+    _list_next = NULL; _listed = false; _serialized = false; _unloading = false; _leakp = false;
   }
-  void set_list_next(const ListEntry<T, IdType>* next) const { _list_next = next; }
+  void set_list_next(const ListEntry<T, IdType>* next) const { _list_next = next; _listed = true; }
+  bool is_listed() const { return _listed; }
   bool is_serialized() const { return _serialized; }
   void set_serialized() const { _serialized = true; }
   bool is_unloading() const { return _unloading; }
@@ -203,6 +204,7 @@ class ListEntry : public JfrHashtableEntry<T, IdType> {
   void set_leakp() const { _leakp = true; }
  private:
   mutable const ListEntry<T, IdType>* _list_next;
+  mutable bool _listed;
   mutable bool _serialized;
   mutable bool _unloading;
   mutable bool _leakp;
@@ -233,6 +235,9 @@ class JfrSymbolId : public JfrCHeapObj {
   bool on_equals(uintptr_t hash, const CStringEntry* entry);
   void on_unlink(const CStringEntry* entry);
 
+  void link(const SymbolEntry* entry);
+  void link(const CStringEntry* entry);
+
   template <typename Functor, typename T>
   void iterate(Functor& functor, const T* list) {
     const T* symbol = list;
@@ -252,6 +257,7 @@ class JfrSymbolId : public JfrCHeapObj {
   ~JfrSymbolId();
 
   void clear();
+  void prune();
   void set_class_unload(bool class_unload);
 
   traceid mark(uintptr_t hash, const Symbol* sym, bool leakp);
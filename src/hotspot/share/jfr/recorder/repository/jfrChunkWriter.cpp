@@ -97,6 +97,17 @@ void JfrChunkWriter::write_header(int64_t metadata_offset) {
   this->write_be_at_offset(_chunkstate->previous_start_ticks(), CHUNK_SIZE_OFFSET + (5 * FILEHEADER_SLOT_SIZE));
 }
 
+// Make the data written so far visible to readers of the chunk file.
+// The chunk size and checkpoint slots are updated, but the metadata
+// offset stays zero until the chunk is closed, which is how a reader
+// tells a chunk in progress from a finished one.
+void JfrChunkWriter::flushpoint() {
+  assert(this->is_valid(), "invariant");
+  this->write_be_at_offset(size_written(), CHUNK_SIZE_OFFSET);
+  this->write_be_at_offset(_chunkstate->last_checkpoint_offset(), CHUNK_SIZE_OFFSET + (1 * FILEHEADER_SLOT_SIZE));
+  this->flush();
+}
+
 void JfrChunkWriter::set_chunk_path(const char* chunk_path) {
   _chunkstate->set_path(chunk_path);
 }
@@ -52,6 +52,7 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   int64_t last_checkpoint_offset() const;
   void set_last_checkpoint_offset(int64_t offset);
   void time_stamp_chunk_now();
+  void flushpoint();
 };
 
 #endif // SHARE_JFR_RECORDER_REPOSITORY_JFRCHUNKWRITER_HPP
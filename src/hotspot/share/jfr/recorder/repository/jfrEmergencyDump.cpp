@@ -27,8 +27,10 @@
 #include "jfr/jni/jfrJavaSupport.hpp"
 #include "jfr/leakprofiler/leakProfiler.hpp"
 #include "jfr/recorder/repository/jfrEmergencyDump.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
+#include "jfr/utilities/jfrTimeConverter.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
 #include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
@@ -454,8 +456,9 @@ void JfrEmergencyDump::on_vm_shutdown(bool exception_handler) {
     event.commit();
   }
   if (!exception_handler) {
-    // OOM
-    LeakProfiler::emit_events(max_jlong, false);
+    // OOM, bound the reference chain search since it runs at a safepoint
+    const jlong cutoff = JfrOptionSet::emergency_dump_cutoff();
+    LeakProfiler::emit_events(cutoff > 0 ? JfrTimeConverter::nanos_to_countertime(cutoff) : 0, false);
   }
   const int messages = MSGBIT(MSG_VM_ERROR);
   ResourceMark rm(thread);
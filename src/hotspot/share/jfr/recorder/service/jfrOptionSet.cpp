@@ -103,6 +103,33 @@ void JfrOptionSet::set_old_object_queue_size(jlong value) {
   _old_object_queue_size = value;
 }
 
+// milliseconds between flushpoints, 0 means no flushpoints
+jlong JfrOptionSet::flush_interval() {
+  return _flush_interval;
+}
+
+void JfrOptionSet::set_flush_interval(jlong millis) {
+  _flush_interval = millis < 0 ? 0 : millis;
+}
+
+// upper bound for allocation samples per second, 0 disables allocation sampling
+jlong JfrOptionSet::allocation_sample_rate() {
+  return _allocation_sample_rate;
+}
+
+void JfrOptionSet::set_allocation_sample_rate(jlong samples_per_second) {
+  _allocation_sample_rate = samples_per_second < 0 ? 0 : samples_per_second;
+}
+
+// nanoseconds to spend searching for paths to gc roots when dumping on OutOfMemoryError
+jlong JfrOptionSet::emergency_dump_cutoff() {
+  return _emergency_dump_cutoff;
+}
+
+void JfrOptionSet::set_emergency_dump_cutoff(jlong nanos) {
+  _emergency_dump_cutoff = nanos < 0 ? 0 : nanos;
+}
+
 u4 JfrOptionSet::stackdepth() {
   return _stack_depth;
 }
@@ -171,6 +198,9 @@ const char* const default_sample_threads = "true";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
+const char* const default_flush_interval = "0";
+const char* const default_allocation_sample_rate = "150";
+const char* const default_emergency_dump_cutoff = "1s";
 DEBUG_ONLY(const char* const default_sample_protection = "false";)
 
 // statics
@@ -223,6 +253,27 @@ static DCmdArgument<jlong> _dcmd_old_object_queue_size (
   false,
   default_old_object_queue_size);
 
+static DCmdArgument<NanoTimeArgument> _dcmd_flush_interval(
+  "flushinterval",
+  "Interval between incremental flushes of the current chunk to disk (0 disables flushing)",
+  "NANOTIME",
+  false,
+  default_flush_interval);
+
+static DCmdArgument<jlong> _dcmd_allocation_sample_rate(
+  "allocationsamplerate",
+  "Maximum number of allocation samples per second (0 disables allocation sampling)",
+  "JLONG",
+  false,
+  default_allocation_sample_rate);
+
+static DCmdArgument<NanoTimeArgument> _dcmd_emergency_dump_cutoff(
+  "emergencydumpcutoff",
+  "Maximum time to search for old object reference chains when dumping on OutOfMemoryError (0 disables the search)",
+  "NANOTIME",
+  false,
+  default_emergency_dump_cutoff);
+
 static DCmdArgument<bool> _dcmd_sample_threads(
   "samplethreads",
   "Thread sampling enable / disable (only sampling when event enabled and sampling enabled)",
@@ -266,6 +317,9 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_sample_threads);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
+  _parser.add_dcmd_option(&_dcmd_flush_interval);
+  _parser.add_dcmd_option(&_dcmd_allocation_sample_rate);
+  _parser.add_dcmd_option(&_dcmd_emergency_dump_cutoff);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
 }
 
@@ -304,6 +358,9 @@ jlong JfrOptionSet::_thread_buffer_size = 0;
 jlong JfrOptionSet::_memory_size = 0;
 jlong JfrOptionSet::_num_global_buffers = 0;
 jlong JfrOptionSet::_old_object_queue_size = 0;
+jlong JfrOptionSet::_flush_interval = 0;
+jlong JfrOptionSet::_allocation_sample_rate = 0;
+jlong JfrOptionSet::_emergency_dump_cutoff = 0;
 u4 JfrOptionSet::_stack_depth = STACK_DEPTH_DEFAULT;
 jboolean JfrOptionSet::_sample_threads = JNI_TRUE;
 jboolean JfrOptionSet::_retransform = JNI_TRUE;
@@ -322,6 +379,9 @@ bool JfrOptionSet::initialize(Thread* thread) {
     set_retransform(_dcmd_retransform.value());
   }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
+  set_flush_interval(_dcmd_flush_interval.value()._nanotime / NANOSECS_PER_MILLISEC);
+  set_allocation_sample_rate(_dcmd_allocation_sample_rate.value());
+  set_emergency_dump_cutoff(_dcmd_emergency_dump_cutoff.value()._nanotime);
   return adjust_memory_options();
 }
 
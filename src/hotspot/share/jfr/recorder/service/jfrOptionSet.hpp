@@ -44,6 +44,9 @@ class JfrOptionSet : public AllStatic {
   static jlong _memory_size;
   static jlong _num_global_buffers;
   static jlong _old_object_queue_size;
+  static jlong _flush_interval;
+  static jlong _allocation_sample_rate;
+  static jlong _emergency_dump_cutoff;
   static u4 _stack_depth;
   static jboolean _sample_threads;
   static jboolean _retransform;
@@ -66,6 +69,12 @@ class JfrOptionSet : public AllStatic {
   static void set_num_global_buffers(jlong value);
   static jint old_object_queue_size();
   static void set_old_object_queue_size(jlong value);
+  static jlong flush_interval();
+  static void set_flush_interval(jlong millis);
+  static jlong allocation_sample_rate();
+  static void set_allocation_sample_rate(jlong samples_per_second);
+  static jlong emergency_dump_cutoff();
+  static void set_emergency_dump_cutoff(jlong nanos);
   static u4 stackdepth();
   static void set_stackdepth(u4 depth);
   static bool sample_threads();
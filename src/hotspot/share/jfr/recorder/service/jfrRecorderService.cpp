@@ -132,7 +132,7 @@ class RotationLock : public StackObj {
   bool not_acquired() const { return !_acquired; }
 };
 
-static int64_t write_checkpoint_event_prologue(JfrChunkWriter& cw, u8 type_id) {
+static int64_t write_checkpoint_event_prologue(JfrChunkWriter& cw, u8 type_id, bool flushpoint) {
   const int64_t last_cp_offset = cw.last_checkpoint_offset();
   const int64_t delta_to_last_checkpoint = 0 == last_cp_offset ? 0 : last_cp_offset - cw.current_offset();
   cw.reserve(sizeof(u4));
@@ -140,7 +140,7 @@ static int64_t write_checkpoint_event_prologue(JfrChunkWriter& cw, u8 type_id) {
   cw.write(JfrTicks::now());
   cw.write((int64_t)0); // duration
   cw.write(delta_to_last_checkpoint);
-  cw.write<bool>(false); // flushpoint
+  cw.write<bool>(flushpoint);
   cw.write((u4)1); // nof types in this checkpoint
   cw.write(type_id);
   const int64_t number_of_elements_offset = cw.current_offset();
@@ -154,17 +154,19 @@ class WriteCheckpointEvent : public StackObj {
   JfrChunkWriter& _cw;
   u8 _type_id;
   ContentFunctor& _content_functor;
+  bool _flushpoint;
  public:
-  WriteCheckpointEvent(JfrChunkWriter& cw, u8 type_id, ContentFunctor& functor) :
+  WriteCheckpointEvent(JfrChunkWriter& cw, u8 type_id, ContentFunctor& functor, bool flushpoint = false) :
     _cw(cw),
     _type_id(type_id),
-    _content_functor(functor) {
+    _content_functor(functor),
+    _flushpoint(flushpoint) {
     assert(_cw.is_valid(), "invariant");
   }
   bool process() {
     // current_cp_offset is also offset for the event size header field
     const int64_t current_cp_offset = _cw.current_offset();
-    const int64_t num_elements_offset = write_checkpoint_event_prologue(_cw, _type_id);
+    const int64_t num_elements_offset = write_checkpoint_event_prologue(_cw, _type_id, _flushpoint);
     // invocation
     _content_functor.process();
     const u4 number_of_elements = (u4)_content_functor.processed();
@@ -268,7 +270,6 @@ void JfrRecorderService::clear() {
 }
 
 void JfrRecorderService::pre_safepoint_clear() {
-  _stack_trace_repository.clear();
   _string_pool.clear();
   _storage.clear();
 }
@@ -392,14 +393,14 @@ typedef WriteCheckpointEvent<WriteStackTraceRepository> WriteStackTraceCheckpoin
 typedef WriteCheckpointEvent<WriteStringPool> WriteStringPoolCheckpoint;
 typedef WriteCheckpointEvent<WriteStringPoolSafepoint> WriteStringPoolCheckpointSafepoint;
 
-static void write_stacktrace_checkpoint(JfrStackTraceRepository& stack_trace_repo, JfrChunkWriter& chunkwriter, bool clear) {
+static void write_stacktrace_checkpoint(JfrStackTraceRepository& stack_trace_repo, JfrChunkWriter& chunkwriter, bool clear, bool flushpoint = false) {
   WriteStackTraceRepository write_stacktrace_repo(stack_trace_repo, chunkwriter, clear);
-  WriteStackTraceCheckpoint write_stack_trace_checkpoint(chunkwriter, TYPE_STACKTRACE, write_stacktrace_repo);
+  WriteStackTraceCheckpoint write_stack_trace_checkpoint(chunkwriter, TYPE_STACKTRACE, write_stacktrace_repo, flushpoint);
   write_stack_trace_checkpoint.process();
 }
-static void write_stringpool_checkpoint(JfrStringPool& string_pool, JfrChunkWriter& chunkwriter) {
+static void write_stringpool_checkpoint(JfrStringPool& string_pool, JfrChunkWriter& chunkwriter, bool flushpoint = false) {
   WriteStringPool write_string_pool(string_pool);
-  WriteStringPoolCheckpoint write_string_pool_checkpoint(chunkwriter, TYPE_STRING, write_string_pool);
+  WriteStringPoolCheckpoint write_string_pool_checkpoint(chunkwriter, TYPE_STRING, write_string_pool, flushpoint);
   write_string_pool_checkpoint.process();
 }
 
@@ -505,6 +506,39 @@ void JfrRecorderService::post_safepoint_write() {
   assert(!_chunkwriter.is_valid(), "invariant");
 }
 
+//
+// flushpoint sequence
+//
+//  lock stream lock ->
+//    write stack trace checkpoint ->
+//      write string pool checkpoint ->
+//        write outstanding checkpoints ->
+//          write storage ->
+//            update chunk header and flush ->
+//              release stream lock
+//
+// Unlike a rotation, a flushpoint neither shifts the epoch nor closes the chunk.
+// Only constants already known to be complete are written, so the type set and
+// the metadata descriptor are still written when the chunk is finalized.
+//
+void JfrRecorderService::flushpoint() {
+  RotationLock rl(Thread::current());
+  if (rl.not_acquired()) {
+    return;
+  }
+  if (!is_recording() || !_chunkwriter.is_valid()) {
+    return;
+  }
+  ResourceMark rm;
+  HandleMark hm;
+  MutexLocker stream_lock(JfrStream_lock, Mutex::_no_safepoint_check_flag);
+  write_stacktrace_checkpoint(_stack_trace_repository, _chunkwriter, false, true);
+  write_stringpool_checkpoint(_string_pool, _chunkwriter, true);
+  _checkpoint_manager.write();
+  _storage.write();
+  _chunkwriter.flushpoint();
+}
+
 void JfrRecorderService::vm_error_rotation() {
   if (_chunkwriter.is_valid()) {
     finalize_current_chunk_on_vm_error();
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
 #include "jfr/recorder/service/jfrRecorderThread.hpp"
@@ -42,6 +43,7 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
   #define ROTATE (msgs & (MSGBIT(MSG_ROTATE)|MSGBIT(MSG_STOP)))
   #define PROCESS_FULL_BUFFERS (msgs & (MSGBIT(MSG_ROTATE)|MSGBIT(MSG_STOP)|MSGBIT(MSG_FULLBUFFER)))
   #define SCAVENGE (msgs & (MSGBIT(MSG_DEADBUFFER)))
+  #define FLUSHPOINT (flush_timeout || (msgs & MSGBIT(MSG_FLUSHPOINT)))
 
   JfrPostBox& post_box = JfrRecorderThread::post_box();
   log_debug(jfr, system)("Recorder thread STARTED");
@@ -49,13 +51,16 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
   {
     bool done = false;
     int msgs = 0;
+    const jlong flush_interval = JfrOptionSet::flush_interval();
     JfrRecorderService service;
     MutexLocker msg_lock(JfrMsg_lock);
 
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
+      bool flush_timeout = false;
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait();
+        // with a flush interval, a timed out wait is a request for a flushpoint
+        flush_timeout = JfrMsg_lock->wait(flush_interval);
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
@@ -72,6 +77,8 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
         service.start();
       } else if (ROTATE) {
         service.rotate(msgs);
+      } else if (FLUSHPOINT) {
+        service.flushpoint();
       }
       JfrMsg_lock->lock();
       post_box.notify_waiters();
@@ -92,4 +99,5 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
   #undef ROTATE
   #undef PROCESS_FULL_BUFFERS
   #undef SCAVENGE
+  #undef FLUSHPOINT
 }
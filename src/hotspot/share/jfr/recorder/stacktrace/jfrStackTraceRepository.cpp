@@ -29,11 +29,13 @@
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/safepoint.hpp"
 
 static JfrStackTraceRepository* _instance = NULL;
 
 JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
 }
 
 JfrStackTraceRepository& JfrStackTraceRepository::instance() {
@@ -72,6 +74,7 @@ void JfrStackTraceRepository::destroy() {
 }
 
 size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
+  assert(!clear || SafepointSynchronize::is_at_safepoint(), "invariant");
   MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   assert(_entries > 0, "invariant");
   int count = 0;
@@ -90,7 +93,7 @@ size_t JfrStackTraceRepository::write_impl(JfrChunkWriter& sw, bool clear) {
     }
   }
   if (clear) {
-    memset(_table, 0, sizeof(_table));
+    memset((void*)_table, 0, sizeof(_table));
     _entries = 0;
   }
   return count;
@@ -116,7 +119,10 @@ void JfrStackTraceRepository::write_metadata(JfrCheckpointWriter& writer) {
   fct.serialize(writer);
 }
 
+// Entries are only unlinked and deleted at a safepoint, because add_trace()
+// and lookup() traverse the buckets without holding JfrStacktrace_lock.
 size_t JfrStackTraceRepository::clear() {
+  assert(SafepointSynchronize::is_at_safepoint(), "invariant");
   MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   if (_entries == 0) {
     return 0;
@@ -129,7 +135,7 @@ size_t JfrStackTraceRepository::clear() {
       stacktrace = next;
     }
   }
-  memset(_table, 0, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
   const size_t processed = _entries;
   _entries = 0;
   return processed;
@@ -183,24 +189,44 @@ void JfrStackTraceRepository::record_and_cache(JavaThread* thread, int skip /* 0
   }
 }
 
-traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  const size_t index = stacktrace._hash % TABLE_SIZE;
-  const JfrStackTrace* table_entry = _table[index];
-
-  while (table_entry != NULL) {
+// Search the bucket list from 'from' up to, but not including, 'to'.
+traceid JfrStackTraceRepository::find(const JfrStackTrace& stacktrace, const JfrStackTrace* from, const JfrStackTrace* to) {
+  for (const JfrStackTrace* table_entry = from; table_entry != to; table_entry = table_entry->next()) {
     if (table_entry->equals(stacktrace)) {
       return table_entry->id();
     }
-    table_entry = table_entry->next();
+  }
+  return 0;
+}
+
+//
+// Most traces recorded are already in the table, so the bucket is first
+// searched without taking JfrStacktrace_lock. New entries are only ever
+// prepended to a bucket, fully constructed and published with a release
+// store, and they are never unlinked outside of a safepoint. Only on a miss
+// is the lock taken, and then only entries added since the lock-free search
+// need to be examined again before inserting.
+//
+traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
+  const size_t index = stacktrace._hash % TABLE_SIZE;
+  const JfrStackTrace* const probed = OrderAccess::load_acquire(&_table[index]);
+  traceid id = find(stacktrace, probed, NULL);
+  if (id != 0) {
+    return id;
+  }
+
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  id = find(stacktrace, _table[index], probed);
+  if (id != 0) {
+    return id;
   }
 
   if (!stacktrace.have_lineno()) {
     return 0;
   }
 
-  traceid id = ++_next_id;
-  _table[index] = new JfrStackTrace(id, stacktrace, _table[index]);
+  id = ++_next_id;
+  OrderAccess::release_store(&_table[index], new JfrStackTrace(id, stacktrace, _table[index]));
   ++_entries;
   return id;
 }
@@ -208,7 +234,7 @@ traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
 // invariant is that the entry to be resolved actually exists in the table
 const JfrStackTrace* JfrStackTraceRepository::lookup(unsigned int hash, traceid id) const {
   const size_t index = (hash % TABLE_SIZE);
-  const JfrStackTrace* trace = _table[index];
+  const JfrStackTrace* trace = OrderAccess::load_acquire(&_table[index]);
   while (trace != NULL && trace->id() != id) {
     trace = trace->next();
   }
@@ -44,7 +44,7 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
  private:
   static const u4 TABLE_SIZE = 2053;
-  JfrStackTrace* _table[TABLE_SIZE];
+  JfrStackTrace* volatile _table[TABLE_SIZE];
   traceid _next_id;
   u4 _entries;
 
@@ -61,6 +61,7 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   size_t clear();
 
   traceid add_trace(const JfrStackTrace& stacktrace);
+  static traceid find(const JfrStackTrace& stacktrace, const JfrStackTrace* from, const JfrStackTrace* to);
   static traceid add(const JfrStackTrace& stacktrace);
   traceid record_for(JavaThread* thread, int skip, JfrStackFrame* frames, u4 max_frames);
   const JfrStackTrace* lookup(unsigned int hash, traceid id) const;
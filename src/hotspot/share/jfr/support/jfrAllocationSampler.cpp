@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/support/jfrAllocationSampler.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadHeapSampler.hpp"
+
+static const jlong window_length_nanos = 100 * NANOSECS_PER_MILLISEC;
+static const jlong windows_per_second = NANOSECS_PER_SEC / window_length_nanos;
+
+static volatile jlong _window_end = 0;
+static volatile jlong _window_budget = 0;
+static volatile jlong _window_taken = 0;
+
+static jlong base_budget() {
+  const jlong rate = JfrOptionSet::allocation_sample_rate();
+  return MAX2<jlong>(1, rate / windows_per_second);
+}
+
+// Moves to a new window if the current one has expired. Only the thread
+// that wins the race sets the new budget, which is the base budget plus the
+// samples left unused in the expired window, up to the base budget again.
+static void rotate_window(jlong now) {
+  const jlong end = OrderAccess::load_acquire(&_window_end);
+  if (now < end) {
+    return;
+  }
+  if (Atomic::cmpxchg(now + window_length_nanos, &_window_end, end) != end) {
+    return;
+  }
+  const jlong base = base_budget();
+  const jlong unused = MAX2<jlong>(0, Atomic::load(&_window_budget) - Atomic::load(&_window_taken));
+  Atomic::store(base + MIN2(unused, base), &_window_budget);
+  OrderAccess::release_store(&_window_taken, (jlong)0);
+}
+
+static bool accept() {
+  rotate_window(os::javaTimeNanos());
+  return Atomic::add((jlong)1, &_window_taken) <= Atomic::load(&_window_budget);
+}
+
+void JfrAllocationSampler::sample(Klass* klass, size_t alloc_size, Thread* thread) {
+  assert(thread != NULL, "invariant");
+  if (JfrOptionSet::allocation_sample_rate() == 0) {
+    return;
+  }
+  EventObjectAllocationSample event;
+  if (!event.is_enabled()) {
+    return;
+  }
+  JfrThreadLocal* const tl = thread->jfr_thread_local();
+  const jlong allocated = thread->cooked_allocated_bytes() + (jlong)alloc_size;
+  const jlong weight = allocated - tl->last_allocation_sample_bytes();
+  if (weight < ThreadHeapSampler::get_sampling_interval()) {
+    return;
+  }
+  if (!accept()) {
+    return;
+  }
+  tl->set_last_allocation_sample_bytes(allocated);
+  event.set_objectClass(klass);
+  event.set_weight((u8)weight);
+  event.commit();
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_JFR_SUPPORT_JFRALLOCATIONSAMPLER_HPP
+#define SHARE_JFR_SUPPORT_JFRALLOCATIONSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+
+class Klass;
+class Thread;
+
+//
+// Emits ObjectAllocationSample events at a bounded rate.
+//
+// A thread becomes a sampling candidate once it has allocated at least
+// the ThreadHeapSampler sampling interval since its last sample. Candidates
+// then draw from a global budget of samples per time window, derived from
+// the configured per-second rate. Unused budget carries over into the
+// next window, so short bursts after quiet periods are still sampled.
+// The weight of a sample is the number of bytes the thread allocated
+// since its previous sample.
+//
+class JfrAllocationSampler : AllStatic {
+ public:
+  static void sample(Klass* klass, size_t alloc_size, Thread* thread);
+};
+
+#endif // SHARE_JFR_SUPPORT_JFRALLOCATIONSAMPLER_HPP
@@ -47,6 +47,8 @@ class JfrThreadLocal {
   jlong _user_time;
   jlong _cpu_time;
   jlong _wallclock_time;
+  jlong _sampler_cpu_time; // written only by the thread sampler
+  jlong _last_allocation_sample_bytes;
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -191,6 +193,22 @@ class JfrThreadLocal {
     _wallclock_time = wallclock_time;
   }
 
+  jlong get_sampler_cpu_time() const {
+    return _sampler_cpu_time;
+  }
+
+  void set_sampler_cpu_time(jlong cpu_time) {
+    _sampler_cpu_time = cpu_time;
+  }
+
+  jlong last_allocation_sample_bytes() const {
+    return _last_allocation_sample_bytes;
+  }
+
+  void set_last_allocation_sample_bytes(jlong allocated_bytes) {
+    _last_allocation_sample_bytes = allocated_bytes;
+  }
+
   traceid trace_id() const {
     return _trace_id;
   }
@@ -180,6 +180,10 @@ class HashTableHost : public JfrBasicHashtable<T> {
   bool has_entries() const { return this->cardinality() > 0; }
   void clear_entries();
 
+  // removes the entries for which the functor returns true
+  template <typename Functor>
+  void remove_entries(Functor& f);
+
   // removal and deallocation
   void free_entry(HashEntry* entry) {
     assert(entry != NULL, "invariant");
@@ -263,6 +267,23 @@ void HashTableHost<T, IdType, Entry, Callback, TABLE_SIZE>::clear_entries() {
   assert(this->number_of_entries() == 0, "should have removed all entries");
 }
 
+template <typename T, typename IdType, template <typename, typename> class Entry, typename Callback, size_t TABLE_SIZE>
+template <typename Functor>
+void HashTableHost<T, IdType, Entry, Callback, TABLE_SIZE>::remove_entries(Functor& f) {
+  for (size_t i = 0; i < this->table_size(); ++i) {
+    HashEntry** link = (HashEntry**)this->bucket_addr(i);
+    while (*link != NULL) {
+      HashEntry* const entry = *link;
+      if (f(entry)) {
+        *link = (HashEntry*)entry->next();
+        this->free_entry(entry);
+      } else {
+        link = (HashEntry**)entry->next_addr();
+      }
+    }
+  }
+}
+
 template <typename T, typename IdType, template <typename, typename> class Entry, typename Callback, size_t TABLE_SIZE>
 Entry<T, IdType>* HashTableHost<T, IdType, Entry, Callback, TABLE_SIZE>::new_entry(uintptr_t hash, const T& data) {
   assert(sizeof(HashEntry) == this->entry_size(), "invariant");
@@ -36,7 +36,7 @@ class EventWriterHost : public WriterHost<BE, IE, WriterPolicyImpl> {
   void begin_write();
   intptr_t end_write();
   void begin_event_write();
-  intptr_t end_event_write();
+  intptr_t end_event_write(bool compact = false);
 };
 
 template <typename BE, typename IE, typename WriterPolicyImpl >
@@ -60,16 +60,31 @@ inline void EventWriterHost<BE, IE, WriterPolicyImpl>::begin_event_write() {
   this->reserve(sizeof(u4)); // reserve the event size slot
 }
 
+// The event size is a compressed integer, reserved padded to four bytes.
+// When compacting, an event that is small enough has its payload moved
+// down so that the size only takes a single byte, which is the same
+// value to a reader.
+static const u4 max_compact_event_size = 127;
+
 template <typename BE, typename IE, typename WriterPolicyImpl>
-inline intptr_t EventWriterHost<BE, IE, WriterPolicyImpl>::end_event_write() {
+inline intptr_t EventWriterHost<BE, IE, WriterPolicyImpl>::end_event_write(bool compact /* false */) {
   assert(this->is_acquired(), "invariant");
   if (!this->is_valid()) {
     this->release();
     return 0;
   }
-  const u4 written = (u4)end_write();
+  u4 written = (u4)end_write();
   if (written > sizeof(u4)) { // larger than header reserve
-    this->write_padded_at_offset(written, 0);
+    const u4 compact_size = written - (u4)(sizeof(u4) - 1);
+    if (compact && compressed_integers() && compact_size <= max_compact_event_size) {
+      u1* const start = const_cast<u1*>(this->start_pos());
+      memmove(start + 1, start + sizeof(u4), written - sizeof(u4));
+      *start = (u1)compact_size;
+      this->set_current_pos(start + compact_size);
+      written = compact_size;
+    } else {
+      this->write_padded_at_offset(written, 0);
+    }
     this->commit();
   }
   this->release();
@@ -91,7 +106,7 @@ inline StackEventWriterHost<BE, IE, WriterPolicyImpl>::StackEventWriterHost(Thre
 
 template <typename BE, typename IE, typename WriterPolicyImpl>
 inline StackEventWriterHost<BE, IE, WriterPolicyImpl>::~StackEventWriterHost() {
-  this->end_event_write();
+  this->end_event_write(true);
 }
 
 #endif // SHARE_JFR_WRITERS_JFREVENTWRITERHOST_INLINE_HPP
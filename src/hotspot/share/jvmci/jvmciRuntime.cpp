@@ -1446,6 +1446,14 @@ JVMCI::CodeInstallResult JVMCIRuntime::register_method(JVMCIEnv* JVMCIENV,
     // Check for {class loads, evolution, breakpoints} during compilation
     result = validate_compile_task_dependencies(dependencies, JVMCIENV->compile_state(), &failure_detail);
     if (result != JVMCI::ok) {
+      LogTarget(Info, nmethod, install) lt;
+      if (lt.is_enabled()) {
+        ResourceMark rm;
+        char *method_name = method->name_and_sig_as_C_string();
+        lt.print("Not installing method (%d) %s: %s", comp_level, method_name,
+                 failure_detail != NULL ? failure_detail : "dependencies failed");
+      }
+
       // While not a true deoptimization, it is a preemptive decompile.
       MethodData* mdp = method()->method_data();
       if (mdp != NULL) {
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#include "precompiled.hpp"
+#include "jvm.h"
+#include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
+#include "logging/logConfiguration.hpp"
+#include "logging/logOutput.hpp"
+#include "logging/logTagSet.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.inline.hpp"
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+AsyncLogMessage::~AsyncLogMessage() {
+  os::free(_message);
+}
+
+size_t AsyncLogMessage::size() const {
+  return sizeof(AsyncLogMessage) + strlen(_message) + 1;
+}
+
+AsyncLogWriter::AsyncLogWriter()
+  : _lock(1), _io_sem(1), _data_available(0),
+    _head(NULL), _tail(NULL), _dropped(NULL),
+    _buffer_size(0), _buffer_max_size(AsyncLogBufferSize) {
+}
+
+// Copies the message. Returns NULL if the buffer is already full
+// or the copy could not be allocated, so the message is dropped.
+static AsyncLogMessage* new_message(LogOutput* output, const LogDecorations& decorations,
+                                    const char* msg, bool buffer_full) {
+  if (buffer_full) {
+    return NULL;
+  }
+  char* copy = os::strdup(msg, mtLogging);
+  if (copy == NULL) {
+    return NULL;
+  }
+  AsyncLogMessage* m = new (std::nothrow) AsyncLogMessage(output, decorations, copy);
+  if (m == NULL) {
+    os::free(copy);
+  }
+  return m;
+}
+
+void AsyncLogWriter::count_dropped_locked(LogOutput* output, uint32_t count) {
+  for (AsyncLogDropCounter* c = _dropped; c != NULL; c = c->_next) {
+    if (c->_output == output) {
+      c->_count += count;
+      return;
+    }
+  }
+  AsyncLogDropCounter* c = new (std::nothrow) AsyncLogDropCounter();
+  if (c != NULL) {
+    c->_output = output;
+    c->_count = count;
+    c->_next = _dropped;
+    _dropped = c;
+  }
+}
+
+void AsyncLogWriter::append(LogOutput* output, AsyncLogMessage* messages, uint32_t dropped) {
+  AsyncLogMessage* rejected = NULL;
+
+  _lock.wait();
+  const bool was_empty = _head == NULL;
+  while (messages != NULL) {
+    AsyncLogMessage* m = messages;
+    messages = m->_next;
+    m->_next = NULL;
+    size_t size = m->size();
+    if (_buffer_size + size > _buffer_max_size) {
+      m->_next = rejected;
+      rejected = m;
+      dropped++;
+      continue;
+    }
+    if (_tail == NULL) {
+      _head = m;
+    } else {
+      _tail->_next = m;
+    }
+    _tail = m;
+    _buffer_size += size;
+  }
+  if (dropped > 0) {
+    count_dropped_locked(output, dropped);
+  }
+  const bool notify = was_empty && _head != NULL;
+  _lock.signal();
+
+  if (notify) {
+    _data_available.signal();
+  }
+  while (rejected != NULL) {
+    AsyncLogMessage* m = rejected;
+    rejected = m->_next;
+    delete m;
+  }
+}
+
+void AsyncLogWriter::enqueue(LogOutput& output, const LogDecorations& decorations, const char* msg) {
+  // The unlocked read of _buffer_size only saves the copy when the buffer
+  // is full; the actual check is done in append().
+  AsyncLogMessage* m = new_message(&output, decorations, msg, _buffer_size >= _buffer_max_size);
+  append(&output, m, m == NULL ? 1 : 0);
+}
+
+void AsyncLogWriter::enqueue(LogOutput& output, LogMessageBuffer::Iterator msg_iterator) {
+  // Copy all lines before taking the lock, then append them at
+  // once so they are not interleaved with other messages.
+  AsyncLogMessage* first = NULL;
+  AsyncLogMessage* last = NULL;
+  uint32_t dropped = 0;
+  for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    AsyncLogMessage* m = new_message(&output, msg_iterator.decorations(), msg_iterator.message(),
+                                     _buffer_size >= _buffer_max_size);
+    if (m == NULL) {
+      dropped++;
+      continue;
+    }
+    if (last == NULL) {
+      first = m;
+    } else {
+      last->_next = m;
+    }
+    last = m;
+  }
+  append(&output, first, dropped);
+}
+
+void AsyncLogWriter::write() {
+  _io_sem.wait();
+
+  _lock.wait();
+  AsyncLogMessage* messages = _head;
+  AsyncLogDropCounter* dropped = _dropped;
+  _head = NULL;
+  _tail = NULL;
+  _dropped = NULL;
+  _buffer_size = 0;
+  _lock.signal();
+
+  while (messages != NULL) {
+    AsyncLogMessage* m = messages;
+    messages = m->_next;
+    m->_output->write(m->_decorations, m->_message);
+    delete m;
+  }
+
+  while (dropped != NULL) {
+    AsyncLogDropCounter* c = dropped;
+    dropped = c->_next;
+    char buf[64];
+    jio_snprintf(buf, sizeof(buf), UINT32_FORMAT " messages dropped due to async logging", c->_count);
+    LogDecorations decorations(LogLevel::Warning, LogTagSetMapping<LOG_TAGS(logging)>::tagset(),
+                               c->_output->decorators());
+    c->_output->write(decorations, buf);
+    delete c;
+  }
+
+  _io_sem.signal();
+}
+
+void AsyncLogWriter::run() {
+  while (true) {
+    _data_available.wait();
+    write();
+  }
+}
+
+void AsyncLogWriter::initialize() {
+  if (!LogConfiguration::is_async_mode()) {
+    return;
+  }
+
+  assert(_instance == NULL, "initialize() should only be invoked once");
+  AsyncLogWriter* self = new AsyncLogWriter();
+  if (!os::create_thread(self, os::os_thread)) {
+    log_warning(logging, thread)("AsyncLogWriter failed to create thread. Falling back to synchronous logging.");
+    return;
+  }
+  OrderAccess::release_store(&_instance, self);
+  os::start_thread(self);
+  log_debug(logging, thread)("Async logging thread started.");
+}
+
+void AsyncLogWriter::flush() {
+  if (_instance != NULL) {
+    _instance->write();
+  }
+}
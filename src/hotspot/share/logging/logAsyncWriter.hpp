@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#ifndef SHARE_LOGGING_LOGASYNCWRITER_HPP
+#define SHARE_LOGGING_LOGASYNCWRITER_HPP
+
+#include "logging/logDecorations.hpp"
+#include "logging/logMessageBuffer.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/semaphore.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class LogOutput;
+
+// A log message waiting to be written by the AsyncLogWriter.
+// Both the message and its decorations are copied, so the
+// logging thread does not have to wait until it is written.
+class AsyncLogMessage : public CHeapObj<mtLogging> {
+  friend class AsyncLogWriter;
+ private:
+  LogOutput* const     _output;
+  const LogDecorations _decorations;
+  char* const          _message;
+  AsyncLogMessage*     _next;
+
+ public:
+  // Takes ownership of the C heap allocated message.
+  AsyncLogMessage(LogOutput* output, const LogDecorations& decorations, char* message)
+    : _output(output), _decorations(decorations), _message(message), _next(NULL) { }
+
+  ~AsyncLogMessage();
+
+  // The number of bytes this message accounts for in the buffer.
+  size_t size() const;
+};
+
+// Counts the messages dropped for an output since the buffer was last written.
+struct AsyncLogDropCounter : public CHeapObj<mtLogging> {
+  LogOutput*           _output;
+  uint32_t             _count;
+  AsyncLogDropCounter* _next;
+};
+
+// The asynchronous log writer, enabled with -Xlog:async.
+//
+// Log calls do not write to their outputs when it is active. Instead, the
+// message and its decorations are copied into an in-memory buffer and this
+// thread writes them out to the outputs. Logging threads never wait for
+// I/O; they only take a short lock to append to the buffer. The buffer is
+// bounded by AsyncLogBufferSize. Messages that do not fit are dropped
+// instead of blocking the logging thread, and the number of dropped
+// messages is reported on the affected output the next time it is written.
+class AsyncLogWriter : public NonJavaThread {
+ private:
+  static AsyncLogWriter* _instance;
+
+  // Protects the buffer and the drop counters. Only pointer updates
+  // are done while holding it, so a semaphore is sufficient.
+  Semaphore _lock;
+  // Serializes the writing of the buffer. Taken before the buffer is
+  // detached, so messages are written in the order they were logged.
+  Semaphore _io_sem;
+  // Signaled when messages have been added to an empty buffer.
+  Semaphore _data_available;
+
+  AsyncLogMessage*     _head;
+  AsyncLogMessage*     _tail;
+  AsyncLogDropCounter* _dropped;
+  size_t               _buffer_size;
+  const size_t         _buffer_max_size;
+
+  AsyncLogWriter();
+
+  void count_dropped_locked(LogOutput* output, uint32_t count);
+
+  // Appends the linked messages to the buffer, or drops them if they do not
+  // fit. 'dropped' is the number of messages that could not even be copied.
+  void append(LogOutput* output, AsyncLogMessage* messages, uint32_t dropped);
+
+  // Writes out everything buffered so far.
+  void write();
+
+  virtual void run();
+
+ public:
+  virtual char* name() const { return (char*)"AsyncLog Thread"; }
+
+  void enqueue(LogOutput& output, const LogDecorations& decorations, const char* msg);
+  void enqueue(LogOutput& output, LogMessageBuffer::Iterator msg_iterator);
+
+  // Returns the writer, or NULL if asynchronous logging is not active.
+  static AsyncLogWriter* instance() { return _instance; }
+
+  // Starts the writer thread if -Xlog:async was given.
+  static void initialize();
+
+  // Writes out all buffered messages on the calling thread. Must be called
+  // before an output is deleted, and before the VM exits.
+  static void flush();
+};
+
+#endif // SHARE_LOGGING_LOGASYNCWRITER_HPP
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logDecorators.hpp"
@@ -45,6 +46,8 @@ size_t      LogConfiguration::_n_outputs = 0;
 LogConfiguration::UpdateListenerFunction* LogConfiguration::_listener_callbacks = NULL;
 size_t      LogConfiguration::_n_listener_callbacks = 0;
 
+bool        LogConfiguration::_async_mode = false;
+
 // LogFileOutput is the default type of output, its type prefix should be used if no type was specified
 static const char* implicit_output_prefix = LogFileOutput::Prefix;
 
@@ -111,6 +114,7 @@ void LogConfiguration::initialize(jlong vm_start_time) {
 }
 
 void LogConfiguration::finalize() {
+  AsyncLogWriter::flush();
   for (size_t i = _n_outputs; i > 0; i--) {
     disable_output(i - 1);
   }
@@ -207,6 +211,8 @@ void LogConfiguration::delete_output(size_t idx) {
          "idx must be in range 1 < idx < _n_outputs, but idx = " SIZE_FORMAT
          " and _n_outputs = " SIZE_FORMAT, idx, _n_outputs);
   LogOutput* output = _outputs[idx];
+  // Write out any messages still buffered for the output before it goes away.
+  AsyncLogWriter::flush();
   // Swap places with the last output and shrink the array
   _outputs[idx] = _outputs[--_n_outputs];
   _outputs = REALLOC_C_HEAP_ARRAY(LogOutput*, _outputs, _n_outputs, mtLogging);
@@ -501,6 +507,10 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr("\t where 'selections' are combinations of tags and levels of the form tag1[+tag2...][*][=level][,...]");
   out->print_cr("\t NOTE: Unless wildcard (*) is specified, only log messages tagged with exactly the tags specified will be matched.");
   out->cr();
+  out->print_cr("-Xlog:async");
+  out->print_cr("\t Write all logging asynchronously from a dedicated thread, using a buffer of AsyncLogBufferSize bytes.");
+  out->print_cr("\t Messages that do not fit into the buffer are dropped, and the number of dropped messages is reported.");
+  out->cr();
 
   out->print_cr("Available log levels:");
   for (size_t i = 0; i < LogLevel::Count; i++) {
@@ -536,6 +546,8 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr("   filecount=.. - Number of files to keep in rotation (not counting the active file)."
                                     " If set to 0, log rotation is disabled."
                                     " This will cause existing log files to be overwritten.");
+  out->print_cr("   format=..    - Either 'text' (default) or 'json'. With 'json' each message is written as one JSON object"
+                                    " per line, with the selected decorators as fields and numeric decorators as plain numbers.");
   out->cr();
 
   out->print_cr("Some examples:");
@@ -567,6 +579,11 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr("\t using the base name 'gctrace.txt', with 'uptimemillis' and 'pid' decorations.");
   out->cr();
 
+  out->print_cr(" -Xlog:gc*:file=gc.jsonl:uptimemillis,level,tags:format=json");
+  out->print_cr("\t Log messages tagged with at least 'gc' up to 'info' level to file 'gc.jsonl' as JSON lines,");
+  out->print_cr("\t e.g. {\"uptimemillis\":1234,\"level\":\"info\",\"tags\":\"gc\",\"message\":\"...\"}.");
+  out->cr();
+
   out->print_cr(" -Xlog:gc::uptime,tid");
   out->print_cr("\t Log messages tagged with 'gc' tag up to 'info' level to output 'stdout', using 'uptime' and 'tid' decorations.");
   out->cr();
@@ -53,6 +53,9 @@ class LogDecorations {
 
   LogDecorations(LogLevelType level, const LogTagSet& tagset, const LogDecorators& decorators);
 
+  // Copies the decorations, e.g. for a message that is written asynchronously.
+  LogDecorations(const LogDecorations& other);
+
   void set_level(LogLevelType level) {
     _level = level;
   }
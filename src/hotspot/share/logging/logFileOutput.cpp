@@ -39,6 +39,7 @@ const char* const LogFileOutput::TimestampFilenamePlaceholder = "%t";
 const char* const LogFileOutput::TimestampFormat = "%Y-%m-%d_%H-%M-%S";
 const char* const LogFileOutput::FileSizeOptionKey = "filesize";
 const char* const LogFileOutput::FileCountOptionKey = "filecount";
+const char* const LogFileOutput::FormatOptionKey = "format";
 char        LogFileOutput::_pid_str[PidBufferSize];
 char        LogFileOutput::_vm_start_time_str[StartTimeBufferSize];
 
@@ -215,6 +216,16 @@ bool LogFileOutput::parse_options(const char* options, outputStream* errstream)
         break;
       }
       _rotate_size = static_cast<size_t>(value);
+    } else if (strcmp(FormatOptionKey, key) == 0) {
+      if (strcmp(value_str, "text") == 0) {
+        _json = false;
+      } else if (strcmp(value_str, "json") == 0) {
+        _json = true;
+      } else {
+        errstream->print_cr("Invalid option: %s must be either 'text' or 'json'", FormatOptionKey);
+        success = false;
+        break;
+      }
     } else {
       errstream->print_cr("Invalid option '%s' for log file output.", key);
       success = false;
@@ -460,4 +471,7 @@ void LogFileOutput::describe(outputStream *out) {
   out->print("filecount=%u,filesize=" SIZE_FORMAT "%s", _file_count,
              byte_size_in_proper_unit(_rotate_size),
              proper_unit_for_byte_size(_rotate_size));
+  if (_json) {
+    out->print(",%s=json", FormatOptionKey);
+  }
 }
@@ -72,11 +72,88 @@ int LogFileStreamOutput::write_decorations(const LogDecorations& decorations) {
   return total_written;
 }
 
+// Writes str as a quoted JSON string, escaping quotes, backslashes and control characters.
+int LogFileStreamOutput::write_json_string(const char* str) {
+  int written = 0;
+  const char* run = str;
+  const char* pos = str;
+  fputc('"', _stream);
+  for (; *pos != '\0'; pos++) {
+    unsigned char c = static_cast<unsigned char>(*pos);
+    if (c != '"' && c != '\\' && c >= 0x20) {
+      continue;
+    }
+    written += (int)fwrite(run, 1, pos - run, _stream);
+    switch (c) {
+      case '"':  written += jio_fprintf(_stream, "\\\""); break;
+      case '\\': written += jio_fprintf(_stream, "\\\\"); break;
+      case '\n': written += jio_fprintf(_stream, "\\n"); break;
+      case '\t': written += jio_fprintf(_stream, "\\t"); break;
+      default:   written += jio_fprintf(_stream, "\\u%04x", c); break;
+    }
+    run = pos + 1;
+  }
+  written += (int)fwrite(run, 1, pos - run, _stream);
+  fputc('"', _stream);
+  return written + 2;
+}
+
+// Numeric decorations carry a unit suffix (s, ms, ns) in text mode.
+// In JSON mode they are written as plain numbers so consumers need not parse them.
+static bool is_numeric_decorator(LogDecorators::Decorator decorator) {
+  switch (decorator) {
+    case LogDecorators::uptime_decorator:
+    case LogDecorators::timemillis_decorator:
+    case LogDecorators::uptimemillis_decorator:
+    case LogDecorators::timenanos_decorator:
+    case LogDecorators::uptimenanos_decorator:
+    case LogDecorators::pid_decorator:
+    case LogDecorators::tid_decorator:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Writes one line of the form {"uptime":0.943,"level":"info","tags":"gc","message":"..."}.
+// The caller holds the stream lock.
+int LogFileStreamOutput::write_json(const LogDecorations& decorations, const char* msg) {
+  int written = jio_fprintf(_stream, "{");
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (!_decorators.is_decorator(decorator)) {
+      continue;
+    }
+    const char* value = decorations.decoration(decorator);
+    written += jio_fprintf(_stream, "\"%s\":", LogDecorators::name(decorator));
+    if (is_numeric_decorator(decorator)) {
+      size_t len = strlen(value);
+      while (len > 0 && isalpha(value[len - 1])) {
+        len--;
+      }
+      written += (int)fwrite(value, 1, len, _stream);
+    } else {
+      written += write_json_string(value);
+    }
+    written += jio_fprintf(_stream, ",");
+  }
+  written += jio_fprintf(_stream, "\"message\":");
+  written += write_json_string(msg);
+  written += jio_fprintf(_stream, "}\n");
+  return written;
+}
+
 int LogFileStreamOutput::write(const LogDecorations& decorations, const char* msg) {
   const bool use_decorations = !_decorators.is_empty();
 
   int written = 0;
   os::flockfile(_stream);
+  if (_json) {
+    written += write_json(decorations, msg);
+    fflush(_stream);
+    os::funlockfile(_stream);
+    return written;
+  }
   if (use_decorations) {
     written += write_decorations(decorations);
     written += jio_fprintf(_stream, " ");
@@ -94,6 +171,10 @@ int LogFileStreamOutput::write(LogMessageBuffer::Iterator msg_iterator) {
   int written = 0;
   os::flockfile(_stream);
   for (; !msg_iterator.is_at_end(); msg_iterator++) {
+    if (_json) {
+      written += write_json(msg_iterator.decorations(), msg_iterator.message());
+      continue;
+    }
     if (use_decorations) {
       written += write_decorations(msg_iterator.decorations());
       written += jio_fprintf(_stream, " ");
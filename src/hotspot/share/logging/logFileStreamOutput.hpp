@@ -43,14 +43,18 @@ class LogFileStreamOutput : public LogOutput {
  protected:
   FILE*               _stream;
   size_t              _decorator_padding[LogDecorators::Count];
+  // Write each message as a single JSON object per line instead of text
+  bool                _json;
 
-  LogFileStreamOutput(FILE *stream) : _stream(stream) {
+  LogFileStreamOutput(FILE *stream) : _stream(stream), _json(false) {
     for (size_t i = 0; i < LogDecorators::Count; i++) {
       _decorator_padding[i] = 0;
     }
   }
 
   int write_decorations(const LogDecorations& decorations);
+  int write_json(const LogDecorations& decorations, const char* msg);
+  int write_json_string(const char* str);
 
  public:
   virtual int write(const LogDecorations& decorations, const char* msg);
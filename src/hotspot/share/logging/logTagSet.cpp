@@ -23,6 +23,7 @@
  */
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logFileStreamOutput.hpp"
 #include "logging/logLevel.hpp"
@@ -74,15 +75,25 @@ bool LogTagSet::has_output(const LogOutput* output) {
 
 void LogTagSet::log(LogLevelType level, const char* msg) {
   LogDecorations decorations(level, *this, _decorators);
+  AsyncLogWriter* async_writer = AsyncLogWriter::instance();
   for (LogOutputList::Iterator it = _output_list.iterator(level); it != _output_list.end(); it++) {
-    (*it)->write(decorations, msg);
+    if (async_writer != NULL) {
+      async_writer->enqueue(**it, decorations, msg);
+    } else {
+      (*it)->write(decorations, msg);
+    }
   }
 }
 
 void LogTagSet::log(const LogMessageBuffer& msg) {
   LogDecorations decorations(LogLevel::Invalid, *this, _decorators);
+  AsyncLogWriter* async_writer = AsyncLogWriter::instance();
   for (LogOutputList::Iterator it = _output_list.iterator(msg.least_detailed_level()); it != _output_list.end(); it++) {
-    (*it)->write(msg.iterator(it.level(), decorations));
+    if (async_writer != NULL) {
+      async_writer->enqueue(**it, msg.iterator(it.level(), decorations));
+    } else {
+      (*it)->write(msg.iterator(it.level(), decorations));
+    }
   }
 }
 
@@ -51,6 +51,12 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* _small_pool;
   static ChunkPool* _tiny_pool;
 
+  // Pools for the chunks above Chunk::size, which double in size from
+  // one class to the next. Compilations with big arenas get their chunks
+  // from here instead of going to malloc for every one of them.
+  enum { num_huge_pools = 5 }; // up to 1M
+  static ChunkPool* _huge_pools[num_huge_pools];
+
   // return first element or null
   void* get_first() {
     Chunk* c = _first;
@@ -130,11 +136,38 @@ class ChunkPool: public CHeapObj<mtInternal> {
   static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
   static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
 
+  static size_t huge_length(int i) {
+    return (((size_t)Chunk::size + Chunk::slack) << (i + 1)) - Chunk::slack;
+  }
+
+  // Returns the pool for chunks of exactly this length, or NULL
+  static ChunkPool* huge_pool(size_t length) {
+    for (int i = 0; i < num_huge_pools; i++) {
+      if (length == huge_length(i)) {
+        assert(_huge_pools[i] != NULL, "must be initialized");
+        return _huge_pools[i];
+      }
+    }
+    return NULL;
+  }
+
+  static size_t pooled_length(size_t length) {
+    for (int i = 0; i < num_huge_pools; i++) {
+      if (length <= huge_length(i)) {
+        return huge_length(i);
+      }
+    }
+    return length;
+  }
+
   static void initialize() {
     _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
     _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
     _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
     _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    for (int i = 0; i < num_huge_pools; i++) {
+      _huge_pools[i] = new ChunkPool(huge_length(i) + Chunk::aligned_overhead_size());
+    }
   }
 
   static void clean() {
@@ -143,6 +176,11 @@ class ChunkPool: public CHeapObj<mtInternal> {
      _small_pool->free_all_but(BlocksToKeep);
      _medium_pool->free_all_but(BlocksToKeep);
      _large_pool->free_all_but(BlocksToKeep);
+     // Keep one chunk of each huge size class; more would retain a lot of
+     // memory between compilations.
+     for (int i = 0; i < num_huge_pools; i++) {
+       _huge_pools[i]->free_all_but(1);
+     }
   }
 };
 
@@ -150,6 +188,7 @@ ChunkPool* ChunkPool::_large_pool  = NULL;
 ChunkPool* ChunkPool::_medium_pool = NULL;
 ChunkPool* ChunkPool::_small_pool  = NULL;
 ChunkPool* ChunkPool::_tiny_pool   = NULL;
+ChunkPool* ChunkPool::_huge_pools[ChunkPool::num_huge_pools] = { NULL };
 
 void chunkpool_init() {
   ChunkPool::initialize();
@@ -191,6 +230,10 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
    case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
    case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
    default: {
+     ChunkPool* pool = ChunkPool::huge_pool(length);
+     if (pool != NULL) {
+       return pool->allocate(bytes, alloc_failmode);
+     }
      void* p = os::malloc(bytes, mtChunk, CALLER_PC);
      if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
        vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
@@ -207,12 +250,22 @@ void Chunk::operator delete(void* p) {
    case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
    case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
    case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
-   default:
+   default: {
+     ChunkPool* pool = ChunkPool::huge_pool(c->length());
+     if (pool != NULL) {
+       pool->free(c);
+       break;
+     }
      ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
      os::free(c);
+   }
   }
 }
 
+size_t Chunk::pooled_length(size_t length) {
+  return ChunkPool::pooled_length(length);
+}
+
 Chunk::Chunk(size_t length) : _len(length) {
   _next = NULL;         // Chain on the linked list
 }
@@ -350,6 +403,9 @@ void Arena::signal_out_of_memory(size_t sz, const char* whence) const {
 void* Arena::grow(size_t x, AllocFailType alloc_failmode) {
   // Get minimal required size.  Either real big, or even bigger for giant objs
   size_t len = MAX2(x, (size_t) Chunk::size);
+  if (len > (size_t) Chunk::size) {
+    len = Chunk::pooled_length(len);
+  }
 
   Chunk *k = _chunk;            // Get filled-up chunk address
   _chunk = new (alloc_failmode, len) Chunk(len);
@@ -69,6 +69,10 @@ class Chunk: CHeapObj<mtChunk> {
     non_pool_size = init_size + 32 // An initial size which is not one of above
   };
 
+  // Rounds up the length of a chunk larger than Chunk::size to one of the
+  // geometric size classes kept in the chunk pools, if there is one.
+  static size_t pooled_length(size_t length);
+
   void chop();                  // Chop this chunk
   void next_chop();             // Chop next chunk
   static size_t aligned_overhead_size(void) { return ARENA_ALIGN(sizeof(Chunk)); }
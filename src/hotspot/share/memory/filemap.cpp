@@ -55,6 +55,7 @@
 #include "runtime/vm_version.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/align.hpp"
+#include "utilities/bitMap.inline.hpp"
 #include "utilities/classpathStream.hpp"
 #include "utilities/defaultStream.hpp"
 #if INCLUDE_G1GC
@@ -197,6 +198,7 @@ FileMapInfo::FileMapInfo(bool is_static) {
   _header->set_has_platform_or_app_classes(true);
   _file_offset = 0;
   _file_open = false;
+  _relocation_delta = 0;
 }
 
 FileMapInfo::~FileMapInfo() {
@@ -256,6 +258,17 @@ void FileMapHeader::populate(FileMapInfo* mapinfo, size_t alignment) {
   _base_archive_is_default = false;
 }
 
+void FileMapHeader::relocate(intx delta) {
+  for (int i = 0; i < MetaspaceShared::num_core_spaces; i++) {
+    space_at(i)->relocate(delta);
+  }
+  _misc_data_patching_start += delta;
+  _serialized_data_start += delta;
+  _i2i_entry_code_buffers += delta;
+  _shared_path_table.set_table((Array<u8>*)((address)_shared_path_table.table() + delta));
+  _shared_base_address += delta;
+}
+
 void SharedClassPathEntry::init_as_non_existent(const char* path, TRAPS) {
   _type = non_existent_entry;
   set_name(path, THREAD);
@@ -1240,6 +1253,27 @@ size_t FileMapInfo::write_archive_heap_regions(GrowableArray<MemRegion> *heap_me
   return total_size;
 }
 
+// Write the bitmap of pointer locations in the core spaces, which is needed
+// to map the archive at a different address. A NULL ptrmap marks the archive
+// as not relocatable.
+void FileMapInfo::write_ptrmap(CHeapBitMap* ptrmap) {
+  if (ptrmap == NULL) {
+    header()->set_ptrmap(0, 0);
+    return;
+  }
+  size_t size_in_bytes = ptrmap->size_in_bytes();
+  BitMap::bm_word_t* buffer = NEW_C_HEAP_ARRAY(BitMap::bm_word_t, size_in_bytes / sizeof(BitMap::bm_word_t), mtClassShared);
+  ptrmap->write_to(buffer, size_in_bytes);
+
+  align_file_position();
+  header()->set_ptrmap(_file_offset, ptrmap->size());
+  log_info(cds)("Pointer bitmap: " SIZE_FORMAT " bits, file offset " SIZE_FORMAT_HEX_W(08),
+                ptrmap->size(), _file_offset);
+  write_bytes(buffer, size_in_bytes);
+  align_file_position();
+  FREE_C_HEAP_ARRAY(BitMap::bm_word_t, buffer);
+}
+
 // Dump bytes to file -- at the current file position.
 
 void FileMapInfo::write_bytes(const void* buffer, size_t nbytes) {
@@ -1331,6 +1365,15 @@ bool FileMapInfo::remap_shared_readonly_as_readwrite() {
   return true;
 }
 
+// The archive can be mapped at a different address only if it was written
+// with a pointer bitmap. A dynamic archive being dumped on top of this one
+// refers to the base archive by its dump time addresses.
+bool FileMapInfo::can_relocate() const {
+  return ArchiveRelocationMode != 2 &&
+         header()->ptrmap_size_in_bits() != 0 &&
+         !DynamicDumpSharedSpaces;
+}
+
 // Map the whole region at once, assumed to be allocated contiguously.
 ReservedSpace FileMapInfo::reserve_shared_memory() {
   char* requested_addr = region_addr(0);
@@ -1338,7 +1381,22 @@ ReservedSpace FileMapInfo::reserve_shared_memory() {
 
   // Reserve the space first, then map otherwise map will go right over some
   // other reserved memory (like the code cache).
-  ReservedSpace rs(size, os::vm_allocation_granularity(), false, requested_addr);
+  ReservedSpace rs;
+  if (ArchiveRelocationMode != 1) {
+    rs = ReservedSpace(size, os::vm_allocation_granularity(), false, requested_addr);
+  }
+  if (!rs.is_reserved() && can_relocate()) {
+    // Map the archive anywhere and relocate it. The base must be aligned for the
+    // compressed class space, which is placed right after the core spaces.
+    rs = ReservedSpace(size, Metaspace::reserve_alignment(), false);
+    if (rs.is_reserved()) {
+      _relocation_delta = rs.base() - requested_addr;
+      header()->relocate(_relocation_delta);
+      SharedBaseAddress = header()->shared_base_address();
+      log_info(cds)("Relocating shared space from " INTPTR_FORMAT " to " INTPTR_FORMAT,
+                    p2i(requested_addr), p2i(rs.base()));
+    }
+  }
   if (!rs.is_reserved()) {
     fail_continue("Unable to reserve shared space at required address "
                   INTPTR_FORMAT, p2i(requested_addr));
@@ -1396,6 +1454,12 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
       Arguments::has_jfr_option()) {
     si->set_read_only(false);
   }
+  // The pointers in a relocated archive are patched after mapping. Keep the
+  // mapping writable, since remapping the read-only region from the file
+  // would lose the patched pointers.
+  if (_relocation_delta != 0) {
+    si->set_read_only(false);
+  }
 #endif // _WINDOWS
 
   // map the contents of the CDS archive in this memory
@@ -1421,6 +1485,55 @@ char* FileMapInfo::map_region(int i, char** top_ret) {
   return base;
 }
 
+// Adjust every pointer recorded in the pointer bitmap by the relocation delta.
+class RelocateSharedPointers: public BitMapClosure {
+  address* _bottom;
+  address _old_base;
+  address _old_end;
+  intx _delta;
+  size_t _num_relocated;
+ public:
+  RelocateSharedPointers(address* bottom, address old_base, address old_end, intx delta) :
+    _bottom(bottom), _old_base(old_base), _old_end(old_end), _delta(delta), _num_relocated(0) {}
+
+  bool do_bit(size_t offset) {
+    address* p = _bottom + offset;
+    address old_ptr = *p;
+    if (old_ptr >= _old_base && old_ptr <= _old_end) {
+      *p = old_ptr + _delta;
+      _num_relocated++;
+    }
+    return true; // keep iterating
+  }
+
+  size_t num_relocated() const { return _num_relocated; }
+};
+
+bool FileMapInfo::relocate_pointers() {
+  assert(_relocation_delta != 0, "only called for relocated archives");
+  size_t size_in_bits = header()->ptrmap_size_in_bits();
+  size_t size_in_bytes = BitMap::calc_size_in_bytes(size_in_bits);
+  BitMap::bm_word_t* buffer = NEW_C_HEAP_ARRAY(BitMap::bm_word_t, size_in_bytes / sizeof(BitMap::bm_word_t), mtClassShared);
+
+  seek_to_position(header()->ptrmap_file_offset());
+  if (read_bytes(buffer, size_in_bytes) != size_in_bytes) {
+    FREE_C_HEAP_ARRAY(BitMap::bm_word_t, buffer);
+    fail_continue("Unable to read the pointer bitmap.");
+    return false;
+  }
+
+  address* bottom = (address*)region_addr(0);
+  address old_base = (address)bottom - _relocation_delta;
+  BitMapView ptrmap(buffer, size_in_bits);
+  RelocateSharedPointers patcher(bottom, old_base, old_base + core_spaces_size(), _relocation_delta);
+  ptrmap.iterate(&patcher);
+  FREE_C_HEAP_ARRAY(BitMap::bm_word_t, buffer);
+
+  log_info(cds)("Relocated " SIZE_FORMAT " pointers by " INTX_FORMAT " bytes",
+                patcher.num_relocated(), _relocation_delta);
+  return true;
+}
+
 size_t FileMapInfo::read_bytes(void* buffer, size_t count) {
   assert(_file_open, "Archive file is not open");
   size_t n = os::read(_fd, buffer, (unsigned int)count);
@@ -1527,6 +1640,12 @@ void FileMapInfo::map_heap_regions_impl() {
   log_info(cds)("    narrow_oop_mode = %d, narrow_oop_base = " PTR_FORMAT ", narrow_oop_shift = %d",
                 CompressedOops::mode(), p2i(CompressedOops::base()), CompressedOops::shift());
 
+  if (_relocation_delta != 0) {
+    // The archived mirrors contain Klass pointers with the dump time addresses.
+    log_info(cds)("CDS heap data cannot be used because the archive has been relocated.");
+    return;
+  }
+
   if (narrow_klass_base() != CompressedKlassPointers::base() ||
       narrow_klass_shift() != CompressedKlassPointers::shift()) {
     log_info(cds)("CDS heap data cannot be used because the archive was created with an incompatible narrow klass encoding mode.");
@@ -32,6 +32,8 @@
 #include "oops/compressedOops.hpp"
 #include "utilities/align.hpp"
 
+class CHeapBitMap;
+
 // Layout of the file:
 //  header: dump of archive instance plus versioning info, datestamp, etc.
 //   [magic # = 0xF00BABA2]
@@ -151,6 +153,7 @@ public:
   void set_file_offset(size_t s) { _file_offset = s; }
   void set_read_only(bool v)     { _read_only = v; }
   void mark_invalid()            { _addr._base = NULL; }
+  void relocate(intx delta)      { assert_is_not_heap_region(); _addr._base += delta; }
 
   void init(bool is_heap_region, char* base, size_t size, bool read_only,
             bool allow_exec, int crc);
@@ -213,6 +216,8 @@ class FileMapHeader: private CDSFileMapHeaderBase {
   bool   _has_platform_or_app_classes;  // Archive contains app classes
   size_t _shared_base_address;          // SharedBaseAddress used at dump time
   bool   _allow_archiving_with_java_agent; // setting of the AllowArchivingWithJavaAgent option
+  size_t _ptrmap_file_offset;           // file offset of the pointer bitmap
+  size_t _ptrmap_size_in_bits;          // 0 if the archive cannot be relocated
 
 public:
   // Accessors -- fields declared in CDSFileMapHeaderBase
@@ -247,6 +252,8 @@ public:
   size_t shared_base_address()             const { return _shared_base_address; }
   bool has_platform_or_app_classes()       const { return _has_platform_or_app_classes; }
   SharedPathTable shared_path_table()      const { return _shared_path_table; }
+  size_t ptrmap_file_offset()              const { return _ptrmap_file_offset; }
+  size_t ptrmap_size_in_bits()             const { return _ptrmap_size_in_bits; }
 
   // FIXME: These should really return int
   jshort max_used_path_index()             const { return _max_used_path_index; }
@@ -262,6 +269,11 @@ public:
   void set_base_archive_is_default(bool b)       { _base_archive_is_default = b; }
   void set_header_size(size_t s)                 { _header_size = s; }
 
+  void set_ptrmap(size_t file_offset, size_t size_in_bits) {
+    _ptrmap_file_offset = file_offset;
+    _ptrmap_size_in_bits = size_in_bits;
+  }
+
   void set_i2i_entry_code_buffers(address p, size_t s) {
     _i2i_entry_code_buffers = p;
     _i2i_entry_code_buffers_size = s;
@@ -280,6 +292,10 @@ public:
   bool validate();
   int compute_crc();
 
+  // Adjust the addresses recorded at dump time after the core spaces have
+  // been reserved at a different address.
+  void relocate(intx delta);
+
   FileMapRegion* space_at(int i) {
     assert(is_valid_region(i), "invalid region");
     return FileMapRegion::cast(&_space[i]);
@@ -303,6 +319,7 @@ private:
   bool           _file_open;
   int            _fd;
   size_t         _file_offset;
+  intx           _relocation_delta; // mapped address - dump time address
   const char*    _full_path;
   const char*    _base_archive_name;
   FileMapHeader* _header;
@@ -373,6 +390,8 @@ public:
   void set_core_spaces_size(size_t s)         const { header()->set_core_spaces_size(s); }
   size_t core_spaces_size()                   const { return header()->core_spaces_size(); }
 
+  intx relocation_delta()                     const { return _relocation_delta; }
+
   class DynamicArchiveHeader* dynamic_header() const {
     assert(!_is_static, "must be");
     return (DynamicArchiveHeader*)header();
@@ -411,6 +430,7 @@ public:
   size_t write_archive_heap_regions(GrowableArray<MemRegion> *heap_mem,
                                     GrowableArray<ArchiveHeapOopmapInfo> *oopmaps,
                                     int first_region_id, int max_num_regions);
+  void  write_ptrmap(CHeapBitMap* ptrmap);
   void  write_bytes(const void* buffer, size_t count);
   void  write_bytes_aligned(const void* buffer, size_t count);
   size_t  read_bytes(void* buffer, size_t count);
@@ -429,7 +449,9 @@ public:
   bool  verify_region_checksum(int i);
   void  close();
   bool  is_open() { return _file_open; }
+  bool  can_relocate() const;
   ReservedSpace reserve_shared_memory();
+  bool  relocate_pointers();
 
   // JVM/TI RedefineClasses() support:
   // Remap the shared readonly space to shared readwrite, private.
@@ -518,6 +518,10 @@ void CodeHeap::add_to_freelist(HeapBlock* a) {
 
 /**
  * Search freelist for an entry on the list with the best fit.
+ * With CodeCacheCompactAllocation the first (lowest addressed) entry that
+ * fits is taken instead, and the allocation is carved from its start. Code
+ * that survives then stays packed towards the start of the heap, which
+ * keeps the hot part of a long running code cache dense for the iTLB.
  * @return NULL, if no one was found
  */
 HeapBlock* CodeHeap::search_freelist(size_t length) {
@@ -545,6 +549,10 @@ HeapBlock* CodeHeap::search_freelist(size_t length) {
       found_block  = cur;
       found_prev   = prev;
       found_length = cur_length;
+      if (CodeCacheCompactAllocation) {
+        // The freelist is address ordered, this is the lowest fit.
+        break;
+      }
     }
     // Next element in list
     prev = cur;
@@ -570,6 +578,20 @@ HeapBlock* CodeHeap::search_freelist(size_t length) {
       found_prev->set_link(found_block->link());
     }
     res = found_block;
+  } else if (CodeCacheCompactAllocation) {
+    // Return the leading part and let the remainder take the place
+    // of the free block in the list.
+    FreeBlock* rest = (FreeBlock*)split_block(found_block, length);
+    rest->set_free();
+    rest->set_link(found_block->link());
+    if (found_prev == NULL) {
+      assert(_freelist == found_block, "sanity check");
+      _freelist = rest;
+    } else {
+      assert((found_prev->link() == found_block), "sanity check");
+      found_prev->set_link(rest);
+    }
+    res = found_block;
   } else {
     // Truncate the free block and return the truncated part
     // as new HeapBlock. The remaining free block does not
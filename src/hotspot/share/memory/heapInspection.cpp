@@ -28,11 +28,15 @@
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/arrayOop.hpp"
+#include "oops/instanceOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/reflectionAccessorImplKlassHelper.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
@@ -242,6 +246,33 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _missed_count;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* dest) : _dest(dest), _missed_count(0) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    KlassInfoEntry* elt = _dest->lookup(cie->klass());
+    if (elt != NULL) {
+      elt->set_count(elt->count() + cie->count());
+      elt->set_words(elt->words() + cie->words());
+      _dest->_size_of_instances_in_words += cie->words();
+    } else {
+      _missed_count += cie->count();
+    }
+  }
+
+  size_t missed_count() const { return _missed_count; }
+};
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.missed_count();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -267,14 +298,28 @@ void KlassInfoHisto::print_elements(outputStream* st) const {
   // simplify the formatting (ILP32 vs LP64) - store the sum in 64-bit
   int64_t total = 0;
   uint64_t totalw = 0;
+  uint64_t header_bytes = 0;
   for(int i=0; i < elements()->length(); i++) {
     st->print("%4d: ", i+1);
     elements()->at(i)->print_on(st);
     total += elements()->at(i)->count();
     totalw += elements()->at(i)->words();
+    header_bytes += elements()->at(i)->count() * header_size_in_bytes(elements()->at(i)->klass());
   }
   st->print_cr("Total " INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13),
                total, totalw * HeapWordSize);
+  if (totalw > 0) {
+    st->print_cr("Object headers " UINT64_FORMAT " bytes (%.1f%% of total)",
+                 header_bytes, 100.0 * header_bytes / (totalw * HeapWordSize));
+  }
+}
+
+// Bytes used by the mark word, the klass pointer and, for arrays, the length
+uint64_t KlassInfoHisto::header_size_in_bytes(Klass* k) {
+  if (k->is_array_klass()) {
+    return arrayOopDesc::length_offset_in_bytes() + sizeof(int);
+  }
+  return instanceOopDesc::base_offset_in_bytes();
 }
 
 #define MAKE_COL_NAME(field, name, help)     #name,
@@ -715,15 +760,77 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
+// Each worker counts the objects it visits in its own KlassInfoTable,
+// which is then merged into the shared one.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable* _shared_cit;
+  BoolObjectClosure* _filter;
+  size_t _missed_count;
+  Mutex _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi, KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+      AbstractGangTask("Iterating heap"),
+      _poi(poi),
+      _shared_cit(shared_cit),
+      _filter(filter),
+      _missed_count(0),
+      _mutex(Mutex::leaf, "Parallel heap inspection merge lock", true,
+             Mutex::_safepoint_check_never) {}
+
+  size_t missed_count() const { return _missed_count; }
+
+  virtual void work(uint worker_id) {
+    KlassInfoTable cit(false);
+    if (cit.allocation_failed()) {
+      // Record straight into the shared table, one such worker at a time.
+      MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
+      RecordInstanceClosure ric(_shared_cit, _filter);
+      _poi->object_iterate(&ric, worker_id);
+      _missed_count += ric.missed_count();
+      return;
+    }
+
+    RecordInstanceClosure ric(&cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+
+    MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
+    _missed_count += ric.missed_count() + _shared_cit->merge(&cit);
+  }
+};
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter,
+                                      uint parallel_thread_num) {
   ResourceMark rm;
 
+  if (parallel_thread_num != 1) {
+    WorkGang* gang = Universe::heap()->get_safepoint_workers();
+    if (gang != NULL) {
+      uint num_workers = gang->active_workers();
+      if (parallel_thread_num > 0) {
+        num_workers = MIN2(num_workers, parallel_thread_num);
+      }
+      ParallelObjectIterator* poi = num_workers > 1 ?
+        Universe::heap()->parallel_object_iterator(num_workers) : NULL;
+      if (poi != NULL) {
+        ParHeapInspectTask task(poi, cit, filter);
+        gang->run_task(&task, num_workers);
+        delete poi;
+        return task.missed_count();
+      }
+    }
+  }
+
+  // The heap cannot be iterated in parallel, walk it on this thread.
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->safe_object_iterate(&ric);
   return ric.missed_count();
 }
 
-void HeapInspection::heap_inspection(outputStream* st) {
+void HeapInspection::heap_inspection(outputStream* st, uint parallel_thread_num) {
   ResourceMark rm;
 
   if (_print_help) {
@@ -747,7 +854,7 @@ void HeapInspection::heap_inspection(outputStream* st) {
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
     // populate table with object allocation info
-    size_t missed_count = populate_table(&cit);
+    size_t missed_count = populate_table(&cit, NULL, parallel_thread_num);
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
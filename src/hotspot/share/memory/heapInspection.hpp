@@ -255,9 +255,13 @@ class KlassInfoTable: public StackObj {
   void iterate(KlassInfoClosure* cic);
   bool allocation_failed() { return _buckets == NULL; }
   size_t size_of_instances_in_words() const;
+  // Adds the counts of table to this table. Returns the number of
+  // instances that could not be added for lack of C-heap.
+  size_t merge(KlassInfoTable* table);
 
   friend class KlassInfoHisto;
   friend class KlassHierarchy;
+  friend class KlassInfoTableMergeClosure;
 };
 
 class KlassHierarchy : AllStatic {
@@ -279,6 +283,7 @@ class KlassInfoHisto : public StackObj {
   GrowableArray<KlassInfoEntry*>* elements() const { return _elements; }
   static int sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2);
   void print_elements(outputStream* st) const;
+  static uint64_t header_size_in_bytes(Klass* k);
   void print_class_stats(outputStream* st, bool csv_format, const char *columns);
   julong annotations_bytes(Array<AnnotationArray*>* p) const;
   const char *_selected_columns;
@@ -358,8 +363,11 @@ class HeapInspection : public StackObj {
                  bool print_class_stats, const char *columns) :
       _csv_format(csv_format), _print_help(print_help),
       _print_class_stats(print_class_stats), _columns(columns) {}
-  void heap_inspection(outputStream* st) NOT_SERVICES_RETURN;
-  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL) NOT_SERVICES_RETURN_(0);
+  // parallel_thread_num is the number of GC workers to iterate the heap
+  // with, 0 meaning all of them.
+  void heap_inspection(outputStream* st, uint parallel_thread_num = 1) NOT_SERVICES_RETURN;
+  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL,
+                        uint parallel_thread_num = 1) NOT_SERVICES_RETURN_(0);
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
  private:
   void iterate_over_heap(KlassInfoTable* cit, BoolObjectClosure* filter = NULL);
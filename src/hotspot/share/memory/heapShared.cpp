@@ -355,6 +355,9 @@ void ArchivedKlassSubGraphInfoRecord::init(KlassSubGraphInfo* info) {
   _k = info->klass();
   _entry_field_records = NULL;
   _subgraph_object_klasses = NULL;
+  MetaspaceShared::mark_pointer((address*)&_k);
+  MetaspaceShared::mark_pointer((address*)&_entry_field_records);
+  MetaspaceShared::mark_pointer((address*)&_subgraph_object_klasses);
 
   // populate the entry fields
   GrowableArray<juint>* entry_fields = info->subgraph_entry_fields();
@@ -383,6 +386,7 @@ void ArchivedKlassSubGraphInfoRecord::init(KlassSubGraphInfo* info) {
           _k->external_name(), i, subgraph_k->external_name());
       }
       _subgraph_object_klasses->at_put(i, subgraph_k);
+      MetaspaceShared::mark_pointer((address*)_subgraph_object_klasses->adr_at(i));
     }
   }
 }
@@ -35,6 +35,7 @@
 #include "memory/metaspace/occupancyMap.hpp"
 #include "memory/metaspace/virtualSpaceNode.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/ostream.hpp"
@@ -135,6 +136,9 @@ bool ChunkManager::attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex
   // Add new chunk to its freelist.
   ChunkList* const list = free_chunks(target_chunk_type);
   list->return_chunk_at_head(p_new_chunk);
+  if (target_chunk_type == MediumIndex) {
+    release_chunk_pages(p_new_chunk);
+  }
 
   // And adjust ChunkManager:: _free_chunks_count (_free_chunks_total
   // should not have changed, because the size of the space should be the same)
@@ -529,6 +533,25 @@ Metachunk* ChunkManager::chunk_freelist_allocate(size_t word_size) {
   return chunk;
 }
 
+// The memory stays committed and reads as zeros when the chunk is used again,
+// which is fine since metaspace allocations are zeroed anyway.  Only the pages
+// holding the chunk header are kept; for humongous chunks the header includes
+// the dictionary tree node.
+void ChunkManager::release_chunk_pages(Metachunk* chunk) {
+  assert_lock_strong(MetaspaceExpand_lock);
+  if (!MetaspaceReleaseFreeChunkPages || (UseLargePages && UseLargePagesInMetaspace)) {
+    return;
+  }
+  const size_t page_size = os::vm_page_size();
+  char* const start = align_up((char*)chunk + sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >), page_size);
+  char* const end = align_down((char*)chunk + chunk->word_size() * BytesPerWord, page_size);
+  if (start < end) {
+    os::free_memory(start, end - start, page_size);
+    log_trace(gc, metaspace, freelist)("released " SIZE_FORMAT " bytes of free chunk at " PTR_FORMAT ".",
+        (size_t)(end - start), p2i(chunk));
+  }
+}
+
 void ChunkManager::return_single_chunk(Metachunk* chunk) {
 
 #ifdef ASSERT
@@ -573,6 +596,10 @@ void ChunkManager::return_single_chunk(Metachunk* chunk) {
   chunk->container()->dec_container_count();
   do_update_in_use_info_for_chunk(chunk, false);
 
+  if (index == MediumIndex || index == HumongousIndex) {
+    release_chunk_pages(chunk);
+  }
+
   // Chunk has been added; update counters.
   account_for_added_chunk(chunk);
 
@@ -79,6 +79,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // free chunks to form a bigger chunk. Returns true if successful.
   bool attempt_to_coalesce_around_chunk(Metachunk* chunk, ChunkIndex target_chunk_type);
 
+  // Give the pages of a free chunk's payload back to the operating system.
+  void release_chunk_pages(Metachunk* chunk);
+
   // Helper for chunk merging:
   //  Given an address range with 1-n chunks which are all supposed to be
   //  free and hence currently managed by this ChunkManager, remove them
@@ -175,6 +175,11 @@ void DumpRegion::pack(DumpRegion* next) {
 DumpRegion _mc_region("mc"), _ro_region("ro"), _rw_region("rw"), _md_region("md");
 size_t _total_closed_archive_region_size = 0, _total_open_archive_region_size = 0;
 
+// Locations of the pointers written into the mc, rw, ro and md regions, one bit
+// per word starting at SharedBaseAddress. It is stored in the archive so that the
+// regions can be mapped at a different address at run time.
+static CHeapBitMap _ptrmap(mtClassShared);
+
 void MetaspaceShared::init_shared_dump_space(DumpRegion* first_space, address first_space_bottom) {
   // Start with 0 committed bytes. The memory will be committed as needed by
   // MetaspaceShared::commit_shared_space_to().
@@ -209,6 +214,62 @@ char* MetaspaceShared::read_only_space_alloc(size_t num_bytes) {
   return _ro_region.allocate(num_bytes);
 }
 
+void MetaspaceShared::mark_pointer(address* ptr_loc) {
+  if (!DumpSharedSpaces || _ptrmap.size() == 0) {
+    return;
+  }
+  address base = (address)_shared_rs.base();
+  if ((address)ptr_loc < base || (address)ptr_loc >= (address)_shared_rs.end()) {
+    return; // not a location inside the archive
+  }
+  assert(is_aligned(ptr_loc, sizeof(address)), "pointers in the archive must be aligned");
+  size_t idx = pointer_delta(ptr_loc, base, sizeof(address));
+  if (idx >= _ptrmap.size()) {
+    _ptrmap.resize(MAX2(idx + 1, _ptrmap.size() * 2));
+  }
+  _ptrmap.set_bit(idx);
+}
+
+// Every word of the rw, ro and md regions that holds an address inside the
+// core spaces must have been recorded by MetaspaceShared::mark_pointer(). The
+// mc region is not checked because its trampolines are regenerated at run time.
+// If a pointer was missed, the archive is written without a pointer bitmap and
+// can only be mapped at the dump time address.
+static bool finalize_ptrmap(size_t core_spaces_size) {
+  address base = (address)_mc_region.base();
+  address end = base + core_spaces_size;
+  _ptrmap.resize(core_spaces_size / sizeof(address));
+
+  DumpRegion* regions[] = {&_rw_region, &_ro_region, &_md_region};
+  size_t num_pointers = 0;
+  size_t num_unrecorded = 0;
+  for (size_t i = 0; i < sizeof(regions)/sizeof(regions[0]); i++) {
+    address* top = (address*)regions[i]->top();
+    for (address* p = (address*)regions[i]->base(); p < top; p++) {
+      if (*p < base || *p > end) {
+        continue;
+      }
+      if (_ptrmap.at(pointer_delta(p, base, sizeof(address)))) {
+        num_pointers++;
+      } else {
+        if (num_unrecorded < 10) {
+          log_info(cds)("Unrecorded pointer " PTR_FORMAT " at " PTR_FORMAT " in %s region",
+                        p2i(*p), p2i(p), regions[i]->name());
+        }
+        num_unrecorded++;
+      }
+    }
+  }
+
+  if (num_unrecorded > 0) {
+    log_info(cds)("Archive is not relocatable: " SIZE_FORMAT " pointers were not recorded",
+                  num_unrecorded);
+    return false;
+  }
+  log_info(cds)("Recorded " SIZE_FORMAT " pointers in the archive", num_pointers);
+  return true;
+}
+
 void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
   assert(UseSharedSpaces, "Must be called when UseSharedSpaces is enabled");
 
@@ -251,7 +312,10 @@ char* MetaspaceShared::initialize_dynamic_runtime_shared_spaces(
         char* static_start, char* static_end) {
   assert(UseSharedSpaces, "must be runtime");
   char* cds_end = static_end;
-  if (!DynamicDumpSharedSpaces) {
+  if (FileMapInfo::current_info()->relocation_delta() != 0) {
+    // The dynamic archive refers to the base archive by its dump time addresses.
+    log_info(cds)("Dynamic archive is not used because the base archive has been relocated.");
+  } else if (!DynamicDumpSharedSpaces) {
     address dynamic_top = DynamicArchive::map();
     if (dynamic_top != NULL) {
       assert(dynamic_top > (address)static_start, "Unexpected layout");
@@ -706,6 +770,7 @@ public:
   static void patch(Metadata* obj) {
     assert(DumpSharedSpaces, "dump-time only");
     *(void**)obj = (void*)(_info->cloned_vtable());
+    MetaspaceShared::mark_pointer((address*)obj);
   }
 
   static bool is_valid_shared_object(const T* obj) {
@@ -909,6 +974,9 @@ void MetaspaceShared::allocate_cpp_vtable_clones() {
   //   ...
   // The order of the vtables is the same as the CPP_VTAB_PATCH_TYPES_DO macro.
   CPP_VTABLE_PATCH_TYPES_DO(ALLOC_CPP_VTABLE_CLONE);
+  for (int i = 0; i < _num_cloned_vtable_kinds; i++) {
+    mark_pointer((address*)&_cloned_cpp_vtptrs[i]);
+  }
 }
 
 // Switch the vtable pointer to point to the cloned vtable. We assume the
@@ -949,6 +1017,12 @@ bool MetaspaceShared::is_valid_shared_method(const Method* m) {
   return CppVtableCloner<Method>::is_valid_shared_object(m);
 }
 
+void WriteClosure::do_ptr(void** p) {
+  address* slot = (address*)_dump_region->top();
+  _dump_region->append_intptr_t((intptr_t)*p);
+  MetaspaceShared::mark_pointer(slot);
+}
+
 void WriteClosure::do_oop(oop* o) {
   if (*o == NULL) {
     _dump_region->append_intptr_t(0);
@@ -965,7 +1039,8 @@ void WriteClosure::do_region(u_char* start, size_t size) {
   assert(size % sizeof(intptr_t) == 0, "bad size");
   do_tag((int)size);
   while (size > 0) {
-    _dump_region->append_intptr_t(*(intptr_t*)start);
+    // The serialized regions are arrays of Symbol*.
+    do_ptr((void**)start);
     start += sizeof(intptr_t);
     size -= sizeof(intptr_t);
   }
@@ -1267,6 +1342,19 @@ private:
     }
   };
 
+  // The method entries and the adapter trampoline are not MetaspaceObj
+  // references, but they point into the mc region and must be found in
+  // the pointer bitmap when the archive is relocated.
+  static void mark_entry_pointers(MetaspaceObj::Type msotype, address new_loc) {
+    if (msotype == MetaspaceObj::MethodType) {
+      MetaspaceShared::mark_pointer((address*)(new_loc + in_bytes(Method::interpreter_entry_offset())));
+      MetaspaceShared::mark_pointer((address*)(new_loc + in_bytes(Method::from_interpreted_offset())));
+      MetaspaceShared::mark_pointer((address*)(new_loc + in_bytes(Method::from_compiled_offset())));
+    } else if (msotype == MetaspaceObj::ConstMethodType) {
+      MetaspaceShared::mark_pointer((address*)((ConstMethod*)new_loc)->adapter_trampoline_addr());
+    }
+  }
+
   // Relocate embedded pointers within a MetaspaceObj's shallow copy
   class ShallowCopyEmbeddedRefRelocator: public UniqueMetaspaceClosure {
   public:
@@ -1274,6 +1362,7 @@ private:
       address new_loc = get_new_loc(ref);
       RefRelocator refer;
       ref->metaspace_pointers_do_at(&refer, new_loc);
+      mark_entry_pointers(ref->msotype(), new_loc);
       return true; // recurse into ref.obj()
     }
   };
@@ -1284,6 +1373,7 @@ private:
     virtual bool do_ref(Ref* ref, bool read_only) {
       if (ref->not_null()) {
         ref->update(get_new_loc(ref));
+        MetaspaceShared::mark_pointer(ref->addr());
       }
       return false; // Do not recurse.
     }
@@ -1501,6 +1591,9 @@ void VM_PopulateDumpSharedSpace::doit() {
   remove_unshareable_in_classes();
   tty->print_cr("done. ");
 
+  // The bitmap grows as pointers are recorded by MetaspaceShared::mark_pointer().
+  _ptrmap.initialize(16 * M / sizeof(address));
+
   ArchiveCompactor::initialize();
   ArchiveCompactor::copy_and_compact();
 
@@ -1534,6 +1627,10 @@ void VM_PopulateDumpSharedSpace::doit() {
   // We don't want to write these addresses into the archive.
   MetaspaceShared::zero_cpp_vtable_clones_for_writing();
 
+  // Patching the vtable pointers is the last step that writes pointers
+  // into the archive.
+  bool relocatable = finalize_ptrmap(core_spaces_size);
+
   // Create and write the archive file that maps the shared spaces.
 
   FileMapInfo* mapinfo = new FileMapInfo(true);
@@ -1562,6 +1659,7 @@ void VM_PopulateDumpSharedSpace::doit() {
                                         _open_archive_heap_oopmaps,
                                         MetaspaceShared::first_open_archive_heap_region,
                                         MetaspaceShared::max_open_archive_heap_region);
+  mapinfo->write_ptrmap(relocatable ? &_ptrmap : NULL);
 
   mapinfo->set_header_crc(mapinfo->compute_header_crc());
   mapinfo->write_header();
@@ -1994,6 +2092,7 @@ bool MetaspaceShared::map_shared_spaces(FileMapInfo* mapinfo) {
   char* top = mapinfo->map_regions(regions, saved_base, len );
 
   if (top != NULL &&
+      (mapinfo->relocation_delta() == 0 || mapinfo->relocate_pointers()) &&
       (image_alignment == (size_t)os::vm_allocation_granularity()) &&
       mapinfo->validate_shared_path_table()) {
     // Success -- set up MetaspaceObj::_shared_metaspace_{base,top} for
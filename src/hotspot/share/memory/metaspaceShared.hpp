@@ -70,6 +70,7 @@ public:
     *p = n;
   }
 
+  const char* name() const { return _name;    }
   char* base()      const { return _base;        }
   char* top()       const { return _top;         }
   char* end()       const { return _end;         }
@@ -116,18 +117,14 @@ public:
     _dump_region = r;
   }
 
-  void do_ptr(void** p) {
-    _dump_region->append_intptr_t((intptr_t)*p);
-  }
+  void do_ptr(void** p);
 
   void do_u4(u4* p) {
-    void* ptr = (void*)(uintx(*p));
-    do_ptr(&ptr);
+    _dump_region->append_intptr_t((intptr_t)(uintx(*p)));
   }
 
   void do_bool(bool *p) {
-    void* ptr = (void*)(uintx(*p));
-    do_ptr(&ptr);
+    _dump_region->append_intptr_t((intptr_t)(uintx(*p)));
   }
 
   void do_tag(int tag) {
@@ -242,6 +239,10 @@ class MetaspaceShared : AllStatic {
     return (u4)deltax;
   }
 
+  // Record the location of a pointer in the static archive that must be
+  // adjusted if the archive is mapped at a different address.
+  static void mark_pointer(address* ptr_loc) NOT_CDS_RETURN;
+
   static void set_archive_loading_failed() {
     _archive_loading_failed = true;
   }
@@ -34,6 +34,8 @@
 #include "code/codeBehaviours.hpp"
 #include "code/codeCache.hpp"
 #include "code/dependencies.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
+#include "gc/shared/allocationTrace.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/gcConfig.hpp"
@@ -967,6 +969,9 @@ bool universe_post_init() {
   MemoryService::add_metaspace_memory_pools();
 
   MemoryService::set_universe_heap(Universe::heap());
+
+  AllocationTraceRecorder::initialize();
+  AllocationSiteProfile::initialize();
 #if INCLUDE_CDS
   MetaspaceShared::post_initialize(CHECK_false);
 #endif
@@ -102,16 +102,22 @@ class arrayOopDesc : public oopDesc {
   // Tells whether index is within bounds.
   bool is_within_bounds(int index) const        { return 0 <= index && index < length(); }
 
+  // Returns the address of the length "field".  See length_offset_in_bytes().
+  static int* length_addr_impl(void* obj_ptr) {
+    char* ptr = static_cast<char*>(obj_ptr);
+    return reinterpret_cast<int*>(ptr + length_offset_in_bytes());
+  }
+
   // Accessors for instance variable which is not a C++ declared nonstatic
   // field.
   int length() const {
-    return *(int*)(((intptr_t)this) + length_offset_in_bytes());
+    return *length_addr_impl(const_cast<arrayOopDesc*>(this));
   }
   void set_length(int length) {
     set_length((HeapWord*)this, length);
   }
   static void set_length(HeapWord* mem, int length) {
-    *(int*)(((char*)mem) + length_offset_in_bytes()) = length;
+    *length_addr_impl(mem) = length;
   }
 
   // Should only be called with constants as argument
@@ -301,6 +301,9 @@ public:
     }
     _adapter_trampoline = trampoline;
   }
+  AdapterHandlerEntry*** adapter_trampoline_addr() {
+    return &_adapter_trampoline;
+  }
   void update_adapter_trampoline(AdapterHandlerEntry* adapter) {
     assert(is_shared(), "must be");
     *_adapter_trampoline = adapter;
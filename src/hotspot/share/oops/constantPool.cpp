@@ -403,6 +403,10 @@ void ConstantPool::remove_unshareable_info() {
       int resolved_klass_index = kslot.resolved_klass_index();
       int name_index = kslot.name_index();
       assert(tag_at(name_index).is_symbol(), "sanity");
+      if (ArchiveResolvedSuperClassEntries &&
+          is_resolved_super_or_self(resolved_klasses()->at(resolved_klass_index))) {
+        continue;
+      }
       resolved_klasses()->at_put(resolved_klass_index, NULL);
       tag_at_put(index, JVM_CONSTANT_UnresolvedClass);
       assert(klass_name_at(index) == symbol_at(name_index), "sanity");
@@ -413,6 +417,30 @@ void ConstantPool::remove_unshareable_info() {
   }
 }
 
+// Resolution of the pool holder itself, or of one of its super types, always
+// gives the same result once the holder is loaded (its super types are
+// resolved by the same loader when the holder is loaded), and these are
+// always archived together with the holder. Such entries can stay resolved
+// in the archive.
+bool ConstantPool::is_resolved_super_or_self(Klass* k) const {
+  if (k == NULL || !k->is_instance_klass()) {
+    return false;
+  }
+  InstanceKlass* holder = pool_holder();
+  for (InstanceKlass* super = holder; super != NULL; super = super->java_super()) {
+    if (super == k) {
+      return true;
+    }
+  }
+  Array<InstanceKlass*>* interfaces = holder->transitive_interfaces();
+  for (int i = 0; i < interfaces->length(); i++) {
+    if (interfaces->at(i) == k) {
+      return true;
+    }
+  }
+  return false;
+}
+
 int ConstantPool::cp_to_object_index(int cp_index) {
   // this is harder don't do this so much.
   int i = reference_map()->find(cp_index);
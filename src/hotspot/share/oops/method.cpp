@@ -29,6 +29,7 @@
 #include "code/codeCache.hpp"
 #include "code/debugInfoRec.hpp"
 #include "compiler/compilationPolicy.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/bytecodeTracer.hpp"
@@ -60,6 +61,7 @@
 #include "runtime/init.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/relocator.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
@@ -116,6 +118,7 @@ Method::Method(ConstMethod* xconst, AccessFlags access_flags) {
 // Release Method*.  The nmethod will be gone when we get here because
 // we've walked the code cache.
 void Method::deallocate_contents(ClassLoaderData* loader_data) {
+  AllocationSiteProfile::method_unloaded(this);
   MetadataFactory::free_metadata(loader_data, constMethod());
   set_constMethod(NULL);
   MetadataFactory::free_metadata(loader_data, method_data());
@@ -256,9 +259,10 @@ int Method::fast_exception_handler_bci_for(const methodHandle& mh, Klass* ex_kla
 
 void Method::mask_for(int bci, InterpreterOopMap* mask) {
   methodHandle h_this(Thread::current(), this);
-  // Only GC uses the OopMapCache during thread stack root scanning
-  // any other uses generate an oopmap but do not save it in the cache.
-  if (Universe::heap()->is_gc_active()) {
+  // The OopMapCache is only used at safepoints (GC thread stack root scanning,
+  // deoptimization and other VM operations walking interpreted frames); any
+  // other uses generate an oopmap but do not save it in the cache.
+  if (SafepointSynchronize::is_at_safepoint()) {
     method_holder()->mask_for(h_this, bci, mask);
   } else {
     OopMapCache::compute_one_oop_map(h_this, bci, mask);
@@ -438,26 +442,31 @@ void Method::build_interpreter_method_data(const methodHandle& method, TRAPS) {
     return;
   }
 
-  // Grab a lock here to prevent multiple
-  // MethodData*s from being created.
-  MutexLocker ml(MethodData_lock, THREAD);
-  if (method->method_data() == NULL) {
-    ClassLoaderData* loader_data = method->method_holder()->class_loader_data();
-    MethodData* method_data = MethodData::allocate(loader_data, method, THREAD);
-    if (HAS_PENDING_EXCEPTION) {
-      CompileBroker::log_metaspace_failure();
-      ClassLoaderDataGraph::set_metaspace_oom(true);
-      return;   // return the exception (which is cleared)
-    }
+  if (method->method_data() != NULL) {
+    return;
+  }
 
-    method->set_method_data(method_data);
-    if (PrintMethodData && (Verbose || WizardMode)) {
-      ResourceMark rm(THREAD);
-      tty->print("build_interpreter_method_data for ");
-      method->print_name(tty);
-      tty->cr();
-      // At the end of the run, the MDO, full of data, will be dumped.
-    }
+  // Many methods can become warm at the same time, so don't serialize the
+  // allocations on a lock. Threads racing on the same method each build a
+  // MethodData*, only one gets installed and the others are freed.
+  ClassLoaderData* loader_data = method->method_holder()->class_loader_data();
+  MethodData* method_data = MethodData::allocate(loader_data, method, THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    CompileBroker::log_metaspace_failure();
+    ClassLoaderDataGraph::set_metaspace_oom(true);
+    return;   // return the exception (which is cleared)
+  }
+
+  if (!method->init_method_data(method_data)) {
+    MetadataFactory::free_metadata(loader_data, method_data);
+    return;
+  }
+  if (PrintMethodData && (Verbose || WizardMode)) {
+    ResourceMark rm(THREAD);
+    tty->print("build_interpreter_method_data for ");
+    method->print_name(tty);
+    tty->cr();
+    // At the end of the run, the MDO, full of data, will be dumped.
   }
 }
 
@@ -485,6 +494,13 @@ MethodCounters* Method::build_method_counters(Method* m, TRAPS) {
   return mh->method_counters();
 }
 
+bool Method::init_method_data(MethodData* data) {
+  // Try to install a pointer to MethodData, return true on success.
+  // The cmpxchg is a full fence, so the initialization of data is visible
+  // before the pointer is.
+  return Atomic::replace_if_null(data, &_method_data);
+}
+
 bool Method::init_method_counters(MethodCounters* counters) {
   // Try to install a pointer to MethodCounters, return true on success.
   return Atomic::replace_if_null(counters, &_method_counters);
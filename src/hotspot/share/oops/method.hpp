@@ -362,6 +362,7 @@ class Method : public Metadata {
   }
 
   bool init_method_counters(MethodCounters* counters);
+  bool init_method_data(MethodData* data);
 
 #ifdef TIERED
   // We are reusing interpreter_invocation_count as a holder for the previous event count!
@@ -29,6 +29,7 @@
 #include "opto/cfgnode.hpp"
 #include "opto/connode.hpp"
 #include "opto/machnode.hpp"
+#include "opto/memnode.hpp"
 #include "opto/mulnode.hpp"
 #include "opto/phaseX.hpp"
 #include "opto/subnode.hpp"
@@ -742,6 +743,18 @@ Node* OrINode::Identity(PhaseGVN* phase) {
   return AddNode::Identity(phase);
 }
 
+//------------------------------Ideal------------------------------------------
+Node *OrINode::Ideal(PhaseGVN *phase, bool can_reshape) {
+  // (LoadUB(p) | (LoadUB(p+1) << 8)) => LoadUS(p), and so on
+  if (MergeLoads && can_reshape) {
+    Node* wide = LoadNode::combine_or_of_loads(phase, this);
+    if (wide != NULL) {
+      return wide;
+    }
+  }
+  return AddNode::Ideal(phase, can_reshape);
+}
+
 //------------------------------add_ring---------------------------------------
 // Supplied function returns the sum of the inputs IN THE CURRENT RING.  For
 // the logical operations the ring's ADD is really a logical OR function.
@@ -1608,6 +1608,12 @@ void PhaseBlockLayout::merge_traces(bool fall_thru_only) {
     } else if (e->state() == CFGEdge::open) {
       // Append traces, even without a fall-thru connection.
       // But leave root entry at the beginning of the block list.
+      // Don't drag a cold trace in behind a frequent one: left on its
+      // own it is placed at the end by reorder_traces().
+      if (BlockLayoutColdTracesLast &&
+          is_cold(targ_trace) && !is_cold(src_trace)) {
+        continue;
+      }
       if (targ_trace != trace(_cfg.get_root_block())) {
         e->set_state(CFGEdge::connected);
         src_trace->append(targ_trace);
@@ -1640,6 +1646,31 @@ void PhaseBlockLayout::reorder_traces(int count) {
   // Sort the new trace list by frequency
   qsort(new_traces + 1, new_count - 1, sizeof(new_traces[0]), trace_frequency_order);
 
+  // Move cold traces behind all others, keeping their relative order, so
+  // that the frequently executed code of the method is contiguous.  The
+  // connector trace stays last.
+  if (BlockLayoutColdTracesLast) {
+    Trace** cold_traces = NEW_ARENA_ARRAY(area, Trace *, new_count);
+    int hot_count = 1;
+    int cold_count = 0;
+    int end = new_count;
+    if (new_count > 1 && new_traces[new_count - 1]->first_block()->is_connector()) {
+      end--;
+    }
+    for (int i = 1; i < end; i++) {
+      Trace* tr = new_traces[i];
+      if (is_cold(tr)) {
+        cold_traces[cold_count++] = tr;
+      } else {
+        new_traces[hot_count++] = tr;
+      }
+    }
+    for (int i = 0; i < cold_count; i++) {
+      new_traces[hot_count++] = cold_traces[i];
+    }
+    assert(hot_count == end, "lost a trace");
+  }
+
   // Patch up the successor blocks
   _cfg.clear_blocks();
   for (int i = 0; i < new_count; i++) {
@@ -877,6 +877,12 @@ class PhaseBlockLayout : public Phase {
   Trace * trace(Block *b) {
     return traces[uf->Find_compress(b->_pre_order)];
   }
+
+  // A trace is cold if it is entered through an uncommon block.
+  bool is_cold(Trace* tr) {
+    Block* b = tr->first_block();
+    return !b->is_connector() && _cfg.is_uncommon(b);
+  }
  public:
   PhaseBlockLayout(PhaseCFG &cfg);
 
@@ -238,9 +238,23 @@
   develop(bool, TraceOptimizeFill, false,                                   \
           "print detailed information about fill conversion")               \
                                                                             \
+  product(bool, MergeStores, true,                                          \
+          "Merge adjacent narrow stores of constants or of the pieces of "  \
+          "one value into a single wider store")                            \
+                                                                            \
+  product(bool, MergeLoads, true,                                           \
+          "Combine adjacent narrow loads that are shifted and or-ed "       \
+          "together into a single wider load")                              \
+                                                                            \
   develop(bool, OptoCoalesce, true,                                         \
           "Use Conservative Copy Coalescing in the Register Allocator")     \
                                                                             \
+  product(intx, OptoCoalesceNodeLimit, 40000,                               \
+          "Skip conservative coalescing of spill copies in the register "   \
+          "allocator for methods with more live nodes than this, "          \
+          "trading some copies for compile time. 0 means no limit")         \
+          range(0, max_jint)                                                \
+                                                                            \
   develop(bool, UseUniqueSubclasses, true,                                  \
           "Narrow an abstract reference to the unique concrete subclass")   \
                                                                             \
@@ -393,6 +407,15 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, true,                               \
+          "Profiling based inlining for more than two receivers, "          \
+          "limited by TypeProfileWidth")                                    \
+                                                                            \
+  product(intx, PolymorphicInlineLimit, 4,                                  \
+          "Maximum number of profiled receivers inlined behind type "       \
+          "guards at a polymorphic call site")                              \
+          range(2, 8)                                                       \
+                                                                            \
   product(bool, InsertMemBarAfterArraycopy, true,                           \
           "Insert memory barrier after arraycopy call")                     \
                                                                             \
@@ -413,6 +436,13 @@
           "Set level of loop optimization for tier 1 compiles")             \
           range(5, 43)                                                      \
                                                                             \
+  product(intx, C2OptimizeTimeBudget, 0,                                    \
+          "Soft limit, in milliseconds, on the time spent compiling one "   \
+          "method. Once it is exceeded, remaining incremental inlining "    \
+          "and additional loop optimization rounds are skipped. "           \
+          "0 means no limit")                                               \
+          range(0, max_jint)                                                \
+                                                                            \
   /* controls for heat-based inlining */                                    \
                                                                             \
   develop(intx, NodeCountInliningCutoff, 18000,                             \
@@ -580,6 +610,11 @@
   product(bool, BlockLayoutRotateLoops, true,                               \
           "Allow back branches to be fall throughs in the block layout")    \
                                                                             \
+  product(bool, BlockLayoutColdTracesLast, true,                            \
+          "Keep traces that start in an uncommon block (uncommon traps, "   \
+          "exception and slow paths) out of frequent traces and place "     \
+          "them after all other code in the block layout")                  \
+                                                                            \
   diagnostic(bool, InlineReflectionGetCallerClass, true,                    \
           "inline sun.reflect.Reflection.getCallerClass(), known to be "    \
           "part of base library DLL")                                       \
@@ -691,6 +726,10 @@
   product(bool, IncrementalInline, true,                                    \
           "do post parse inlining")                                         \
                                                                             \
+  product(bool, IncrementalInlineHotFirst, true,                            \
+          "Order pending late inlines by call site profile count so the "   \
+          "live node budget is spent on the hottest call sites first")      \
+                                                                            \
   develop(bool, AlwaysIncrementalInline, false,                             \
           "do all inlining incrementally")                                  \
                                                                             \
@@ -468,6 +468,12 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_floor:
     if (!Matcher::match_rule_supported(Op_RoundDoubleMode)) return false;
     break;
+  case vmIntrinsics::_indexOfL_char:
+    // Only x86 has a Latin1 rule for StrIndexOfChar; the other platforms'
+    // rules scan UTF16 chars.
+    NOT_X86(return false;)
+    if (!Matcher::match_rule_supported(Op_StrIndexOfChar)) return false;
+    break;
   case vmIntrinsics::_hashCode:
   case vmIntrinsics::_identityHashCode:
   case vmIntrinsics::_getClass:
@@ -630,6 +636,7 @@ bool C2Compiler::is_intrinsic_supported(const methodHandle& method, bool is_virt
   case vmIntrinsics::_montgomeryMultiply:
   case vmIntrinsics::_montgomerySquare:
   case vmIntrinsics::_vectorizedMismatch:
+  case vmIntrinsics::_vectorizedHashCode:
   case vmIntrinsics::_ghash_processBlocks:
   case vmIntrinsics::_base64_encodeBlock:
   case vmIntrinsics::_updateCRC32:
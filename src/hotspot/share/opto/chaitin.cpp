@@ -348,6 +348,16 @@ void PhaseChaitin::Register_Allocate() {
   _alternate = 0;
   _matcher._allocation_started = true;
 
+  // Conservative coalescing after each split round is one of the most
+  // expensive parts of allocation for huge methods: it reruns over the
+  // whole IFG every round.  Skip it for those; the remaining copies are
+  // partly cleaned up by post_allocate_copy_removal().
+  _conservative_coalesce = OptoCoalesce &&
+    (OptoCoalesceNodeLimit == 0 || C->live_nodes() <= (uint)OptoCoalesceNodeLimit);
+  if (!_conservative_coalesce && OptoCoalesce && C->log() != NULL) {
+    C->log()->elem("regalloc_skip_coalesce live_nodes='%d'", C->live_nodes());
+  }
+
   ResourceArea split_arena(mtCompiler);     // Arena for Split local resources
   ResourceArea live_arena(mtCompiler);      // Arena for liveness & IFG info
   ResourceMark rm(&live_arena);
@@ -486,7 +496,7 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->SquareUp();
     _ifg->Compute_Effective_Degree();
     // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    if (_conservative_coalesce) {
       Compile::TracePhase tp("chaitinCoalesce2", &timers[_t_chaitinCoalesce2]);
       // Conservative (and pessimistic) copy coalescing of those spills
       PhaseConservativeCoalesce coalesce(*this);
@@ -560,7 +570,7 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->Compute_Effective_Degree();
 
     // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    if (_conservative_coalesce) {
       Compile::TracePhase tp("chaitinCoalesce3", &timers[_t_chaitinCoalesce3]);
       // Conservative (and pessimistic) copy coalescing
       PhaseConservativeCoalesce coalesce(*this);
@@ -393,6 +393,7 @@ class PhaseChaitin : public PhaseRegAlloc {
 
   int _trip_cnt;
   int _alternate;
+  bool _conservative_coalesce;  // Coalesce spill copies; see OptoCoalesceNodeLimit
 
   PhaseLive *_live;             // Liveness, used in the interference graph
   PhaseIFG *_ifg;               // Interference graph (for original chunk)
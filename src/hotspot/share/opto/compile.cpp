@@ -35,6 +35,8 @@
 #include "compiler/oopMap.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/c2/barrierSetC2.hpp"
+#include "logging/log.hpp"
+#include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
 #include "opto/addnode.hpp"
 #include "opto/block.hpp"
@@ -1128,6 +1130,8 @@ void Compile::Init(int aliaslevel) {
 
   set_do_freq_based_layout(_directive->BlockLayoutByFrequencyOption);
   _loop_opts_cnt = LoopOptsCount;
+  _start_time_ns = os::javaTimeNanos();
+  _over_time_budget = false;
   set_do_inlining(Inline);
   set_max_inline_size(MaxInlineSize);
   set_freq_inline_size(FreqInlineSize);
@@ -2105,6 +2109,44 @@ void Compile::inline_incrementally_cleanup(PhaseIterGVN& igvn) {
   }
 }
 
+// Profiled invocation count of the call site of a pending late inline,
+// -1 if unknown.
+static int late_inline_count(CallGenerator* cg) {
+  CallStaticJavaNode* call = cg->call_node();
+  if (call == NULL || call->jvms() == NULL) {
+    return -1;
+  }
+  JVMState* jvms = call->jvms();
+  ciCallProfile profile = jvms->method()->call_profile_at_bci(jvms->bci());
+  return profile.count();
+}
+
+// Stable sort of the pending late inlines, hottest call site first, so
+// that when LiveNodeCountInliningCutoff is reached the remaining budget
+// has been used for the call sites that matter most.
+void Compile::sort_late_inlines_by_count() {
+  int len = _late_inlines.length();
+  if (len < 2) {
+    return;
+  }
+  int* counts = NEW_RESOURCE_ARRAY(int, len);
+  for (int i = 0; i < len; i++) {
+    counts[i] = late_inline_count(_late_inlines.at(i));
+  }
+  for (int i = 1; i < len; i++) {
+    CallGenerator* cg = _late_inlines.at(i);
+    int count = counts[i];
+    int j = i - 1;
+    while (j >= 0 && counts[j] < count) {
+      _late_inlines.at_put(j + 1, _late_inlines.at(j));
+      counts[j + 1] = counts[j];
+      j--;
+    }
+    _late_inlines.at_put(j + 1, cg);
+    counts[j + 1] = count;
+  }
+}
+
 // Perform incremental inlining until bound on number of live nodes is reached
 void Compile::inline_incrementally(PhaseIterGVN& igvn) {
   TracePhase tp("incrementalInline", &timers[_t_incrInline]);
@@ -2130,9 +2172,17 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
       }
     }
 
+    if (over_time_budget("incremental inlining")) {
+      break; // finish
+    }
+
     for_igvn()->clear();
     initial_gvn()->replace_with(&igvn);
 
+    if (IncrementalInlineHotFirst) {
+      sort_late_inlines_by_count();
+    }
+
     while (inline_incrementally_one()) {
       assert(!failing(), "inconsistent");
     }
@@ -2161,10 +2211,32 @@ void Compile::inline_incrementally(PhaseIterGVN& igvn) {
 }
 
 
+bool Compile::over_time_budget(const char* phase) {
+  if (C2OptimizeTimeBudget == 0) {
+    return false;
+  }
+  if (!_over_time_budget) {
+    jlong elapsed_ms = (os::javaTimeNanos() - _start_time_ns) / NANOSECS_PER_MILLISEC;
+    if (elapsed_ms <= C2OptimizeTimeBudget) {
+      return false;
+    }
+    _over_time_budget = true;
+    if (log() != NULL) {
+      log()->elem("time_budget_exceeded phase='%s' elapsed_ms='" JLONG_FORMAT "'", phase, elapsed_ms);
+    }
+#ifndef PRODUCT
+    if (PrintOpto || TraceLoopOpts) {
+      tty->print_cr("C2OptimizeTimeBudget exceeded after " JLONG_FORMAT " ms, skipping %s", elapsed_ms, phase);
+    }
+#endif
+  }
+  return true;
+}
+
 bool Compile::optimize_loops(PhaseIterGVN& igvn, LoopOptsMode mode) {
   if(_loop_opts_cnt > 0) {
     debug_only( int cnt = 0; );
-    while(major_progress() && (_loop_opts_cnt > 0)) {
+    while(major_progress() && (_loop_opts_cnt > 0) && !over_time_budget("loop opts")) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       assert( cnt++ < 40, "infinite cycle in loop optimization" );
       PhaseIdealLoop::optimize(igvn, mode);
@@ -2329,7 +2401,7 @@ void Compile::Optimize() {
       if (failing())  return;
     }
     // Loop opts pass if partial peeling occurred in previous pass
-    if(PartialPeelLoop && major_progress() && (_loop_opts_cnt > 0)) {
+    if(PartialPeelLoop && major_progress() && (_loop_opts_cnt > 0) && !over_time_budget("loop opts")) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, LoopOptsSkipSplitIf);
       _loop_opts_cnt--;
@@ -2337,7 +2409,7 @@ void Compile::Optimize() {
       if (failing())  return;
     }
     // Loop opts pass for loop-unrolling before CCP
-    if(major_progress() && (_loop_opts_cnt > 0)) {
+    if(major_progress() && (_loop_opts_cnt > 0) && !over_time_budget("loop opts")) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, LoopOptsSkipSplitIf);
       _loop_opts_cnt--;
@@ -3933,7 +4005,8 @@ void Compile::record_failure(const char* reason) {
 
 Compile::TracePhase::TracePhase(const char* name, elapsedTimer* accumulator)
   : TraceTime(name, accumulator, CITime, CITimeVerbose),
-    _phase_name(name), _dolog(CITimeVerbose)
+    _phase_name(name), _dolog(CITimeVerbose),
+    _hardware_counters(HardwareCounters::should_measure(log_is_enabled(Debug, jit, perf)))
 {
   if (_dolog) {
     C = Compile::current();
@@ -3972,6 +4045,27 @@ Compile::TracePhase::~TracePhase() {
   if (_log != NULL) {
     _log->done("phase name='%s' nodes='%d' live='%d'", _phase_name, C->unique(), C->live_nodes());
   }
+
+  if (_hardware_counters.is_active()) {
+    report_hardware_counters();
+  }
+}
+
+// Phases nest, so the counts of an enclosing phase include those of the
+// phases it contains.
+void Compile::TracePhase::report_hardware_counters() {
+  HardwareCounterValues values;
+  if (!_hardware_counters.elapsed(&values)) {
+    return;
+  }
+  LogTarget(Debug, jit, perf) lt;
+  if (lt.is_enabled()) {
+    LogStream ls(lt);
+    ls.print("C2 %s (compile id %d): ", _phase_name, C->compile_id());
+    HardwareCounters::print_on(&ls, values);
+    ls.cr();
+  }
+  _hardware_counters.send_event(_phase_name, values);
 }
 
 //=============================================================================
@@ -41,6 +41,7 @@
 #include "opto/phase.hpp"
 #include "opto/regmask.hpp"
 #include "runtime/deoptimization.hpp"
+#include "runtime/hardwareCounters.hpp"
 #include "runtime/timerTrace.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/ticks.hpp"
@@ -182,6 +183,9 @@ class Compile : public Phase {
     CompileLog* _log;
     const char* _phase_name;
     bool _dolog;
+    HardwareCounterScope _hardware_counters;
+
+    void report_hardware_counters();
    public:
     TracePhase(const char* name, elapsedTimer* accumulator);
     ~TracePhase();
@@ -415,6 +419,8 @@ class Compile : public Phase {
   bool                  _has_method_handle_invokes; // True if this method has MethodHandle invokes.
   RTMState              _rtm_state;             // State of Restricted Transactional Memory usage
   int                   _loop_opts_cnt;         // loop opts round
+  jlong                 _start_time_ns;         // When this compilation started, for C2OptimizeTimeBudget
+  bool                  _over_time_budget;      // C2OptimizeTimeBudget has been exceeded
   bool                  _clinit_barrier_on_entry; // True if clinit barrier is needed on nmethod entry
 
   // Compilation environment.
@@ -1109,11 +1115,15 @@ class Compile : public Phase {
   bool has_mh_late_inlines() const     { return _number_of_mh_late_inlines > 0; }
 
   bool inline_incrementally_one();
+  void sort_late_inlines_by_count();
   void inline_incrementally_cleanup(PhaseIterGVN& igvn);
   void inline_incrementally(PhaseIterGVN& igvn);
   void inline_string_calls(bool parse_time);
   void inline_boxing_calls(PhaseIterGVN& igvn);
   bool optimize_loops(PhaseIterGVN& igvn, LoopOptsMode mode);
+  // True once the compilation has run longer than C2OptimizeTimeBudget;
+  // callers use it to skip optional optimization work.
+  bool over_time_budget(const char* phase);
   void remove_root_to_sfpts_edges(PhaseIterGVN& igvn);
 
   // Matching, CFG layout, allocation, code generation
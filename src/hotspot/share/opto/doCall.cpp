@@ -291,6 +291,58 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           }
         }
       }
+
+      // A polymorphic site without a major receiver: inline the most
+      // frequent receivers, each behind its own type guard, and leave
+      // the rest to a virtual call.
+      if (receiver_method == NULL && speculative_receiver_type == NULL &&
+          UsePolymorphicInlining && profile.has_receiver(2)) {
+        const int max_receivers = 8;
+        CallGenerator* hit_cgs[max_receivers];
+        ciMethod* receiver_methods[max_receivers];
+        int limit = MIN2((int)PolymorphicInlineLimit, max_receivers);
+        int n = 0;
+        while (n < limit && profile.has_receiver(n)) {
+          ciMethod* m = callee->resolve_invoke(jvms->method()->holder(), profile.receiver(n));
+          if (m == NULL) {
+            break;
+          }
+          CallGenerator* cg = this->call_generator(m, vtable_index, !call_does_dispatch, jvms,
+                                                   allow_inline, prof_factor);
+          if (cg == NULL || !cg->is_inline()) {
+            break; // a type guard in front of an out-of-line call buys nothing
+          }
+          receiver_methods[n] = m;
+          hit_cgs[n++] = cg;
+        }
+        if (n > 2) {
+          CallGenerator* miss_cg;
+          if (profile.morphism() == n &&
+              !too_many_traps_or_recompiles(caller, bci, Deoptimization::Reason_bimorphic)) {
+            // Every receiver seen so far is covered.
+            miss_cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_bimorphic,
+                                                       Deoptimization::Action_maybe_recompile);
+          } else {
+            miss_cg = CallGenerator::for_virtual_call(callee, vtable_index);
+          }
+          // Build the guards from the least frequent receiver outwards. Each
+          // guard is only reached when the more frequent ones have failed.
+          int remaining = site_count;
+          for (int i = 0; i < n; i++) {
+            remaining -= profile.receiver_count(i);
+          }
+          remaining = MAX2(remaining, 0);
+          for (int i = n - 1; i >= 0 && miss_cg != NULL; i--) {
+            int rcount = profile.receiver_count(i);
+            remaining += rcount;
+            float hit_prob = MIN2(MAX2((float)rcount / (float)MAX2(remaining, 1), PROB_MIN), PROB_MAX);
+            trace_type_profile(C, jvms->method(), jvms->depth() - 1, jvms->bci(), receiver_methods[i],
+                               profile.receiver(i), site_count, rcount);
+            miss_cg = CallGenerator::for_predicted_call(profile.receiver(i), miss_cg, hit_cgs[i], hit_prob);
+          }
+          if (miss_cg != NULL)  return miss_cg;
+        }
+      }
     }
 
     // If there is only one implementor of this interface then we
@@ -129,8 +129,8 @@ class ConnectionGraph;
 
 // ConnectionGraph nodes
 class PointsToNode : public ResourceObj {
-  GrowableArray<PointsToNode*> _edges; // List of nodes this node points to
-  GrowableArray<PointsToNode*> _uses;  // List of nodes which point to this node
+  InlineGrowableArray<PointsToNode*, 2> _edges; // List of nodes this node points to
+  InlineGrowableArray<PointsToNode*, 2> _uses;  // List of nodes which point to this node
 
   const u1           _type;  // NodeType
   u1                _flags;  // NodeFlags
@@ -451,6 +451,11 @@ private:
   // Adjust scalar_replaceable state after Connection Graph is built.
   void adjust_scalar_replaceable_state(JavaObjectNode* jobj);
 
+  // Clear ptn's scalar_replaceable state. With PrintEliminateAllocations
+  // the reason is printed, since macro expansion only reports allocations
+  // that were still considered scalar replaceable.
+  void set_not_scalar_replaceable(PointsToNode* ptn NOT_PRODUCT(COMMA const char* reason)) const;
+
   // Optimize ideal graph.
   void optimize_ideal_graph(GrowableArray<Node*>& ptr_cmp_worklist,
                             GrowableArray<Node*>& storestore_worklist);
@@ -606,8 +611,8 @@ public:
 };
 
 inline PointsToNode::PointsToNode(ConnectionGraph *CG, Node* n, EscapeState es, NodeType type):
-  _edges(CG->_compile->comp_arena(), 2, 0, NULL),
-  _uses (CG->_compile->comp_arena(), 2, 0, NULL),
+  _edges(CG->_compile->comp_arena()),
+  _uses (CG->_compile->comp_arena()),
   _type((u1)type),
   _flags(ScalarReplaceable),
   _escape((u1)es),
@@ -218,7 +218,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_string_indexOfI(StrIntrinsicNode::ArgEnc ae);
   Node* make_indexOf_node(Node* src_start, Node* src_count, Node* tgt_start, Node* tgt_count,
                           RegionNode* region, Node* phi, StrIntrinsicNode::ArgEnc ae);
-  bool inline_string_indexOfChar();
+  bool inline_string_indexOfChar(StrIntrinsicNode::ArgEnc ae);
   bool inline_string_equals(StrIntrinsicNode::ArgEnc ae);
   bool inline_string_toBytesU();
   bool inline_string_getCharsU();
@@ -329,6 +329,7 @@ class LibraryCallKit : public GraphKit {
   bool inline_montgomeryMultiply();
   bool inline_montgomerySquare();
   bool inline_vectorizedMismatch();
+  bool inline_vectorizedHashCode();
   bool inline_fma(vmIntrinsics::ID id);
   bool inline_character_compare(vmIntrinsics::ID id);
   bool inline_fp_min_max(vmIntrinsics::ID id);
@@ -586,7 +587,8 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_indexOfIL:                return inline_string_indexOfI(StrIntrinsicNode::LL);
   case vmIntrinsics::_indexOfIU:                return inline_string_indexOfI(StrIntrinsicNode::UU);
   case vmIntrinsics::_indexOfIUL:               return inline_string_indexOfI(StrIntrinsicNode::UL);
-  case vmIntrinsics::_indexOfU_char:            return inline_string_indexOfChar();
+  case vmIntrinsics::_indexOfL_char:            return inline_string_indexOfChar(StrIntrinsicNode::L);
+  case vmIntrinsics::_indexOfU_char:            return inline_string_indexOfChar(StrIntrinsicNode::U);
 
   case vmIntrinsics::_equalsL:                  return inline_string_equals(StrIntrinsicNode::LL);
   case vmIntrinsics::_equalsU:                  return inline_string_equals(StrIntrinsicNode::UU);
@@ -849,6 +851,8 @@ bool LibraryCallKit::try_to_inline(int predicate) {
 
   case vmIntrinsics::_vectorizedMismatch:
     return inline_vectorizedMismatch();
+  case vmIntrinsics::_vectorizedHashCode:
+    return inline_vectorizedHashCode();
 
   case vmIntrinsics::_ghash_processBlocks:
     return inline_ghash_processBlocks();
@@ -1435,7 +1439,7 @@ Node* LibraryCallKit::make_indexOf_node(Node* src_start, Node* src_count, Node*
 }
 
 //-----------------------------inline_string_indexOfChar-----------------------
-bool LibraryCallKit::inline_string_indexOfChar() {
+bool LibraryCallKit::inline_string_indexOfChar(StrIntrinsicNode::ArgEnc ae) {
   if (too_many_traps(Deoptimization::Reason_intrinsic)) {
     return false;
   }
@@ -1451,12 +1455,12 @@ bool LibraryCallKit::inline_string_indexOfChar() {
   src = must_be_not_null(src, true);
   src = access_resolve(src, ACCESS_READ);
 
-  Node* src_offset = _gvn.transform(new LShiftINode(from_index, intcon(1)));
+  Node* src_offset = ae == StrIntrinsicNode::L ? from_index : _gvn.transform(new LShiftINode(from_index, intcon(1)));
   Node* src_start = array_element_address(src, src_offset, T_BYTE);
   Node* src_count = _gvn.transform(new SubINode(max, from_index));
 
   // Range checks
-  generate_string_range_check(src, src_offset, src_count, true);
+  generate_string_range_check(src, src_offset, src_count, ae == StrIntrinsicNode::U);
   if (stopped()) {
     return true;
   }
@@ -1464,7 +1468,7 @@ bool LibraryCallKit::inline_string_indexOfChar() {
   RegionNode* region = new RegionNode(3);
   Node* phi = new PhiNode(region, TypeInt::INT);
 
-  Node* result = new StrIndexOfCharNode(control(), memory(TypeAryPtr::BYTES), src_start, src_count, tgt, StrIntrinsicNode::none);
+  Node* result = new StrIndexOfCharNode(control(), memory(TypeAryPtr::BYTES), src_start, src_count, tgt, ae);
   C->set_has_split_ifs(true); // Has chance for split-if optimization
   _gvn.transform(result);
 
@@ -5488,6 +5492,65 @@ bool LibraryCallKit::inline_vectorizedMismatch() {
   return true;
 }
 
+//-------------inline_vectorizedHashCode------------------------------
+// int ArraysSupport.vectorizedHashCode(Object array, int fromIndex, int length,
+//                                      int initialValue, int basicType)
+// The caller has already range checked the array; basicType selects how the
+// elements are widened (T_BOOLEAN: unsigned byte, T_BYTE, T_CHAR, T_SHORT, T_INT)
+// and has to be a constant for the call to be intrinsified.
+bool LibraryCallKit::inline_vectorizedHashCode() {
+  assert(UseVectorizedHashCodeIntrinsic, "not implementated on this platform");
+
+  address stubAddr = StubRoutines::vectorizedHashCode();
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+  const char* stubName = "vectorizedHashCode";
+  assert(callee()->signature()->size() == 5, "vectorizedHashCode has 5 parameters");
+
+  Node* array        = argument(0);
+  Node* offset       = argument(1);
+  Node* length       = argument(2);
+  Node* initial      = argument(3);
+  Node* basic_type   = argument(4);
+
+  const TypeInt* bt_type = gvn().type(basic_type)->isa_int();
+  if (bt_type == NULL || !bt_type->is_con()) {
+    return false; // element type is not known at compile time
+  }
+  BasicType bt = (BasicType)bt_type->get_con();
+  BasicType elem_bt;
+  switch (bt) {
+  case T_BOOLEAN: elem_bt = T_BYTE; break; // Latin1 bytes, hashed unsigned
+  case T_BYTE:
+  case T_CHAR:
+  case T_SHORT:
+  case T_INT:     elem_bt = bt;     break;
+  default:
+    return false;
+  }
+
+  const TypeAryPtr* top = array->Value(&_gvn)->isa_aryptr();
+  if (top == NULL || top->klass() == NULL) {
+    // failed array check
+    return false;
+  }
+
+  jvms()->set_should_reexecute(true);
+
+  array = access_resolve(array, ACCESS_READ);
+  Node* array_start = array_element_address(array, offset, elem_bt);
+
+  Node* call = make_runtime_call(RC_LEAF,
+    OptoRuntime::vectorizedHashCode_Type(),
+    stubAddr, stubName, TypePtr::BOTTOM,
+    array_start, length, initial, intcon(bt));
+
+  Node* result = _gvn.transform(new ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 /**
  * Calculate CRC32 for byte.
  * int java.util.zip.CRC32.update(int crc, int b)
@@ -798,8 +798,13 @@ bool IdealLoopTree::policy_unroll(PhaseIdealLoop *phase) {
   //   the residual iterations are more than 10% of the trip count
   //   and rounds of "unroll,optimize" are not making significant progress
   //   Progress defined as current size less than 20% larger than previous size.
+  // Loops that slp analysis has mapped to vectors are exempt as long as the
+  // next round stays within slp_max_unroll: the check above already keeps
+  // the unrolled body within the profiled trip count, and stopping short of
+  // the vector width leaves short trip count loops on narrow vectors.
   if (UseSuperWord && cl->node_count_before_unroll() > 0 &&
       future_unroll_cnt > LoopUnrollMin &&
+      !(cl->has_passed_slp() && future_unroll_cnt <= cl->slp_max_unroll()) &&
       (future_unroll_cnt - 1) * (100 / LoopPercentProfileLimit) > cl->profile_trip_cnt() &&
       1.2 * cl->node_count_before_unroll() < (double)_body.size()) {
     return false;
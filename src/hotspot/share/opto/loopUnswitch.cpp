@@ -84,11 +84,18 @@ bool IdealLoopTree::policy_unswitching( PhaseIdealLoop *phase ) const {
 
 //------------------------------find_unswitching_candidate-----------------------------
 // Find candidate "if" for unswitching
+//
+// A loop is unswitched on at most unswitch_max() tests, so when there are
+// more invariant tests than that, prefer the ones the profile says are
+// executed most often: unswitching a test that is rarely reached doubles
+// the loop for little gain.  Tests without profile data, and ties, fall
+// back to the first invariant test in dominator order.
 IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) const {
 
   // Find first invariant test that doesn't exit the loop
   LoopNode *head = loop->_head->as_Loop();
   IfNode* unswitch_iff = NULL;
+  float unswitch_cnt = COUNT_UNKNOWN;
   Node* n = head->in(LoopNode::LoopBackControl);
   while (n != head) {
     Node* n_dom = idom(n);
@@ -101,7 +108,12 @@ IfNode* PhaseIdealLoop::find_unswitching_candidate(const IdealLoopTree *loop) co
             // If condition is invariant and not a loop exit,
             // then found reason to unswitch.
             if (loop->is_invariant(bol) && !loop->is_loop_exit(iff)) {
-              unswitch_iff = iff;
+              float cnt = iff->_fcnt;
+              if (unswitch_iff == NULL || cnt == COUNT_UNKNOWN || unswitch_cnt == COUNT_UNKNOWN ||
+                  cnt >= unswitch_cnt) {
+                unswitch_iff = iff;
+                unswitch_cnt = cnt;
+              }
             }
           }
         }
@@ -1302,6 +1302,9 @@ public:
   // Attempt to use a conditional move instead of a phi/branch
   Node *conditional_move( Node *n );
 
+  // Can SuperWord turn a CMove of type bt in loop into a vector blend?
+  bool is_vector_cmove_candidate(IdealLoopTree* loop, BasicType bt) const;
+
   // Reorganize offset computations to lower register pressure.
   // Mostly prevent loop-fallout uses of the pre-incremented trip counter
   // (which are then alive with the post-incremented trip counter
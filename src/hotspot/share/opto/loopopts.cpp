@@ -574,6 +574,8 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   assert(r_loop == get_loop(iff), "sanity");
   // Always convert to CMOVE if all results are used only outside this loop.
   bool used_inside_loop = (r_loop == _ltree_root);
+  // Set if every Phi can become part of a vector blend.
+  bool vector_cmove = false;
 
   // Check profitability
   int cost = 0;
@@ -590,6 +592,12 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
       if (C->use_cmove()) {
         continue; //TODO: maybe we want to add some cost
       }
+      if (phis == 1 && is_vector_cmove_candidate(r_loop, bt)) {
+        // The scalar cost only matters if SuperWord gives up on the loop
+        vector_cmove = true;
+        cost++;
+        break;
+      }
       cost += Matcher::float_cmove_cost(); // Could be very expensive
       break;
     case T_LONG: {
@@ -675,6 +683,13 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   // we are going to predict accurately all the time.
   if (C->use_cmove() && (cmp_op == Op_CmpF || cmp_op == Op_CmpD)) {
     //keep going
+  } else if (vector_cmove && phis == 1 && (cmp_op == Op_CmpF || cmp_op == Op_CmpD)) {
+    // A blend costs the same whichever way the branch goes. Keep only
+    // branches the profile says are practically never taken.
+    float never_prob = PROB_UNLIKELY_MAG(6);
+    if (iff->_prob < never_prob || iff->_prob > (1.0f - never_prob)) {
+      return NULL;
+    }
   } else if (iff->_prob < infrequent_prob ||
       iff->_prob > (1.0f - infrequent_prob))
     return NULL;
@@ -736,6 +751,26 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   return iff->in(1);
 }
 
+//------------------------------is_vector_cmove_candidate----------------------
+// SuperWord packs a CMoveF/CMoveD together with its Bool and CmpF/CmpD
+// into CMoveVF/CMoveVD (see CMoveKit::make_cmovevd_pack), so a diamond in
+// the body of an innermost counted loop does not have to pay the scalar
+// float CMove cost if the platform can blend vectors of that type.
+bool PhaseIdealLoop::is_vector_cmove_candidate(IdealLoopTree* loop, BasicType bt) const {
+  if (!UseSuperWord || !UseVectorCmov) {
+    return false;
+  }
+  if (loop == _ltree_root || !loop->is_innermost() || !loop->_head->is_CountedLoop()) {
+    return false;
+  }
+  CountedLoopNode* cl = loop->_head->as_CountedLoop();
+  if (cl->is_post_loop() || cl->is_vectorized_loop()) {
+    return false;
+  }
+  int vopc = (bt == T_FLOAT) ? Op_CMoveVF : Op_CMoveVD;
+  return Matcher::match_rule_supported(vopc);
+}
+
 static void enqueue_cfg_uses(Node* m, Unique_Node_List& wq) {
   for (DUIterator_Fast imax, i = m->fast_outs(imax); i < imax; i++) {
     Node* u = m->fast_out(i);
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "compiler/compileLog.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "libadt/vectset.hpp"
 #include "memory/universe.hpp"
@@ -1280,7 +1281,8 @@ void PhaseMacroExpand::expand_allocate_common(
             AllocateNode* alloc, // allocation node to be expanded
             Node* length,  // array length for an array allocation
             const TypeFunc* slow_call_type, // Type of slow call
-            address slow_call_address  // Address of slow call
+            address slow_call_address,  // Address of slow call
+            bool pretenure  // Allocate through the slow call, for a pretenured site
     )
 {
 
@@ -1311,7 +1313,7 @@ void PhaseMacroExpand::expand_allocate_common(
     initial_slow_test = BoolNode::make_predicate(initial_slow_test, &_igvn);
   }
 
-  if (C->env()->dtrace_alloc_probes() ||
+  if (C->env()->dtrace_alloc_probes() || pretenure ||
       (!UseTLAB && !Universe::heap()->supports_inline_contig_alloc())) {
     // Force slow-path allocation
     always_slow = true;
@@ -1857,7 +1859,27 @@ Node* PhaseMacroExpand::prefetch_allocation(Node* i_o, Node*& needgc_false,
 }
 
 
+// Whether the objects of the allocation site of alloc mostly survive,
+// so that they are better allocated directly in the old generation.
+static bool is_pretenured_allocation(AllocateNode* alloc) {
+  if (!AllocationSiteProfile::is_enabled()) {
+    return false;
+  }
+  JVMState* jvms = alloc->jvms();
+  if (jvms == NULL || !jvms->has_method()) {
+    return false;
+  }
+  return AllocationSiteProfile::should_pretenure(jvms->method()->get_Method(), jvms->bci());
+}
+
 void PhaseMacroExpand::expand_allocate(AllocateNode *alloc) {
+  if (is_pretenured_allocation(alloc)) {
+    expand_allocate_common(alloc, NULL,
+                           OptoRuntime::new_instance_Type(),
+                           OptoRuntime::new_instance_pretenured_Java(),
+                           true /* pretenure */);
+    return;
+  }
   expand_allocate_common(alloc, NULL,
                          OptoRuntime::new_instance_Type(),
                          OptoRuntime::new_instance_Java());
@@ -1874,6 +1896,12 @@ void PhaseMacroExpand::expand_allocate_array(AllocateArrayNode *alloc) {
     // Don't zero type array during slow allocation in VM since
     // it will be initialized later by arraycopy in compiled code.
     slow_call_address = OptoRuntime::new_array_nozero_Java();
+  } else if (is_pretenured_allocation(alloc)) {
+    expand_allocate_common(alloc, length,
+                           OptoRuntime::new_array_Type(),
+                           OptoRuntime::new_array_pretenured_Java(),
+                           true /* pretenure */);
+    return;
   } else {
     slow_call_address = OptoRuntime::new_array_Java();
   }
@@ -2554,6 +2554,13 @@ Node *StoreNode::Ideal(PhaseGVN *phase, bool can_reshape) {
   }
 
 
+  if (MergeStores && can_reshape) {
+    Node* merged = Ideal_merge_stores(phase);
+    if (merged != NULL) {
+      return merged;
+    }
+  }
+
   // Capture an unaliased, unconditional, simple store into an initializer.
   // Or, if it is independent of the allocation, hoist it above the allocation.
   if (ReduceFieldZeroing && /*can_reshape &&*/
@@ -2709,6 +2716,267 @@ Node *StoreNode::Ideal_sign_extended_input(PhaseGVN *phase, int num_bits) {
   return NULL;
 }
 
+//------------------------------skip_constant_offsets--------------------------
+// Strip AddPs with constant offsets off adr, accumulating them into offset.
+// Two accesses with the same remaining pointer are a known distance apart.
+static Node* skip_constant_offsets(PhaseGVN* phase, Node* adr, intptr_t& offset) {
+  offset = 0;
+  adr = adr->uncast();
+  while (adr->is_AddP()) {
+    const TypeX* t = phase->type(adr->in(AddPNode::Offset))->isa_intptr_t();
+    if (t == NULL || !t->is_con()) {
+      break;
+    }
+    offset += t->get_con();
+    adr = adr->in(AddPNode::Address)->uncast();
+  }
+  return adr;
+}
+
+// Match val against x or (x >> shift) for a constant shift and return x.
+static Node* shifted_input(PhaseGVN* phase, Node* val, int rshift_op, int urshift_op, jint& shift) {
+  shift = 0;
+  int op = val->Opcode();
+  if (op == rshift_op || op == urshift_op) {
+    const TypeInt* t = phase->type(val->in(2))->isa_int();
+    if (t != NULL && t->is_con()) {
+      shift = t->get_con();
+      return val->in(1);
+    }
+  }
+  return val;
+}
+
+//------------------------------Ideal_merge_stores-----------------------------
+// Merge this store with the adjacent store of the same size that it follows:
+//   StoreB(StoreB(m, p, lo), p+1, hi) => StoreC(m, p, lo | (hi << 8))
+// and likewise StoreC pairs into a StoreI and StoreI pairs into a StoreL, so
+// repeated application builds up the widest store the values allow.  The
+// wide store stands for both narrow ones if they store two constants, or
+// the high and low pieces of the same value, e.g. (x >> 8) and x.  Which
+// store holds the low piece depends on the platform byte order.
+Node *StoreNode::Ideal_merge_stores(PhaseGVN *phase) {
+  int opc = Opcode();
+  if (opc != Op_StoreB && opc != Op_StoreC && opc != Op_StoreI) {
+    return NULL;
+  }
+  if (!UseUnalignedAccesses) {
+    return NULL; // the wide store is not aligned to its own size in general
+  }
+  Node* mem = in(MemNode::Memory);
+  if (mem->Opcode() != opc || mem->outcnt() != 1) {
+    return NULL;
+  }
+  StoreNode* prev = mem->as_Store();
+  if (!is_unordered() || !prev->is_unordered() ||
+      prev->in(MemNode::Control) != in(MemNode::Control) ||
+      phase->C->get_alias_index(prev->adr_type()) != phase->C->get_alias_index(adr_type())) {
+    return NULL;
+  }
+
+  int size = memory_size();
+  intptr_t off, prev_off;
+  Node* ptr = skip_constant_offsets(phase, in(MemNode::Address), off);
+  Node* prev_ptr = skip_constant_offsets(phase, prev->in(MemNode::Address), prev_off);
+  if (ptr != prev_ptr) {
+    return NULL;
+  }
+  StoreNode* lo_st;  // store to the lower address
+  StoreNode* hi_st;
+  if (off == prev_off + size) {
+    lo_st = prev;
+    hi_st = this;
+  } else if (prev_off == off + size) {
+    lo_st = this;
+    hi_st = prev;
+  } else {
+    return NULL;
+  }
+
+#ifdef VM_LITTLE_ENDIAN
+  Node* low_bits  = lo_st->in(MemNode::ValueIn);
+  Node* high_bits = hi_st->in(MemNode::ValueIn);
+#else
+  Node* low_bits  = hi_st->in(MemNode::ValueIn);
+  Node* high_bits = lo_st->in(MemNode::ValueIn);
+#endif
+
+  Node* val = NULL;
+  int bits = size * BitsPerByte;
+  if (size < 4) {
+    const TypeInt* tlo = phase->type(low_bits)->isa_int();
+    const TypeInt* thi = phase->type(high_bits)->isa_int();
+    if (tlo != NULL && tlo->is_con() && thi != NULL && thi->is_con()) {
+      juint mask = right_n_bits(bits);
+      val = phase->intcon((jint)(((juint)tlo->get_con() & mask) | (((juint)thi->get_con() & mask) << bits)));
+    } else {
+      jint lo_shift, hi_shift;
+      Node* lo_src = shifted_input(phase, low_bits,  Op_RShiftI, Op_URShiftI, lo_shift);
+      Node* hi_src = shifted_input(phase, high_bits, Op_RShiftI, Op_URShiftI, hi_shift);
+      if (lo_src == hi_src && lo_shift >= 0 && hi_shift == lo_shift + bits && hi_shift + bits <= BitsPerInt) {
+        val = low_bits; // the wider store keeps the next bits of the same value
+      }
+    }
+  } else {
+    const TypeInt* tlo = phase->type(low_bits)->isa_int();
+    const TypeInt* thi = phase->type(high_bits)->isa_int();
+    if (tlo != NULL && tlo->is_con() && thi != NULL && thi->is_con()) {
+      val = phase->longcon((jlong)(((julong)(juint)thi->get_con() << 32) | (julong)(juint)tlo->get_con()));
+    } else if (low_bits->Opcode() == Op_ConvL2I && high_bits->Opcode() == Op_ConvL2I) {
+      jint lo_shift, hi_shift;
+      Node* lo_src = shifted_input(phase, low_bits->in(1),  Op_RShiftL, Op_URShiftL, lo_shift);
+      Node* hi_src = shifted_input(phase, high_bits->in(1), Op_RShiftL, Op_URShiftL, hi_shift);
+      if (lo_src == hi_src && lo_shift >= 0 && hi_shift == lo_shift + bits && hi_shift + bits <= BitsPerLong) {
+        val = low_bits->in(1);
+      }
+    }
+  }
+  if (val == NULL) {
+    return NULL;
+  }
+
+  BasicType bt = (size == 1) ? T_CHAR : (size == 2) ? T_INT : T_LONG;
+  StoreNode* st = StoreNode::make(*phase, in(MemNode::Control), prev->in(MemNode::Memory),
+                                  lo_st->in(MemNode::Address), adr_type(), val, bt, MemNode::unordered);
+  st->set_mismatched_access();
+  st->set_unaligned_access();
+  return st;
+}
+
+//------------------------------combine_or_of_loads----------------------------
+// Turn an OrI tree over adjacent narrow loads into one wider load:
+//   LoadUB(p) | (LoadUB(p+1) << 8) => LoadUS(p)
+// (little endian; on a big endian platform the lower address has to supply
+// the high bits).  All but the most significant piece have to be zero
+// extended, the most significant one may be sign extended.  Up to four
+// pieces covering two or four bytes are recognized.
+Node* LoadNode::combine_or_of_loads(PhaseGVN* phase, Node* or_node) {
+  if (!UseUnalignedAccesses) {
+    return NULL;
+  }
+  const int max_pieces = 4;
+  Node* pieces[max_pieces];
+  int npieces = 0;
+  Node* worklist[2 * max_pieces];
+  int nwork = 0;
+  worklist[nwork++] = or_node->in(1);
+  worklist[nwork++] = or_node->in(2);
+  while (nwork > 0) {
+    Node* n = worklist[--nwork];
+    if (n->Opcode() == Op_OrI && n->outcnt() == 1) {
+      if (nwork + 2 > 2 * max_pieces) {
+        return NULL;
+      }
+      worklist[nwork++] = n->in(1);
+      worklist[nwork++] = n->in(2);
+    } else {
+      if (npieces == max_pieces) {
+        return NULL;
+      }
+      pieces[npieces++] = n;
+    }
+  }
+
+  LoadNode* loads[max_pieces];
+  jint shifts[max_pieces];
+  intptr_t offs[max_pieces];
+  Node* ptr = NULL;
+  for (int i = 0; i < npieces; i++) {
+    Node* n = pieces[i];
+    shifts[i] = 0;
+    if (n->Opcode() == Op_LShiftI) {
+      const TypeInt* t = phase->type(n->in(2))->isa_int();
+      if (t == NULL || !t->is_con()) {
+        return NULL;
+      }
+      shifts[i] = t->get_con();
+      n = n->in(1);
+    }
+    int op = n->Opcode();
+    if (op != Op_LoadUB && op != Op_LoadB && op != Op_LoadUS && op != Op_LoadS) {
+      return NULL;
+    }
+    loads[i] = n->as_Load();
+    if (!loads[i]->is_unordered() || loads[i]->is_unsafe_access()) {
+      return NULL;
+    }
+    Node* p = skip_constant_offsets(phase, loads[i]->in(MemNode::Address), offs[i]);
+    if (i == 0) {
+      ptr = p;
+    } else if (p != ptr ||
+               loads[i]->in(MemNode::Memory) != loads[0]->in(MemNode::Memory) ||
+               loads[i]->in(MemNode::Control) != loads[0]->in(MemNode::Control) ||
+               phase->C->get_alias_index(loads[i]->adr_type()) != phase->C->get_alias_index(loads[0]->adr_type())) {
+      return NULL;
+    }
+  }
+
+  // Sort the pieces by address.
+  for (int i = 1; i < npieces; i++) {
+    for (int j = i; j > 0 && offs[j - 1] > offs[j]; j--) {
+      swap(loads[j], loads[j - 1]);
+      swap(shifts[j], shifts[j - 1]);
+      swap(offs[j], offs[j - 1]);
+    }
+  }
+
+  // The pieces have to tile the loaded range without gaps, and each one
+  // has to be shifted to the position its address implies.
+  int total = 0;
+  for (int i = 0; i < npieces; i++) {
+    if (offs[i] != offs[0] + total) {
+      return NULL;
+    }
+    total += loads[i]->memory_size();
+  }
+  if (total != 2 && total != 4) {
+    return NULL;
+  }
+  int top = -1;  // the piece supplying the most significant bits
+  for (int i = 0; i < npieces; i++) {
+    int size = loads[i]->memory_size();
+#ifdef VM_LITTLE_ENDIAN
+    jint expected = (jint)(offs[i] - offs[0]) * BitsPerByte;
+#else
+    jint expected = (jint)(offs[0] + total - offs[i] - size) * BitsPerByte;
+#endif
+    if (shifts[i] != expected) {
+      return NULL;
+    }
+    if (expected + size * BitsPerByte == total * BitsPerByte) {
+      top = i;
+    }
+  }
+  assert(top >= 0, "tiling covers the most significant bits");
+  bool sign_extended = false;
+  for (int i = 0; i < npieces; i++) {
+    int op = loads[i]->Opcode();
+    if (op == Op_LoadB || op == Op_LoadS) {
+      if (i != top) {
+        return NULL; // its sign bits would spill over a higher piece
+      }
+      sign_extended = true;
+    }
+  }
+
+  Node* adr = loads[0]->in(MemNode::Address);
+  const Type* rt;
+  BasicType bt;
+  if (total == 4) {
+    rt = TypeInt::INT;
+    bt = T_INT;
+  } else if (sign_extended) {
+    rt = TypeInt::SHORT;
+    bt = T_SHORT;
+  } else {
+    rt = TypeInt::CHAR;
+    bt = T_CHAR;
+  }
+  return LoadNode::make(*phase, loads[0]->in(MemNode::Control), loads[0]->in(MemNode::Memory),
+                        adr, loads[0]->adr_type(), rt, bt, MemNode::unordered,
+                        loads[0]->_control_dependency, /* unaligned */ true, /* mismatched */ true);
+}
+
 //------------------------------value_never_loaded-----------------------------------
 // Determine whether there are any possible loads of the value stored.
 // For simplicity, we actually check if there are any loads from the
@@ -230,6 +230,9 @@ public:
                     MemOrd mo, ControlDependency control_dependency = DependsOnlyOnTest,
                     bool unaligned = false, bool mismatched = false, bool unsafe = false);
 
+  // Replace an OrI tree of shifted adjacent narrow loads by one wider load.
+  static Node* combine_or_of_loads(PhaseGVN* phase, Node* or_node);
+
   virtual uint hash()   const;  // Check the type
 
   // Handle algebraic identities here.  If we have an identity, return the Node
@@ -561,6 +564,7 @@ protected:
 
   Node *Ideal_masked_input       (PhaseGVN *phase, uint mask);
   Node *Ideal_sign_extended_input(PhaseGVN *phase, int  num_bits);
+  Node *Ideal_merge_stores       (PhaseGVN *phase);
 
 public:
   // We must ensure that stores of object references will be visible
@@ -36,6 +36,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/oopMap.hpp"
 #include "gc/g1/heapRegion.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcLocker.hpp"
@@ -90,6 +91,8 @@
 address OptoRuntime::_new_instance_Java                           = NULL;
 address OptoRuntime::_new_array_Java                              = NULL;
 address OptoRuntime::_new_array_nozero_Java                       = NULL;
+address OptoRuntime::_new_instance_pretenured_Java                = NULL;
+address OptoRuntime::_new_array_pretenured_Java                   = NULL;
 address OptoRuntime::_multianewarray2_Java                        = NULL;
 address OptoRuntime::_multianewarray3_Java                        = NULL;
 address OptoRuntime::_multianewarray4_Java                        = NULL;
@@ -134,6 +137,10 @@ bool OptoRuntime::generate(ciEnv* env) {
   gen(env, _new_instance_Java              , new_instance_Type            , new_instance_C                  ,    0 , true , false, false);
   gen(env, _new_array_Java                 , new_array_Type               , new_array_C                     ,    0 , true , false, false);
   gen(env, _new_array_nozero_Java          , new_array_Type               , new_array_nozero_C              ,    0 , true , false, false);
+  if (AllocationSiteProfile::is_enabled()) {
+    gen(env, _new_instance_pretenured_Java , new_instance_Type            , new_instance_pretenured_C       ,    0 , true , false, false);
+    gen(env, _new_array_pretenured_Java    , new_array_Type               , new_array_pretenured_C          ,    0 , true , false, false);
+  }
   gen(env, _multianewarray2_Java           , multianewarray2_Type         , multianewarray2_C               ,    0 , true , false, false);
   gen(env, _multianewarray3_Java           , multianewarray3_Type         , multianewarray3_C               ,    0 , true , false, false);
   gen(env, _multianewarray4_Java           , multianewarray4_Type         , multianewarray4_C               ,    0 , true , false, false);
@@ -266,6 +273,68 @@ JRT_BLOCK_ENTRY(void, OptoRuntime::new_array_C(Klass* array_type, int len, JavaT
   SharedRuntime::on_slowpath_allocation_exit(thread);
 JRT_END
 
+// object allocation for a pretenured allocation site
+JRT_BLOCK_ENTRY(void, OptoRuntime::new_instance_pretenured_C(Klass* klass, JavaThread* thread))
+  JRT_BLOCK;
+#ifndef PRODUCT
+  SharedRuntime::_new_instance_ctr++;
+#endif
+  assert(check_compiled_frame(thread), "incorrect caller");
+
+  // Initialize the class before pretenuring, which must not apply to the
+  // allocations of the class initializer.
+  int lh = klass->layout_helper();
+  if (Klass::layout_helper_needs_slow_path(lh) || !InstanceKlass::cast(klass)->is_initialized()) {
+    Handle holder(THREAD, klass->klass_holder()); // keep the klass alive
+    klass->check_valid_for_instantiation(false, THREAD);
+    if (!HAS_PENDING_EXCEPTION) {
+      InstanceKlass::cast(klass)->initialize(THREAD);
+    }
+  }
+
+  if (!HAS_PENDING_EXCEPTION) {
+    Handle holder(THREAD, klass->klass_holder()); // keep the klass alive
+    PretenureAllocationMark pam(thread);
+    oop result = InstanceKlass::cast(klass)->allocate_instance(THREAD);
+    thread->set_vm_result(result);
+  }
+
+  deoptimize_caller_frame(thread, HAS_PENDING_EXCEPTION);
+  JRT_BLOCK_END;
+
+  // inform GC that we won't do card marks for initializing writes.
+  SharedRuntime::on_slowpath_allocation_exit(thread);
+JRT_END
+
+// array allocation for a pretenured allocation site
+JRT_BLOCK_ENTRY(void, OptoRuntime::new_array_pretenured_C(Klass* array_type, int len, JavaThread *thread))
+  JRT_BLOCK;
+#ifndef PRODUCT
+  SharedRuntime::_new_array_ctr++;
+#endif
+  assert(check_compiled_frame(thread), "incorrect caller");
+
+  oop result;
+  {
+    PretenureAllocationMark pam(thread);
+    if (array_type->is_typeArray_klass()) {
+      BasicType elem_type = TypeArrayKlass::cast(array_type)->element_type();
+      result = oopFactory::new_typeArray(elem_type, len, THREAD);
+    } else {
+      Handle holder(THREAD, array_type->klass_holder()); // keep the array klass alive
+      Klass* elem_type = ObjArrayKlass::cast(array_type)->element_klass();
+      result = oopFactory::new_objArray(elem_type, len, THREAD);
+    }
+  }
+
+  deoptimize_caller_frame(thread, HAS_PENDING_EXCEPTION);
+  thread->set_vm_result(result);
+  JRT_BLOCK_END;
+
+  // inform GC that we won't do card marks for initializing writes.
+  SharedRuntime::on_slowpath_allocation_exit(thread);
+JRT_END
+
 // array allocation without zeroing
 JRT_BLOCK_ENTRY(void, OptoRuntime::new_array_nozero_C(Klass* array_type, int len, JavaThread *thread))
   JRT_BLOCK;
@@ -1131,6 +1200,26 @@ const TypeFunc* OptoRuntime::vectorizedMismatch_Type() {
   return TypeFunc::make(domain, range);
 }
 
+const TypeFunc* OptoRuntime::vectorizedHashCode_Type() {
+  // create input type (domain)
+  int num_args = 4;
+  int argcnt = num_args;
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // address of the first element
+  fields[argp++] = TypeInt::INT;        // length, number of elements
+  fields[argp++] = TypeInt::INT;        // initial hash value
+  fields[argp++] = TypeInt::INT;        // basic type of the elements
+  assert(argp == TypeFunc::Parms + argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms + argcnt, fields);
+
+  //return hash value (int)
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms + 0] = TypeInt::INT;
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms + 1, fields);
+  return TypeFunc::make(domain, range);
+}
+
 // GHASH block processing
 const TypeFunc* OptoRuntime::ghash_processBlocks_Type() {
     int argcnt = 4;
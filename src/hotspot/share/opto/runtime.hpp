@@ -136,6 +136,8 @@ class OptoRuntime : public AllStatic {
   static address _new_instance_Java;
   static address _new_array_Java;
   static address _new_array_nozero_Java;
+  static address _new_instance_pretenured_Java;
+  static address _new_array_pretenured_Java;
   static address _multianewarray2_Java;
   static address _multianewarray3_Java;
   static address _multianewarray4_Java;
@@ -161,6 +163,10 @@ class OptoRuntime : public AllStatic {
   static void new_array_C(Klass* array_klass, int len, JavaThread *thread);
   static void new_array_nozero_C(Klass* array_klass, int len, JavaThread *thread);
 
+  // Same as above, in the old generation if possible, for pretenured allocation sites
+  static void new_instance_pretenured_C(Klass* instance_klass, JavaThread *thread);
+  static void new_array_pretenured_C(Klass* array_klass, int len, JavaThread *thread);
+
   // Allocate storage for a multi-dimensional arrays
   // Note: needs to be fixed for arbitrary number of dimensions
   static void multianewarray2_C(Klass* klass, int len1, int len2, JavaThread *thread);
@@ -214,6 +220,8 @@ private:
   static address new_instance_Java()                     { return _new_instance_Java; }
   static address new_array_Java()                        { return _new_array_Java; }
   static address new_array_nozero_Java()                 { return _new_array_nozero_Java; }
+  static address new_instance_pretenured_Java()          { return _new_instance_pretenured_Java; }
+  static address new_array_pretenured_Java()             { return _new_array_pretenured_Java; }
   static address multianewarray2_Java()                  { return _multianewarray2_Java; }
   static address multianewarray3_Java()                  { return _multianewarray3_Java; }
   static address multianewarray4_Java()                  { return _multianewarray4_Java; }
@@ -290,6 +298,7 @@ private:
   static const TypeFunc* mulAdd_Type();
 
   static const TypeFunc* vectorizedMismatch_Type();
+  static const TypeFunc* vectorizedHashCode_Type();
 
   static const TypeFunc* ghash_processBlocks_Type();
   static const TypeFunc* base64_encodeBlock_Type();
@@ -122,7 +122,11 @@ void SuperWord::transform_loop(IdealLoopTree* lpt, bool do_optimization) {
     if (SuperWordLoopUnrollAnalysis && cl->slp_max_unroll() == 0) return;
   }
 
-  // Check for no control flow in body (other than exit)
+  // Check for no control flow in body (other than exit). This also
+  // rejects loops calling the Math intrinsic stubs (dexp, dlog, ...):
+  // those are CallLeaf nodes on the control path. Packing them would need
+  // vector variants that give bit-identical results to the scalar stubs,
+  // since the interpreter and C1 use the scalar ones.
   Node *cl_exit = cl->loopexit();
   if (cl->is_main_loop() && (cl_exit->in(0) != lpt->_head)) {
     #ifndef PRODUCT
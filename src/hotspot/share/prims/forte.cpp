@@ -641,6 +641,14 @@ void    collector_func_load(char* name,
 } // end extern "C"
 #endif // !IA64
 
+void Forte::get_call_trace(void* trace, jint depth, void* ucontext) {
+#if !defined(IA64)
+  AsyncGetCallTrace((ASGCT_CallTrace*)trace, depth, ucontext);
+#else
+  ((ASGCT_CallTrace*)trace)->num_frames = ticks_unknown_state;
+#endif // !IA64
+}
+
 void Forte::register_stub(const char* name, address start, address end) {
 #if !defined(_WINDOWS) && !defined(IA64)
   assert(pointer_delta(end, start, sizeof(jbyte)) < INT_MAX,
@@ -658,4 +666,8 @@ extern "C" {
     trace->num_frames = ticks_no_class_load; // -1
   }
 }
+
+void Forte::get_call_trace(void* trace, jint depth, void* ucontext) {
+  AsyncGetCallTrace((ASGCT_CallTrace*)trace, depth, ucontext);
+}
 #endif // INCLUDE_JVMTI
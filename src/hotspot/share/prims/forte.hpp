@@ -32,6 +32,10 @@ class Forte : AllStatic {
    static void register_stub(const char* name, address start, address end)
                                                  NOT_JVMTI_RETURN;
                                                  // register internal VM stub
+
+   // Async-signal-safe sampling of the current thread's Java stack, the
+   // same walk as AsyncGetCallTrace. 'trace' points to an ASGCT_CallTrace.
+   static void get_call_trace(void* trace, jint depth, void* ucontext);
 };
 
 #endif // SHARE_PRIMS_FORTE_HPP
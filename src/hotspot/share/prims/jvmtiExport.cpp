@@ -1489,6 +1489,38 @@ void JvmtiExport::post_object_free(JvmtiEnv* env, jlong tag) {
   }
 }
 
+// Posts the ObjectFree events for the tags collected by a GC, see
+// JvmtiTagMap::do_weak_oops. Runs on the service thread.
+void JvmtiExport::post_deferred_object_free(JvmtiEnv* target, const GrowableArray<jlong>* tags) {
+  JavaThread* thread = JavaThread::current();
+
+  EVT_TRIG_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[%s] Trg Deferred Object Free triggered",
+                 JvmtiTrace::safe_get_thread_name(thread)));
+
+  // The environment might have been disposed of since the GC, an environment
+  // is not deallocated while it is being iterated over.
+  JvmtiEnvIterator it;
+  for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
+    if (env != target) {
+      continue;
+    }
+    if (!env->is_valid() || !env->is_enabled(JVMTI_EVENT_OBJECT_FREE)) {
+      return;
+    }
+    jvmtiEventObjectFree callback = env->callbacks()->ObjectFree;
+    if (callback == NULL) {
+      return;
+    }
+    EVT_TRACE(JVMTI_EVENT_OBJECT_FREE, ("[%s] Evt Deferred Object Free sent %d",
+              JvmtiTrace::safe_get_thread_name(thread), tags->length()));
+    JvmtiJavaThreadEventTransition jet(thread);
+    for (int i = 0; i < tags->length(); i++) {
+      (*callback)(env->jvmti_external(), tags->at(i));
+    }
+    return;
+  }
+}
+
 void JvmtiExport::post_resource_exhausted(jint resource_exhausted_flags, const char* description) {
 
   JavaThread *thread  = JavaThread::current();
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "prims/forte.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiExtensions.hpp"
 
@@ -42,9 +43,25 @@ static jvmtiError JNICALL IsClassUnloadingEnabled(const jvmtiEnv* env, jboolean*
   return JVMTI_ERROR_NONE;
 }
 
+// extension function, a supported entry point for AsyncGetCallTrace. It is
+// async-signal-safe and needs no capabilities, but as with AsyncGetCallTrace
+// the agent must have enabled CLASS_LOAD events since startup so that the
+// jmethodIDs already exist. The outcome is reported in trace->num_frames.
+static jvmtiError JNICALL GetCallTrace(const jvmtiEnv* env, void* trace, jint depth, void* ucontext, ...) {
+  if (trace == NULL) {
+    return JVMTI_ERROR_NULL_POINTER;
+  }
+  if (depth < 0) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  Forte::get_call_trace(trace, depth, ucontext);
+  return JVMTI_ERROR_NONE;
+}
+
 // register extension functions and events. In this implementation we
-// have a single extension function (to prove the API) that tests if class
-// unloading is enabled or disabled. We also have a single extension event
+// have an extension function (to prove the API) that tests if class
+// unloading is enabled or disabled, and one that samples the current
+// thread's stack from a signal handler. We also have a single extension event
 // EXT_EVENT_CLASS_UNLOAD which is used to provide the JVMDI_EVENT_CLASS_UNLOAD
 // event. The function and the event are registered here.
 //
@@ -67,6 +84,25 @@ void JvmtiExtensions::register_extensions() {
   };
   _ext_functions->append(&ext_func);
 
+  static jvmtiParamInfo call_trace_params[] = {
+    { (char*)"trace", JVMTI_KIND_IN_PTR, JVMTI_TYPE_CVOID, JNI_FALSE },
+    { (char*)"depth", JVMTI_KIND_IN, JVMTI_TYPE_JINT, JNI_FALSE },
+    { (char*)"ucontext", JVMTI_KIND_IN_PTR, JVMTI_TYPE_CVOID, JNI_TRUE }
+  };
+  static jvmtiError call_trace_errors[] = {
+    JVMTI_ERROR_ILLEGAL_ARGUMENT
+  };
+  static jvmtiExtensionFunctionInfo call_trace_func = {
+    (jvmtiExtensionFunction)GetCallTrace,
+    (char*)"com.sun.hotspot.functions.GetCallTrace",
+    (char*)"Sample the current thread's stack from a signal handler (AsyncGetCallTrace)",
+    sizeof(call_trace_params)/sizeof(call_trace_params[0]),
+    call_trace_params,
+    sizeof(call_trace_errors)/sizeof(call_trace_errors[0]),
+    call_trace_errors
+  };
+  _ext_functions->append(&call_trace_func);
+
   // register our extension event
 
   static jvmtiParamInfo event_params[] = {
@@ -938,6 +938,15 @@ JvmtiDeferredEvent JvmtiDeferredEvent::dynamic_code_generated_event(
   return event;
 }
 
+JvmtiDeferredEvent JvmtiDeferredEvent::object_free_event(
+      JvmtiEnv* env, GrowableArray<jlong>* tags) {
+  JvmtiDeferredEvent event = JvmtiDeferredEvent(TYPE_OBJECT_FREE);
+  // The event takes ownership of the tags, they are freed once posted.
+  event._event_data.object_free.env = env;
+  event._event_data.object_free.tags = tags;
+  return event;
+}
+
 void JvmtiDeferredEvent::post() {
   assert(ServiceThread::is_service_thread(Thread::current()),
          "Service thread must post enqueued events");
@@ -971,6 +980,12 @@ void JvmtiDeferredEvent::post() {
       }
       break;
     }
+    case TYPE_OBJECT_FREE: {
+      GrowableArray<jlong>* tags = _event_data.object_free.tags;
+      JvmtiExport::post_deferred_object_free(_event_data.object_free.env, tags);
+      delete tags;
+      break;
+    }
     default:
       ShouldNotReachHere();
   }
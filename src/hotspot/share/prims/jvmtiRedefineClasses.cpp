@@ -24,7 +24,7 @@
 
 #include "precompiled.hpp"
 #include "aot/aotLoader.hpp"
-#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/classLoaderDataGraph.inline.hpp"
 #include "classfile/classFileStream.hpp"
 #include "classfile/javaClasses.inline.hpp"
 #include "classfile/metadataOnStackMark.hpp"
@@ -33,6 +33,7 @@
 #include "classfile/verifier.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "interpreter/oopMapCache.hpp"
 #include "interpreter/rewriter.hpp"
 #include "logging/logStream.hpp"
@@ -49,6 +50,7 @@
 #include "prims/jvmtiThreadState.inline.hpp"
 #include "prims/resolvedMethodTable.hpp"
 #include "prims/methodComparator.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/jniHandles.inline.hpp"
@@ -223,8 +225,7 @@ void VM_RedefineClasses::doit() {
   // that reference methods of the evolved classes.
   // Have to do this after all classes are redefined and all methods that
   // are redefined are marked as old.
-  AdjustAndCleanMetadata adjust_and_clean_metadata(thread);
-  ClassLoaderDataGraph::classes_do(&adjust_and_clean_metadata);
+  adjust_and_clean_metadata(thread);
 
   // JSR-292 support
   if (_any_class_has_resolved_methods) {
@@ -3516,6 +3517,65 @@ void VM_RedefineClasses::AdjustAndCleanMetadata::do_klass(Klass* k) {
   }
 }
 
+// Records every class so the adjust walk can be split between workers.
+class CollectKlassesClosure : public KlassClosure {
+  GrowableArray<Klass*>* _klasses;
+ public:
+  CollectKlassesClosure(GrowableArray<Klass*>* klasses) : _klasses(klasses) {}
+  void do_klass(Klass* k) { _klasses->append(k); }
+};
+
+// Each class only has its own vtable, itable, constant pool caches and
+// MethodData adjusted, so distinct classes can be processed concurrently.
+class VM_RedefineClasses::ParallelAdjustAndCleanMetadataTask : public AbstractGangTask {
+  GrowableArray<Klass*>* _klasses;
+  volatile int           _claimed;
+
+ public:
+  enum { ClaimChunkSize = 64 };
+
+  ParallelAdjustAndCleanMetadataTask(GrowableArray<Klass*>* klasses) :
+    AbstractGangTask("Adjust Redefined Methods"),
+    _klasses(klasses),
+    _claimed(0) {}
+
+  void work(uint worker_id) {
+    AdjustAndCleanMetadata cl(Thread::current());
+    const int length = _klasses->length();
+    for (;;) {
+      int start = Atomic::add((int)ClaimChunkSize, &_claimed) - ClaimChunkSize;
+      if (start >= length) {
+        break;
+      }
+      int end = MIN2(start + (int)ClaimChunkSize, length);
+      for (int i = start; i < end; i++) {
+        cl.do_klass(_klasses->at(i));
+      }
+    }
+  }
+};
+
+void VM_RedefineClasses::adjust_and_clean_metadata(Thread* thread) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+
+  WorkGang* workers = Universe::heap()->get_safepoint_workers();
+  if (workers != NULL && workers->active_workers() > 1 &&
+      ClassLoaderDataGraph::num_instance_classes() >= 4 * ParallelAdjustAndCleanMetadataTask::ClaimChunkSize) {
+    ResourceMark rm(thread);
+    GrowableArray<Klass*>* klasses = new GrowableArray<Klass*>((int)ClassLoaderDataGraph::num_instance_classes());
+    CollectKlassesClosure collect(klasses);
+    ClassLoaderDataGraph::classes_do(&collect);
+
+    ParallelAdjustAndCleanMetadataTask task(klasses);
+    workers->run_task(&task);
+    log_debug(redefine, class, update)("adjusted %d classes with %u workers",
+                                       klasses->length(), workers->active_workers());
+  } else {
+    AdjustAndCleanMetadata adjust_and_clean_metadata(thread);
+    ClassLoaderDataGraph::classes_do(&adjust_and_clean_metadata);
+  }
+}
+
 void VM_RedefineClasses::update_jmethod_ids() {
   for (int j = 0; j < _matching_methods_length; ++j) {
     Method* old_method = _matching_old_methods[j];
@@ -523,6 +523,14 @@ class VM_RedefineClasses: public VM_Operation {
     void do_klass(Klass* k);
   };
 
+  // Applies AdjustAndCleanMetadata to a snapshot of all classes using
+  // the GC's safepoint workers.
+  class ParallelAdjustAndCleanMetadataTask;
+
+  // Runs AdjustAndCleanMetadata over all classes, in parallel if the
+  // heap provides safepoint workers and there are enough classes.
+  static void adjust_and_clean_metadata(Thread* thread);
+
  public:
   VM_RedefineClasses(jint class_count,
                      const jvmtiClassDefinition *class_defs,
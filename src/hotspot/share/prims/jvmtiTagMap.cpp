@@ -1280,6 +1280,44 @@ class VM_HeapIterateOperation: public VM_Operation {
 };
 
 
+// Applies an ObjectClosure to each tagged object.
+class TaggedObjectClosure : public JvmtiTagHashmapEntryClosure {
+ private:
+  ObjectClosure* _blk;
+ public:
+  TaggedObjectClosure(ObjectClosure* blk) : _blk(blk) {}
+
+  // The closure may untag the object and so remove the entry, see
+  // JvmtiTagHashmap::entry_iterate. It cannot tag other objects.
+  void do_entry(JvmtiTagHashmapEntry* entry) {
+    oop o = entry->object();
+    assert(o != NULL && Universe::heap()->is_in(o), "sanity check");
+    _blk->do_object(o);
+  }
+};
+
+// Used by IterateThroughHeap when the heap filter excludes untagged
+// objects. Walking the tag map instead of the heap makes the cost
+// proportional to the number of tagged objects rather than the heap size.
+class VM_TaggedObjectIterateOperation: public VM_Operation {
+ private:
+  JvmtiTagMap* _tag_map;
+  ObjectClosure* _blk;
+ public:
+  VM_TaggedObjectIterateOperation(JvmtiTagMap* tag_map, ObjectClosure* blk) :
+    _tag_map(tag_map), _blk(blk) { }
+
+  VMOp_Type type() const { return VMOp_HeapIterateOperation; }
+  void doit() {
+    // allows class files maps to be cached during iteration
+    ClassFieldMapCacheMark cm;
+
+    TaggedObjectClosure cl(_blk);
+    _tag_map->hashmap()->entry_iterate(&cl);
+  }
+};
+
+
 // An ObjectClosure used to support the deprecated IterateOverHeap and
 // IterateOverInstancesOfClass functions
 class IterateOverHeapObjectClosure: public ObjectClosure {
@@ -1504,8 +1542,14 @@ void JvmtiTagMap::iterate_through_heap(jint heap_filter,
                                       heap_filter,
                                       callbacks,
                                       user_data);
-  VM_HeapIterateOperation op(&blk);
-  VMThread::execute(&op);
+  if ((heap_filter & JVMTI_HEAP_FILTER_UNTAGGED) != 0) {
+    // only tagged objects can be reported
+    VM_TaggedObjectIterateOperation op(this, &blk);
+    VMThread::execute(&op);
+  } else {
+    VM_HeapIterateOperation op(&blk);
+    VMThread::execute(&op);
+  }
 }
 
 // support class for get_objects_with_tags
@@ -3321,6 +3365,9 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   // does this environment have the OBJECT_FREE event enabled
   bool post_object_free = env()->is_enabled(JVMTI_EVENT_OBJECT_FREE);
 
+  // tags of the freed objects, when the events are posted by the service thread
+  GrowableArray<jlong>* freed_tags = NULL;
+
   // counters used for trace message
   int freed = 0;
   int moved = 0;
@@ -3362,7 +3409,14 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
 
         // post the event to the profiler
         if (post_object_free) {
-          JvmtiExport::post_object_free(env(), tag);
+          if (DeferJvmtiObjectFreeEvents) {
+            if (freed_tags == NULL) {
+              freed_tags = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jlong>(64, true, mtInternal);
+            }
+            freed_tags->append(tag);
+          } else {
+            JvmtiExport::post_object_free(env(), tag);
+          }
         }
 
         ++freed;
@@ -3408,6 +3462,12 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
     delayed_add = next;
   }
 
+  if (freed_tags != NULL) {
+    // Let the Service thread (which is a real Java thread) post the events
+    MutexLocker ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    JvmtiDeferredEventQueue::enqueue(JvmtiDeferredEvent::object_free_event(env(), freed_tags));
+  }
+
   log_debug(jvmti, objecttagging)("(%d->%d, %d freed, %d total moves)",
                                   hashmap->_entry_count + freed, hashmap->_entry_count, freed, moved);
 }
@@ -51,10 +51,15 @@ static const size_t GROW_HINT = 32;
 
 static const size_t ResolvedMethodTableSizeLog = 10;
 
+// Include the holder's name so that common name and signature pairs such as
+// <init>()V or toString() from many classes do not all share one bucket. The
+// hash must not depend on the Method* itself since RedefineClasses updates the
+// vmtarget of existing entries in place.
 unsigned int method_hash(const Method* method) {
+  unsigned int holder_hash = method->klass_name()->identity_hash();
   unsigned int name_hash = method->name()->identity_hash();
   unsigned int signature_hash = method->signature()->identity_hash();
-  return name_hash ^ signature_hash;
+  return 31 * (name_hash ^ signature_hash) + holder_hash;
 }
 
 typedef ConcurrentHashTable<ResolvedMethodTableConfig,
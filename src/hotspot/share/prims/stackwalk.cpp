@@ -164,20 +164,24 @@ int StackWalk::fill_in_frames(jlong mode, BaseFrameStream& stream,
 
 // Fill in the LiveStackFrameInfo at the given index in frames_array
 void LiveFrameStream::fill_frame(int index, objArrayHandle  frames_array,
-                                 const methodHandle& method, TRAPS) {
+                                 Method* method, TRAPS) {
   HandleMark hm(THREAD);
+  methodHandle mh(THREAD, method);
   Handle stackFrame(THREAD, frames_array->obj_at(index));
-  fill_live_stackframe(stackFrame, method, CHECK);
+  fill_live_stackframe(stackFrame, mh, CHECK);
 }
 
 // Fill in the StackFrameInfo at the given index in frames_array
 void JavaFrameStream::fill_frame(int index, objArrayHandle  frames_array,
-                                 const methodHandle& method, TRAPS) {
+                                 Method* method, TRAPS) {
   if (_need_method_info) {
     HandleMark hm(THREAD);
+    methodHandle mh(THREAD, method);
     Handle stackFrame(THREAD, frames_array->obj_at(index));
-    fill_stackframe(stackFrame, method, CHECK);
+    fill_stackframe(stackFrame, mh, CHECK);
   } else {
+    // Class-only walks (e.g. getCallerClass) store the mirror directly;
+    // no handles are needed since nothing here can safepoint.
     frames_array->obj_at_put(index, method->method_holder()->java_mirror());
   }
 }
@@ -82,6 +82,9 @@
 #if INCLUDE_CDS
 #include "prims/cdsoffsets.hpp"
 #endif // INCLUDE_CDS
+#if INCLUDE_EPSILONGC
+#include "gc/epsilon/epsilonHeap.hpp"
+#endif // INCLUDE_EPSILONGC
 #if INCLUDE_G1GC
 #include "gc/g1/g1Arguments.hpp"
 #include "gc/g1/g1CollectedHeap.inline.hpp"
@@ -680,6 +683,26 @@ WB_END
 
 #endif // INCLUDE_G1GC
 
+#if INCLUDE_EPSILONGC
+
+WB_ENTRY(void, WB_EpsilonSetArenaMark(JNIEnv* env, jobject o))
+  if (UseEpsilonGC) {
+    EpsilonHeap::heap()->set_arena_mark();
+    return;
+  }
+  THROW_MSG(vmSymbols::java_lang_UnsupportedOperationException(), "WB_EpsilonSetArenaMark: Epsilon GC is not enabled");
+WB_END
+
+WB_ENTRY(void, WB_EpsilonResetToArenaMark(JNIEnv* env, jobject o))
+  if (UseEpsilonGC) {
+    EpsilonHeap::heap()->reset_to_arena_mark();
+    return;
+  }
+  THROW_MSG(vmSymbols::java_lang_UnsupportedOperationException(), "WB_EpsilonResetToArenaMark: Epsilon GC is not enabled");
+WB_END
+
+#endif // INCLUDE_EPSILONGC
+
 #if INCLUDE_NMT
 // Alloc memory using the test memory type so that we can use that to see if
 // NMT picks it up correctly
@@ -2207,6 +2230,10 @@ static JNINativeMethod methods[] = {
   {CC"nvdimmReservedStart", CC"()J",                  (void*)&WB_NvdimmReservedStart },
   {CC"nvdimmReservedEnd",   CC"()J",                  (void*)&WB_NvdimmReservedEnd },
 #endif // INCLUDE_G1GC || INCLUDE_PARALLELGC
+#if INCLUDE_EPSILONGC
+  {CC"epsilonSetArenaMark", CC"()V",                  (void*)&WB_EpsilonSetArenaMark },
+  {CC"epsilonResetToArenaMark", CC"()V",              (void*)&WB_EpsilonResetToArenaMark },
+#endif // INCLUDE_EPSILONGC
 #if INCLUDE_PARALLELGC
   {CC"psVirtualSpaceAlignment",CC"()J",               (void*)&WB_PSVirtualSpaceAlignment},
   {CC"psHeapGenerationAlignment",CC"()J",             (void*)&WB_PSHeapGenerationAlignment},
@@ -471,12 +471,18 @@ static void clean_up_cached_monitor_info(JavaThread* thread = NULL) {
 }
 
 
+// Unlike single revocations, bulk operations can't be done with
+// handshakes. The locking fast paths revoke a stale bias with a CAS, so
+// the prototype header change and the fixing up of the biased locks on
+// all thread stacks must appear atomic to every thread.
 class VM_BulkRevokeBias : public VM_Operation {
 private:
   Handle* _obj;
   JavaThread* _requesting_thread;
   bool _bulk_rebias;
   uint64_t _safepoint_id;
+  markWord _prototype_at_request;
+  bool _superseded;
 
 public:
   VM_BulkRevokeBias(Handle* obj, JavaThread* requesting_thread,
@@ -484,10 +490,32 @@ public:
     : _obj(obj)
     , _requesting_thread(requesting_thread)
     , _bulk_rebias(bulk_rebias)
-    , _safepoint_id(0) {}
+    , _safepoint_id(0)
+    , _prototype_at_request((*obj)->klass()->prototype_header())
+    , _superseded(false) {}
 
   virtual VMOp_Type type() const { return VMOp_BulkRevokeBias; }
 
+  // Skip the safepoint if another bulk operation on the type, waited
+  // for while queueing this one, already made the object's bias stale:
+  // biasing was disabled, or for a rebias, the epoch has moved on. The
+  // caller then revokes the stale bias with a CAS.
+  virtual bool doit_prologue() {
+    markWord prototype = (*_obj)->klass()->prototype_header();
+    if (!prototype.has_bias_pattern() ||
+        (_bulk_rebias && prototype.bias_epoch() != _prototype_at_request.bias_epoch())) {
+      log_info(biasedlocking)("* Skipping bulk %s, superseded by another bulk operation",
+                              _bulk_rebias ? "rebias" : "revoke");
+      _superseded = true;
+      return false;
+    }
+    return true;
+  }
+
+  bool is_superseded() const {
+    return _superseded;
+  }
+
   virtual void doit() {
     BiasedLocking::bulk_revoke_at_safepoint((*_obj)(), _bulk_rebias, _requesting_thread);
     _safepoint_id = SafepointSynchronize::safepoint_id();
@@ -844,6 +872,9 @@ void BiasedLocking::revoke(Handle obj, TRAPS) {
       VM_BulkRevokeBias bulk_revoke(&obj, (JavaThread*)THREAD,
                                     (heuristics == HR_BULK_REBIAS));
       VMThread::execute(&bulk_revoke);
+      if (bulk_revoke.is_superseded()) {
+        continue;
+      }
       if (event.should_commit()) {
         post_class_revocation_event(&event, obj->klass(), &bulk_revoke);
       }
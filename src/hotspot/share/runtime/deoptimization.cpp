@@ -32,6 +32,9 @@
 #include "code/pcDesc.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/compilationPolicy.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/strongRootsScope.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
@@ -807,15 +810,61 @@ class DeoptimizeMarkedTC : public ThreadClosure {
   }
 };
 
+// Patches the frames of marked methods on the stacks of the threads
+// claimed by each worker. Deoptimizing a frame only touches the stack
+// of its own thread, which is what the handshake based deoptimization
+// below relies on as well.
+class ParallelDeoptimizeMarkedTask : public AbstractGangTask {
+ private:
+  class DeoptimizeMarkedJavaThreadTC : public ThreadClosure {
+   public:
+    virtual void do_thread(Thread* thread) {
+      if (thread->is_Java_thread()) {
+        ((JavaThread*)thread)->deoptimize_marked_methods();
+      }
+    }
+  };
+
+ public:
+  ParallelDeoptimizeMarkedTask() : AbstractGangTask("Deoptimize Marked Frames") {}
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    DeoptimizeMarkedJavaThreadTC cl;
+    Threads::possibly_parallel_threads_do(true, &cl);
+  }
+};
+
+// Walk the stacks in parallel, using the GC's safepoint workers, when
+// there are enough threads for the walks to outweigh starting the gang.
+static WorkGang* deoptimization_workers() {
+  if (!Thread::current()->is_VM_thread() || Universe::heap()->is_gc_active()) {
+    return NULL;
+  }
+  WorkGang* workers = Universe::heap()->get_safepoint_workers();
+  if (workers == NULL || workers->active_workers() < 2 ||
+      Threads::number_of_threads() < 2 * (int)workers->active_workers()) {
+    return NULL;
+  }
+  return workers;
+}
+
 void Deoptimization::deoptimize_all_marked() {
   ResourceMark rm;
   DeoptimizationMarker dm;
 
   if (SafepointSynchronize::is_at_safepoint()) {
-    DeoptimizeMarkedTC deopt;
     // Make the dependent methods not entrant
     CodeCache::make_marked_nmethods_not_entrant();
-    Threads::java_threads_do(&deopt);
+    WorkGang* workers = deoptimization_workers();
+    if (workers != NULL) {
+      ParallelDeoptimizeMarkedTask task;
+      StrongRootsScope srs(workers->active_workers());
+      workers->run_task(&task);
+    } else {
+      DeoptimizeMarkedTC deopt;
+      Threads::java_threads_do(&deopt);
+    }
   } else {
     // Make the dependent methods not entrant
     {
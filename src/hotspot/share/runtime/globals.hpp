@@ -373,6 +373,9 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, UseVectorizedMismatchIntrinsic, false,                   \
           "Enables intrinsification of ArraysSupport.vectorizedMismatch()") \
                                                                             \
+  diagnostic(bool, UseVectorizedHashCodeIntrinsic, false,                   \
+          "Enables intrinsification of ArraysSupport.vectorizedHashCode()") \
+                                                                            \
   diagnostic(ccstrlist, DisableIntrinsic, "",                               \
          "do not expand intrinsics whose (internal) names appear here")     \
                                                                             \
@@ -441,6 +444,10 @@ const size_t minimumSymbolTableSize = 1024;
           "Number of ring buffer event logs")                               \
           range(1, NOT_LP64(1*K) LP64_ONLY(1*M))                            \
                                                                             \
+  diagnostic(bool, ProfileVMLocks, false,                                   \
+          "Collect acquisition and contention statistics for the VM's "     \
+          "internal locks, printed by the VM.mutex_stats command")          \
+                                                                            \
   diagnostic(bool, BytecodeVerificationRemote, true,                        \
           "Enable the Java bytecode verifier for remote classes")           \
                                                                             \
@@ -702,6 +709,12 @@ const size_t minimumSymbolTableSize = 1024;
           "Allow parallel defineClass requests for class loaders "          \
           "registering as parallel capable")                                \
                                                                             \
+  experimental(uint, JImagePrefetchThreads, 0,                              \
+          "Number of threads used at startup to decompress the classes "    \
+          "named in lib/classlist from a compressed runtime image when "    \
+          "CDS is not in use. 0 disables prefetching")                      \
+          range(0, 64)                                                      \
+                                                                            \
   product_pd(bool, DontYieldALot,                                           \
           "Throw away obvious excess yield calls")                          \
                                                                             \
@@ -723,9 +736,19 @@ const size_t minimumSymbolTableSize = 1024;
   experimental(intx, MonitorUsedDeflationThreshold, 90,                     \
                 "Percentage of used monitors before triggering cleanup "    \
                 "safepoint which deflates monitors (0 is off). "            \
-                "The check is performed on GuaranteedSafepointInterval.")   \
+                "The check is performed on GuaranteedSafepointInterval "    \
+                "or AsyncDeflationInterval.")                               \
                 range(0, 100)                                               \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors, true,                             \
+          "Deflate idle monitors using the ServiceThread instead of "       \
+          "during safepoint cleanup")                                       \
+                                                                            \
+  diagnostic(intx, AsyncDeflationInterval, 250,                             \
+          "Async deflate idle monitors every so many milliseconds when "    \
+          "MonitorUsedDeflationThreshold is exceeded (0 is off).")          \
+          range(0, max_jint)                                                \
+                                                                            \
   experimental(intx, hashCode, 5,                                           \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -955,6 +978,10 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(bool, VerifyBeforeIteration, false,                            \
           "Verify memory system before JVMTI iteration")                    \
                                                                             \
+  product(bool, DeferJvmtiObjectFreeEvents, false,                          \
+          "Post the JVMTI ObjectFree events for the tags freed by a GC "    \
+          "from the service thread rather than during the GC pause")        \
+                                                                            \
   /* compiler interface */                                                  \
                                                                             \
   develop(bool, CIPrintCompilerName, false,                                 \
@@ -1063,6 +1090,11 @@ const size_t minimumSymbolTableSize = 1024;
   develop(bool, UseCHA, true,                                               \
           "Enable CHA")                                                     \
                                                                             \
+  diagnostic(bool, UseSecondarySupersCache, true,                           \
+          "Remember the last secondary super found by a subtype check in "  \
+          "the subclass. Turning this off avoids cache line contention "    \
+          "when threads check one class against alternating supertypes")   \
+                                                                            \
   product(bool, UseTypeProfile, true,                                       \
           "Check interpreter profile for historically monomorphic calls")   \
                                                                             \
@@ -1148,6 +1180,11 @@ const size_t minimumSymbolTableSize = 1024;
           "If LogVMOutput or LogCompilation is on, save VM output to "      \
           "this file [default: ./hotspot_pid%p.log] (%p replaced with pid)")\
                                                                             \
+  product(size_t, AsyncLogBufferSize, 2*M,                                  \
+          "Memory budget (in bytes) for the buffer of asynchronous "        \
+          "logging, enabled by -Xlog:async")                                \
+          range(100*K, 50*M)                                                \
+                                                                            \
   product(ccstr, ErrorFile, NULL,                                           \
           "If an error occurs, save the error data to this file "           \
           "[default: ./hs_err_pid%p.log] (%p replaced with pid)")           \
@@ -1466,6 +1503,11 @@ const size_t minimumSymbolTableSize = 1024;
   LP64_ONLY(range(0, max_intx/MICROUNITS))                                  \
   NOT_LP64(range(0, max_intx))                                              \
                                                                             \
+  product(intx, SafepointStallSampleDelay, 200,                             \
+          "Sample the pc of each thread that has not reached a safepoint "  \
+          "after this many milliseconds (0 means never)")                   \
+  range(0, max_jint)                                                        \
+                                                                            \
   product(intx, NmethodSweepActivity, 10,                                   \
           "Removes cold nmethods from code cache if > 0. Higher values "    \
           "result in more aggressive sweeping")                             \
@@ -1645,6 +1687,11 @@ const size_t minimumSymbolTableSize = 1024;
           "The minimum expansion of Metaspace (in bytes)")                  \
           range(0, max_uintx)                                               \
                                                                             \
+  product(bool, MetaspaceReleaseFreeChunkPages, true,                       \
+          "Give the pages of free medium and humongous metaspace chunks "   \
+          "back to the operating system when the chunks are returned "      \
+          "after class unloading")                                          \
+                                                                            \
   product(uintx, MaxMetaspaceFreeRatio,    70,                              \
           "The maximum percentage of Metaspace free after GC to avoid "     \
           "shrinking")                                                      \
@@ -1753,6 +1800,11 @@ const size_t minimumSymbolTableSize = 1024;
           "Minimum number of segments in a code cache block")               \
           range(1, 100)                                                     \
                                                                             \
+  product(bool, CodeCacheCompactAllocation, false,                          \
+          "Allocate code blobs from the start of the lowest addressed "     \
+          "free block that fits instead of the best fitting one, which "    \
+          "keeps live code packed at the low end of each code heap")        \
+                                                                            \
   notproduct(bool, ExitOnFullCodeCache, false,                              \
           "Exit the VM if we fill the code cache")                          \
                                                                             \
@@ -1765,6 +1817,11 @@ const size_t minimumSymbolTableSize = 1024;
           "Non-segmented code cache: X[%] of the total code cache")         \
           range(0, 100)                                                     \
                                                                             \
+  product(uintx, InlineCacheBufferChunks, 8,                                \
+          "Number of chunks the inline cache buffer may grow to before "    \
+          "running out of IC stubs forces a safepoint")                     \
+          range(1, 64)                                                      \
+                                                                            \
   /* AOT parameters */                                                      \
   experimental(bool, UseAOT, false,                                         \
           "Use AOT compiled files")                                         \
@@ -1778,6 +1835,10 @@ const size_t minimumSymbolTableSize = 1024;
   notproduct(bool, PrintAOTStatistics, false,                               \
           "Print AOT statistics")                                           \
                                                                             \
+  experimental(bool, AOTLazyMethodLinking, false,                           \
+          "Publish AOT compiled methods on their first invocation event "   \
+          "instead of when their class is initialized")                     \
+                                                                            \
   diagnostic(bool, UseAOTStrictLoading, false,                              \
           "Exit the VM if any of the AOT libraries has invalid config")     \
                                                                             \
@@ -1825,6 +1886,14 @@ const size_t minimumSymbolTableSize = 1024;
   diagnostic(ccstr, CompilerDirectivesFile, NULL,                           \
           "Read compiler directives from this file")                        \
                                                                             \
+  product(ccstr, HotMethodsFile, NULL,                                      \
+          "Compile the methods listed in this file, as written by "         \
+          "DumpHotMethodsFile, at the highest tier on their first "         \
+          "invocation event")                                               \
+                                                                            \
+  product(ccstr, DumpHotMethodsFile, NULL,                                  \
+          "Write the methods that have C2 code to this file at exit")       \
+                                                                            \
   product(ccstrlist, CompileCommand, "",                                    \
           "Prepend to .hotspot_compiler; e.g. log,java/lang/String.<init>") \
                                                                             \
@@ -2105,6 +2174,12 @@ const size_t minimumSymbolTableSize = 1024;
           "given timeout in milliseconds")                                  \
           range(0, max_intx)                                                \
                                                                             \
+  product(intx, TieredCompileQueueScanLimit, 1000,                          \
+          "Maximum number of tasks from the head of a compile queue "       \
+          "the tiered policy considers when selecting the next task, "      \
+          "0 means the whole queue")                                        \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, TieredStopAtLevel, 4,                                       \
           "Stop at given compilation level")                                \
           range(0, 4)                                                       \
@@ -2192,6 +2267,11 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, PerfDisableSharedMem, false,                                \
           "Store performance data in standard memory")                      \
                                                                             \
+  product(bool, PerfPublishSharedMem, false,                                \
+          "Update performance data in standard memory and copy it to the "  \
+          "shared memory file every PerfDataSamplingInterval "              \
+          "milliseconds (Linux only)")                                      \
+                                                                            \
   product(intx, PerfDataMemorySize, 32*K,                                   \
           "Size of performance data memory region. Will be rounded "        \
           "up to a multiple of the native os page size.")                   \
@@ -2207,6 +2287,12 @@ const size_t minimumSymbolTableSize = 1024;
   product(bool, PerfBypassFileSystemCheck, false,                           \
           "Bypass Win32 file system criteria checks (Windows Only)")        \
                                                                             \
+  diagnostic(bool, PhaseHardwareCounters, false,                            \
+          "Attribute hardware performance counters (cycles, instructions, " \
+          "cache and TLB misses) of the executing thread to GC and C2 "     \
+          "phases and report them with -Xlog:gc+phases+perf, "              \
+          "-Xlog:jit+perf and JFR (Linux only)")                            \
+                                                                            \
   product(intx, UnguardOnExecutionViolation, 0,                             \
           "Unguard page and retry on no-execute fault (Win32 only) "        \
           "0=off, 1=conservative, 2=aggressive")                            \
@@ -2260,6 +2346,12 @@ const size_t minimumSymbolTableSize = 1024;
           "Address to allocate shared memory region for class data")        \
           range(0, SIZE_MAX)                                                \
                                                                             \
+  diagnostic(intx, ArchiveRelocationMode, 0,                                \
+          "(0) map the CDS archive at the dump time address and relocate "  \
+          "it if that address is not available; (1) always relocate the "  \
+          "archive; (2) never relocate the archive")                        \
+          range(0, 2)                                                       \
+                                                                            \
   product(ccstr, SharedArchiveConfigFile, NULL,                             \
           "Data to add to the CDS archive file")                            \
                                                                             \
@@ -2299,6 +2391,12 @@ const size_t minimumSymbolTableSize = 1024;
           "resolution; 2+: stress test the BCI API by calling more BSMs "   \
           "via that API, instead of with the eagerly-resolved array.")      \
                                                                             \
+  diagnostic(bool, ShareStringConcatCallSites, true,                        \
+          "Link invokedynamic call sites bootstrapped by "                  \
+          "StringConcatFactory to the target of an already linked call "    \
+          "site with the same recipe, constants and type, instead of "      \
+          "calling the bootstrap method again")                             \
+                                                                            \
   diagnostic(bool, PauseAtStartup,      false,                              \
           "Causes the VM to pause at startup time and wait for the pause "  \
           "file to be removed (default: ./vm.paused.<pid>)")                \
@@ -2343,7 +2441,7 @@ const size_t minimumSymbolTableSize = 1024;
           range(1, markWord::max_age)                                       \
                                                                             \
   diagnostic(bool, StringDeduplicationResizeALot, false,                    \
-          "Force table resize every time the table is scanned")             \
+          "Force table resize every time the dedup queue is drained")       \
                                                                             \
   diagnostic(bool, StringDeduplicationRehashALot, false,                    \
           "Force table rehash every time the table is scanned")             \
@@ -2360,6 +2458,11 @@ const size_t minimumSymbolTableSize = 1024;
           "Dump the names all loaded classes, that could be stored into "   \
           "the CDS archive, in the specified file")                         \
                                                                             \
+  product(ccstr, PreloadClassList, NULL,                                    \
+          "Load and link the classes named in the specified file, in the "  \
+          "format of DumpLoadedClassList, on a background thread using "    \
+          "the system class loader")                                        \
+                                                                            \
   product(ccstr, SharedClassListFile, NULL,                                 \
           "Override the default CDS class list")                            \
                                                                             \
@@ -2372,6 +2475,10 @@ const size_t minimumSymbolTableSize = 1024;
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
+  diagnostic(bool, ArchiveResolvedSuperClassEntries, true,                  \
+          "Keep constant pool class entries that resolve to the class "     \
+          "itself or one of its super types resolved in the CDS archive")   \
+                                                                            \
   experimental(size_t, ArrayAllocatorMallocLimit,                           \
           SOLARIS_ONLY(64*K) NOT_SOLARIS((size_t)-1),                       \
           "Allocation less than this value will be allocated "              \
@@ -26,6 +26,7 @@
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/orderAccess.hpp"
@@ -44,24 +45,30 @@ public:
 };
 
 class HandshakeThreadsOperation: public HandshakeOperation {
-  static Semaphore _done;
   ThreadClosure* _thread_cl;
+  // Number of targets that have not yet completed (or canceled) the operation.
+  // Completing threads only decrement it, so the VM thread does not have to
+  // consume one semaphore signal per target thread.
+  volatile int32_t _pending_threads;
   bool _executed;
 public:
-  HandshakeThreadsOperation(ThreadClosure* cl) : _thread_cl(cl), _executed(false) {}
+  HandshakeThreadsOperation(ThreadClosure* cl) : _thread_cl(cl), _pending_threads(0), _executed(false) {}
   void do_handshake(JavaThread* thread);
-  bool thread_has_completed() { return _done.trywait(); }
+  void add_target() { Atomic::inc(&_pending_threads); }
+  bool is_completed() {
+    int32_t pending = OrderAccess::load_acquire(&_pending_threads);
+    assert(pending >= 0, "_pending_threads cannot be negative");
+    return pending == 0;
+  }
   bool executed() const { return _executed; }
 
 #ifdef ASSERT
   void check_state() {
-    assert(!_done.trywait(), "Must be zero");
+    assert(_pending_threads == 0, "Must be zero");
   }
 #endif
 };
 
-Semaphore HandshakeThreadsOperation::_done(0);
-
 class VM_Handshake: public VM_Operation {
   const jlong _handshake_timeout;
  public:
@@ -76,13 +83,15 @@ class VM_Handshake: public VM_Operation {
       _handshake_timeout(TimeHelper::millis_to_counter(HandshakeTimeout)), _op(op) {}
 
   void set_handshake(JavaThread* target) {
+    // Count the target before it can see, and complete, the operation.
+    _op->add_target();
     target->set_handshake_operation(_op);
   }
 
-  // This method returns true for threads completed their operation
-  // and true for threads canceled their operation.
+  // This method returns true once all targets have completed their operation,
+  // including targets that canceled their operation.
   // A cancellation can happen if the thread is exiting.
-  bool poll_for_completed_thread() { return _op->thread_has_completed(); }
+  bool all_threads_completed() { return _op->is_completed(); }
 
   bool handshake_has_timed_out(jlong start_time);
   static void handle_timeout();
@@ -140,7 +149,7 @@ class VM_HandshakeOneThread: public VM_Handshake {
         MutexLocker ml(Threads_lock);
         _target->handshake_process_by_vmthread();
       }
-    } while (!poll_for_completed_thread());
+    } while (!all_threads_completed());
     DEBUG_ONLY(_op->check_state();)
   }
 
@@ -171,7 +180,6 @@ class VM_HandshakeAllThreads: public VM_Handshake {
 
     log_debug(handshake)("Threads signaled, begin processing blocked threads by VMThtread");
     const jlong start_time = os::elapsed_counter();
-    int number_of_threads_completed = 0;
     do {
       // Check if handshake operation has timed out
       if (handshake_has_timed_out(start_time)) {
@@ -194,13 +202,7 @@ class VM_HandshakeAllThreads: public VM_Handshake {
           }
       }
 
-      while (poll_for_completed_thread()) {
-        // Includes canceled operations by exiting threads.
-        number_of_threads_completed++;
-      }
-
-    } while (number_of_threads_issued > number_of_threads_completed);
-    assert(number_of_threads_issued == number_of_threads_completed, "Must be the same");
+    } while (!all_threads_completed());
     DEBUG_ONLY(_op->check_state();)
   }
 
@@ -246,8 +248,8 @@ void HandshakeThreadsOperation::do_handshake(JavaThread* thread) {
     _executed = true;
   }
 
-  // Use the semaphore to inform the VM thread that we have completed the operation
-  _done.signal();
+  // Inform the VM thread that we have completed the operation
+  Atomic::dec(&_pending_threads);
 }
 
 void Handshake::execute(ThreadClosure* thread_cl) {
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/hardwareCounters.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/ostream.hpp"
+
+volatile int HardwareCounters::_unavailable = 0;
+
+void HardwareCounters::disable() {
+  if (Atomic::cmpxchg(1, &_unavailable, 0) == 0) {
+    log_warning(perf)("PhaseHardwareCounters disabled: hardware performance counters are not available");
+  }
+}
+
+bool HardwareCounters::is_event_enabled() {
+  return EventPhaseHardwareCounters::is_enabled();
+}
+
+bool HardwareCounters::read(HardwareCounterValues* values) {
+  Thread* thread = Thread::current_or_null();
+  if (thread == NULL) {
+    return false;
+  }
+  HardwareCounterInterface* counters = thread->hardware_counters();
+  if (counters == NULL) {
+    counters = new HardwareCounterInterface();
+    if (!counters->initialize()) {
+      delete counters;
+      disable();
+      return false;
+    }
+    thread->set_hardware_counters(counters);
+  }
+  return counters->read_counters(values) == OS_OK;
+}
+
+void HardwareCounters::print_on(outputStream* st, const HardwareCounterValues& values) {
+  double ipc = values.cycles() == 0 ? 0.0 : (double)values.instructions() / (double)values.cycles();
+  st->print("cycles=" UINT64_FORMAT " instructions=" UINT64_FORMAT " IPC=%.2f"
+            " LLC-misses=" UINT64_FORMAT " dTLB-misses=" UINT64_FORMAT,
+            values.cycles(), values.instructions(), ipc,
+            values.llc_misses(), values.dtlb_misses());
+}
+
+HardwareCounterScope::HardwareCounterScope(bool active) :
+  _active(active),
+  _start_ticks(),
+  _start() {
+  if (_active) {
+    _start_ticks.stamp();
+    _active = HardwareCounters::read(&_start);
+  }
+}
+
+bool HardwareCounterScope::elapsed(HardwareCounterValues* values) const {
+  if (!_active) {
+    return false;
+  }
+  HardwareCounterValues now;
+  if (!HardwareCounters::read(&now)) {
+    return false;
+  }
+  *values = now.since(_start);
+  return true;
+}
+
+void HardwareCounterScope::send_event(const char* phase, const HardwareCounterValues& values) const {
+  EventPhaseHardwareCounters event(UNTIMED);
+  if (event.should_commit()) {
+    event.set_starttime(_start_ticks);
+    event.set_endtime(Ticks::now());
+    event.set_phase(phase);
+    event.set_cycles(values.cycles());
+    event.set_instructions(values.instructions());
+    event.set_llcMisses(values.llc_misses());
+    event.set_dtlbMisses(values.dtlb_misses());
+    event.commit();
+  }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_HARDWARECOUNTERS_HPP
+#define SHARE_RUNTIME_HARDWARECOUNTERS_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os_perf.hpp"
+#include "utilities/ticks.hpp"
+
+class outputStream;
+
+// Attribution of hardware performance counters to GC and compiler phases
+// (-XX:+PhaseHardwareCounters). The counters belong to the thread that
+// executes the phase and are opened the first time that thread measures
+// one. If the platform or the kernel does not give access to the PMU the
+// feature switches itself off after a single warning.
+class HardwareCounters : AllStatic {
+  static volatile int _unavailable;
+
+  static void disable();
+ public:
+  static bool is_enabled() {
+    return PhaseHardwareCounters && _unavailable == 0;
+  }
+
+  static bool is_event_enabled();
+
+  // True if a phase should be measured given whether its log target is on.
+  static bool should_measure(bool log_enabled) {
+    return is_enabled() && (log_enabled || is_event_enabled());
+  }
+
+  // Reads the counters of the current thread.
+  static bool read(HardwareCounterValues* values);
+
+  static void print_on(outputStream* st, const HardwareCounterValues& values);
+};
+
+// Measures the counters of the current thread between construction and
+// the call to elapsed().
+class HardwareCounterScope : public StackObj {
+ private:
+  bool _active;
+  Ticks _start_ticks;
+  HardwareCounterValues _start;
+ public:
+  HardwareCounterScope(bool active);
+
+  bool is_active() const { return _active; }
+
+  // Counters accumulated since construction. Returns false if there is
+  // nothing to report.
+  bool elapsed(HardwareCounterValues* values) const;
+
+  // Sends a PhaseHardwareCounters event for values obtained from elapsed().
+  void send_event(const char* phase, const HardwareCounterValues& values) const;
+};
+
+#endif // SHARE_RUNTIME_HARDWARECOUNTERS_HPP
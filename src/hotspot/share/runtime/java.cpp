@@ -33,6 +33,8 @@
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/hotMethodList.hpp"
+#include "gc/shared/allocationTrace.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/support/jfrThreadId.hpp"
@@ -40,6 +42,7 @@
 #include "jvmci/jvmci.hpp"
 #endif
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logStream.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -460,6 +463,8 @@ void before_exit(JavaThread* thread) {
   // Stop concurrent GC threads
   Universe::heap()->stop();
 
+  AllocationTraceRecorder::shutdown();
+
   // Print GC/heap related information.
   Log(gc, heap, exit) log;
   if (log.is_info()) {
@@ -496,9 +501,17 @@ void before_exit(JavaThread* thread) {
   }
 #endif
 
+  if (DumpHotMethodsFile != NULL) {
+    HotMethodList::dump_to_file(DumpHotMethodsFile);
+  }
+
   print_statistics();
   Universe::heap()->print_tracing_info();
 
+  // The process may exit without finalizing the log configuration,
+  // so write out the asynchronously buffered log messages now.
+  AsyncLogWriter::flush();
+
   { MutexLocker ml(BeforeExit_lock);
     _before_exit_status = BEFORE_EXIT_DONE;
     BeforeExit_lock->notify_all();
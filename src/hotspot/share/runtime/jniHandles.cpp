@@ -30,9 +30,11 @@
 #include "memory/universe.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
@@ -328,7 +330,7 @@ bool JNIHandles::current_thread_in_native() {
 
 
 int             JNIHandleBlock::_blocks_allocated     = 0;
-JNIHandleBlock* JNIHandleBlock::_block_free_list      = NULL;
+JNIHandleBlock* volatile JNIHandleBlock::_block_free_list = NULL;
 #ifndef PRODUCT
 JNIHandleBlock* JNIHandleBlock::_block_list           = NULL;
 #endif
@@ -364,6 +366,31 @@ void JNIHandleBlock::zap() {
 }
 #endif // ASSERT
 
+JNIHandleBlock* JNIHandleBlock::pop_free_list() {
+  assert_lock_strong(JNIHandleBlockFreeList_lock);
+  JNIHandleBlock* block = OrderAccess::load_acquire(&_block_free_list);
+  while (block != NULL) {
+    JNIHandleBlock* prev = Atomic::cmpxchg(block->_next, &_block_free_list, block);
+    if (prev == block) {
+      break;
+    }
+    block = prev;
+  }
+  return block;
+}
+
+void JNIHandleBlock::prepend_free_list(JNIHandleBlock* first, JNIHandleBlock* last) {
+  JNIHandleBlock* cur = _block_free_list;
+  while (true) {
+    last->_next = cur;
+    JNIHandleBlock* prev = Atomic::cmpxchg(first, &_block_free_list, cur);
+    if (prev == cur) {
+      break;
+    }
+    cur = prev;
+  }
+}
+
 JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread)  {
   assert(thread == NULL || thread == Thread::current(), "sanity check");
   JNIHandleBlock* block;
@@ -371,7 +398,7 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread)  {
   // have to acquire a mutex.
   if (thread != NULL && thread->free_handle_block() != NULL) {
     block = thread->free_handle_block();
-    thread->set_free_handle_block(block->_next);
+    thread->set_free_handle_block(block->_next, thread->free_handle_block_count() - 1);
   }
   else {
     // locking with safepoint checking introduces a potential deadlock:
@@ -380,7 +407,8 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread)  {
     //   JNIHandleBlockFreeList_lock (JNIHandleBlock::allocate_block)
     MutexLocker ml(JNIHandleBlockFreeList_lock,
                    Mutex::_no_safepoint_check_flag);
-    if (_block_free_list == NULL) {
+    block = pop_free_list();
+    if (block == NULL) {
       // Allocate new block
       block = new JNIHandleBlock();
       _blocks_allocated++;
@@ -390,10 +418,18 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread)  {
       block->_block_list_link = _block_list;
       _block_list = block;
       #endif
-    } else {
-      // Get block from free list
-      block = _block_free_list;
-      _block_free_list = _block_free_list->_next;
+    } else if (thread != NULL) {
+      // Refill the thread-local free list too, so that a thread
+      // allocating many blocks only takes the lock every few blocks.
+      JNIHandleBlock* freelist = NULL;
+      int count = 0;
+      JNIHandleBlock* extra;
+      while (count < free_list_refill_count - 1 && (extra = pop_free_list()) != NULL) {
+        extra->_next = freelist;
+        freelist = extra;
+        count++;
+      }
+      thread->set_free_handle_block(freelist, count);
     }
   }
   block->_top = 0;
@@ -411,38 +447,40 @@ JNIHandleBlock* JNIHandleBlock::allocate_block(Thread* thread)  {
 void JNIHandleBlock::release_block(JNIHandleBlock* block, Thread* thread) {
   assert(thread == NULL || thread == Thread::current(), "sanity check");
   JNIHandleBlock* pop_frame_link = block->pop_frame_link();
-  // Put returned block at the beginning of the thread-local free list.
+  // Put returned blocks at the beginning of the thread-local free list,
+  // up to its limit. A thread calling into Java from a native loop over
+  // and over reuses the same few blocks without any synchronization.
   // Note that if thread == NULL, we use it as an implicit argument that
   // we _don't_ want the block to be kept on the free_handle_block.
   // See for instance JavaThread::exit().
-  if (thread != NULL ) {
-    block->zap();
+  if (thread != NULL) {
     JNIHandleBlock* freelist = thread->free_handle_block();
-    block->_pop_frame_link = NULL;
-    thread->set_free_handle_block(block);
-
-    // Add original freelist to end of chain
-    if ( freelist != NULL ) {
-      while ( block->_next != NULL ) block = block->_next;
+    int count = thread->free_handle_block_count();
+    while (block != NULL && count < thread_free_list_limit) {
+      JNIHandleBlock* next = block->_next;
+      block->zap();
+      block->_pop_frame_link = NULL;
       block->_next = freelist;
+      freelist = block;
+      count++;
+      block = next;
     }
-    block = NULL;
+    thread->set_free_handle_block(freelist, count);
   }
   if (block != NULL) {
-    // Return blocks to free list
-    // locking with safepoint checking introduces a potential deadlock:
-    // - we would hold JNIHandleBlockFreeList_lock and then Threads_lock
-    // - another would hold Threads_lock (jni_AttachCurrentThread) and then
-    //   JNIHandleBlockFreeList_lock (JNIHandleBlock::allocate_block)
-    MutexLocker ml(JNIHandleBlockFreeList_lock,
-                   Mutex::_no_safepoint_check_flag);
-    while (block != NULL) {
+    // Return the remaining blocks to the global free list. Pushing
+    // doesn't need the lock, so threads exiting or releasing large
+    // chains don't contend with each other.
+    JNIHandleBlock* first = block;
+    while (true) {
       block->zap();
-      JNIHandleBlock* next = block->_next;
-      block->_next = _block_free_list;
-      _block_free_list = block;
-      block = next;
+      block->_pop_frame_link = NULL;
+      if (block->_next == NULL) {
+        break;
+      }
+      block = block->_next;
     }
+    prepend_free_list(first, block);
   }
   if (pop_frame_link != NULL) {
     // As a sanity check we release blocks pointed to by the pop_frame_link.
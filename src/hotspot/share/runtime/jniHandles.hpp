@@ -136,7 +136,9 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
 
  private:
   enum SomeConstants {
-    block_size_in_oops  = 32                    // Number of handles per handle block
+    block_size_in_oops  = 32,                   // Number of handles per handle block
+    thread_free_list_limit = 32,                // Max blocks on a thread local free list
+    free_list_refill_count = 8                  // Blocks taken from the global free list at a time
   };
 
   uintptr_t       _handles[block_size_in_oops]; // The handles
@@ -158,9 +160,16 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
   static JNIHandleBlock* _block_list;           // List of all allocated blocks (for debugging only)
   #endif
 
-  static JNIHandleBlock* _block_free_list;      // Free list of currently unused blocks
+  // Free list of currently unused blocks. Blocks are pushed without
+  // locking; they are only popped with JNIHandleBlockFreeList_lock held,
+  // which rules out ABA since a block can't leave and re-enter the list
+  // while a pop is in progress.
+  static JNIHandleBlock* volatile _block_free_list;
   static int      _blocks_allocated;            // For debugging/printing
 
+  static JNIHandleBlock* pop_free_list();
+  static void prepend_free_list(JNIHandleBlock* first, JNIHandleBlock* last);
+
   // Fill block with bad_handle values
   void zap() NOT_DEBUG_RETURN;
 
@@ -29,6 +29,7 @@
 #include "runtime/osThread.hpp"
 #include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
 
@@ -99,18 +100,38 @@ void Mutex::lock_contended(Thread* self) {
   } while (!_lock.try_lock());
 }
 
+void Mutex::record_acquisition(jlong contended_start) {
+  _acquisitions++;
+  if (contended_start == 0) {
+    return;
+  }
+  jlong ticks = os::elapsed_counter() - contended_start;
+  _contentions++;
+  _contended_ticks += ticks;
+  jlong micros = (jlong)(TimeHelper::counter_to_millis(ticks) * 1000.0);
+  int bucket = micros < 1 ? 0 : log2_long(micros) + 1;
+  _contended_histogram[MIN2(bucket, (int)ContendedHistogramBuckets - 1)]++;
+}
+
 void Mutex::lock(Thread* self) {
   check_safepoint_state(self);
 
   assert(_owner != self, "invariant");
 
+  jlong contended_start = 0;
   if (!_lock.try_lock()) {
+    if (ProfileVMLocks) {
+      contended_start = os::elapsed_counter();
+    }
     // The lock is contended, use contended slow-path function to lock
     lock_contended(self);
   }
 
   assert_owner(NULL);
   set_owner(self);
+  if (ProfileVMLocks) {
+    record_acquisition(contended_start);
+  }
 }
 
 void Mutex::lock() {
@@ -126,9 +147,18 @@ void Mutex::lock() {
 void Mutex::lock_without_safepoint_check(Thread * self) {
   check_no_safepoint_state(self);
   assert(_owner != self, "invariant");
-  _lock.lock();
+  jlong contended_start = 0;
+  if (!ProfileVMLocks) {
+    _lock.lock();
+  } else if (!_lock.try_lock()) {
+    contended_start = os::elapsed_counter();
+    _lock.lock();
+  }
   assert_owner(NULL);
   set_owner(self);
+  if (ProfileVMLocks) {
+    record_acquisition(contended_start);
+  }
 }
 
 void Mutex::lock_without_safepoint_check() {
@@ -146,6 +176,9 @@ bool Mutex::try_lock() {
   if (_lock.try_lock()) {
     assert_owner(NULL);
     set_owner(self);
+    if (ProfileVMLocks) {
+      record_acquisition(0);
+    }
     return true;
   }
   return false;
@@ -274,6 +307,7 @@ bool is_sometimes_ok(const char* name) {
 Mutex::Mutex(int Rank, const char * name, bool allow_vm_block,
              SafepointCheckRequired safepoint_check_required) : _owner(NULL) {
   assert(os::mutex_init_done(), "Too early!");
+  reset_stats();
   if (name == NULL) {
     strcpy(_name, "UNKNOWN");
   } else {
@@ -309,6 +343,44 @@ void Mutex::print_on_error(outputStream* st) const {
   st->print(" - owner thread: " PTR_FORMAT, p2i(_owner));
 }
 
+void Mutex::reset_stats() {
+  _acquisitions = 0;
+  _contentions = 0;
+  _contended_ticks = 0;
+  for (int i = 0; i < ContendedHistogramBuckets; i++) {
+    _contended_histogram[i] = 0;
+  }
+}
+
+void Mutex::print_stats_on(outputStream* st) const {
+  // The counters may be updated concurrently, so read them once.
+  uint64_t acquisitions = _acquisitions;
+  if (acquisitions == 0) {
+    return;
+  }
+  uint64_t contentions = _contentions;
+  st->print("%-28s acquired: " UINT64_FORMAT_W(12) " contended: " UINT64_FORMAT_W(10) " (%5.1f%%)"
+            " total wait: %10.3fms",
+            _name, acquisitions, contentions,
+            contentions * 100.0 / acquisitions,
+            TimeHelper::counter_to_millis(_contended_ticks));
+  if (contentions > 0) {
+    st->print(" wait histogram:");
+    for (int i = 0; i < ContendedHistogramBuckets; i++) {
+      uint64_t count = _contended_histogram[i];
+      if (count == 0) {
+        continue;
+      }
+      if (i == ContendedHistogramBuckets - 1) {
+        st->print(" >=" SIZE_FORMAT "us: " UINT64_FORMAT, (size_t)1 << (i - 1), count);
+      } else {
+        st->print(" <" SIZE_FORMAT "us: " UINT64_FORMAT, (size_t)1 << i, count);
+      }
+    }
+  }
+  st->cr();
+}
+
 // ----------------------------------------------------------------------------------
 // Non-product code
 
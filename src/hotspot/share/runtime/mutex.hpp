@@ -80,6 +80,19 @@ class Mutex : public CHeapObj<mtSynchronizer> {
   os::PlatformMonitor _lock;             // Native monitor implementation
   char _name[MUTEX_NAME_LEN];            // Name of mutex/monitor
 
+  // Acquisition and contention statistics, collected when ProfileVMLocks is
+  // enabled. They are only updated by the thread that has just acquired the
+  // lock, so plain increments suffice. The histogram counts contended
+  // acquisitions by wait time: bucket 0 is below 1us, bucket i below 2^i us,
+  // and the last bucket holds everything longer.
+  enum { ContendedHistogramBuckets = 16 };
+  uint64_t _acquisitions;
+  uint64_t _contentions;
+  jlong    _contended_ticks;
+  uint64_t _contended_histogram[ContendedHistogramBuckets];
+
+  void record_acquisition(jlong contended_start);
+
   // Debugging fields for naming, deadlock detection, etc. (some only used in debug mode)
 #ifdef ASSERT
   bool    _allow_vm_block;
@@ -172,6 +185,10 @@ class Mutex : public CHeapObj<mtSynchronizer> {
 
   void print_on_error(outputStream* st) const;
 
+  // Prints the ProfileVMLocks statistics, if this lock has been acquired.
+  void print_stats_on(outputStream* st) const;
+  void reset_stats();
+
   #ifndef PRODUCT
     void print_on(outputStream* st) const;
     void print() const                      { print_on(::tty); }
@@ -108,6 +108,7 @@ Mutex*   RawMonitor_lock              = NULL;
 Mutex*   PerfDataMemAlloc_lock        = NULL;
 Mutex*   PerfDataManager_lock         = NULL;
 Mutex*   OopMapCacheAlloc_lock        = NULL;
+Mutex*   SharedCallSite_lock          = NULL;
 
 Mutex*   FreeList_lock                = NULL;
 Mutex*   OldSets_lock                 = NULL;
@@ -227,6 +228,7 @@ void mutex_init() {
   def(CodeCache_lock               , PaddedMonitor, special,     true,  _safepoint_check_never);
   def(RawMonitor_lock              , PaddedMutex  , special,     true,  _safepoint_check_never);
   def(OopMapCacheAlloc_lock        , PaddedMutex  , leaf,        true,  _safepoint_check_always); // used for oop_map_cache allocation.
+  def(SharedCallSite_lock          , PaddedMutex  , leaf,        true,  _safepoint_check_never);
 
   def(MetaspaceExpand_lock         , PaddedMutex  , leaf-1,      true,  _safepoint_check_never);
   def(ClassLoaderDataGraph_lock    , PaddedMutex  , nonleaf,     false, _safepoint_check_always);
@@ -371,3 +373,18 @@ void print_owned_locks_on_error(outputStream* st) {
   }
   if (none) st->print_cr("None");
 }
+
+// Print the ProfileVMLocks statistics of the global mutexes/monitors,
+// optionally resetting them afterwards.
+void print_lock_stats_on(outputStream* st, bool reset) {
+  if (!ProfileVMLocks) {
+    st->print_cr("Lock statistics are not collected, enable with -XX:+UnlockDiagnosticVMOptions -XX:+ProfileVMLocks");
+    return;
+  }
+  for (int i = 0; i < _num_mutex; i++) {
+    _mutex_array[i]->print_stats_on(st);
+    if (reset) {
+      _mutex_array[i]->reset_stats();
+    }
+  }
+}
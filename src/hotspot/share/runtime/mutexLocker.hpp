@@ -104,6 +104,7 @@ extern Mutex*   RawMonitor_lock;
 extern Mutex*   PerfDataMemAlloc_lock;           // a lock on the allocator for PerfData memory for performance data
 extern Mutex*   PerfDataManager_lock;            // a long on access to PerfDataManager resources
 extern Mutex*   OopMapCacheAlloc_lock;           // protects allocation of oop_map caches
+extern Mutex*   SharedCallSite_lock;             // protects the table of shared invokedynamic call site targets
 
 extern Mutex*   FreeList_lock;                   // protects the free region list during safepoints
 extern Mutex*   OldSets_lock;                    // protects the old region sets
@@ -170,6 +171,7 @@ extern Mutex* tty_lock;                          // lock to synchronize output.
 // Print all mutexes/monitors that are currently owned by a thread; called
 // by fatal error handler.
 void print_owned_locks_on_error(outputStream* st);
+void print_lock_stats_on(outputStream* st, bool reset);
 
 char *lock_name(Mutex *mutex);
 
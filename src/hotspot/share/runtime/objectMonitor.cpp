@@ -109,6 +109,7 @@ static int Knob_Penalty             = 200;     // spin failure penalty
 static int Knob_Poverty             = 1000;
 static int Knob_FixedSpin           = 0;
 static int Knob_PreSpin             = 10;      // 20-100 likely better
+static int Knob_MaxSpinners         = -1;      // set by Initialize()
 
 DEBUG_ONLY(static volatile bool InitDone = false;)
 
@@ -238,7 +239,7 @@ void ObjectMonitor::operator delete[] (void *p) {
 // -----------------------------------------------------------------------------
 // Enter support
 
-void ObjectMonitor::enter(TRAPS) {
+bool ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD;
@@ -246,13 +247,13 @@ void ObjectMonitor::enter(TRAPS) {
   void * cur = Atomic::cmpxchg(Self, &_owner, (void*)NULL);
   if (cur == NULL) {
     assert(_recursions == 0, "invariant");
-    return;
+    return true;
   }
 
   if (cur == Self) {
     // TODO-FIXME: check for integer overflow!  BUGID 6557169.
     _recursions++;
-    return;
+    return true;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -261,13 +262,33 @@ void ObjectMonitor::enter(TRAPS) {
     // Commute owner from a thread-specific on-stack BasicLockObject address to
     // a full-fledged "Thread *".
     _owner = Self;
-    return;
+    return true;
   }
 
   // We've encountered genuine contention.
   assert(Self->_Stalled == 0, "invariant");
   Self->_Stalled = intptr_t(this);
 
+  // Prevent deflation at STW-time and by the deflater thread.  See
+  // deflate_idle_monitors(), deflate_monitor_using_JT() and is_busy().
+  // Ensure the object-monitor relationship remains stable while there's
+  // contention. This is done before spinning because TryLock() relies on
+  // the caller having made the monitor busy.
+  Atomic::inc(&_contentions);
+
+  if (is_being_async_deflated()) {
+    // The deflater thread has won the race and this ObjectMonitor is
+    // no longer associated with the object. Help restore the object's
+    // header so the caller's retry does not find this monitor again.
+    const oop obj = (oop) object();
+    if (obj != NULL) {
+      install_displaced_markword_in_object(obj);
+    }
+    Atomic::dec(&_contentions);
+    Self->_Stalled = 0;
+    return false;
+  }
+
   // Try one round of spinning *before* enqueueing Self
   // and before going through the awkward and expensive state
   // transitions.  The following spin is strictly optional ...
@@ -281,8 +302,9 @@ void ObjectMonitor::enter(TRAPS) {
            "object mark must match encoded this: mark=" INTPTR_FORMAT
            ", encoded this=" INTPTR_FORMAT, ((oop)object())->mark().value(),
            markWord::encode(this).value());
+    Atomic::dec(&_contentions);
     Self->_Stalled = 0;
-    return;
+    return true;
   }
 
   assert(_owner != Self, "invariant");
@@ -292,17 +314,15 @@ void ObjectMonitor::enter(TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(jt->thread_state() != _thread_blocked, "invariant");
   assert(this->object() != NULL, "invariant");
-  assert(_contentions >= 0, "invariant");
-
-  // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
-  // Ensure the object-monitor relationship remains stable while there's contention.
-  Atomic::inc(&_contentions);
+  assert(_contentions > 0, "invariant");
 
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(jt);)
   EventJavaMonitorEnter event;
   if (event.should_commit()) {
     event.set_monitorClass(((oop)this->object())->klass());
     event.set_address((uintptr_t)(this->object_addr()));
+    // Sampled before this thread blocks; includes this thread.
+    event.set_contenders(_contentions);
   }
 
   { // Change java thread status to indicate blocked on monitor enter.
@@ -394,13 +414,31 @@ void ObjectMonitor::enter(TRAPS) {
     event.commit();
   }
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
+  return true;
 }
 
 // Caveat: TryLock() is not necessarily serializing if it returns failure.
 // Callers must compensate as needed.
+//
+// All callers have made the monitor busy, either via _contentions in
+// enter() or via _waiters in wait(), so an async deflation that has set
+// _owner to DEFLATER_MARKER cannot complete and may be cancelled here.
 
 int ObjectMonitor::TryLock(Thread * Self) {
   void * own = _owner;
+  if (own == DEFLATER_MARKER) {
+    assert(AsyncDeflateIdleMonitors, "sanity check");
+    if (Atomic::cmpxchg(Self, &_owner, DEFLATER_MARKER) == DEFLATER_MARKER) {
+      // Cancelled the in-progress async deflation by changing owner from
+      // DEFLATER_MARKER to Self. The extra increment keeps _contentions
+      // positive after our caller's regular decrement; the deflater thread
+      // does the matching decrement once it notices the cancellation.
+      Atomic::inc(&_contentions);
+      assert(_recursions == 0, "invariant");
+      return 1;
+    }
+    return -1;
+  }
   if (own != NULL) return 0;
   if (Atomic::replace_if_null(Self, &_owner)) {
     assert(_recursions == 0, "invariant");
@@ -953,8 +991,16 @@ void ObjectMonitor::exit(bool not_suspended, TRAPS) {
     // to reacquire the lock the responsibility for ensuring succession
     // falls to the new owner.
     //
-    if (!Atomic::replace_if_null(THREAD, &_owner)) {
-      return;
+    void* cur;
+    while ((cur = Atomic::cmpxchg(THREAD, &_owner, (void*)NULL)) != NULL) {
+      if (cur != DEFLATER_MARKER) {
+        return;
+      }
+      // An async deflation has claimed the NULL owner. It is bound to
+      // back off because _cxq or _EntryList is non-empty, and it will
+      // either restore a NULL owner or a queued thread will take over;
+      // we must not leave the queued threads stranded in the meantime.
+      SpinPause();
     }
 
     guarantee(_owner == THREAD, "invariant");
@@ -1131,16 +1177,51 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->is_Java_thread(), "Must be Java thread!");
   JavaThread *jt = (JavaThread *)THREAD;
 
   guarantee(_owner != Self, "reenter already owner");
-  enter(THREAD);       // enter the monitor
+  if (!enter(THREAD)) {
+    // Lost the race to an async deflation; the caller must retry.
+    return false;
+  }
   guarantee(_recursions == 0, "reenter recursion");
   _recursions = recursions;
-  return;
+  return true;
+}
+
+// Install the displaced mark word (dmw) of a deflating ObjectMonitor
+// into the header of the object associated with the monitor. This
+// idempotent method is called by a thread that is deflating a
+// monitor and by other threads that have detected a race with the
+// deflation process.
+void ObjectMonitor::install_displaced_markword_in_object(const oop obj) {
+  assert(obj != NULL, "must be non-NULL");
+  assert(is_being_async_deflated(), "must be async deflated");
+
+  // Marking the dmw freezes it: the hash code merge in FastHashCode()
+  // expects an unmarked dmw, so a hash code that made it into the dmw
+  // before this point is preserved in the restored object header and
+  // later merge attempts fail and retry against the object.
+  markWord dmw = header();
+  while (!dmw.is_marked()) {
+    markWord res = markWord(Atomic::cmpxchg(dmw.set_marked().value(),
+                                            (volatile uintptr_t*)header_addr(),
+                                            dmw.value()));
+    if (res == dmw) {
+      dmw = dmw.set_marked();
+      break;
+    }
+    dmw = res;
+  }
+  assert(dmw.is_marked(), "must be marked: dmw=" INTPTR_FORMAT, dmw.value());
+
+  // It does not matter which thread restores the dmw into the object's
+  // header: the object's header only refers to this monitor until the
+  // first restore and every thread restores the same value.
+  obj->cas_set_mark(dmw.set_unmarked(), markWord::encode(this));
 }
 
 // Checks that the current THREAD owns this monitor and causes an
@@ -1370,7 +1451,9 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
     assert(_owner != Self, "invariant");
     ObjectWaiter::TStates v = node.TState;
     if (v == ObjectWaiter::TS_RUN) {
-      enter(Self);
+      // _waiters is still non-zero so an async deflation cannot win the
+      // race and enter() cannot fail.
+      guarantee(enter(Self), "must not be async deflated while waiting");
     } else {
       guarantee(v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant");
       ReenterI(Self, &node);
@@ -1626,6 +1709,16 @@ int ObjectMonitor::TrySpin(Thread * Self) {
     return 0;
   }
 
+  // Limit the number of threads spinning on this monitor at once.  Only
+  // one of them can take the lock when it is released, so once there are
+  // more spinners than can usefully run the rest just burn cycles that
+  // the owner may need.  Excess contenders go straight to the queue and
+  // park.  No penalty is applied since the spin was never attempted.
+  if (Atomic::add(1, &_Spinner) > Knob_MaxSpinners) {
+    Atomic::dec(&_Spinner);
+    return 0;
+  }
+
   // We're good to spin ... spin ingress.
   // CONSIDER: use Prefetch::write() to avoid RTS->RTO upgrades
   // when preparing to LD...CAS _owner, etc and the CAS is likely
@@ -1677,6 +1770,7 @@ int ObjectMonitor::TrySpin(Thread * Self) {
         if (_succ == Self) {
           _succ = NULL;
         }
+        Atomic::dec(&_Spinner);
 
         // Increase _SpinDuration :
         // The spin was successful (profitable) so we tend toward
@@ -1721,20 +1815,22 @@ int ObjectMonitor::TrySpin(Thread * Self) {
   }
 
   // Spin failed with prejudice -- reduce _SpinDuration.
-  // TODO: Use an AIMD-like policy to adjust _SpinDuration.
-  // AIMD is globally stable.
+  // Use an AIMD policy: success adds a fixed bonus above, failure takes
+  // off a fixed penalty plus a fraction of the current duration.  A
+  // monitor whose owner holds it longer than a full spin thus backs off
+  // quickly, while one with short hold times keeps its budget.
+  // AIMD is globally stable and tends to damp the response.
   {
     int x = _SpinDuration;
     if (x > 0) {
-      // Consider an AIMD scheme like: x -= (x >> 3) + 100
-      // This is globally sample and tends to damp the response.
-      x -= Knob_Penalty;
+      x -= (x >> 3) + Knob_Penalty;
       if (x < 0) x = 0;
       _SpinDuration = x;
     }
   }
 
  Abort:
+  Atomic::dec(&_Spinner);
   if (_succ == Self) {
     _succ = NULL;
     // Invariant: after setting succ=null a contending thread
@@ -1908,6 +2004,10 @@ void ObjectMonitor::Initialize() {
     Knob_FixedSpin = -1;
   }
 
+  // Spinning only pays off while spinners and the owner are all on a
+  // CPU, so allow at most half of the processors to spin per monitor.
+  Knob_MaxSpinners = MAX2(1, os::processor_count() / 2);
+
   if (UsePerfData) {
     EXCEPTION_MARK;
 #define NEWPERFCOUNTER(n)                                                \
@@ -120,6 +120,11 @@ class ObjectWaiter : public StackObj {
 //     intptr_t. There's no reason to use a 64-bit type for this field
 //     in a 64-bit JVM.
 
+// When AsyncDeflateIdleMonitors is enabled, the _owner field is set to
+// DEFLATER_MARKER by the deflater thread to claim an idle ObjectMonitor.
+// See ObjectSynchronizer::deflate_monitor_using_JT().
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
 class ObjectMonitor {
   friend class ObjectSynchronizer;
   friend class ObjectWaiter;
@@ -153,12 +158,14 @@ class ObjectMonitor {
   Thread* volatile _succ;           // Heir presumptive thread - used for futile wakeup throttling
   Thread* volatile _Responsible;
 
-  volatile int _Spinner;            // for exit->spinner handoff optimization
+  volatile int _Spinner;            // number of threads in the adaptive phase of TrySpin()
   volatile int _SpinDuration;
 
   volatile jint  _contentions;      // Number of active contentions in enter(). It is used by is_busy()
                                     // along with other fields to determine if an ObjectMonitor can be
-                                    // deflated. See ObjectSynchronizer::deflate_monitor().
+                                    // deflated. It is made negative when an async deflation has won
+                                    // the race. See ObjectSynchronizer::deflate_monitor() and
+                                    // ObjectSynchronizer::deflate_monitor_using_JT().
  protected:
   ObjectWaiter* volatile _WaitSet;  // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
@@ -225,7 +232,20 @@ class ObjectMonitor {
 
   intptr_t is_busy() const {
     // TODO-FIXME: assert _owner == null implies _recursions = 0
-    return _contentions|_waiters|intptr_t(_owner)|intptr_t(_cxq)|intptr_t(_EntryList);
+    intptr_t ret_code = _waiters | intptr_t(_cxq) | intptr_t(_EntryList);
+    if (!AsyncDeflateIdleMonitors) {
+      ret_code |= _contentions | intptr_t(_owner);
+    } else {
+      // A negative _contentions value and a DEFLATER_MARKER owner are
+      // left behind by the async deflation protocol and do not count.
+      if (_contentions > 0) {
+        ret_code |= _contentions;
+      }
+      if (_owner != DEFLATER_MARKER) {
+        ret_code |= intptr_t(_owner);
+      }
+    }
+    return ret_code;
   }
   const char* is_busy_to_string(stringStream* ss);
 
@@ -237,6 +257,9 @@ class ObjectMonitor {
   jint      waiters() const;
 
   jint      contentions() const;
+  // Returns true if an async deflation has won the race to deflate
+  // this ObjectMonitor. Callers must retry their operation.
+  bool      is_being_async_deflated();
   intptr_t  recursions() const                                         { return _recursions; }
 
   // JVM/TI GetObjectMonitorUsage() needs this:
@@ -281,8 +304,11 @@ class ObjectMonitor {
   // returns false and throws IllegalMonitorStateException (IMSE).
   bool      check_owner(Thread* THREAD);
   void      clear();
+  void      clear_using_JT();
 
-  void      enter(TRAPS);
+  // Returns false if an async deflation won the race and the caller
+  // has to inflate the object again and retry.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -293,7 +319,11 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
+
+  // Restore the displaced header of an async deflated ObjectMonitor
+  // into the object's header, unless another thread already did so.
+  void      install_displaced_markword_in_object(const oop obj);
 
  private:
   void      AddWaiter(ObjectWaiter* waiter);
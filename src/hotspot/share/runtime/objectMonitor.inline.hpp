@@ -51,8 +51,10 @@ inline jint ObjectMonitor::waiters() const {
   return _waiters;
 }
 
+// Returns NULL if DEFLATER_MARKER is observed.
 inline void* ObjectMonitor::owner() const {
-  return _owner;
+  void* owner = _owner;
+  return owner != DEFLATER_MARKER ? owner : NULL;
 }
 
 inline void ObjectMonitor::clear() {
@@ -67,6 +69,21 @@ inline void ObjectMonitor::clear() {
   _object = NULL;
 }
 
+// Clear the fields left behind by a successful async deflation so that
+// the ObjectMonitor can be put back on a free list.
+inline void ObjectMonitor::clear_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  assert(_owner == DEFLATER_MARKER, "must be DEFLATER_MARKER: owner=" INTPTR_FORMAT, p2i(_owner));
+  assert(_contentions < 0, "must be negative: contentions=%d", _contentions);
+  assert(_waiters == 0, "must be 0: waiters=%d", _waiters);
+  assert(_recursions == 0, "must be 0: recursions=" INTPTR_FORMAT, _recursions);
+  assert(_object == NULL, "must be NULL: object=" INTPTR_FORMAT, p2i(_object));
+
+  Atomic::store(markWord::zero(), &_header);
+  _owner = NULL;
+  _contentions = 0;
+}
+
 inline void* ObjectMonitor::object() const {
   return _object;
 }
@@ -84,6 +101,10 @@ inline jint ObjectMonitor::contentions() const {
   return _contentions;
 }
 
+inline bool ObjectMonitor::is_being_async_deflated() {
+  return AsyncDeflateIdleMonitors && _contentions < 0;
+}
+
 inline void ObjectMonitor::set_owner(void* owner) {
   _owner = owner;
 }
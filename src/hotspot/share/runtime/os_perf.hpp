@@ -277,4 +277,55 @@ class NetworkPerformanceInterface : public CHeapObj<mtInternal> {
   int network_utilization(NetworkInterface** network_interfaces) const;
 };
 
+// Hardware performance counter values of a single thread. Counters
+// that the platform cannot provide read as zero.
+class HardwareCounterValues {
+ private:
+  uint64_t _cycles;
+  uint64_t _instructions;
+  uint64_t _llc_misses;
+  uint64_t _dtlb_misses;
+ public:
+  HardwareCounterValues() :
+    _cycles(0),
+    _instructions(0),
+    _llc_misses(0),
+    _dtlb_misses(0) {}
+
+  uint64_t cycles() const       { return _cycles; }
+  uint64_t instructions() const { return _instructions; }
+  uint64_t llc_misses() const   { return _llc_misses; }
+  uint64_t dtlb_misses() const  { return _dtlb_misses; }
+
+  void set_cycles(uint64_t value)       { _cycles = value; }
+  void set_instructions(uint64_t value) { _instructions = value; }
+  void set_llc_misses(uint64_t value)   { _llc_misses = value; }
+  void set_dtlb_misses(uint64_t value)  { _dtlb_misses = value; }
+
+  // Difference to an earlier reading of the same thread.
+  HardwareCounterValues since(const HardwareCounterValues& start) const {
+    HardwareCounterValues result;
+    result._cycles       = _cycles       - start._cycles;
+    result._instructions = _instructions - start._instructions;
+    result._llc_misses   = _llc_misses   - start._llc_misses;
+    result._dtlb_misses  = _dtlb_misses  - start._dtlb_misses;
+    return result;
+  }
+};
+
+// Per-thread hardware performance counters. The counters are opened for,
+// and must only be read by, the thread that called initialize().
+class HardwareCounterInterface : public CHeapObj<mtInternal> {
+ private:
+  class HardwareCounters;
+  HardwareCounters* _impl;
+  HardwareCounterInterface(const HardwareCounterInterface& rhs); // no impl
+  HardwareCounterInterface& operator=(const HardwareCounterInterface& rhs); // no impl
+ public:
+  HardwareCounterInterface();
+  bool initialize();
+  ~HardwareCounterInterface();
+  int read_counters(HardwareCounterValues* values) const;
+};
+
 #endif // SHARE_RUNTIME_OS_PERF_HPP
@@ -37,6 +37,7 @@
 #include "runtime/safepoint.hpp"
 #include "runtime/statSampler.hpp"
 #include "utilities/align.hpp"
+#include "utilities/copy.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 // Prefix of performance data file.
@@ -54,6 +55,7 @@ size_t                   PerfMemory::_capacity = 0;
 int                      PerfMemory::_initialized = false;
 PerfDataPrologue*        PerfMemory::_prologue = NULL;
 bool                     PerfMemory::_destroyed = false;
+char*                    PerfMemory::_shared_copy = NULL;
 
 void perfMemory_init() {
 
@@ -159,6 +161,16 @@ void PerfMemory::initialize() {
   OrderAccess::release_store(&_initialized, 1);
 }
 
+void PerfMemory::publish() {
+
+  if (_shared_copy == NULL || !is_usable()) return;
+
+  // Counters are updated concurrently, so copy in jlong units to avoid
+  // publishing torn values. Readers already tolerate a changing region.
+  size_t count = align_up(used(), BytesPerLong) / BytesPerLong;
+  Copy::conjoint_jlongs_atomic((jlong*)_start, (jlong*)_shared_copy, count);
+}
+
 void PerfMemory::destroy() {
 
   if (!is_usable()) return;
@@ -124,6 +124,10 @@ class PerfMemory : AllStatic {
     static int    _initialized;
     static bool   _destroyed;
 
+    // The shared memory file when PerfPublishSharedMem keeps the
+    // counters in standard memory, otherwise NULL.
+    static char*  _shared_copy;
+
     static void create_memory_region(size_t sizep);
     static void delete_memory_region();
 
@@ -146,6 +150,10 @@ class PerfMemory : AllStatic {
     }
     static void mark_updated();
 
+    // copy the counters into the shared memory file, if they are kept
+    // apart from it (see PerfPublishSharedMem)
+    static void publish();
+
     // methods for attaching to and detaching from the PerfData
     // memory segment of another JVM process on the same system.
     static void attach(const char* user, int vmid, PerfMemoryMode mode,
@@ -981,6 +981,32 @@ static methodHandle resolve_interface_call(InstanceKlass* klass,
   return info.selected_method();
 }
 
+// Selects the implementation of an interface method through the itable
+// of the receiver class, which is what an already linked invokeinterface
+// does. Link-time resolution was done by Class.getMethod(), so a full
+// resolve_interface_call on every reflective call is only needed to
+// produce the right error. Returns NULL whenever the selected method is
+// not a public concrete method, in which case the caller falls back to
+// resolve_interface_call.
+static Method* select_interface_method(const methodHandle& method,
+                                       Klass* recv_klass,
+                                       TRAPS) {
+  if (!method->has_itable_index() || !recv_klass->is_instance_klass()) {
+    return NULL;
+  }
+  Method* selected = InstanceKlass::cast(recv_klass)->method_at_itable(method->method_holder(),
+                                                                       method->itable_index(),
+                                                                       THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    CLEAR_PENDING_EXCEPTION;
+    return NULL;
+  }
+  if (selected == NULL || selected->is_abstract() || !selected->is_public()) {
+    return NULL;
+  }
+  return selected;
+}
+
 // Conversion
 static BasicType basic_type_mirror_to_basic_type(oop basic_type_mirror, TRAPS) {
   assert(java_lang_Class::is_primitive(basic_type_mirror),
@@ -1057,7 +1083,12 @@ static oop invoke(InstanceKlass* klass,
         //
         // Match resolution errors with those thrown due to reflection inlining
         // Linktime resolution & IllegalAccessCheck already done by Class.getMethod()
-        method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
+        Method* selected = select_interface_method(reflected_method, target_klass, CHECK_NULL);
+        if (selected != NULL) {
+          method = methodHandle(THREAD, selected);
+        } else {
+          method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
+        }
         if (HAS_PENDING_EXCEPTION) {
           // Method resolution threw an exception; wrap it in an InvocationTargetException
           oop resolution_exception = PENDING_EXCEPTION;
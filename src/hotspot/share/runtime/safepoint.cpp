@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/classLoaderDataGraph.inline.hpp"
 #include "classfile/dictionary.hpp"
+#include "classfile/packageEntry.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -41,6 +42,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -68,6 +70,7 @@
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/ticks.hpp"
 
 static void post_safepoint_begin_event(EventSafepointBegin& event,
                                        uint64_t safepoint_id,
@@ -245,6 +248,12 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
   int iterations = 1; // The first iteration is above.
   int64_t start_time = os::javaTimeNanos();
 
+  jlong stall_sample_time = max_jlong;
+  if (SafepointStallSampleDelay > 0) {
+    stall_sample_time = SafepointTracing::start_of_safepoint() +
+                        (jlong)SafepointStallSampleDelay * (NANOUNITS / MILLIUNITS);
+  }
+
   do {
     // Check if this has taken too long:
     if (SafepointTimeout && safepoint_limit_time < os::javaTimeNanos()) {
@@ -278,6 +287,11 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
     DEBUG_ONLY(assert_list_is_valid(tss_head, still_running);)
 
     if (still_running > 0) {
+      if (stall_sample_time < os::javaTimeNanos()) {
+        // Sample each safepoint only once.
+        stall_sample_time = max_jlong;
+        sample_stalled_threads(tss_head);
+      }
       back_off(start_time);
     }
 
@@ -529,6 +543,9 @@ bool SafepointSynchronize::is_cleanup_needed() {
   if (!InlineCacheBuffer::is_empty()) return true;
   if (StringTable::needs_rehashing()) return true;
   if (SymbolTable::needs_rehashing()) return true;
+  // Need a safepoint to grow dictionaries whose hash chains got too long.
+  if (Dictionary::does_any_dictionary_needs_resizing()) return true;
+  if (PackageEntryTable::does_any_table_need_resizing()) return true;
   return false;
 }
 
@@ -552,102 +569,228 @@ public:
   }
 };
 
-class ParallelSPCleanupTask : public AbstractGangTask {
+// Counts the threads a single worker processes in the shared per-thread pass.
+class CountingSPCleanupThreadClosure : public ThreadClosure {
 private:
-  SubTasksDone _subtasks;
-  ParallelSPCleanupThreadClosure _cleanup_threads_cl;
-  uint _num_workers;
-  DeflateMonitorCounters* _counters;
+  ThreadClosure* _cl;
+  uint _count;
+
 public:
-  ParallelSPCleanupTask(uint num_workers, DeflateMonitorCounters* counters) :
-    AbstractGangTask("Parallel Safepoint Cleanup"),
-    _subtasks(SubTasksDone(SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS)),
-    _cleanup_threads_cl(ParallelSPCleanupThreadClosure(counters)),
-    _num_workers(num_workers),
-    _counters(counters) {}
+  CountingSPCleanupThreadClosure(ThreadClosure* cl) : _cl(cl), _count(0) {}
 
-  void work(uint worker_id) {
-    uint64_t safepoint_id = SafepointSynchronize::safepoint_id();
-    // All threads deflate monitors and mark nmethods (if necessary).
-    Threads::possibly_parallel_threads_do(true, &_cleanup_threads_cl);
+  void do_thread(Thread* thread) {
+    _cl->do_thread(thread);
+    _count++;
+  }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
-      const char* name = "deflating global idle monitors";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-      ObjectSynchronizer::deflate_idle_monitors(_counters);
+  uint count() const { return _count; }
+};
 
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
-    }
+// Per-worker, per-subtask times of the safepoint cleanup phase, reported
+// with -Xlog:safepoint+cleanup=debug. Each worker only writes its own row,
+// and the VM thread reads the table after the work gang has finished.
+class SafepointCleanupWorkerTimes : public StackObj {
+public:
+  // The per-thread pass shared by all workers is recorded after the subtasks.
+  static const uint PER_THREAD_PASS = SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS;
+  static const uint NUM_PHASES = PER_THREAD_PASS + 1;
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES)) {
-      const char* name = "updating inline caches";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-      InlineCacheBuffer::update_inline_caches();
+private:
+  uint _num_workers;
+  double* _secs;          // _num_workers * NUM_PHASES, negative if not run
+  uint* _thread_counts;   // _num_workers
+  const char* _names[NUM_PHASES];
 
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
+public:
+  SafepointCleanupWorkerTimes(uint num_workers) :
+    _num_workers(num_workers), _secs(NULL), _thread_counts(NULL) {
+    if (log_is_enabled(Debug, safepoint, cleanup)) {
+      _secs = NEW_RESOURCE_ARRAY(double, num_workers * NUM_PHASES);
+      _thread_counts = NEW_RESOURCE_ARRAY(uint, num_workers);
+      for (uint i = 0; i < num_workers * NUM_PHASES; i++) {
+        _secs[i] = -1.0;
+      }
+      for (uint i = 0; i < num_workers; i++) {
+        _thread_counts[i] = 0;
+      }
+    }
+    for (uint i = 0; i < NUM_PHASES; i++) {
+      _names[i] = NULL;
     }
+  }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY)) {
-      const char* name = "compilation policy safepoint handler";
-      EventSafepointCleanupTask event;
-      TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-      CompilationPolicy::policy()->do_safepoint_work();
+  bool is_enabled() const { return _secs != NULL; }
 
-      post_safepoint_cleanup_task_event(event, safepoint_id, name);
+  void record(uint worker_id, uint phase, const char* name, double secs) {
+    assert(worker_id < _num_workers && phase < NUM_PHASES, "out of bounds");
+    if (is_enabled()) {
+      _secs[worker_id * NUM_PHASES + phase] = secs;
+      _names[phase] = name;
     }
+  }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH)) {
-      if (SymbolTable::needs_rehashing()) {
-        const char* name = "rehashing symbol table";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-        SymbolTable::rehash_table();
+  void record_thread_count(uint worker_id, uint count) {
+    assert(worker_id < _num_workers, "out of bounds");
+    if (is_enabled()) {
+      _thread_counts[worker_id] = count;
+    }
+  }
 
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
+  void print() const {
+    if (!is_enabled()) {
+      return;
+    }
+    LogStreamHandle(Debug, safepoint, cleanup) ls;
+    for (uint w = 0; w < _num_workers; w++) {
+      ls.print("worker %u:", w);
+      double secs = _secs[w * NUM_PHASES + PER_THREAD_PASS];
+      if (secs >= 0.0) {
+        ls.print(" %s %3.7f secs (%u threads)", _names[PER_THREAD_PASS], secs, _thread_counts[w]);
+      }
+      for (uint phase = 0; phase < PER_THREAD_PASS; phase++) {
+        secs = _secs[w * NUM_PHASES + phase];
+        if (secs >= 0.0) {
+          ls.print(", %s %3.7f secs", _names[phase], secs);
+        }
       }
+      ls.cr();
     }
+  }
+};
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH)) {
-      if (StringTable::needs_rehashing()) {
-        const char* name = "rehashing string table";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-        StringTable::rehash_table();
+class ParallelSPCleanupTask : public AbstractGangTask {
+private:
+  SubTasksDone _subtasks;
+  ParallelSPCleanupThreadClosure _cleanup_threads_cl;
+  uint _num_workers;
+  DeflateMonitorCounters* _counters;
+  SafepointCleanupWorkerTimes* _times;
+
+  // Runs a claimed subtask. Returns the name of the subtask if it had
+  // work to do, NULL otherwise.
+  const char* run_subtask(uint task) {
+    switch (task) {
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_DEFLATE_MONITORS:
+        if (!AsyncDeflateIdleMonitors) {
+          ObjectSynchronizer::deflate_idle_monitors(_counters);
+          return "deflating global idle monitors";
+        }
+        return NULL;
 
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
-      }
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES:
+        InlineCacheBuffer::update_inline_caches();
+        return "updating inline caches";
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_COMPILATION_POLICY:
+        CompilationPolicy::policy()->do_safepoint_work();
+        return "compilation policy safepoint handler";
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH:
+        if (SymbolTable::needs_rehashing()) {
+          SymbolTable::rehash_table();
+          return "rehashing symbol table";
+        }
+        return NULL;
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_STRING_TABLE_REHASH:
+        if (StringTable::needs_rehashing()) {
+          StringTable::rehash_table();
+          return "rehashing string table";
+        }
+        return NULL;
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE:
+        if (ClassLoaderDataGraph::should_purge_and_reset()) {
+          // CMS delays purging the CLDG until the beginning of the next safepoint and to
+          // make sure concurrent sweep is done
+          ClassLoaderDataGraph::purge();
+          return "purging class loader data graph";
+        }
+        return NULL;
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE:
+        {
+          bool resize_dictionaries = Dictionary::does_any_dictionary_needs_resizing();
+          bool resize_packages = PackageEntryTable::does_any_table_need_resizing();
+          if (resize_dictionaries) {
+            ClassLoaderDataGraph::resize_dictionaries();
+          }
+          if (resize_packages) {
+            ClassLoaderDataGraph::resize_package_tables();
+          }
+          if (resize_dictionaries || resize_packages) {
+            return "resizing system dictionaries";
+          }
+        }
+        return NULL;
+
+      case SafepointSynchronize::SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP:
+        // Don't bother reporting event or time for this very short operation.
+        // To have any utility we'd also want to report whether needed.
+        OopStorage::trigger_cleanup_if_needed();
+        return NULL;
+
+      default:
+        ShouldNotReachHere();
+        return NULL;
     }
+  }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_CLD_PURGE)) {
-      if (ClassLoaderDataGraph::should_purge_and_reset()) {
-        // CMS delays purging the CLDG until the beginning of the next safepoint and to
-        // make sure concurrent sweep is done
-        const char* name = "purging class loader data graph";
+  // Claims the first unclaimed subtask and runs it. Returns false if
+  // all subtasks have already been claimed.
+  bool claim_and_run_subtask(uint worker_id, uint64_t safepoint_id) {
+    for (uint task = 0; task < SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS; task++) {
+      if (_subtasks.try_claim_task(task)) {
         EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-        ClassLoaderDataGraph::purge();
-
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
+        Ticks start = Ticks::now();
+        const char* name = run_subtask(task);
+        if (name != NULL) {
+          double secs = (Ticks::now() - start).seconds();
+          log_info(safepoint, cleanup)("%s, %3.7f secs", name, secs);
+          _times->record(worker_id, task, name, secs);
+          post_safepoint_cleanup_task_event(event, safepoint_id, name);
+        }
+        return true;
       }
     }
+    return false;
+  }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYSTEM_DICTIONARY_RESIZE)) {
-      if (Dictionary::does_any_dictionary_needs_resizing()) {
-        const char* name = "resizing system dictionaries";
-        EventSafepointCleanupTask event;
-        TraceTime timer(name, TRACETIME_LOG(Info, safepoint, cleanup));
-        ClassLoaderDataGraph::resize_dictionaries();
+public:
+  ParallelSPCleanupTask(uint num_workers, DeflateMonitorCounters* counters,
+                        SafepointCleanupWorkerTimes* times) :
+    AbstractGangTask("Parallel Safepoint Cleanup"),
+    _subtasks(SubTasksDone(SafepointSynchronize::SAFEPOINT_CLEANUP_NUM_TASKS)),
+    _cleanup_threads_cl(ParallelSPCleanupThreadClosure(counters)),
+    _num_workers(num_workers),
+    _counters(counters),
+    _times(times) {}
 
-        post_safepoint_cleanup_task_event(event, safepoint_id, name);
-      }
+  void work(uint worker_id) {
+    uint64_t safepoint_id = SafepointSynchronize::safepoint_id();
+
+    // Start with one of the single-threaded subtasks, if one is left, so
+    // that a long running subtask overlaps with the per-thread pass below
+    // rather than extending the tail of the cleanup phase.
+    claim_and_run_subtask(worker_id, safepoint_id);
+
+    // All threads deflate monitors and mark nmethods (if necessary).
+    // Threads are claimed one at a time, so workers that are done with
+    // their subtask pick up the remaining threads.
+    {
+      const char* name = "per-thread cleanup";
+      EventSafepointCleanupTask event;
+      Ticks start = Ticks::now();
+      CountingSPCleanupThreadClosure cl(&_cleanup_threads_cl);
+      Threads::possibly_parallel_threads_do(true, &cl);
+      _times->record(worker_id, SafepointCleanupWorkerTimes::PER_THREAD_PASS,
+                     name, (Ticks::now() - start).seconds());
+      _times->record_thread_count(worker_id, cl.count());
+      post_safepoint_cleanup_task_event(event, safepoint_id, name);
     }
 
-    if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_REQUEST_OOPSTORAGE_CLEANUP)) {
-      // Don't bother reporting event or time for this very short operation.
-      // To have any utility we'd also want to report whether needed.
-      OopStorage::trigger_cleanup_if_needed();
+    // Help with the subtasks that are left.
+    while (claim_and_run_subtask(worker_id, safepoint_id)) {
     }
 
     _subtasks.all_tasks_completed(_num_workers);
@@ -658,6 +801,7 @@ public:
 void SafepointSynchronize::do_cleanup_tasks() {
 
   TraceTime timer("safepoint cleanup tasks", TRACETIME_LOG(Info, safepoint, cleanup));
+  ResourceMark rm;
 
   // Prepare for monitor deflation.
   DeflateMonitorCounters deflate_counters;
@@ -669,14 +813,18 @@ void SafepointSynchronize::do_cleanup_tasks() {
   if (cleanup_workers != NULL) {
     // Parallel cleanup using GC provided thread pool.
     uint num_cleanup_workers = cleanup_workers->active_workers();
-    ParallelSPCleanupTask cleanup(num_cleanup_workers, &deflate_counters);
+    SafepointCleanupWorkerTimes times(num_cleanup_workers);
+    ParallelSPCleanupTask cleanup(num_cleanup_workers, &deflate_counters, &times);
     StrongRootsScope srs(num_cleanup_workers);
     cleanup_workers->run_task(&cleanup);
+    times.print();
   } else {
     // Serial cleanup using VMThread.
-    ParallelSPCleanupTask cleanup(1, &deflate_counters);
+    SafepointCleanupWorkerTimes times(1);
+    ParallelSPCleanupTask cleanup(1, &deflate_counters, &times);
     StrongRootsScope srs(1);
     cleanup.work(0);
+    times.print();
   }
 
   // Needs to be done single threaded by the VMThread.  This walks
@@ -947,6 +1095,108 @@ void SafepointSynchronize::print_safepoint_timeout() {
   }
 }
 
+// Captures the pc of a thread that has not reached the safepoint. The
+// task runs while the thread is suspended, possibly in the middle of
+// malloc or holding a lock, so it must neither lock nor allocate; the
+// pc is resolved to a method after the thread has been resumed.
+class SafepointStallSampler : public os::SuspendedThreadTask {
+ private:
+  address _pc;
+
+ public:
+  SafepointStallSampler(JavaThread* thread) : os::SuspendedThreadTask(thread), _pc(NULL) {}
+
+  address pc() const { return _pc; }
+
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    JavaThread* jt = (JavaThread*)context.thread();
+    if (jt->thread_state() == _thread_in_Java) {
+      intptr_t* sp;
+      intptr_t* fp;
+      _pc = os::fetch_frame_from_context(context.ucontext(), &sp, &fp).pc();
+    }
+  }
+};
+
+static void post_safepoint_stall_event(EventSafepointStall& event,
+                                       uint64_t safepoint_id,
+                                       JavaThread* thread,
+                                       const Method* method,
+                                       int bci,
+                                       int pc_offset,
+                                       const char* code_blob,
+                                       jlong stall_ns) {
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_stalledThread(JFR_THREAD_ID(thread));
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_pcOffset(pc_offset);
+    event.set_codeBlob(code_blob);
+    event.set_stallTime(stall_ns);
+    event.commit();
+  }
+}
+
+// Time-to-safepoint is dominated by threads that run for a long time
+// without polling, typically in counted loops that C2 compiled without a
+// safepoint poll. Report the compiled method and the bci of the next
+// debug info after the pc of each such thread, which for a loop
+// without a poll is the call or poll following it.
+void SafepointSynchronize::sample_stalled_threads(ThreadSafepointState* tss_head) {
+  LogTarget(Info, safepoint, stats) lt;
+  if (!lt.is_enabled() && !EventSafepointStall::is_enabled()) {
+    return;
+  }
+  ResourceMark rm;
+  jlong stall_ns = os::javaTimeNanos() - SafepointTracing::start_of_safepoint();
+  for (ThreadSafepointState* cur_tss = tss_head; cur_tss != NULL; cur_tss = cur_tss->get_next()) {
+    JavaThread* thread = cur_tss->thread();
+    EventSafepointStall event;
+    SafepointStallSampler sampler(thread);
+    sampler.run();
+
+    // The code blob of a running thread can't be flushed before this
+    // safepoint has been reached, so it is safe to look at it here.
+    const char* code_blob = "in VM";
+    const Method* method = NULL;
+    int bci = InvocationEntryBci;
+    int pc_offset = -1;
+    address pc = sampler.pc();
+    CodeBlob* cb = (pc != NULL) ? CodeCache::find_blob_unsafe(pc) : NULL;
+    if (cb != NULL) {
+      code_blob = cb->name();
+      pc_offset = (int)(pc - cb->code_begin());
+      CompiledMethod* cm = cb->as_compiled_method_or_null();
+      if (cm != NULL) {
+        method = cm->method();
+        if (cm->pc_desc_near(pc) != NULL) {
+          ScopeDesc* sd = cm->scope_desc_near(pc);
+          method = sd->method();
+          bci = sd->bci();
+        }
+      }
+    } else if (pc != NULL) {
+      code_blob = "native";
+    }
+
+    if (lt.is_enabled()) {
+      LogStream ls(lt);
+      ls.print("Thread " INTPTR_FORMAT " (%s) has not reached the safepoint after " JLONG_FORMAT " ms, %s",
+               p2i(thread), thread->get_thread_name(), stall_ns / (NANOUNITS / MILLIUNITS), code_blob);
+      if (method != NULL) {
+        ls.print(" %s bci %d", method->name_and_sig_as_C_string(), bci);
+      }
+      if (pc_offset >= 0) {
+        ls.print(" pc offset %d", pc_offset);
+      }
+      ls.cr();
+    }
+    post_safepoint_stall_event(event, _safepoint_id + 1, thread, method, bci,
+                               pc_offset, code_blob, stall_ns);
+  }
+}
+
 // -------------------------------------------------------------------------------------------------------
 // Implementation of ThreadSafepointState
 
@@ -1235,11 +1485,17 @@ void SafepointTracing::statistics_exit_log() {
 
   log_info(safepoint, stats)("VM operations coalesced during safepoint " INT64_FORMAT,
                               VMThread::get_coalesced_count());
+  log_info(safepoint, stats)("No-op safepoints elided for pending VM operations " UINT64_FORMAT,
+                              VMThread::get_elided_no_op_count());
   log_info(safepoint, stats)("Maximum sync time  " INT64_FORMAT" ns",
                               (int64_t)(_max_sync_time));
   log_info(safepoint, stats)("Maximum vm operation time (except for Exit VM operation)  "
                               INT64_FORMAT " ns",
                               (int64_t)(_max_vmop_time));
+
+  LogTarget(Info, safepoint, stats) lt;
+  LogStream ls(lt);
+  VMThread::print_operation_time_histogram(&ls);
 }
 
 void SafepointTracing::begin(VM_Operation::VMOp_Type type) {
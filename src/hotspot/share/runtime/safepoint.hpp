@@ -115,6 +115,9 @@ class SafepointSynchronize : AllStatic {
   // For debug long safepoint
   static void print_safepoint_timeout();
 
+  // Samples where the threads that hold up the safepoint are executing.
+  static void sample_stalled_threads(ThreadSafepointState* tss_head);
+
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
   static int synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running);
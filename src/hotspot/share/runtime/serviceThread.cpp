@@ -37,6 +37,7 @@
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/resolvedMethodTable.hpp"
 #include "services/diagnosticArgument.hpp"
@@ -105,6 +106,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool thread_id_table_work = false;
     bool protection_domain_table_work = false;
     bool oopstorage_work = false;
+    bool deflate_idle_monitors = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -131,10 +133,13 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
               (resolved_method_table_work = ResolvedMethodTable::has_work()) |
               (thread_id_table_work = ThreadIdTable::has_work()) |
               (protection_domain_table_work = SystemDictionary::pd_cache_table()->has_work()) |
-              (oopstorage_work = OopStorage::has_cleanup_work_and_reset())
+              (oopstorage_work = OopStorage::has_cleanup_work_and_reset()) |
+              (deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed())
              ) == 0) {
-        // Wait until notified that there is some work to do.
-        ml.wait();
+        // Wait until notified that there is some work to do. With
+        // AsyncDeflateIdleMonitors we also wake up periodically to
+        // check whether idle monitors need to be deflated.
+        ml.wait(AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -183,6 +188,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (oopstorage_work) {
       cleanup_oopstorages();
     }
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_using_JT();
+    }
   }
 }
 
@@ -110,6 +110,8 @@ void StatSampler::disengage() {
 
   // force a final sample
   sample_data(_sampled);
+
+  PerfMemory::publish();
 }
 
 /*
@@ -170,6 +172,8 @@ void StatSampler::collect_sample() {
   assert(_sampled != NULL, "list not initialized");
 
   sample_data(_sampled);
+
+  PerfMemory::publish();
 }
 
 /*
@@ -119,6 +119,7 @@ address StubRoutines::_data_cache_writeback_sync         = NULL;
 address StubRoutines::_checkcast_arraycopy               = NULL;
 address StubRoutines::_checkcast_arraycopy_uninit        = NULL;
 address StubRoutines::_unsafe_arraycopy                  = NULL;
+address StubRoutines::_unsafe_setmemory                  = NULL;
 address StubRoutines::_generic_arraycopy                 = NULL;
 
 address StubRoutines::_jbyte_fill;
@@ -159,6 +160,7 @@ address StubRoutines::_montgomeryMultiply = NULL;
 address StubRoutines::_montgomerySquare = NULL;
 
 address StubRoutines::_vectorizedMismatch = NULL;
+address StubRoutines::_vectorizedHashCode = NULL;
 
 address StubRoutines::_dexp = NULL;
 address StubRoutines::_dlog = NULL;
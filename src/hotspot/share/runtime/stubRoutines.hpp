@@ -198,6 +198,7 @@ class StubRoutines: AllStatic {
   // these are recommended but optional:
   static address _checkcast_arraycopy, _checkcast_arraycopy_uninit;
   static address _unsafe_arraycopy;
+  static address _unsafe_setmemory;
   static address _generic_arraycopy;
 
   static address _jbyte_fill;
@@ -241,6 +242,7 @@ class StubRoutines: AllStatic {
   static address _montgomerySquare;
 
   static address _vectorizedMismatch;
+  static address _vectorizedHashCode;
 
   static address _dexp;
   static address _dlog;
@@ -377,6 +379,11 @@ class StubRoutines: AllStatic {
   typedef void (*UnsafeArrayCopyStub)(const void* src, void* dst, size_t count);
   static UnsafeArrayCopyStub UnsafeArrayCopy_stub()         { return CAST_TO_FN_PTR(UnsafeArrayCopyStub,  _unsafe_arraycopy); }
 
+  static address unsafe_setmemory()     { return _unsafe_setmemory; }
+
+  typedef void (*UnsafeSetMemoryStub)(void* dst, size_t count, jubyte value);
+  static UnsafeSetMemoryStub UnsafeSetMemory_stub()         { return CAST_TO_FN_PTR(UnsafeSetMemoryStub,  _unsafe_setmemory); }
+
   static address generic_arraycopy()   { return _generic_arraycopy; }
 
   static address jbyte_fill()          { return _jbyte_fill; }
@@ -416,6 +423,7 @@ class StubRoutines: AllStatic {
   static address montgomerySquare()    { return _montgomerySquare; }
 
   static address vectorizedMismatch()  { return _vectorizedMismatch; }
+  static address vectorizedHashCode()  { return _vectorizedHashCode; }
 
   static address dexp()                { return _dexp; }
   static address dlog()                { return _dlog; }
@@ -37,11 +37,13 @@
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -130,6 +132,15 @@ static volatile intptr_t gListLock = 0;   // protects global monitor lists
 static volatile int g_om_free_count = 0;  // # on g_free_list
 static volatile int g_om_population = 0;  // # Extant -- in circulation
 
+// Global ObjectMonitor wait list. ObjectMonitors that have been async
+// deflated are prepended here until a handshake with all JavaThreads
+// guarantees that no thread still refers to them. They are then moved
+// to g_free_list. Protected by gListLock.
+static ObjectMonitor* volatile g_wait_list = NULL;
+static volatile int g_om_wait_count = 0;  // # on g_wait_list
+// Time of the last async deflation; see is_async_deflation_needed().
+static jlong g_last_async_deflation_time_ns = 0;
+
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
 
@@ -171,8 +182,9 @@ bool ObjectSynchronizer::quick_notify(oopDesc* obj, Thread* self, bool all) {
 
   if (mark.has_monitor()) {
     ObjectMonitor* const mon = mark.monitor();
-    assert(mon->object() == obj, "invariant");
     if (mon->owner() != self) return false;  // slow-path for IMS exception
+    // An owned ObjectMonitor cannot be async deflated.
+    assert(mon->object() == obj, "invariant");
 
     if (mon->first_waiter() != NULL) {
       // We have one or more waiters. Since this is an inflated monitor
@@ -215,7 +227,10 @@ bool ObjectSynchronizer::quick_enter(oop obj, Thread* self,
 
   if (mark.has_monitor()) {
     ObjectMonitor* const m = mark.monitor();
-    assert(m->object() == obj, "invariant");
+    // An async deflation can race us here. If it already claimed the
+    // ObjectMonitor, then _owner is DEFLATER_MARKER and we take the
+    // slow-path which knows how to retry.
+    assert(AsyncDeflateIdleMonitors || m->object() == obj, "invariant");
     Thread* const owner = (Thread *) m->_owner;
 
     // Lock contention and Transactional Lock Elision (TLE) diagnostics
@@ -295,7 +310,15 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markWord::unused_mark());
-  inflate(THREAD, obj(), inflate_cause_monitor_enter)->enter(THREAD);
+  // An async deflation can race after the inflate() call and before
+  // enter() can make the ObjectMonitor busy. enter() returns false if
+  // we have lost the race to async deflation and we simply try again.
+  while (true) {
+    ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_monitor_enter);
+    if (monitor->enter(THREAD)) {
+      return;
+    }
+  }
 }
 
 void ObjectSynchronizer::exit(oop object, BasicLock* lock, TRAPS) {
@@ -377,9 +400,16 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark().has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  // An async deflation can race after the inflate() call and before
+  // reenter() -> enter() can make the ObjectMonitor busy. reenter() ->
+  // enter() returns false if we have lost the race to async deflation
+  // and we simply try again.
+  while (true) {
+    ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_vm_internal);
+    if (monitor->reenter(recursion, THREAD)) {
+      return;
+    }
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -391,7 +421,15 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark().has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  // An async deflation can race after the inflate() call and before
+  // enter() can make the ObjectMonitor busy. enter() returns false if
+  // we have lost the race to async deflation and we simply try again.
+  while (true) {
+    ObjectMonitor* monitor = inflate(THREAD, obj(), inflate_cause_jni_enter);
+    if (monitor->enter(THREAD)) {
+      break;
+    }
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -686,79 +724,98 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* self, oop obj) {
   assert(Universe::verify_in_progress() || DumpSharedSpaces ||
          ((JavaThread *)self)->thread_state() != _thread_blocked, "invariant");
 
-  ObjectMonitor* monitor = NULL;
-  markWord temp, test;
-  intptr_t hash;
-  markWord mark = read_stable_mark(obj);
+  while (true) {
+    ObjectMonitor* monitor = NULL;
+    markWord temp, test;
+    intptr_t hash;
+    markWord mark = read_stable_mark(obj);
 
-  // object should remain ineligible for biased locking
-  assert(!mark.has_bias_pattern(), "invariant");
+    // object should remain ineligible for biased locking
+    assert(!mark.has_bias_pattern(), "invariant");
 
-  if (mark.is_neutral()) {
-    hash = mark.hash();               // this is a normal header
-    if (hash != 0) {                  // if it has hash, just return it
-      return hash;
-    }
-    hash = get_next_hash(self, obj);  // allocate a new hash code
-    temp = mark.copy_set_hash(hash);  // merge the hash code into header
-    // use (machine word version) atomic operation to install the hash
-    test = obj->cas_set_mark(temp, mark);
-    if (test == mark) {
-      return hash;
-    }
-    // If atomic operation failed, we must inflate the header
-    // into heavy weight monitor. We could add more code here
-    // for fast path, but it does not worth the complexity.
-  } else if (mark.has_monitor()) {
-    monitor = mark.monitor();
-    temp = monitor->header();
-    assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
-    hash = temp.hash();
-    if (hash != 0) {
-      return hash;
+    if (mark.is_neutral()) {
+      hash = mark.hash();               // this is a normal header
+      if (hash != 0) {                  // if it has hash, just return it
+        return hash;
+      }
+      hash = get_next_hash(self, obj);  // allocate a new hash code
+      temp = mark.copy_set_hash(hash);  // merge the hash code into header
+      // use (machine word version) atomic operation to install the hash
+      test = obj->cas_set_mark(temp, mark);
+      if (test == mark) {
+        return hash;
+      }
+      // If atomic operation failed, we must inflate the header
+      // into heavy weight monitor. We could add more code here
+      // for fast path, but it does not worth the complexity.
+    } else if (mark.has_monitor()) {
+      monitor = mark.monitor();
+      temp = monitor->header();
+      // An async deflation may have marked the header, but the hash
+      // bits are still valid.
+      assert(temp.is_neutral() || (AsyncDeflateIdleMonitors && temp.is_marked()),
+             "invariant: header=" INTPTR_FORMAT, temp.value());
+      hash = temp.hash();
+      if (hash != 0) {
+        return hash;
+      }
+      // Skip to the following code to reduce code size
+    } else if (self->is_lock_owned((address)mark.locker())) {
+      temp = mark.displaced_mark_helper(); // this is a lightweight monitor owned
+      assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
+      hash = temp.hash();                  // by current thread, check if the displaced
+      if (hash != 0) {                     // header contains hash code
+        return hash;
+      }
+      // WARNING:
+      // The displaced header in the BasicLock on a thread's stack
+      // is strictly immutable. It CANNOT be changed in ANY cases.
+      // So we have to inflate the stack lock into an ObjectMonitor
+      // even if the current thread owns the lock. The BasicLock on
+      // a thread's stack can be asynchronously read by other threads
+      // during an inflate() call so any change to that stack memory
+      // may not propagate to other threads correctly.
     }
-    // Skip to the following code to reduce code size
-  } else if (self->is_lock_owned((address)mark.locker())) {
-    temp = mark.displaced_mark_helper(); // this is a lightweight monitor owned
-    assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
-    hash = temp.hash();                  // by current thread, check if the displaced
-    if (hash != 0) {                     // header contains hash code
-      return hash;
+
+    // Inflate the monitor to set hash code
+    monitor = inflate(self, obj, inflate_cause_hash_code);
+    // Load displaced header and check it has hash code
+    mark = monitor->header();
+    if (AsyncDeflateIdleMonitors && mark.is_marked()) {
+      // The monitor is being async deflated and its header can no
+      // longer be updated. Restore the header into the object and
+      // retry against the object.
+      monitor->install_displaced_markword_in_object(obj);
+      continue;
     }
-    // WARNING:
-    // The displaced header in the BasicLock on a thread's stack
-    // is strictly immutable. It CANNOT be changed in ANY cases.
-    // So we have to inflate the stack lock into an ObjectMonitor
-    // even if the current thread owns the lock. The BasicLock on
-    // a thread's stack can be asynchronously read by other threads
-    // during an inflate() call so any change to that stack memory
-    // may not propagate to other threads correctly.
-  }
-
-  // Inflate the monitor to set hash code
-  monitor = inflate(self, obj, inflate_cause_hash_code);
-  // Load displaced header and check it has hash code
-  mark = monitor->header();
-  assert(mark.is_neutral(), "invariant: header=" INTPTR_FORMAT, mark.value());
-  hash = mark.hash();
-  if (hash == 0) {
-    hash = get_next_hash(self, obj);
-    temp = mark.copy_set_hash(hash); // merge hash code into header
-    assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
-    uintptr_t v = Atomic::cmpxchg(temp.value(), (volatile uintptr_t*)monitor->header_addr(), mark.value());
-    test = markWord(v);
-    if (test != mark) {
-      // The only non-deflation update to the ObjectMonitor's
-      // header/dmw field is to merge in the hash code. If someone
-      // adds a new usage of the header/dmw field, please update
-      // this code.
-      hash = test.hash();
-      assert(test.is_neutral(), "invariant: header=" INTPTR_FORMAT, test.value());
-      assert(hash != 0, "Trivial unexpected object/monitor header usage.");
+    assert(mark.is_neutral(), "invariant: header=" INTPTR_FORMAT, mark.value());
+    hash = mark.hash();
+    if (hash == 0) {
+      hash = get_next_hash(self, obj);
+      temp = mark.copy_set_hash(hash); // merge hash code into header
+      assert(temp.is_neutral(), "invariant: header=" INTPTR_FORMAT, temp.value());
+      uintptr_t v = Atomic::cmpxchg(temp.value(), (volatile uintptr_t*)monitor->header_addr(), mark.value());
+      test = markWord(v);
+      if (test != mark) {
+        if (AsyncDeflateIdleMonitors && test.is_marked()) {
+          // Lost the race to an async deflation which froze the header
+          // without our hash code. Restore the header into the object
+          // and retry against the object.
+          monitor->install_displaced_markword_in_object(obj);
+          continue;
+        }
+        // The only non-deflation update to the ObjectMonitor's
+        // header/dmw field is to merge in the hash code. If someone
+        // adds a new usage of the header/dmw field, please update
+        // this code.
+        hash = test.hash();
+        assert(test.is_neutral(), "invariant: header=" INTPTR_FORMAT, test.value());
+        assert(hash != 0, "Trivial unexpected object/monitor header usage.");
+      }
     }
+    // We finally get the hash
+    return hash;
   }
-  // We finally get the hash
-  return hash;
 }
 
 // Deprecated -- use FastHashCode() instead.
@@ -827,9 +884,11 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
 
   // CASE: inflated. Mark (tagged pointer) points to an ObjectMonitor.
   // The Object:ObjectMonitor relationship is stable as long as we're
-  // not at a safepoint.
+  // not at a safepoint and AsyncDeflateIdleMonitors is false. The
+  // owner() accessor reports an ObjectMonitor that is being async
+  // deflated as unowned.
   if (mark.has_monitor()) {
-    void* owner = mark.monitor()->_owner;
+    void* owner = mark.monitor()->owner();
     if (owner == NULL) return owner_none;
     return (owner == self ||
             self->is_lock_owned((address)owner)) ? owner_self : owner_other;
@@ -909,12 +968,32 @@ static bool monitors_used_above_threshold() {
 }
 
 bool ObjectSynchronizer::is_cleanup_needed() {
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the ServiceThread, so there is
+    // no reason to induce a cleanup safepoint for them.
+    return false;
+  }
   if (MonitorUsedDeflationThreshold > 0) {
     return monitors_used_above_threshold();
   }
   return false;
 }
 
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (ForceMonitorScavenge != 0) {
+    // Deflation has been requested, e.g. by MonitorBound.
+    return true;
+  }
+  if (AsyncDeflationInterval > 0 && MonitorUsedDeflationThreshold > 0) {
+    jlong elapsed_ms = (os::javaTimeNanos() - g_last_async_deflation_time_ns) / NANOSECS_PER_MILLISEC;
+    return elapsed_ms >= AsyncDeflationInterval && monitors_used_above_threshold();
+  }
+  return false;
+}
+
 void ObjectSynchronizer::oops_do(OopClosure* f) {
   // We only scan the global used list here (for moribund threads), and
   // the thread-local monitors in Thread::oops_do().
@@ -947,8 +1026,10 @@ void ObjectSynchronizer::list_oops_do(ObjectMonitor* list, OopClosure* f) {
 // -----------------------
 // Inflation unlinks monitors from the global g_free_list and
 // associates them with objects.  Deflation -- which occurs at
-// STW-time -- disassociates idle monitors from objects.  Such
-// scavenged monitors are returned to the g_free_list.
+// STW-time, or concurrently on the ServiceThread when
+// AsyncDeflateIdleMonitors is enabled -- disassociates idle monitors
+// from objects.  Such scavenged monitors are returned to the
+// g_free_list.
 //
 // The global list is protected by gListLock.  All the critical sections
 // are short and operate in constant-time.
@@ -994,6 +1075,12 @@ static void InduceScavenge(Thread* self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // The ServiceThread picks up the request the next time it checks
+      // is_async_deflation_needed(), at the latest after
+      // AsyncDeflationInterval. No safepoint is needed.
+      return;
+    }
     // Induce a 'null' safepoint to scavenge monitors
     // Must VM_Operation instance be heap allocated as the op will be enqueue and posted
     // to the VMthread and have a lifespan longer than that of this activation record.
@@ -1300,8 +1387,11 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* self,
     if (mark.has_monitor()) {
       ObjectMonitor* inf = mark.monitor();
       markWord dmw = inf->header();
-      assert(dmw.is_neutral(), "invariant: header=" INTPTR_FORMAT, dmw.value());
-      assert(inf->object() == object, "invariant");
+      // With AsyncDeflateIdleMonitors the ObjectMonitor may be in the
+      // middle of being deflated. The callers detect that and retry.
+      assert(dmw.is_neutral() || (AsyncDeflateIdleMonitors && dmw.is_marked()),
+             "invariant: header=" INTPTR_FORMAT, dmw.value());
+      assert(inf->object() == object || AsyncDeflateIdleMonitors, "invariant");
       assert(ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
       return inf;
     }
@@ -1603,6 +1693,11 @@ void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* c
 
 void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors) {
+    // Idle monitors are deflated by the ServiceThread; see
+    // deflate_idle_monitors_using_JT().
+    return;
+  }
   bool deflated = false;
 
   ObjectMonitor* free_head_p = NULL;  // Local SLL of scavenged monitors
@@ -1656,6 +1751,14 @@ void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters)
 }
 
 void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  if (AsyncDeflateIdleMonitors) {
+    // Nothing was deflated at this safepoint so only the bookkeeping
+    // that has to happen at every safepoint is done.
+    GVars.stw_random = os::random();
+    GVars.stw_cycle++;
+    return;
+  }
+
   // Report the cumulative time for deflating each thread's idle
   // monitors. Note: if the work is split among more than one
   // worker thread, then the reported time will likely be more
@@ -1687,6 +1790,11 @@ void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* co
 
 void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (AsyncDeflateIdleMonitors) {
+    // Per-thread idle monitors are deflated via a handshake; see
+    // deflate_thread_local_monitors_using_JT().
+    return;
+  }
 
   ObjectMonitor* free_head_p = NULL;  // Local SLL of scavenged monitors
   ObjectMonitor* free_tail_p = NULL;
@@ -1739,6 +1847,341 @@ void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMo
   }
 }
 
+// Deflate the specified ObjectMonitor if it is not in-use using a thread
+// other than the VMThread at a safepoint. Returns true if it was deflated
+// and false otherwise.
+//
+// The async deflation protocol sets owner to DEFLATER_MARKER and makes
+// contentions negative as signals to contending threads that an async
+// deflation is in progress. There are a number of checks as part of the
+// protocol to make sure that the calling thread has not lost the race to
+// a contending thread:
+//
+// 1) A NULL owner is replaced with DEFLATER_MARKER. A contending thread
+//    that has already made the ObjectMonitor busy can cancel the deflation
+//    by replacing DEFLATER_MARKER with itself in ObjectMonitor::TryLock().
+// 2) A zero contentions field is made negative. A contending thread that
+//    sees a negative contentions field in ObjectMonitor::enter() restores
+//    the object's header and retries with a fresh inflate().
+//
+// ObjectMonitors are type-stable so a thread that raced with us may still
+// refer to a deflated ObjectMonitor. That is why deflated ObjectMonitors
+// are kept on g_wait_list until after a handshake with all JavaThreads;
+// see deflate_idle_monitors_using_JT().
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid,
+                                                  ObjectMonitor** free_head_p,
+                                                  ObjectMonitor** free_tail_p) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+
+  const oop obj = (oop) mid->object();
+  if (obj == NULL || mid->is_busy()) {
+    // Easy checks are first - the ObjectMonitor is busy or is not
+    // associated with an object so no deflation.
+    return false;
+  }
+
+  // Set a NULL owner to DEFLATER_MARKER to force any contending thread
+  // through the slow path. This is just the first part of the async
+  // deflation dance.
+  if (Atomic::cmpxchg(DEFLATER_MARKER, &mid->_owner, (void*)NULL) != NULL) {
+    // The owner field is no longer NULL so we lost the race since the
+    // ObjectMonitor is now busy.
+    return false;
+  }
+
+  if (mid->_contentions > 0 || mid->_waiters != 0) {
+    // Another thread has raced to enter the ObjectMonitor after
+    // mid->is_busy() above or has already entered and waited on it
+    // which makes it busy so no deflation. Restore owner to NULL if
+    // it is still DEFLATER_MARKER.
+    if (Atomic::cmpxchg((void*)NULL, &mid->_owner, DEFLATER_MARKER) != DEFLATER_MARKER) {
+      // Deferred decrement for the thread that cancelled the async
+      // deflation in ObjectMonitor::TryLock().
+      Atomic::dec(&mid->_contentions);
+    }
+    return false;
+  }
+
+  // Make a zero contentions field negative to force any contending
+  // threads to retry. This is the second part of the async deflation
+  // dance.
+  if (Atomic::cmpxchg(-max_jint, &mid->_contentions, (jint)0) != 0) {
+    // Contentions was no longer 0 so we lost the race since the
+    // ObjectMonitor is now busy. Restore owner to NULL if it is
+    // still DEFLATER_MARKER.
+    if (Atomic::cmpxchg((void*)NULL, &mid->_owner, DEFLATER_MARKER) != DEFLATER_MARKER) {
+      // Deferred decrement for the thread that cancelled the async
+      // deflation in ObjectMonitor::TryLock().
+      Atomic::dec(&mid->_contentions);
+    }
+    return false;
+  }
+
+  // The ObjectMonitor has been successfully async deflated.
+  // Sanity checks for the races:
+  guarantee(mid->_owner == DEFLATER_MARKER, "must be DEFLATER_MARKER: owner="
+            INTPTR_FORMAT, p2i(mid->_owner));
+  guarantee(mid->_contentions < 0, "must be negative: contentions=%d",
+            mid->_contentions);
+  guarantee(mid->_waiters == 0, "must be 0: waiters=%d", mid->_waiters);
+  guarantee(mid->_cxq == NULL, "must be no contending threads: cxq="
+            INTPTR_FORMAT, p2i(mid->_cxq));
+  guarantee(mid->_EntryList == NULL,
+            "must be no entering threads: EntryList=" INTPTR_FORMAT,
+            p2i(mid->_EntryList));
+
+  if (log_is_enabled(Trace, monitorinflation)) {
+    ResourceMark rm;
+    log_trace(monitorinflation)("deflate_monitor_using_JT: "
+                                "object=" INTPTR_FORMAT ", mark="
+                                INTPTR_FORMAT ", type='%s'",
+                                p2i(obj), obj->mark().value(),
+                                obj->klass()->external_name());
+  }
+
+  // Install the old mark word if nobody else has already done it.
+  mid->install_displaced_markword_in_object(obj);
+  mid->set_object(NULL);
+
+  // Move the deflated ObjectMonitor to the working free list
+  // defined by free_head_p and free_tail_p.
+  if (*free_head_p == NULL) *free_head_p = mid;
+  if (*free_tail_p != NULL) {
+    // We append to the list so the caller can use mid->_next_om
+    // to fix the linkages in its context.
+    ObjectMonitor* prevtail = *free_tail_p;
+    // Should have been cleaned up by the caller:
+    assert(prevtail->_next_om == NULL, "cleaned up deflated?");
+    prevtail->_next_om = mid;
+  }
+  *free_tail_p = mid;
+  return true;
+}
+
+// Prepend a list of async deflated ObjectMonitors to g_wait_list.
+// Caller acquires gListLock.
+static void prepend_to_wait_list(ObjectMonitor* head, ObjectMonitor* tail,
+                                 int count) {
+  assert(head != NULL && tail != NULL && count > 0, "invariant");
+  assert(tail->_next_om == NULL, "invariant");
+  tail->_next_om = g_wait_list;
+  g_wait_list = head;
+  g_om_wait_count += count;
+}
+
+// Walk a given ObjectMonitor list and deflate idle ObjectMonitors using
+// a thread other than the VMThread at a safepoint. Deflated ObjectMonitors
+// are unlinked from the list, *count_p is updated and they are prepended
+// to g_wait_list. Returns the number of deflated ObjectMonitors.
+//
+// When is_global is true, the list is g_om_in_use_list and the caller
+// (the ServiceThread) holds gListLock. The lock is dropped whenever a
+// safepoint or handshake is pending so that neither is held up by a long
+// list. om_flush() may prepend to g_om_in_use_list while the lock is not
+// held, but only this function unlinks from it. Otherwise the list is a
+// per-thread in-use list and the caller is executing a handshake for the
+// list's owner, which keeps the owner from changing the list.
+int ObjectSynchronizer::deflate_monitor_list_using_JT(ObjectMonitor** list_p,
+                                                      int* count_p,
+                                                      bool is_global) {
+  Thread* self = Thread::current();
+  ObjectMonitor* free_head_p = NULL;  // Local SLL of deflated monitors
+  ObjectMonitor* free_tail_p = NULL;
+  ObjectMonitor* cur_mid_in_use = NULL;
+  int local_deflated_count = 0;
+  int deflated_count = 0;
+
+  ObjectMonitor* mid = *list_p;
+  while (mid != NULL) {
+    ObjectMonitor* next = mid->_next_om;
+    if (deflate_monitor_using_JT(mid, &free_head_p, &free_tail_p)) {
+      // Deflation succeeded and already updated free_head_p and
+      // free_tail_p as needed. Finish the move to the local free list
+      // by unlinking mid from the in-use list.
+      if (cur_mid_in_use == NULL) {
+        *list_p = next;
+      } else {
+        cur_mid_in_use->_next_om = next;
+      }
+      mid->_next_om = NULL;  // This mid is current tail in the free_head_p list
+      local_deflated_count++;
+    } else {
+      cur_mid_in_use = mid;
+    }
+    mid = next;
+
+    if (is_global && mid != NULL && SafepointMechanism::should_block(self)) {
+      // Publish what we have so far: the lists and counts have to be
+      // consistent while we are blocked.
+      if (local_deflated_count > 0) {
+        *count_p -= local_deflated_count;
+        prepend_to_wait_list(free_head_p, free_tail_p, local_deflated_count);
+        deflated_count += local_deflated_count;
+        free_head_p = free_tail_p = NULL;
+        local_deflated_count = 0;
+      }
+      Thread::muxRelease(&gListLock);
+      {
+        assert(self->is_Java_thread(), "must be a JavaThread");
+        ThreadBlockInVM tbivm((JavaThread*)self);
+      }
+      Thread::muxAcquire(&gListLock, "deflate_monitor_list_using_JT");
+      if (cur_mid_in_use == NULL && *list_p != mid) {
+        // om_flush() prepended to the list in the meantime so
+        // find mid's new predecessor.
+        cur_mid_in_use = *list_p;
+        while (cur_mid_in_use->_next_om != mid) {
+          cur_mid_in_use = cur_mid_in_use->_next_om;
+        }
+      }
+    }
+  }
+
+  if (local_deflated_count > 0) {
+    if (!is_global) {
+      Thread::muxAcquire(&gListLock, "deflate_monitor_list_using_JT");
+    }
+    *count_p -= local_deflated_count;
+    prepend_to_wait_list(free_head_p, free_tail_p, local_deflated_count);
+    if (!is_global) {
+      Thread::muxRelease(&gListLock);
+    }
+    deflated_count += local_deflated_count;
+  }
+  return deflated_count;
+}
+
+// Deflate the thread's per-thread in-use list. Called from a handshake
+// either by the thread itself or by the VMThread on its behalf.
+int ObjectSynchronizer::deflate_thread_local_monitors_using_JT(Thread* thread) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  elapsedTimer timer;
+
+  if (log_is_enabled(Info, monitorinflation)) {
+    timer.start();
+  }
+
+  int deflated_count = deflate_monitor_list_using_JT(thread->om_in_use_list_addr(),
+                                                     &thread->om_in_use_count,
+                                                     false /* is_global */);
+  timer.stop();
+
+  LogStreamHandle(Debug, monitorinflation) lsh_debug;
+  LogStreamHandle(Info, monitorinflation) lsh_info;
+  LogStream* ls = NULL;
+  if (log_is_enabled(Debug, monitorinflation)) {
+    ls = &lsh_debug;
+  } else if (deflated_count != 0 && log_is_enabled(Info, monitorinflation)) {
+    ls = &lsh_info;
+  }
+  if (ls != NULL) {
+    ls->print_cr("jt=" INTPTR_FORMAT ": async deflating per-thread idle monitors, %3.7f secs, %d monitors", p2i(thread), timer.seconds(), deflated_count);
+  }
+  return deflated_count;
+}
+
+// Deflates the per-thread in-use list of every JavaThread visited.
+class DeflateThreadLocalMonitorsClosure : public ThreadClosure {
+ private:
+  volatile int _deflated_count;
+
+ public:
+  DeflateThreadLocalMonitorsClosure() : _deflated_count(0) {}
+
+  void do_thread(Thread* thread) {
+    int count = ObjectSynchronizer::deflate_thread_local_monitors_using_JT(thread);
+    Atomic::add(count, &_deflated_count);
+  }
+
+  int deflated_count() const { return _deflated_count; }
+};
+
+// Nothing to do: once every JavaThread has executed this handshake (or
+// had it executed on its behalf) no thread can still refer to an
+// ObjectMonitor that was deflated before the handshake started.
+class HandshakeForDeflation : public ThreadClosure {
+ public:
+  void do_thread(Thread* thread) {}
+};
+
+// Deflate idle ObjectMonitors on the global and per-thread in-use lists
+// without a safepoint. Called by the ServiceThread when
+// is_async_deflation_needed() returns true.
+void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  JavaThread* self = JavaThread::current();
+  assert(self->thread_state() == _thread_in_vm, "invariant");
+  elapsedTimer timer;
+
+  if (log_is_enabled(Info, monitorinflation)) {
+    timer.start();
+  }
+
+  // For moribund threads, scan g_om_in_use_list.
+  Thread::muxAcquire(&gListLock, "deflate_idle_monitors_using_JT(1)");
+  int global_deflated_count = deflate_monitor_list_using_JT((ObjectMonitor**)&g_om_in_use_list,
+                                                            &g_om_in_use_count,
+                                                            true /* is_global */);
+  Thread::muxRelease(&gListLock);
+
+  // Each JavaThread deflates its own in-use list at its next handshake
+  // poll, or the VMThread does it for a JavaThread that is blocked, so
+  // there is no global pause.
+  DeflateThreadLocalMonitorsClosure dtlm_cl;
+  Handshake::execute(&dtlm_cl);
+  int deflated_count = global_deflated_count + dtlm_cl.deflated_count();
+
+  int freed_count = 0;
+  if (g_om_wait_count > 0) {
+    // Only this thread adds to g_wait_list, so everything on it now was
+    // deflated before the handshake below starts.
+    HandshakeForDeflation hfd_cl;
+    Handshake::execute(&hfd_cl);
+
+    Thread::muxAcquire(&gListLock, "deflate_idle_monitors_using_JT(2)");
+    ObjectMonitor* tail = NULL;
+    for (ObjectMonitor* mid = g_wait_list; mid != NULL; mid = mid->_next_om) {
+      mid->clear_using_JT();
+      tail = mid;
+      freed_count++;
+    }
+    assert(freed_count == g_om_wait_count, "wait-count off");
+    if (tail != NULL) {
+      // constant-time list splice - prepend the deflated segment to g_free_list
+      tail->_next_om = g_free_list;
+      g_free_list = g_wait_list;
+      g_om_free_count += freed_count;
+    }
+    g_wait_list = NULL;
+    g_om_wait_count = 0;
+    Thread::muxRelease(&gListLock);
+  }
+  timer.stop();
+
+  g_last_async_deflation_time_ns = os::javaTimeNanos();
+  ForceMonitorScavenge = 0;    // Reset
+
+  OM_PERFDATA_OP(Deflations, inc(deflated_count));
+  OM_PERFDATA_OP(MonExtant, set_value(g_om_population - g_om_free_count));
+
+  LogStreamHandle(Debug, monitorinflation) lsh_debug;
+  LogStreamHandle(Info, monitorinflation) lsh_info;
+  LogStream* ls = NULL;
+  if (log_is_enabled(Debug, monitorinflation)) {
+    ls = &lsh_debug;
+  } else if (deflated_count != 0 && log_is_enabled(Info, monitorinflation)) {
+    ls = &lsh_info;
+  }
+  if (ls != NULL) {
+    ls->print_cr("async deflating idle monitors, %3.7f secs, %d monitors "
+                 "(global=%d), %d freed", timer.seconds(), deflated_count,
+                 global_deflated_count, freed_count);
+    ls->print_cr("g_om_population=%d, g_om_in_use_count=%d, "
+                 "g_om_free_count=%d", g_om_population,
+                 g_om_in_use_count, g_om_free_count);
+  }
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
@@ -2138,12 +2581,13 @@ void ObjectSynchronizer::log_in_use_monitor_details(outputStream * out,
 // the population count.
 int ObjectSynchronizer::log_monitor_list_counts(outputStream * out) {
   int pop_count = 0;
-  out->print_cr("%18s  %10s  %10s  %10s",
-                "Global Lists:", "InUse", "Free", "Total");
-  out->print_cr("==================  ==========  ==========  ==========");
-  out->print_cr("%18s  %10d  %10d  %10d", "",
-                g_om_in_use_count, g_om_free_count, g_om_population);
-  pop_count += g_om_in_use_count + g_om_free_count;
+  out->print_cr("%18s  %10s  %10s  %10s  %10s",
+                "Global Lists:", "InUse", "Free", "Wait", "Total");
+  out->print_cr("==================  ==========  ==========  ==========  ==========");
+  out->print_cr("%18s  %10d  %10d  %10d  %10d", "",
+                g_om_in_use_count, g_om_free_count, g_om_wait_count,
+                g_om_population);
+  pop_count += g_om_in_use_count + g_om_free_count + g_om_wait_count;
 
   out->print_cr("%18s  %10s  %10s  %10s",
                 "Per-Thread Lists:", "InUse", "Free", "Provision");
@@ -138,6 +138,17 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** free_head_p,
                               ObjectMonitor** free_tail_p);
   static bool is_cleanup_needed();
+
+  // With AsyncDeflateIdleMonitors, idle monitors are deflated by the
+  // ServiceThread instead of at safepoint cleanup time.
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_using_JT();
+  static int  deflate_thread_local_monitors_using_JT(Thread* thread);
+  static int  deflate_monitor_list_using_JT(ObjectMonitor** list_p,
+                                            int* count_p, bool is_global);
+  static bool deflate_monitor_using_JT(ObjectMonitor* mid,
+                                       ObjectMonitor** free_head_p,
+                                       ObjectMonitor** free_tail_p);
   static void oops_do(OopClosure* f);
   // Process oops in thread local used monitors
   static void thread_local_used_oops_do(Thread* thread, OopClosure* f);
@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "aot/aotLoader.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/moduleEntry.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -44,6 +45,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "logging/log.hpp"
+#include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -82,6 +84,7 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/orderAccess.hpp"
+#include "runtime/os_perf.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
 #include "runtime/safepoint.hpp"
@@ -233,7 +236,7 @@ Thread::Thread() {
   set_handle_area(new (mtThread) HandleArea(NULL));
   set_metadata_handles(new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, true));
   set_active_handles(NULL);
-  set_free_handle_block(NULL);
+  set_free_handle_block(NULL, 0);
   set_last_handle_mark(NULL);
   DEBUG_ONLY(_missed_ic_stub_refill_verifier = NULL);
 
@@ -253,6 +256,8 @@ Thread::Thread() {
   NOT_PRODUCT(_skip_gcalot = false;)
   _jvmti_env_iteration_count = 0;
   set_allocated_bytes(0);
+  _pretenure_allocations = false;
+  _hardware_counters = NULL;
   _vm_operation_started_count = 0;
   _vm_operation_completed_count = 0;
   _current_pending_monitor = NULL;
@@ -446,6 +451,7 @@ Thread::~Thread() {
 #endif // INCLUDE_NMT
 
   // deallocate data structures
+  delete _hardware_counters;
   delete resource_area();
   // since the handle marks are using the handle area, we have to deallocated the root
   // handle mark before deallocating the thread's handle area,
@@ -1637,6 +1643,7 @@ void JavaThread::initialize() {
   _thread_stat = NULL;
   _thread_stat = new ThreadStatistics();
   _jni_active_critical = 0;
+  _profile_sample_counter = 0;
   _pending_jni_exception_check_fn = NULL;
   _do_not_unlock_if_synchronized = false;
   _cached_monitor_info = NULL;
@@ -2102,7 +2109,7 @@ void JavaThread::exit(bool destroy_vm, ExitType exit_type) {
 
   if (free_handle_block() != NULL) {
     JNIHandleBlock* block = free_handle_block();
-    set_free_handle_block(NULL);
+    set_free_handle_block(NULL, 0);
     JNIHandleBlock::release_block(block);
   }
 
@@ -2158,7 +2165,7 @@ void JavaThread::cleanup_failed_attach_current_thread(bool is_daemon) {
 
   if (free_handle_block() != NULL) {
     JNIHandleBlock* block = free_handle_block();
-    set_free_handle_block(NULL);
+    set_free_handle_block(NULL, 0);
     JNIHandleBlock::release_block(block);
   }
 
@@ -3830,6 +3837,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     return status;
   }
 
+  // Start the asynchronous log writer, if requested, now that
+  // NonJavaThreads can be created.
+  AsyncLogWriter::initialize();
+
   JFR_ONLY(Jfr::on_vm_init();)
 
   // Should be done after the heap is fully created
@@ -4006,6 +4017,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   JFR_ONLY(Jfr::on_vm_start();)
 
+  // Start loading the classes the application is expected to need.
+  ClassPreloader::initialize();
+
 #if INCLUDE_MANAGEMENT
   Management::initialize(THREAD);
 
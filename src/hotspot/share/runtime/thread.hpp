@@ -97,6 +97,7 @@ class ResourceArea;
 DEBUG_ONLY(class ResourceMark;)
 
 class WorkerThread;
+class HardwareCounterInterface;
 
 // Class hierarchy
 // - Thread
@@ -175,7 +176,7 @@ class Thread: public ThreadShadow {
 
   // JavaThread lifecycle support:
   friend class SafeThreadsListPtr;  // for _threads_list_ptr, cmpxchg_threads_hazard_ptr(), {dec_,inc_,}nested_threads_hazard_ptr_cnt(), {g,s}et_threads_hazard_ptr(), inc_nested_handle_cnt(), tag_hazard_ptr() access
-  friend class ScanHazardPtrGatherProtectedThreadsClosure;  // for cmpxchg_threads_hazard_ptr(), get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
+  friend class ScanHazardPtrFindProtectedThreadClosure;  // for cmpxchg_threads_hazard_ptr(), get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
   friend class ScanHazardPtrGatherThreadsListClosure;  // for get_threads_hazard_ptr(), untag_hazard_ptr() access
   friend class ScanHazardPtrPrintMatchingThreadsClosure;  // for get_threads_hazard_ptr(), is_hazard_ptr_tagged() access
   friend class ThreadsSMRSupport;  // for _nested_threads_hazard_ptr_cnt, _threads_hazard_ptr, _threads_list_ptr access
@@ -333,8 +334,10 @@ class Thread: public ThreadShadow {
   // Active_handles points to a block of handles
   JNIHandleBlock* _active_handles;
 
-  // One-element thread local free list
+  // Thread local free list of JNI handle blocks, bounded by
+  // JNIHandleBlock::thread_free_list_limit
   JNIHandleBlock* _free_handle_block;
+  int _free_handle_block_count;
 
   // Point to the last handle mark
   HandleMark* _last_handle_mark;
@@ -394,8 +397,11 @@ class Thread: public ThreadShadow {
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
   ThreadHeapSampler _heap_sampler;              // For use when sampling the memory.
+  bool _pretenure_allocations;                  // Allocate objects in the old generation
+                                                // if the heap supports it
 
   ThreadStatisticalInfo _statistical_info;      // Statistics about the thread
+  HardwareCounterInterface* _hardware_counters; // Opened on first use with PhaseHardwareCounters
 
   JFR_ONLY(DEFINE_THREAD_LOCAL_FIELD_JFR;)      // Thread-local data for jfr
 
@@ -587,7 +593,11 @@ class Thread: public ThreadShadow {
   JNIHandleBlock* active_handles() const         { return _active_handles; }
   void set_active_handles(JNIHandleBlock* block) { _active_handles = block; }
   JNIHandleBlock* free_handle_block() const      { return _free_handle_block; }
-  void set_free_handle_block(JNIHandleBlock* block) { _free_handle_block = block; }
+  int free_handle_block_count() const            { return _free_handle_block_count; }
+  void set_free_handle_block(JNIHandleBlock* block, int count) {
+    _free_handle_block = block;
+    _free_handle_block_count = count;
+  }
 
   // Internal handle support
   HandleArea* handle_area() const                { return _handle_area; }
@@ -611,8 +621,14 @@ class Thread: public ThreadShadow {
 
   ThreadHeapSampler& heap_sampler()     { return _heap_sampler; }
 
+  bool pretenure_allocations() const    { return _pretenure_allocations; }
+  void set_pretenure_allocations(bool value) { _pretenure_allocations = value; }
+
   ThreadStatisticalInfo& statistical_info() { return _statistical_info; }
 
+  HardwareCounterInterface* hardware_counters() const { return _hardware_counters; }
+  void set_hardware_counters(HardwareCounterInterface* counters) { _hardware_counters = counters; }
+
   JFR_ONLY(DEFINE_THREAD_LOCAL_ACCESSOR_JFR;)
 
   bool is_trace_suspend()               { return (_suspend_flags & _trace_flag) != 0; }
@@ -1180,6 +1196,9 @@ class JavaThread: public Thread {
   // support for JNI critical regions
   jint    _jni_active_critical;                  // count of entries into JNI critical region
 
+  // Countdown used by C1 tier 3 code to sample call profile updates
+  jint    _profile_sample_counter;
+
   // Checked JNI: function name requires exception check
   char* _pending_jni_exception_check_fn;
 
@@ -1775,6 +1794,7 @@ class JavaThread: public Thread {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
   static ByteSize doing_unsafe_access_offset() { return byte_offset_of(JavaThread, _doing_unsafe_access); }
+  static ByteSize profile_sample_counter_offset() { return byte_offset_of(JavaThread, _profile_sample_counter); }
 
   // Returns the jni environment for this thread
   JNIEnv* jni_environment()                      { return &_jni_environment; }
@@ -201,53 +201,47 @@ class ThreadScanHashtable : public CHeapObj<mtThread> {
  public:
   // ResourceHashtable is passed to various functions and populated in
   // different places so we allocate it using C_HEAP to make it immune
-  // from any ResourceMarks that happen to be in the code paths.
-  ThreadScanHashtable(int table_size) : _table_size(table_size), _ptrs(new (ResourceObj::C_HEAP, mtThread) PtrTable()) {}
+  // from any ResourceMarks that happen to be in the code paths. Most
+  // scans find no pointer worth recording, so the table is only
+  // allocated by the first add_entry().
+  ThreadScanHashtable(int table_size) : _table_size(table_size), _ptrs(NULL) {}
 
   ~ThreadScanHashtable() { delete _ptrs; }
 
   bool has_entry(void *pointer) {
+    if (_ptrs == NULL) {
+      return false;
+    }
     int *val_ptr = _ptrs->get(pointer);
     return val_ptr != NULL && *val_ptr == 1;
   }
 
   void add_entry(void *pointer) {
+    if (_ptrs == NULL) {
+      _ptrs = new (ResourceObj::C_HEAP, mtThread) PtrTable();
+    }
     _ptrs->put(pointer, 1);
   }
 };
 
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 2
-// of the dance - adding all the JavaThreads referenced by the hazard
-// pointer (ThreadsList reference) to the hash table.
+// Closure to find out whether a JavaThread is indirectly referenced by
+// a hazard ptr (ThreadsList reference). Each distinct hazard-protected
+// ThreadsList is searched once; the table only records the lists that
+// have been searched, so the cost does not grow with the number of
+// hazard ptrs times the number of JavaThreads on their lists.
 //
-class AddThreadHazardPointerThreadClosure : public ThreadClosure {
+class ScanHazardPtrFindProtectedThreadClosure : public ThreadClosure {
  private:
+  JavaThread *_target;
+  // A list known not to contain _target, e.g. the current list.
+  ThreadsList *_excluded;
   ThreadScanHashtable *_table;
-
+  bool _found;
  public:
-  AddThreadHazardPointerThreadClosure(ThreadScanHashtable *table) : _table(table) {}
+  ScanHazardPtrFindProtectedThreadClosure(JavaThread *target, ThreadsList *excluded, ThreadScanHashtable *table) :
+    _target(target), _excluded(excluded), _table(table), _found(false) {}
 
-  virtual void do_thread(Thread *thread) {
-    if (!_table->has_entry((void*)thread)) {
-      // The same JavaThread might be on more than one ThreadsList or
-      // more than one thread might be using the same ThreadsList. In
-      // either case, we only need a single entry for a JavaThread.
-      _table->add_entry((void*)thread);
-    }
-  }
-};
-
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 1
-// of the dance - hazard ptr chain walking and dispatch to another
-// closure.
-//
-class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
- private:
-  ThreadScanHashtable *_table;
- public:
-  ScanHazardPtrGatherProtectedThreadsClosure(ThreadScanHashtable *table) : _table(table) {}
+  bool found() const { return _found; }
 
   virtual void do_thread(Thread *thread) {
     assert_locked_or_safepoint(Threads_lock);
@@ -284,18 +278,27 @@ class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
     // ThreadsList that has been removed but not freed. In either case,
     // the hazard ptr is protecting all the JavaThreads on that
     // ThreadsList.
-    AddThreadHazardPointerThreadClosure add_cl(_table);
-    current_list->threads_do(&add_cl);
+    if (_found || current_list == _excluded || _table->has_entry((void*)current_list)) {
+      return;
+    }
+    // The same ThreadsList is usually shared by many hazard ptrs; only
+    // search it the first time it is seen.
+    _table->add_entry((void*)current_list);
+    _found = current_list->includes(_target);
   }
 };
 
 // Closure to gather hazard ptrs (ThreadsList references) into a hash table.
+// Hazard ptrs to the excluded list, which is the current list and so not
+// a candidate for freeing, are not recorded.
 //
 class ScanHazardPtrGatherThreadsListClosure : public ThreadClosure {
  private:
   ThreadScanHashtable *_table;
+  ThreadsList *_excluded;
  public:
-  ScanHazardPtrGatherThreadsListClosure(ThreadScanHashtable *table) : _table(table) {}
+  ScanHazardPtrGatherThreadsListClosure(ThreadScanHashtable *table, ThreadsList *excluded) :
+    _table(table), _excluded(excluded) {}
 
   virtual void do_thread(Thread* thread) {
     assert_locked_or_safepoint(Threads_lock);
@@ -311,7 +314,7 @@ class ScanHazardPtrGatherThreadsListClosure : public ThreadClosure {
     // published), then the only side effect is that we might keep a
     // to-be-deleted ThreadsList alive a little longer.
     threads = Thread::untag_hazard_ptr(threads);
-    if (!_table->has_entry((void*)threads)) {
+    if (threads != _excluded && !_table->has_entry((void*)threads)) {
       _table->add_entry((void*)threads);
     }
   }
@@ -821,7 +824,7 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
 
   // Gather a hash table of the current hazard ptrs:
   ThreadScanHashtable *scan_table = new ThreadScanHashtable(hash_table_size);
-  ScanHazardPtrGatherThreadsListClosure scan_cl(scan_table);
+  ScanHazardPtrGatherThreadsListClosure scan_cl(scan_table, get_java_thread_list());
   threads_do(&scan_cl);
   OrderAccess::acquire(); // Must order reads of hazard ptr before reads of
                           // nested reference counters
@@ -882,32 +885,34 @@ bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
   hash_table_size |= hash_table_size >> 16;
   hash_table_size++;
 
-  // Gather a hash table of the JavaThreads indirectly referenced by
-  // hazard ptrs.
+  // An exiting JavaThread has already been removed from the current
+  // list, so hazard ptrs to it, which are the common case, need not be
+  // searched.
+  ThreadsList* current_list = get_java_thread_list();
+  ThreadsList* excluded = current_list->includes(thread) ? NULL : current_list;
+
+  // Search the distinct ThreadsLists referenced by hazard ptrs.
   ThreadScanHashtable *scan_table = new ThreadScanHashtable(hash_table_size);
-  ScanHazardPtrGatherProtectedThreadsClosure scan_cl(scan_table);
+  ScanHazardPtrFindProtectedThreadClosure scan_cl(thread, excluded, scan_table);
   threads_do(&scan_cl);
   OrderAccess::acquire(); // Must order reads of hazard ptr before reads of
                           // nested reference counters
 
+  bool thread_is_protected = scan_cl.found();
+
   // Walk through the linked list of pending freeable ThreadsLists
-  // and include the ones that are currently in use by a nested
-  // ThreadsListHandle in the search set.
+  // and search the ones that are currently in use by a nested
+  // ThreadsListHandle.
   ThreadsList* current = _to_delete_list;
-  while (current != NULL) {
-    if (current->_nested_handle_cnt != 0) {
+  while (!thread_is_protected && current != NULL) {
+    if (current->_nested_handle_cnt != 0 && !scan_table->has_entry((void*)current)) {
       // 'current' is in use by a nested ThreadsListHandle so the hazard
       // ptr is protecting all the JavaThreads on that ThreadsList.
-      AddThreadHazardPointerThreadClosure add_cl(scan_table);
-      current->threads_do(&add_cl);
+      thread_is_protected = current->includes(thread);
     }
     current = current->next_list();
   }
 
-  bool thread_is_protected = false;
-  if (scan_table->has_entry((void*)thread)) {
-    thread_is_protected = true;
-  }
   delete scan_table;
   return thread_is_protected;
 }
@@ -226,6 +226,8 @@ VM_Operation*     VMThread::_cur_vm_operation   = NULL;
 VMOperationQueue* VMThread::_vm_queue           = NULL;
 PerfCounter*      VMThread::_perf_accumulated_vm_operation_time = NULL;
 uint64_t          VMThread::_coalesced_count = 0;
+uint64_t          VMThread::_elided_no_op_count = 0;
+uint64_t          VMThread::_operation_time_histogram[VM_Operation::VMOp_Terminating][VMThread::operation_time_buckets] = {{0}};
 VMOperationTimeoutTask* VMThread::_timeout_task = NULL;
 
 
@@ -375,7 +377,7 @@ void VMThread::wait_for_vm_thread_exit() {
   }
 }
 
-static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation* op) {
+static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation* op, bool coalesced) {
   assert(event != NULL, "invariant");
   assert(event->should_commit(), "invariant");
   assert(op != NULL, "invariant");
@@ -389,10 +391,39 @@ static void post_vm_operation_event(EventExecuteVMOperation* event, VM_Operation
   // This is because the caller thread could have exited already.
   event->set_caller(is_concurrent ? 0 : JFR_THREAD_ID(op->calling_thread()));
   event->set_safepointId(evaluate_at_safepoint ? SafepointSynchronize::safepoint_id() : 0);
+  event->set_coalesced(coalesced);
   event->commit();
 }
 
-void VMThread::evaluate_operation(VM_Operation* op) {
+void VMThread::record_operation_time(VM_Operation::VMOp_Type type, jlong elapsed_ns) {
+  julong elapsed_us = (julong)MAX2(elapsed_ns, (jlong)0) / (NANOUNITS / MICROUNITS);
+  int bucket = (elapsed_us == 0) ? 0 : log2_long(elapsed_us) + 1;
+  _operation_time_histogram[type][MIN2(bucket, operation_time_buckets - 1)]++;
+}
+
+void VMThread::print_operation_time_histogram(outputStream* st) {
+  st->print("%-28s", "VM Operation time (us)");
+  for (int i = 0; i < operation_time_buckets - 1; i++) {
+    st->print(" %9s" UINT64_FORMAT_W(-6), "<", (uint64_t)1 << i);
+  }
+  st->print_cr(" %9s" UINT64_FORMAT_W(-6), ">=", (uint64_t)1 << (operation_time_buckets - 2));
+  for (int type = 0; type < VM_Operation::VMOp_Terminating; type++) {
+    uint64_t total = 0;
+    for (int i = 0; i < operation_time_buckets; i++) {
+      total += _operation_time_histogram[type][i];
+    }
+    if (total == 0) {
+      continue;
+    }
+    st->print("%-28s", VM_Operation::name(type));
+    for (int i = 0; i < operation_time_buckets; i++) {
+      st->print(" " UINT64_FORMAT_W(15), _operation_time_histogram[type][i]);
+    }
+    st->cr();
+  }
+}
+
+void VMThread::evaluate_operation(VM_Operation* op, bool coalesced) {
   ResourceMark rm;
 
   {
@@ -402,9 +433,11 @@ void VMThread::evaluate_operation(VM_Operation* op) {
                      op->evaluation_mode());
 
     EventExecuteVMOperation event;
+    jlong start_ns = os::javaTimeNanos();
     op->evaluate();
+    record_operation_time(op->type(), os::javaTimeNanos() - start_ns);
     if (event.should_commit()) {
-      post_vm_operation_event(&event, op);
+      post_vm_operation_event(&event, op, coalesced);
     }
 
     HOTSPOT_VMOPS_END(
@@ -450,7 +483,20 @@ VM_Operation* VMThread::no_op_safepoint() {
   long interval_ms = SafepointTracing::time_since_last_safepoint_ms();
   bool max_time_exceeded = GuaranteedSafepointInterval != 0 &&
                            (interval_ms >= GuaranteedSafepointInterval);
-  if (max_time_exceeded && SafepointSynchronize::is_cleanup_needed()) {
+  bool cleanup = max_time_exceeded && SafepointSynchronize::is_cleanup_needed();
+  if (!cleanup && !SafepointALot) {
+    // Nothing to be done.
+    return NULL;
+  }
+  // A pending safepoint operation will be started shortly, and every
+  // safepoint does the cleanup work, so don't stop the world twice in a
+  // row. The unlocked peek can miss a racing enqueue, which only costs
+  // the extra safepoint we would have had anyway.
+  if (_vm_queue->peek_at_safepoint_priority()) {
+    _elided_no_op_count++;
+    return NULL;
+  }
+  if (cleanup) {
     return &cleanup_op;
   }
   if (SafepointALot) {
@@ -549,7 +595,7 @@ void VMThread::loop() {
           _timeout_task->arm();
         }
 
-        evaluate_operation(_cur_vm_operation);
+        evaluate_operation(_cur_vm_operation, false);
         // now process all queued safepoint ops, iteratively draining
         // the queue until there are none left
         do {
@@ -562,7 +608,7 @@ void VMThread::loop() {
               // to grab the next op now
               VM_Operation* next = _cur_vm_operation->next();
               _vm_queue->set_drain_list(next);
-              evaluate_operation(_cur_vm_operation);
+              evaluate_operation(_cur_vm_operation, true);
               _cur_vm_operation = next;
               _coalesced_count++;
             } while (_cur_vm_operation != NULL);
@@ -601,7 +647,7 @@ void VMThread::loop() {
         if (TraceLongCompiles) {
           elapsedTimer t;
           t.start();
-          evaluate_operation(_cur_vm_operation);
+          evaluate_operation(_cur_vm_operation, false);
           t.stop();
           double secs = t.seconds();
           if (secs * 1e3 > LongCompileThreshold) {
@@ -611,7 +657,7 @@ void VMThread::loop() {
             tty->print_cr("vm %s: %3.7f secs]", _cur_vm_operation->name(), secs);
           }
         } else {
-          evaluate_operation(_cur_vm_operation);
+          evaluate_operation(_cur_vm_operation, false);
         }
 
         _cur_vm_operation = NULL;
@@ -120,12 +120,21 @@ class VMThread: public NamedThread {
   static Monitor * _terminate_lock;
   static PerfCounter* _perf_accumulated_vm_operation_time;
   static uint64_t _coalesced_count;
+  static uint64_t _elided_no_op_count;
+
+  // Per operation type histogram of evaluation times. Bucket i counts
+  // operations that took less than 2^i microseconds; the last bucket
+  // also counts everything slower.
+  static const int operation_time_buckets = 16;
+  static uint64_t _operation_time_histogram[VM_Operation::VMOp_Terminating][operation_time_buckets];
 
   static VMOperationTimeoutTask* _timeout_task;
 
   static VM_Operation* no_op_safepoint();
 
-  void evaluate_operation(VM_Operation* op);
+  static void record_operation_time(VM_Operation::VMOp_Type type, jlong elapsed_ns);
+
+  void evaluate_operation(VM_Operation* op, bool coalesced);
 
  public:
   // Constructor
@@ -156,6 +165,10 @@ class VMThread: public NamedThread {
   static VM_Operation* vm_operation()             { return _cur_vm_operation; }
   static VM_Operation::VMOp_Type vm_op_type()     { return _cur_vm_operation->type(); }
   static uint64_t get_coalesced_count()           { return _coalesced_count; }
+  static uint64_t get_elided_no_op_count()        { return _elided_no_op_count; }
+
+  // Prints the evaluation time histograms of all operation types seen.
+  static void print_operation_time_histogram(outputStream* st);
 
   // Returns the single instance of VMThread.
   static VMThread* vm_thread()                    { return _vm_thread; }
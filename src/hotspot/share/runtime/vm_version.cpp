@@ -27,6 +27,7 @@
 #include "logging/logStream.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/vm_version.hpp"
 
 const char* Abstract_VM_Version::_s_vm_release = Abstract_VM_Version::vm_release();
@@ -294,9 +295,35 @@ unsigned int Abstract_VM_Version::jvm_version() {
          (Abstract_VM_Version::vm_build_number() & 0xFF);
 }
 
+// The stubs behind these intrinsics are only called from compiled code.
+// Turn them off in interpreter-only mode so that StubRoutines does not
+// spend startup time generating them.
+static void disable_compiler_only_intrinsics() {
+  FLAG_SET_DEFAULT(UseAESIntrinsics, false);
+  FLAG_SET_DEFAULT(UseAESCTRIntrinsics, false);
+  FLAG_SET_DEFAULT(UseSHA1Intrinsics, false);
+  FLAG_SET_DEFAULT(UseSHA256Intrinsics, false);
+  FLAG_SET_DEFAULT(UseSHA512Intrinsics, false);
+  FLAG_SET_DEFAULT(UseGHASHIntrinsics, false);
+  FLAG_SET_DEFAULT(UseBASE64Intrinsics, false);
+  FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
+  FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+#ifdef COMPILER2
+  FLAG_SET_DEFAULT(UseMultiplyToLenIntrinsic, false);
+  FLAG_SET_DEFAULT(UseSquareToLenIntrinsic, false);
+  FLAG_SET_DEFAULT(UseMulAddIntrinsic, false);
+  FLAG_SET_DEFAULT(UseMontgomeryMultiplyIntrinsic, false);
+  FLAG_SET_DEFAULT(UseMontgomerySquareIntrinsic, false);
+#endif // COMPILER2
+}
+
 void VM_Version_init() {
   VM_Version::initialize();
 
+  if (Arguments::is_interpreter_only()) {
+    disable_compiler_only_intrinsics();
+  }
+
   if (log_is_enabled(Info, os, cpu)) {
     char buf[1024];
     ResourceMark rm;
@@ -260,6 +260,7 @@ jint dump_heap(AttachOperation* op, outputStream* out) {
 // Input arguments :-
 //   arg0: "-live" or "-all"
 //   arg1: Name of the dump file or NULL
+//   arg2: Number of threads iterating the heap, 0 or NULL for all GC workers
 static jint heap_inspection(AttachOperation* op, outputStream* out) {
   bool live_objects_only = true;   // default is true to retain the behavior before this change is made
   outputStream* os = out;   // if path not specified or path is NULL, use out
@@ -273,6 +274,19 @@ static jint heap_inspection(AttachOperation* op, outputStream* out) {
     live_objects_only = strcmp(arg0, "-live") == 0;
   }
 
+  uint parallel_thread_num = 0;
+  const char* num_str = op->arg(2);
+  if (num_str != NULL && num_str[0] != '\0') {
+    char* end = NULL;
+    errno = 0;
+    julong num = strtoull(num_str, &end, 10);
+    if (errno != 0 || *end != '\0' || !isdigit(num_str[0]) || num > UINT_MAX) {
+      out->print_cr("Invalid parallel thread number: [%s]", num_str);
+      return JNI_ERR;
+    }
+    parallel_thread_num = (uint) num;
+  }
+
   const char* path = op->arg(1);
   if (path != NULL) {
     if (path[0] == '\0') {
@@ -288,7 +302,8 @@ static jint heap_inspection(AttachOperation* op, outputStream* out) {
     }
   }
 
-  VM_GC_HeapInspection heapop(os, live_objects_only /* request full gc */);
+  VM_GC_HeapInspection heapop(os, live_objects_only /* request full gc */,
+                              parallel_thread_num);
   VMThread::execute(&heapop);
   if (os != NULL && os != out) {
     out->print_cr("Heap inspection file created: %s", path);
@@ -28,6 +28,8 @@
 #include "classfile/classLoaderStats.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "compiler/hotMethodList.hpp"
+#include "gc/shared/allocationTrace.hpp"
 #include "gc/shared/gcVMOperations.hpp"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
@@ -40,6 +42,7 @@
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
@@ -89,6 +92,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<AllocationTraceReplayDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemDictionaryDCmd>(full_export, true, false));
@@ -97,6 +101,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<StringtableDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<metaspace::MetaspaceDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<EventLogDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<MutexStatsDCmd>(full_export, true, false));
 #if INCLUDE_JVMTI // Both JVMTI and SERVICES have to be enabled to have this dcmd
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<JVMTIAgentLoadDCmd>(full_export, true, false));
 #endif // INCLUDE_JVMTI
@@ -109,6 +114,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderHierarchyDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HotMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
@@ -506,17 +512,41 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _gzip("-gz", "If specified, the heap dump is written in gzipped format "
+               "using the given compression level. 1 (recommended) is the fastest, "
+               "9 the strongest compression.", "INT", false, "1"),
+  _parallel("-parallel", "Number of threads dumping the heap objects in parallel. "
+                         "0 uses all GC worker threads available.", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
   _dcmdparser.add_dcmd_argument(&_filename);
+  _dcmdparser.add_dcmd_option(&_gzip);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
+  jlong level = -1; // -1 means no compression.
+
+  if (_gzip.is_set()) {
+    level = _gzip.value();
+
+    if (level < 1 || level > 9) {
+      output()->print_cr("Compression level out of range (1-9): " JLONG_FORMAT, level);
+      return;
+    }
+  }
+
+  jlong parallel = _parallel.value();
+  if (parallel < 0 || parallel > UINT_MAX) {
+    output()->print_cr("Invalid number of parallel dump threads: " JLONG_FORMAT, parallel);
+    return;
+  }
+
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), (int) level, (uint) parallel);
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -542,16 +572,50 @@ int HeapDumpDCmd::num_arguments() {
   }
 }
 
+AllocationTraceReplayDCmd::AllocationTraceReplayDCmd(outputStream* output, bool heap) :
+                                                     DCmdWithParser(output, heap),
+  _filename("filename", "Name of the allocation trace file", "STRING", true),
+  _fast("-fast", "Replay as fast as possible instead of at the recorded pace",
+        "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_fast);
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void AllocationTraceReplayDCmd::execute(DCmdSource source, TRAPS) {
+  AllocationTraceReplayer::replay(_filename.value(), !_fast.value(), output(), THREAD);
+}
+
+int AllocationTraceReplayDCmd::num_arguments() {
+  ResourceMark rm;
+  AllocationTraceReplayDCmd* dcmd = new AllocationTraceReplayDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
                                        DCmdWithParser(output, heap),
   _all("-all", "Inspect all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of threads iterating the heap in parallel. "
+                         "0 uses all GC worker threads available.", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
+  jlong parallel = _parallel.value();
+  if (parallel < 0 || parallel > UINT_MAX) {
+    output()->print_cr("Invalid number of parallel threads: " JLONG_FORMAT, parallel);
+    return;
+  }
+
   VM_GC_HeapInspection heapop(output(),
-                              !_all.value() /* request full gc if false */);
+                              !_all.value() /* request full gc if false */,
+                              (uint) parallel);
   VMThread::execute(&heapop);
 }
 
@@ -938,6 +1002,10 @@ void CodeListDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_codelist(output());
 }
 
+void HotMethodsDCmd::execute(DCmdSource source, TRAPS) {
+  HotMethodList::print_on(output());
+}
+
 void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
@@ -974,6 +1042,28 @@ int CodeHeapAnalyticsDCmd::num_arguments() {
 }
 //---<  END  >--- CodeHeap State Analytics.
 
+MutexStatsDCmd::MutexStatsDCmd(outputStream* output, bool heap) :
+  DCmdWithParser(output, heap),
+  _reset("-reset", "Reset the statistics after printing them", "BOOLEAN", false, "false")
+{
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void MutexStatsDCmd::execute(DCmdSource source, TRAPS) {
+  print_lock_stats_on(output(), _reset.value());
+}
+
+int MutexStatsDCmd::num_arguments() {
+  ResourceMark rm;
+  MutexStatsDCmd* dcmd = new MutexStatsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 EventLogDCmd::EventLogDCmd(outputStream* output, bool heap) :
   DCmdWithParser(output, heap),
   _log("log", "Name of log to be printed. If omitted, all logs are printed.", "STRING", false, NULL),
@@ -330,6 +330,8 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _gzip;
+  DCmdArgument<jlong> _parallel;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -350,12 +352,38 @@ public:
   static int num_arguments();
   virtual void execute(DCmdSource source, TRAPS);
 };
+
+class AllocationTraceReplayDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+  DCmdArgument<bool>  _fast;
+public:
+  AllocationTraceReplayDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.replay_allocation_trace";
+  }
+  static const char* description() {
+    return "Replay an allocation trace recorded with -XX:AllocationTraceFile.";
+  }
+  static const char* impact() {
+    return "High: Allocates and retains as much memory as the recorded "
+           "application did, for as long as the trace lasts.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
 #endif // INCLUDE_SERVICES
 
 // See also: inspectheap in attachListener.cpp
 class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
+  DCmdArgument<jlong> _parallel;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -619,6 +647,26 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class HotMethodsDCmd : public DCmd {
+public:
+  HotMethodsDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.hotmethods";
+  }
+  static const char* description() {
+    return "Print the methods with C2 code in the format read by -XX:HotMethodsFile";
+  }
+  static const char* impact() {
+    return "Medium";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
 
 class CodeCacheDCmd : public DCmd {
 public:
@@ -888,6 +936,29 @@ public:
 };
 #endif // INCLUDE_JVMTI
 
+class MutexStatsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  MutexStatsDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "VM.mutex_stats";
+  }
+  static const char* description() {
+    return "Print acquisition and contention statistics of VM internal locks (requires -XX:+ProfileVMLocks).";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class EventLogDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _log;
@@ -54,7 +54,7 @@ class HeapDumper : public StackObj {
 
   // string representation of error
   char* error() const                   { return _error; }
-  void set_error(char* error);
+  void set_error(char const* error);
 
   // indicates if progress messages can be sent to tty
   bool print_to_tty() const             { return _print_to_tty; }
@@ -71,7 +71,10 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // compression > 0 creates a gzipped file with the given compression level.
+  // num_dump_threads > 0 limits the number of threads dumping heap objects in
+  // parallel; 0 uses all available worker threads.
+  int dump(const char* path, int compression = -1, uint num_dump_threads = 0);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -30,6 +30,7 @@
 #include "memory/allocation.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/threadCritical.hpp"
+#include "runtime/threadLocalStorage.hpp"
 #include "services/nmtCommon.hpp"
 #include "utilities/nativeCallStack.hpp"
 
@@ -84,6 +85,85 @@ class MemoryCounter {
 
 };
 
+/*
+ * A counter with the same interface as MemoryCounter, for the summary
+ * counters that every os::malloc() and os::free() updates. The counter
+ * is split into stripes that are a cache line apart, and each thread
+ * updates the stripe picked by its Thread pointer. Threads that allocate
+ * the same type of memory concurrently then mostly update different
+ * cache lines. Reads sum up the stripes. A stripe may wrap below zero
+ * when memory is freed by another thread than the one that allocated it,
+ * the sum is still exact.
+ */
+class StripedMemoryCounter {
+ private:
+  enum { stripe_count = 8 };
+
+  struct Stripe {
+    volatile size_t   _count;
+    volatile size_t   _size;
+    char              _pad[DEFAULT_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+  };
+
+  Stripe _stripes[stripe_count];
+
+  static inline int stripe_index() {
+    // Threads not yet attached, or allocations before TLS is set up,
+    // all share the first stripe.
+    if (!ThreadLocalStorage::is_initialized()) {
+      return 0;
+    }
+    uintptr_t h = (uintptr_t)ThreadLocalStorage::thread() >> LogBytesPerWord;
+    h ^= h >> 7;
+    h ^= h >> 13;
+    return (int)(h & (stripe_count - 1));
+  }
+
+  inline Stripe* stripe() {
+    return &_stripes[stripe_index()];
+  }
+
+ public:
+  StripedMemoryCounter() {
+    for (int i = 0; i < stripe_count; i++) {
+      _stripes[i]._count = 0;
+      _stripes[i]._size = 0;
+    }
+  }
+
+  inline void allocate(size_t sz) {
+    Stripe* const s = stripe();
+    Atomic::inc(&s->_count);
+    if (sz > 0) {
+      Atomic::add(sz, &s->_size);
+    }
+  }
+
+  inline void deallocate(size_t sz) {
+    Stripe* const s = stripe();
+    Atomic::dec(&s->_count);
+    if (sz > 0) {
+      Atomic::sub(sz, &s->_size);
+    }
+  }
+
+  inline size_t count() const {
+    size_t sum = 0;
+    for (int i = 0; i < stripe_count; i++) {
+      sum += _stripes[i]._count;
+    }
+    return sum;
+  }
+
+  inline size_t size() const {
+    size_t sum = 0;
+    for (int i = 0; i < stripe_count; i++) {
+      sum += _stripes[i]._size;
+    }
+    return sum;
+  }
+};
+
 /*
  * Malloc memory used by a particular subsystem.
  * It includes the memory acquired through os::malloc()
@@ -91,7 +171,7 @@ class MemoryCounter {
  */
 class MallocMemory {
  private:
-  MemoryCounter _malloc;
+  StripedMemoryCounter _malloc;
   MemoryCounter _arena;
 
  public:
@@ -122,7 +202,7 @@ class MallocMemory {
   inline size_t arena_size()   const { return _arena.size();  }
   inline size_t arena_count()  const { return _arena.count(); }
 
-  DEBUG_ONLY(inline const MemoryCounter& malloc_counter() const { return _malloc; })
+  DEBUG_ONLY(inline const StripedMemoryCounter& malloc_counter() const { return _malloc; })
   DEBUG_ONLY(inline const MemoryCounter& arena_counter()  const { return _arena;  })
 };
 
@@ -134,8 +214,8 @@ class MallocMemorySnapshot : public ResourceObj {
   friend class MallocMemorySummary;
 
  private:
-  MallocMemory      _malloc[mt_number_of_types];
-  MemoryCounter     _tracking_header;
+  MallocMemory         _malloc[mt_number_of_types];
+  StripedMemoryCounter _tracking_header;
 
 
  public:
@@ -150,7 +230,7 @@ class MallocMemorySnapshot : public ResourceObj {
     return &_malloc[index];
   }
 
-  inline MemoryCounter* malloc_overhead() {
+  inline StripedMemoryCounter* malloc_overhead() {
     return &_tracking_header;
   }
 
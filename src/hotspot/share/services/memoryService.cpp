@@ -25,6 +25,8 @@
 #include "precompiled.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "gc/shared/allocationSiteProfile.hpp"
+#include "gc/shared/allocationTrace.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "logging/logConfiguration.hpp"
 #include "memory/heap.hpp"
@@ -187,6 +189,8 @@ void MemoryService::gc_end(GCMemoryManager* manager, bool recordPostGCUsage,
   // register the GC end statistics and memory usage
   manager->gc_end(recordPostGCUsage, recordAccumulatedGCTime, recordGCEndTime,
                   countCollection, cause, allMemoryPoolsAffected);
+  AllocationTraceRecorder::report_gc_end();
+  AllocationSiteProfile::report_gc_end();
 }
 
 void MemoryService::oops_do(OopClosure* f) {
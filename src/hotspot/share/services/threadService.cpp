@@ -35,6 +35,7 @@
 #include "prims/jvmtiRawMonitor.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/thread.inline.hpp"
@@ -300,19 +301,67 @@ void ThreadService::remove_thread_dump(ThreadDumpResult* dump) {
 // Dump stack trace of threads specified in the given threads array.
 // Returns StackTraceElement[][] each element is the stack trace of a thread in
 // the corresponding entry in the given threads array
+// Captures the stack trace of a single thread while it is stopped in a handshake.
+class StackTraceHandshakeClosure : public ThreadClosure {
+ private:
+  ThreadSnapshot* _snapshot;
+  int _max_depth;
+ public:
+  StackTraceHandshakeClosure(ThreadSnapshot* snapshot, int max_depth) :
+    _snapshot(snapshot), _max_depth(max_depth) {}
+
+  void do_thread(Thread* th) {
+    assert(th->is_Java_thread(), "invariant");
+    ResourceMark rm;
+    HandleMark hm;
+    _snapshot->dump_stack_in_handshake((JavaThread*)th, _max_depth);
+  }
+};
+
+// Without locked monitors or synchronizers a stack trace only concerns its
+// own thread, so each thread is stopped in turn with a handshake instead of
+// stopping all of them at a safepoint. The traces are then not taken at the
+// same instant, which Thread.getAllStackTraces does not promise anyway.
+static void dump_stack_traces_with_handshakes(ThreadDumpResult* dump_result,
+                                              GrowableArray<instanceHandle>* threads,
+                                              int num_threads) {
+  // Protect the JavaThreads we handshake with until the dump is done.
+  dump_result->set_t_list();
+  for (int i = 0; i < num_threads; i++) {
+    // A snapshot without a stack trace is left for threads that are not
+    // alive, are exiting or are hidden, like VM_ThreadDump does.
+    ThreadSnapshot* snapshot = dump_result->add_thread_snapshot();
+    oop thread_obj = threads->at(i)();
+    if (thread_obj == NULL) {
+      continue;
+    }
+    JavaThread* jt = java_lang_Thread::thread(thread_obj);
+    if (jt == NULL || !dump_result->t_list()->includes(jt) ||
+        jt->is_exiting() || jt->is_hidden_from_external_view()) {
+      continue;
+    }
+    StackTraceHandshakeClosure cl(snapshot, -1 /* entire stack */);
+    Handshake::execute(&cl, jt);
+  }
+}
+
 Handle ThreadService::dump_stack_traces(GrowableArray<instanceHandle>* threads,
                                         int num_threads,
                                         TRAPS) {
   assert(num_threads > 0, "just checking");
 
   ThreadDumpResult dump_result;
-  VM_ThreadDump op(&dump_result,
-                   threads,
-                   num_threads,
-                   -1,    /* entire stack */
-                   false, /* with locked monitors */
-                   false  /* with locked synchronizers */);
-  VMThread::execute(&op);
+  if (ThreadLocalHandshakes) {
+    dump_stack_traces_with_handshakes(&dump_result, threads, num_threads);
+  } else {
+    VM_ThreadDump op(&dump_result,
+                     threads,
+                     num_threads,
+                     -1,    /* entire stack */
+                     false, /* with locked monitors */
+                     false  /* with locked synchronizers */);
+    VMThread::execute(&op);
+  }
 
   // Allocate the resulting StackTraceElement[][] object
 
@@ -658,7 +707,9 @@ ThreadStackTrace::~ThreadStackTrace() {
 }
 
 void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+  assert(SafepointSynchronize::is_at_safepoint() ||
+         (!_with_locked_monitors && (Thread::current() == _thread || Thread::current()->is_VM_thread())),
+         "all threads are stopped, or the thread is stopped in a handshake");
 
   if (_thread->has_last_Java_frame()) {
     RegisterMap reg_map(_thread);
@@ -931,6 +982,12 @@ void ThreadSnapshot::dump_stack_at_safepoint(int max_depth, bool with_locked_mon
   _stack_trace->dump_stack_at_safepoint(max_depth);
 }
 
+void ThreadSnapshot::dump_stack_in_handshake(JavaThread* thread, int max_depth) {
+  assert(_stack_trace == NULL, "only once");
+  _stack_trace = new ThreadStackTrace(thread, false /* with_locked_monitors */);
+  _stack_trace->dump_stack_at_safepoint(max_depth);
+}
+
 
 void ThreadSnapshot::oops_do(OopClosure* f) {
   f->do_oop(&_threadObj);
@@ -432,6 +432,11 @@ class ConcurrentHashTable : public CHeapObj<F> {
     return internal_remove(thread, lookup_f, noOp);
   }
 
+  // Destroys the items in the bucket for LOOKUP_FUNC's hash which
+  // LOOKUP_FUNC reports as dead, without visiting any other bucket.
+  template <typename LOOKUP_FUNC>
+  void delete_dead_in_bucket(Thread* thread, LOOKUP_FUNC& lookup_f);
+
   // Visit all items with SCAN_FUNC if no concurrent resize. Takes the resize
   // lock to avoid concurrent resizes. Else returns false.
   template <typename SCAN_FUNC>
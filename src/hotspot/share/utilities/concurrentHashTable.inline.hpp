@@ -564,6 +564,16 @@ inline void ConcurrentHashTable<CONFIG, F>::
   }
 }
 
+template <typename CONFIG, MEMFLAGS F>
+template <typename LOOKUP_FUNC>
+inline void ConcurrentHashTable<CONFIG, F>::
+  delete_dead_in_bucket(Thread* thread, LOOKUP_FUNC& lookup_f)
+{
+  Bucket* bucket = get_bucket_locked(thread, lookup_f.get_hash());
+  delete_in_bucket(thread, bucket, lookup_f);
+  bucket->unlock();
+}
+
 template <typename CONFIG, MEMFLAGS F>
 inline typename ConcurrentHashTable<CONFIG, F>::Bucket*
 ConcurrentHashTable<CONFIG, F>::
@@ -30,6 +30,13 @@
 
 // This inline file contains BulkDeleteTask and GrowTasks which are both bucket
 // operations, which they are serialized with each other.
+//
+// Both tasks may be driven by several threads: one thread calls prepare(),
+// which takes the resize lock, then any number of threads call do_task()
+// until it returns false, and once they have all finished the preparing
+// thread calls done(). Ranges are claimed atomically. A BulkDeleteTask
+// shared between threads must be created with is_mt. Only the preparing
+// thread may use pause() and cont().
 
 // Base class for pause and/or parallel bulk operations.
 template <typename CONFIG, MEMFLAGS F>
@@ -29,9 +29,11 @@
 #include "memory/allocation.inline.hpp"
 #include "utilities/elfFuncDescTable.hpp"
 #include "utilities/elfSymbolTable.hpp"
+#include "utilities/quickSort.hpp"
 
 ElfSymbolTable::ElfSymbolTable(FILE* const file, Elf_Shdr& shdr) :
-  _next(NULL), _fd(file), _section(file, shdr) {
+  _next(NULL), _fd(file), _section(file, shdr), _sorted(NULL), _sorted_count(0),
+  _sorted_built(false), _use_sorted(false), _sorted_func_desc_table(NULL) {
   assert(file != NULL, "null file handle");
   _status = _section.status();
 
@@ -44,19 +46,96 @@ ElfSymbolTable::~ElfSymbolTable() {
   if (_next != NULL) {
     delete _next;
   }
+  if (_sorted != NULL) {
+    FREE_C_HEAP_ARRAY(SortedSymbol, _sorted);
+  }
+}
+
+address ElfSymbolTable::symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable) {
+  if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
+    // We need to go another step trough the function descriptor table (currently PPC64 only)
+    return funcDescTable->lookup(sym->st_value);
+  } else {
+    return (address)sym->st_value;
+  }
+}
+
+int ElfSymbolTable::compare_by_address(SortedSymbol a, SortedSymbol b) {
+  if (a._addr != b._addr) {
+    return a._addr < b._addr ? -1 : 1;
+  }
+  // keep table order for aliases, as the linear scan would find them
+  return a._index - b._index;
+}
+
+void ElfSymbolTable::build_sorted_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable) {
+  _sorted_built = true;
+  int n = 0;
+  for (int index = 0; index < count; index++) {
+    if (STT_FUNC == ELF_ST_TYPE(symbols[index].st_info) && symbols[index].st_size > 0) {
+      n++;
+    }
+  }
+  SortedSymbol* sorted = NULL;
+  if (n > 0) {
+    sorted = NEW_C_HEAP_ARRAY_RETURN_NULL(SortedSymbol, n, mtInternal);
+    if (sorted == NULL) {
+      // not enough memory, keep scanning linearly
+      return;
+    }
+    int i = 0;
+    for (int index = 0; index < count; index++) {
+      const Elf_Sym* sym = &symbols[index];
+      if (STT_FUNC == ELF_ST_TYPE(sym->st_info) && sym->st_size > 0) {
+        sorted[i]._addr = symbol_address(sym, funcDescTable);
+        sorted[i]._index = index;
+        i++;
+      }
+    }
+    QuickSort::sort(sorted, n, compare_by_address, false);
+  }
+  _sorted = sorted;
+  _sorted_count = n;
+  _sorted_func_desc_table = funcDescTable;
+  _use_sorted = true;
+}
+
+bool ElfSymbolTable::lookup_sorted(const Elf_Sym* symbols, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
+  // find the first symbol that starts above addr
+  int lo = 0;
+  int hi = _sorted_count;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (_sorted[mid]._addr <= addr) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // Look back over the closest preceding symbols; a few are enough for
+  // nested symbols. Among aliases prefer the one first in the table.
+  const int max_probes = 8;
+  int found = -1;
+  for (int i = lo - 1; i >= 0 && i >= lo - max_probes; i--) {
+    if (found != -1 && _sorted[i]._addr != _sorted[found]._addr) {
+      break;
+    }
+    if ((Elf_Word)(addr - _sorted[i]._addr) < symbols[_sorted[i]._index].st_size) {
+      found = i;
+    }
+  }
+  if (found == -1) {
+    return false;
+  }
+  return compare(&symbols[_sorted[found]._index], addr, stringtableIndex, posIndex, offset, funcDescTable);
 }
 
 bool ElfSymbolTable::compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable) {
   if (STT_FUNC == ELF_ST_TYPE(sym->st_info)) {
     Elf_Word st_size = sym->st_size;
     const Elf_Shdr* shdr = _section.section_header();
-    address sym_addr;
-    if (funcDescTable != NULL && funcDescTable->get_index() == sym->st_shndx) {
-      // We need to go another step trough the function descriptor table (currently PPC64 only)
-      sym_addr = funcDescTable->lookup(sym->st_value);
-    } else {
-      sym_addr = (address)sym->st_value;
-    }
+    address sym_addr = symbol_address(sym, funcDescTable);
     if (sym_addr <= addr && (Elf_Word)(addr - sym_addr) < st_size) {
       *offset = (int)(addr - sym_addr);
       *posIndex = sym->st_name;
@@ -81,6 +160,12 @@ bool ElfSymbolTable::lookup(address addr, int* stringtableIndex, int* posIndex,
   Elf_Sym* symbols = (Elf_Sym*)_section.section_data();
 
   if (symbols != NULL) {
+    if (!_sorted_built) {
+      build_sorted_index(symbols, count, funcDescTable);
+    }
+    if (_use_sorted && _sorted_func_desc_table == funcDescTable) {
+      return lookup_sorted(symbols, addr, stringtableIndex, posIndex, offset, funcDescTable);
+    }
     for (int index = 0; index < count; index ++) {
       if (compare(&symbols[index], addr, stringtableIndex, posIndex, offset, funcDescTable)) {
         return true;
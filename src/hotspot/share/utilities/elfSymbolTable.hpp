@@ -50,6 +50,19 @@ private:
   ElfSection      _section;
 
   NullDecoder::decoder_status _status;
+
+  // Function symbols of a section cached in memory, sorted by address.
+  // Built on the first lookup so that repeated lookups can binary search
+  // instead of scanning the whole table.
+  struct SortedSymbol {
+    address _addr;
+    int     _index;   // index into the section data
+  };
+  SortedSymbol*    _sorted;
+  int              _sorted_count;
+  bool             _sorted_built;    // an index build was attempted
+  bool             _use_sorted;
+  ElfFuncDescTable* _sorted_func_desc_table;
 public:
   ElfSymbolTable(FILE* const file, Elf_Shdr& shdr);
   ~ElfSymbolTable();
@@ -63,6 +76,11 @@ private:
   void set_next(ElfSymbolTable* next) { _next = next; }
 
   bool compare(const Elf_Sym* sym, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+
+  address symbol_address(const Elf_Sym* sym, ElfFuncDescTable* funcDescTable);
+  void build_sorted_index(const Elf_Sym* symbols, int count, ElfFuncDescTable* funcDescTable);
+  bool lookup_sorted(const Elf_Sym* symbols, address addr, int* stringtableIndex, int* posIndex, int* offset, ElfFuncDescTable* funcDescTable);
+  static int compare_by_address(SortedSymbol a, SortedSymbol b);
 };
 
 #endif // !_WINDOWS and !__APPLE__
@@ -26,7 +26,9 @@
 #define SHARE_UTILITIES_EVENTS_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -78,34 +80,43 @@ class EventLog : public CHeapObj<mtInternal> {
 // providing a more featureful log function if the existing copy
 // semantics aren't appropriate.  The name is used as the label of the
 // log when it is dumped during a crash.
+//
+// Appending is lock-free so that concurrent loggers do not serialize.
+// A writer claims a sequence number with an atomic increment, fills in
+// the record in the corresponding slot and then publishes it by storing
+// the sequence number in the record.  Readers only print records whose
+// published sequence number matches the one they expect, so records that
+// are still being written are skipped.
 template <class T> class EventLogBase : public EventLog {
   template <class X> class EventRecord : public CHeapObj<mtInternal> {
    public:
+    // Sequence number + 1 of the event in this record, or 0 while the
+    // record is being written.
+    volatile uint seq;
     double  timestamp;
     Thread* thread;
     X       data;
+
+    EventRecord() : seq(0) {}
   };
 
  protected:
-  Mutex           _mutex;
   // Name is printed out as a header.
   const char*     _name;
   // Handle is a short specifier used to select this particular event log
   // for printing (see VM.events command).
   const char*     _handle;
   int             _length;
-  int             _index;
-  int             _count;
+  // Sequence number of the next event to be logged.
+  volatile uint   _next;
   EventRecord<T>* _records;
 
  public:
   EventLogBase<T>(const char* name, const char* handle, int length = LogEventsBufferEntries):
-    _mutex(Mutex::event, name, true, Mutex::_safepoint_check_never),
     _name(name),
     _handle(handle),
     _length(length),
-    _index(0),
-    _count(0) {
+    _next(0) {
     _records = new EventRecord<T>[length];
   }
 
@@ -113,15 +124,23 @@ template <class T> class EventLogBase : public EventLog {
     return os::elapsedTime();
   }
 
-  // move the ring buffer to next open slot and return the index of
-  // the slot to use for the current message.  Should only be called
-  // while mutex is held.
-  int compute_log_index() {
-    int index = _index;
-    if (_count < _length) _count++;
-    _index++;
-    if (_index >= _length) _index = 0;
-    return index;
+  // Claim the next slot in the ring buffer and return the sequence
+  // number of the event.  The record is then filled in through
+  // record_at() and handed to readers with end_record().
+  uint begin_record() {
+    uint seq = Atomic::add(1u, &_next) - 1;
+    EventRecord<T>& r = record_at(seq);
+    r.seq = 0;
+    OrderAccess::storestore();
+    return seq;
+  }
+
+  EventRecord<T>& record_at(uint seq) {
+    return _records[seq % (uint)_length];
+  }
+
+  void end_record(uint seq) {
+    OrderAccess::release_store(&record_at(seq).seq, seq + 1);
   }
 
   bool should_log() {
@@ -173,11 +192,11 @@ class FormatStringEventLog : public EventLogBase< FormatStringLogMessage<bufsz>
     if (!this->should_log()) return;
 
     double timestamp = this->fetch_timestamp();
-    MutexLocker ml(&this->_mutex, Mutex::_no_safepoint_check_flag);
-    int index = this->compute_log_index();
-    this->_records[index].thread = thread;
-    this->_records[index].timestamp = timestamp;
-    this->_records[index].data.printv(format, ap);
+    uint seq = this->begin_record();
+    this->record_at(seq).thread = thread;
+    this->record_at(seq).timestamp = timestamp;
+    this->record_at(seq).data.printv(format, ap);
+    this->end_record(seq);
   }
 
   void log(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(3, 4) {
@@ -311,13 +330,8 @@ inline void Events::log_deopt_message(Thread* thread, const char* format, ...) {
 
 template <class T>
 inline void EventLogBase<T>::print_log_on(outputStream* out, int max) {
-  if (Thread::current_or_null() == NULL) {
-    // Not yet attached? Don't try to use locking
-    print_log_impl(out, max);
-  } else {
-    MutexLocker ml(&_mutex, Mutex::_no_safepoint_check_flag);
-    print_log_impl(out, max);
-  }
+  // Writers never block, so no locking is needed, even at crash time.
+  print_log_impl(out, max);
 }
 
 template <class T>
@@ -334,37 +348,28 @@ inline void EventLogBase<T>::print_names(outputStream* out) const {
 // Dump the ring buffer entries that current have entries.
 template <class T>
 inline void EventLogBase<T>::print_log_impl(outputStream* out, int max) {
-  out->print_cr("%s (%d events):", _name, _count);
-  if (_count == 0) {
+  uint next = OrderAccess::load_acquire(&_next);
+  int count = next < (uint)_length ? (int)next : _length;
+  out->print_cr("%s (%d events):", _name, count);
+  if (count == 0) {
     out->print_cr("No events");
     out->cr();
     return;
   }
 
+  // Print from oldest to newest.
   int printed = 0;
-  if (_count < _length) {
-    for (int i = 0; i < _count; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
-    }
-  } else {
-    for (int i = _index; i < _length; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+  for (uint seq = next - count; seq != next; seq++) {
+    if (max > 0 && printed == max) {
+      break;
     }
-    for (int i = 0; i < _index; i++) {
-      if (max > 0 && printed == max) {
-        break;
-      }
-      print(out, _records[i]);
-      printed ++;
+    EventRecord<T>& r = record_at(seq);
+    if (OrderAccess::load_acquire(&r.seq) != seq + 1) {
+      // Still being written, or already overwritten by a newer event.
+      continue;
     }
+    print(out, r);
+    printed ++;
   }
 
   if (printed == max) {
@@ -167,6 +167,21 @@ template<class E> class GrowableArray : public GenericGrowableArray {
   void grow(int j);
   void raw_at_put_grow(int i, const E& p, const E& fill);
   void  clear_and_deallocate();
+
+ protected:
+  // Start out with the caller's storage for initial_size elements. Only
+  // for resource area and arena arrays, which abandon their old data
+  // when they grow. See InlineGrowableArray.
+  GrowableArray(E* storage, int initial_size, int initial_len) : GenericGrowableArray(initial_size, initial_len, false) {
+    _data = storage;
+    for (int i = 0; i < _max; i++) ::new ((void*)&_data[i]) E();
+  }
+
+  GrowableArray(Arena* arena, E* storage, int initial_size) : GenericGrowableArray(arena, initial_size, 0) {
+    _data = storage;
+    for (int i = 0; i < _max; i++) ::new ((void*)&_data[i]) E();
+  }
+
  public:
   GrowableArray(Thread* thread, int initial_size) : GenericGrowableArray(initial_size, 0, false) {
     _data = (E*)raw_allocate(thread, sizeof(E));
@@ -473,6 +488,25 @@ template<class E> class GrowableArray : public GenericGrowableArray {
   }
 };
 
+// A resource area or arena GrowableArray with room for its first N
+// elements inside the array object itself, so arrays that stay small
+// never allocate. Once it grows past N elements it behaves like any other
+// GrowableArray. It must not be copied since the copy would refer to the
+// inline storage of the original.
+template<class E, int N>
+class InlineGrowableArray : public GrowableArray<E> {
+ private:
+  // raw storage, the elements are constructed by GrowableArray
+  jlong _storage[(N * sizeof(E) + sizeof(jlong) - 1) / sizeof(jlong)];
+
+  InlineGrowableArray(const InlineGrowableArray&);
+  InlineGrowableArray& operator=(const InlineGrowableArray&);
+
+ public:
+  InlineGrowableArray() : GrowableArray<E>((E*)_storage, N, 0) {}
+  InlineGrowableArray(Arena* arena) : GrowableArray<E>(arena, (E*)_storage, N) {}
+};
+
 // Global GrowableArray methods (one instance in the library per each 'E' type).
 
 template<class E> void GrowableArray<E>::grow(int j) {
@@ -25,6 +25,29 @@
 #include "precompiled.hpp"
 #include "utilities/utf8.hpp"
 
+// Word-at-a-time helpers for the ASCII fast paths below. Strings are
+// not necessarily word aligned, so the words are loaded with memcpy,
+// which compilers turn into a single unaligned load where allowed.
+static inline uint64_t load_word(const void* p) {
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+// True if none of the 8 bytes in w has the high bit set.
+static inline bool is_ascii_bytes(uint64_t w) {
+  return (w & UCONST64(0x8080808080808080)) == 0;
+}
+
+// True if all 4 jchars in w are in [0x0001, 0x007F], i.e. encode
+// as a single byte in modified UTF-8.
+static inline bool is_ascii_jchars(uint64_t w) {
+  const uint64_t ones = UCONST64(0x0001000100010001);
+  const uint64_t highs = UCONST64(0x8000800080008000);
+  bool has_zero = ((w - ones) & ~w & highs) != 0;
+  return (w & UCONST64(0xFF80FF80FF80FF80)) == 0 && !has_zero;
+}
+
 // Assume the utf8 string is in legal form and has been
 // checked in the class file parser/format checker.
 template<typename T> char* UTF8::next(const char* str, T* value) {
@@ -101,7 +124,16 @@ int UTF8::unicode_length(const char* str, int len, bool& is_latin1, bool& has_mu
   has_multibyte = false;
   is_latin1 = true;
   unsigned char prev = 0;
-  for (int i = 0; i < len; i++) {
+  int i = 0;
+  // Skip over ASCII runs a word at a time. An ASCII byte is never
+  // a continuation byte and clears any pending lead byte.
+  while (i + (int)sizeof(uint64_t) <= len) {
+    if (!is_ascii_bytes(load_word(str + i))) {
+      break;
+    }
+    i += sizeof(uint64_t);
+  }
+  for (; i < len; i++) {
     unsigned char c = str[i];
     if ((c & 0xC0) == 0x80) {
       // Multibyte, check if valid latin1 character.
@@ -172,6 +204,15 @@ template<typename T> void UTF8::convert_to_unicode(const char* utf8_str, T* unic
   int index = 0;
 
   /* ASCII case loop optimization */
+  // Every character takes at least one byte, so while 8 or more characters
+  // remain there are at least 8 more bytes to read.
+  while (index + (int)sizeof(uint64_t) <= unicode_length && is_ascii_bytes(load_word(ptr))) {
+    for (int i = 0; i < (int)sizeof(uint64_t); i++) {
+      unicode_str[index + i] = (T)(unsigned char)ptr[i];
+    }
+    index += sizeof(uint64_t);
+    ptr += sizeof(uint64_t);
+  }
   for (; index < unicode_length; index++) {
     if((ch = ptr[0]) > 0x7F) { break; }
     unicode_str[index] = (T)ch;
@@ -435,10 +476,26 @@ int UNICODE::utf8_size(jbyte c) {
   }
 }
 
+template<typename T>
+static inline int ascii_prefix_length(const T* base, int length) {
+  return 0;
+}
+
+// Number of leading jchars, in multiples of 4, that encode as single bytes.
+template<>
+inline int ascii_prefix_length<jchar>(const jchar* base, int length) {
+  const int per_word = sizeof(uint64_t) / sizeof(jchar);
+  int index = 0;
+  while (index + per_word <= length && is_ascii_jchars(load_word(base + index))) {
+    index += per_word;
+  }
+  return index;
+}
+
 template<typename T>
 int UNICODE::utf8_length(const T* base, int length) {
-  int result = 0;
-  for (int index = 0; index < length; index++) {
+  int result = ascii_prefix_length(base, length);
+  for (int index = result; index < length; index++) {
     T c = base[index];
     result += utf8_size(c);
   }
@@ -489,7 +546,12 @@ char* UNICODE::as_utf8(const jbyte* base, int length, char* buf, int buflen) {
 }
 
 void UNICODE::convert_to_utf8(const jchar* base, int length, char* utf8_buffer) {
-  for(int index = 0; index < length; index++) {
+  int index = ascii_prefix_length(base, length);
+  for (int i = 0; i < index; i++) {
+    utf8_buffer[i] = (char)base[i];
+  }
+  utf8_buffer += index;
+  for(; index < length; index++) {
     utf8_buffer = (char*)utf8_write((u_char*)utf8_buffer, base[index]);
   }
   *utf8_buffer = '\0';
@@ -88,7 +88,14 @@ void GenericWaitBarrier::wait(int barrier_tag) {
     _sem_barrier.wait();
     // We help out with posting, but we need to do so before we decrement the
     // _barrier_threads otherwise we might wake threads up in next wait.
-    GenericWaitBarrier::wake_if_needed();
+    // Each woken thread tries to wake WakeFanOut more, so the wakeups
+    // spread out as a tree instead of being posted one at a time by the
+    // disarming thread.
+    for (int i = 0; i < WakeFanOut; i++) {
+      if (GenericWaitBarrier::wake_if_needed() == 0) {
+        break;
+      }
+    }
   }
   Atomic::add(-1, &_barrier_threads);
 }
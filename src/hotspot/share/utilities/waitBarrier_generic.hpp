@@ -39,6 +39,9 @@ class GenericWaitBarrier : public CHeapObj<mtInternal> {
   volatile int _barrier_threads;
   Semaphore _sem_barrier;
 
+  // The number of wakeups each woken thread attempts before resuming.
+  static const int WakeFanOut = 2;
+
   // Prevent copying and assignment of GenericWaitBarrier instances.
   GenericWaitBarrier(const GenericWaitBarrier&);
   GenericWaitBarrier& operator=(const GenericWaitBarrier&);
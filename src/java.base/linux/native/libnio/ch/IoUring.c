@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "jni.h"
+#include "jni_util.h"
+#include "jvm.h"
+#include "jlong.h"
+#include "nio.h"
+#include "nio_util.h"
+
+#include "sun_nio_ch_IoUring.h"
+
+/*
+ * Thin wrappers around the io_uring system calls for sun.nio.ch.IoUring.
+ * The submission and completion rings are mapped into the process and
+ * driven from Java with Unsafe, in the same way EPoll exposes the layout
+ * of struct epoll_event.  The system calls are invoked directly so that
+ * liburing is not required.  If the build host has no io_uring headers,
+ * isSupported() reports false and the epoll based implementation is used.
+ */
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define HAVE_IO_URING 1
+#endif
+#endif
+
+#ifdef HAVE_IO_URING
+
+/* The io_uring system call numbers are the same on all architectures */
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup     425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter     426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register  427
+#endif
+
+static int io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                          unsigned flags) {
+    return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                         flags, NULL, 0);
+}
+
+static int io_uring_register(int fd, unsigned opcode, void *arg,
+                             unsigned nr_args) {
+    return (int) syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_IoUring_isSupported(JNIEnv *env, jclass clazz)
+{
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    fd = io_uring_setup(1, &p);
+    if (fd < 0) {
+        /* ENOSYS on older kernels, EPERM if disabled by seccomp policy */
+        return JNI_FALSE;
+    }
+    close(fd);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_paramsSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct io_uring_params);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_featuresOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_params, features);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqOffsetsOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_params, sq_off);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_cqOffsetsOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_params, cq_off);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct io_uring_sqe);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeOpcodeOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, opcode);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeFdOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, fd);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeOffOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, off);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeAddrOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, addr);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeLenOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, len);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeUserDataOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, user_data);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_sqeBufIndexOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_sqe, buf_index);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_cqeSize(JNIEnv* env, jclass clazz)
+{
+    return sizeof(struct io_uring_cqe);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_cqeUserDataOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_cqe, user_data);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_cqeResOffset(JNIEnv* env, jclass clazz)
+{
+    return offsetof(struct io_uring_cqe, res);
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_setup(JNIEnv *env, jclass clazz, jint entries,
+                              jlong paramsAddress)
+{
+    struct io_uring_params *p = jlong_to_ptr(paramsAddress);
+    int fd = io_uring_setup((unsigned)entries, p);
+    if (fd < 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "io_uring_setup failed");
+    }
+    return fd;
+}
+
+JNIEXPORT jlong JNICALL
+Java_sun_nio_ch_IoUring_mmap(JNIEnv *env, jclass clazz, jint fd,
+                             jlong length, jlong offset)
+{
+    void *addr = mmap(NULL, (size_t)length, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, (off_t)offset);
+    if (addr == MAP_FAILED) {
+        JNU_ThrowIOExceptionWithLastError(env, "mmap of io_uring failed");
+        return 0;
+    }
+    return ptr_to_jlong(addr);
+}
+
+JNIEXPORT void JNICALL
+Java_sun_nio_ch_IoUring_munmap(JNIEnv *env, jclass clazz, jlong address,
+                               jlong length)
+{
+    if (munmap(jlong_to_ptr(address), (size_t)length) != 0) {
+        JNU_ThrowIOExceptionWithLastError(env, "munmap of io_uring failed");
+    }
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_enter(JNIEnv *env, jclass clazz, jint fd,
+                              jint toSubmit, jint minComplete, jint flags)
+{
+    int res = io_uring_enter(fd, (unsigned)toSubmit, (unsigned)minComplete,
+                             (unsigned)flags);
+    if (res < 0) {
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        } else {
+            JNU_ThrowIOExceptionWithLastError(env, "io_uring_enter failed");
+            return IOS_THROWN;
+        }
+    }
+    return res;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_registerBuffers(JNIEnv *env, jclass clazz, jint fd,
+                                        jlong iovAddress, jint count)
+{
+    struct iovec *iov = jlong_to_ptr(iovAddress);
+    int res = io_uring_register(fd, IORING_REGISTER_BUFFERS, iov, (unsigned)count);
+    return (res == 0) ? 0 : errno;
+}
+
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_IoUring_unregisterBuffers(JNIEnv *env, jclass clazz, jint fd)
+{
+    int res = io_uring_register(fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+    return (res == 0) ? 0 : errno;
+}
+
+#else /* HAVE_IO_URING */
+
+JNIEXPORT jboolean JNICALL
+Java_sun_nio_ch_IoUring_isSupported(JNIEnv *env, jclass clazz)
+{
+    return JNI_FALSE;
+}
+
+#endif /* HAVE_IO_URING */
@@ -57,6 +57,13 @@ readSingle(JNIEnv *env, jobject this, jfieldID fid) {
  */
 #define BUF_SIZE 8192
 
+/* The maximum size of a malloc-allocated buffer.  Larger requests are
+ * split into several system calls rather than allocating (and, for most
+ * allocators, mapping and faulting in) a buffer as large as the array
+ * slice on every call.
+ */
+#define MAX_MALLOC_SIZE (1024 * 1024)
+
 /*
  * Returns true if the array slice defined by the given offset and length
  * is out of bounds.
@@ -92,6 +99,10 @@ readBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return 0;
     } else if (len > BUF_SIZE) {
+        /* A short read is permitted, so simply read less */
+        if (len > MAX_MALLOC_SIZE) {
+            len = MAX_MALLOC_SIZE;
+        }
         buf = malloc(len);
         if (buf == NULL) {
             JNU_ThrowOutOfMemoryError(env, NULL);
@@ -149,6 +160,7 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     jint n;
     char stackBuf[BUF_SIZE];
     char *buf = NULL;
+    jint bufLen;
     FD fd;
 
     if (IS_NULL(bytes)) {
@@ -164,37 +176,48 @@ writeBytes(JNIEnv *env, jobject this, jbyteArray bytes,
     if (len == 0) {
         return;
     } else if (len > BUF_SIZE) {
-        buf = malloc(len);
+        bufLen = (len > MAX_MALLOC_SIZE) ? MAX_MALLOC_SIZE : len;
+        buf = malloc(bufLen);
         if (buf == NULL) {
             JNU_ThrowOutOfMemoryError(env, NULL);
             return;
         }
     } else {
+        bufLen = len;
         buf = stackBuf;
     }
 
-    (*env)->GetByteArrayRegion(env, bytes, off, len, (jbyte *)buf);
+    /* Copy and write at most bufLen bytes at a time */
+    while (len > 0) {
+        jint chunkLen = (len > bufLen) ? bufLen : len;
+        jint chunkOff = 0;
 
-    if (!(*env)->ExceptionOccurred(env)) {
-        off = 0;
-        while (len > 0) {
+        (*env)->GetByteArrayRegion(env, bytes, off, chunkLen, (jbyte *)buf);
+        if ((*env)->ExceptionOccurred(env)) {
+            break;
+        }
+        while (chunkOff < chunkLen) {
             fd = GET_FD(this, fid);
             if (fd == -1) {
                 JNU_ThrowIOException(env, "Stream Closed");
                 break;
             }
             if (append == JNI_TRUE) {
-                n = IO_Append(fd, buf+off, len);
+                n = IO_Append(fd, buf+chunkOff, chunkLen-chunkOff);
             } else {
-                n = IO_Write(fd, buf+off, len);
+                n = IO_Write(fd, buf+chunkOff, chunkLen-chunkOff);
             }
             if (n == -1) {
                 JNU_ThrowIOExceptionWithLastError(env, "Write error");
                 break;
             }
-            off += n;
-            len -= n;
+            chunkOff += n;
+        }
+        if (chunkOff < chunkLen) {
+            break;
         }
+        off += chunkLen;
+        len -= chunkLen;
     }
     if (buf != stackBuf) {
         free(buf);
@@ -257,6 +257,71 @@ bool ImageFileReaderTable::contains(ImageFileReader* image) {
     return false;
 }
 
+ImageResourceCache::ImageResourceCache() : _count(0), _bytes(0) {
+    memset(_table, 0, sizeof(_table));
+}
+
+ImageResourceCache::~ImageResourceCache() {
+    for (u4 i = 0; i < _buckets; i++) {
+        for (Entry* entry = _table[i]; entry != NULL; ) {
+            Entry* next = entry->_next;
+            delete[] entry->_data;
+            delete entry;
+            entry = next;
+        }
+    }
+}
+
+// Take ownership of the uncompressed data for the location offset.
+bool ImageResourceCache::put(u4 offset, u1* data, u8 size) {
+    SimpleCriticalSectionLock cs(&_lock);
+    if (_bytes + size > _max_bytes) {
+        return false;
+    }
+    Entry** bucket = &_table[offset % _buckets];
+    for (Entry* entry = *bucket; entry != NULL; entry = entry->_next) {
+        if (entry->_offset == offset) {
+            return false;
+        }
+    }
+    Entry* entry = new Entry();
+    if (entry == NULL) {
+        return false;
+    }
+    entry->_offset = offset;
+    entry->_data = data;
+    entry->_size = size;
+    entry->_next = *bucket;
+    *bucket = entry;
+    _bytes += size;
+    _count++;
+    return true;
+}
+
+// Copy out and release the resource for the location offset.
+bool ImageResourceCache::take(u4 offset, u1* uncompressed_data) {
+    Entry* found = NULL;
+    {
+        SimpleCriticalSectionLock cs(&_lock);
+        for (Entry** link = &_table[offset % _buckets]; *link != NULL; link = &(*link)->_next) {
+            if ((*link)->_offset == offset) {
+                found = *link;
+                *link = found->_next;
+                _bytes -= found->_size;
+                _count--;
+                break;
+            }
+        }
+    }
+    if (found == NULL) {
+        return false;
+    }
+    memcpy(uncompressed_data, found->_data, (size_t)found->_size);
+    delete[] found->_data;
+    delete found;
+    return true;
+}
+
 // Table to manage multiple opens of an image file.
 ImageFileReaderTable ImageFileReader::_reader_table;
 
@@ -522,6 +587,11 @@ bool ImageFileReader::verify_location(ImageLocation& location, const char* path)
 
 // Return the resource for the supplied location offset.
 void ImageFileReader::get_resource(u4 offset, u1* uncompressed_data) const {
+        // Use the resource if it was decompressed by prefetch_resources.
+        if (!_resource_cache.is_empty() &&
+            const_cast<ImageResourceCache&>(_resource_cache).take(offset, uncompressed_data)) {
+            return;
+        }
         // Get address of first byte of location attribute stream.
         u1* data = get_location_offset_data(offset);
         // Expand location attributes.
@@ -559,6 +629,9 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
         if (!memory_map_image) {
                 delete[] compressed_data;
         }
+    } else if (memory_map_image) {
+        // Copy bytes from the mapped image.
+        memcpy(uncompressed_data, get_data_address() + offset, (size_t)uncompressed_size);
     } else {
         // Read bytes from offset beyond the image index.
         bool is_read = read_at(uncompressed_data, uncompressed_size, _index_size + offset);
@@ -566,6 +639,84 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     }
 }
 
+// Return the address of an uncompressed resource in the mapped image.
+const u1* ImageFileReader::get_resource_address(u4 offset) const {
+    if (!memory_map_image) {
+        return NULL;
+    }
+    // Get address of first byte of location attribute stream.
+    u1* data = get_location_offset_data(offset);
+    // Expand location attributes.
+    ImageLocation location(data);
+    if (location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED) != 0) {
+        return NULL;
+    }
+    return get_data_address() + location.get_attribute(ImageLocation::ATTRIBUTE_OFFSET);
+}
+
+// Work shared by the threads of ImageFileReader::prefetch_resources.
+struct ImagePrefetch {
+    ImageFileReader* reader;
+    ImageResourceCache* cache;
+    const u4* offsets;
+    u4 count;
+    u4 next;                  // Next offset to claim, guarded by lock
+    u4 held;                  // Resources put in the cache, guarded by lock
+    SimpleCriticalSection lock;
+};
+
+static void prefetch_worker(void* arg) {
+    ImagePrefetch* work = (ImagePrefetch*) arg;
+    while (true) {
+        u4 i;
+        {
+            SimpleCriticalSectionLock cs(&work->lock);
+            if (work->next >= work->count) {
+                return;
+            }
+            i = work->next++;
+        }
+        u4 offset = work->offsets[i];
+        if (offset == 0) {
+            continue;
+        }
+        ImageLocation location(work->reader->get_location_offset_data(offset));
+        // Uncompressed resources are cheap to read, only decompress ahead.
+        if (location.get_attribute(ImageLocation::ATTRIBUTE_COMPRESSED) == 0) {
+            continue;
+        }
+        u8 size = location.get_attribute(ImageLocation::ATTRIBUTE_UNCOMPRESSED);
+        u1* data = new u1[(size_t)size];
+        if (data == NULL) {
+            return;
+        }
+        work->reader->get_resource(location, data);
+        if (!work->cache->put(offset, data, size)) {
+            delete[] data;
+            continue;
+        }
+        SimpleCriticalSectionLock cs(&work->lock);
+        work->held++;
+    }
+}
+
+// Decompress the compressed resources among the location offsets ahead of
+// their use, so startup class loading from an image built with --compress
+// can spread the decompression over several threads.
+u4 ImageFileReader::prefetch_resources(const u4* offsets, u4 count, u4 threads) {
+    // The decompressors are created lazily; do it before sharing them.
+    ImageDecompressor::image_decompressor_init();
+    ImagePrefetch work;
+    work.reader = this;
+    work.cache = &_resource_cache;
+    work.offsets = offsets;
+    work.count = count;
+    work.next = 0;
+    work.held = 0;
+    osSupport::run_in_parallel(prefetch_worker, &work, threads < 1 ? 1 : (int)threads);
+    return work.held;
+}
+
 // Return the ImageModuleData for this image
 ImageModuleData * ImageFileReader::get_image_module_data() {
         return module_data;
@@ -36,6 +36,8 @@
 
 #include "endian.hpp"
 #include "inttypes.hpp"
+#include "jni.h"
+#include "osSupport.hpp"
 
 // Image files are an alternate file format for storing classes and resources. The
 // goal is to supply file access which is faster and smaller than the jar format.
@@ -389,6 +391,44 @@ public:
     bool contains(ImageFileReader* image);
 };
 
+// Hold resources that were decompressed ahead of use by
+// ImageFileReader::prefetch_resources.  A resource is handed out once, to the
+// first get_resource for its location, and then released, so the cache only
+// retains resources that have been prefetched but not yet read.
+class ImageResourceCache {
+private:
+    const static u4 _buckets = 1024;    // Number of hash buckets
+    const static u8 _max_bytes = 64*1024*1024; // Limit on bytes held
+
+    struct Entry {
+        Entry* _next;                   // Next entry in bucket
+        u4 _offset;                     // Location offset of the resource
+        u1* _data;                      // Uncompressed resource bytes
+        u8 _size;                       // Size of the resource
+    };
+
+    Entry* _table[_buckets];            // Entries hashed by location offset
+    volatile u4 _count;                 // Number of entries held
+    u8 _bytes;                          // Number of resource bytes held
+    SimpleCriticalSection _lock;        // Guards the table
+
+public:
+    ImageResourceCache();
+    ~ImageResourceCache();
+
+    // Return true if no resources are held.  Racy, but a resource being
+    // added concurrently is simply not found and decompressed again.
+    inline bool is_empty() const { return _count == 0; }
+
+    // Take ownership of the uncompressed data for the location offset.
+    // Returns false, without taking ownership, if the cache is full.
+    bool put(u4 offset, u1* data, u8 size);
+
+    // Copy the resource for the location offset into uncompressed_data and
+    // release it.  Returns false if the resource is not held.
+    bool take(u4 offset, u1* uncompressed_data);
+};
+
 // Manage the image file.
 // ImageFileReader manages the content of an image file.
 // Initially, the header of the image file is read for validation.  If valid,
@@ -424,6 +464,7 @@ private:
     u1* _location_bytes; // Location attributes
     u1* _string_bytes;   // String table
     ImageModuleData *module_data;       // The ImageModuleData for this image
+    ImageResourceCache _resource_cache; // Prefetched uncompressed resources
 
     ImageFileReader(const char* name, bool big_endian);
     ~ImageFileReader();
@@ -573,6 +614,16 @@ public:
     // Return the resource for the supplied path.
     void get_resource(ImageLocation& location, u1* uncompressed_data) const;
 
+    // Return the address of the resource for the supplied location index in
+    // the mapped image, or NULL if the resource is compressed or the image is
+    // not memory mapped.
+    const u1* get_resource_address(u4 index) const;
+
+    // Decompress the compressed resources among the count location offsets
+    // using up to threads threads, and hold them for the first get_resource
+    // of each.  Returns the number of resources held.
+    u4 prefetch_resources(const u4* offsets, u4 count, u4 threads);
+
     // Return the ImageModuleData for this image
     ImageModuleData * get_image_module_data();
 
@@ -162,6 +162,57 @@ JIMAGE_GetResource(JImageFile* image, JImageLocationRef location,
     return size;
 }
 
+/*
+ * JImageGetResourceAddress - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), return the address
+ * of the resource's bytes in the memory mapped image.  NULL is returned if the
+ * resource is compressed or the image is not memory mapped, in which case
+ * JImageGetResource must be used.  The bytes must not be modified and stay
+ * valid until the image is closed.
+ *
+ * Ex.
+ *  jlong size;
+ *  JImageLocationRef location = (*JImageFindResource)(image,
+ *                               "java.base", "9.0", "java/lang/String.class", &size);
+ *  const char* data = (*JImageGetResourceAddress)(image, location);
+ */
+extern "C" JNIEXPORT const char*
+JIMAGE_GetResourceAddress(JImageFile* image, JImageLocationRef location) {
+    return (const char*) ((ImageFileReader*) image)->get_resource_address((u4) location);
+}
+
+/*
+ * JImagePrefetchResources - Given an open image file (see JImageOpen) and an
+ * array of count resource locations (see JImageFindResource), decompress the
+ * compressed resources among them using up to threads threads.  The bytes
+ * are held by the image until the first JImageGetResource of each location,
+ * which then copies them out instead of decompressing.  Locations of zero
+ * are ignored.  Returns the number of resources held.
+ *
+ * Ex.
+ *  JImageLocationRef locations[n];
+ *  ... (*JImageFindResource)(image, module, "9.0", name, &size) ...
+ *  (*JImagePrefetchResources)(image, locations, n, 4);
+ */
+extern "C" JNIEXPORT jint
+JIMAGE_PrefetchResources(JImageFile* image, const JImageLocationRef* locations,
+        jint count, jint threads) {
+    if (count <= 0) {
+        return 0;
+    }
+    u4* offsets = new u4[count];
+    if (offsets == NULL) {
+        return 0;
+    }
+    for (jint i = 0; i < count; i++) {
+        offsets[i] = (u4) locations[i];
+    }
+    u4 held = ((ImageFileReader*) image)->prefetch_resources(offsets, (u4) count,
+                                                             threads < 1 ? 1 : (u4) threads);
+    delete[] offsets;
+    return (jint) held;
+}
+
 /*
  * JImageResourceIterator - Given an open image file (see JImageOpen), a visitor
  * function and a visitor argument, iterator through each of the image's resources.
@@ -157,6 +157,45 @@ JIMAGE_GetResource(JImageFile* jimage, JImageLocationRef location,
 typedef jlong(*JImageGetResource_t)(JImageFile* jimage, JImageLocationRef location,
         char* buffer, jlong size);
 
+/*
+ * JImageGetResourceAddress - Given an open image file (see JImageOpen) and a
+ * resource's location information (see JImageFindResource), return the address
+ * of the resource's bytes in the memory mapped image.  NULL is returned if the
+ * resource is compressed or the image is not memory mapped, in which case
+ * JImageGetResource must be used.  The bytes must not be modified and stay
+ * valid until the image is closed.
+ *
+ * Ex.
+ *  jlong size;
+ *  JImageLocationRef location = (*JImageFindResource)(image,
+ *                               "java.base", "9.0", "java/lang/String.class", &size);
+ *  const char* data = (*JImageGetResourceAddress)(image, location);
+ */
+extern "C" JNIEXPORT const char*
+JIMAGE_GetResourceAddress(JImageFile* jimage, JImageLocationRef location);
+
+typedef const char*(*JImageGetResourceAddress_t)(JImageFile* jimage, JImageLocationRef location);
+
+/*
+ * JImagePrefetchResources - Given an open image file (see JImageOpen) and an
+ * array of count resource locations (see JImageFindResource), decompress the
+ * compressed resources among them using up to threads threads.  The bytes
+ * are held by the image until the first JImageGetResource of each location,
+ * which then copies them out instead of decompressing.  Locations of zero
+ * are ignored.  Returns the number of resources held.
+ *
+ * Ex.
+ *  JImageLocationRef locations[n];
+ *  ... (*JImageFindResource)(image, module, "9.0", name, &size) ...
+ *  (*JImagePrefetchResources)(image, locations, n, 4);
+ */
+extern "C" JNIEXPORT jint
+JIMAGE_PrefetchResources(JImageFile* jimage, const JImageLocationRef* locations,
+        jint count, jint threads);
+
+typedef jint(*JImagePrefetchResources_t)(JImageFile* jimage,
+        const JImageLocationRef* locations, jint count, jint threads);
+
 
 /*
  * JImageResourceIterator - Given an open image file (see JImageOpen), a visitor
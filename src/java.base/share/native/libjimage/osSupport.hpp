@@ -71,6 +71,13 @@ public:
      * Unmap nBytes of memory at address.
      */
     static int unmap_memory(void* addr, size_t bytes);
+
+    /**
+     * Run function(arg) on the calling thread and on up to threads - 1
+     * additional threads, and wait for all of them to return.  If threads
+     * cannot be started, the work is left to the threads that did start.
+     */
+    static void run_in_parallel(void (*function)(void*), void* arg, int threads);
 };
 
 /**
@@ -274,6 +274,10 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
      *     the pre 1.9 JRE [ 1.6 thru 1.8 ], it is as if 1.9+ has been
      *     invoked from the command line.
      */
+    if (JLI_IsTraceLauncher()) {
+        start = CounterGet();
+    }
+
     SelectVersion(argc, argv, &main_class);
 
     CreateExecutionEnvironment(&argc, &argv,
@@ -285,6 +289,13 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
         SetJvmEnvironment(argc,argv);
     }
 
+    if (JLI_IsTraceLauncher()) {
+        end   = CounterGet();
+    }
+
+    JLI_TraceLauncher("%ld micro seconds to locate the JVM\n",
+             (long)(jint)Counter2Micros(end-start));
+
     ifn.CreateJavaVM = 0;
     ifn.GetDefaultJavaVMInitArgs = 0;
 
@@ -447,6 +447,17 @@ hash_append(unsigned int hash, char c)
     return ((int)hash)*31 + c;
 }
 
+/*
+ * Returns the first slot of the entry index to probe for a name hash.
+ * The index is open addressed with linear probing over a power of two
+ * number of slots, so the high bits are folded in before masking.
+ */
+static jint
+indexSlot(unsigned int hsh, jint tablelen)
+{
+    return (jint)((hsh ^ (hsh >> 16)) & (unsigned int)(tablelen - 1));
+}
+
 /*
  * Returns true if the specified entry's name begins with the string
  * "META-INF/" irrespective of case.
@@ -681,8 +692,14 @@ readCEN(jzfile *zip, jint knownTotal)
      * the Zip64 enabled.
      */
     total = (knownTotal != -1) ? knownTotal : total;
+    /* Size the index so that it is at most two thirds full, which keeps
+     * the linear probe sequences short.  Lookups then only touch the
+     * index and the hash cells until a candidate entry is found. */
+    for (tablelen = 16; tablelen < (jlong)total + total/2; tablelen <<= 1) {
+        if (tablelen >= (1 << 30)) goto Catch;
+    }
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    zip->tablelen = tablelen;
     table    = zip->table    = malloc(tablelen * sizeof(table[0]));
     /* According to ISO C it is perfectly legal for malloc to return zero
      * if called with a zero argument. We check this for 'entries' but not
@@ -727,12 +744,23 @@ readCEN(jzfile *zip, jint knownTotal)
 
         /* Record the CEN offset and the name hash in our hash cell. */
         entries[i].cenpos = cenpos + (cp - cenbuf);
-        entries[i].hash = hashN((char *)cp+CENHDR, nlen);
-
-        /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
-        entries[i].next = table[hsh];
-        table[hsh] = i;
+        entries[i].hash = hsh = hashN((char *)cp+CENHDR, nlen);
+
+        /* Add the entry to the index.  If an earlier entry has the same
+         * name, the later one replaces it, so lookups keep finding the
+         * last entry of that name as they did with chained buckets. */
+        for (j = indexSlot(hsh, tablelen);
+             table[j] != ZIP_ENDCHAIN;
+             j = (j + 1) & (tablelen - 1)) {
+            jzcell *zc = &entries[table[j]];
+            if (zc->hash == hsh) {
+                unsigned char *other = cenbuf + (zc->cenpos - cenpos);
+                if (CENNAM(other) == nlen &&
+                    memcmp(other + CENHDR, cp + CENHDR, nlen) == 0)
+                    break;
+            }
+        }
+        table[j] = i;
     }
     if (cp != cenend) {
         ZIP_FORMAT_ERROR("invalid CEN header (bad header size)");
@@ -1154,14 +1182,23 @@ jboolean equals(char* name1, int len1, char* name2, int len2) {
     if (len1 != len2) {
         return JNI_FALSE;
     }
-    while (len1-- > 0) {
-        if (*name1++ != *name2++) {
-            return JNI_FALSE;
-        }
-    }
-    return JNI_TRUE;
+    return memcmp(name1, name2, len1) == 0 ? JNI_TRUE : JNI_FALSE;
 }
 
+#ifdef USE_MMAP
+/*
+ * Returns true if the name in the mapped CEN header of the given hash
+ * cell is equal to name.  This lets lookups reject cells whose hash
+ * collides without allocating and filling in a jzentry.
+ */
+static jboolean
+cenNameEquals(jzfile *zip, jzcell *zc, char *name, jint ulen)
+{
+    unsigned char *cen = zip->maddr + zc->cenpos - zip->offset;
+    return equals((char *)cen + CENHDR, CENNAM(cen), name, ulen);
+}
+#endif
+
 /*
  * Returns the zip entry corresponding to the specified name, or
  * NULL if not found.
@@ -1172,7 +1209,7 @@ jzentry *
 ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
 {
     unsigned int hsh = hashN(name, ulen);
-    jint idx;
+    jint slot, idx;
     jzentry *ze = 0;
 
     ZIP_Lock(zip);
@@ -1180,7 +1217,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    slot = indexSlot(hsh, zip->tablelen);
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1201,12 +1238,22 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         ze = 0;
 
         /*
-         * Search down the target hash chain for a cell whose
-         * 32 bit hash matches the hashed name.
+         * Probe the index for a cell whose 32 bit hash matches
+         * the hashed name.
          */
-        while (idx != ZIP_ENDCHAIN) {
+        while ((idx = zip->table[slot]) != ZIP_ENDCHAIN) {
             jzcell *zc = &zip->entries[idx];
 
+            slot = (slot + 1) & (zip->tablelen - 1);
+#ifdef USE_MMAP
+            if (zc->hash == hsh && zip->usemmap) {
+                /* The CEN is mapped, compare the name in place */
+                if (cenNameEquals(zip, zc, name, ulen)) {
+                    ze = newEntry(zip, zc, ACCESS_RANDOM);
+                    break;
+                }
+            } else
+#endif
             if (zc->hash == hsh) {
                 /*
                  * OK, we've found a ZIP entry whose 32 bit hashcode
@@ -1229,7 +1276,6 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
                 }
                 ze = 0;
             }
-            idx = zc->next;
         }
 
         /* Entry found, return it */
@@ -1251,7 +1297,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        slot = indexSlot(hsh, zip->tablelen);
         addSlash = JNI_FALSE;
     }
 
@@ -1589,3 +1635,161 @@ ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pm
     inflateEnd(&strm);
     return JNI_TRUE;
 }
+
+/* Bump allocator state used to keep zlib from calling malloc when
+ * compressing. The scratch memory is handed in by the caller.
+ */
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t pos;
+} GZipScratch;
+
+static voidpf
+GZip_Alloc(voidpf opaque, uInt items, uInt size)
+{
+    GZipScratch *scratch = (GZipScratch *) opaque;
+    size_t needed = ((size_t) items * size + 7) & ~(size_t) 7;
+    char *result;
+
+    if (scratch->buf == NULL) {
+        /* Measuring only, so hand out real memory and record the size. */
+        scratch->pos += needed;
+        return calloc(items, size);
+    }
+
+    if (scratch->pos + needed > scratch->size) {
+        return Z_NULL;
+    }
+
+    result = scratch->buf + scratch->pos;
+    scratch->pos += needed;
+    return result;
+}
+
+static void
+GZip_Free(voidpf opaque, voidpf address)
+{
+    GZipScratch *scratch = (GZipScratch *) opaque;
+
+    /* Scratch memory is released by the caller as a whole. */
+    if (scratch->buf == NULL) {
+        free(address);
+    }
+}
+
+/*
+ * Computes the sizes of the output and scratch buffers needed to gzip
+ * compress a block of inLen bytes with the given level. Returns NULL on
+ * success or an error message.
+ */
+JNIEXPORT char*
+ZIP_GZip_InitParams(size_t inLen, size_t *outLen, size_t *tmpLen, int level)
+{
+    z_stream strm;
+    GZipScratch scratch;
+    int err;
+
+    *outLen = 0;
+    *tmpLen = 0;
+
+    if (level < 1 || level > 9) {
+        return "Compression level out of range (1-9)";
+    }
+
+    /* Run the initialization in measuring mode to learn how much memory
+     * zlib wants, then repeat it with a scratch buffer that large. */
+    memset(&strm, 0, sizeof(z_stream));
+    scratch.buf = NULL;
+    scratch.size = 0;
+    scratch.pos = 0;
+    strm.zalloc = GZip_Alloc;
+    strm.zfree = GZip_Free;
+    strm.opaque = &scratch;
+
+    /* windowBits of 31 selects the gzip wrapper. */
+    err = deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        return strm.msg != NULL ? strm.msg : "Could not initialize gzip compression";
+    }
+    deflateEnd(&strm);
+
+    *tmpLen = scratch.pos;
+    scratch.buf = (char *) malloc(*tmpLen);
+    if (scratch.buf == NULL) {
+        return "Out of memory";
+    }
+
+    memset(&strm, 0, sizeof(z_stream));
+    scratch.size = *tmpLen;
+    scratch.pos = 0;
+    strm.zalloc = GZip_Alloc;
+    strm.zfree = GZip_Free;
+    strm.opaque = &scratch;
+
+    err = deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        free(scratch.buf);
+        return strm.msg != NULL ? strm.msg : "Could not initialize gzip compression";
+    }
+
+    *outLen = (size_t) deflateBound(&strm, (uLong) inLen);
+    deflateEnd(&strm);
+    free(scratch.buf);
+
+    return NULL;
+}
+
+/*
+ * Compresses inLen bytes from inBuf into outBuf as a complete gzip member.
+ * The tmp buffer must be at least as large as the size returned by
+ * ZIP_GZip_InitParams. Returns the number of bytes written to outBuf, or
+ * 0 with *pmsg set on error. Several members can be concatenated to form
+ * a valid gzip file.
+ */
+JNIEXPORT size_t
+ZIP_GZip_Fully(char *inBuf, size_t inLen, char *outBuf, size_t outLen, char *tmp,
+               size_t tmpLen, int level, char *comment, char **pmsg)
+{
+    z_stream strm;
+    gz_header hdr;
+    GZipScratch scratch;
+    int err;
+
+    *pmsg = NULL;
+
+    memset(&strm, 0, sizeof(z_stream));
+    scratch.buf = tmp;
+    scratch.size = tmpLen;
+    scratch.pos = 0;
+    strm.zalloc = GZip_Alloc;
+    strm.zfree = GZip_Free;
+    strm.opaque = &scratch;
+
+    err = deflateInit2(&strm, level, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK) {
+        *pmsg = strm.msg != NULL ? strm.msg : "Could not initialize gzip compression";
+        return 0;
+    }
+
+    if (comment != NULL) {
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.comment = (Bytef *) comment;
+        deflateSetHeader(&strm, &hdr);
+    }
+
+    strm.next_in = (Bytef *) inBuf;
+    strm.avail_in = (uInt) inLen;
+    strm.next_out = (Bytef *) outBuf;
+    strm.avail_out = (uInt) outLen;
+
+    err = deflate(&strm, Z_FINISH);
+    if (err != Z_STREAM_END) {
+        *pmsg = strm.msg != NULL ? strm.msg : "Gzip output buffer too small";
+        deflateEnd(&strm);
+        return 0;
+    }
+
+    deflateEnd(&strm);
+    return (size_t) strm.total_out;
+}
@@ -182,7 +182,6 @@ typedef struct jzentry {  /* Zip file entry */
  */
 typedef struct jzcell {
     unsigned int hash;    /* 32 bit hashcode on name */
-    unsigned int next;    /* hash chain: index into jzfile->entries */
     jlong cenpos;         /* Offset of central directory file header */
 } jzcell;
 
@@ -224,8 +223,8 @@ typedef struct jzfile {   /* Zip file */
     char *msg;            /* zip error message */
     jzcell *entries;      /* array of hash cells */
     jint total;           /* total number of entries */
-    jint *table;          /* Hash chain heads: indexes into entries */
-    jint tablelen;        /* number of hash heads */
+    jint *table;          /* Open addressed index: indexes into entries */
+    jint tablelen;        /* number of index slots, a power of two */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
     /* Information on metadata names in META-INF directory */
@@ -237,7 +236,7 @@ typedef struct jzfile {   /* Zip file */
 } jzfile;
 
 /*
- * Index representing end of hash chain
+ * Index representing an empty slot in the entry index
  */
 #define ZIP_ENDCHAIN ((jint)-1)
 
@@ -284,4 +283,11 @@ jzentry * ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash);
 JNIEXPORT jboolean
 ZIP_InflateFully(void *inBuf, jlong inLen, void *outBuf, jlong outLen, char **pmsg);
 
+JNIEXPORT char*
+ZIP_GZip_InitParams(size_t inLen, size_t *outLen, size_t *tmpLen, int level);
+
+JNIEXPORT size_t
+ZIP_GZip_Fully(char *inBuf, size_t inLen, char *outBuf, size_t outLen, char *tmp,
+               size_t tmpLen, int level, char *comment, char **pmsg);
+
 #endif /* !_ZIP_H_ */
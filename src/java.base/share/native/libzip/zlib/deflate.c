@@ -1365,6 +1365,24 @@ local uInt longest_match(s, cur_match)
         scan += 2, match++;
         Assert(*scan == *match, "match[2]?");
 
+#ifdef DEFLATE_WORD_MATCH
+        /* Compare eight bytes at a time from strstart+3 to strstart+258,
+         * the same 256 bytes the loop below looks at.  On a mismatch the
+         * lowest differing byte ends the match.
+         */
+        scan++, match++;
+        do {
+            z_word_t sw, mw;
+            zmemcpy(&sw, scan, sizeof(sw));
+            zmemcpy(&mw, match, sizeof(mw));
+            if (sw != mw) {
+                scan += __builtin_ctzll(sw ^ mw) >> 3;
+                break;
+            }
+            scan += sizeof(sw), match += sizeof(mw);
+        } while (scan < strend);
+        if (scan > strend) scan = strend;
+#else
         /* We check for insufficient lookahead only every 8th comparison;
          * the 256th check will be made at strstart+258.
          */
@@ -1374,6 +1392,7 @@ local uInt longest_match(s, cur_match)
                  *++scan == *++match && *++scan == *++match &&
                  *++scan == *++match && *++scan == *++match &&
                  scan < strend);
+#endif
 
         Assert(scan <= s->window+(unsigned)(s->window_size-1), "wild scan");
 
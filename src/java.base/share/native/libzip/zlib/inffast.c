@@ -36,6 +36,45 @@
 #  pragma message("Assembler code may have bugs -- use at your own risk")
 #else
 
+#ifdef INFLATE_CHUNK_COPY
+/*
+   Copy len bytes of a match that starts dist bytes back in the output.
+   If dist is at least the word size, every word read has already been
+   written, so the copy can proceed a word at a time and finish with one
+   word that ends exactly at the end of the match.  Nothing is written
+   past the match.  Runs of a single byte are filled directly.  Returns
+   the updated output pointer.
+ */
+local unsigned char FAR *chunk_copy(out, dist, len)
+unsigned char FAR *out;
+unsigned dist;
+unsigned len;
+{
+    const unsigned char FAR *from = out - dist;
+
+    if (dist >= sizeof(z_word_t) && len >= sizeof(z_word_t)) {
+        unsigned char FAR *last = out + len - sizeof(z_word_t);
+        z_word_t w;
+        do {
+            zmemcpy(&w, from, sizeof(w));
+            zmemcpy(out, &w, sizeof(w));
+            out += sizeof(w);
+            from += sizeof(w);
+        } while (out < last);
+        zmemcpy(&w, last - dist, sizeof(w));
+        zmemcpy(last, &w, sizeof(w));
+        return last + sizeof(w);
+    }
+    if (dist == 1) {
+        memset(out, *from, len);
+        return out + len;
+    }
+    while (len--)
+        *out++ = *from++;
+    return out;
+}
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -225,10 +264,17 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
+#ifdef INFLATE_CHUNK_COPY
+                            zmemcpy(out, from, op);
+                            out += op;
+                            out = chunk_copy(out, dist, len);
+                            continue;           /* rest from output */
+#else
                             do {
                                 *out++ = *from++;
                             } while (--op);
                             from = out - dist;  /* rest from output */
+#endif
                         }
                     }
                     else if (wnext < op) {      /* wrap around window */
@@ -243,10 +289,17 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                             if (wnext < len) {  /* some from start of window */
                                 op = wnext;
                                 len -= op;
+#ifdef INFLATE_CHUNK_COPY
+                                zmemcpy(out, from, op);
+                                out += op;
+                                out = chunk_copy(out, dist, len);
+                                continue;       /* rest from output */
+#else
                                 do {
                                     *out++ = *from++;
                                 } while (--op);
                                 from = out - dist;      /* rest from output */
+#endif
                             }
                         }
                     }
@@ -254,10 +307,17 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wnext - op;
                         if (op < len) {         /* some from window */
                             len -= op;
+#ifdef INFLATE_CHUNK_COPY
+                            zmemcpy(out, from, op);
+                            out += op;
+                            out = chunk_copy(out, dist, len);
+                            continue;           /* rest from output */
+#else
                             do {
                                 *out++ = *from++;
                             } while (--op);
                             from = out - dist;  /* rest from output */
+#endif
                         }
                     }
                     while (len > 2) {
@@ -273,6 +333,9 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                     }
                 }
                 else {
+#ifdef INFLATE_CHUNK_COPY
+                    out = chunk_copy(out, dist, len);
+#else
                     from = out - dist;          /* copy direct from output */
                     do {                        /* minimum length is three */
                         *out++ = *from++;
@@ -285,6 +348,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         if (len > 1)
                             *out++ = *from++;
                     }
+#endif
                 }
             }
             else if ((op & 64) == 0) {          /* 2nd level distance code */
@@ -257,6 +257,19 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
    void ZLIB_INTERNAL zmemzero OF((Bytef* dest, uInt len));
 #endif
 
+/* Copy matches in inflate_fast() and extend matches in longest_match()
+   eight bytes at a time.  This relies on cheap unaligned loads and stores
+   and on little-endian byte order, so it is only enabled where both hold.
+   Define NO_WORD_COPY to build the byte at a time code instead.
+ */
+#if !defined(NO_WORD_COPY) && defined(HAVE_MEMCPY) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#  define INFLATE_CHUNK_COPY
+#  define DEFLATE_WORD_MATCH
+   typedef unsigned long long z_word_t;
+#endif
+
 /* Diagnostic functions */
 #ifdef ZLIB_DEBUG
 #  include <stdio.h>
@@ -31,6 +31,9 @@
 #include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include "childproc.h"
 
@@ -77,6 +80,25 @@ isAsciiDigit(char c)
   #define FD_DIR "/proc/self/fd"
 #endif
 
+#if defined(__linux__)
+/* close_range(2) has the same system call number on all architectures */
+#ifndef __NR_close_range
+#define __NR_close_range 436
+#endif
+
+/*
+ * Closes every descriptor from from_fd upwards with a single system call.
+ * Returns 0 if close_range(2) is not available (kernels before 5.9, or
+ * filtered by a seccomp policy), in which case the caller falls back to
+ * walking FD_DIR.
+ */
+static int
+closeDescriptorRange(int from_fd)
+{
+    return syscall(__NR_close_range, (unsigned int) from_fd, ~0U, 0) == 0;
+}
+#endif
+
 int
 closeDescriptors(void)
 {
@@ -84,6 +106,13 @@ closeDescriptors(void)
     struct dirent *dirp;
     int from_fd = FAIL_FILENO + 1;
 
+#if defined(__linux__)
+    /* Avoid one close() per open descriptor; with large descriptor tables
+     * the loop below dominates the cost of starting a process. */
+    if (closeDescriptorRange(from_fd))
+        return 1;
+#endif
+
     /* We're trying to close all file descriptors, but opendir() might
      * itself be implemented using a file descriptor, and we certainly
      * don't want to close that while it's in use.  We assume that if
@@ -89,6 +89,41 @@ int osSupport::unmap_memory(void *addr, size_t bytes) {
     return munmap((char *) addr, bytes) == 0;
 }
 
+struct ParallelTask {
+    void (*function)(void*);
+    void* arg;
+};
+
+static void* parallel_task_start(void* task) {
+    ParallelTask* t = (ParallelTask*) task;
+    t->function(t->arg);
+    return NULL;
+}
+
+/**
+ * Run function(arg) on the calling thread and on up to threads - 1
+ * additional threads, and wait for all of them to return.
+ */
+void osSupport::run_in_parallel(void (*function)(void*), void* arg, int threads) {
+    const int max_threads = 64;
+    pthread_t tids[max_threads];
+    ParallelTask task = { function, arg };
+    int started = 0;
+    if (threads > max_threads) {
+        threads = max_threads;
+    }
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&tids[started], NULL, parallel_task_start, &task) != 0) {
+            break;
+        }
+        started++;
+    }
+    function(arg);
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+}
+
 /**
  * A CriticalSection to protect a small section of code.
  */
@@ -31,6 +31,7 @@
 #include <netdb.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
@@ -52,6 +53,59 @@ static jfieldID dci_senderPortID; /* sender port in sun.nio.ch.DatagramChannelIm
 static jclass isa_class;        /* java.net.InetSocketAddress */
 static jmethodID isa_ctorID;    /*   .InetSocketAddress(InetAddress, int) */
 
+/* Maximum number of datagrams moved by one receiveBatch0 or sendBatch0 */
+#define MAX_BATCH 64
+
+/*
+ * recvmmsg and sendmmsg are used where available. Elsewhere a batch is
+ * emulated with recvmsg and sendmsg, stopping at the first datagram that
+ * cannot be moved without blocking, so only the system call count differs.
+ */
+#ifdef __linux__
+
+typedef struct mmsghdr batch_msg;
+
+static int batch_recv(int fd, batch_msg *msgs, int count) {
+    return recvmmsg(fd, msgs, count, MSG_WAITFORONE, NULL);
+}
+
+static int batch_send(int fd, batch_msg *msgs, int count) {
+    return sendmmsg(fd, msgs, count, 0);
+}
+
+#else
+
+typedef struct {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+} batch_msg;
+
+static int batch_recv(int fd, batch_msg *msgs, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        ssize_t n = recvmsg(fd, &msgs[i].msg_hdr, (i == 0) ? 0 : MSG_DONTWAIT);
+        if (n < 0) {
+            return (i == 0) ? -1 : i;
+        }
+        msgs[i].msg_len = (unsigned int)n;
+    }
+    return count;
+}
+
+static int batch_send(int fd, batch_msg *msgs, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        ssize_t n = sendmsg(fd, &msgs[i].msg_hdr, 0);
+        if (n < 0) {
+            return (i == 0) ? -1 : i;
+        }
+        msgs[i].msg_len = (unsigned int)n;
+    }
+    return count;
+}
+
+#endif
+
 JNIEXPORT void JNICALL
 Java_sun_nio_ch_DatagramChannelImpl_initIDs(JNIEnv *env, jclass clazz)
 {
@@ -121,6 +175,46 @@ Java_sun_nio_ch_DatagramChannelImpl_disconnect0(JNIEnv *env, jobject this,
         handleSocketError(env, errno);
 }
 
+/*
+ * Sets the sender field of DatagramChannelImpl to the InetSocketAddress
+ * for sa and returns it, or returns NULL with an exception pending.
+ * If the source address and port match the cached address and port then
+ * we don't need to create InetAddress and InetSocketAddress objects.
+ */
+static jobject
+updateSender(JNIEnv *env, jobject this, SOCKETADDRESS *sa)
+{
+    jobject senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
+    jobject isa = NULL;
+
+    if (senderAddr != NULL) {
+        if (!NET_SockaddrEqualsInetAddress(env, sa, senderAddr)) {
+            senderAddr = NULL;
+        } else {
+            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
+            if (port != NET_GetPortFromSockaddr(sa)) {
+                senderAddr = NULL;
+            }
+        }
+    }
+    if (senderAddr == NULL) {
+        int port = 0;
+        jobject ia = NET_SockaddrToInetAddress(env, sa, &port);
+        if (ia != NULL) {
+            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
+        }
+        CHECK_NULL_RETURN(isa, NULL);
+
+        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
+        (*env)->SetIntField(env, this, dci_senderPortID,
+                            NET_GetPortFromSockaddr(sa));
+        (*env)->SetObjectField(env, this, dci_senderID, isa);
+    } else {
+        isa = (*env)->GetObjectField(env, this, dci_senderID);
+    }
+    return isa;
+}
+
 JNIEXPORT jint JNICALL
 Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
                                              jobject fdo, jlong address,
@@ -132,7 +226,6 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
     socklen_t sa_len = sizeof(SOCKETADDRESS);
     jboolean retry = JNI_FALSE;
     jint n = 0;
-    jobject senderAddr;
 
     if (len > MAX_PACKET_LEN) {
         len = MAX_PACKET_LEN;
@@ -162,35 +255,8 @@ Java_sun_nio_ch_DatagramChannelImpl_receive0(JNIEnv *env, jobject this,
         }
     } while (retry == JNI_TRUE);
 
-    /*
-     * If the source address and port match the cached address
-     * and port in DatagramChannelImpl then we don't need to
-     * create InetAddress and InetSocketAddress objects.
-     */
-    senderAddr = (*env)->GetObjectField(env, this, dci_senderAddrID);
-    if (senderAddr != NULL) {
-        if (!NET_SockaddrEqualsInetAddress(env, &sa, senderAddr)) {
-            senderAddr = NULL;
-        } else {
-            jint port = (*env)->GetIntField(env, this, dci_senderPortID);
-            if (port != NET_GetPortFromSockaddr(&sa)) {
-                senderAddr = NULL;
-            }
-        }
-    }
-    if (senderAddr == NULL) {
-        jobject isa = NULL;
-        int port = 0;
-        jobject ia = NET_SockaddrToInetAddress(env, &sa, &port);
-        if (ia != NULL) {
-            isa = (*env)->NewObject(env, isa_class, isa_ctorID, ia, port);
-        }
-        CHECK_NULL_RETURN(isa, IOS_THROWN);
-
-        (*env)->SetObjectField(env, this, dci_senderAddrID, ia);
-        (*env)->SetIntField(env, this, dci_senderPortID,
-                            NET_GetPortFromSockaddr(&sa));
-        (*env)->SetObjectField(env, this, dci_senderID, isa);
+    if (updateSender(env, this, &sa) == NULL) {
+        return IOS_THROWN;
     }
     return n;
 }
@@ -231,3 +297,160 @@ Java_sun_nio_ch_DatagramChannelImpl_send0(JNIEnv *env, jobject this,
     }
     return n;
 }
+
+/*
+ * Receives up to count datagrams with as few system calls as possible.
+ * The datagrams are read into the buffers described by the array of count
+ * iovec structures at address, one buffer per datagram, and their lengths
+ * are stored in the jint array at lengthsAddress. If senders is not NULL,
+ * the source address of each datagram is stored in it. Blocks only until
+ * the first datagram is received. Returns the number of datagrams received.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_receiveBatch0(JNIEnv *env, jobject this,
+                                                  jobject fdo, jlong address,
+                                                  jint count, jlong lengthsAddress,
+                                                  jobjectArray senders,
+                                                  jboolean connected)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    jint *lengths = (jint *)jlong_to_ptr(lengthsAddress);
+    batch_msg msgs[MAX_BATCH];
+    SOCKETADDRESS sa[MAX_BATCH];
+    jboolean retry = JNI_FALSE;
+    int i, n = 0;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    for (i = 0; i < count; i++) {
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (senders != NULL) {
+            msgs[i].msg_hdr.msg_name = &sa[i].sa;
+        }
+    }
+
+    do {
+        retry = JNI_FALSE;
+        for (i = 0; i < count; i++) {
+            msgs[i].msg_hdr.msg_namelen = (senders != NULL) ? sizeof(SOCKETADDRESS) : 0;
+        }
+        n = batch_recv(fd, msgs, count);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return IOS_UNAVAILABLE;
+            }
+            if (errno == EINTR) {
+                return IOS_INTERRUPTED;
+            }
+            if (errno == ECONNREFUSED) {
+                if (connected == JNI_FALSE) {
+                    retry = JNI_TRUE;
+                } else {
+                    JNU_ThrowByName(env, JNU_JAVANETPKG
+                                    "PortUnreachableException", 0);
+                    return IOS_THROWN;
+                }
+            } else {
+                return handleSocketError(env, errno);
+            }
+        }
+    } while (retry == JNI_TRUE);
+
+    for (i = 0; i < n; i++) {
+        lengths[i] = (jint)msgs[i].msg_len;
+        if (senders != NULL) {
+            jobject isa = updateSender(env, this, &sa[i]);
+            if (isa == NULL) {
+                return IOS_THROWN;
+            }
+            (*env)->SetObjectArrayElement(env, senders, i, isa);
+            (*env)->DeleteLocalRef(env, isa);
+        }
+    }
+    return n;
+}
+
+/*
+ * Sends up to count datagrams with as few system calls as possible. Each
+ * datagram is the buffer described by the corresponding iovec structure
+ * in the array at address. If targets is not NULL, datagram i is sent to
+ * targets[i] and ports[i], otherwise to the connected peer. The number of
+ * bytes sent for each datagram is stored in the jint array at
+ * lengthsAddress. Returns the number of datagrams sent.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_nio_ch_DatagramChannelImpl_sendBatch0(JNIEnv *env, jobject this,
+                                               jboolean preferIPv6, jobject fdo,
+                                               jlong address, jint count,
+                                               jlong lengthsAddress,
+                                               jobjectArray targets,
+                                               jintArray ports)
+{
+    jint fd = fdval(env, fdo);
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    jint *lengths = (jint *)jlong_to_ptr(lengthsAddress);
+    batch_msg msgs[MAX_BATCH];
+    struct iovec vec[MAX_BATCH];
+    SOCKETADDRESS sa[MAX_BATCH];
+    jint port[MAX_BATCH];
+    int i, n = 0;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    if (targets != NULL) {
+        (*env)->GetIntArrayRegion(env, ports, 0, count, port);
+        if ((*env)->ExceptionCheck(env)) {
+            return IOS_THROWN;
+        }
+    }
+    for (i = 0; i < count; i++) {
+        vec[i] = iov[i];
+        if (vec[i].iov_len > MAX_PACKET_LEN) {
+            vec[i].iov_len = MAX_PACKET_LEN;
+        }
+        msgs[i].msg_hdr.msg_iov = &vec[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (targets != NULL) {
+            int sa_len = 0;
+            jobject ia = (*env)->GetObjectArrayElement(env, targets, i);
+            if (ia == NULL) {
+                JNU_ThrowNullPointerException(env, NULL);
+                return IOS_THROWN;
+            }
+            if (NET_InetAddressToSockaddr(env, ia, port[i], &sa[i],
+                                          &sa_len, preferIPv6) != 0) {
+                return IOS_THROWN;
+            }
+            (*env)->DeleteLocalRef(env, ia);
+            msgs[i].msg_hdr.msg_name = &sa[i].sa;
+            msgs[i].msg_hdr.msg_namelen = sa_len;
+        }
+    }
+
+    n = batch_send(fd, msgs, count);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        }
+        if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        }
+        if (errno == ECONNREFUSED) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "PortUnreachableException", 0);
+            return IOS_THROWN;
+        }
+        return handleSocketError(env, errno);
+    }
+    for (i = 0; i < n; i++) {
+        lengths[i] = (jint)msgs[i].msg_len;
+    }
+    return n;
+}
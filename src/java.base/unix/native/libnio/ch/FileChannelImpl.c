@@ -29,7 +29,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#if defined(__linux__) || defined(__solaris__)
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(__solaris__)
 #include <sys/sendfile.h>
 #elif defined(_AIX)
 #include <string.h>
@@ -158,6 +161,39 @@ Java_sun_nio_ch_FileChannelImpl_unmap0(JNIEnv *env, jobject this,
                   "Unmap failed");
 }
 
+#if defined(__linux__) && defined(__NR_copy_file_range)
+/* Cleared once the kernel is found to lack copy_file_range */
+static volatile int copy_file_range_supported = 1;
+
+/*
+ * Copy between regular files with copy_file_range, which the kernel can
+ * satisfy by sharing extents or by a server side copy and otherwise
+ * copies without going through a pipe. Like sendfile, it reads from
+ * 'position' and writes at, and advances, the current position of the
+ * target. Returns -1 with errno set if the transfer should be retried
+ * with sendfile.
+ */
+static jlong
+copyFileRange(jint srcFD, jint dstFD, jlong position, jlong count)
+{
+    struct stat64 st;
+    off64_t offset = (off64_t)position;
+    jlong n;
+
+    if (!copy_file_range_supported ||
+        fstat64(dstFD, &st) != 0 || !S_ISREG(st.st_mode)) {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    n = syscall(__NR_copy_file_range, srcFD, &offset, dstFD, NULL,
+                (size_t)count, 0);
+    if (n < 0 && errno == ENOSYS) {
+        copy_file_range_supported = 0;
+    }
+    return n;
+}
+#endif
+
 JNIEXPORT jlong JNICALL
 Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
                                             jobject srcFDO,
@@ -169,7 +205,20 @@ Java_sun_nio_ch_FileChannelImpl_transferTo0(JNIEnv *env, jobject this,
 
 #if defined(__linux__)
     off64_t offset = (off64_t)position;
-    jlong n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
+    jlong n;
+#if defined(__NR_copy_file_range)
+    n = copyFileRange(srcFD, dstFD, position, count);
+    if (n > 0)
+        return n;
+    if (n < 0 && errno == EINTR)
+        return IOS_INTERRUPTED;
+    /*
+     * Not supported for this pair of files (EXDEV, EINVAL, ...), or no
+     * bytes copied, which some file systems report for files whose size
+     * is not known in advance: use sendfile
+     */
+#endif
+    n = sendfile64(dstFD, srcFD, &offset, (size_t)count);
     if (n < 0) {
         if (errno == EAGAIN)
             return IOS_UNAVAILABLE;
@@ -114,6 +114,44 @@ int osSupport::unmap_memory(void* addr, size_t bytes) {
     return result;
 }
 
+struct ParallelTask {
+    void (*function)(void*);
+    void* arg;
+};
+
+static DWORD WINAPI parallel_task_start(LPVOID task) {
+    ParallelTask* t = (ParallelTask*) task;
+    t->function(t->arg);
+    return 0;
+}
+
+/**
+ * Run function(arg) on the calling thread and on up to threads - 1
+ * additional threads, and wait for all of them to return.
+ */
+void osSupport::run_in_parallel(void (*function)(void*), void* arg, int threads) {
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+    ParallelTask task = { function, arg };
+    DWORD started = 0;
+    if (threads > MAXIMUM_WAIT_OBJECTS) {
+        threads = MAXIMUM_WAIT_OBJECTS;
+    }
+    for (int i = 1; i < threads; i++) {
+        HANDLE h = CreateThread(NULL, 0, parallel_task_start, &task, 0, NULL);
+        if (h == NULL) {
+            break;
+        }
+        handles[started++] = h;
+    }
+    function(arg);
+    if (started > 0) {
+        WaitForMultipleObjects(started, handles, TRUE, INFINITE);
+        for (DWORD i = 0; i < started; i++) {
+            CloseHandle(handles[i]);
+        }
+    }
+}
+
 /**
  * A CriticalSection to protect a small section of code.
  */
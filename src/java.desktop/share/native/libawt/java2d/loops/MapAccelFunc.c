@@ -23,15 +23,64 @@
  * questions.
  */
 
+#include <stdlib.h>
+
 #include "GraphicsPrimitiveMgr.h"
+#include "sse2_Loops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+MaskFillFunc IntArgbPreSrcOverMaskFill;
+MaskFillFunc IntRgbSrcOverMaskFill;
+BlitFunc IntArgbToIntArgbPreConvert;
+
+typedef struct {
+    AnyFunc  *func_c;
+    AnyFunc  *func_sse2;
+} AnyFunc_pair;
+
+#define ADD_FUNC(x)    \
+    { (AnyFunc *) & x, (AnyFunc *) & x ## _SSE2 }
+
+static AnyFunc_pair sse2_func_pair_array[] = {
+    ADD_FUNC(IntArgbPreSrcOverMaskFill),
+    ADD_FUNC(IntRgbSrcOverMaskFill),
+    ADD_FUNC(IntArgbToIntArgbPreConvert),
+};
+
+#define NUM_SSE2_FUNCS \
+    (sizeof(sse2_func_pair_array) / sizeof(sse2_func_pair_array[0]))
+
+static int initialized = 0;
+static jboolean usesse2 = JNI_TRUE;
+
+#endif /* J2D_SSE2_LOOPS */
 
 /*
- * This is a dummy function that satisfies the MapAccelFunction
- * contract by simply returning a pointer to the indicated
- * C function.  This function is only executed in the absence
- * of an implementation specific function that maps the C
- * functions to accelerated versions of the same operation.
+ * This function returns a pointer to the SSE2 version of the
+ * indicated C function on x86 platforms, if there is one and
+ * the J2D_USE_SSE2_LOOPS environment variable does not disable
+ * them.  Otherwise it satisfies the MapAccelFunction contract
+ * by simply returning a pointer to the indicated C function.
  */
 AnyFunc *MapAccelFunction(AnyFunc *c_func) {
+#ifdef J2D_SSE2_LOOPS
+    size_t i;
+
+    if (!initialized) {
+        char *sse2_env = getenv("J2D_USE_SSE2_LOOPS");
+        if (sse2_env != NULL && (*sse2_env == 'f' || *sse2_env == 'F')) {
+            usesse2 = JNI_FALSE;
+        }
+        initialized = 1;
+    }
+    if (usesse2) {
+        for (i = 0; i < NUM_SSE2_FUNCS; i++) {
+            if (sse2_func_pair_array[i].func_c == c_func) {
+                return sse2_func_pair_array[i].func_sse2;
+            }
+        }
+    }
+#endif /* J2D_SSE2_LOOPS */
     return c_func;
 }
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+/*
+ * SSE2 versions of a few of the most heavily used software loops.
+ * MapAccelFunction (MapAccelFunc.c) substitutes them for the generic
+ * C versions, which are defined by the macros in AlphaMacros.h and
+ * LoopMacros.h, when the primitives are registered.
+ *
+ * The results are bit-for-bit identical to the C loops.  MUL8 never
+ * needs more than 16 bits of precision, and mul8table[a][b] is equal
+ * to ((t + (t >> 8)) >> 8) with t = a * b + 128 for every a and b,
+ * so each table lookup becomes a handful of 16-bit lane operations
+ * and four pixels are processed at a time.
+ */
+
+#include "sse2_Loops.h"
+
+#ifdef J2D_SSE2_LOOPS
+
+#include <string.h>
+#include <emmintrin.h>
+
+#include "AlphaMath.h"
+
+/* Per 16-bit lane MUL8 of two vectors whose lanes are all <= 0xff */
+static inline __m128i
+Mul8x8(__m128i a, __m128i b, __m128i half)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), half);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+/* Replicates the alpha lane of each of the two pixels in v */
+static inline __m128i
+BroadcastAlpha(__m128i v)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xff), 0xff);
+}
+
+/*
+ * Computes res + MUL8(0xff - resA, dst) on every component of four
+ * pixels, where res is MUL8(pathA, src) for the per-pixel coverage in
+ * pathLo (pixels 0 and 1) and pathHi (pixels 2 and 3).  This is the
+ * SrcOver equation for a premultiplied source and destination,
+ * including the alpha component.
+ */
+static inline __m128i
+SrcOverPre4(__m128i dst, __m128i src,
+            __m128i pathLo, __m128i pathHi,
+            __m128i zero, __m128i half, __m128i max)
+{
+    __m128i resLo = Mul8x8(pathLo, src, half);
+    __m128i resHi = Mul8x8(pathHi, src, half);
+    __m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+    __m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+    __m128i dstFLo = _mm_sub_epi16(max, BroadcastAlpha(resLo));
+    __m128i dstFHi = _mm_sub_epi16(max, BroadcastAlpha(resHi));
+    resLo = _mm_add_epi16(resLo, Mul8x8(dstFLo, dstLo, half));
+    resHi = _mm_add_epi16(resHi, Mul8x8(dstFHi, dstHi, half));
+    return _mm_packus_epi16(resLo, resHi);
+}
+
+/* Expands four coverage bytes into two vectors of 16-bit lanes */
+static inline void
+LoadPath4(const jubyte *pMask, __m128i zero, __m128i *pLo, __m128i *pHi)
+{
+    jint m;
+    __m128i path;
+
+    memcpy(&m, pMask, sizeof(m));
+    path = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);  /* 4 x 16 */
+    path = _mm_unpacklo_epi16(path, path);                 /* 4 x 32 */
+    *pLo = _mm_unpacklo_epi32(path, path);
+    *pHi = _mm_unpackhi_epi32(path, path);
+}
+
+/*
+ * Scalar form of SrcOverPre4 for a single pixel, used for the pixels
+ * left over at the end of each row.
+ */
+static inline juint
+SrcOverPre1(juint dst, jint pathA, jint srcA, jint srcR, jint srcG, jint srcB)
+{
+    jint resA = MUL8(pathA, srcA);
+    jint dstF = 0xff - resA;
+    jint a = resA + MUL8(dstF, (dst >> 24));
+    jint r = MUL8(pathA, srcR) + MUL8(dstF, (dst >> 16) & 0xff);
+    jint g = MUL8(pathA, srcG) + MUL8(dstF, (dst >>  8) & 0xff);
+    jint b = MUL8(pathA, srcB) + MUL8(dstF, (dst      ) & 0xff);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+/*
+ * Shared body of the IntArgbPre and IntRgb SrcOver MaskFill loops.
+ * IntRgb is opaque, so the stored alpha byte is cleared instead;
+ * MUL8(0xff - resA, 0xff) == 0xff - resA, so the color components
+ * come out of the same premultiplied equation as for IntArgbPre.
+ */
+static void
+SrcOverMaskFill4ByteArgb(void *rasBase,
+                         jubyte *pMask, jint maskOff, jint maskScan,
+                         jint width, jint height,
+                         jint fgColor,
+                         SurfaceDataRasInfo *pRasInfo,
+                         juint alphaMask)
+{
+    jint rasScan = pRasInfo->scanStride;
+    juint *pRas = (juint *) rasBase;
+    jint srcA = ((juint) fgColor) >> 24;
+    jint srcR = (fgColor >> 16) & 0xff;
+    jint srcG = (fgColor >>  8) & 0xff;
+    jint srcB = (fgColor      ) & 0xff;
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(0x80);
+    __m128i max = _mm_set1_epi16(0xff);
+    __m128i keep = _mm_set1_epi32(alphaMask | 0x00ffffff);
+    __m128i src;
+
+    if (srcA != 0xff) {
+        if (srcA == 0) {
+            return;
+        }
+        srcR = MUL8(srcA, srcR);
+        srcG = MUL8(srcA, srcG);
+        srcB = MUL8(srcA, srcB);
+    }
+    src = _mm_set_epi16((short) srcA, (short) srcR, (short) srcG, (short) srcB,
+                        (short) srcA, (short) srcR, (short) srcG, (short) srcB);
+
+    if (pMask) {
+        pMask += maskOff;
+        do {
+            jint x = 0;
+            for (; x + 4 <= width; x += 4) {
+                __m128i dst = _mm_loadu_si128((__m128i *) (pRas + x));
+                __m128i pathLo, pathHi, res, skip;
+                jint m;
+
+                memcpy(&m, pMask + x, sizeof(m));
+                if (m == 0) {
+                    continue;
+                }
+                LoadPath4(pMask + x, zero, &pathLo, &pathHi);
+                res = SrcOverPre4(dst, src, pathLo, pathHi, zero, half, max);
+                res = _mm_and_si128(res, keep);
+                /* pixels with no coverage are not written at all */
+                skip = _mm_unpacklo_epi8(_mm_cvtsi32_si128(m), zero);
+                skip = _mm_cmpeq_epi32(_mm_unpacklo_epi16(skip, zero), zero);
+                res = _mm_or_si128(_mm_and_si128(skip, dst),
+                                   _mm_andnot_si128(skip, res));
+                _mm_storeu_si128((__m128i *) (pRas + x), res);
+            }
+            for (; x < width; x++) {
+                jint pathA = pMask[x];
+                if (pathA) {
+                    pRas[x] = SrcOverPre1(pRas[x], pathA,
+                                          srcA, srcR, srcG, srcB) & alphaMask;
+                }
+            }
+            pRas = PtrAddBytes(pRas, rasScan);
+            pMask = PtrAddBytes(pMask, maskScan);
+        } while (--height > 0);
+    } else {
+        do {
+            jint x = 0;
+            for (; x + 4 <= width; x += 4) {
+                __m128i dst = _mm_loadu_si128((__m128i *) (pRas + x));
+                /* full coverage, MUL8(0xff, src) == src */
+                __m128i res = SrcOverPre4(dst, src, max, max,
+                                          zero, half, max);
+                _mm_storeu_si128((__m128i *) (pRas + x),
+                                 _mm_and_si128(res, keep));
+            }
+            for (; x < width; x++) {
+                pRas[x] = SrcOverPre1(pRas[x], 0xff,
+                                      srcA, srcR, srcG, srcB) & alphaMask;
+            }
+            pRas = PtrAddBytes(pRas, rasScan);
+        } while (--height > 0);
+    }
+}
+
+void
+IntArgbPreSrcOverMaskFill_SSE2(void *rasBase,
+                               jubyte *pMask, jint maskOff, jint maskScan,
+                               jint width, jint height,
+                               jint fgColor,
+                               SurfaceDataRasInfo *pRasInfo,
+                               NativePrimitive *pPrim,
+                               CompositeInfo *pCompInfo)
+{
+    SrcOverMaskFill4ByteArgb(rasBase, pMask, maskOff, maskScan,
+                             width, height, fgColor, pRasInfo, 0xffffffff);
+}
+
+void
+IntRgbSrcOverMaskFill_SSE2(void *rasBase,
+                           jubyte *pMask, jint maskOff, jint maskScan,
+                           jint width, jint height,
+                           jint fgColor,
+                           SurfaceDataRasInfo *pRasInfo,
+                           NativePrimitive *pPrim,
+                           CompositeInfo *pCompInfo)
+{
+    SrcOverMaskFill4ByteArgb(rasBase, pMask, maskOff, maskScan,
+                             width, height, fgColor, pRasInfo, 0x00ffffff);
+}
+
+void
+IntArgbToIntArgbPreConvert_SSE2(void *srcBase, void *dstBase,
+                                juint width, juint height,
+                                SurfaceDataRasInfo *pSrcInfo,
+                                SurfaceDataRasInfo *pDstInfo,
+                                NativePrimitive *pPrim,
+                                CompositeInfo *pCompInfo)
+{
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    juint *pSrc = (juint *) srcBase;
+    juint *pDst = (juint *) dstBase;
+    __m128i zero = _mm_setzero_si128();
+    __m128i half = _mm_set1_epi16(0x80);
+    __m128i alpha = _mm_set1_epi32(0xff000000);
+
+    do {
+        juint x = 0;
+        for (; x + 4 <= width; x += 4) {
+            __m128i pix = _mm_loadu_si128((__m128i *) (pSrc + x));
+            __m128i lo = _mm_unpacklo_epi8(pix, zero);
+            __m128i hi = _mm_unpackhi_epi8(pix, zero);
+            __m128i res;
+            lo = Mul8x8(BroadcastAlpha(lo), lo, half);
+            hi = Mul8x8(BroadcastAlpha(hi), hi, half);
+            res = _mm_packus_epi16(lo, hi);
+            /* the alpha byte itself is copied, not multiplied */
+            res = _mm_or_si128(_mm_and_si128(pix, alpha),
+                               _mm_andnot_si128(alpha, res));
+            _mm_storeu_si128((__m128i *) (pDst + x), res);
+        }
+        for (; x < width; x++) {
+            juint argb = pSrc[x];
+            jint a = argb >> 24;
+            if (a == 0xff) {
+                pDst[x] = argb;
+            } else {
+                jint r = MUL8(a, (argb >> 16) & 0xff);
+                jint g = MUL8(a, (argb >>  8) & 0xff);
+                jint b = MUL8(a, (argb      ) & 0xff);
+                pDst[x] = (a << 24) | (r << 16) | (g << 8) | b;
+            }
+        }
+        pSrc = PtrAddBytes(pSrc, srcScan);
+        pDst = PtrAddBytes(pDst, dstScan);
+    } while (--height > 0);
+}
+
+#endif /* J2D_SSE2_LOOPS */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef sse2_Loops_h_Included
+#define sse2_Loops_h_Included
+
+#include "GraphicsPrimitiveMgr.h"
+
+/*
+ * SSE2 is part of the base x86_64 instruction set, and of 32-bit x86
+ * builds that are compiled for it, so no runtime CPU check is needed.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define J2D_SSE2_LOOPS
+#endif
+
+#ifdef J2D_SSE2_LOOPS
+
+MaskFillFunc IntArgbPreSrcOverMaskFill_SSE2;
+MaskFillFunc IntRgbSrcOverMaskFill_SSE2;
+BlitFunc IntArgbToIntArgbPreConvert_SSE2;
+
+#endif /* J2D_SSE2_LOOPS */
+
+#endif /* sse2_Loops_h_Included */
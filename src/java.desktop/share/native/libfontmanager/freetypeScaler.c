@@ -52,6 +52,9 @@
 #define  FT26Dot6ToFloat(x)  ((x) / ((float) (1<<6)))
 #define  FT26Dot6ToInt(x) (((int)(x)) >> 6)
 
+/* number of FT_Size objects kept per face, see activateFTSize */
+#define  FT_SIZE_CACHE_LENGTH 8
+
 typedef struct {
     /* Important note:
          JNI forbids sharing same env between different threads.
@@ -73,6 +76,12 @@ typedef struct {
     unsigned fontDataOffset;
     unsigned fontDataLength;
     unsigned fileSize;
+
+    /* Sizes of recently used scaler contexts, most recently used first.
+       They are children of the face and are freed by FT_Done_Face. */
+    FT_Size sizes[FT_SIZE_CACHE_LENGTH];
+    int sizePtsz[FT_SIZE_CACHE_LENGTH];
+    int numSizes;
 } FTScalerInfo;
 
 typedef struct FTScalerContext {
@@ -472,6 +481,58 @@ Java_sun_font_FreetypeFontScaler_createScalerContextNative(
     return ptr_to_jlong(context);
 }
 
+/* Makes a size of ptsz (26.6 points) the active size of the face.
+ *
+ * All strikes of a font share one FTScalerInfo, so text that mixes sizes
+ * of the same font would otherwise call FT_Set_Char_Size for nearly every
+ * glyph. For TrueType fonts that also reruns the hinting "prep" program.
+ * Instead each entry of a small per-face cache owns its own FT_Size, and
+ * switching between cached sizes is just FT_Activate_Size.
+ * The least recently used entry is reused when the cache is full.
+ */
+static int activateFTSize(FTScalerInfo *scalerInfo, int ptsz) {
+    FT_Size size;
+    int i, errCode;
+
+    for (i = 0; i < scalerInfo->numSizes; i++) {
+        if (scalerInfo->sizePtsz[i] == ptsz) {
+            break;
+        }
+    }
+
+    if (i < scalerInfo->numSizes) {
+        size = scalerInfo->sizes[i];
+        errCode = FT_Activate_Size(size);
+    } else {
+        if (scalerInfo->numSizes < FT_SIZE_CACHE_LENGTH) {
+            errCode = FT_New_Size(scalerInfo->face, &size);
+            if (errCode) {
+                return errCode;
+            }
+            i = scalerInfo->numSizes++;
+            scalerInfo->sizes[i] = size;
+        } else {
+            i = FT_SIZE_CACHE_LENGTH - 1;
+            size = scalerInfo->sizes[i];
+        }
+        errCode = FT_Activate_Size(size);
+        if (errCode == 0) {
+            errCode = FT_Set_Char_Size(scalerInfo->face, 0, ptsz, 72, 72);
+        }
+    }
+
+    /* move the entry to the front */
+    for (; i > 0; i--) {
+        scalerInfo->sizes[i] = scalerInfo->sizes[i - 1];
+        scalerInfo->sizePtsz[i] = scalerInfo->sizePtsz[i - 1];
+    }
+    scalerInfo->sizes[0] = size;
+    /* ptsz is never below 64, so a failed entry gets 0 to never match */
+    scalerInfo->sizePtsz[0] = (errCode == 0) ? ptsz : 0;
+
+    return errCode;
+}
+
 static int setupFTContext(JNIEnv *env,
                           jobject font2D,
                           FTScalerInfo *scalerInfo,
@@ -484,11 +545,7 @@ static int setupFTContext(JNIEnv *env,
     if (context != NULL) {
         FT_Set_Transform(scalerInfo->face, &context->transform, NULL);
 
-        errCode = FT_Set_Char_Size(scalerInfo->face, 0, context->ptsz, 72, 72);
-
-        if (errCode == 0) {
-            errCode = FT_Activate_Size(scalerInfo->face->size);
-        }
+        errCode = activateFTSize(scalerInfo, context->ptsz);
 
         FT_Library_SetLcdFilter(scalerInfo->library, FT_LCD_FILTER_DEFAULT);
     }
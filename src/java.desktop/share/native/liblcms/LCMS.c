@@ -26,11 +26,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
 #include "sun_java2d_cmm_lcms_LCMS.h"
 #include "jni_util.h"
 #include "Trace.h"
 #include "Disposer.h"
 #include <lcms2.h>
+#include "lcms2_plugin.h"
 #include "jlong.h"
 
 
@@ -104,6 +111,51 @@ typedef union {
     jint j;
 } TagSignature_t, *TagSignature_p;
 
+/*
+ * Transforms are kept in a small cache after their LCMSTransform objects
+ * are disposed, so that converting many images between the same profiles
+ * does not rebuild and reoptimize the same pipeline every time. An entry
+ * is keyed by the profile handles, the rendering intent and the pixel
+ * formats; it is dropped when one of its profiles is freed or modified.
+ */
+#define XFORM_CACHE_SIZE 16
+
+typedef struct xformCacheEntry_s {
+    cmsHTRANSFORM xform;
+    cmsHPROFILE profiles[DF_ICC_BUF_SIZE];
+    int numProfiles;        /* 0 when the entry can not be looked up */
+    jint renderType;
+    cmsUInt32Number inFormatter;
+    cmsUInt32Number outFormatter;
+    int refs;               /* number of LCMSTransform objects using xform */
+    unsigned int lastUse;
+} xformCacheEntry_t;
+
+static xformCacheEntry_t xformCache[XFORM_CACHE_SIZE];
+static unsigned int xformCacheClock = 0;
+static void *xformCacheLock = NULL;
+
+/*
+ * Large images are converted in bands of rows on several threads.
+ * A transform can be shared by threads since cmsDoTransform only reads it.
+ */
+#define XFORM_MAX_BANDS 8
+
+/* do not start a thread for less than this many pixels or rows */
+#define XFORM_BAND_MIN_PIXELS (256 * 1024)
+#define XFORM_BAND_MIN_ROWS 16
+
+typedef struct xformBand_s {
+    cmsHTRANSFORM xform;
+    char *inputRow;
+    char *outputRow;
+    int srcNextRowOffset;
+    int dstNextRowOffset;
+    int width;
+    int rows;
+    jboolean atOnce;        /* the rows are contiguous in both images */
+} xformBand_t;
+
 static jfieldID Trans_renderType_fID;
 static jfieldID Trans_ID_fID;
 static jfieldID IL_isIntPacked_fID;
@@ -138,14 +190,115 @@ JNIEXPORT jint JNICALL DEF_JNI_OnLoad(JavaVM *jvm, void *reserved) {
     javaVM = jvm;
 
     cmsSetLogErrorHandler(errorHandler);
+    /* without the lock transforms are simply not cached */
+    xformCacheLock = _cmsCreateMutex(NULL);
     return JNI_VERSION_1_6;
 }
 
+/*
+ * Returns a cached transform for the given key, or NULL.
+ * The caller holds xformCacheLock.
+ */
+static cmsHTRANSFORM lookupTransform(cmsHPROFILE *profiles, int numProfiles,
+                                     jint renderType,
+                                     cmsUInt32Number inFormatter,
+                                     cmsUInt32Number outFormatter)
+{
+    int i;
+
+    for (i = 0; i < XFORM_CACHE_SIZE; i++) {
+        xformCacheEntry_t *e = &xformCache[i];
+        if (e->xform != NULL && e->numProfiles == numProfiles &&
+            e->renderType == renderType &&
+            e->inFormatter == inFormatter && e->outFormatter == outFormatter &&
+            memcmp(e->profiles, profiles,
+                   numProfiles * sizeof(cmsHPROFILE)) == 0)
+        {
+            e->refs++;
+            e->lastUse = ++xformCacheClock;
+            return e->xform;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Adds a new transform to the cache, replacing the least recently used
+ * entry that is not in use. Does nothing if all entries are in use.
+ * The caller holds xformCacheLock.
+ */
+static void cacheTransform(cmsHTRANSFORM xform,
+                           cmsHPROFILE *profiles, int numProfiles,
+                           jint renderType,
+                           cmsUInt32Number inFormatter,
+                           cmsUInt32Number outFormatter)
+{
+    xformCacheEntry_t *e = NULL;
+    int i;
+
+    if (numProfiles > DF_ICC_BUF_SIZE) {
+        return;
+    }
+    for (i = 0; i < XFORM_CACHE_SIZE; i++) {
+        xformCacheEntry_t *c = &xformCache[i];
+        if (c->xform == NULL) {
+            e = c;
+            break;
+        }
+        if (c->refs == 0 && (e == NULL || c->lastUse < e->lastUse)) {
+            e = c;
+        }
+    }
+    if (e == NULL) {
+        return;
+    }
+    if (e->xform != NULL) {
+        cmsDeleteTransform(e->xform);
+    }
+    e->xform = xform;
+    memcpy(e->profiles, profiles, numProfiles * sizeof(cmsHPROFILE));
+    e->numProfiles = numProfiles;
+    e->renderType = renderType;
+    e->inFormatter = inFormatter;
+    e->outFormatter = outFormatter;
+    e->refs = 1;
+    e->lastUse = ++xformCacheClock;
+}
+
+/*
+ * Drops the cache entries built from the given profile, which is about
+ * to be closed or changed. Transforms still in use are deleted when their
+ * last LCMSTransform is disposed.
+ */
+static void invalidateTransforms(cmsHPROFILE pf)
+{
+    int i, j;
+
+    if (xformCacheLock == NULL || !_cmsLockMutex(NULL, xformCacheLock)) {
+        return;
+    }
+    for (i = 0; i < XFORM_CACHE_SIZE; i++) {
+        xformCacheEntry_t *e = &xformCache[i];
+        for (j = 0; j < e->numProfiles; j++) {
+            if (e->profiles[j] == pf) {
+                e->numProfiles = 0;
+                break;
+            }
+        }
+        if (e->xform != NULL && e->numProfiles == 0 && e->refs == 0) {
+            cmsDeleteTransform(e->xform);
+            e->xform = NULL;
+        }
+    }
+    _cmsUnlockMutex(NULL, xformCacheLock);
+}
+
 void LCMS_freeProfile(JNIEnv *env, jlong ptr) {
     lcmsProfile_p p = (lcmsProfile_p)jlong_to_ptr(ptr);
 
     if (p != NULL) {
         if (p->pf != NULL) {
+            invalidateTransforms(p->pf);
             cmsCloseProfile(p->pf);
         }
         free(p);
@@ -155,7 +308,24 @@ void LCMS_freeProfile(JNIEnv *env, jlong ptr) {
 void LCMS_freeTransform(JNIEnv *env, jlong ID)
 {
     cmsHTRANSFORM sTrans = jlong_to_ptr(ID);
+    int i;
+
     /* Passed ID is always valid native ref so there is no check for zero */
+    if (xformCacheLock != NULL && _cmsLockMutex(NULL, xformCacheLock)) {
+        for (i = 0; i < XFORM_CACHE_SIZE; i++) {
+            xformCacheEntry_t *e = &xformCache[i];
+            if (e->xform == sTrans) {
+                /* keep it for reuse unless its profiles are gone */
+                if (--e->refs == 0 && e->numProfiles == 0) {
+                    e->xform = NULL;
+                    break;
+                }
+                _cmsUnlockMutex(NULL, xformCacheLock);
+                return;
+            }
+        }
+        _cmsUnlockMutex(NULL, xformCacheLock);
+    }
     cmsDeleteTransform(sTrans);
 }
 
@@ -223,8 +393,24 @@ JNIEXPORT jlong JNICALL Java_sun_java2d_cmm_lcms_LCMS_createNativeTransform
         }
     }
 
-    sTrans = cmsCreateMultiprofileTransform(iccArray, j,
-        inFormatter, outFormatter, renderType, 0);
+    if (xformCacheLock != NULL && _cmsLockMutex(NULL, xformCacheLock)) {
+        sTrans = lookupTransform(iccArray, j, renderType,
+                                 inFormatter, outFormatter);
+        _cmsUnlockMutex(NULL, xformCacheLock);
+    }
+
+    if (sTrans == NULL) {
+        sTrans = cmsCreateMultiprofileTransform(iccArray, j,
+            inFormatter, outFormatter, renderType, 0);
+
+        if (sTrans != NULL && xformCacheLock != NULL &&
+            _cmsLockMutex(NULL, xformCacheLock))
+        {
+            cacheTransform(sTrans, iccArray, j, renderType,
+                           inFormatter, outFormatter);
+            _cmsUnlockMutex(NULL, xformCacheLock);
+        }
+    }
 
     (*env)->ReleaseLongArrayElements(env, profileIDs, ids, 0);
 
@@ -515,8 +701,12 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_setTagDataNative
     if (!status) {
         JNU_ThrowIllegalArgumentException(env, "Can not write tag data.");
     } else if (pfReplace != NULL) {
+        invalidateTransforms(sProf->pf);
         cmsCloseProfile(sProf->pf);
         sProf->pf = pfReplace;
+    } else {
+        /* the header was changed in place */
+        invalidateTransforms(sProf->pf);
     }
 }
 
@@ -562,6 +752,149 @@ void releaseILData (JNIEnv *env, void* pData, jint dataType,
     }
 }
 
+static void transformBand(xformBand_t *b)
+{
+    int i;
+
+    if (b->atOnce) {
+        cmsDoTransform(b->xform, b->inputRow, b->outputRow,
+                       b->width * b->rows);
+    } else {
+        char *inputRow = b->inputRow;
+        char *outputRow = b->outputRow;
+        for (i = 0; i < b->rows; i++) {
+            cmsDoTransform(b->xform, inputRow, outputRow, b->width);
+            inputRow += b->srcNextRowOffset;
+            outputRow += b->dstNextRowOffset;
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI transformBandThread(LPVOID p)
+#else
+static void *transformBandThread(void *p)
+#endif
+{
+    transformBand((xformBand_t *)p);
+    return 0;
+}
+
+/*
+ * Returns the size in bytes of one pixel in the given format, or 0 if
+ * the pixels of a row are not stored one after another.
+ */
+static int pixelSize(cmsUInt32Number format)
+{
+    int bytes = T_BYTES(format);
+
+    if (T_PLANAR(format)) {
+        return 0;
+    }
+    if (bytes == 0) {
+        /* doubles */
+        bytes = sizeof(cmsFloat64Number);
+    }
+    return bytes * (T_CHANNELS(format) + T_EXTRA(format));
+}
+
+static int processorCount(void)
+{
+    static int count = 0;
+
+    if (count == 0) {
+        int n;
+#ifdef _WIN32
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        n = (int)si.dwNumberOfProcessors;
+#else
+        n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        count = (n < 1) ? 1 : n;
+    }
+    return count;
+}
+
+/*
+ * Converts b->rows rows, splitting them into bands on several threads
+ * when the image is large enough to pay for starting them.
+ */
+static void transformRows(xformBand_t *b)
+{
+    xformBand_t band[XFORM_MAX_BANDS];
+    int started[XFORM_MAX_BANDS];
+#ifdef _WIN32
+    HANDLE thread[XFORM_MAX_BANDS];
+#else
+    pthread_t thread[XFORM_MAX_BANDS];
+#endif
+    int srcStride = b->srcNextRowOffset;
+    int dstStride = b->dstNextRowOffset;
+    int n = processorCount();
+    int i, r0;
+
+    if (n > XFORM_MAX_BANDS) {
+        n = XFORM_MAX_BANDS;
+    }
+    if (n > b->rows / XFORM_BAND_MIN_ROWS) {
+        n = b->rows / XFORM_BAND_MIN_ROWS;
+    }
+    if ((jlong)n * XFORM_BAND_MIN_PIXELS > (jlong)b->width * b->rows) {
+        n = (int)(((jlong)b->width * b->rows) / XFORM_BAND_MIN_PIXELS);
+    }
+    if (b->atOnce) {
+        /* the bands of a contiguous image start at whole rows */
+        int inSize = pixelSize(cmsGetTransformInputFormat(b->xform));
+        int outSize = pixelSize(cmsGetTransformOutputFormat(b->xform));
+        if (inSize == 0 || outSize == 0) {
+            n = 1;
+        }
+        srcStride = b->width * inSize;
+        dstStride = b->width * outSize;
+    }
+    if (n < 2) {
+        transformBand(b);
+        return;
+    }
+
+    r0 = 0;
+    for (i = 0; i < n; i++) {
+        int r1 = (int)(((jlong)b->rows * (i + 1)) / n);
+        band[i] = *b;
+        band[i].inputRow = b->inputRow + (size_t)r0 * srcStride;
+        band[i].outputRow = b->outputRow + (size_t)r0 * dstStride;
+        band[i].rows = r1 - r0;
+        r0 = r1;
+    }
+
+    started[0] = 0;
+    for (i = 1; i < n; i++) {
+#ifdef _WIN32
+        thread[i] = CreateThread(NULL, 0, transformBandThread, &band[i], 0, NULL);
+        started[i] = (thread[i] != NULL);
+#else
+        started[i] = (pthread_create(&thread[i], NULL,
+                                     transformBandThread, &band[i]) == 0);
+#endif
+    }
+    for (i = 0; i < n; i++) {
+        if (!started[i]) {
+            transformBand(&band[i]);
+        }
+    }
+    for (i = 1; i < n; i++) {
+        if (started[i]) {
+#ifdef _WIN32
+            WaitForSingleObject(thread[i], INFINITE);
+            CloseHandle(thread[i]);
+#else
+            pthread_join(thread[i], NULL);
+#endif
+        }
+    }
+}
+
 /*
  * Class:     sun_java2d_cmm_lcms_LCMS
  * Method:    colorConvert
@@ -573,13 +906,14 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     cmsHTRANSFORM sTrans = NULL;
     int srcDType, dstDType;
     int srcOffset, srcNextRowOffset, dstOffset, dstNextRowOffset;
-    int width, height, i;
+    int width, height;
     void* inputBuffer;
     void* outputBuffer;
     char* inputRow;
     char* outputRow;
     jobject srcData, dstData;
     jboolean srcAtOnce = JNI_FALSE, dstAtOnce = JNI_FALSE;
+    xformBand_t b;
 
     srcOffset = (*env)->GetIntField (env, src, IL_offset_fID);
     srcNextRowOffset = (*env)->GetIntField (env, src, IL_nextRowOffset_fID);
@@ -620,15 +954,15 @@ JNIEXPORT void JNICALL Java_sun_java2d_cmm_lcms_LCMS_colorConvert
     inputRow = (char*)inputBuffer + srcOffset;
     outputRow = (char*)outputBuffer + dstOffset;
 
-    if (srcAtOnce && dstAtOnce) {
-        cmsDoTransform(sTrans, inputRow, outputRow, width * height);
-    } else {
-        for (i = 0; i < height; i++) {
-            cmsDoTransform(sTrans, inputRow, outputRow, width);
-            inputRow += srcNextRowOffset;
-            outputRow += dstNextRowOffset;
-        }
-    }
+    b.xform = sTrans;
+    b.inputRow = inputRow;
+    b.outputRow = outputRow;
+    b.srcNextRowOffset = srcNextRowOffset;
+    b.dstNextRowOffset = dstNextRowOffset;
+    b.width = width;
+    b.rows = height;
+    b.atOnce = (srcAtOnce && dstAtOnce) ? JNI_TRUE : JNI_FALSE;
+    transformRows(&b);
 
     releaseILData(env, inputBuffer, srcDType, srcData);
     releaseILData(env, outputBuffer, dstDType, dstData);
@@ -70,10 +70,14 @@
  *      MLIB_SHORT, MLIB_USHORT or MLIB_INT data type.
  *
  *      src image can not have width or height larger than 32767.
+ *
+ *  Large images are resampled in bands of destination rows on several
+ *  threads, see mlib_ImageParallel.c.
  */
 
 #include "mlib_ImageCheck.h"
 #include "mlib_ImageAffine.h"
+#include "mlib_ImageParallel.h"
 
 
 /***************************************************************/
@@ -130,6 +134,56 @@ const type_affine_fun mlib_AffineFunArr_bc[] = {
 #define MAX_T_IND  3
 #endif /* i386 ( do not perform the coping by mlib_d64 data type for x86 ) */
 
+/***************************************************************/
+typedef struct {
+  type_affine_fun fun;
+  mlib_affine_param *param;
+  mlib_s32 nbands;
+} mlib_affine_bands;
+
+/***************************************************************/
+/*
+ * The kernels only depend on the per-row tables filled in by
+ * mlib_AffineEdges, so a band is the same call with a narrower
+ * [yStart, yFinish] range and dstData moved to the row before it.
+ */
+static mlib_status mlib_ImageAffine_band(void     *arg,
+                                         mlib_s32 band)
+{
+  mlib_affine_bands *bands = (mlib_affine_bands *) arg;
+  mlib_affine_param *param = bands->param;
+  mlib_affine_param param_b[1];
+  mlib_s32 rows = param->yFinish - param->yStart + 1;
+  mlib_s32 y0 = param->yStart + (rows * band) / bands->nbands;
+  mlib_s32 y1 = param->yStart + (rows * (band + 1)) / bands->nbands;
+
+  *param_b = *param;
+  param_b->yStart = y0;
+  param_b->yFinish = y1 - 1;
+  param_b->dstData = param->dstData + (mlib_addr) (y0 - param->yStart) * param->dstYStride;
+
+  return bands->fun(param_b);
+}
+
+/***************************************************************/
+static mlib_status mlib_ImageAffine_call(type_affine_fun   fun,
+                                         mlib_affine_param *param,
+                                         mlib_s32          kw)
+{
+  mlib_affine_bands bands[1];
+  mlib_s32 rows = param->yFinish - param->yStart + 1;
+  mlib_s32 nbands = mlib_ImageBandCount(rows, (mlib_d64) rows * param->max_xsize * kw * kw);
+
+  if (nbands <= 1)
+    return fun(param);
+
+  bands->fun = fun;
+  bands->param = param;
+  bands->nbands = nbands;
+
+  return mlib_ImageRunBands(mlib_ImageAffine_band, bands, nbands);
+}
+
 /***************************************************************/
 mlib_status mlib_ImageAffine_alltypes(mlib_image       *dst,
                                       const mlib_image *src,
@@ -222,18 +276,18 @@ mlib_status mlib_ImageAffine_alltypes(mlib_image       *dst,
           t_ind++;
         }
 
-        res = mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_call(mlib_AffineFunArr_nn[4 * t_ind + (nchan - 1)], param, kw);
         break;
 
       case MLIB_BILINEAR:
 
-        res = mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_call(mlib_AffineFunArr_bl[4 * t_ind + (nchan - 1)], param, kw);
         break;
 
       case MLIB_BICUBIC:
       case MLIB_BICUBIC2:
 
-        res = mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)] (param);
+        res = mlib_ImageAffine_call(mlib_AffineFunArr_bc[4 * t_ind + (nchan - 1)], param, kw);
         break;
     }
 
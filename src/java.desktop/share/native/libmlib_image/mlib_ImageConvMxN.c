@@ -88,6 +88,136 @@
 #include "mlib_c_ImageConv.h"
 #include "mlib_ImageClipping.h"
 #include "mlib_ImageConvEdge.h"
+#include "mlib_ImageParallel.h"
+
+/***************************************************************/
+static mlib_status mlib_ImageConvMxN_nw(mlib_image       *dst_i,
+                                        const mlib_image *src_i,
+                                        const void       *kernel,
+                                        mlib_s32         m,
+                                        mlib_s32         n,
+                                        mlib_s32         dm,
+                                        mlib_s32         dn,
+                                        mlib_s32         scale,
+                                        mlib_s32         cmask)
+{
+  mlib_type type = mlib_ImageGetType(dst_i);
+  mlib_status ret = MLIB_SUCCESS;
+
+  switch (type) {
+    case MLIB_BYTE:
+      ret = mlib_convMxNnw_u8(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+      break;
+    case MLIB_SHORT:
+#ifdef __sparc
+      ret = mlib_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+#else
+
+      if (mlib_ImageConvVersion(m, n, scale, type) == 0)
+        ret = mlib_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+      else
+        ret = mlib_i_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+#endif /* __sparc */
+      break;
+    case MLIB_USHORT:
+#ifdef __sparc
+      ret = mlib_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+#else
+
+      if (mlib_ImageConvVersion(m, n, scale, type) == 0)
+        ret = mlib_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+      else
+        ret = mlib_i_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+#endif /* __sparc */
+      break;
+    case MLIB_INT:
+      ret = mlib_convMxNnw_s32(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+      break;
+    case MLIB_FLOAT:
+      ret = mlib_convMxNnw_f32(dst_i, src_i, kernel, m, n, dm, dn, cmask);
+      break;
+    case MLIB_DOUBLE:
+      ret = mlib_convMxNnw_d64(dst_i, src_i, kernel, m, n, dm, dn, cmask);
+      break;
+
+  default:
+    /* For some reasons, there is no convolution routine for type MLIB_BIT.
+     * For now, we silently ignore it (because this image type is not used by java),
+     * but probably we have to report an error.
+     */
+    break;
+  }
+
+  return ret;
+}
+
+/***************************************************************/
+typedef struct {
+  mlib_image *dst_i;
+  const mlib_image *src_i;
+  const void *kernel;
+  mlib_s32 m, n, dm, dn, scale, cmask;
+  mlib_s32 nbands;
+} mlib_conv_bands;
+
+/***************************************************************/
+/*
+ * Destination row dn + i of the nw kernels only reads source rows
+ * i .. i + n - 1, so output rows [r0, r1) are computed by running the
+ * kernel on the sub-images made of rows [r0, r1 + n - 1).
+ */
+static mlib_status mlib_ImageConvMxN_band(void     *arg,
+                                          mlib_s32 band)
+{
+  mlib_conv_bands *bands = (mlib_conv_bands *) arg;
+  mlib_image dst_b[1], src_b[1];
+  mlib_s32 wid = mlib_ImageGetWidth(bands->dst_i);
+  mlib_s32 rows = mlib_ImageGetHeight(bands->dst_i) - bands->n + 1;
+  mlib_s32 r0 = (rows * band) / bands->nbands;
+  mlib_s32 r1 = (rows * (band + 1)) / bands->nbands;
+  mlib_s32 hgt = r1 - r0 + bands->n - 1;
+
+  if (mlib_ImageSetSubimage(dst_b, bands->dst_i, 0, r0, wid, hgt) == NULL ||
+      mlib_ImageSetSubimage(src_b, bands->src_i, 0, r0, wid, hgt) == NULL)
+    return MLIB_FAILURE;
+
+  return mlib_ImageConvMxN_nw(dst_b, src_b, bands->kernel, bands->m, bands->n,
+                              bands->dm, bands->dn, bands->scale, bands->cmask);
+}
+
+/***************************************************************/
+static mlib_status mlib_ImageConvMxN_nw_call(mlib_image       *dst_i,
+                                             const mlib_image *src_i,
+                                             const void       *kernel,
+                                             mlib_s32         m,
+                                             mlib_s32         n,
+                                             mlib_s32         dm,
+                                             mlib_s32         dn,
+                                             mlib_s32         scale,
+                                             mlib_s32         cmask)
+{
+  mlib_conv_bands bands[1];
+  mlib_s32 rows = mlib_ImageGetHeight(dst_i) - n + 1;
+  mlib_d64 work = (mlib_d64) rows * mlib_ImageGetWidth(dst_i) *
+                  mlib_ImageGetChannels(dst_i) * m * n;
+  mlib_s32 nbands = mlib_ImageBandCount(rows, work);
+
+  if (nbands <= 1)
+    return mlib_ImageConvMxN_nw(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
+
+  bands->dst_i = dst_i;
+  bands->src_i = src_i;
+  bands->kernel = kernel;
+  bands->m = m;
+  bands->n = n;
+  bands->dm = dm;
+  bands->dn = dn;
+  bands->scale = scale;
+  bands->cmask = cmask;
+  bands->nbands = nbands;
+
+  return mlib_ImageRunBands(mlib_ImageConvMxN_band, bands, nbands);
+}
 
 /***************************************************************/
 JNIEXPORT
@@ -177,49 +307,7 @@ mlib_status mlib_ImageConvMxN_f(mlib_image       *dst,
 
   if (edge != MLIB_EDGE_SRC_EXTEND) {
     if (mlib_ImageGetWidth(dst_i) >= m && mlib_ImageGetHeight(dst_i) >= n) {
-      switch (type) {
-        case MLIB_BYTE:
-          ret = mlib_convMxNnw_u8(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-          break;
-        case MLIB_SHORT:
-#ifdef __sparc
-          ret = mlib_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-#else
-
-          if (mlib_ImageConvVersion(m, n, scale, type) == 0)
-            ret = mlib_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-          else
-            ret = mlib_i_convMxNnw_s16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-#endif /* __sparc */
-          break;
-        case MLIB_USHORT:
-#ifdef __sparc
-          ret = mlib_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-#else
-
-          if (mlib_ImageConvVersion(m, n, scale, type) == 0)
-            ret = mlib_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-          else
-            ret = mlib_i_convMxNnw_u16(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-#endif /* __sparc */
-          break;
-        case MLIB_INT:
-          ret = mlib_convMxNnw_s32(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
-          break;
-        case MLIB_FLOAT:
-          ret = mlib_convMxNnw_f32(dst_i, src_i, kernel, m, n, dm, dn, cmask);
-          break;
-        case MLIB_DOUBLE:
-          ret = mlib_convMxNnw_d64(dst_i, src_i, kernel, m, n, dm, dn, cmask);
-          break;
-
-      default:
-        /* For some reasons, there is no convolution routine for type MLIB_BIT.
-         * For now, we silently ignore it (because this image type is not used by java),
-         * but probably we have to report an error.
-         */
-        break;
-      }
+      ret = mlib_ImageConvMxN_nw_call(dst_i, src_i, kernel, m, n, dm, dn, scale, cmask);
     }
 
     switch (edge) {
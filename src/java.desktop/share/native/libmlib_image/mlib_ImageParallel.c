@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+/*
+ * FUNCTION
+ *      mlib_ImageBandCount
+ *      mlib_ImageRunBands
+ *              Split the rows of an image operation into bands and
+ *              process the bands on several threads.
+ *
+ * SYNOPSIS
+ *      mlib_s32 mlib_ImageBandCount(mlib_s32 rows,
+ *                                   mlib_d64 work)
+ *
+ *      mlib_status mlib_ImageRunBands(mlib_band_fun fun,
+ *                                     void          *arg,
+ *                                     mlib_s32      nbands)
+ *
+ * ARGUMENTS
+ *      rows      Number of destination rows of the operation.
+ *      work      Estimated cost of the operation, in multiply-adds.
+ *      fun       Function that processes one band.
+ *      arg       Argument passed to every call of fun.
+ *      nbands    Number of bands.
+ *
+ * DESCRIPTION
+ *      mlib_ImageBandCount() returns the number of bands an operation
+ *      should be split into.  It returns 1, meaning the caller should do
+ *      the work itself, unless the operation is large enough to pay for
+ *      starting threads.
+ *
+ *      mlib_ImageRunBands() calls fun(arg, band) for every band.  Band 0
+ *      runs on the calling thread, the other bands on threads started
+ *      for the call, and the function returns when all of them are done.
+ *      If a thread cannot be started its band runs on the calling thread.
+ *      The result is the first status other than MLIB_SUCCESS, if any.
+ *
+ *      The number of threads defaults to the number of online processors,
+ *      up to MLIB_MAX_BANDS.  It can be set with the environment variable
+ *      J2D_MLIB_THREADS; a value of 1 disables the banding.
+ */
+
+#include <stdlib.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include "mlib_ImageParallel.h"
+
+/***************************************************************/
+#define MLIB_MAX_BANDS      8
+
+/* do not start a thread for less than this much work or rows */
+#define MLIB_BAND_MIN_WORK  (1 << 20)
+#define MLIB_BAND_MIN_ROWS  16
+
+/***************************************************************/
+typedef struct {
+  mlib_band_fun fun;
+  void *arg;
+  mlib_s32 band;
+  mlib_status res;
+} mlib_band_task;
+
+/* 0 means not yet initialized */
+static volatile mlib_s32 mlib_band_threads = 0;
+
+/***************************************************************/
+static mlib_s32 mlib_ImageThreadCount(void)
+{
+  mlib_s32 n = mlib_band_threads;
+
+  if (n == 0) {
+    char *env = getenv("J2D_MLIB_THREADS");
+
+    if (env != NULL) {
+      n = atoi(env);
+    }
+    else {
+#ifdef _WIN32
+      SYSTEM_INFO si;
+
+      GetSystemInfo(&si);
+      n = (mlib_s32) si.dwNumberOfProcessors;
+#else
+      n = (mlib_s32) sysconf(_SC_NPROCESSORS_ONLN);
+#endif /* _WIN32 */
+    }
+
+    if (n < 1)
+      n = 1;
+
+    if (n > MLIB_MAX_BANDS)
+      n = MLIB_MAX_BANDS;
+
+    mlib_band_threads = n;
+  }
+
+  return n;
+}
+
+/***************************************************************/
+mlib_s32 mlib_ImageBandCount(mlib_s32 rows,
+                             mlib_d64 work)
+{
+  mlib_s32 n = mlib_ImageThreadCount();
+
+  if (n > 1) {
+    mlib_d64 n_work = work / MLIB_BAND_MIN_WORK;
+    mlib_s32 n_rows = rows / MLIB_BAND_MIN_ROWS;
+
+    if (n_work < n)
+      n = (mlib_s32) n_work;
+
+    if (n_rows < n)
+      n = n_rows;
+
+    if (n < 1)
+      n = 1;
+  }
+
+  return n;
+}
+
+/***************************************************************/
+#ifdef _WIN32
+static DWORD WINAPI mlib_ImageBandThread(LPVOID p)
+#else
+static void *mlib_ImageBandThread(void *p)
+#endif /* _WIN32 */
+{
+  mlib_band_task *task = (mlib_band_task *) p;
+
+  task->res = task->fun(task->arg, task->band);
+  return 0;
+}
+
+/***************************************************************/
+mlib_status mlib_ImageRunBands(mlib_band_fun fun,
+                               void          *arg,
+                               mlib_s32      nbands)
+{
+  mlib_band_task task[MLIB_MAX_BANDS];
+  mlib_s32 started[MLIB_MAX_BANDS];
+#ifdef _WIN32
+  HANDLE thread[MLIB_MAX_BANDS];
+#else
+  pthread_t thread[MLIB_MAX_BANDS];
+#endif /* _WIN32 */
+  mlib_status res = MLIB_SUCCESS;
+  mlib_s32 i;
+
+  if (nbands > MLIB_MAX_BANDS)
+    return MLIB_FAILURE;
+
+  for (i = 0; i < nbands; i++) {
+    task[i].fun = fun;
+    task[i].arg = arg;
+    task[i].band = i;
+    task[i].res = MLIB_SUCCESS;
+    started[i] = 0;
+  }
+
+  for (i = 1; i < nbands; i++) {
+#ifdef _WIN32
+    thread[i] = CreateThread(NULL, 0, mlib_ImageBandThread, &task[i], 0, NULL);
+    started[i] = (thread[i] != NULL);
+#else
+    started[i] = (pthread_create(&thread[i], NULL, mlib_ImageBandThread, &task[i]) == 0);
+#endif /* _WIN32 */
+  }
+
+  for (i = 0; i < nbands; i++) {
+    if (!started[i]) {
+      mlib_ImageBandThread(&task[i]);
+    }
+  }
+
+  for (i = 1; i < nbands; i++) {
+    if (started[i]) {
+#ifdef _WIN32
+      WaitForSingleObject(thread[i], INFINITE);
+      CloseHandle(thread[i]);
+#else
+      pthread_join(thread[i], NULL);
+#endif /* _WIN32 */
+    }
+  }
+
+  for (i = 0; i < nbands; i++) {
+    if (res == MLIB_SUCCESS)
+      res = task[i].res;
+  }
+
+  return res;
+}
+
+/***************************************************************/
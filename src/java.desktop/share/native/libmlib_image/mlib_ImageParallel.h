@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#ifndef __MLIB_IMAGEPARALLEL_H
+#define __MLIB_IMAGEPARALLEL_H
+
+#include <mlib_types.h>
+#include <mlib_status.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * Work function for one band of rows.  The function is called once for
+ * every band in [0, nbands), possibly from different threads, and must
+ * only write the destination rows that belong to its band.
+ */
+typedef mlib_status (*mlib_band_fun)(void *arg, mlib_s32 band);
+
+mlib_s32 mlib_ImageBandCount(mlib_s32 rows,
+                             mlib_d64 work);
+
+mlib_status mlib_ImageRunBands(mlib_band_fun fun,
+                               void          *arg,
+                               mlib_s32      nbands);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __MLIB_IMAGEPARALLEL_H */
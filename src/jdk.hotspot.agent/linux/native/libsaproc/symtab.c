@@ -51,6 +51,11 @@ typedef struct symtab {
   size_t num_symbols;
   struct elf_symbol *symbols;
   struct hsearch_data *hash_table;
+  // address index for nearest_symbol, built on first use
+  struct elf_symbol **sorted;   // named symbols of non-zero size, by offset
+  uintptr_t *max_end;           // max_end[i]: largest end of sorted[0..i]
+  size_t num_sorted;
+  bool sorted_failed;
 } symtab_t;
 
 
@@ -559,6 +564,8 @@ void destroy_symtab(struct symtab* symtab) {
   if (!symtab) return;
   if (symtab->strs) free(symtab->strs);
   if (symtab->symbols) free(symtab->symbols);
+  if (symtab->sorted) free(symtab->sorted);
+  if (symtab->max_end) free(symtab->max_end);
   if (symtab->hash_table) {
      hdestroy_r(symtab->hash_table);
      free(symtab->hash_table);
@@ -591,10 +598,53 @@ quit:
   return (uintptr_t) NULL;
 }
 
-const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
-                           uintptr_t* poffset) {
+static int compare_symbol_offsets(const void* lhsp, const void* rhsp) {
+  const struct elf_symbol* lhs = *((const struct elf_symbol**)lhsp);
+  const struct elf_symbol* rhs = *((const struct elf_symbol**)rhsp);
+
+  if (lhs->offset != rhs->offset) {
+    return (lhs->offset < rhs->offset) ? -1 : 1;
+  }
+  // keep symbol table order for aliases
+  return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+// Libraries such as libjvm have tens of thousands of symbols and
+// jstack --mixed resolves every native frame, so instead of scanning the
+// symbol table each time we sort the symbols by offset once.
+static bool build_sorted_symbols(struct symtab* symtab) {
+  size_t n, i;
+
+  symtab->sorted = (struct elf_symbol **)malloc(symtab->num_symbols * sizeof(struct elf_symbol*));
+  symtab->max_end = (uintptr_t *)malloc(symtab->num_symbols * sizeof(uintptr_t));
+  if (symtab->sorted == NULL || symtab->max_end == NULL) {
+    if (symtab->sorted) free(symtab->sorted);
+    if (symtab->max_end) free(symtab->max_end);
+    symtab->sorted = NULL;
+    symtab->max_end = NULL;
+    symtab->sorted_failed = true;
+    return false;
+  }
+
+  for (i = 0, n = 0; i < symtab->num_symbols; i++) {
+    struct elf_symbol* sym = &(symtab->symbols[i]);
+    if (sym->name != NULL && sym->size > 0) {
+      symtab->sorted[n++] = sym;
+    }
+  }
+  qsort(symtab->sorted, n, sizeof(struct elf_symbol*), compare_symbol_offsets);
+
+  for (i = 0; i < n; i++) {
+    uintptr_t end = symtab->sorted[i]->offset + symtab->sorted[i]->size;
+    symtab->max_end[i] = (i > 0 && symtab->max_end[i - 1] > end) ? symtab->max_end[i - 1] : end;
+  }
+  symtab->num_sorted = n;
+  return true;
+}
+
+static const char* nearest_symbol_linear(struct symtab* symtab, uintptr_t offset,
+                                         uintptr_t* poffset) {
   int n = 0;
-  if (!symtab) return NULL;
   for (; n < symtab->num_symbols; n++) {
      struct elf_symbol* sym = &(symtab->symbols[n]);
      if (sym->name != NULL &&
@@ -605,3 +655,44 @@ const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
   }
   return NULL;
 }
+
+const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
+                           uintptr_t* poffset) {
+  struct elf_symbol* found = NULL;
+  size_t lo, hi;
+
+  if (!symtab) return NULL;
+  if (symtab->sorted == NULL) {
+    if (symtab->sorted_failed || !build_sorted_symbols(symtab)) {
+      return nearest_symbol_linear(symtab, offset, poffset);
+    }
+  }
+
+  // find the number of symbols starting at or below offset
+  lo = 0;
+  hi = symtab->num_sorted;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (symtab->sorted[mid]->offset <= offset) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // Walk back to the closest symbol that contains offset. No symbol
+  // before index i can contain it once max_end[i] is at or below offset.
+  while (lo > 0 && symtab->max_end[lo - 1] > offset) {
+    struct elf_symbol* sym = symtab->sorted[--lo];
+    if (found != NULL && sym->offset != found->offset) {
+      break;
+    }
+    if (offset < sym->offset + sym->size) {
+      found = sym;
+    }
+  }
+
+  if (found == NULL) return NULL;
+  if (poffset) *poffset = (offset - found->offset);
+  return found->name;
+}
@@ -25,8 +25,10 @@
 
 #include "util.h"
 #include "ArrayReferenceImpl.h"
+#include "stream.h"
 #include "inStream.h"
 #include "outStream.h"
+#include "commonRef.h"
 
 static jboolean
 length(PacketInputStream *in, PacketOutputStream *out)
@@ -77,8 +79,9 @@ writeBooleanComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetBooleanArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeBoolean(out, components[i]);
+            components[i] = (components[i] != 0) ? JNI_TRUE : JNI_FALSE;
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -91,11 +94,8 @@ writeByteComponents(JNIEnv *env, PacketOutputStream *out,
 
     components = newComponents(out, length, sizeof(jbyte));
     if (components != NULL) {
-        jint i;
         JNI_FUNC_PTR(env,GetByteArrayRegion)(env, array, index, length, components);
-        for (i = 0; i < length; i++) {
-            (void)outStream_writeByte(out, components[i]);
-        }
+        (void)outStream_writeBytes(out, components, length);
         deleteComponents(components);
     }
 }
@@ -111,8 +111,9 @@ writeCharComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetCharArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeChar(out, components[i]);
+            components[i] = HOST_TO_JAVA_CHAR(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -128,8 +129,9 @@ writeShortComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetShortArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeShort(out, components[i]);
+            components[i] = HOST_TO_JAVA_SHORT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -145,8 +147,9 @@ writeIntComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetIntArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeInt(out, components[i]);
+            components[i] = HOST_TO_JAVA_INT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -162,8 +165,9 @@ writeLongComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetLongArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeLong(out, components[i]);
+            components[i] = HOST_TO_JAVA_LONG(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -179,8 +183,9 @@ writeFloatComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetFloatArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeFloat(out, components[i]);
+            components[i] = HOST_TO_JAVA_FLOAT(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -196,8 +201,9 @@ writeDoubleComponents(JNIEnv *env, PacketOutputStream *out,
         jint i;
         JNI_FUNC_PTR(env,GetDoubleArrayRegion)(env, array, index, length, components);
         for (i = 0; i < length; i++) {
-            (void)outStream_writeDouble(out, components[i]);
+            components[i] = HOST_TO_JAVA_DOUBLE(components[i]);
         }
+        (void)outStream_writeBytes(out, components, length * (jint)sizeof(components[0]));
         deleteComponents(components);
     }
 }
@@ -212,6 +218,11 @@ writeObjectComponents(JNIEnv *env, PacketOutputStream *out,
         int i;
         jobject component;
 
+        /*
+         * Hold the reference table lock for the whole region so that
+         * each element's id lookup does not contend for it separately.
+         */
+        commonRef_lock();
         for (i = 0; i < length; i++) {
             component = JNI_FUNC_PTR(env,GetObjectArrayElement)(env, array, index + i);
             if (JNI_FUNC_PTR(env,ExceptionOccurred)(env)) {
@@ -221,6 +232,7 @@ writeObjectComponents(JNIEnv *env, PacketOutputStream *out,
             (void)outStream_writeByte(out, specificTypeKey(env, component));
             (void)outStream_writeObjectRef(env, out, component);
         }
+        commonRef_unlock();
 
     } END_WITH_LOCAL_REFS(env);
 }
@@ -549,6 +549,29 @@ eventFilterRestricted_passesFilter(JNIEnv *env,
     return JNI_TRUE;
 }
 
+/*
+ * Determine if any of the handler's filters match on the class
+ * name, so the caller can skip looking up the class signature
+ * for events (single steps in particular) that do not need it.
+ */
+jboolean
+eventFilterRestricted_needsClassname(HandlerNode *node)
+{
+    Filter *filter = FILTERS_ARRAY(node);
+    int i;
+
+    for (i = 0; i < FILTER_COUNT(node); ++i, ++filter) {
+        switch (filter->modifier) {
+            case JDWP_REQUEST_MODIFIER(ClassMatch):
+            case JDWP_REQUEST_MODIFIER(ClassExclude):
+                return JNI_TRUE;
+            default:
+                break;
+        }
+    }
+    return JNI_FALSE;
+}
+
 /* Determine if this event is interesting to this handler.  Do so
  * by checking each of the handler's filters.  Return false if any
  * of the filters fail, true if the handler wants this event.
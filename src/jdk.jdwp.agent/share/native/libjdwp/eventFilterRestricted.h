@@ -46,6 +46,7 @@ jboolean eventFilterRestricted_passesUnloadFilter(JNIEnv *env,
                                                   char *classname,
                                                   HandlerNode *node,
                                                   jboolean *shouldDelete);
+jboolean eventFilterRestricted_needsClassname(HandlerNode *node);
 jboolean eventFilterRestricted_isBreakpointInClass(JNIEnv *env,
                                                    jclass clazz,
                                                    HandlerNode *node);
@@ -635,6 +635,7 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
     debugMonitorEnter(handlerLock);
     {
         HandlerNode *node;
+        HandlerNode *scan;
         char        *classname;
 
         /* We must keep track of all classes prepared to know what's unloaded */
@@ -643,7 +644,17 @@ event_callback(JNIEnv *env, EventInfo *evinfo)
         }
 
         node = getHandlerChain(evinfo->ei)->first;
-        classname = getClassname(evinfo->clazz);
+
+        /* Looking up the class signature is a JVMTI call and an
+         * allocation, so only do it if some filter matches on it.
+         */
+        classname = NULL;
+        for (scan = node; scan != NULL; scan = NEXT(scan)) {
+            if (eventFilterRestricted_needsClassname(scan)) {
+                classname = getClassname(evinfo->clazz);
+                break;
+            }
+        }
 
         while (node != NULL) {
             /* save next so handlers can remove themselves */
@@ -108,6 +108,10 @@ writeBytes(PacketOutputStream *stream, void *source, int size)
         jint count;
         if (stream->left == 0) {
             jint segSize = SMALLEST(2 * stream->segment->length, MAX_SEGMENT_SIZE);
+            /* Bulk writes (array regions) get a segment of their own */
+            if (segSize < size) {
+                segSize = size;
+            }
             jbyte *newSeg = jvmtiAllocate(segSize);
             struct PacketData *newHeader = jvmtiAllocate(sizeof(*newHeader));
             if ((newSeg == NULL) || (newHeader == NULL)) {
@@ -301,6 +305,16 @@ outStream_writeByteArray(PacketOutputStream*stream, jint length,
     return writeBytes(stream, bytes, length);
 }
 
+/*
+ * Write raw bytes with no length prefix. The caller is responsible
+ * for having converted the data to Java byte order.
+ */
+jdwpError
+outStream_writeBytes(PacketOutputStream *stream, void *source, jint size)
+{
+    return writeBytes(stream, source, size);
+}
+
 jdwpError
 outStream_writeString(PacketOutputStream *stream, char *string)
 {
@@ -75,6 +75,7 @@ jdwpError outStream_writeMethodID(PacketOutputStream *stream, jmethodID val);
 jdwpError outStream_writeFieldID(PacketOutputStream *stream, jfieldID val);
 jdwpError outStream_writeLocation(PacketOutputStream *stream, jlocation val);
 jdwpError outStream_writeByteArray(PacketOutputStream*stream, jint length, jbyte *bytes);
+jdwpError outStream_writeBytes(PacketOutputStream *stream, void *source, jint size);
 jdwpError outStream_writeString(PacketOutputStream *stream, char *string);
 jdwpError outStream_writeValue(JNIEnv *env, struct PacketOutputStream *out,
                           jbyte typeKey, jvalue value);
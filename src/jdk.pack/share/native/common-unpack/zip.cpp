@@ -51,6 +51,8 @@
 inline bool jar::deflate_bytes(bytes& head, bytes& tail) {
   return false;
 }
+void jar::free_deflater() {
+}
 inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return 0; }
 #define Z_NULL NULL
 
@@ -458,15 +460,24 @@ uLong jar::get_dostime(int modtime) {
 bool jar::deflate_bytes(bytes& head, bytes& tail) {
   int len = (int)(head.len + tail.len);
 
-  z_stream zs;
-  BYTES_OF(zs).clear();
+  // An archive holds thousands of small entries, so the deflater is set
+  // up once and only reset between entries; deflateInit2 allocates and
+  // clears a quarter megabyte of state each time.
+  int error = Z_OK;
+  if (zstream == null) {
+    zstream = NEW(z_stream, 1);
+    if (zstream == null)  return false;
 
-  // NOTE: the window size should always be -MAX_WBITS normally -15.
-  // unzip/zipup.c and java/Deflater.c
+    // NOTE: the window size should always be -MAX_WBITS normally -15.
+    // unzip/zipup.c and java/Deflater.c
 
-  int error = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
-                           -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    error = deflateInit2((z_stream*) zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  } else {
+    error = deflateReset((z_stream*) zstream);
+  }
   if (error != Z_OK) {
+    free_deflater();
     switch (error) {
     case Z_MEM_ERROR:
       PRINTCR((2, "Error: deflate error : Out of memory \n"));
@@ -483,6 +494,7 @@ bool jar::deflate_bytes(bytes& head, bytes& tail) {
     return false;
   }
 
+  z_stream& zs = *(z_stream*) zstream;
   deflated.empty();
   zs.next_out  = (uchar*) deflated.grow(add_size(len, (len/2)));
   zs.avail_out = (int)deflated.size();
@@ -514,19 +526,25 @@ bool jar::deflate_bytes(bytes& head, bytes& tail) {
       // Even if compressed size is bigger than uncompressed, write it
       PRINTCR((2, "deflate compressed data %d -> %d\n", len, zs.total_out));
       deflated.b.len = zs.total_out;
-      deflateEnd(&zs);
       return true;
     }
     PRINTCR((2, "deflate expanded data %d -> %d\n", len, zs.total_out));
-    deflateEnd(&zs);
     return false;
   }
 
-  deflateEnd(&zs);
   PRINTCR((2, "Error: deflate error deflate did not finish error=%d\n",error));
   return false;
 }
 
+void jar::free_deflater() {
+  if (zstream != null) {
+    deflateEnd((z_stream*) zstream);
+    mtrace('f', zstream, 0);
+    ::free(zstream);
+    zstream = null;
+  }
+}
+
 // Callback for fetching data from a GZIP input stream
 static jlong read_input_via_gzip(unpacker* u,
                                   void* buf, jlong minlen, jlong maxlen) {
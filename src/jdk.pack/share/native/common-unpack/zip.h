@@ -45,6 +45,7 @@ struct jar {
   uint        central_directory_count;
   uint        output_file_offset;
   fillbytes   deflated;  // temporary buffer
+  void*       zstream;   // deflater state, reset and reused for each entry
 
   // pointer to outer unpacker, for error checks etc.
   unpacker* u;
@@ -62,6 +63,7 @@ struct jar {
   void free() {
     central_directory.free();
     deflated.free();
+    free_deflater();
   }
 
   void reset() {
@@ -83,6 +85,7 @@ struct jar {
 
   // The definitions of these depend on the NO_ZLIB option:
   bool deflate_bytes(bytes& head, bytes& tail);
+  void free_deflater();
   static uint get_crc32(uint c, unsigned char *ptr, uint len);
 
   // error handling
@@ -54,6 +54,59 @@ struct controlData {
     unsigned int ppid;
 };
 
+/* Maximum number of messages moved by one receiveBatch0 or sendBatch0 */
+#define MAX_BATCH 64
+
+/*
+ * recvmmsg and sendmmsg are used where available. Elsewhere a batch is
+ * emulated with recvmsg and sendmsg, stopping at the first message that
+ * cannot be moved without blocking, so only the system call count differs.
+ */
+#ifdef __linux__
+
+typedef struct mmsghdr batch_msg;
+
+static int batch_recv(int fd, batch_msg *msgs, int count) {
+    return recvmmsg(fd, msgs, count, MSG_WAITFORONE, NULL);
+}
+
+static int batch_send(int fd, batch_msg *msgs, int count) {
+    return sendmmsg(fd, msgs, count, 0);
+}
+
+#else
+
+typedef struct {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+} batch_msg;
+
+static int batch_recv(int fd, batch_msg *msgs, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        ssize_t n = recvmsg(fd, &msgs[i].msg_hdr, (i == 0) ? 0 : MSG_DONTWAIT);
+        if (n < 0) {
+            return (i == 0) ? -1 : i;
+        }
+        msgs[i].msg_len = (unsigned int)n;
+    }
+    return count;
+}
+
+static int batch_send(int fd, batch_msg *msgs, int count) {
+    int i;
+    for (i = 0; i < count; i++) {
+        ssize_t n = sendmsg(fd, &msgs[i].msg_hdr, 0);
+        if (n < 0) {
+            return (i == 0) ? -1 : i;
+        }
+        msgs[i].msg_len = (unsigned int)n;
+    }
+    return count;
+}
+
+#endif
+
 static jclass    smi_class;    /* sun.nio.ch.sctp.MessageInfoImpl            */
 static jmethodID smi_ctrID;    /* sun.nio.ch.sctp.MessageInfoImpl.<init>     */
 static jfieldID  src_valueID;  /* sun.nio.ch.sctp.ResultContainer.value      */
@@ -241,7 +294,8 @@ void handleSendFailed
             iov->iov_len = dataLength;
         }
 
-        if (remaining > 0) {
+        /* fd is -1 when the rest of the notification cannot be read */
+        if (remaining > 0 && fd >= 0) {
             if ((rv = recvmsg(fd, msg, 0)) < 0) {
                 handleSocketError(env, errno);
                 return;
@@ -523,6 +577,114 @@ JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_receive0
     return rv;
 }
 
+/*
+ * Class:     sun_nio_ch_sctp_SctpChannelImpl
+ * Method:    receiveBatch0
+ * Signature: (I[Lsun/nio/ch/sctp/ResultContainer;JI)I
+ *
+ * Receives up to count messages with as few system calls as possible.
+ * Message i is read into the buffer described by the i-th of the count
+ * iovec structures at address, and its MessageInfo or notification is set
+ * in resultContainers[i] in the same way as receive0 does. A container is
+ * left untouched for a notification that is of no interest to the Java
+ * API. A notification that does not fit its buffer is reported with the
+ * part that was received, and its continuation is skipped. Blocks only
+ * until the first message is received. Returns the number of messages
+ * received.
+ */
+JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_receiveBatch0
+  (JNIEnv *env, jclass klass, jint fd, jobjectArray resultContainers,
+   jlong address, jint count) {
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    batch_msg msgs[MAX_BATCH];
+    SOCKETADDRESS sa[MAX_BATCH];
+    char cbuf[MAX_BATCH][CMSG_SPACE(sizeof (struct sctp_sndrcvinfo))];
+    jboolean inNotification = JNI_FALSE;
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    for (i = 0; i < count; i++) {
+        msgs[i].msg_hdr.msg_name = &sa[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sa[i]);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = cbuf[i];
+        msgs[i].msg_hdr.msg_controllen = sizeof(cbuf[i]);
+    }
+
+    if ((n = batch_recv(fd, msgs, count)) < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        } else if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+#ifdef __linux__
+        } else if (errno == ENOTCONN) {
+            /* ENOTCONN when EOF reached, there will be no control data */
+            msgs[0].msg_hdr.msg_controllen = 0;
+            msgs[0].msg_hdr.msg_flags = MSG_EOR;
+            msgs[0].msg_len = 0;
+            n = 1;
+#endif /* __linux__ */
+        } else {
+            handleSocketError(env, errno);
+            return 0;
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        struct msghdr *msg = &msgs[i].msg_hdr;
+        jboolean isEOR = (msg->msg_flags & MSG_EOR) ? JNI_TRUE : JNI_FALSE;
+        jobject rco;
+
+        if (inNotification == JNI_TRUE) {
+            /* continuation of a notification that did not fit its buffer */
+            inNotification = !isEOR;
+            continue;
+        }
+
+        rco = (*env)->GetObjectArrayElement(env, resultContainers, i);
+        if (rco == NULL) {
+            JNU_ThrowNullPointerException(env, NULL);
+            return IOS_THROWN;
+        }
+        if (msg->msg_flags & MSG_NOTIFICATION) {
+            union sctp_notification *snp = iov[i].iov_base;
+            char *newBuf = NULL;
+
+            if ((int)msgs[i].msg_len < SCTP_NOTIFICATION_SIZE
+#ifdef __sparc
+                || ((intptr_t)snp & 0x3)
+#endif
+               ) {
+                /* too short to be parsed in place, or not 4 byte aligned */
+                int size = (int)msgs[i].msg_len;
+                if ((newBuf = calloc(1, size > SCTP_NOTIFICATION_SIZE ?
+                                     size : SCTP_NOTIFICATION_SIZE)) == NULL) {
+                    JNU_ThrowOutOfMemoryError(env, "Out of native heap space.");
+                    return IOS_THROWN;
+                }
+                memcpy(newBuf, snp, size);
+                snp = (union sctp_notification *) newBuf;
+            }
+            handleNotification(env, -1, rco, snp, msgs[i].msg_len, isEOR,
+                               &sa[i].sa);
+            free(newBuf);
+            inNotification = !isEOR;
+        } else {
+            handleMessage(env, rco, msg, msgs[i].msg_len, isEOR, &sa[i].sa);
+        }
+        (*env)->DeleteLocalRef(env, rco);
+        if ((*env)->ExceptionCheck(env)) {
+            return IOS_THROWN;
+        }
+    }
+    return n;
+}
+
 /*
  * Class:     sun_nio_ch_sctp_SctpChannelImpl
  * Method:    send0
@@ -594,3 +756,76 @@ JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_send0
     return rv;
 }
 
+/*
+ * Class:     sun_nio_ch_sctp_SctpChannelImpl
+ * Method:    sendBatch0
+ * Signature: (IJILjava/net/InetAddress;IIIZI)I
+ *
+ * Sends up to count messages with as few system calls as possible. Each
+ * message is the buffer described by the corresponding iovec structure in
+ * the array at address. All messages share the destination and the
+ * association, stream, ordering and payload protocol identifier given, as
+ * for send0. Returns the number of messages sent.
+ */
+JNIEXPORT jint JNICALL Java_sun_nio_ch_sctp_SctpChannelImpl_sendBatch0
+  (JNIEnv *env, jclass klass, jint fd, jlong address, jint count,
+   jobject targetAddress, jint targetPort, jint assocId, jint streamNumber,
+   jboolean unordered, jint ppid) {
+    SOCKETADDRESS sa;
+    int sa_len = 0;
+    struct iovec *iov = (struct iovec *)jlong_to_ptr(address);
+    batch_msg msgs[MAX_BATCH];
+    char cbuf[CMSG_SPACE(sizeof (struct sctp_sndrcvinfo))];
+    struct controlData cdata[1];
+    int i, n;
+
+    if (count > MAX_BATCH) {
+        count = MAX_BATCH;
+    }
+
+    if (targetAddress != NULL) {
+        if (NET_InetAddressToSockaddr(env, targetAddress, targetPort, &sa,
+                                      &sa_len, JNI_TRUE) != 0) {
+            return IOS_THROWN;
+        }
+    } else {
+        memset(&sa, '\x0', sizeof(sa));
+    }
+
+    /* The control data is the same for every message, build it once */
+    memset(msgs, 0, count * sizeof(msgs[0]));
+    memset(cbuf, 0, sizeof(cbuf));
+    msgs[0].msg_hdr.msg_control = cbuf;
+    msgs[0].msg_hdr.msg_controllen = sizeof(cbuf);
+    cdata->streamNumber = streamNumber;
+    cdata->assocId = assocId;
+    cdata->unordered = unordered;
+    cdata->ppid = ppid;
+    setControlData(&msgs[0].msg_hdr, cdata);
+
+    for (i = 0; i < count; i++) {
+        msgs[i].msg_hdr.msg_name = &sa;
+        msgs[i].msg_hdr.msg_namelen = sa_len;
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_control = cbuf;
+        msgs[i].msg_hdr.msg_controllen = msgs[0].msg_hdr.msg_controllen;
+    }
+
+    if ((n = batch_send(fd, msgs, count)) < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return IOS_UNAVAILABLE;
+        } else if (errno == EINTR) {
+            return IOS_INTERRUPTED;
+        } else if (errno == EPIPE) {
+            JNU_ThrowByName(env, JNU_JAVANETPKG "SocketException",
+                            "Socket is shutdown for writing");
+            return IOS_THROWN;
+        } else {
+            handleSocketError(env, errno);
+            return 0;
+        }
+    }
+
+    return n;
+}
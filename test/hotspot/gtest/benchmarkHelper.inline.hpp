@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef GTEST_BENCHMARKHELPER_INLINE_HPP
+#define GTEST_BENCHMARKHELPER_INLINE_HPP
+
+#include "memory/allocation.inline.hpp"
+#include "runtime/orderAccess.hpp"
+#include "runtime/os.hpp"
+#include "runtime/semaphore.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/quickSort.hpp"
+#include "threadHelper.inline.hpp"
+#include "unittest.hpp"
+
+#ifdef LINUX
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <stdlib.h>
+
+// Support for microbenchmarks of VM-internal data structures, run by the
+// gtest launcher like any other test.
+//
+// A Benchmark describes one operation.  BenchmarkRunner::run() performs it
+// on a number of JavaTestThreads for a fixed time, then prints the
+// throughput, latency percentiles and, where the platform allows it,
+// hardware counters, one line per thread role.  Nothing is asserted about
+// the numbers; they are meant to be compared between builds.
+//
+// Each configuration runs for 100ms, or for the number of milliseconds in
+// the environment variable HOTSPOT_GTEST_BENCHMARK_MS.
+
+class Benchmark {
+public:
+  static const uint max_roles = 2;
+
+  virtual ~Benchmark() {}
+
+  // Called by every thread before the measurement starts.
+  virtual void setup_thread(uint thread_id) {}
+
+  // Performs one operation on behalf of thread_id.
+  virtual void do_op(uint thread_id, Thread* thread) = 0;
+
+  // Threads are reported by role, for benchmarks where some threads are
+  // writers or owners and the others readers or thieves.
+  virtual uint role(uint thread_id) const { return 0; }
+  virtual const char* role_name(uint role) const { return "all"; }
+};
+
+// Cheap per-thread pseudo random numbers (xorshift).
+class BenchmarkRandom {
+  uint64_t _state;
+public:
+  BenchmarkRandom(uint64_t seed = 1) : _state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+  uint64_t next() {
+    _state ^= _state << 13;
+    _state ^= _state >> 7;
+    _state ^= _state << 17;
+    return _state;
+  }
+  // Returns a value in [0, bound).
+  size_t next(size_t bound) { return (size_t)(next() % bound); }
+};
+
+// Hardware counters of the calling thread.  Only available on Linux, and
+// only if perf events are permitted; otherwise available() is false.
+class BenchmarkCounters {
+public:
+  enum Counter { cycles, instructions, cache_misses, num_counters };
+
+private:
+  int _fd[num_counters];
+  uint64_t _value[num_counters];
+
+#ifdef LINUX
+  static int open_counter(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+  }
+#endif
+
+public:
+  BenchmarkCounters() {
+    for (int i = 0; i < num_counters; i++) {
+      _fd[i] = -1;
+      _value[i] = 0;
+    }
+  }
+
+  ~BenchmarkCounters() {
+#ifdef LINUX
+    for (int i = 0; i < num_counters; i++) {
+      if (_fd[i] != -1) {
+        ::close(_fd[i]);
+      }
+    }
+#endif
+  }
+
+  // Must be called by the thread to be measured.
+  void open() {
+#ifdef LINUX
+    static const uint64_t config[num_counters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES
+    };
+    for (int i = 0; i < num_counters; i++) {
+      _fd[i] = open_counter(config[i], _fd[0]);
+      if (_fd[i] == -1) {
+        break;
+      }
+    }
+#endif
+  }
+
+  bool available() const { return _fd[num_counters - 1] != -1; }
+
+  void start() {
+#ifdef LINUX
+    if (available()) {
+      ::ioctl(_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ::ioctl(_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  void stop() {
+#ifdef LINUX
+    if (available()) {
+      ::ioctl(_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      for (int i = 0; i < num_counters; i++) {
+        if (::read(_fd[i], &_value[i], sizeof(_value[i])) != sizeof(_value[i])) {
+          _value[i] = 0;
+        }
+      }
+    }
+#endif
+  }
+
+  uint64_t value(Counter c) const { return _value[c]; }
+};
+
+// What one benchmark thread measured.  Owned by the runner, since the
+// thread itself is deleted when it exits.
+struct BenchmarkThreadResult {
+  static const size_t max_samples = 16 * 1024;
+
+  uint64_t _ops;
+  size_t _num_samples;
+  jlong _samples[max_samples];
+  bool _counters_available;
+  uint64_t _counters[BenchmarkCounters::num_counters];
+};
+
+class BenchmarkThread : public JavaTestThread {
+  // The latency of every sample_interval'th operation is recorded.
+  static const uint64_t sample_interval = 16;
+
+  Benchmark* _benchmark;
+  uint _id;
+  Semaphore* _ready;
+  Semaphore* _start;
+  volatile bool* _stop;
+  BenchmarkThreadResult* _result;
+
+public:
+  BenchmarkThread(Semaphore* post, Benchmark* benchmark, uint id,
+                  Semaphore* ready, Semaphore* start, volatile bool* stop,
+                  BenchmarkThreadResult* result) :
+    JavaTestThread(post), _benchmark(benchmark), _id(id),
+    _ready(ready), _start(start), _stop(stop), _result(result) {}
+
+  virtual void main_run() {
+    BenchmarkThreadResult* r = _result;
+    BenchmarkCounters counters;
+    uint64_t ops = 0;
+    size_t num_samples = 0;
+
+    _benchmark->setup_thread(_id);
+    counters.open();
+    _ready->signal();
+    _start->wait();
+
+    counters.start();
+    while (!OrderAccess::load_acquire(_stop)) {
+      if ((ops % sample_interval) == 0 && num_samples < BenchmarkThreadResult::max_samples) {
+        jlong t0 = os::elapsed_counter();
+        _benchmark->do_op(_id, this);
+        r->_samples[num_samples++] = os::elapsed_counter() - t0;
+      } else {
+        _benchmark->do_op(_id, this);
+      }
+      ops++;
+    }
+    counters.stop();
+
+    r->_ops = ops;
+    r->_num_samples = num_samples;
+    r->_counters_available = counters.available();
+    for (int i = 0; i < BenchmarkCounters::num_counters; i++) {
+      r->_counters[i] = counters.value((BenchmarkCounters::Counter)i);
+    }
+  }
+};
+
+class BenchmarkRunner : AllStatic {
+  static int compare_samples(jlong a, jlong b) {
+    return (a < b) ? -1 : ((a > b) ? 1 : 0);
+  }
+
+  static double percentile_ns(const jlong* sorted, size_t n, double p) {
+    size_t i = MIN2(n - 1, (size_t)(p * n));
+    return (double)sorted[i] * NANOSECS_PER_SEC / os::elapsed_frequency();
+  }
+
+  static void report(const char* name, Benchmark* benchmark, uint nthreads,
+                     BenchmarkThreadResult* results, jlong elapsed) {
+    double seconds = (double)elapsed / os::elapsed_frequency();
+    for (uint role = 0; role < Benchmark::max_roles; role++) {
+      uint64_t ops = 0;
+      size_t n = 0;
+      bool counters_available = true;
+      uint64_t counters[BenchmarkCounters::num_counters] = { 0 };
+      uint role_threads = 0;
+
+      for (uint i = 0; i < nthreads; i++) {
+        if (benchmark->role(i) == role) {
+          role_threads++;
+          ops += results[i]._ops;
+          n += results[i]._num_samples;
+          counters_available &= results[i]._counters_available;
+          for (int c = 0; c < BenchmarkCounters::num_counters; c++) {
+            counters[c] += results[i]._counters[c];
+          }
+        }
+      }
+      if (role_threads == 0 || n == 0) {
+        continue;
+      }
+
+      jlong* samples = NEW_C_HEAP_ARRAY(jlong, n, mtInternal);
+      size_t k = 0;
+      for (uint i = 0; i < nthreads; i++) {
+        if (benchmark->role(i) == role) {
+          memcpy(samples + k, results[i]._samples, results[i]._num_samples * sizeof(jlong));
+          k += results[i]._num_samples;
+        }
+      }
+      QuickSort::sort(samples, n, compare_samples, false);
+
+      tty->print("%s threads=%u %s=%u ops/s=%.0f p50=%.0fns p90=%.0fns p99=%.0fns p99.9=%.0fns max=%.0fns",
+                 name, nthreads, benchmark->role_name(role), role_threads,
+                 ops / seconds,
+                 percentile_ns(samples, n, 0.50), percentile_ns(samples, n, 0.90),
+                 percentile_ns(samples, n, 0.99), percentile_ns(samples, n, 0.999),
+                 percentile_ns(samples, n, 1.0));
+      if (counters_available && ops > 0 && counters[BenchmarkCounters::cycles] > 0) {
+        tty->print(" cycles/op=%.1f ipc=%.2f misses/op=%.3f",
+                   (double)counters[BenchmarkCounters::cycles] / ops,
+                   (double)counters[BenchmarkCounters::instructions] /
+                     counters[BenchmarkCounters::cycles],
+                   (double)counters[BenchmarkCounters::cache_misses] / ops);
+      }
+      tty->cr();
+      FREE_C_HEAP_ARRAY(jlong, samples);
+    }
+  }
+
+public:
+  // The thread counts worth running on this machine: 1, 2, 4 and 8, up to
+  // the number of processors, but always at least 1 and 2.
+  static uint max_threads() {
+    return (uint)MAX2(2, MIN2(8, os::processor_count()));
+  }
+
+  static jlong duration_ms() {
+    const char* s = ::getenv("HOTSPOT_GTEST_BENCHMARK_MS");
+    jlong ms = (s != NULL) ? (jlong)::atol(s) : 0;
+    return (ms > 0) ? ms : 100;
+  }
+
+  // Runs benchmark on nthreads threads for duration_ms() and reports it.
+  // Safepoints are blocked for the duration, as nothing the threads do
+  // polls for them.
+  static void run(const char* name, Benchmark* benchmark, uint nthreads) {
+    Semaphore post;
+    Semaphore ready;
+    Semaphore start;
+    volatile bool stop = false;
+    BenchmarkThreadResult* results =
+      NEW_C_HEAP_ARRAY(BenchmarkThreadResult, nthreads, mtInternal);
+
+    VMThreadBlocker* blocker = new VMThreadBlocker();
+    blocker->doit();
+    blocker->ready();
+
+    for (uint i = 0; i < nthreads; i++) {
+      BenchmarkThread* t = new BenchmarkThread(&post, benchmark, i, &ready,
+                                               &start, &stop, &results[i]);
+      t->doit();
+    }
+    for (uint i = 0; i < nthreads; i++) {
+      ready.wait();
+    }
+
+    jlong start_time = os::elapsed_counter();
+    start.signal(nthreads);
+    for (jlong left = duration_ms(); left > 0; left -= 500) {
+      os::naked_short_sleep(MIN2(left, (jlong)500));
+    }
+    OrderAccess::release_store_fence(&stop, true);
+    for (uint i = 0; i < nthreads; i++) {
+      post.wait();
+    }
+    jlong elapsed = os::elapsed_counter() - start_time;
+
+    blocker->release();
+
+    report(name, benchmark, nthreads, results, elapsed);
+    FREE_C_HEAP_ARRAY(BenchmarkThreadResult, results);
+  }
+
+  // Runs benchmark with each thread count from 1 up to max_threads().
+  static void run_all(const char* name, Benchmark* benchmark, uint min_threads = 1) {
+    for (uint n = min_threads; n <= max_threads(); n *= 2) {
+      run(name, benchmark, n);
+    }
+  }
+};
+
+#endif // include guard
@@ -23,10 +23,31 @@
 
 #include "precompiled.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "classfile/javaClasses.hpp"
 #include "classfile/symbolTable.hpp"
 #include "threadHelper.inline.hpp"
 #include "unittest.hpp"
 
+TEST(SymbolTable, hash_code) {
+  // The unrolled hash must give the same value as String.hashCode()
+  jbyte bytes[23];
+  jchar chars[23];
+  for (int i = 0; i < 23; i++) {
+    bytes[i] = (jbyte)(0x7a + 13 * i);  // includes bytes with the sign bit set
+    chars[i] = (jchar)(0xfff0 + 7 * i);
+  }
+  for (int len = 0; len <= 23; len++) {
+    unsigned int byte_hash = 0;
+    unsigned int char_hash = 0;
+    for (int i = 0; i < len; i++) {
+      byte_hash = 31 * byte_hash + (((unsigned int)bytes[i]) & 0xFF);
+      char_hash = 31 * char_hash + (unsigned int)chars[i];
+    }
+    ASSERT_EQ(byte_hash, java_lang_String::hash_code(bytes, len)) << "len " << len;
+    ASSERT_EQ(char_hash, java_lang_String::hash_code(chars, len)) << "len " << len;
+  }
+}
+
 TEST_VM(SymbolTable, temp_new_symbol) {
   // Assert messages assume these symbols are unique, and the refcounts start at
   // one, but code does not rely on this.
@@ -1034,6 +1034,37 @@ TEST_VM_F(OopStorageTestWithAllocation, delete_empty_blocks) {
   EXPECT_EQ(initial_active_size - 3, _storage.block_count());
 }
 
+TEST_VM_F(OopStorageTest, allocate_after_delete_empty_blocks) {
+  static const size_t max_entries = 10;
+  oop* entries[max_entries];
+
+  // The first allocation is locked; the rest use the block it picked.
+  for (size_t i = 0; i < max_entries; ++i) {
+    entries[i] = _storage.allocate();
+    ASSERT_TRUE(entries[i] != NULL);
+  }
+  EXPECT_EQ(1u, _storage.block_count());
+  const OopBlock* block = TestAccess::allocation_list(_storage).chead();
+  EXPECT_EQ(max_entries, TestAccess::block_allocation_count(*block));
+
+  for (size_t i = 0; i < max_entries; ++i) {
+    release_entry(_storage, entries[i]);
+  }
+  EXPECT_EQ(1u, empty_block_count(_storage));
+  {
+    ThreadInVMfromNative invm(JavaThread::current());
+    while (_storage.delete_empty_blocks()) {}
+  }
+  EXPECT_EQ(0u, _storage.block_count());
+
+  // The deleted block must not be used for further allocations.
+  oop* ptr = _storage.allocate();
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(1u, _storage.block_count());
+  EXPECT_EQ(OopStorage::ALLOCATED_ENTRY, _storage.allocation_status(ptr));
+  release_entry(_storage, ptr);
+}
+
 TEST_VM_F(OopStorageTestWithAllocation, allocation_status) {
   oop* retained = _entries[200];
   oop* released = _entries[300];
@@ -97,3 +97,32 @@ TEST_VM(PreservedMarks, iterate_and_restore) {
   ASSERT_MARK_WORD_EQ(o3.mark(), FakeOop::changedMark());
   ASSERT_MARK_WORD_EQ(o4.mark(), FakeOop::changedMark());
 }
+
+TEST_VM(PreservedMarks, restore_many) {
+  // Need to disable biased locking to easily
+  // create oops that "must_be_preseved"
+  ScopedDisabledBiasedLocking dbl;
+
+  // Enough marks to span several chunks.
+  const size_t num_oops = 2500;
+  FakeOop* oops = new FakeOop[num_oops];
+  PreservedMarks pm;
+
+  // Do it twice to also restore from recycled chunks.
+  for (int round = 0; round < 2; round++) {
+    for (size_t i = 0; i < num_oops; i++) {
+      oops[i].set_mark(FakeOop::changedMark());
+      pm.push(oops[i].get_oop(), oops[i].mark());
+      oops[i].set_mark(FakeOop::originalMark());
+    }
+    ASSERT_EQ(num_oops, pm.size());
+
+    pm.restore();
+    ASSERT_EQ(0u, pm.size());
+    for (size_t i = 0; i < num_oops; i++) {
+      ASSERT_MARK_WORD_EQ(oops[i].mark(), FakeOop::changedMark());
+    }
+  }
+
+  delete[] oops;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#include "precompiled.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// This "test" doesn't verify anything.  It is a microbenchmark of work
+// stealing: thread 0 owns the only queue that is fed with tasks, and
+// every other thread keeps trying to steal from the set, as the workers
+// of a parallel GC phase do when the work is unbalanced.  The thieves
+// work off what they steal, including tasks moved by batched stealing,
+// from their own queues.
+
+typedef GenericTaskQueue<size_t, mtGC>          BenchTaskQueue;
+typedef GenericTaskQueueSet<BenchTaskQueue, mtGC> BenchTaskQueueSet;
+
+class StealStormBenchmark : public Benchmark {
+  static const uint push_batch = 64;
+
+  uint _nthreads;
+  BenchTaskQueueSet _queues;
+  volatile size_t _done;
+
+  void drain(BenchTaskQueue* q) {
+    size_t task;
+    while (q->pop_local(task)) {
+      _done = task;
+    }
+  }
+
+public:
+  // The victims are picked among all queues of the set, so the set has
+  // one queue per thread of the run.
+  StealStormBenchmark(uint nthreads) :
+    _nthreads(nthreads), _queues(nthreads), _done(0) {
+    for (uint i = 0; i < _nthreads; i++) {
+      BenchTaskQueue* q = new BenchTaskQueue();
+      q->initialize();
+      _queues.register_queue(i, q);
+    }
+  }
+
+  ~StealStormBenchmark() {
+    for (uint i = 0; i < _nthreads; i++) {
+      delete _queues.queue(i);
+    }
+  }
+
+  virtual uint role(uint thread_id) const { return thread_id == 0 ? 0 : 1; }
+  virtual const char* role_name(uint role) const { return role == 0 ? "owner" : "thieves"; }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    BenchTaskQueue* q = _queues.queue(thread_id);
+    if (thread_id == 0) {
+      // Push a batch, then take back half of it from the local end.
+      for (uint i = 0; i < push_batch; i++) {
+        if (!q->push(i)) {
+          break;
+        }
+      }
+      size_t task;
+      for (uint i = 0; i < push_batch / 2 && q->pop_local(task); i++) {
+        _done = task;
+      }
+    } else {
+      size_t task;
+      if (_queues.steal(thread_id, task)) {
+        _done = task;
+        drain(q);
+      }
+    }
+  }
+};
+
+TEST_VM(TaskQueueBenchmark, steal_storm) {
+  for (uint n = 2; n <= BenchmarkRunner::max_threads(); n *= 2) {
+    StealStormBenchmark b(n);
+    BenchmarkRunner::run("steal_storm", &b, n);
+  }
+}
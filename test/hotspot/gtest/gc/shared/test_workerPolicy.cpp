@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/workerPolicy.hpp"
+#include "unittest.hpp"
+
+TEST(WorkerPolicy, calc_workers_for_work) {
+  // No or very little work still needs one worker.
+  EXPECT_EQ(1u, WorkerPolicy::calc_workers_for_work(8, 0, 10));
+  EXPECT_EQ(1u, WorkerPolicy::calc_workers_for_work(8, 1, 10));
+  EXPECT_EQ(1u, WorkerPolicy::calc_workers_for_work(8, 10, 10));
+
+  // Partial units of work round up.
+  EXPECT_EQ(2u, WorkerPolicy::calc_workers_for_work(8, 11, 10));
+  EXPECT_EQ(5u, WorkerPolicy::calc_workers_for_work(8, 50, 10));
+
+  // Never more than the maximum number of workers.
+  EXPECT_EQ(8u, WorkerPolicy::calc_workers_for_work(8, 81, 10));
+  EXPECT_EQ(8u, WorkerPolicy::calc_workers_for_work(8, SIZE_MAX, 10));
+  EXPECT_EQ(1u, WorkerPolicy::calc_workers_for_work(1, 1000, 1));
+}
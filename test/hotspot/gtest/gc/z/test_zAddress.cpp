@@ -101,6 +101,24 @@ protected:
     EXPECT_FALSE(ZAddress::is_good(addr2));
     EXPECT_FALSE(ZAddress::is_good_or_null(addr2));
   }
+
+  static void uncolored() {
+    // Setup
+    ZAddress::initialize();
+
+    // Test that all colors of a pointer share the same uncolored address
+    const uintptr_t addr = ZAddress::uncolored(1);
+    EXPECT_EQ(ZAddress::uncolored(ZAddress::marked0(1)), addr);
+    EXPECT_EQ(ZAddress::uncolored(ZAddress::marked1(1)), addr);
+    EXPECT_EQ(ZAddress::uncolored(ZAddress::remapped(1)), addr);
+    EXPECT_EQ(ZAddress::uncolored(ZAddress::finalizable_good(1)), addr);
+
+    // Test that the uncolored address keeps the offset, but has no metadata
+    EXPECT_EQ(ZAddress::offset(addr), (uintptr_t)1);
+    EXPECT_EQ(addr & ZAddressMetadataMask, (uintptr_t)0);
+    EXPECT_TRUE(ZAddress::is_in(ZAddress::good(1)));
+    EXPECT_FALSE(ZAddress::is_in(addr));
+  }
 };
 
 TEST_F(ZAddressTest, is_good) {
@@ -133,3 +151,7 @@ TEST_F(ZAddressTest, is_weak_good_or_null) {
 TEST_F(ZAddressTest, finalizable) {
   finalizable();
 }
+
+TEST_F(ZAddressTest, uncolored) {
+  uncolored();
+}
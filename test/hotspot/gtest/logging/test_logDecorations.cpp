@@ -224,3 +224,22 @@ TEST(LogDecorations, identifiers) {
     EXPECT_EQ(ids[i].expected, strtol(reported, NULL, 10));
   }
 }
+
+// Test that a copy has the same decorations, stored in its own buffer
+TEST_VM(LogDecorations, copy) {
+  LogDecorators decorator_selection;
+  ASSERT_TRUE(decorator_selection.parse("uptime,pid,tags"));
+  LogDecorations decorations(LogLevel::Info, tagset, decorator_selection);
+  LogDecorations copy(decorations);
+
+  for (uint i = 0; i < LogDecorators::Count; i++) {
+    LogDecorators::Decorator decorator = static_cast<LogDecorators::Decorator>(i);
+    if (decorator == LogDecorators::level_decorator || !decorator_selection.is_decorator(decorator)) {
+      continue;
+    }
+    EXPECT_STREQ(decorations.decoration(decorator), copy.decoration(decorator));
+    EXPECT_NE(decorations.decoration(decorator), copy.decoration(decorator))
+        << "Copy should not refer to the buffer of the original";
+  }
+  EXPECT_STREQ(LogLevel::name(LogLevel::Info), copy.decoration(LogDecorators::level_decorator));
+}
@@ -24,7 +24,9 @@
 #include "precompiled.hpp"
 #include "jvm.h"
 #include "logTestUtils.inline.hpp"
+#include "logging/logDecorations.hpp"
 #include "logging/logFileOutput.hpp"
+#include "logging/logTagSet.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/os.hpp"
 #include "unittest.hpp"
@@ -41,7 +43,9 @@ TEST_VM(LogFileOutput, parse_valid) {
     "filesize=256,filecount=11",
     "filesize=0", "filecount=1",
     "filesize=1m", "filesize=1M",
-    "filesize=1k", "filesize=1G"
+    "filesize=1k", "filesize=1G",
+    "format=text", "format=json",
+    "filecount=3,format=json"
   };
 
   // Override LogOutput's vm_start time to get predictable file name
@@ -74,6 +78,7 @@ TEST_VM(LogFileOutput, parse_invalid) {
     "filecount= 2", "filesize=2 ",
     "filecount=ab", "filesize=0xz",
     "filecount=1MB", "filesize=99bytes",
+    "format=", "format=xml", "format=JSON",
     "filesize=9999999999999999999999999"
     "filecount=9999999999999999999999999"
   };
@@ -99,6 +104,33 @@ TEST_VM(LogFileOutput, filesize_overflow) {
   EXPECT_FALSE(fo.initialize(buf, &ss)) << "Accepted filesize that overflows";
 }
 
+TEST_VM(LogFileOutput, json_format) {
+  ResourceMark rm;
+  const char* filename = prepend_temp_dir("json-format-test");
+  delete_file(filename);
+  {
+    stringStream ss;
+    LogFileOutput fo(prepend_prefix_temp_dir("file=", "json-format-test"));
+    ASSERT_TRUE(fo.initialize("filecount=0,format=json", &ss)) << ss.as_string();
+    LogDecorators decorators;
+    ASSERT_TRUE(decorators.parse("pid,level,tags"));
+    fo.set_decorators(decorators);
+
+    const LogTagSet& tagset = LogTagSetMapping<LOG_TAGS(logging)>::tagset();
+    LogDecorations decorations(LogLevel::Info, tagset, decorators);
+    fo.write(decorations, "a \"quoted\" \\ message\t");
+  }
+
+  char expected[128];
+  jio_snprintf(expected, sizeof(expected),
+               "{\"pid\":%d,\"level\":\"info\",\"tags\":\"logging\","
+               "\"message\":\"a \\\"quoted\\\" \\\\ message\\t\"}",
+               os::current_process_id());
+  EXPECT_TRUE(file_contains_substring(filename, expected))
+    << "expected '" << expected << "' in " << filename;
+  delete_file(filename);
+}
+
 TEST_VM(LogFileOutput, startup_rotation) {
   ResourceMark rm;
   const size_t rotations = 5;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/arena.hpp"
+#include "unittest.hpp"
+
+TEST(Arena, pooled_length) {
+  const size_t size = Chunk::size;
+  const size_t slack = Chunk::slack;
+  // Lengths above Chunk::size round up to the next doubling size class
+  EXPECT_EQ(2 * (size + slack) - slack, Chunk::pooled_length(size + 1));
+  EXPECT_EQ(2 * (size + slack) - slack, Chunk::pooled_length(2 * (size + slack) - slack));
+  EXPECT_EQ(4 * (size + slack) - slack, Chunk::pooled_length(2 * (size + slack)));
+  // Past the largest size class the length is left alone
+  EXPECT_EQ((size_t)(64 * M), Chunk::pooled_length(64 * M));
+}
+
+TEST_VM(Arena, huge_allocation) {
+  // Run twice so that the second arena can take the chunk the first one
+  // returned to the pool
+  for (int i = 0; i < 2; i++) {
+    Arena arena(mtTest);
+    const size_t len = 100 * K;
+    char* p = (char*)arena.Amalloc(len);
+    ASSERT_TRUE(p != NULL);
+    memset(p, 0, len);
+    EXPECT_EQ(Chunk::init_size + Chunk::pooled_length(len), arena.size_in_bytes());
+  }
+}
@@ -130,3 +130,21 @@ TEST_VM(BitMap, reinitialize) {
   BitMapTest::testReinitialize(BitMapTest::BITMAP_SIZE >> 3);
   BitMapTest::testReinitialize(BitMapTest::BITMAP_SIZE);
 }
+
+TEST_VM(BitMap, count_one_bits) {
+  ResourceMark rm;
+  ResourceBitMap map(BitMapTest::BITMAP_SIZE);
+  EXPECT_EQ(0u, map.count_one_bits());
+
+  map.set_bit(1);
+  map.set_bit(63);
+  map.set_bit(64);
+  map.set_bit(BitMapTest::BITMAP_SIZE - 1);
+  EXPECT_EQ(4u, map.count_one_bits());
+
+  map.set_range(128, 256);
+  EXPECT_EQ(4u + 128u, map.count_one_bits());
+
+  map.set_range(0, BitMapTest::BITMAP_SIZE);
+  EXPECT_EQ(BitMapTest::BITMAP_SIZE, map.count_one_bits());
+}
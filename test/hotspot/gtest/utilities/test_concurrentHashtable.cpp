@@ -106,6 +106,48 @@ static void cht_insert(Thread* thr) {
   delete cht;
 }
 
+struct OddIsDeadLookup {
+  uintptr_t _hash;
+  OddIsDeadLookup(uintptr_t hash) : _hash(hash) {}
+  uintx get_hash() {
+    return _hash;
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    if ((*value & 0x1) != 0) {
+      *is_dead = true;
+    }
+    return false;
+  }
+};
+
+static void cht_delete_dead_in_bucket(Thread* thr) {
+  uintptr_t val1 = 0x1;
+  uintptr_t val2 = 0x2;
+  uintptr_t val3 = 0x3;
+  SimpleTestLookup stl1(val1), stl2(val2), stl3(val3);
+  SimpleTestTable* cht = new SimpleTestTable();
+  EXPECT_TRUE(cht->insert(thr, stl1, val1)) << "Insert unique value failed.";
+  EXPECT_TRUE(cht->insert(thr, stl2, val2)) << "Insert unique value failed.";
+  EXPECT_TRUE(cht->insert(thr, stl3, val3)) << "Insert unique value failed.";
+
+  // Only the bucket of the given hash is cleaned.
+  OddIsDeadLookup dead3(val3);
+  cht->delete_dead_in_bucket(thr, dead3);
+  EXPECT_EQ(cht_get_copy(cht, thr, stl1), val1) << "Dead value in another bucket was removed.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl2), val2) << "Live value was removed.";
+  EXPECT_NE(cht_get_copy(cht, thr, stl3), val3) << "Dead value was not removed.";
+
+  OddIsDeadLookup dead1(val1);
+  cht->delete_dead_in_bucket(thr, dead1);
+  EXPECT_NE(cht_get_copy(cht, thr, stl1), val1) << "Dead value was not removed.";
+  EXPECT_EQ(cht_get_copy(cht, thr, stl2), val2) << "Live value was removed.";
+
+  // Nothing left to delete.
+  cht->delete_dead_in_bucket(thr, dead1);
+  EXPECT_EQ(cht_get_copy(cht, thr, stl2), val2) << "Live value was removed.";
+  delete cht;
+}
+
 static void cht_get_insert(Thread* thr) {
   uintptr_t val = 0x2;
   SimpleTestLookup stl(val);
@@ -382,6 +424,10 @@ TEST_VM(ConcurrentHashTable, basic_get_insert) {
   nomt_test_doer(cht_get_insert);
 }
 
+TEST_VM(ConcurrentHashTable, basic_delete_dead_in_bucket) {
+  nomt_test_doer(cht_delete_dead_in_bucket);
+}
+
 TEST_VM(ConcurrentHashTable, basic_scope) {
   nomt_test_doer(cht_scope);
 }
@@ -1032,3 +1078,63 @@ public:
 TEST_VM(ConcurrentHashTable, concurrent_mt_bulk_delete) {
   mt_test_doer<Driver_BD_Thread>();
 }
+
+//#############################################################################################
+
+class MT_GT_Thread : public JavaTestThread {
+  TestTable::GrowTask* _gt;
+  public:
+  MT_GT_Thread(Semaphore* post, TestTable::GrowTask* gt)
+    : JavaTestThread(post), _gt(gt){}
+  virtual ~MT_GT_Thread() {}
+  void main_run() {
+    while(_gt->do_task(this));
+  }
+};
+
+class Driver_GT_Thread : public JavaTestThread {
+public:
+  Driver_GT_Thread(Semaphore* post) : JavaTestThread(post) {
+  };
+  virtual ~Driver_GT_Thread(){}
+
+  void main_run() {
+    Semaphore done(0);
+    TestTable* cht = new TestTable(14, 16, 2);
+    for (uintptr_t v = 1; v < 99999; v++ ) {
+      TestLookup tl(v);
+      EXPECT_TRUE(cht->insert(this, tl, v)) << "Inserting an unique value should work.";
+    }
+    size_t log2_size = cht->get_size_log2(this);
+    TestTable::GrowTask gt(cht);
+    EXPECT_TRUE(gt.prepare(this)) << "Uncontended prepare must work.";
+
+    MT_GT_Thread* tt[4];
+    for (int i = 0; i < 4; i++) {
+      tt[i] = new MT_GT_Thread(&done, &gt);
+      tt[i]->doit();
+    }
+
+    for (uintptr_t v = 1; v < 99999; v++ ) {
+      TestLookup tl(v);
+      EXPECT_EQ(cht_get_copy(cht, this, tl), v) << "Getting an inserted value during grow should work.";
+    }
+
+    for (int i = 0; i < 4; i++) {
+      done.wait();
+    }
+
+    gt.done(this);
+
+    EXPECT_EQ(cht->get_size_log2(this), log2_size + 1) << "Table should have grown.";
+    for (uintptr_t v = 1; v < 99999; v++ ) {
+      TestLookup tl(v);
+      EXPECT_EQ(cht_get_copy(cht, this, tl), v) << "Getting an item after grow failed.";
+    }
+    delete cht;
+  }
+};
+
+TEST_VM(ConcurrentHashTable, concurrent_mt_grow) {
+  mt_test_doer<Driver_GT_Thread>();
+}
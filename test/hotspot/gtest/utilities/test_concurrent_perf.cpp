@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+
+#include "precompiled.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/bitMap.inline.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
+#include "utilities/lockFreeStack.hpp"
+#include "utilities/singleWriterSynchronizer.hpp"
+#include "benchmarkHelper.inline.hpp"
+#include "unittest.hpp"
+
+// These "tests" don't verify anything.  They are microbenchmarks of the
+// concurrent data structures in utilities, and print one line of stats
+// per configuration; see benchmarkHelper.inline.hpp.
+
+// ConcurrentHashTable: lookups of present keys mixed with inserts and
+// removes of keys private to each thread.
+
+struct BenchPointer : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    // Spread the keys, which are consecutive.
+    return (uintx)(value * 0x9E3779B97F4A7C15ULL);
+  }
+  static void* allocate_node(size_t size, const Value& value) {
+    return ::malloc(size);
+  }
+  static void free_node(void* memory, const Value& value) {
+    ::free(memory);
+  }
+};
+
+typedef ConcurrentHashTable<BenchPointer, mtInternal> BenchTable;
+
+struct BenchLookup {
+  uintptr_t _val;
+  BenchLookup(uintptr_t val) : _val(val) {}
+  uintx get_hash() {
+    return BenchPointer::get_hash(_val, NULL);
+  }
+  bool equals(const uintptr_t* value, bool* is_dead) {
+    return _val == *value;
+  }
+};
+
+struct BenchFound {
+  uintptr_t _value;
+  BenchFound() : _value(0) {}
+  void operator()(uintptr_t* value) { _value = *value; }
+};
+
+class CHTMixBenchmark : public Benchmark {
+  static const uintptr_t num_keys = 64 * 1024;
+  static const uint max_threads = 64;
+
+  BenchTable* _table;
+  uint _update_percent;
+  BenchmarkRandom _random[max_threads];
+
+public:
+  CHTMixBenchmark(uint update_percent) :
+    _table(new BenchTable(16, 16)), _update_percent(update_percent) {
+    for (uintptr_t k = 1; k <= num_keys; k++) {
+      _table->unsafe_insert(k);
+    }
+  }
+
+  ~CHTMixBenchmark() {
+    delete _table;
+  }
+
+  virtual void setup_thread(uint thread_id) {
+    _random[thread_id] = BenchmarkRandom(thread_id + 1);
+  }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    BenchmarkRandom& r = _random[thread_id];
+    if (r.next(100) < _update_percent) {
+      // Keys above num_keys are private to a thread.
+      BenchLookup l(num_keys * (thread_id + 2) + r.next(num_keys));
+      if (!_table->insert(thread, l, l._val)) {
+        _table->remove(thread, l);
+      }
+    } else {
+      BenchLookup l(1 + r.next(num_keys));
+      BenchFound f;
+      _table->get(thread, l, f);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, cht_lookup) {
+  CHTMixBenchmark b(0);
+  BenchmarkRunner::run_all("cht_lookup", &b);
+}
+
+TEST_VM(ConcurrentBenchmark, cht_mixed_90_10) {
+  CHTMixBenchmark b(10);
+  BenchmarkRunner::run_all("cht_mixed_90_10", &b);
+}
+
+// BitMap: every thread scans windows of a sparse bitmap for set bits,
+// while atomically flipping a bit now and then.
+
+class BitMapScanBenchmark : public Benchmark {
+  static const BitMap::idx_t num_bits = 4 * M;
+  static const BitMap::idx_t window = 64 * K;
+  static const uint max_threads = 64;
+
+  CHeapBitMap _map;
+  BenchmarkRandom _random[max_threads];
+  volatile size_t _found;
+
+public:
+  BitMapScanBenchmark() : _map(num_bits, mtInternal), _found(0) {
+    BenchmarkRandom r;
+    for (BitMap::idx_t i = 0; i < num_bits / 256; i++) {
+      _map.set_bit(r.next(num_bits));
+    }
+  }
+
+  virtual void setup_thread(uint thread_id) {
+    _random[thread_id] = BenchmarkRandom(thread_id + 1);
+  }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    BenchmarkRandom& r = _random[thread_id];
+    BitMap::idx_t start = r.next(num_bits / window) * window;
+    BitMap::idx_t end = start + window;
+    size_t found = 0;
+    for (BitMap::idx_t i = _map.get_next_one_offset(start, end);
+         i < end;
+         i = _map.get_next_one_offset(i + 1, end)) {
+      found++;
+    }
+    if ((found & 7) == 0) {
+      BitMap::idx_t bit = r.next(num_bits);
+      if (!_map.par_set_bit(bit)) {
+        _map.par_clear_bit(bit);
+      }
+    }
+    // Keep the scan from being optimized away.
+    _found = found;
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, bitmap_scan) {
+  BitMapScanBenchmark b;
+  BenchmarkRunner::run_all("bitmap_scan", &b);
+}
+
+// LockFreeStack: threads move elements around a ring of stacks, as in
+// the stress test.
+
+class BenchStackElement {
+  BenchStackElement* volatile _entry;
+  static BenchStackElement* volatile* entry_ptr(BenchStackElement& e) { return &e._entry; }
+public:
+  BenchStackElement() : _entry(NULL) {}
+  typedef LockFreeStack<BenchStackElement, &entry_ptr> Stack;
+};
+
+class LockFreeStackBenchmark : public Benchmark {
+  static const uint num_stacks = 4;
+  static const size_t num_elements = 1024;
+
+  BenchStackElement::Stack _stacks[num_stacks];
+  BenchStackElement* _elements;
+
+public:
+  LockFreeStackBenchmark() : _elements(new BenchStackElement[num_elements]) {
+    for (size_t i = 0; i < num_elements; i++) {
+      _stacks[i % num_stacks].push(_elements[i]);
+    }
+  }
+
+  ~LockFreeStackBenchmark() {
+    for (uint i = 0; i < num_stacks; i++) {
+      _stacks[i].pop_all();
+    }
+    delete[] _elements;
+  }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    BenchStackElement::Stack& from = _stacks[thread_id % num_stacks];
+    BenchStackElement* e = from.pop();
+    if (e != NULL) {
+      _stacks[(thread_id + 1) % num_stacks].push(*e);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, lock_free_stack) {
+  LockFreeStackBenchmark b;
+  BenchmarkRunner::run_all("lock_free_stack", &b);
+}
+
+// GlobalCounter and SingleWriterSynchronizer: readers enter and leave
+// critical sections, while thread 0 keeps synchronizing.
+
+class GlobalCounterBenchmark : public Benchmark {
+  uintptr_t* volatile _value;
+  uintptr_t _values[2];
+
+public:
+  GlobalCounterBenchmark() : _value(&_values[0]) {
+    _values[0] = 0;
+    _values[1] = 1;
+  }
+
+  virtual uint role(uint thread_id) const { return thread_id == 0 ? 0 : 1; }
+  virtual const char* role_name(uint role) const { return role == 0 ? "writer" : "readers"; }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    if (thread_id == 0) {
+      uintptr_t* old = _value;
+      OrderAccess::release_store_fence(&_value, old == &_values[0] ? &_values[1] : &_values[0]);
+      GlobalCounter::write_synchronize();
+    } else {
+      GlobalCounter::CriticalSection cs(thread);
+      uintptr_t v = *OrderAccess::load_acquire(&_value);
+      guarantee(v <= 1, "read a value that was never published");
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, global_counter) {
+  GlobalCounterBenchmark b;
+  BenchmarkRunner::run_all("global_counter", &b, 2);
+}
+
+class SingleWriterSynchronizerBenchmark : public Benchmark {
+  SingleWriterSynchronizer _synchronizer;
+  volatile uintx _value;
+
+public:
+  SingleWriterSynchronizerBenchmark() : _value(0) {}
+
+  virtual uint role(uint thread_id) const { return thread_id == 0 ? 0 : 1; }
+  virtual const char* role_name(uint role) const { return role == 0 ? "writer" : "readers"; }
+
+  virtual void do_op(uint thread_id, Thread* thread) {
+    if (thread_id == 0) {
+      Atomic::inc(&_value);
+      _synchronizer.synchronize();
+    } else {
+      SingleWriterSynchronizer::CriticalSection cs(&_synchronizer);
+      OrderAccess::load_acquire(&_value);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, single_writer_synchronizer) {
+  SingleWriterSynchronizerBenchmark b;
+  BenchmarkRunner::run_all("single_writer_synchronizer", &b, 2);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/arena.hpp"
+#include "memory/resourceArea.hpp"
+#include "utilities/growableArray.hpp"
+#include "unittest.hpp"
+
+TEST_VM(InlineGrowableArray, resource_area) {
+  ResourceMark rm;
+  InlineGrowableArray<int, 4> a;
+  EXPECT_EQ(4, a.max_length());
+  for (int i = 0; i < 4; i++) {
+    a.append(i);
+  }
+  EXPECT_EQ(4, a.max_length()) << "should not have grown";
+
+  for (int i = 4; i < 100; i++) {
+    a.append(i);
+  }
+  EXPECT_EQ(100, a.length());
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(i, a.at(i));
+  }
+}
+
+TEST_VM(InlineGrowableArray, arena) {
+  Arena arena(mtTest);
+  InlineGrowableArray<void*, 2> a(&arena);
+  size_t used = arena.used();
+  a.append(&arena);
+  a.append(NULL);
+  EXPECT_EQ(used, arena.used()) << "inline elements should not allocate";
+
+  a.append(&a);
+  EXPECT_LT(used, arena.used());
+  EXPECT_EQ(3, a.length());
+  EXPECT_EQ((void*)&arena, a.at(0));
+  EXPECT_EQ((void*)NULL, a.at(1));
+  EXPECT_EQ((void*)&a, a.at(2));
+}
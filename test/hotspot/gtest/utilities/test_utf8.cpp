@@ -48,3 +48,43 @@ TEST(utf8, length) {
   UNICODE::as_utf8(str, 19, res, INT_MAX);
   ASSERT_EQ(strlen(res), (size_t) 3 * 19) << "string should end here";
 }
+
+// Exercise the word-at-a-time ASCII paths with strings that are not a
+// multiple of the word size and switch to non-ASCII at various offsets.
+TEST(utf8, ascii_fast_paths) {
+  for (int prefix = 0; prefix < 20; prefix++) {
+    jchar str[24];
+    for (int i = 0; i < prefix; i++) {
+      str[i] = (jchar)('a' + i);
+    }
+    str[prefix] = 0x00E9;     // 2 bytes, latin1
+    str[prefix + 1] = 0;      // 2 bytes in modified UTF-8
+    str[prefix + 2] = 0x20AC; // 3 bytes, not latin1
+    str[prefix + 3] = 'z';
+    const int len = prefix + 4;
+
+    int utf8_len = UNICODE::utf8_length(str, len);
+    ASSERT_EQ(prefix + 2 + 2 + 3 + 1, utf8_len);
+
+    char utf8[64];
+    UNICODE::convert_to_utf8(str, len, utf8);
+    ASSERT_EQ((size_t)utf8_len, strlen(utf8));
+
+    bool is_latin1;
+    bool has_multibyte;
+    ASSERT_EQ(len, UTF8::unicode_length(utf8, utf8_len, is_latin1, has_multibyte));
+    ASSERT_FALSE(is_latin1);
+    ASSERT_TRUE(has_multibyte);
+
+    jchar back[24];
+    UTF8::convert_to_unicode(utf8, back, len);
+    for (int i = 0; i < len; i++) {
+      ASSERT_EQ(str[i], back[i]) << "mismatch at " << i << " with prefix " << prefix;
+    }
+
+    // Pure ASCII string of the same prefix length
+    ASSERT_EQ(prefix, UTF8::unicode_length(utf8, prefix, is_latin1, has_multibyte));
+    ASSERT_TRUE(is_latin1);
+    ASSERT_FALSE(has_multibyte);
+  }
+}